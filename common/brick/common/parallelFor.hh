@@ -0,0 +1,196 @@
+/**
+***************************************************************************
+* @file brick/common/parallelFor.hh
+*
+* Header file declaring simple tools for splitting a loop into bands
+* and running those bands on concurrent threads.
+*
+* Copyright (C) 2026, David LaRose, dlr@cs.cmu.edu
+* See accompanying file, LICENSE.TXT, for details.
+*
+***************************************************************************
+**/
+
+#ifndef BRICK_COMMON_PARALLELFOR_HH
+#define BRICK_COMMON_PARALLELFOR_HH
+
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace brick {
+
+  namespace common {
+
+    /**
+     * This function returns the number of threads that should be
+     * used by parallel algorithms when the calling context doesn't
+     * specify a thread count.  It is never less than 1.
+     *
+     * @return The return value is the number of hardware threads
+     * reported by the standard library, or 1 if that number is not
+     * available.
+     */
+    inline unsigned int
+    getDefaultNumberOfThreads();
+
+
+    /**
+     * This function template divides the half-open range [begin,
+     * end) into contiguous bands of approximately equal size, and
+     * calls functor(bandBegin, bandEnd, bandIndex) once for each
+     * band.  The bands are processed on concurrent threads, with the
+     * calling thread handling band 0.  Each band index in the range
+     * [0, numberOfBands) is passed to exactly one call, so it can be
+     * used to address per-thread accumulators.  If any call throws,
+     * this function waits for the remaining bands to finish and then
+     * rethrows the first exception in the calling context.
+     *
+     * Usage example:
+     *
+     * @code
+     *   std::vector<double> partialSums(numberOfThreads, 0.0);
+     *   parallelFor(0, data.size(), numberOfThreads,
+     *               [&](std::size_t begin, std::size_t end,
+     *                   std::size_t band) {
+     *                 for(std::size_t ii = begin; ii < end; ++ii) {
+     *                   partialSums[band] += data[ii];
+     *                 }
+     *               });
+     * @endcode
+     *
+     * @param begin This argument is the first index of the range.
+     *
+     * @param end This argument is one past the last index of the range.
+     *
+     * @param numberOfBands This argument specifies how many bands
+     * (and therefore threads) to use.  Setting it to zero selects
+     * getDefaultNumberOfThreads().  It will be reduced if there are
+     * fewer than numberOfBands elements in the range.
+     *
+     * @param functor This argument is the function to be called for
+     * each band.  It must be safe to call concurrently from several
+     * threads.
+     *
+     * @return The return value is the number of bands actually used,
+     * which is the number of distinct band indices passed to functor.
+     */
+    template <class Functor>
+    std::size_t
+    parallelFor(std::size_t begin, std::size_t end,
+                std::size_t numberOfBands, Functor functor);
+
+
+    /**
+     * This function returns the number of bands that parallelFor()
+     * will actually use for a given range size and requested band
+     * count.  It is useful for sizing per-band accumulators before
+     * calling parallelFor().
+     *
+     * @param rangeSize This argument is the number of elements in the
+     * range, (end - begin).
+     *
+     * @param numberOfBands This argument is the number of bands that
+     * will be passed to parallelFor().
+     *
+     * @return The return value is the effective band count.
+     */
+    inline std::size_t
+    getNumberOfBands(std::size_t rangeSize, std::size_t numberOfBands);
+
+  } // namespace common
+
+} // namespace brick
+
+
+/* ============ Definitions of inline & template functions ============ */
+
+
+namespace brick {
+
+  namespace common {
+
+    inline unsigned int
+    getDefaultNumberOfThreads()
+    {
+      unsigned int numberOfThreads = std::thread::hardware_concurrency();
+      return (numberOfThreads == 0) ? 1 : numberOfThreads;
+    }
+
+
+    inline std::size_t
+    getNumberOfBands(std::size_t rangeSize, std::size_t numberOfBands)
+    {
+      if(numberOfBands == 0) {
+        numberOfBands = getDefaultNumberOfThreads();
+      }
+      if(numberOfBands > rangeSize) {
+        numberOfBands = rangeSize;
+      }
+      return (numberOfBands == 0) ? 1 : numberOfBands;
+    }
+
+
+    template <class Functor>
+    std::size_t
+    parallelFor(std::size_t begin, std::size_t end,
+                std::size_t numberOfBands, Functor functor)
+    {
+      std::size_t const rangeSize = (end > begin) ? (end - begin) : 0;
+      numberOfBands = getNumberOfBands(rangeSize, numberOfBands);
+
+      // Single threaded case is handled without any thread overhead.
+      if(numberOfBands == 1) {
+        functor(begin, begin + rangeSize, std::size_t(0));
+        return 1;
+      }
+
+      // Spread any remainder over the first few bands so that band
+      // sizes differ by at most one element.
+      std::size_t const bandSize = rangeSize / numberOfBands;
+      std::size_t const remainder = rangeSize % numberOfBands;
+      std::vector<std::size_t> bandStarts(numberOfBands + 1);
+      bandStarts[0] = begin;
+      for(std::size_t band = 0; band < numberOfBands; ++band) {
+        bandStarts[band + 1] = bandStarts[band] + bandSize
+          + ((band < remainder) ? 1 : 0);
+      }
+
+      std::vector<std::exception_ptr> exceptions(numberOfBands);
+      std::vector<std::thread> threads;
+      threads.reserve(numberOfBands - 1);
+      for(std::size_t band = 1; band < numberOfBands; ++band) {
+        threads.push_back(std::thread(
+          [&functor, &bandStarts, &exceptions, band]() {
+            try {
+              functor(bandStarts[band], bandStarts[band + 1], band);
+            } catch(...) {
+              exceptions[band] = std::current_exception();
+            }
+          }));
+      }
+
+      // The calling thread does its share of the work, too.
+      try {
+        functor(bandStarts[0], bandStarts[1], std::size_t(0));
+      } catch(...) {
+        exceptions[0] = std::current_exception();
+      }
+
+      for(std::size_t ii = 0; ii < threads.size(); ++ii) {
+        threads[ii].join();
+      }
+      for(std::size_t band = 0; band < numberOfBands; ++band) {
+        if(exceptions[band]) {
+          std::rethrow_exception(exceptions[band]);
+        }
+      }
+      return numberOfBands;
+    }
+
+  } // namespace common
+
+} // namespace brick
+
+#endif /* #ifndef BRICK_COMMON_PARALLELFOR_HH */
@@ -0,0 +1,103 @@
+/**
+***************************************************************************
+* @file parallelForTest.cc
+*
+* Source file defining tests for parallelFor().
+*
+* Copyright (C) 2026 David LaRose, dlr@cs.cmu.edu
+* See accompanying file, LICENSE.TXT, for details.
+*
+***************************************************************************
+**/
+
+#include <stdexcept>
+#include <vector>
+#include <brick/common/parallelFor.hh>
+
+namespace brick {
+
+  namespace common {
+
+    // We don't want to introduce a dependency on non-brick code for
+    // unit testing, and the brick::test library is not available in
+    // this context, so we just hack up some test functions.
+
+    bool
+    testParallelFor()
+    {
+      for(std::size_t numberOfBands = 0; numberOfBands < 9; ++numberOfBands) {
+        // Every element should be visited exactly once, and band
+        // indices should be usable as accumulator indices.
+        std::vector<int> visits(103, 0);
+        std::vector<std::size_t> partialSums(
+          getNumberOfBands(100, numberOfBands), 0);
+        std::size_t bandsUsed = parallelFor(
+          3, 103, numberOfBands,
+          [&](std::size_t begin, std::size_t end, std::size_t band) {
+            for(std::size_t ii = begin; ii < end; ++ii) {
+              ++visits[ii];
+              partialSums[band] += ii;
+            }
+          });
+        if(bandsUsed != partialSums.size()) {
+          return false;
+        }
+        for(std::size_t ii = 0; ii < visits.size(); ++ii) {
+          if(visits[ii] != ((ii < 3) ? 0 : 1)) {
+            return false;
+          }
+        }
+        std::size_t total = 0;
+        for(std::size_t ii = 0; ii < partialSums.size(); ++ii) {
+          total += partialSums[ii];
+        }
+        if(total != (3 + 102) * 100 / 2) {
+          return false;
+        }
+      }
+
+      // Empty ranges and small ranges should be handled sensibly.
+      std::size_t callCount = 0;
+      parallelFor(5, 5, 4, [&](std::size_t begin, std::size_t end,
+                               std::size_t) {
+                    callCount += 1 + (end - begin);
+                  });
+      if(callCount != 1) {
+        return false;
+      }
+      if(getNumberOfBands(2, 8) != 2 || getNumberOfBands(0, 8) != 1) {
+        return false;
+      }
+      return true;
+    }
+
+
+    bool
+    testParallelForException()
+    {
+      try {
+        parallelFor(0, 10, 3, [](std::size_t begin, std::size_t,
+                                 std::size_t) {
+                      if(begin != 0) {
+                        throw std::runtime_error("Band failed.");
+                      }
+                    });
+      } catch(std::runtime_error const&) {
+        return true;
+      }
+      return false;
+    }
+
+  } // namespace common
+
+} // namespace brick
+
+
+// int main(int argc, char** argv)
+int main(int, char**)
+{
+  bool result = true;
+  result &= brick::common::testParallelFor();
+  result &= brick::common::testParallelForException();
+  return (result ? 0 : 1);
+}
@@ -0,0 +1,308 @@
+/**
+***************************************************************************
+* @file brick/computerVision/calibrationObjectiveMultiView.hh
+*
+* Header file declaring an analytically differentiated reprojection
+* error objective for calibrating a camera from many views of a
+* target.
+*
+* Copyright (C) 2026 David LaRose, dlr@cs.cmu.edu
+* See accompanying file, LICENSE.TXT, for details.
+*
+***************************************************************************
+*/
+
+#ifndef BRICK_COMPUTERVISION_CALIBRATIONOBJECTIVEMULTIVIEW_HH
+#define BRICK_COMPUTERVISION_CALIBRATIONOBJECTIVEMULTIVIEW_HH
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+#include <brick/numeric/array1D.hh>
+#include <brick/numeric/array2D.hh>
+#include <brick/numeric/transform3D.hh>
+#include <brick/numeric/vector2D.hh>
+#include <brick/numeric/vector3D.hh>
+
+namespace brick {
+
+  namespace computerVision {
+
+    /**
+     ** This class implements the sum-of-squares reprojection error
+     ** of a single camera observing a calibration target from
+     ** several different poses, in a form suitable for use with
+     ** brick::optimization::OptimizerLM.
+     **
+     ** The parameter vector consists of the intrinsic parameters, in
+     ** the order returned by Intrinsics::getParameters(), followed by
+     ** seven parameters for each view: the four elements (s, i, j, k)
+     ** of a quaternion representing the rotation part of cameraTworld,
+     ** followed by its three translation elements.  Quaternions are
+     ** normalized before use, so their magnitude is arbitrary.
+     **
+     ** Each view contributes an independent block of residuals, whose
+     ** Jacobian is nonzero only in the intrinsic columns and the
+     ** seven columns belonging to that view.  Rather than
+     ** differentiating numerically and forming the full Jacobian,
+     ** computeGradientAndHessian() evaluates analytic derivatives
+     ** (see Intrinsics::projectWithJacobian()) one view at a time,
+     ** and accumulates J^T * J and J^T * r directly.  Views are
+     ** divided among threads, each of which accumulates its own copy
+     ** of the intrinsic block; the per-view blocks are written
+     ** directly, since no two threads share them.
+     **
+     ** Template argument Intrinsics must provide getParameters(),
+     ** setParameters(), and projectWithJacobian(), as
+     ** CameraIntrinsicsPlumbBob and CameraIntrinsicsRational do.
+     **
+     ** Example usage:
+     **
+     ** @code
+     **   CalibrationObjectiveMultiView< CameraIntrinsicsRational<double> >
+     **     objective(initialIntrinsics, 0);
+     **   for(size_t ii = 0; ii < numberOfViews; ++ii) {
+     **     objective.addView(points3D[ii].begin(), points3D[ii].end(),
+     **                       points2D[ii].begin());
+     **   }
+     **   OptimizerLM< CalibrationObjectiveMultiView<
+     **     CameraIntrinsicsRational<double> >, double > optimizer(objective);
+     **   optimizer.setStartPoint(
+     **     objective.getParameters(initialIntrinsics, initialPoses));
+     **   objective.getCalibration(optimizer.optimum(), intrinsics, poses);
+     ** @endcode
+     **/
+    template <class Intrinsics>
+    class CalibrationObjectiveMultiView
+      : public std::unary_function<typename Intrinsics::ParameterVectorType,
+                                   typename Intrinsics::FloatType>
+    {
+    public:
+
+      /// Convenient typedef for keeping track of how we represent
+      /// real numbers.
+      typedef typename Intrinsics::FloatType FloatType;
+
+      /// Convenient typedef for the parameter vector type.
+      typedef typename Intrinsics::ParameterVectorType ParameterVectorType;
+
+
+      /**
+       * The constructor specifies the camera model.
+       *
+       * @param intrinsics This argument determines the image size
+       * and the number of intrinsic parameters (for example, whether
+       * a CameraIntrinsicsPlumbBob instance allows skew).  Its
+       * parameter values are not used.
+       *
+       * @param numberOfThreads This argument specifies how many
+       * threads should share the work of evaluating views.  Setting
+       * it to zero uses one thread per available processor.
+       */
+      CalibrationObjectiveMultiView(
+        Intrinsics const& intrinsics = Intrinsics(),
+        unsigned int numberOfThreads = 1);
+
+
+      /**
+       * This member function adds one view of the calibration target.
+       *
+       * @param points3DBegin This argument is an iterator pointing to
+       * the beginning of a sequence of 3D points (expressed as
+       * brick::numeric::Vector3D<FloatType> instances) in world
+       * coordinates.
+       *
+       * @param points3DEnd This argument is an iterator pointing one
+       * element past the end of the sequence of 3D points.
+       *
+       * @param points2DBegin This argument is an iterator pointing to
+       * the beginning of a sequence of 2D points (expressed as
+       * brick::numeric::Vector2D<FloatType> instances) in pixel
+       * coordinates, corresponding to the sequence defined by
+       * points3DBegin and points3DEnd.
+       */
+      template <class Iter3D, class Iter2D>
+      void
+      addView(Iter3D points3DBegin, Iter3D points3DEnd,
+              Iter2D points2DBegin);
+
+
+      /**
+       * This member function computes the gradient and Hessian of
+       * the sum-of-squares error, using the Gauss-Newton
+       * approximation to the Hessian, with the same scaling as
+       * brick::optimization::GradientFunctionLM.
+       *
+       * @param theta This argument is the parameter vector at which
+       * to evaluate the derivatives.
+       *
+       * @param dEdX This argument returns the gradient, 2 * J^T * r.
+       *
+       * @param d2EdX2 This argument returns the approximate Hessian,
+       * 2 * J^T * J.
+       */
+      void
+      computeGradientAndHessian(ParameterVectorType const& theta,
+                                ParameterVectorType& dEdX,
+                                brick::numeric::Array2D<FloatType>& d2EdX2);
+
+
+      /**
+       * This member function computes the reprojection residuals
+       * (projected minus observed pixel position) for every point of
+       * every view.
+       *
+       * @param theta This argument is the parameter vector at which
+       * to evaluate the residuals.
+       *
+       * @return The return value holds the u and v residuals of each
+       * point, in the order in which views and points were added.
+       */
+      brick::numeric::Array1D<FloatType>
+      computeResiduals(ParameterVectorType const& theta);
+
+
+      /**
+       * This member function unpacks a parameter vector.
+       *
+       * @param theta This argument is the parameter vector to unpack.
+       *
+       * @param intrinsics This argument returns the camera
+       * intrinsics.  Its image size is copied from the constructor
+       * argument.
+       *
+       * @param cameraTworldVector This argument returns one pose for
+       * each view.
+       */
+      void
+      getCalibration(
+        ParameterVectorType const& theta,
+        Intrinsics& intrinsics,
+        std::vector< brick::numeric::Transform3D<FloatType> >&
+          cameraTworldVector) const;
+
+
+      /**
+       * This member function returns the number of parameters
+       * expected by operator()().
+       *
+       * @return The return value is the number of intrinsic
+       * parameters plus seven times the number of views.
+       */
+      std::size_t
+      getNumberOfParameters() const {
+        return m_numberOfIntrinsicParameters + 7 * m_views.size();
+      }
+
+
+      /**
+       * This member function returns the total number of residuals.
+       *
+       * @return The return value is twice the total number of points.
+       */
+      std::size_t
+      getNumberOfResiduals() const {return 2 * m_numberOfPoints;}
+
+
+      /**
+       * This member function returns the number of views added so far.
+       *
+       * @return The return value is the number of views.
+       */
+      std::size_t
+      getNumberOfViews() const {return m_views.size();}
+
+
+      /**
+       * This member function packs intrinsics and poses into a
+       * parameter vector.
+       *
+       * @param intrinsics This argument specifies the camera
+       * intrinsics.
+       *
+       * @param cameraTworldVector This argument specifies one pose
+       * for each view.
+       *
+       * @return The return value is a parameter vector suitable for
+       * passing to operator()().
+       */
+      ParameterVectorType
+      getParameters(
+        Intrinsics const& intrinsics,
+        std::vector< brick::numeric::Transform3D<FloatType> > const&
+          cameraTworldVector) const;
+
+
+      /**
+       * This member function computes the sum-of-squares
+       * reprojection error.
+       *
+       * @param theta This argument is the parameter vector at which
+       * to evaluate the error.
+       *
+       * @return The return value is the sum of squared residuals.
+       */
+      FloatType
+      operator()(ParameterVectorType const& theta);
+
+
+      /**
+       * This member function specifies how many threads should share
+       * the work.
+       *
+       * @param numberOfThreads This argument specifies the number of
+       * threads.  Setting it to zero uses one thread per available
+       * processor.
+       */
+      void
+      setNumberOfThreads(unsigned int numberOfThreads) {
+        m_numberOfThreads = numberOfThreads;
+      }
+
+    private:
+
+      // Observations of the calibration target from a single pose.
+      struct View {
+        std::vector< brick::numeric::Vector3D<FloatType> > points3D;
+        std::vector< brick::numeric::Vector2D<FloatType> > points2D;
+        std::size_t residualOffset;
+      };
+
+
+      // Adds the contribution of one view to the gradient and
+      // Hessian.  The intrinsic-only blocks are accumulated into
+      // intrinsicGradient and intrinsicHessian, and everything else
+      // is written directly into dEdX and d2EdX2.
+      void
+      accumulateView(ParameterVectorType const& theta,
+                     std::size_t viewIndex,
+                     ParameterVectorType& dEdX,
+                     brick::numeric::Array2D<FloatType>& d2EdX2,
+                     brick::numeric::Array1D<FloatType>& intrinsicGradient,
+                     brick::numeric::Array2D<FloatType>& intrinsicHessian,
+                     brick::numeric::Array2D<FloatType>& dPixelDIntrinsics,
+                     brick::numeric::Array2D<FloatType>& dPixelDPoint) const;
+
+
+      // Copies the intrinsic part of theta into m_intrinsics.
+      void
+      setIntrinsics(ParameterVectorType const& theta);
+
+
+      Intrinsics m_intrinsics;
+      std::size_t m_numberOfIntrinsicParameters;
+      std::size_t m_numberOfPoints;
+      unsigned int m_numberOfThreads;
+      std::vector<View> m_views;
+    };
+
+  } // namespace computerVision
+
+} // namespace brick
+
+
+// Include file containing definitions of inline and template
+// functions.
+#include <brick/computerVision/calibrationObjectiveMultiView_impl.hh>
+
+#endif /* #ifndef BRICK_COMPUTERVISION_CALIBRATIONOBJECTIVEMULTIVIEW_HH */
@@ -0,0 +1,437 @@
+/**
+***************************************************************************
+* @file brick/computerVision/calibrationObjectiveMultiView_impl.hh
+*
+* Header file defining inline and template functions declared in
+* calibrationObjectiveMultiView.hh.
+*
+* Copyright (C) 2026 David LaRose, dlr@cs.cmu.edu
+* See accompanying file, LICENSE.TXT, for details.
+*
+***************************************************************************
+*/
+
+#ifndef BRICK_COMPUTERVISION_CALIBRATIONOBJECTIVEMULTIVIEW_IMPL_HH
+#define BRICK_COMPUTERVISION_CALIBRATIONOBJECTIVEMULTIVIEW_IMPL_HH
+
+// This file is included by calibrationObjectiveMultiView.hh, and
+// should not be directly included by user code, so no need to
+// include calibrationObjectiveMultiView.hh here.
+//
+// #include <brick/computerVision/calibrationObjectiveMultiView.hh>
+
+#include <brick/common/exception.hh>
+#include <brick/common/parallelFor.hh>
+#include <brick/numeric/quaternion.hh>
+#include <brick/numeric/rotations.hh>
+
+namespace brick {
+
+  namespace computerVision {
+
+    template <class Intrinsics>
+    CalibrationObjectiveMultiView<Intrinsics>::
+    CalibrationObjectiveMultiView(Intrinsics const& intrinsics,
+                                  unsigned int numberOfThreads)
+      : m_intrinsics(intrinsics),
+        m_numberOfIntrinsicParameters(intrinsics.getParameters().size()),
+        m_numberOfPoints(0),
+        m_numberOfThreads(numberOfThreads),
+        m_views()
+    {
+      // Empty.
+    }
+
+
+    template <class Intrinsics>
+    template <class Iter3D, class Iter2D>
+    void
+    CalibrationObjectiveMultiView<Intrinsics>::
+    addView(Iter3D points3DBegin, Iter3D points3DEnd, Iter2D points2DBegin)
+    {
+      m_views.push_back(View());
+      View& view = m_views.back();
+      view.points3D.assign(points3DBegin, points3DEnd);
+      view.points2D.assign(points2DBegin,
+                           points2DBegin + view.points3D.size());
+      view.residualOffset = 2 * m_numberOfPoints;
+      m_numberOfPoints += view.points3D.size();
+    }
+
+
+    template <class Intrinsics>
+    void
+    CalibrationObjectiveMultiView<Intrinsics>::
+    computeGradientAndHessian(ParameterVectorType const& theta,
+                              ParameterVectorType& dEdX,
+                              brick::numeric::Array2D<FloatType>& d2EdX2)
+    {
+      std::size_t const numberOfParameters = this->getNumberOfParameters();
+      std::size_t const numberOfIntrinsics = m_numberOfIntrinsicParameters;
+      if(theta.size() != numberOfParameters) {
+        BRICK_THROW(brick::common::ValueException,
+                    "CalibrationObjectiveMultiView::"
+                    "computeGradientAndHessian()",
+                    "Parameter vector has the wrong size.");
+      }
+      this->setIntrinsics(theta);
+
+      if(dEdX.size() != numberOfParameters) {
+        dEdX.reinit(numberOfParameters);
+      }
+      if(d2EdX2.rows() != numberOfParameters
+         || d2EdX2.columns() != numberOfParameters) {
+        d2EdX2.reinit(numberOfParameters, numberOfParameters);
+      }
+      dEdX = FloatType(0.0);
+      d2EdX2 = FloatType(0.0);
+
+      // Each band of views gets its own intrinsic accumulators.
+      // Everything else belongs to exactly one view, and so to
+      // exactly one band.
+      std::size_t const numberOfBands = brick::common::getNumberOfBands(
+        m_views.size(), m_numberOfThreads);
+      std::vector< brick::numeric::Array1D<FloatType> > intrinsicGradients(
+        numberOfBands);
+      std::vector< brick::numeric::Array2D<FloatType> > intrinsicHessians(
+        numberOfBands);
+      brick::common::parallelFor(
+        0, m_views.size(), numberOfBands,
+        [&](std::size_t bandBegin, std::size_t bandEnd, std::size_t band) {
+          brick::numeric::Array1D<FloatType> intrinsicGradient(
+            numberOfIntrinsics);
+          brick::numeric::Array2D<FloatType> intrinsicHessian(
+            numberOfIntrinsics, numberOfIntrinsics);
+          intrinsicGradient = FloatType(0.0);
+          intrinsicHessian = FloatType(0.0);
+          brick::numeric::Array2D<FloatType> dPixelDIntrinsics(
+            2, numberOfIntrinsics);
+          brick::numeric::Array2D<FloatType> dPixelDPoint(2, 3);
+          for(std::size_t viewIndex = bandBegin; viewIndex < bandEnd;
+              ++viewIndex) {
+            this->accumulateView(theta, viewIndex, dEdX, d2EdX2,
+                                 intrinsicGradient, intrinsicHessian,
+                                 dPixelDIntrinsics, dPixelDPoint);
+          }
+          intrinsicGradients[band] = intrinsicGradient;
+          intrinsicHessians[band] = intrinsicHessian;
+        });
+
+      // Reduce in band order so that the result doesn't depend on
+      // thread scheduling.
+      for(std::size_t band = 0; band < numberOfBands; ++band) {
+        if(intrinsicGradients[band].size() == 0) {
+          continue;
+        }
+        for(std::size_t row = 0; row < numberOfIntrinsics; ++row) {
+          dEdX[row] += intrinsicGradients[band][row];
+          for(std::size_t column = row; column < numberOfIntrinsics;
+              ++column) {
+            d2EdX2(row, column) += intrinsicHessians[band](row, column);
+          }
+        }
+      }
+
+      // Only the upper triangle was accumulated.  Fill in the rest,
+      // and apply the same factor of two as GradientFunctionLM.
+      for(std::size_t row = 0; row < numberOfParameters; ++row) {
+        dEdX[row] *= FloatType(2.0);
+        for(std::size_t column = row; column < numberOfParameters;
+            ++column) {
+          d2EdX2(row, column) *= FloatType(2.0);
+          d2EdX2(column, row) = d2EdX2(row, column);
+        }
+      }
+    }
+
+
+    template <class Intrinsics>
+    brick::numeric::Array1D<typename Intrinsics::FloatType>
+    CalibrationObjectiveMultiView<Intrinsics>::
+    computeResiduals(ParameterVectorType const& theta)
+    {
+      if(theta.size() != this->getNumberOfParameters()) {
+        BRICK_THROW(brick::common::ValueException,
+                    "CalibrationObjectiveMultiView::computeResiduals()",
+                    "Parameter vector has the wrong size.");
+      }
+      this->setIntrinsics(theta);
+
+      brick::numeric::Array1D<FloatType> residuals(
+        this->getNumberOfResiduals());
+      brick::common::parallelFor(
+        0, m_views.size(), m_numberOfThreads,
+        [&](std::size_t bandBegin, std::size_t bandEnd,
+            std::size_t /* band */) {
+          for(std::size_t viewIndex = bandBegin; viewIndex < bandEnd;
+              ++viewIndex) {
+            View const& view = m_views[viewIndex];
+            std::size_t const offset =
+              m_numberOfIntrinsicParameters + 7 * viewIndex;
+            brick::numeric::Quaternion<FloatType> quaternion(
+              theta[offset], theta[offset + 1], theta[offset + 2],
+              theta[offset + 3]);
+            brick::numeric::Transform3D<FloatType> cameraTworld =
+              brick::numeric::quaternionToTransform3D(quaternion);
+            cameraTworld.setValue(0, 3, theta[offset + 4]);
+            cameraTworld.setValue(1, 3, theta[offset + 5]);
+            cameraTworld.setValue(2, 3, theta[offset + 6]);
+
+            FloatType* residualPtr = residuals.data(view.residualOffset);
+            for(std::size_t ii = 0; ii < view.points3D.size(); ++ii) {
+              brick::numeric::Vector2D<FloatType> projectedPoint =
+                m_intrinsics.project(cameraTworld * view.points3D[ii]);
+              *(residualPtr++) = projectedPoint.x() - view.points2D[ii].x();
+              *(residualPtr++) = projectedPoint.y() - view.points2D[ii].y();
+            }
+          }
+        });
+      return residuals;
+    }
+
+
+    template <class Intrinsics>
+    void
+    CalibrationObjectiveMultiView<Intrinsics>::
+    getCalibration(
+      ParameterVectorType const& theta,
+      Intrinsics& intrinsics,
+      std::vector< brick::numeric::Transform3D<FloatType> >&
+        cameraTworldVector) const
+    {
+      if(theta.size() != this->getNumberOfParameters()) {
+        BRICK_THROW(brick::common::ValueException,
+                    "CalibrationObjectiveMultiView::getCalibration()",
+                    "Parameter vector has the wrong size.");
+      }
+      ParameterVectorType intrinsicParameters(m_numberOfIntrinsicParameters);
+      std::copy(theta.begin(), theta.begin() + m_numberOfIntrinsicParameters,
+                intrinsicParameters.begin());
+      intrinsics = m_intrinsics;
+      intrinsics.setParameters(intrinsicParameters);
+
+      cameraTworldVector.resize(m_views.size());
+      for(std::size_t viewIndex = 0; viewIndex < m_views.size();
+          ++viewIndex) {
+        std::size_t const offset =
+          m_numberOfIntrinsicParameters + 7 * viewIndex;
+        brick::numeric::Quaternion<FloatType> quaternion(
+          theta[offset], theta[offset + 1], theta[offset + 2],
+          theta[offset + 3]);
+        cameraTworldVector[viewIndex] =
+          brick::numeric::quaternionToTransform3D(quaternion);
+        cameraTworldVector[viewIndex].setValue(0, 3, theta[offset + 4]);
+        cameraTworldVector[viewIndex].setValue(1, 3, theta[offset + 5]);
+        cameraTworldVector[viewIndex].setValue(2, 3, theta[offset + 6]);
+      }
+    }
+
+
+    template <class Intrinsics>
+    typename CalibrationObjectiveMultiView<Intrinsics>::ParameterVectorType
+    CalibrationObjectiveMultiView<Intrinsics>::
+    getParameters(
+      Intrinsics const& intrinsics,
+      std::vector< brick::numeric::Transform3D<FloatType> > const&
+        cameraTworldVector) const
+    {
+      ParameterVectorType intrinsicParameters = intrinsics.getParameters();
+      if(intrinsicParameters.size() != m_numberOfIntrinsicParameters) {
+        BRICK_THROW(brick::common::ValueException,
+                    "CalibrationObjectiveMultiView::getParameters()",
+                    "Intrinsics have the wrong number of parameters.");
+      }
+      if(cameraTworldVector.size() != m_views.size()) {
+        BRICK_THROW(brick::common::ValueException,
+                    "CalibrationObjectiveMultiView::getParameters()",
+                    "There must be exactly one pose for each view.");
+      }
+
+      ParameterVectorType theta(this->getNumberOfParameters());
+      std::copy(intrinsicParameters.begin(), intrinsicParameters.end(),
+                theta.begin());
+      for(std::size_t viewIndex = 0; viewIndex < m_views.size();
+          ++viewIndex) {
+        std::size_t const offset =
+          m_numberOfIntrinsicParameters + 7 * viewIndex;
+        brick::numeric::Transform3D<FloatType> const& cameraTworld =
+          cameraTworldVector[viewIndex];
+        brick::numeric::Quaternion<FloatType> quaternion =
+          brick::numeric::transform3DToQuaternion(cameraTworld);
+        theta[offset] = quaternion.s();
+        theta[offset + 1] = quaternion.i();
+        theta[offset + 2] = quaternion.j();
+        theta[offset + 3] = quaternion.k();
+        theta[offset + 4] = cameraTworld(0, 3);
+        theta[offset + 5] = cameraTworld(1, 3);
+        theta[offset + 6] = cameraTworld(2, 3);
+      }
+      return theta;
+    }
+
+
+    template <class Intrinsics>
+    typename Intrinsics::FloatType
+    CalibrationObjectiveMultiView<Intrinsics>::
+    operator()(ParameterVectorType const& theta)
+    {
+      brick::numeric::Array1D<FloatType> residuals =
+        this->computeResiduals(theta);
+      FloatType sumOfSquares(0.0);
+      for(std::size_t ii = 0; ii < residuals.size(); ++ii) {
+        sumOfSquares += residuals[ii] * residuals[ii];
+      }
+      return sumOfSquares;
+    }
+
+
+    template <class Intrinsics>
+    void
+    CalibrationObjectiveMultiView<Intrinsics>::
+    accumulateView(ParameterVectorType const& theta,
+                   std::size_t viewIndex,
+                   ParameterVectorType& dEdX,
+                   brick::numeric::Array2D<FloatType>& d2EdX2,
+                   brick::numeric::Array1D<FloatType>& intrinsicGradient,
+                   brick::numeric::Array2D<FloatType>& intrinsicHessian,
+                   brick::numeric::Array2D<FloatType>& dPixelDIntrinsics,
+                   brick::numeric::Array2D<FloatType>& dPixelDPoint) const
+    {
+      std::size_t const numberOfIntrinsics = m_numberOfIntrinsicParameters;
+      std::size_t const offset = numberOfIntrinsics + 7 * viewIndex;
+      View const& view = m_views[viewIndex];
+
+      // The rotation is M(q) / |q|^2, where M is the homogeneous
+      // quadratic form that reduces to the usual rotation matrix for
+      // unit quaternions.
+      FloatType const qS = theta[offset];
+      FloatType const qI = theta[offset + 1];
+      FloatType const qJ = theta[offset + 2];
+      FloatType const qK = theta[offset + 3];
+      FloatType const tX = theta[offset + 4];
+      FloatType const tY = theta[offset + 5];
+      FloatType const tZ = theta[offset + 6];
+      FloatType const normSquared = qS * qS + qI * qI + qJ * qJ + qK * qK;
+      if(normSquared == FloatType(0.0)) {
+        BRICK_THROW(brick::common::ValueException,
+                    "CalibrationObjectiveMultiView::accumulateView()",
+                    "Quaternion must be nonzero.");
+      }
+      FloatType const inverseNorm = FloatType(1.0) / normSquared;
+      FloatType const m00 = qS * qS + qI * qI - qJ * qJ - qK * qK;
+      FloatType const m01 = 2.0 * (qI * qJ - qS * qK);
+      FloatType const m02 = 2.0 * (qI * qK + qS * qJ);
+      FloatType const m10 = 2.0 * (qI * qJ + qS * qK);
+      FloatType const m11 = qS * qS - qI * qI + qJ * qJ - qK * qK;
+      FloatType const m12 = 2.0 * (qJ * qK - qS * qI);
+      FloatType const m20 = 2.0 * (qI * qK - qS * qJ);
+      FloatType const m21 = 2.0 * (qJ * qK + qS * qI);
+      FloatType const m22 = qS * qS - qI * qI - qJ * qJ + qK * qK;
+
+      // Jacobians of the camera coordinate point with respect to the
+      // pose, and of the residual with respect to the pose.
+      FloatType dPointDPose[3][7];
+      FloatType dPixelDPose[2][7];
+      for(std::size_t ii = 0; ii < 3; ++ii) {
+        for(std::size_t jj = 4; jj < 7; ++jj) {
+          dPointDPose[ii][jj] = (ii + 4 == jj) ? 1.0 : 0.0;
+        }
+      }
+
+      brick::numeric::Vector3D<FloatType> cameraPoint;
+      brick::numeric::Vector2D<FloatType> pixel;
+      for(std::size_t pointIndex = 0; pointIndex < view.points3D.size();
+          ++pointIndex) {
+        FloatType const xx = view.points3D[pointIndex].x();
+        FloatType const yy = view.points3D[pointIndex].y();
+        FloatType const zz = view.points3D[pointIndex].z();
+
+        // Rotated point, R * X.
+        FloatType const rX = (m00 * xx + m01 * yy + m02 * zz) * inverseNorm;
+        FloatType const rY = (m10 * xx + m11 * yy + m12 * zz) * inverseNorm;
+        FloatType const rZ = (m20 * xx + m21 * yy + m22 * zz) * inverseNorm;
+        cameraPoint.setValue(rX + tX, rY + tY, rZ + tZ);
+
+        // d(R * X) / dq = (dM/dq * X - 2 * q * (R * X)) / |q|^2.
+        FloatType const a0 = 2.0 * (qS * xx - qK * yy + qJ * zz);
+        FloatType const a1 = 2.0 * (qK * xx + qS * yy - qI * zz);
+        FloatType const a2 = 2.0 * (-qJ * xx + qI * yy + qS * zz);
+        FloatType const b0 = 2.0 * (qI * xx + qJ * yy + qK * zz);
+        FloatType const b1 = 2.0 * (qJ * xx - qI * yy - qS * zz);
+        FloatType const b2 = 2.0 * (qK * xx + qS * yy - qI * zz);
+        dPointDPose[0][0] = (a0 - 2.0 * qS * rX) * inverseNorm;
+        dPointDPose[1][0] = (a1 - 2.0 * qS * rY) * inverseNorm;
+        dPointDPose[2][0] = (a2 - 2.0 * qS * rZ) * inverseNorm;
+        dPointDPose[0][1] = (b0 - 2.0 * qI * rX) * inverseNorm;
+        dPointDPose[1][1] = (b1 - 2.0 * qI * rY) * inverseNorm;
+        dPointDPose[2][1] = (b2 - 2.0 * qI * rZ) * inverseNorm;
+        dPointDPose[0][2] = (a2 - 2.0 * qJ * rX) * inverseNorm;
+        dPointDPose[1][2] = (b0 - 2.0 * qJ * rY) * inverseNorm;
+        dPointDPose[2][2] = (-a0 - 2.0 * qJ * rZ) * inverseNorm;
+        dPointDPose[0][3] = (-a1 - 2.0 * qK * rX) * inverseNorm;
+        dPointDPose[1][3] = (a0 - 2.0 * qK * rY) * inverseNorm;
+        dPointDPose[2][3] = (b0 - 2.0 * qK * rZ) * inverseNorm;
+
+        m_intrinsics.projectWithJacobian(
+          cameraPoint, pixel, dPixelDIntrinsics, dPixelDPoint);
+        FloatType const residual[2] = {
+          pixel.x() - view.points2D[pointIndex].x(),
+          pixel.y() - view.points2D[pointIndex].y()
+        };
+
+        for(std::size_t row = 0; row < 2; ++row) {
+          for(std::size_t column = 0; column < 7; ++column) {
+            dPixelDPose[row][column] =
+              dPixelDPoint(row, 0) * dPointDPose[0][column]
+              + dPixelDPoint(row, 1) * dPointDPose[1][column]
+              + dPixelDPoint(row, 2) * dPointDPose[2][column];
+          }
+        }
+
+        // Intrinsic block, shared between views.
+        for(std::size_t ii = 0; ii < numberOfIntrinsics; ++ii) {
+          FloatType const dU = dPixelDIntrinsics(0, ii);
+          FloatType const dV = dPixelDIntrinsics(1, ii);
+          intrinsicGradient[ii] += dU * residual[0] + dV * residual[1];
+          for(std::size_t jj = ii; jj < numberOfIntrinsics; ++jj) {
+            intrinsicHessian(ii, jj) +=
+              dU * dPixelDIntrinsics(0, jj) + dV * dPixelDIntrinsics(1, jj);
+          }
+
+          // Intrinsic/pose cross terms, which belong to this view.
+          for(std::size_t jj = 0; jj < 7; ++jj) {
+            d2EdX2(ii, offset + jj) +=
+              dU * dPixelDPose[0][jj] + dV * dPixelDPose[1][jj];
+          }
+        }
+
+        // Pose block, which belongs to this view.
+        for(std::size_t ii = 0; ii < 7; ++ii) {
+          dEdX[offset + ii] +=
+            dPixelDPose[0][ii] * residual[0] + dPixelDPose[1][ii] * residual[1];
+          for(std::size_t jj = ii; jj < 7; ++jj) {
+            d2EdX2(offset + ii, offset + jj) +=
+              dPixelDPose[0][ii] * dPixelDPose[0][jj]
+              + dPixelDPose[1][ii] * dPixelDPose[1][jj];
+          }
+        }
+      }
+    }
+
+
+    template <class Intrinsics>
+    void
+    CalibrationObjectiveMultiView<Intrinsics>::
+    setIntrinsics(ParameterVectorType const& theta)
+    {
+      ParameterVectorType intrinsicParameters(m_numberOfIntrinsicParameters);
+      std::copy(theta.begin(), theta.begin() + m_numberOfIntrinsicParameters,
+                intrinsicParameters.begin());
+      m_intrinsics.setParameters(intrinsicParameters);
+    }
+
+  } // namespace computerVision
+
+} // namespace brick
+
+#endif /* #ifndef BRICK_COMPUTERVISION_CALIBRATIONOBJECTIVEMULTIVIEW_IMPL_HH */
@@ -13,9 +13,12 @@
 #ifndef BRICK_COMPUTERVISION_CALIBRATIONTOOLS_HH
 #define BRICK_COMPUTERVISION_CALIBRATIONTOOLS_HH
 
+#include <vector>
 #include <brick/computerVision/cameraIntrinsicsPinhole.hh>
 #include <brick/geometry/circle3D.hh>
 #include <brick/numeric/transform3D.hh>
+#include <brick/numeric/vector2D.hh>
+#include <brick/numeric/vector3D.hh>
 
 namespace brick {
 
@@ -303,6 +306,67 @@ namespace brick {
       int verbosity = 0);
 
 
+    /**
+     * This function refines camera intrinsic parameters, and the
+     * camera pose for each of several views of a calibration target,
+     * by minimizing reprojection error over all views at once.  It
+     * differs from estimateCameraParameters() in that it jointly
+     * uses many views, and in that it requires an initial guess.
+     * The initial guess for each view can come, for example, from
+     * running estimateCameraParameters() on that view alone.
+     * Derivatives are computed analytically, views are evaluated in
+     * parallel, and the normal equations are accumulated directly
+     * (see CalibrationObjectiveMultiView), so this function scales
+     * to hundreds of views.
+     *
+     * @param intrinsics This argument specifies the initial guess
+     * for the camera intrinsics, and is used to return the refined
+     * intrinsics.  Its type must provide projectWithJacobian(), as
+     * CameraIntrinsicsPlumbBob and CameraIntrinsicsRational do.
+     *
+     * @param cameraTworldVector This argument specifies the initial
+     * guess for the pose of each view, and is used to return the
+     * refined poses.  Each pose takes world coordinates and returns
+     * the corresponding camera coordinates.
+     *
+     * @param statistics This reference argument is used to return
+     * information about the calibration result.  The Hessian matrix
+     * has one unconstrained axis per view (the magnitude of its
+     * quaternion), so pass the number of views to
+     * statistics.getConditionNumber().
+     *
+     * @param points3DVector This argument contains, for each view,
+     * 3D points in world coordinates.
+     *
+     * @param points2DVector This argument contains, for each view,
+     * the pixel coordinates of the corresponding elements of
+     * points3DVector.
+     *
+     * @param numberOfThreads This argument specifies how many threads
+     * should share the work.  Setting it to zero uses one thread per
+     * available processor.
+     *
+     * @param verbosity This argument sets the level of standard
+     * output generated by the function call (0 means none).
+     */
+    template <class Intrinsics>
+    void
+    estimateCameraParametersMultiView(
+      Intrinsics& intrinsics,
+      std::vector< numeric::Transform3D<typename Intrinsics::FloatType> >&
+        cameraTworldVector,
+      CameraParameterEstimationStatistics<typename Intrinsics::FloatType>&
+        statistics,
+      std::vector< std::vector<
+        numeric::Vector3D<typename Intrinsics::FloatType> > > const&
+        points3DVector,
+      std::vector< std::vector<
+        numeric::Vector2D<typename Intrinsics::FloatType> > > const&
+        points2DVector,
+      unsigned int numberOfThreads = 1,
+      int verbosity = 0);
+
+
     /**
      * This function estimates pinhole camera intrinsic and extrinsic
      * parameters based on corresponding points in 2D image
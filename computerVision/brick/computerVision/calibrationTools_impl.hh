@@ -22,6 +22,7 @@
 #include <limits>
 
 #include <brick/common/constants.hh>
+#include <brick/computerVision/calibrationObjectiveMultiView.hh>
 #include <brick/geometry/triangle2D.hh>
 #include <brick/geometry/utilities2D.hh>
 #include <brick/linearAlgebra/linearAlgebra.hh>
@@ -1010,6 +1011,74 @@ namespace brick {
     }
 
 
+    template <class Intrinsics>
+    void
+    estimateCameraParametersMultiView(
+      Intrinsics& intrinsics,
+      std::vector< numeric::Transform3D<typename Intrinsics::FloatType> >&
+        cameraTworldVector,
+      CameraParameterEstimationStatistics<typename Intrinsics::FloatType>&
+        statistics,
+      std::vector< std::vector<
+        numeric::Vector3D<typename Intrinsics::FloatType> > > const&
+        points3DVector,
+      std::vector< std::vector<
+        numeric::Vector2D<typename Intrinsics::FloatType> > > const&
+        points2DVector,
+      unsigned int numberOfThreads,
+      int verbosity)
+    {
+      typedef typename Intrinsics::FloatType FloatType;
+      typedef CalibrationObjectiveMultiView<Intrinsics> ObjectiveFunction;
+
+      if(points3DVector.size() != cameraTworldVector.size()
+         || points2DVector.size() != cameraTworldVector.size()) {
+        BRICK_THROW(brick::common::ValueException,
+                    "estimateCameraParametersMultiView()",
+                    "There must be one pose and one set of 2D and 3D "
+                    "points for each view.");
+      }
+
+      ObjectiveFunction objectiveFunction(intrinsics, numberOfThreads);
+      for(std::size_t ii = 0; ii < points3DVector.size(); ++ii) {
+        if(points2DVector[ii].size() != points3DVector[ii].size()) {
+          BRICK_THROW(brick::common::ValueException,
+                      "estimateCameraParametersMultiView()",
+                      "Each view must have the same number of 2D and "
+                      "3D points.");
+        }
+        objectiveFunction.addView(points3DVector[ii].begin(),
+                                  points3DVector[ii].end(),
+                                  points2DVector[ii].begin());
+      }
+      typename Intrinsics::ParameterVectorType allParameters =
+        objectiveFunction.getParameters(intrinsics, cameraTworldVector);
+
+      // Run the optimization.  The objective supplies its own
+      // derivatives, so there's no need for GradientFunctionLM.
+      OptimizerLM<ObjectiveFunction, FloatType> optimizerLM(objectiveFunction);
+      optimizerLM.setMaxIterations(100);
+      optimizerLM.setMaxLambda(1.0E15);
+      optimizerLM.setMinDrop(1.0E-6);
+      optimizerLM.setVerbosity(verbosity);
+      optimizerLM.setStartPoint(allParameters);
+      allParameters = optimizerLM.optimum();
+
+      // Communicate the result back to the calling context.
+      objectiveFunction.getCalibration(
+        allParameters, intrinsics, cameraTworldVector);
+
+      // ...including convergence statistics.
+      brick::numeric::Array1D<FloatType> gradient;
+      brick::numeric::Array2D<FloatType> hessian;
+      objectiveFunction.computeGradientAndHessian(
+        allParameters, gradient, hessian);
+      statistics.setStatistics(
+        objectiveFunction.computeResiduals(allParameters), allParameters,
+        hessian);
+    }
+
+
     template <class FloatType, class Iter3D, class Iter2D>
     void
     estimateCameraParametersPinhole(
@@ -660,6 +660,120 @@ namespace brick {
     }
 
 
+    // This member function projects a point into pixel coordinates,
+    // and computes the Jacobian of the projection with respect to
+    // the intrinsic parameters and the input point.
+    template <class FloatType>
+    void
+    CameraIntrinsicsPlumbBob<FloatType>::
+    projectWithJacobian(
+      brick::numeric::Vector3D<FloatType> const& point,
+      brick::numeric::Vector2D<FloatType>& pixel,
+      brick::numeric::Array2D<FloatType>& dPixelDParameters,
+      brick::numeric::Array2D<FloatType>& dPixelDPoint) const
+    {
+      brick::common::UInt32 const numParameters =
+        (4 + 4
+         + (m_allowSixthOrderRadial ? 1 : 0)
+         + (m_allowSkew ? 1 : 0));
+      if(dPixelDParameters.rows() != 2
+         || dPixelDParameters.columns() != numParameters) {
+        dPixelDParameters.reinit(2, numParameters);
+      }
+      if(dPixelDPoint.rows() != 2 || dPixelDPoint.columns() != 3) {
+        dPixelDPoint.reinit(2, 3);
+      }
+
+      // Perspective division.
+      FloatType inverseZ = FloatType(1.0) / point.z();
+      FloatType xNorm = point.x() * inverseZ;
+      FloatType yNorm = point.y() * inverseZ;
+
+      // Distortion and skew, and their derivatives with respect to
+      // the normalized coordinates.
+      FloatType xDistorted;
+      FloatType yDistorted;
+      FloatType dXDdX;
+      FloatType dXDdY;
+      FloatType dYDdX;
+      FloatType dYDdY;
+      this->projectThroughDistortionWithPartialDerivatives(
+        xNorm, yNorm, xDistorted, yDistorted, dXDdX, dXDdY, dYDdX, dYDdY);
+
+      FloatType kX = this->getFocalLengthX();
+      FloatType kY = this->getFocalLengthY();
+      pixel.setValue(kX * xDistorted + this->getCenterU(),
+                     kY * yDistorted + this->getCenterV());
+
+      // Chain rule through the perspective division.
+      FloatType dUdX = kX * dXDdX;
+      FloatType dUdY = kX * dXDdY;
+      FloatType dVdX = kY * dYDdX;
+      FloatType dVdY = kY * dYDdY;
+      dPixelDPoint(0, 0) = dUdX * inverseZ;
+      dPixelDPoint(0, 1) = dUdY * inverseZ;
+      dPixelDPoint(0, 2) = -(dUdX * xNorm + dUdY * yNorm) * inverseZ;
+      dPixelDPoint(1, 0) = dVdX * inverseZ;
+      dPixelDPoint(1, 1) = dVdY * inverseZ;
+      dPixelDPoint(1, 2) = -(dVdX * xNorm + dVdY * yNorm) * inverseZ;
+
+      // Each distortion coefficient moves the pre-skew point by
+      // (dx, dy), which moves the pixel by (kX * (dx + skew * dy),
+      // kY * dy).
+      FloatType xSquared = xNorm * xNorm;
+      FloatType ySquared = yNorm * yNorm;
+      FloatType rSquared = xSquared + ySquared;
+      FloatType rFourth = rSquared * rSquared;
+      FloatType rSixth = rSquared * rFourth;
+      FloatType crossTerm = 2.0 * xNorm * yNorm;
+      FloatType uRadial = kX * (xNorm + m_skewCoefficient * yNorm);
+      FloatType vRadial = kY * yNorm;
+
+      // Pinhole parameters.
+      dPixelDParameters(0, 0) = xDistorted;
+      dPixelDParameters(1, 0) = 0.0;
+      dPixelDParameters(0, 1) = 0.0;
+      dPixelDParameters(1, 1) = yDistorted;
+      dPixelDParameters(0, 2) = 1.0;
+      dPixelDParameters(1, 2) = 0.0;
+      dPixelDParameters(0, 3) = 0.0;
+      dPixelDParameters(1, 3) = 1.0;
+
+      // Radial coefficients.
+      unsigned int column = 4;
+      dPixelDParameters(0, column) = uRadial * rSquared;
+      dPixelDParameters(1, column) = vRadial * rSquared;
+      ++column;
+      dPixelDParameters(0, column) = uRadial * rFourth;
+      dPixelDParameters(1, column) = vRadial * rFourth;
+      ++column;
+      if(m_allowSixthOrderRadial) {
+        dPixelDParameters(0, column) = uRadial * rSixth;
+        dPixelDParameters(1, column) = vRadial * rSixth;
+        ++column;
+      }
+
+      // Skew multiplies the distorted (pre-skew) y coordinate, which
+      // is the same as the final one.
+      if(m_allowSkew) {
+        dPixelDParameters(0, column) = kX * yDistorted;
+        dPixelDParameters(1, column) = 0.0;
+        ++column;
+      }
+
+      // Tangential coefficients.
+      FloatType dYDT0 = rSquared + 2.0 * ySquared;
+      FloatType dXDT1 = rSquared + 2.0 * xSquared;
+      dPixelDParameters(0, column) =
+        kX * (crossTerm + m_skewCoefficient * dYDT0);
+      dPixelDParameters(1, column) = kY * dYDT0;
+      ++column;
+      dPixelDParameters(0, column) =
+        kX * (dXDT1 + m_skewCoefficient * crossTerm);
+      dPixelDParameters(1, column) = kY * crossTerm;
+    }
+
+
     template <class FloatType>
     bool
     reverseProjectWithJacobian(
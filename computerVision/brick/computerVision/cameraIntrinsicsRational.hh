@@ -17,6 +17,7 @@
 #include <iostream>
 #include <brick/computerVision/cameraIntrinsicsDistortedPinhole.hh>
 #include <brick/numeric/array1D.hh>
+#include <brick/numeric/array2D.hh>
 #include <brick/numeric/utilities.hh>
 
 namespace brick {
@@ -359,6 +360,40 @@ namespace brick {
         FloatType& dYDdX, FloatType& dYDdY) const;
 
 
+      /**
+       * This member function projects a point from 3D camera
+       * coordinates into pixel coordinates, and also computes the
+       * Jacobian of the projection with respect to the intrinsic
+       * parameters and with respect to the input point.  It is
+       * provided for calibration routines that use analytic
+       * derivatives, such as CalibrationObjectiveMultiView.
+       *
+       * @param point This argument specifies the 3D point to be
+       * projected.  Its Z coordinate must be nonzero.
+       *
+       * @param pixel This argument returns the projected point in
+       * pixel coordinates.
+       *
+       * @param dPixelDParameters This argument returns a 2x12 array in which element (i, j) is the partial
+       * derivative of pixel coordinate i (u, then v) with respect
+       * to element j of the vector returned by getParameters().
+       * It is reallocated only if it has the wrong shape, so
+       * repeated calls with the same array do not allocate.
+       *
+       * @param dPixelDPoint This argument returns a 2x3 array in
+       * which element (i, j) is the partial derivative of pixel
+       * coordinate i with respect to coordinate j (x, y, then z) of
+       * the input point.  It is reallocated only if it has the wrong
+       * shape.
+       */
+      void
+      projectWithJacobian(
+        numeric::Vector3D<FloatType> const& point,
+        numeric::Vector2D<FloatType>& pixel,
+        numeric::Array2D<FloatType>& dPixelDParameters,
+        numeric::Array2D<FloatType>& dPixelDPoint) const;
+
+
       /**
        * This member function sets the calibration from an input
        * stream.  *this is modified only if the read was successful,
@@ -631,6 +631,116 @@ namespace brick {
     }
 
 
+    // This member function projects a point into pixel coordinates,
+    // and computes the Jacobian of the projection with respect to
+    // the intrinsic parameters and the input point.
+    template <class FloatType>
+    void
+    CameraIntrinsicsRational<FloatType>::
+    projectWithJacobian(
+      brick::numeric::Vector3D<FloatType> const& point,
+      brick::numeric::Vector2D<FloatType>& pixel,
+      brick::numeric::Array2D<FloatType>& dPixelDParameters,
+      brick::numeric::Array2D<FloatType>& dPixelDPoint) const
+    {
+      brick::common::UInt32 constexpr numParameters = 4 + 8;
+      if(dPixelDParameters.rows() != 2
+         || dPixelDParameters.columns() != numParameters) {
+        dPixelDParameters.reinit(2, numParameters);
+      }
+      if(dPixelDPoint.rows() != 2 || dPixelDPoint.columns() != 3) {
+        dPixelDPoint.reinit(2, 3);
+      }
+
+      // Perspective division.
+      FloatType inverseZ = FloatType(1.0) / point.z();
+      FloatType xNorm = point.x() * inverseZ;
+      FloatType yNorm = point.y() * inverseZ;
+
+      // Distortion, and its derivatives with respect to the
+      // normalized coordinates.
+      FloatType xDistorted;
+      FloatType yDistorted;
+      FloatType dXDdX;
+      FloatType dXDdY;
+      FloatType dYDdX;
+      FloatType dYDdY;
+      this->projectThroughDistortionWithPartialDerivatives(
+        xNorm, yNorm, xDistorted, yDistorted, dXDdX, dXDdY, dYDdX, dYDdY);
+
+      FloatType kX = this->getFocalLengthX();
+      FloatType kY = this->getFocalLengthY();
+      pixel.setValue(kX * xDistorted + this->getCenterU(),
+                     kY * yDistorted + this->getCenterV());
+
+      // Chain rule through the perspective division.
+      FloatType dUdX = kX * dXDdX;
+      FloatType dUdY = kX * dXDdY;
+      FloatType dVdX = kY * dYDdX;
+      FloatType dVdY = kY * dYDdY;
+      dPixelDPoint(0, 0) = dUdX * inverseZ;
+      dPixelDPoint(0, 1) = dUdY * inverseZ;
+      dPixelDPoint(0, 2) = -(dUdX * xNorm + dUdY * yNorm) * inverseZ;
+      dPixelDPoint(1, 0) = dVdX * inverseZ;
+      dPixelDPoint(1, 1) = dVdY * inverseZ;
+      dPixelDPoint(1, 2) = -(dVdX * xNorm + dVdY * yNorm) * inverseZ;
+
+      // Derivatives of the radial distortion factor, N / D, with
+      // respect to the numerator and denominator coefficients.
+      FloatType xSquared = xNorm * xNorm;
+      FloatType ySquared = yNorm * yNorm;
+      FloatType rSquared = xSquared + ySquared;
+      FloatType rFourth = rSquared * rSquared;
+      FloatType rSixth = rSquared * rFourth;
+      FloatType radialDistortionNumerator =
+        (1.0 + m_radialCoefficient0 * rSquared
+         + m_radialCoefficient1 * rFourth
+         + m_radialCoefficient2 * rSixth);
+      FloatType inverseDenominator = FloatType(1.0) /
+        (1.0 + m_radialCoefficient3 * rSquared
+         + m_radialCoefficient4 * rFourth
+         + m_radialCoefficient5 * rSixth);
+      FloatType radialDistortion =
+        radialDistortionNumerator * inverseDenominator;
+      FloatType dRadialDNumerator = inverseDenominator;
+      FloatType dRadialDDenominator = -radialDistortion * inverseDenominator;
+
+      FloatType uScale = kX * xNorm;
+      FloatType vScale = kY * yNorm;
+      FloatType crossTerm = 2.0 * xNorm * yNorm;
+
+      // Pinhole parameters.
+      dPixelDParameters(0, 0) = xDistorted;
+      dPixelDParameters(1, 0) = 0.0;
+      dPixelDParameters(0, 1) = 0.0;
+      dPixelDParameters(1, 1) = yDistorted;
+      dPixelDParameters(0, 2) = 1.0;
+      dPixelDParameters(1, 2) = 0.0;
+      dPixelDParameters(0, 3) = 0.0;
+      dPixelDParameters(1, 3) = 1.0;
+
+      // Radial coefficients.
+      dPixelDParameters(0, 4) = uScale * dRadialDNumerator * rSquared;
+      dPixelDParameters(1, 4) = vScale * dRadialDNumerator * rSquared;
+      dPixelDParameters(0, 5) = uScale * dRadialDNumerator * rFourth;
+      dPixelDParameters(1, 5) = vScale * dRadialDNumerator * rFourth;
+      dPixelDParameters(0, 6) = uScale * dRadialDNumerator * rSixth;
+      dPixelDParameters(1, 6) = vScale * dRadialDNumerator * rSixth;
+      dPixelDParameters(0, 7) = uScale * dRadialDDenominator * rSquared;
+      dPixelDParameters(1, 7) = vScale * dRadialDDenominator * rSquared;
+      dPixelDParameters(0, 8) = uScale * dRadialDDenominator * rFourth;
+      dPixelDParameters(1, 8) = vScale * dRadialDDenominator * rFourth;
+      dPixelDParameters(0, 9) = uScale * dRadialDDenominator * rSixth;
+      dPixelDParameters(1, 9) = vScale * dRadialDDenominator * rSixth;
+
+      // Tangential coefficients.
+      dPixelDParameters(0, 10) = kX * crossTerm;
+      dPixelDParameters(1, 10) = kY * (rSquared + 2.0 * ySquared);
+      dPixelDParameters(0, 11) = kX * (rSquared + 2.0 * xSquared);
+      dPixelDParameters(1, 11) = kY * crossTerm;
+    }
+
+
     template <class FloatType>
     bool
     reverseProjectWithJacobian(
@@ -124,6 +124,70 @@ namespace brick {
                FloatType autoUpperThresholdFactor = 3.0,
                FloatType autoLowerThresholdFactor = 0.0);
 
+
+    /**
+     * This function applies the canny edge detector to the input
+     * image, producing the same edge map as applyCanny(), but with
+     * far less memory traffic.  The one difference is at the image
+     * border: when given explicit thresholds, applyCanny() treats
+     * the zero padding around the blurred image as an edge, and can
+     * grow edges inward from it, while this function always ignores
+     * the padded border (as applyCanny() does when it chooses its
+     * thresholds automatically).  Rather than
+     * allocating full-size images for the blurred input, each
+     * gradient component, the gradient magnitude, and the
+     * non-maximum-suppressed magnitude, it works through the image in
+     * strips of a few dozen rows, carrying each strip through
+     * smoothing, gradient computation, and non-maximum suppression
+     * while the data is still in cache.  The only full-size
+     * intermediate is a one-byte-per-pixel map of edge candidates.
+     * Hysteresis thresholding then grows edges from the strong
+     * candidates using an explicit stack, first within each strip in
+     * parallel, and then across strip boundaries.
+     *
+     * If either threshold is computed automatically, the gradient
+     * magnitude and direction for the whole image are needed before
+     * any thresholding can be done, so in that case one full-size
+     * magnitude array and one byte per pixel of direction are kept.
+     *
+     * Pixels within (gaussianSize + 1) / 2 (and at least one) pixels
+     * of the image border are never reported as edges.
+     *
+     * @param inputImage This argument is the image to be
+     * edge-detected.  It must have a grayscale pixel format.
+     *
+     * @param gaussianSize This argument has the same meaning as for
+     * applyCanny().
+     *
+     * @param upperThreshold This argument has the same meaning as for
+     * applyCanny().
+     *
+     * @param lowerThreshold This argument has the same meaning as for
+     * applyCanny().
+     *
+     * @param autoUpperThresholdFactor This argument has the same
+     * meaning as for applyCanny().
+     *
+     * @param autoLowerThresholdFactor This argument has the same
+     * meaning as for applyCanny().
+     *
+     * @param numberOfThreads This argument specifies how many threads
+     * should share the work.  Setting it to zero uses one thread per
+     * available processor.
+     *
+     * @return The return value is a binary image in which all edge
+     * pixels are true, and all non-edge pixels are false.
+     */
+    template <class FloatType, ImageFormat FORMAT>
+    Image<GRAY1>
+    applyCannyStreaming(const Image<FORMAT>& inputImage,
+                        unsigned int gaussianSize = 5,
+                        FloatType upperThreshold = 0.0,
+                        FloatType lowerThreshold = 0.0,
+                        FloatType autoUpperThresholdFactor = 3.0,
+                        FloatType autoLowerThresholdFactor = 0.0,
+                        unsigned int numberOfThreads = 1);
+
   } // namespace computerVision
 
 } // namespace brick
@@ -18,8 +18,12 @@
 //
 // #include <brick/computerVision/canny.hh>
 
+#include <algorithm>
 #include <limits>
 #include <list>
+#include <vector>
+#include <brick/common/parallelFor.hh>
+#include <brick/common/types.hh>
 #include <brick/computerVision/imageFilter.hh>
 #include <brick/computerVision/kernels.hh>
 #include <brick/computerVision/nonMaximumSuppress.hh>
@@ -141,6 +145,245 @@ namespace brick {
         return edgeImage;
       }
 
+
+      // Number of image rows that applyCannyStreaming() carries
+      // through smoothing, differentiation, and non-maximum
+      // suppression at once.
+      const size_t cannyStripRows = 32;
+
+
+      // Values of the edge candidate map used by
+      // applyCannyStreaming().
+      enum CannyLabel {
+        CANNY_NONE = 0,
+        CANNY_WEAK = 1,
+        CANNY_EDGE = 2
+      };
+
+
+      // Per-thread scratch space for cannyGetGradientRows().
+      template <class FloatType>
+      struct CannyScratch {
+        std::vector<FloatType> horizontalRows;
+        std::vector<FloatType> blurredRows;
+      };
+
+
+      // Quantizes gradient direction exactly as nonMaximumSuppress()
+      // does: 0 for horizontal, 1 for vertical, 2 for the diagonal
+      // running down and to the right, and 3 for the other diagonal.
+      template <class FloatType>
+      inline brick::common::UInt8
+      cannyGetDirection(FloatType gradX, FloatType gradY)
+      {
+        if(gradX == FloatType(0)) {
+          return 1;
+        }
+        brick::common::UInt8 majorDirection = 0;
+        FloatType indicator;
+        if(brick::common::absoluteValue(gradX)
+           >= brick::common::absoluteValue(gradY)) {
+          indicator = gradY / gradX;
+        } else {
+          indicator = gradX / gradY;
+          majorDirection = 1;
+        }
+        if(indicator >= FloatType(0.5)) {
+          return 2;
+        }
+        if(indicator < FloatType(-0.5)) {
+          return 3;
+        }
+        return majorDirection;
+      }
+
+
+      // Computes gradient magnitude and quantized direction for image
+      // rows [rowBegin, rowEnd), writing them with a stride of
+      // inputImage.columns().  Smoothing matches filter2D() with a
+      // fill value of zero, and differentiation matches the interior
+      // of applySobelX() and applySobelY().  Magnitudes within margin
+      // of the image border are set to zero.
+      template <class FloatType, ImageFormat FORMAT>
+      void
+      cannyGetGradientRows(
+        const Image<FORMAT>& inputImage,
+        const brick::numeric::Array1D<FloatType>& rowKernel,
+        const brick::numeric::Array1D<FloatType>& columnKernel,
+        size_t margin, size_t rowBegin, size_t rowEnd,
+        CannyScratch<FloatType>& scratch,
+        FloatType* magnitudePtr,
+        brick::common::UInt8* directionPtr)
+      {
+        size_t const rows = inputImage.rows();
+        size_t const columns = inputImage.columns();
+        std::fill(magnitudePtr, magnitudePtr + (rowEnd - rowBegin) * columns,
+                  FloatType(0));
+        std::fill(directionPtr, directionPtr + (rowEnd - rowBegin) * columns,
+                  brick::common::UInt8(0));
+
+        size_t const firstRow = std::max(rowBegin, margin);
+        size_t const lastRow = std::min(rowEnd, rows - margin);
+        if(firstRow >= lastRow || 2 * margin >= columns) {
+          return;
+        }
+
+        // Blur rows [firstRow - 1, lastRow + 1).
+        size_t const blurBegin = firstRow - 1;
+        size_t const blurEnd = lastRow + 1;
+        scratch.blurredRows.resize((blurEnd - blurBegin) * columns);
+        FloatType* blurredPtr = &(scratch.blurredRows[0]);
+        if(rowKernel.size() == 0) {
+          for(size_t row = blurBegin; row < blurEnd; ++row) {
+            FloatType* outputPtr = blurredPtr + (row - blurBegin) * columns;
+            for(size_t column = 0; column < columns; ++column) {
+              outputPtr[column] = static_cast<FloatType>(inputImage(row, column));
+            }
+          }
+        } else {
+          std::fill(scratch.blurredRows.begin(), scratch.blurredRows.end(),
+                    FloatType(0));
+          size_t const halfRow = rowKernel.size() / 2;
+          size_t const halfColumn = columnKernel.size() / 2;
+          size_t const validBegin = std::max(blurBegin, halfColumn);
+          size_t const validEnd = std::min(blurEnd, rows - halfColumn);
+          if(validBegin < validEnd && 2 * halfRow < columns) {
+            // Horizontal pass over just the input rows we need.
+            size_t const horizontalBegin = validBegin - halfColumn;
+            size_t const horizontalEnd = validEnd + halfColumn;
+            scratch.horizontalRows.resize(
+              (horizontalEnd - horizontalBegin) * columns);
+            for(size_t row = horizontalBegin; row < horizontalEnd; ++row) {
+              FloatType* outputPtr =
+                &(scratch.horizontalRows[(row - horizontalBegin) * columns]);
+              for(size_t column = halfRow; column < columns - halfRow;
+                  ++column) {
+                FloatType sum = FloatType(0);
+                for(size_t kk = 0; kk < rowKernel.size(); ++kk) {
+                  sum += rowKernel[kk] * static_cast<FloatType>(
+                    inputImage(row, column - halfRow + kk));
+                }
+                outputPtr[column] = sum;
+              }
+            }
+
+            // Vertical pass, accumulating whole rows at a time.
+            for(size_t row = validBegin; row < validEnd; ++row) {
+              FloatType* outputPtr = blurredPtr + (row - blurBegin) * columns;
+              for(size_t kk = 0; kk < columnKernel.size(); ++kk) {
+                FloatType const weight = columnKernel[kk];
+                FloatType const* inputPtr = &(scratch.horizontalRows[
+                    (row - halfColumn + kk - horizontalBegin) * columns]);
+                for(size_t column = halfRow; column < columns - halfRow;
+                    ++column) {
+                  outputPtr[column] += weight * inputPtr[column];
+                }
+              }
+            }
+          }
+        }
+
+        // Differentiate.
+        for(size_t row = firstRow; row < lastRow; ++row) {
+          FloatType const* abovePtr = blurredPtr + (row - 1 - blurBegin) * columns;
+          FloatType const* currentPtr = abovePtr + columns;
+          FloatType const* belowPtr = currentPtr + columns;
+          FloatType* outputPtr = magnitudePtr + (row - rowBegin) * columns;
+          brick::common::UInt8* outputDirectionPtr =
+            directionPtr + (row - rowBegin) * columns;
+          for(size_t column = margin; column < columns - margin; ++column) {
+            FloatType const gradX =
+              (abovePtr[column + 1] - abovePtr[column - 1])
+              + 2 * (currentPtr[column + 1] - currentPtr[column - 1])
+              + (belowPtr[column + 1] - belowPtr[column - 1]);
+            FloatType const gradY =
+              (belowPtr[column - 1] - abovePtr[column - 1])
+              + 2 * (belowPtr[column] - abovePtr[column])
+              + (belowPtr[column + 1] - abovePtr[column + 1]);
+            outputPtr[column] =
+              brick::common::squareRoot(gradX * gradX + gradY * gradY);
+            outputDirectionPtr[column] = cannyGetDirection(gradX, gradY);
+          }
+        }
+      }
+
+
+      // Non-maximum suppression and double thresholding of image rows
+      // [rowBegin, rowEnd).  Arguments magnitudePtr and directionPtr
+      // point to image row gradientBegin, which must be at most
+      // rowBegin - 1 (unless rowBegin is zero), and must be followed
+      // by at least rowEnd - rowBegin + 1 rows.
+      template <class FloatType>
+      void
+      cannySuppressRows(FloatType const* magnitudePtr,
+                        brick::common::UInt8 const* directionPtr,
+                        size_t gradientBegin, size_t rowBegin, size_t rowEnd,
+                        FloatType lowerThreshold, FloatType upperThreshold,
+                        brick::numeric::Array2D<brick::common::UInt8>& labels)
+      {
+        size_t const rows = labels.rows();
+        size_t const columns = labels.columns();
+        std::ptrdiff_t const offsets[4] = {
+          1, static_cast<std::ptrdiff_t>(columns),
+          static_cast<std::ptrdiff_t>(columns) + 1,
+          static_cast<std::ptrdiff_t>(columns) - 1};
+        for(size_t row = rowBegin; row < rowEnd; ++row) {
+          brick::common::UInt8* labelPtr = labels.data(row, 0);
+          std::fill(labelPtr, labelPtr + columns,
+                    brick::common::UInt8(CANNY_NONE));
+          if(row == 0 || row + 1 >= rows) {
+            continue;
+          }
+          FloatType const* currentPtr =
+            magnitudePtr + (row - gradientBegin) * columns;
+          brick::common::UInt8 const* currentDirectionPtr =
+            directionPtr + (row - gradientBegin) * columns;
+          for(size_t column = 1; column + 1 < columns; ++column) {
+            FloatType const magnitude = currentPtr[column];
+            if(magnitude > lowerThreshold) {
+              std::ptrdiff_t const offset = offsets[currentDirectionPtr[column]];
+              if(magnitude > currentPtr[column + offset]
+                 && magnitude > currentPtr[column - offset]) {
+                labelPtr[column] = (magnitude > upperThreshold)
+                  ? CANNY_EDGE : CANNY_WEAK;
+              }
+            }
+          }
+        }
+      }
+
+
+      // Grows edges from the pixels on the stack into 8-connected
+      // weak candidates, without leaving rows [rowBegin, rowEnd).
+      // Candidates are never found in the outermost rows or columns
+      // of the image, so no other bounds checking is needed.
+      inline void
+      cannyGrowEdges(brick::numeric::Array2D<brick::common::UInt8>& labels,
+                     size_t rowBegin, size_t rowEnd,
+                     std::vector<size_t>& stack)
+      {
+        size_t const columns = labels.columns();
+        brick::common::UInt8* labelPtr = labels.data();
+        while(!stack.empty()) {
+          size_t const index0 = stack.back();
+          stack.pop_back();
+          size_t const row = index0 / columns;
+          size_t const neighborRowBegin = (row > rowBegin) ? row - 1 : row;
+          size_t const neighborRowEnd = (row + 1 < rowEnd) ? row + 2 : row + 1;
+          for(size_t neighborRow = neighborRowBegin;
+              neighborRow < neighborRowEnd; ++neighborRow) {
+            size_t neighborIndex = index0 + neighborRow * columns
+              - row * columns - 1;
+            for(size_t kk = 0; kk < 3; ++kk, ++neighborIndex) {
+              if(labelPtr[neighborIndex] == CANNY_WEAK) {
+                labelPtr[neighborIndex] = CANNY_EDGE;
+                stack.push_back(neighborIndex);
+              }
+            }
+          }
+        }
+      }
+
     } // namespace privateCode
     /// @endcond
 
@@ -216,12 +459,11 @@ namespace brick {
 
       // Step 2: Compute derivatives of the blurred image, and discard
       // any which are less than the lower threshold.
-      Image<ImageFormatIdentifierGray<FloatType>::Format> gradX =
-        applySobelX(blurredImage);
-      Image<ImageFormatIdentifierGray<FloatType>::Format> gradY =
-        applySobelY(blurredImage);
-      Image<ImageFormatIdentifierGray<FloatType>::Format> gradMagnitude(
-          gradX.rows(), gradX.columns());
+      // The fused Sobel pass reads the blurred image only once.
+      Image<ImageFormatIdentifierGray<FloatType>::Format> gradX;
+      Image<ImageFormatIdentifierGray<FloatType>::Format> gradY;
+      Image<ImageFormatIdentifierGray<FloatType>::Format> gradMagnitude;
+      applySobel(blurredImage, gradX, gradY, gradMagnitude);
 
       // Communicate gradients to the calling context.
       gradientX = gradX;
@@ -230,17 +472,13 @@ namespace brick {
       // Continue with Canny algorithm.
       if(lowerThreshold > 0.0 && upperThreshold > 0.0) {
         // Discard values less than the lower threshold.
-        for(size_t index0 = 0; index0 < gradX.size(); ++index0) {
-          FloatType tmpVal = brick::common::squareRoot(
-            gradX[index0] * gradX[index0] + gradY[index0] * gradY[index0]);
+        for(size_t index0 = 0; index0 < gradMagnitude.size(); ++index0) {
+          FloatType tmpVal = gradMagnitude[index0];
           gradMagnitude[index0] = (tmpVal > lowerThreshold) ? tmpVal : 0.0;
         }
       } else {
-        // Temporarily retain all gradient values.
-        for(size_t index0 = 0; index0 < gradX.size(); ++index0) {
-          gradMagnitude[index0] = brick::common::squareRoot(
-            gradX[index0] * gradX[index0] + gradY[index0] * gradY[index0]);
-        }
+        // All gradient values are retained for now.  The fused Sobel
+        // pass above has already filled in gradMagnitude.
 
         // Pick edge thresholds.
         size_t startRow = (gaussianSize + 1) / 2;
@@ -329,6 +567,205 @@ namespace brick {
       return edgeImage;
     }
 
+
+    // This function applies the canny edge operator, working through
+    // the image in strips.
+    template <class FloatType, ImageFormat FORMAT>
+    Image<GRAY1>
+    applyCannyStreaming(const Image<FORMAT>& inputImage,
+                        unsigned int gaussianSize,
+                        FloatType upperThreshold,
+                        FloatType lowerThreshold,
+                        FloatType autoUpperThresholdFactor,
+                        FloatType autoLowerThresholdFactor,
+                        unsigned int numberOfThreads)
+    {
+      // Argument checking.
+      if(inputImage.rows() < gaussianSize + 3
+         || inputImage.columns() < gaussianSize + 3) {
+        BRICK_THROW(brick::common::ValueException, "applyCannyStreaming()",
+                    "Argument inputImage has insufficient size, or argument "
+                    "gaussianSize is too large.");
+      }
+      if(lowerThreshold > upperThreshold) {
+        BRICK_THROW(brick::common::ValueException, "applyCannyStreaming()",
+                    "Argument lowerThreshold must be less than or equal to "
+                    "Arguments upperThreshold.");
+      }
+      autoLowerThresholdFactor =
+        std::min(autoLowerThresholdFactor, autoUpperThresholdFactor);
+
+      // See applyCanny() for an explanation of this scale factor.
+      FloatType scaleFactor = static_cast<FloatType>(std::sqrt(2.0) * 8.0);
+      lowerThreshold *= scaleFactor;
+      upperThreshold *= scaleFactor;
+
+      size_t const rows = inputImage.rows();
+      size_t const columns = inputImage.columns();
+      size_t const stripRows = privateCode::cannyStripRows;
+      size_t const numberOfStrips = (rows + stripRows - 1) / stripRows;
+      size_t const margin = std::max(size_t(1), size_t((gaussianSize + 1) / 2));
+
+      brick::numeric::Array1D<FloatType> rowKernel;
+      brick::numeric::Array1D<FloatType> columnKernel;
+      if(gaussianSize != 0) {
+        Kernel<FloatType> gaussian =
+          getGaussianKernelBySize<FloatType>(gaussianSize, gaussianSize);
+        rowKernel = gaussian.getRowComponent();
+        columnKernel = gaussian.getColumnComponent();
+      }
+
+      // Steps 1 - 3: Blur, differentiate, and suppress non-maxima,
+      // leaving a map of weak and strong edge candidates.
+      brick::numeric::Array2D<brick::common::UInt8> labels(rows, columns);
+      if(lowerThreshold > 0.0 && upperThreshold > 0.0) {
+        // Thresholds are known, so each strip can go all the way
+        // through in one go.  Each strip needs gradients for one
+        // extra row above and below.
+        brick::common::parallelFor(
+          size_t(0), numberOfStrips, numberOfThreads,
+          [&](size_t bandBegin, size_t bandEnd, unsigned int) {
+            privateCode::CannyScratch<FloatType> scratch;
+            std::vector<FloatType> magnitudes((stripRows + 2) * columns);
+            std::vector<brick::common::UInt8> directions(
+              (stripRows + 2) * columns);
+            for(size_t strip = bandBegin; strip < bandEnd; ++strip) {
+              size_t const rowBegin = strip * stripRows;
+              size_t const rowEnd = std::min(rowBegin + stripRows, rows);
+              size_t const gradientBegin = (rowBegin == 0) ? 0 : rowBegin - 1;
+              size_t const gradientEnd = std::min(rowEnd + 1, rows);
+              privateCode::cannyGetGradientRows(
+                inputImage, rowKernel, columnKernel, margin,
+                gradientBegin, gradientEnd, scratch,
+                &(magnitudes[0]), &(directions[0]));
+              privateCode::cannySuppressRows(
+                &(magnitudes[0]), &(directions[0]), gradientBegin,
+                rowBegin, rowEnd, lowerThreshold, upperThreshold, labels);
+            }
+          });
+      } else {
+        // Thresholds depend on gradient statistics for the whole
+        // image, so gradients must be kept until they're known.
+        brick::numeric::Array2D<FloatType> magnitudes(rows, columns);
+        brick::numeric::Array2D<brick::common::UInt8> directions(
+          rows, columns);
+        size_t const numberOfBands =
+          brick::common::getNumberOfBands(numberOfStrips, numberOfThreads);
+        std::vector<FloatType> partialSums(numberOfBands, FloatType(0));
+        std::vector<FloatType> partialSumsOfSquares(numberOfBands, FloatType(0));
+        brick::common::parallelFor(
+          size_t(0), numberOfStrips, numberOfThreads,
+          [&](size_t bandBegin, size_t bandEnd, unsigned int band) {
+            privateCode::CannyScratch<FloatType> scratch;
+            for(size_t strip = bandBegin; strip < bandEnd; ++strip) {
+              size_t const rowBegin = strip * stripRows;
+              size_t const rowEnd = std::min(rowBegin + stripRows, rows);
+              privateCode::cannyGetGradientRows(
+                inputImage, rowKernel, columnKernel, margin,
+                rowBegin, rowEnd, scratch,
+                magnitudes.data(rowBegin, 0), directions.data(rowBegin, 0));
+              for(size_t row = std::max(rowBegin, margin);
+                  row < std::min(rowEnd, rows - margin); ++row) {
+                FloatType const* magnitudePtr = magnitudes.data(row, 0);
+                FloatType subSum = 0.0;
+                FloatType subSumOfSquares = 0.0;
+                for(size_t column = margin; column < columns - margin;
+                    ++column) {
+                  subSum += magnitudePtr[column];
+                  subSumOfSquares += magnitudePtr[column] * magnitudePtr[column];
+                }
+                partialSums[band] += subSum;
+                partialSumsOfSquares[band] += subSumOfSquares;
+              }
+            }
+          });
+
+        // Pick edge thresholds.
+        size_t numberOfPixels = (rows - 2 * margin) * (columns - 2 * margin);
+        FloatType sumOfGradient = 0.0;
+        FloatType sumOfGradientSquared = 0.0;
+        for(size_t band = 0; band < numberOfBands; ++band) {
+          sumOfGradient += partialSums[band];
+          sumOfGradientSquared += partialSumsOfSquares[band];
+        }
+        FloatType gradientMean = sumOfGradient / numberOfPixels;
+        FloatType gradientVariance =
+          sumOfGradientSquared / numberOfPixels - gradientMean * gradientMean;
+        FloatType gradientSigma = brick::common::squareRoot(
+          std::max(gradientVariance, FloatType(0)));
+        if(upperThreshold <= 0.0) {
+          upperThreshold =
+            gradientMean + autoUpperThresholdFactor * gradientSigma;
+          upperThreshold = std::max(upperThreshold, FloatType(0));
+        }
+        if(lowerThreshold <= 0.0) {
+          lowerThreshold =
+            gradientMean + autoLowerThresholdFactor * gradientSigma;
+          lowerThreshold = std::min(lowerThreshold, upperThreshold);
+          lowerThreshold = std::max(lowerThreshold, FloatType(0));
+        }
+
+        brick::common::parallelFor(
+          size_t(0), numberOfStrips, numberOfThreads,
+          [&](size_t bandBegin, size_t bandEnd, unsigned int) {
+            size_t const rowBegin = bandBegin * stripRows;
+            size_t const rowEnd = std::min(bandEnd * stripRows, rows);
+            privateCode::cannySuppressRows(
+              magnitudes.data(), directions.data(), 0, rowBegin, rowEnd,
+              lowerThreshold, upperThreshold, labels);
+          });
+      }
+
+      // Step 4: Threshold with hysteresis.  Grow edges within each
+      // strip in parallel...
+      brick::common::parallelFor(
+        size_t(0), numberOfStrips, numberOfThreads,
+        [&](size_t bandBegin, size_t bandEnd, unsigned int) {
+          std::vector<size_t> stack;
+          for(size_t strip = bandBegin; strip < bandEnd; ++strip) {
+            size_t const rowBegin = strip * stripRows;
+            size_t const rowEnd = std::min(rowBegin + stripRows, rows);
+            for(size_t index0 = rowBegin * columns; index0 < rowEnd * columns;
+                ++index0) {
+              if(labels(index0) == privateCode::CANNY_EDGE) {
+                stack.push_back(index0);
+              }
+            }
+            privateCode::cannyGrowEdges(labels, rowBegin, rowEnd, stack);
+          }
+        });
+
+      // ...then let edges that reach a strip boundary continue into
+      // the neighboring strip, and follow them wherever they lead.
+      std::vector<size_t> stack;
+      for(size_t strip = 1; strip < numberOfStrips; ++strip) {
+        size_t const upperRow = strip * stripRows - 1;
+        for(size_t column = 1; column + 1 < columns; ++column) {
+          size_t const upperIndex = upperRow * columns + column;
+          size_t const lowerIndex = upperIndex + columns;
+          for(size_t kk = 0; kk < 3; ++kk) {
+            if(labels(upperIndex) == privateCode::CANNY_EDGE
+               && labels(lowerIndex + kk - 1) == privateCode::CANNY_WEAK) {
+              labels(lowerIndex + kk - 1) = privateCode::CANNY_EDGE;
+              stack.push_back(lowerIndex + kk - 1);
+            }
+            if(labels(lowerIndex) == privateCode::CANNY_EDGE
+               && labels(upperIndex + kk - 1) == privateCode::CANNY_WEAK) {
+              labels(upperIndex + kk - 1) = privateCode::CANNY_EDGE;
+              stack.push_back(upperIndex + kk - 1);
+            }
+          }
+        }
+      }
+      privateCode::cannyGrowEdges(labels, 0, rows, stack);
+
+      Image<GRAY1> edgeImage(rows, columns);
+      for(size_t index0 = 0; index0 < labels.size(); ++index0) {
+        edgeImage[index0] = (labels[index0] == privateCode::CANNY_EDGE);
+      }
+      return edgeImage;
+    }
+
   } // namespace computerVision
 
 } // namespace brick
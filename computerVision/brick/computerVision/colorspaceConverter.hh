@@ -13,6 +13,7 @@
 #ifndef BRICK_COMPUTERVISION_COLORSPACECONVERTER_HH
 #define BRICK_COMPUTERVISION_COLORSPACECONVERTER_HH
 
+#include <cstddef>
 #include <functional>
 #include <brick/computerVision/imageFormat.hh>
 #include <brick/computerVision/image.hh>
@@ -99,6 +100,36 @@ namespace brick {
           static_cast<typename Image<FORMAT1>::PixelType>(inputPixel);
       }
 
+
+      /**
+       * This member function converts a contiguous run of pixels, such
+       * as one row of an image.  It gives exactly the same results as
+       * calling operator()() for each pixel, but some format
+       * combinations are specialized in the implementation file to
+       * use lookup tables or simplified arithmetic, so this is the
+       * fastest way to convert many pixels.  Function
+       * convertColorspace() uses this member function.
+       *
+       * @param inputPixels This argument points to the first pixel to
+       * be converted.
+       *
+       * @param outputPixels This argument points to the location to
+       * which the first converted pixel should be written.  The
+       * output run must not overlap the input run.
+       *
+       * @param numberOfPixels This argument specifies how many pixels
+       * to convert.
+       */
+      inline
+      void
+      convertRow(const typename Image<FORMAT0>::PixelType* inputPixels,
+                 typename Image<FORMAT1>::PixelType* outputPixels,
+                 size_t numberOfPixels) {
+        for(size_t ii = 0; ii < numberOfPixels; ++ii) {
+          this->operator()(inputPixels[ii], outputPixels[ii]);
+        }
+      }
+
     };
 
   } // namespace computerVision
@@ -19,6 +19,7 @@
 //
 // #include <brick/computerVision/colorspaceConverter.hh>
 
+#include <algorithm>
 #include <cmath>
 
 #include <brick/common/mathFunctions.hh>
@@ -161,6 +162,72 @@ namespace brick {
         outputPixel.blue = blue + increment;
       }
 
+
+      // Lookup tables used by the RGB8 -> GRAY8 row conversion below.
+      // Each entry is computed with exactly the same expression as in
+      // the per-pixel conversion, so results are bit-for-bit
+      // identical, but the row conversion avoids three int-to-double
+      // conversions and three multiplies per pixel.
+      struct RGB8ToGray8Tables {
+        RGB8ToGray8Tables() {
+          for(int ii = 0; ii < 256; ++ii) {
+            red[ii] = 0.3 * ii;
+            green[ii] = 0.59 * ii;
+            blue[ii] = 0.11 * ii;
+          }
+        }
+
+        double red[256];
+        double green[256];
+        double blue[256];
+      };
+
+
+      inline RGB8ToGray8Tables const&
+      getRGB8ToGray8Tables()
+      {
+        static RGB8ToGray8Tables const tables;
+        return tables;
+      }
+
+
+      // Lookup tables used by the RGB8 -> YIQ_FLOAT64 row conversion
+      // below.  As above, entries match the per-pixel conversion
+      // exactly.
+      struct RGB8ToYIQTables {
+        RGB8ToYIQTables() {
+          for(int ii = 0; ii < 256; ++ii) {
+            lumaRed[ii] = (0.299 / 255.0) * ii;
+            lumaGreen[ii] = (0.587 / 255.0) * ii;
+            lumaBlue[ii] = (0.114 / 255.0) * ii;
+            inPhaseRed[ii] = (0.595716 / 255.0) * ii;
+            inPhaseGreen[ii] = (0.274453 / 255.0) * ii;
+            inPhaseBlue[ii] = (0.321263 / 255.0) * ii;
+            quadratureRed[ii] = (0.211456 / 255.0) * ii;
+            quadratureGreen[ii] = (0.522591 / 255.0) * ii;
+            quadratureBlue[ii] = (0.311135 / 255.0) * ii;
+          }
+        }
+
+        double lumaRed[256];
+        double lumaGreen[256];
+        double lumaBlue[256];
+        double inPhaseRed[256];
+        double inPhaseGreen[256];
+        double inPhaseBlue[256];
+        double quadratureRed[256];
+        double quadratureGreen[256];
+        double quadratureBlue[256];
+      };
+
+
+      inline RGB8ToYIQTables const&
+      getRGB8ToYIQTables()
+      {
+        static RGB8ToYIQTables const tables;
+        return tables;
+      }
+
     } // namespace privateCode
 
 
@@ -555,6 +622,103 @@ namespace brick {
 
 
 
+    template<>
+    inline
+    void
+    ColorspaceConverter<RGB8, GRAY8>::
+    convertRow(const Image<RGB8>::PixelType* inputPixels,
+               Image<GRAY8>::PixelType* outputPixels,
+               size_t numberOfPixels)
+    {
+      privateCode::RGB8ToGray8Tables const& tables =
+        privateCode::getRGB8ToGray8Tables();
+      for(size_t ii = 0; ii < numberOfPixels; ++ii) {
+        double accumulator = (tables.red[inputPixels[ii].red]
+                              + tables.green[inputPixels[ii].green]
+                              + tables.blue[inputPixels[ii].blue]);
+        outputPixels[ii] =
+          static_cast<Image<GRAY8>::PixelType>(accumulator + 0.5);
+      }
+    }
+
+
+    template<>
+    inline
+    void
+    ColorspaceConverter<RGB8, HSV_FLOAT64>::
+    convertRow(const Image<RGB8>::PixelType* inputPixels,
+               Image<HSV_FLOAT64>::PixelType* outputPixels,
+               size_t numberOfPixels)
+    {
+      // Same arithmetic as privateCode::doColorspaceConversion(), but
+      // the max/min and channel comparisons are done on the 8-bit
+      // values, and there's no intermediate RGB_FLOAT64 pixel.
+      for(size_t ii = 0; ii < numberOfPixels; ++ii) {
+        int red = inputPixels[ii].red;
+        int green = inputPixels[ii].green;
+        int blue = inputPixels[ii].blue;
+        int maxInt = std::max(red, std::max(green, blue));
+        int minInt = std::min(red, std::min(green, blue));
+        brick::common::Float64 maxVal =
+          static_cast<brick::common::Float64>(maxInt);
+        brick::common::Float64 delta =
+          static_cast<brick::common::Float64>(maxInt - minInt);
+        brick::common::Float64 hue = 0.0;
+        brick::common::Float64 saturation = 0.0;
+        if(maxInt != 0) {
+          saturation = delta / maxVal;
+          if(maxInt != minInt) {
+            if(red == maxInt) {
+              hue = (brick::common::Float64(1.0 / 6.0)
+                     + static_cast<brick::common::Float64>(green - blue)
+                     / (6.0 * delta));
+            } else if(green == maxInt) {
+              hue = (brick::common::Float64(0.5)
+                     + static_cast<brick::common::Float64>(blue - red)
+                     / (6.0 * delta));
+            } else {
+              hue = (brick::common::Float64(5.0 / 6.0)
+                     + static_cast<brick::common::Float64>(red - green)
+                     / (6.0 * delta));
+            }
+            hue -= 1.0 / 6.0;
+            hue = (hue < 0.0) ? (hue + 1.0) : hue;
+          }
+        }
+        outputPixels[ii].hue = hue;
+        outputPixels[ii].saturation = saturation;
+        outputPixels[ii].value = maxVal / 255.0;
+      }
+    }
+
+
+    template<>
+    inline
+    void
+    ColorspaceConverter<RGB8, YIQ_FLOAT64>::
+    convertRow(const Image<RGB8>::PixelType* inputPixels,
+               Image<YIQ_FLOAT64>::PixelType* outputPixels,
+               size_t numberOfPixels)
+    {
+      privateCode::RGB8ToYIQTables const& tables =
+        privateCode::getRGB8ToYIQTables();
+      for(size_t ii = 0; ii < numberOfPixels; ++ii) {
+        brick::common::UInt8 red = inputPixels[ii].red;
+        brick::common::UInt8 green = inputPixels[ii].green;
+        brick::common::UInt8 blue = inputPixels[ii].blue;
+        outputPixels[ii].luma = (tables.lumaRed[red]
+                                 + tables.lumaGreen[green]
+                                 + tables.lumaBlue[blue]);
+        outputPixels[ii].inPhase = (tables.inPhaseRed[red]
+                                    - tables.inPhaseGreen[green]
+                                    - tables.inPhaseBlue[blue]);
+        outputPixels[ii].quadrature = (tables.quadratureRed[red]
+                                       - tables.quadratureGreen[green]
+                                       + tables.quadratureBlue[blue]);
+      }
+    }
+
+
   } // namespace computerVision
 
 } // namespace brick
@@ -0,0 +1,134 @@
+/**
+***************************************************************************
+* @file brick/computerVision/fft2D.hh
+*
+* Header file declaring private helpers for frequency domain
+* filtering and correlation, shared by imageFilter.hh and
+* templateMatcherNCC.hh.
+*
+* Copyright (C) 2026 David LaRose, dlr@cs.cmu.edu
+* See accompanying file, LICENSE.TXT, for details.
+*
+***************************************************************************
+*/
+
+#ifndef BRICK_COMPUTERVISION_FFT2D_HH
+#define BRICK_COMPUTERVISION_FFT2D_HH
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <brick/common/parallelFor.hh>
+#include <brick/numeric/array1D.hh>
+#include <brick/numeric/array2D.hh>
+#include <brick/numeric/fft.hh>
+
+namespace brick {
+
+  namespace computerVision {
+
+    /// @cond privateCode
+    namespace privateCode {
+
+      // Returns the smallest power of two that is >= value.  This is
+      // the padded size along one axis, since computeFFT() only
+      // handles power of two lengths.
+      inline std::size_t
+      fft2DNextPowerOfTwo(std::size_t value)
+      {
+        std::size_t result = 1;
+        while(result < value) {
+          result <<= 1;
+        }
+        return result;
+      }
+
+
+      // Returns the approximate cost of one 2D FFT of an image with
+      // the specified size, after padding, in units of one
+      // multiply-add in a direct (spatial domain) correlation.  The
+      // constant fftCostFactor is the approximate cost of one element
+      // of one butterfly stage of computeFFT().
+      inline double
+      fft2DTransformCost(std::size_t rows, std::size_t columns)
+      {
+        double const fftCostFactor = 8.0;
+        double paddedSize = double(
+          fft2DNextPowerOfTwo(rows) * fft2DNextPowerOfTwo(columns));
+        return (fftCostFactor * paddedSize
+                * std::log(paddedSize) / std::log(2.0));
+      }
+
+
+      // Computes the 2D FFT in place, transforming each row, then
+      // each column.  Rows and columns are independent, so they can
+      // be spread across threads.  Both dimensions of data must be
+      // powers of two.
+      template <class ComplexType>
+      void
+      fft2DTransform(brick::numeric::Array2D<ComplexType>& data,
+                     unsigned int numberOfThreads)
+      {
+        std::size_t const rows = data.rows();
+        std::size_t const columns = data.columns();
+        brick::common::parallelFor(
+          0, rows, numberOfThreads,
+          [&](std::size_t rowBegin, std::size_t rowEnd, std::size_t) {
+            brick::numeric::Array1D<ComplexType> signal(columns);
+            for(std::size_t row = rowBegin; row < rowEnd; ++row) {
+              std::copy(data.data(row, 0), data.data(row, 0) + columns,
+                        signal.begin());
+              brick::numeric::Array1D<ComplexType> transformed =
+                brick::numeric::computeFFT(signal);
+              std::copy(transformed.begin(), transformed.end(),
+                        data.data(row, 0));
+            }
+          });
+        brick::common::parallelFor(
+          0, columns, numberOfThreads,
+          [&](std::size_t columnBegin, std::size_t columnEnd, std::size_t) {
+            brick::numeric::Array1D<ComplexType> signal(rows);
+            for(std::size_t column = columnBegin; column < columnEnd;
+                ++column) {
+              for(std::size_t row = 0; row < rows; ++row) {
+                signal[row] = data(row, column);
+              }
+              brick::numeric::Array1D<ComplexType> transformed =
+                brick::numeric::computeFFT(signal);
+              for(std::size_t row = 0; row < rows; ++row) {
+                data(row, column) = transformed[row];
+              }
+            }
+          });
+      }
+
+
+      // Returns the 2D FFT of the input, after zero-padding it to
+      // size (rows, columns), both of which must be powers of two.
+      template <class ComplexType, class InputType>
+      brick::numeric::Array2D<ComplexType>
+      fft2DGetSpectrum(brick::numeric::Array2D<InputType> const& input,
+                       std::size_t rows, std::size_t columns,
+                       unsigned int numberOfThreads)
+      {
+        typedef typename ComplexType::value_type RealType;
+        brick::numeric::Array2D<ComplexType> spectrum(rows, columns);
+        spectrum = ComplexType(0);
+        for(std::size_t row = 0; row < input.rows(); ++row) {
+          for(std::size_t column = 0; column < input.columns(); ++column) {
+            spectrum(row, column) = ComplexType(
+              static_cast<RealType>(input(row, column)));
+          }
+        }
+        fft2DTransform(spectrum, numberOfThreads);
+        return spectrum;
+      }
+
+    } // namespace privateCode
+    /// @endcond
+
+  } // namespace computerVision
+
+} // namespace brick
+
+#endif /* #ifndef BRICK_COMPUTERVISION_FFT2D_HH */
@@ -101,15 +101,52 @@ namespace brick {
 
 
     /**
-     * WARNING(xxx): The essential matrix returned by this funtion is
-     * currently not normalized to reasonable magnitude.  You can
-     * easily get back a matrix in which the average element magnitude
-     * is on the order of 1.0E12.
+     * This function solves the same problem as fivePointAlgorithm(),
+     * but for exactly five point pairs, and without allocating any
+     * memory.  It is intended for the inner loop of RANSAC-style
+     * algorithms, where it is called once per hypothesis.  All
+     * intermediate values are kept in fixed-size arrays on the stack:
+     * the null space of the linear constraints is found by QR
+     * decomposition rather than SVD, the elimination is done in
+     * place, and the real eigenvalues of the 10x10 action matrix are
+     * found by Hessenberg QR iteration, with the corresponding
+     * eigenvectors recovered by inverse iteration, rather than by
+     * calling LAPACK.  Up to scale, the recovered essential matrices
+     * are the same as those returned by fivePointAlgorithm().
      *
+     * @param sequence0Begin This argument is the beginning (in the
+     * STL sense) of a sequence of five calibrated feature points,
+     * represented as brick::numeric::Vector2D instances, from the
+     * first image.  Please see fivePointAlgorithm() for more
+     * information.
+     *
+     * @param sequence1Begin This argument is the beginning of a
+     * sequence of five corresponding calibrated feature points from
+     * the second image.
+     *
+     * @param essentialMatrices This argument is used to return the
+     * candidate essential matrices, one per row, with the elements
+     * of each in row-major order.  Unlike the matrices returned by
+     * fivePointAlgorithm(), each is scaled to have unit Frobenius
+     * norm.
+     *
+     * @return The return value is the number of candidates written
+     * into essentialMatrices, which is at most 10, and will be zero
+     * if the input points are degenerate.
+     */
+    template<class FloatType, class Iterator>
+    size_t
+    fivePointAlgorithmMinimal(Iterator sequence0Begin, Iterator sequence1Begin,
+                              FloatType (&essentialMatrices)[10][9]);
+
+
+    /**
      * Warning: this interface may change.
      *
      * This function implements the two-view robust five-point
-     * algorithm described in section 5 of [2].  Note that our method
+     * algorithm described in section 5 of [2].  Candidate essential
+     * matrices are generated by fivePointAlgorithmMinimal(), so the
+     * returned matrix has unit Frobenius norm.  Note that our method
      * of computing the goodness of a potential solution for the
      * essential matrix involves testing feature point pairs against
      * the (image-space) epipolar constraint.  We do not project
@@ -253,6 +290,124 @@ namespace brick {
       brick::numeric::Vector2D<FloatType>& point1);
 
 
+    /**
+     ** This enum selects the error measure used by
+     ** computeEpipolarErrors() and getEpipolarInliers().  In each
+     ** case, F is the fundamental (or essential) matrix, q is a
+     ** homogeneous point in the first image, and q' is a homogeneous
+     ** point in the second image.
+     **/
+    enum EpipolarErrorType {
+      /// Squared distance from q' to the epipolar line F * q.  This
+      /// is the quantity returned by checkEpipolarConstraint().
+      BRICK_CV_EPIPOLAR_DISTANCE,
+
+      /// First order approximation of the squared geometric
+      /// (reprojection) error: (q'^T F q)^2 divided by the sum of the
+      /// squares of the first two elements of both F * q and F^T * q'.
+      BRICK_CV_SAMPSON_ERROR,
+
+      /// Sum of the squared distance from q' to the epipolar line F *
+      /// q, and the squared distance from q to the epipolar line F^T
+      /// * q'.
+      BRICK_CV_SYMMETRIC_EPIPOLAR_DISTANCE
+    };
+
+
+    /**
+     * This function is a batch version of checkEpipolarConstraint().
+     * It evaluates the epipolar constraint for many correspondences
+     * at once.  Points are passed as separate arrays of x and y
+     * coordinates, rather than as arrays of Vector2D, so that the
+     * inner loop is branch-free and contiguous, and can be
+     * vectorized by the compiler.  Use this when you need to score
+     * every correspondence against each of many candidate matrices,
+     * as in RANSAC.
+     *
+     * @param fundamentalMx This argument is the 3x3 fundamental (or,
+     * for calibrated points, essential) matrix.
+     *
+     * @param xCoords0 This argument holds the x coordinates of the
+     * points in the first image.
+     *
+     * @param yCoords0 This argument holds the y coordinates of the
+     * points in the first image.  It must be the same size as
+     * xCoords0.
+     *
+     * @param xCoords1 This argument holds the x coordinates of the
+     * corresponding points in the second image.  It must be the same
+     * size as xCoords0.
+     *
+     * @param yCoords1 This argument holds the y coordinates of the
+     * corresponding points in the second image.  It must be the same
+     * size as xCoords0.
+     *
+     * @param errors This argument is used to return one error value
+     * per correspondence.  If it is not already the same size as
+     * xCoords0, it will be reinitialized.  Correspondences for which
+     * the error is undefined (because an epipolar line is
+     * degenerate) are assigned std::numeric_limits<FloatType>::max().
+     *
+     * @param errorType This argument selects the error measure.
+     */
+    template <class FloatType>
+    void
+    computeEpipolarErrors(
+      brick::numeric::Array2D<FloatType> const& fundamentalMx,
+      brick::numeric::Array1D<FloatType> const& xCoords0,
+      brick::numeric::Array1D<FloatType> const& yCoords0,
+      brick::numeric::Array1D<FloatType> const& xCoords1,
+      brick::numeric::Array1D<FloatType> const& yCoords1,
+      brick::numeric::Array1D<FloatType>& errors,
+      EpipolarErrorType errorType = BRICK_CV_EPIPOLAR_DISTANCE);
+
+
+    /**
+     * This function works just like computeEpipolarErrors(), but
+     * compares each error against a threshold as it is computed, and
+     * returns the resulting inlier mask instead of the errors
+     * themselves.
+     *
+     * @param fundamentalMx This argument is the 3x3 fundamental (or
+     * essential) matrix.
+     *
+     * @param xCoords0 This argument holds the x coordinates of the
+     * points in the first image.
+     *
+     * @param yCoords0 This argument holds the y coordinates of the
+     * points in the first image.
+     *
+     * @param xCoords1 This argument holds the x coordinates of the
+     * points in the second image.
+     *
+     * @param yCoords1 This argument holds the y coordinates of the
+     * points in the second image.
+     *
+     * @param threshold This argument is the largest error that will
+     * be considered an inlier.
+     *
+     * @param inlierMask This argument is used to return true for each
+     * correspondence whose error is less than or equal to threshold,
+     * and false otherwise.  If it is not already the same size as
+     * xCoords0, it will be reinitialized.
+     *
+     * @param errorType This argument selects the error measure.
+     *
+     * @return The return value is the number of inliers.
+     */
+    template <class FloatType>
+    size_t
+    getEpipolarInliers(
+      brick::numeric::Array2D<FloatType> const& fundamentalMx,
+      brick::numeric::Array1D<FloatType> const& xCoords0,
+      brick::numeric::Array1D<FloatType> const& yCoords0,
+      brick::numeric::Array1D<FloatType> const& xCoords1,
+      brick::numeric::Array1D<FloatType> const& yCoords1,
+      FloatType threshold,
+      brick::numeric::Array1D<bool>& inlierMask,
+      EpipolarErrorType errorType = BRICK_CV_EPIPOLAR_DISTANCE);
+
+
     // WARNING(xxx): We have observed at least one case in which the
     // return value from this function is fishy.  We currently do not
     // trust it.
@@ -279,6 +434,57 @@ namespace brick {
       brick::numeric::Vector2D<FloatType> const& testPointCamera1);
 
 
+    /**
+     * This function is a batch version of
+     * triangulateCalibratedImagePoint().  It computes the same
+     * closest point of approach between corresponding rays, but in
+     * closed form, and for many correspondences at once.  As with
+     * computeEpipolarErrors(), points are passed and returned as
+     * separate coordinate arrays.
+     *
+     * @param c0Tc1 This argument is the coordinate transformation
+     * taking points in the coordinate system of camera 1 to the
+     * coordinate system of camera 0.
+     *
+     * @param xCoords0 This argument holds the x coordinates of the
+     * calibrated image points in camera 0.
+     *
+     * @param yCoords0 This argument holds the y coordinates of the
+     * calibrated image points in camera 0.
+     *
+     * @param xCoords1 This argument holds the x coordinates of the
+     * corresponding calibrated image points in camera 1.
+     *
+     * @param yCoords1 This argument holds the y coordinates of the
+     * corresponding calibrated image points in camera 1.
+     *
+     * @param xCoords3D This argument is used to return the x
+     * coordinates of the triangulated points, in camera 0
+     * coordinates.  It will be reinitialized if it is not already
+     * the right size.
+     *
+     * @param yCoords3D This argument is used to return the y
+     * coordinates of the triangulated points.
+     *
+     * @param zCoords3D This argument is used to return the z
+     * coordinates of the triangulated points.  Where the two rays
+     * are parallel, which would cause
+     * triangulateCalibratedImagePoint() to throw, all three
+     * coordinates are set to quiet NaN.
+     */
+    template <class FloatType>
+    void
+    triangulateCalibratedImagePoints(
+      brick::numeric::Transform3D<FloatType> const& c0Tc1,
+      brick::numeric::Array1D<FloatType> const& xCoords0,
+      brick::numeric::Array1D<FloatType> const& yCoords0,
+      brick::numeric::Array1D<FloatType> const& xCoords1,
+      brick::numeric::Array1D<FloatType> const& yCoords1,
+      brick::numeric::Array1D<FloatType>& xCoords3D,
+      brick::numeric::Array1D<FloatType>& yCoords3D,
+      brick::numeric::Array1D<FloatType>& zCoords3D);
+
+
     /**
      * This function is used internally by fivePointAlgorithm() to
      * generate a 10x20 matrix of coefficients of polynomial
@@ -20,9 +20,11 @@
 //
 // #include <brick/computerVision/fivePointAlgorithm.hh>
 
+#include <algorithm>
 #include <cmath>
 #include <complex>
 #include <limits>
+#include <sstream>
 #include <brick/computerVision/cameraIntrinsicsPinhole.hh>
 #include <brick/computerVision/threePointAlgorithm.hh>
 #include <brick/geometry/ray2D.hh>
@@ -36,6 +38,626 @@ namespace brick {
 
   namespace computerVision {
 
+    /// @cond privateCode
+    namespace privateCode {
+
+      // Error for a single correspondence.  The error type is a
+      // template parameter so that the selection happens outside the
+      // inner loops of the kernels below, leaving them branch-free.
+      template <EpipolarErrorType ErrorType, class FloatType>
+      inline FloatType
+      getEpipolarError(FloatType const (&ff)[9],
+                       FloatType x0, FloatType y0,
+                       FloatType x1, FloatType y1)
+      {
+        // Epipolar line in image 1, l = F * q.
+        FloatType const l0 = ff[0] * x0 + ff[1] * y0 + ff[2];
+        FloatType const l1 = ff[3] * x0 + ff[4] * y0 + ff[5];
+        FloatType const l2 = ff[6] * x0 + ff[7] * y0 + ff[8];
+        FloatType const algebraicError = x1 * l0 + y1 * l1 + l2;
+        FloatType const numerator = algebraicError * algebraicError;
+        FloatType const lineNorm1 = l0 * l0 + l1 * l1;
+        if(ErrorType == BRICK_CV_EPIPOLAR_DISTANCE) {
+          return (lineNorm1 > FloatType(0))
+            ? numerator / lineNorm1 : std::numeric_limits<FloatType>::max();
+        }
+
+        // Epipolar line in image 0, l' = F^T * q'.  Only the first
+        // two elements are needed.
+        FloatType const m0 = ff[0] * x1 + ff[3] * y1 + ff[6];
+        FloatType const m1 = ff[1] * x1 + ff[4] * y1 + ff[7];
+        FloatType const lineNorm0 = m0 * m0 + m1 * m1;
+        if(ErrorType == BRICK_CV_SAMPSON_ERROR) {
+          FloatType const denominator = lineNorm0 + lineNorm1;
+          return (denominator > FloatType(0))
+            ? numerator / denominator : std::numeric_limits<FloatType>::max();
+        }
+        return (lineNorm0 > FloatType(0) && lineNorm1 > FloatType(0))
+          ? numerator / lineNorm0 + numerator / lineNorm1
+          : std::numeric_limits<FloatType>::max();
+      }
+
+
+      template <EpipolarErrorType ErrorType, class FloatType>
+      void
+      computeEpipolarErrorsKernel(FloatType const (&ff)[9],
+                                  FloatType const* x0Ptr,
+                                  FloatType const* y0Ptr,
+                                  FloatType const* x1Ptr,
+                                  FloatType const* y1Ptr,
+                                  size_t numberOfPoints,
+                                  FloatType* outputPtr)
+      {
+        for(size_t ii = 0; ii < numberOfPoints; ++ii) {
+          outputPtr[ii] = getEpipolarError<ErrorType>(
+            ff, x0Ptr[ii], y0Ptr[ii], x1Ptr[ii], y1Ptr[ii]);
+        }
+      }
+
+
+      template <EpipolarErrorType ErrorType, class FloatType>
+      size_t
+      getEpipolarInliersKernel(FloatType const (&ff)[9],
+                               FloatType const* x0Ptr,
+                               FloatType const* y0Ptr,
+                               FloatType const* x1Ptr,
+                               FloatType const* y1Ptr,
+                               size_t numberOfPoints,
+                               FloatType threshold,
+                               bool* outputPtr)
+      {
+        size_t count = 0;
+        for(size_t ii = 0; ii < numberOfPoints; ++ii) {
+          bool const isInlier = getEpipolarError<ErrorType>(
+            ff, x0Ptr[ii], y0Ptr[ii], x1Ptr[ii], y1Ptr[ii]) <= threshold;
+          outputPtr[ii] = isInlier;
+          count += isInlier;
+        }
+        return count;
+      }
+
+
+      template <class FloatType>
+      void
+      checkEpipolarArguments(
+        brick::numeric::Array2D<FloatType> const& fundamentalMx,
+        brick::numeric::Array1D<FloatType> const& xCoords0,
+        brick::numeric::Array1D<FloatType> const& yCoords0,
+        brick::numeric::Array1D<FloatType> const& xCoords1,
+        brick::numeric::Array1D<FloatType> const& yCoords1,
+        char const* functionName)
+      {
+        if(fundamentalMx.rows() != 3 || fundamentalMx.columns() != 3) {
+          std::ostringstream message;
+          message << "Argument fundamentalMx must be 3x3, but is "
+                  << fundamentalMx.rows() << "x" << fundamentalMx.columns()
+                  << ".";
+          BRICK_THROW(brick::common::ValueException, functionName,
+                      message.str().c_str());
+        }
+        if(yCoords0.size() != xCoords0.size()
+           || xCoords1.size() != xCoords0.size()
+           || yCoords1.size() != xCoords0.size()) {
+          BRICK_THROW(brick::common::ValueException, functionName,
+                      "Coordinate arrays must all be the same size.");
+        }
+      }
+
+
+      // A minimal fixed-size matrix with the same element access
+      // syntax as Array2D, so that the automatically generated
+      // constraint code can fill either one.
+      template <class FloatType, size_t Rows, size_t Columns>
+      struct FivePointFixedMatrix {
+        FloatType&
+        operator()(size_t row, size_t column) {
+          return m_data[row][column];
+        }
+
+        FloatType const&
+        operator()(size_t row, size_t column) const {
+          return m_data[row][column];
+        }
+
+        FloatType m_data[Rows][Columns];
+      };
+
+
+      // Defined near the bottom of this file, with the rest of the
+      // automatically generated code.
+      template <class FloatType, class InputType, class OutputType>
+      void
+      fillFivePointConstraintMatrix(InputType const& E0Array,
+                                    InputType const& E1Array,
+                                    InputType const& E2Array,
+                                    InputType const& E3Array,
+                                    OutputType& AMatrix);
+
+
+      // Warning(xxx): The action matrix in Stewenius & Nister's paper
+      // doesn't appear to correspond to degree-then-lexicographic
+      // order of monomials, so columns of the constraint matrix are
+      // shuffled to match it.  See generateFivePointConstraintMatrix().
+      inline size_t const*
+      getFivePointColumnShuffle()
+      {
+        static size_t const shuffle[20] = {
+          0, 1, 3, 6, 2, 4, 7, 5, 8, 9, 10, 11, 13, 12, 14, 15, 16, 17, 18, 19
+        };
+        return shuffle;
+      }
+
+
+      // Finds an orthonormal basis for the null space of the 5x9
+      // matrix of linear constraints on the essential matrix.  This
+      // is the Householder QR decomposition of the transpose of
+      // aMatrix: the last four columns of Q span the null space.
+      // Each basis vector is returned as a 3x3 matrix.
+      template <class FloatType>
+      void
+      getFivePointNullSpace(FloatType const (&aMatrix)[5][9],
+                            FivePointFixedMatrix<FloatType, 3, 3> (&basis)[4])
+      {
+        FloatType qr[9][5];
+        for(size_t ii = 0; ii < 9; ++ii) {
+          for(size_t jj = 0; jj < 5; ++jj) {
+            qr[ii][jj] = aMatrix[jj][ii];
+          }
+        }
+
+        FloatType householder[5][9];
+        FloatType beta[5];
+        for(size_t kk = 0; kk < 5; ++kk) {
+          FloatType normSquared(0);
+          for(size_t ii = kk; ii < 9; ++ii) {
+            normSquared += qr[ii][kk] * qr[ii][kk];
+          }
+          FloatType const norm = std::sqrt(normSquared);
+          FloatType const alpha = (qr[kk][kk] > FloatType(0)) ? -norm : norm;
+          FloatType vectorNormSquared(0);
+          for(size_t ii = 0; ii < 9; ++ii) {
+            householder[kk][ii] = (ii < kk) ? FloatType(0) : qr[ii][kk];
+          }
+          householder[kk][kk] -= alpha;
+          for(size_t ii = kk; ii < 9; ++ii) {
+            vectorNormSquared += householder[kk][ii] * householder[kk][ii];
+          }
+          beta[kk] = (vectorNormSquared > FloatType(0))
+            ? FloatType(2) / vectorNormSquared : FloatType(0);
+
+          for(size_t jj = kk + 1; jj < 5; ++jj) {
+            FloatType dotProduct(0);
+            for(size_t ii = kk; ii < 9; ++ii) {
+              dotProduct += householder[kk][ii] * qr[ii][jj];
+            }
+            dotProduct *= beta[kk];
+            for(size_t ii = kk; ii < 9; ++ii) {
+              qr[ii][jj] -= dotProduct * householder[kk][ii];
+            }
+          }
+        }
+
+        // Q = H_0 * H_1 * ... * H_4, so column j of Q is found by
+        // applying the reflections to e_j in reverse order.
+        for(size_t jj = 0; jj < 4; ++jj) {
+          FloatType column[9];
+          for(size_t ii = 0; ii < 9; ++ii) {
+            column[ii] = (ii == jj + 5) ? FloatType(1) : FloatType(0);
+          }
+          for(size_t kk = 5; kk > 0; --kk) {
+            FloatType dotProduct(0);
+            for(size_t ii = kk - 1; ii < 9; ++ii) {
+              dotProduct += householder[kk - 1][ii] * column[ii];
+            }
+            dotProduct *= beta[kk - 1];
+            for(size_t ii = kk - 1; ii < 9; ++ii) {
+              column[ii] -= dotProduct * householder[kk - 1][ii];
+            }
+          }
+          for(size_t ii = 0; ii < 9; ++ii) {
+            basis[jj](ii / 3, ii % 3) = column[ii];
+          }
+        }
+      }
+
+
+      // Reduces the first ten (shuffled) columns of the 10x20
+      // constraint matrix to the identity by Gauss-Jordan elimination
+      // with partial pivoting, and returns the last ten columns of
+      // the result.  This is the matrix B of fivePointAlgorithm().
+      // Returns false if the constraints are degenerate.
+      template <class FloatType>
+      bool
+      eliminateFivePointConstraints(
+        FivePointFixedMatrix<FloatType, 10, 20> const& constraintMatrix,
+        FloatType (&bMatrix)[10][10])
+      {
+        size_t const* shuffle = getFivePointColumnShuffle();
+        FloatType mm[10][20];
+        for(size_t ii = 0; ii < 10; ++ii) {
+          for(size_t jj = 0; jj < 20; ++jj) {
+            mm[ii][jj] = constraintMatrix(ii, shuffle[jj]);
+          }
+        }
+
+        for(size_t kk = 0; kk < 10; ++kk) {
+          size_t pivotRow = kk;
+          FloatType pivotMagnitude = std::fabs(mm[kk][kk]);
+          for(size_t ii = kk + 1; ii < 10; ++ii) {
+            if(std::fabs(mm[ii][kk]) > pivotMagnitude) {
+              pivotMagnitude = std::fabs(mm[ii][kk]);
+              pivotRow = ii;
+            }
+          }
+          if(!(pivotMagnitude > FloatType(0))) {
+            return false;
+          }
+          if(pivotRow != kk) {
+            for(size_t jj = kk; jj < 20; ++jj) {
+              std::swap(mm[kk][jj], mm[pivotRow][jj]);
+            }
+          }
+          FloatType const scale = FloatType(1) / mm[kk][kk];
+          for(size_t jj = kk + 1; jj < 20; ++jj) {
+            mm[kk][jj] *= scale;
+          }
+          for(size_t ii = 0; ii < 10; ++ii) {
+            FloatType const factor = mm[ii][kk];
+            if(ii == kk || factor == FloatType(0)) {
+              continue;
+            }
+            for(size_t jj = kk + 1; jj < 20; ++jj) {
+              mm[ii][jj] -= factor * mm[kk][jj];
+            }
+          }
+        }
+
+        for(size_t ii = 0; ii < 10; ++ii) {
+          for(size_t jj = 0; jj < 10; ++jj) {
+            bMatrix[ii][jj] = mm[ii][jj + 10];
+          }
+        }
+        return true;
+      }
+
+
+      // Finds the real eigenvalues of a small square matrix, which
+      // is overwritten in the process.  The matrix is balanced,
+      // reduced to upper Hessenberg form by stabilized elementary
+      // similarity transformations, and then deflated by Francis
+      // double shift QR iteration, following the EISPACK routines
+      // BALANC, ELMHES, and HQR.  Returns the number of real
+      // eigenvalues found, or zero if the iteration fails to
+      // converge.
+      template <class FloatType, size_t Size>
+      size_t
+      getFivePointRealEigenvalues(FloatType (&aa)[Size][Size],
+                                  FloatType (&eigenvalues)[Size])
+      {
+        // Balance rows and columns so that their norms are similar.
+        // Scale factors are powers of two, so no rounding is
+        // introduced.
+        bool isBalanced = false;
+        while(!isBalanced) {
+          isBalanced = true;
+          for(size_t ii = 0; ii < Size; ++ii) {
+            FloatType columnNorm(0);
+            FloatType rowNorm(0);
+            for(size_t jj = 0; jj < Size; ++jj) {
+              if(jj != ii) {
+                columnNorm += std::fabs(aa[jj][ii]);
+                rowNorm += std::fabs(aa[ii][jj]);
+              }
+            }
+            if(columnNorm == FloatType(0) || rowNorm == FloatType(0)) {
+              continue;
+            }
+            FloatType const sum = columnNorm + rowNorm;
+            FloatType factor(1);
+            while(columnNorm < rowNorm / FloatType(2)) {
+              factor *= FloatType(2);
+              columnNorm *= FloatType(4);
+            }
+            while(columnNorm > rowNorm * FloatType(2)) {
+              factor /= FloatType(2);
+              columnNorm /= FloatType(4);
+            }
+            if((columnNorm + rowNorm) / factor < FloatType(0.95) * sum) {
+              isBalanced = false;
+              for(size_t jj = 0; jj < Size; ++jj) {
+                aa[ii][jj] /= factor;
+                aa[jj][ii] *= factor;
+              }
+            }
+          }
+        }
+
+        // Reduce to upper Hessenberg form.
+        for(size_t mm = 1; mm + 1 < Size; ++mm) {
+          FloatType pivot(0);
+          size_t pivotRow = mm;
+          for(size_t jj = mm; jj < Size; ++jj) {
+            if(std::fabs(aa[jj][mm - 1]) > std::fabs(pivot)) {
+              pivot = aa[jj][mm - 1];
+              pivotRow = jj;
+            }
+          }
+          if(pivotRow != mm) {
+            for(size_t jj = mm - 1; jj < Size; ++jj) {
+              std::swap(aa[pivotRow][jj], aa[mm][jj]);
+            }
+            for(size_t jj = 0; jj < Size; ++jj) {
+              std::swap(aa[jj][pivotRow], aa[jj][mm]);
+            }
+          }
+          if(pivot == FloatType(0)) {
+            continue;
+          }
+          for(size_t ii = mm + 1; ii < Size; ++ii) {
+            FloatType factor = aa[ii][mm - 1];
+            if(factor == FloatType(0)) {
+              continue;
+            }
+            factor /= pivot;
+            aa[ii][mm - 1] = FloatType(0);
+            for(size_t jj = mm; jj < Size; ++jj) {
+              aa[ii][jj] -= factor * aa[mm][jj];
+            }
+            for(size_t jj = 0; jj < Size; ++jj) {
+              aa[jj][mm] += factor * aa[jj][ii];
+            }
+          }
+        }
+
+        // Francis QR iteration.  Each pass looks for a negligible
+        // subdiagonal element near the bottom of the active block, and
+        // splits off one or two eigenvalues if it finds one.
+        FloatType matrixNorm(0);
+        for(size_t ii = 0; ii < Size; ++ii) {
+          for(size_t jj = (ii > 0 ? ii - 1 : 0); jj < Size; ++jj) {
+            matrixNorm += std::fabs(aa[ii][jj]);
+          }
+        }
+        size_t numberOfEigenvalues = 0;
+        FloatType shiftTotal(0);
+        size_t iterations = 0;
+        long last = static_cast<long>(Size) - 1;
+        while(last >= 0) {
+          long first = last;
+          while(first > 0) {
+            FloatType scale = (std::fabs(aa[first - 1][first - 1])
+                               + std::fabs(aa[first][first]));
+            if(scale == FloatType(0)) {
+              scale = matrixNorm;
+            }
+            if(std::fabs(aa[first][first - 1]) + scale == scale) {
+              aa[first][first - 1] = FloatType(0);
+              break;
+            }
+            --first;
+          }
+
+          FloatType xx = aa[last][last];
+          if(first == last) {
+            eigenvalues[numberOfEigenvalues++] = xx + shiftTotal;
+            --last;
+            iterations = 0;
+            continue;
+          }
+          FloatType yy = aa[last - 1][last - 1];
+          FloatType ww = aa[last][last - 1] * aa[last - 1][last];
+          if(first == last - 1) {
+            // A 2x2 block.  Keep its eigenvalues only if they're real.
+            FloatType const pp = FloatType(0.5) * (yy - xx);
+            FloatType const qq = pp * pp + ww;
+            if(qq >= FloatType(0)) {
+              FloatType zz = std::sqrt(qq);
+              zz = (pp >= FloatType(0)) ? pp + zz : pp - zz;
+              eigenvalues[numberOfEigenvalues++] = xx + shiftTotal + zz;
+              eigenvalues[numberOfEigenvalues++] = shiftTotal
+                + ((zz != FloatType(0)) ? xx - ww / zz : xx);
+            }
+            last -= 2;
+            iterations = 0;
+            continue;
+          }
+
+          if(iterations == 30) {
+            return 0;
+          }
+          if(iterations == 10 || iterations == 20) {
+            // Exceptional shift, to break out of cycles.
+            shiftTotal += xx;
+            for(long ii = 0; ii <= last; ++ii) {
+              aa[ii][ii] -= xx;
+            }
+            FloatType const scale = (std::fabs(aa[last][last - 1])
+                                     + std::fabs(aa[last - 1][last - 2]));
+            xx = yy = FloatType(0.75) * scale;
+            ww = FloatType(-0.4375) * scale * scale;
+          }
+          ++iterations;
+
+          // Look for two consecutive small subdiagonal elements, and
+          // compute the first column of the double shifted matrix.
+          FloatType pp(0);
+          FloatType qq(0);
+          FloatType rr(0);
+          FloatType zz(0);
+          long mm = last - 2;
+          for(; mm >= first; --mm) {
+            zz = aa[mm][mm];
+            rr = xx - zz;
+            FloatType ss = yy - zz;
+            pp = (rr * ss - ww) / aa[mm + 1][mm] + aa[mm][mm + 1];
+            qq = aa[mm + 1][mm + 1] - zz - rr - ss;
+            rr = aa[mm + 2][mm + 1];
+            ss = std::fabs(pp) + std::fabs(qq) + std::fabs(rr);
+            pp /= ss;
+            qq /= ss;
+            rr /= ss;
+            if(mm == first) {
+              break;
+            }
+            FloatType const uu =
+              std::fabs(aa[mm][mm - 1]) * (std::fabs(qq) + std::fabs(rr));
+            FloatType const vv =
+              std::fabs(pp) * (std::fabs(aa[mm - 1][mm - 1]) + std::fabs(zz)
+                               + std::fabs(aa[mm + 1][mm + 1]));
+            if(uu + vv == vv) {
+              break;
+            }
+          }
+          for(long ii = mm + 2; ii <= last; ++ii) {
+            aa[ii][ii - 2] = FloatType(0);
+            if(ii != mm + 2) {
+              aa[ii][ii - 3] = FloatType(0);
+            }
+          }
+
+          // Chase the bulge down the diagonal with 3x3 Householder
+          // reflections.
+          for(long kk = mm; kk < last; ++kk) {
+            bool const isInterior = (kk != last - 1);
+            if(kk != mm) {
+              pp = aa[kk][kk - 1];
+              qq = aa[kk + 1][kk - 1];
+              rr = isInterior ? aa[kk + 2][kk - 1] : FloatType(0);
+              xx = std::fabs(pp) + std::fabs(qq) + std::fabs(rr);
+              if(xx != FloatType(0)) {
+                pp /= xx;
+                qq /= xx;
+                rr /= xx;
+              }
+            }
+            FloatType ss = std::sqrt(pp * pp + qq * qq + rr * rr);
+            if(pp < FloatType(0)) {
+              ss = -ss;
+            }
+            if(ss == FloatType(0)) {
+              continue;
+            }
+            if(kk == mm) {
+              if(first != mm) {
+                aa[kk][kk - 1] = -aa[kk][kk - 1];
+              }
+            } else {
+              aa[kk][kk - 1] = -ss * xx;
+            }
+            pp += ss;
+            xx = pp / ss;
+            yy = qq / ss;
+            zz = rr / ss;
+            qq /= pp;
+            rr /= pp;
+            for(long jj = kk; jj <= last; ++jj) {
+              pp = aa[kk][jj] + qq * aa[kk + 1][jj];
+              if(isInterior) {
+                pp += rr * aa[kk + 2][jj];
+                aa[kk + 2][jj] -= pp * zz;
+              }
+              aa[kk + 1][jj] -= pp * yy;
+              aa[kk][jj] -= pp * xx;
+            }
+            long const lastRow = std::min(last, kk + 3);
+            for(long ii = first; ii <= lastRow; ++ii) {
+              pp = xx * aa[ii][kk] + yy * aa[ii][kk + 1];
+              if(isInterior) {
+                pp += zz * aa[ii][kk + 2];
+                aa[ii][kk + 2] -= pp * rr;
+              }
+              aa[ii][kk + 1] -= pp * qq;
+              aa[ii][kk] -= pp;
+            }
+          }
+        }
+        return numberOfEigenvalues;
+      }
+
+
+      // Finds the eigenvector of a small square matrix associated
+      // with a known real eigenvalue, by inverse iteration.
+      template <class FloatType, size_t Size>
+      void
+      getFivePointEigenvector(FloatType const (&aa)[Size][Size],
+                              FloatType eigenvalue,
+                              FloatType (&eigenvector)[Size])
+      {
+        // LU decomposition of (A - lambda * I), with partial pivoting.
+        // The matrix is singular (or nearly so) by construction, so
+        // tiny pivots are replaced by something small but safe.
+        FloatType lu[Size][Size];
+        size_t pivots[Size];
+        FloatType matrixNorm(0);
+        for(size_t ii = 0; ii < Size; ++ii) {
+          for(size_t jj = 0; jj < Size; ++jj) {
+            lu[ii][jj] = aa[ii][jj];
+          }
+          lu[ii][ii] -= eigenvalue;
+          for(size_t jj = 0; jj < Size; ++jj) {
+            matrixNorm += std::fabs(lu[ii][jj]);
+          }
+        }
+        FloatType const tinyPivot = std::max(
+          matrixNorm * std::numeric_limits<FloatType>::epsilon(),
+          std::numeric_limits<FloatType>::min());
+        for(size_t kk = 0; kk < Size; ++kk) {
+          size_t pivotRow = kk;
+          for(size_t ii = kk + 1; ii < Size; ++ii) {
+            if(std::fabs(lu[ii][kk]) > std::fabs(lu[pivotRow][kk])) {
+              pivotRow = ii;
+            }
+          }
+          pivots[kk] = pivotRow;
+          if(pivotRow != kk) {
+            for(size_t jj = 0; jj < Size; ++jj) {
+              std::swap(lu[kk][jj], lu[pivotRow][jj]);
+            }
+          }
+          if(std::fabs(lu[kk][kk]) < tinyPivot) {
+            lu[kk][kk] = tinyPivot;
+          }
+          for(size_t ii = kk + 1; ii < Size; ++ii) {
+            FloatType const factor = lu[ii][kk] / lu[kk][kk];
+            lu[ii][kk] = factor;
+            for(size_t jj = kk + 1; jj < Size; ++jj) {
+              lu[ii][jj] -= factor * lu[kk][jj];
+            }
+          }
+        }
+
+        // Two steps of inverse iteration are plenty, since the
+        // eigenvalue is already accurate to working precision.
+        for(size_t ii = 0; ii < Size; ++ii) {
+          eigenvector[ii] = FloatType(1);
+        }
+        for(size_t iteration = 0; iteration < 2; ++iteration) {
+          for(size_t kk = 0; kk < Size; ++kk) {
+            std::swap(eigenvector[kk], eigenvector[pivots[kk]]);
+            for(size_t ii = kk + 1; ii < Size; ++ii) {
+              eigenvector[ii] -= lu[ii][kk] * eigenvector[kk];
+            }
+          }
+          FloatType largest(0);
+          for(size_t ii = Size; ii > 0; --ii) {
+            FloatType sum = eigenvector[ii - 1];
+            for(size_t jj = ii; jj < Size; ++jj) {
+              sum -= lu[ii - 1][jj] * eigenvector[jj];
+            }
+            eigenvector[ii - 1] = sum / lu[ii - 1][ii - 1];
+            largest = std::max(largest, std::fabs(eigenvector[ii - 1]));
+          }
+          if(largest > FloatType(0)) {
+            for(size_t ii = 0; ii < Size; ++ii) {
+              eigenvector[ii] /= largest;
+            }
+          }
+        }
+      }
+
+    } // namespace privateCode
+    /// @endcond
+
 
     template<class FloatType, class Iterator>
     std::vector< brick::numeric::Array2D<FloatType> >
@@ -269,6 +891,102 @@ namespace brick {
     }
 
 
+    template<class FloatType, class Iterator>
+    size_t
+    fivePointAlgorithmMinimal(Iterator sequence0Begin, Iterator sequence1Begin,
+                              FloatType (&essentialMatrices)[10][9])
+    {
+      // Linear constraints, arranged as in fivePointAlgorithm().
+      FloatType aMatrix[5][9];
+      for(size_t rowIndex = 0; rowIndex < 5; ++rowIndex) {
+        const brick::numeric::Vector2D<FloatType>& qq = *sequence0Begin;
+        const brick::numeric::Vector2D<FloatType>& qPrime = *sequence1Begin;
+        aMatrix[rowIndex][0] = qq.x() * qPrime.x();
+        aMatrix[rowIndex][1] = qq.y() * qPrime.x();
+        aMatrix[rowIndex][2] = qPrime.x();
+        aMatrix[rowIndex][3] = qq.x() * qPrime.y();
+        aMatrix[rowIndex][4] = qq.y() * qPrime.y();
+        aMatrix[rowIndex][5] = qPrime.y();
+        aMatrix[rowIndex][6] = qq.x();
+        aMatrix[rowIndex][7] = qq.y();
+        aMatrix[rowIndex][8] = 1.0;
+        ++sequence0Begin;
+        ++sequence1Begin;
+      }
+
+      // With exactly five constraints, QR decomposition gives an
+      // orthonormal basis for the null space just as well as SVD
+      // does, and much more cheaply.
+      privateCode::FivePointFixedMatrix<FloatType, 3, 3> nullSpace[4];
+      privateCode::getFivePointNullSpace(aMatrix, nullSpace);
+
+      // Cubic constraints, and their Groebner basis.  See
+      // fivePointAlgorithm() for the details.
+      privateCode::FivePointFixedMatrix<FloatType, 10, 20> constraintMatrix;
+      privateCode::fillFivePointConstraintMatrix<FloatType>(
+        nullSpace[0], nullSpace[1], nullSpace[2], nullSpace[3],
+        constraintMatrix);
+      FloatType bMatrix[10][10];
+      if(!privateCode::eliminateFivePointConstraints(
+           constraintMatrix, bMatrix)) {
+        return 0;
+      }
+
+      // Transposed action matrix, exactly as in fivePointAlgorithm().
+      FloatType actionMatrix[10][10];
+      size_t const bRows[6] = {0, 1, 2, 4, 5, 7};
+      for(size_t ii = 0; ii < 10; ++ii) {
+        for(size_t jj = 0; jj < 10; ++jj) {
+          actionMatrix[ii][jj] = (ii < 6) ? -bMatrix[bRows[ii]][jj] : 0.0;
+        }
+      }
+      actionMatrix[6][0] = 1.0;
+      actionMatrix[7][1] = 1.0;
+      actionMatrix[8][3] = 1.0;
+      actionMatrix[9][6] = 1.0;
+
+      // Only real eigenvalues give real solutions, so there's no
+      // need for a general complex eigensolver.
+      FloatType workspace[10][10];
+      std::copy(&(actionMatrix[0][0]), &(actionMatrix[0][0]) + 100,
+                &(workspace[0][0]));
+      FloatType eigenvalues[10];
+      size_t numberOfEigenvalues = privateCode::getFivePointRealEigenvalues(
+        workspace, eigenvalues);
+
+      size_t numberOfSolutions = 0;
+      for(size_t ii = 0; ii < numberOfEigenvalues; ++ii) {
+        FloatType eigenvector[10];
+        privateCode::getFivePointEigenvector(
+          actionMatrix, eigenvalues[ii], eigenvector);
+        if(eigenvector[9] == FloatType(0)) {
+          continue;
+        }
+        FloatType const xx = eigenvector[6] / eigenvector[9];
+        FloatType const yy = eigenvector[7] / eigenvector[9];
+        FloatType const zz = eigenvector[8] / eigenvector[9];
+
+        FloatType* solution = essentialMatrices[numberOfSolutions];
+        FloatType sumOfSquares(0);
+        for(size_t jj = 0; jj < 9; ++jj) {
+          size_t const row = jj / 3;
+          size_t const column = jj % 3;
+          solution[jj] = (xx * nullSpace[0](row, column)
+                          + yy * nullSpace[1](row, column)
+                          + zz * nullSpace[2](row, column)
+                          + nullSpace[3](row, column));
+          sumOfSquares += solution[jj] * solution[jj];
+        }
+        FloatType const scale = FloatType(1) / std::sqrt(sumOfSquares);
+        for(size_t jj = 0; jj < 9; ++jj) {
+          solution[jj] *= scale;
+        }
+        ++numberOfSolutions;
+      }
+      return numberOfSolutions;
+    }
+
+
     template<class FloatType, class Iterator>
     brick::numeric::Array2D<FloatType>
     fivePointAlgorithmRobust(Iterator sequence0Begin, Iterator sequence0End,
@@ -284,53 +1002,70 @@ namespace brick {
       brick::numeric::Array2D<FloatType> selectedCandidate(3, 3);
       selectedCandidate = 0.0;
 
-      // Copy input points into local buffers.
+      // Copy input points into local buffers, one array per
+      // coordinate, so that each candidate can be scored by a single
+      // call to computeEpipolarErrors().
       size_t numberOfPoints = sequence0End - sequence0Begin;
-      std::vector< brick::numeric::Vector2D<FloatType> >
-        qVector(numberOfPoints);
-      std::vector< brick::numeric::Vector2D<FloatType> > qPrimeVector(numberOfPoints);
-      std::copy(sequence0Begin, sequence0End, qVector.begin());
-      std::copy(sequence1Begin, sequence1Begin + numberOfPoints,
-                qPrimeVector.begin());
+      brick::numeric::Array1D<FloatType> xCoords0(numberOfPoints);
+      brick::numeric::Array1D<FloatType> yCoords0(numberOfPoints);
+      brick::numeric::Array1D<FloatType> xCoords1(numberOfPoints);
+      brick::numeric::Array1D<FloatType> yCoords1(numberOfPoints);
+      for(size_t kk = 0; kk < numberOfPoints; ++kk) {
+        xCoords0[kk] = sequence0Begin->x();
+        yCoords0[kk] = sequence0Begin->y();
+        xCoords1[kk] = sequence1Begin->x();
+        yCoords1[kk] = sequence1Begin->y();
+        ++sequence0Begin;
+        ++sequence1Begin;
+      }
+
+      // Allocate storage for temporary values prior to starting loop.
+      std::vector< brick::numeric::Vector2D<FloatType> > qVector(5);
+      std::vector< brick::numeric::Vector2D<FloatType> > qPrimeVector(5);
+      FloatType candidates[10][9];
+      brick::numeric::Array2D<FloatType> EE(3, 3);
+      brick::numeric::Array1D<FloatType> residualVector(numberOfPoints);
+      size_t testIndex = std::min(
+        static_cast<size_t>(inlierProportion * numberOfPoints + 0.5),
+        numberOfPoints - 1);
 
       for(size_t ii = 0; ii < iterations; ++ii) {
         // Select five points.
         for(size_t jj = 0; jj < 5; ++jj) {
           int selectedIndex = pRandom.uniformInt(jj, numberOfPoints);
           if(selectedIndex != static_cast<int>(jj)) {
-            std::swap(qVector[jj], qVector[selectedIndex]);
-            std::swap(qPrimeVector[jj], qPrimeVector[selectedIndex]);
+            std::swap(xCoords0[jj], xCoords0[selectedIndex]);
+            std::swap(yCoords0[jj], yCoords0[selectedIndex]);
+            std::swap(xCoords1[jj], xCoords1[selectedIndex]);
+            std::swap(yCoords1[jj], yCoords1[selectedIndex]);
           }
+          qVector[jj].setValue(xCoords0[jj], yCoords0[jj]);
+          qPrimeVector[jj].setValue(xCoords1[jj], yCoords1[jj]);
         }
 
         // Get candidate essential matrices.
-        std::vector< brick::numeric::Array2D<FloatType> > EVector =
-          fivePointAlgorithm<FloatType>(qVector.begin(), qVector.begin() + 5,
-                                        qPrimeVector.begin());
+        size_t numberOfCandidates = fivePointAlgorithmMinimal(
+          qVector.begin(), qPrimeVector.begin(), candidates);
 
         // Test each candidate.
-        for(size_t jj = 0; jj < EVector.size(); ++jj) {
-          Array2D<FloatType> EE = EVector[jj];
+        for(size_t jj = 0; jj < numberOfCandidates; ++jj) {
+          std::copy(candidates[jj], candidates[jj] + 9, EE.begin());
 
           // Compute residuals for all input points.
-          std::vector<FloatType> residualVector(numberOfPoints);
-          for(size_t kk = 0; kk < numberOfPoints; ++kk) {
-            residualVector[kk] = checkEpipolarConstraint(
-              EE, qVector[kk], qPrimeVector[kk]);
-          }
-
-          // Compute robust error statistic.
-          //
-          // Note(xxx): Better not to sort here, since it changes the
-          // algorithm to O(NlogN).
-          std::sort(residualVector.begin(), residualVector.end());
-          int testIndex = static_cast<int>(
-            inlierProportion * residualVector.size() + 0.5);
+          computeEpipolarErrors(EE, xCoords0, yCoords0, xCoords1, yCoords1,
+                                residualVector);
+
+          // Compute robust error statistic.  Partial sorting gives
+          // the same order statistic as a full sort, in linear time.
+          std::nth_element(residualVector.begin(),
+                           residualVector.begin() + testIndex,
+                           residualVector.end());
           FloatType errorValue = residualVector[testIndex];
 
-          // Remember candidate if it's the best so far.
+          // Remember candidate if it's the best so far.  EE is
+          // reused on the next pass, so copy its contents.
           if(errorValue < bestErrorSoFar) {
-            selectedCandidate = EE;
+            selectedCandidate.copy(EE);
             bestErrorSoFar = errorValue;
           }
         }
@@ -366,22 +1101,42 @@ namespace brick {
       brick::numeric::Transform3D<FloatType> selectedCam1Tcam2;
       selectedCam2Ecam0 = 0.0;
 
-      // Copy input points into local buffers.
+      // Copy input points into local buffers, one array per
+      // coordinate, so that triangulation and scoring of each
+      // candidate run as tight loops over contiguous memory.
       size_t numberOfPoints = sequence0End - sequence0Begin;
-      std::vector< brick::numeric::Vector2D<FloatType> > points2D_cam0(numberOfPoints);
-      std::vector< brick::numeric::Vector2D<FloatType> > points2D_cam1(numberOfPoints);
-      std::vector< brick::numeric::Vector2D<FloatType> > points2D_cam2(numberOfPoints);
-      std::copy(sequence0Begin, sequence0End, points2D_cam0.begin());
-      std::copy(sequence1Begin, sequence1Begin + numberOfPoints,
-                points2D_cam1.begin());
-      std::copy(sequence2Begin, sequence2Begin + numberOfPoints,
-                points2D_cam2.begin());
+      brick::numeric::Array1D<FloatType> xCoords0(numberOfPoints);
+      brick::numeric::Array1D<FloatType> yCoords0(numberOfPoints);
+      brick::numeric::Array1D<FloatType> xCoords1(numberOfPoints);
+      brick::numeric::Array1D<FloatType> yCoords1(numberOfPoints);
+      brick::numeric::Array1D<FloatType> xCoords2(numberOfPoints);
+      brick::numeric::Array1D<FloatType> yCoords2(numberOfPoints);
+      for(size_t kk = 0; kk < numberOfPoints; ++kk) {
+        xCoords0[kk] = sequence0Begin->x();
+        yCoords0[kk] = sequence0Begin->y();
+        xCoords1[kk] = sequence1Begin->x();
+        yCoords1[kk] = sequence1Begin->y();
+        xCoords2[kk] = sequence2Begin->x();
+        yCoords2[kk] = sequence2Begin->y();
+        ++sequence0Begin;
+        ++sequence1Begin;
+        ++sequence2Begin;
+      }
 
       // Allocate storage for temporary values prior to starting loop.
-      std::vector< brick::numeric::Vector3D<FloatType> > points3D_cam0(numberOfPoints);
-      std::vector< brick::numeric::Vector3D<FloatType> > points3D_cam1(numberOfPoints);
-      std::vector< brick::numeric::Vector3D<FloatType> > points3D_cam2(numberOfPoints);
-      std::vector<FloatType> residualVector(numberOfPoints);
+      std::vector< brick::numeric::Vector2D<FloatType> > sample2D_cam0(5);
+      std::vector< brick::numeric::Vector2D<FloatType> > sample2D_cam1(5);
+      std::vector< brick::numeric::Vector2D<FloatType> > sample2D_cam2(5);
+      std::vector< brick::numeric::Vector3D<FloatType> > sample3D_cam2(5);
+      FloatType candidates[10][9];
+      brick::numeric::Array2D<FloatType> EE(3, 3);
+      brick::numeric::Array1D<FloatType> xCoords3D(numberOfPoints);
+      brick::numeric::Array1D<FloatType> yCoords3D(numberOfPoints);
+      brick::numeric::Array1D<FloatType> zCoords3D(numberOfPoints);
+      brick::numeric::Array1D<FloatType> residualVector(numberOfPoints);
+      size_t testIndex = std::min(
+        static_cast<size_t>(inlierProportion * numberOfPoints + 0.5),
+        numberOfPoints - 1);
 
       // Loop over many sets of random samples.
       for(size_t ii = 0; ii < iterations; ++ii) {
@@ -390,28 +1145,32 @@ namespace brick {
         for(size_t jj = 0; jj < 5; ++jj) {
           int selectedIndex = pRandom.uniformInt(jj, numberOfPoints);
           if(selectedIndex != static_cast<int>(jj)) {
-            std::swap(points2D_cam0[jj], points2D_cam0[selectedIndex]);
-            std::swap(points2D_cam1[jj], points2D_cam1[selectedIndex]);
-            std::swap(points2D_cam2[jj], points2D_cam2[selectedIndex]);
+            std::swap(xCoords0[jj], xCoords0[selectedIndex]);
+            std::swap(yCoords0[jj], yCoords0[selectedIndex]);
+            std::swap(xCoords1[jj], xCoords1[selectedIndex]);
+            std::swap(yCoords1[jj], yCoords1[selectedIndex]);
+            std::swap(xCoords2[jj], xCoords2[selectedIndex]);
+            std::swap(yCoords2[jj], yCoords2[selectedIndex]);
           }
+          sample2D_cam0[jj].setValue(xCoords0[jj], yCoords0[jj]);
+          sample2D_cam1[jj].setValue(xCoords1[jj], yCoords1[jj]);
+          sample2D_cam2[jj].setValue(xCoords2[jj], yCoords2[jj]);
         }
 
         // Get candidate essential matrices.
-        std::vector< brick::numeric::Array2D<FloatType> > EVector =
-          fivePointAlgorithm<FloatType>(
-            points2D_cam0.begin(), points2D_cam0.begin() + 5,
-            points2D_cam2.begin());
+        size_t numberOfCandidates = fivePointAlgorithmMinimal(
+          sample2D_cam0.begin(), sample2D_cam2.begin(), candidates);
 
         // Test each candidate.
-        for(size_t jj = 0; jj < EVector.size(); ++jj) {
-          Array2D<FloatType> EE = EVector[jj];
+        for(size_t jj = 0; jj < numberOfCandidates; ++jj) {
+          std::copy(candidates[jj], candidates[jj] + 9, EE.begin());
 
           // Recover relative motion between cameras, assuming EE is
           // correct.
           brick::numeric::Transform3D<FloatType> c2Tc0;
           try {
             c2Tc0 = getCameraMotionFromEssentialMatrix(
-              EE, points2D_cam0[0], points2D_cam2[0]);
+              EE, sample2D_cam0[0], sample2D_cam2[0]);
           } catch(brick::common::ValueException&) {
             // Input points were on parallel rays!  No point in evaluating
             // this candidate.
@@ -420,16 +1179,19 @@ namespace brick {
 
           // Given relative motion, recover 3D position of each input
           // point in camera 2 coordinates.
-          for(size_t kk = 0; kk < numberOfPoints; ++kk) {
-            points3D_cam2[kk] = triangulateCalibratedImagePoint(
-              c2Tc0, points2D_cam2[kk], points2D_cam0[kk]);
-          }
+          triangulateCalibratedImagePoints(
+            c2Tc0, xCoords2, yCoords2, xCoords0, yCoords0,
+            xCoords3D, yCoords3D, zCoords3D);
 
           // Recover 3D position and orientation of camera 1.
+          for(size_t kk = 0; kk < 5; ++kk) {
+            sample3D_cam2[kk].setValue(
+              xCoords3D[kk], yCoords3D[kk], zCoords3D[kk]);
+          }
           FloatType internalScore;
           brick::numeric::Transform3D<FloatType> c1Tc2 = threePointAlgorithmRobust(
-            points3D_cam2.begin(), points3D_cam2.begin() + 5,
-            points2D_cam1.begin(), intrinsics, 1, 1.0, internalScore, pRandom);
+            sample3D_cam2.begin(), sample3D_cam2.end(),
+            sample2D_cam1.begin(), intrinsics, 1, 1.0, internalScore, pRandom);
 
           // We expect the model to fit these five points better than
           // it fits other points in the set.  If internalScore
@@ -440,52 +1202,71 @@ namespace brick {
             continue;
           }
 
-          // Compute the 3D position of each input point in camera 1
-          // coordinates.
-          for(size_t kk = 0; kk < numberOfPoints; ++kk) {
-            points3D_cam1[kk] = c1Tc2 * points3D_cam2[kk];
-          }
-
-          // Recover 3D position of each of the input points in camera
-          // 0 coordinates.
+          // Project each 3D point into all three images, and compute
+          // residual.  Both transforms are rigid, so their bottom
+          // rows are [0, 0, 0, 1].
           brick::numeric::Transform3D<FloatType> c0Tc2 = c2Tc0.invert();
+          FloatType const a00 = c0Tc2.template value<0, 0>();
+          FloatType const a01 = c0Tc2.template value<0, 1>();
+          FloatType const a02 = c0Tc2.template value<0, 2>();
+          FloatType const a03 = c0Tc2.template value<0, 3>();
+          FloatType const a10 = c0Tc2.template value<1, 0>();
+          FloatType const a11 = c0Tc2.template value<1, 1>();
+          FloatType const a12 = c0Tc2.template value<1, 2>();
+          FloatType const a13 = c0Tc2.template value<1, 3>();
+          FloatType const a20 = c0Tc2.template value<2, 0>();
+          FloatType const a21 = c0Tc2.template value<2, 1>();
+          FloatType const a22 = c0Tc2.template value<2, 2>();
+          FloatType const a23 = c0Tc2.template value<2, 3>();
+          FloatType const b00 = c1Tc2.template value<0, 0>();
+          FloatType const b01 = c1Tc2.template value<0, 1>();
+          FloatType const b02 = c1Tc2.template value<0, 2>();
+          FloatType const b03 = c1Tc2.template value<0, 3>();
+          FloatType const b10 = c1Tc2.template value<1, 0>();
+          FloatType const b11 = c1Tc2.template value<1, 1>();
+          FloatType const b12 = c1Tc2.template value<1, 2>();
+          FloatType const b13 = c1Tc2.template value<1, 3>();
+          FloatType const b20 = c1Tc2.template value<2, 0>();
+          FloatType const b21 = c1Tc2.template value<2, 1>();
+          FloatType const b22 = c1Tc2.template value<2, 2>();
+          FloatType const b23 = c1Tc2.template value<2, 3>();
           for(size_t kk = 0; kk < numberOfPoints; ++kk) {
-            points3D_cam0[kk] = c0Tc2 * points3D_cam2[kk];
-          }
-
-          // Project 3D points into each image, and compute residual.
-          for(size_t kk = 0; kk < numberOfPoints; ++kk) {
-            brick::numeric::Vector2D<FloatType> residualVec0(
-              points3D_cam0[kk].x() / points3D_cam0[kk].z(),
-              points3D_cam0[kk].y() / points3D_cam0[kk].z());
-            residualVec0 -= points2D_cam0[kk];
-            brick::numeric::Vector2D<FloatType> residualVec1(
-              points3D_cam1[kk].x() / points3D_cam1[kk].z(),
-              points3D_cam1[kk].y() / points3D_cam1[kk].z());
-            residualVec1 -= points2D_cam1[kk];
-            brick::numeric::Vector2D<FloatType> residualVec2(
-              points3D_cam2[kk].x() / points3D_cam2[kk].z(),
-              points3D_cam2[kk].y() / points3D_cam2[kk].z());
-            residualVec2 -= points2D_cam2[kk];
-
-            residualVector[kk] =
-              (brick::numeric::magnitudeSquared<FloatType>(residualVec0)
-               + brick::numeric::magnitudeSquared<FloatType>(residualVec1)
-               + brick::numeric::magnitudeSquared<FloatType>(residualVec2)) / 3.0;
+            FloatType const xx2 = xCoords3D[kk];
+            FloatType const yy2 = yCoords3D[kk];
+            FloatType const zz2 = zCoords3D[kk];
+            FloatType const xx0 = a00 * xx2 + a01 * yy2 + a02 * zz2 + a03;
+            FloatType const yy0 = a10 * xx2 + a11 * yy2 + a12 * zz2 + a13;
+            FloatType const zz0 = a20 * xx2 + a21 * yy2 + a22 * zz2 + a23;
+            FloatType const xx1 = b00 * xx2 + b01 * yy2 + b02 * zz2 + b03;
+            FloatType const yy1 = b10 * xx2 + b11 * yy2 + b12 * zz2 + b13;
+            FloatType const zz1 = b20 * xx2 + b21 * yy2 + b22 * zz2 + b23;
+
+            FloatType const du0 = xx0 / zz0 - xCoords0[kk];
+            FloatType const dv0 = yy0 / zz0 - yCoords0[kk];
+            FloatType const du1 = xx1 / zz1 - xCoords1[kk];
+            FloatType const dv1 = yy1 / zz1 - yCoords1[kk];
+            FloatType const du2 = xx2 / zz2 - xCoords2[kk];
+            FloatType const dv2 = yy2 / zz2 - yCoords2[kk];
+            FloatType const residual =
+              (du0 * du0 + dv0 * dv0 + du1 * du1 + dv1 * dv1
+               + du2 * du2 + dv2 * dv2) / FloatType(3);
+
+            // Points on parallel rays triangulate to NaN.  Give them
+            // the largest residual so that the partial sort below is
+            // well defined.
+            residualVector[kk] = (residual == residual)
+              ? residual : std::numeric_limits<FloatType>::max();
           }
 
           // Compute robust error statistic.
-          //
-          // Note(xxx): Better not to sort here, since it changes the
-          // algorithm to O(NlogN).
-          std::sort(residualVector.begin(), residualVector.end());
-          int testIndex = static_cast<int>(
-            inlierProportion * residualVector.size() + 0.5);
+          std::nth_element(residualVector.begin(),
+                           residualVector.begin() + testIndex,
+                           residualVector.end());
           FloatType errorValue = residualVector[testIndex];
 
           // Remember candidate if it's the best so far.
           if(errorValue < bestErrorSoFar) {
-            selectedCam2Ecam0 = EE;
+            selectedCam2Ecam0.copy(EE);
             selectedCam0Tcam2 = c0Tc2;
             selectedCam1Tcam2 = c1Tc2;
             bestErrorSoFar = errorValue;
@@ -527,6 +1308,91 @@ namespace brick {
     }
 
 
+    template <class FloatType>
+    void
+    computeEpipolarErrors(
+      brick::numeric::Array2D<FloatType> const& fundamentalMx,
+      brick::numeric::Array1D<FloatType> const& xCoords0,
+      brick::numeric::Array1D<FloatType> const& yCoords0,
+      brick::numeric::Array1D<FloatType> const& xCoords1,
+      brick::numeric::Array1D<FloatType> const& yCoords1,
+      brick::numeric::Array1D<FloatType>& errors,
+      EpipolarErrorType errorType)
+    {
+      privateCode::checkEpipolarArguments(
+        fundamentalMx, xCoords0, yCoords0, xCoords1, yCoords1,
+        "computeEpipolarErrors()");
+      if(errors.size() != xCoords0.size()) {
+        errors.reinit(xCoords0.size());
+      }
+
+      // Local copy of the matrix, so the compiler knows it isn't
+      // aliased by the output array.
+      FloatType ff[9];
+      std::copy(fundamentalMx.begin(), fundamentalMx.end(), &(ff[0]));
+
+      switch(errorType) {
+      case BRICK_CV_SAMPSON_ERROR:
+        privateCode::computeEpipolarErrorsKernel<BRICK_CV_SAMPSON_ERROR>(
+          ff, xCoords0.data(), yCoords0.data(), xCoords1.data(),
+          yCoords1.data(), xCoords0.size(), errors.data());
+        break;
+      case BRICK_CV_SYMMETRIC_EPIPOLAR_DISTANCE:
+        privateCode::computeEpipolarErrorsKernel<
+          BRICK_CV_SYMMETRIC_EPIPOLAR_DISTANCE>(
+            ff, xCoords0.data(), yCoords0.data(), xCoords1.data(),
+            yCoords1.data(), xCoords0.size(), errors.data());
+        break;
+      default:
+        privateCode::computeEpipolarErrorsKernel<BRICK_CV_EPIPOLAR_DISTANCE>(
+          ff, xCoords0.data(), yCoords0.data(), xCoords1.data(),
+          yCoords1.data(), xCoords0.size(), errors.data());
+        break;
+      }
+    }
+
+
+    template <class FloatType>
+    size_t
+    getEpipolarInliers(
+      brick::numeric::Array2D<FloatType> const& fundamentalMx,
+      brick::numeric::Array1D<FloatType> const& xCoords0,
+      brick::numeric::Array1D<FloatType> const& yCoords0,
+      brick::numeric::Array1D<FloatType> const& xCoords1,
+      brick::numeric::Array1D<FloatType> const& yCoords1,
+      FloatType threshold,
+      brick::numeric::Array1D<bool>& inlierMask,
+      EpipolarErrorType errorType)
+    {
+      privateCode::checkEpipolarArguments(
+        fundamentalMx, xCoords0, yCoords0, xCoords1, yCoords1,
+        "getEpipolarInliers()");
+      if(inlierMask.size() != xCoords0.size()) {
+        inlierMask.reinit(xCoords0.size());
+      }
+
+      FloatType ff[9];
+      std::copy(fundamentalMx.begin(), fundamentalMx.end(), &(ff[0]));
+
+      switch(errorType) {
+      case BRICK_CV_SAMPSON_ERROR:
+        return privateCode::getEpipolarInliersKernel<BRICK_CV_SAMPSON_ERROR>(
+          ff, xCoords0.data(), yCoords0.data(), xCoords1.data(),
+          yCoords1.data(), xCoords0.size(), threshold, inlierMask.data());
+      case BRICK_CV_SYMMETRIC_EPIPOLAR_DISTANCE:
+        return privateCode::getEpipolarInliersKernel<
+          BRICK_CV_SYMMETRIC_EPIPOLAR_DISTANCE>(
+            ff, xCoords0.data(), yCoords0.data(), xCoords1.data(),
+            yCoords1.data(), xCoords0.size(), threshold, inlierMask.data());
+      default:
+        break;
+      }
+      return privateCode::getEpipolarInliersKernel<BRICK_CV_EPIPOLAR_DISTANCE>(
+        ff, xCoords0.data(), yCoords0.data(), xCoords1.data(),
+        yCoords1.data(), xCoords0.size(), threshold, inlierMask.data());
+    }
+
+
     template <class FloatType>
     brick::numeric::Transform3D<FloatType>
     getCameraMotionFromEssentialMatrix(
@@ -708,6 +1574,99 @@ namespace brick {
     }
 
 
+    template <class FloatType>
+    void
+    triangulateCalibratedImagePoints(
+      brick::numeric::Transform3D<FloatType> const& c0Tc1,
+      brick::numeric::Array1D<FloatType> const& xCoords0,
+      brick::numeric::Array1D<FloatType> const& yCoords0,
+      brick::numeric::Array1D<FloatType> const& xCoords1,
+      brick::numeric::Array1D<FloatType> const& yCoords1,
+      brick::numeric::Array1D<FloatType>& xCoords3D,
+      brick::numeric::Array1D<FloatType>& yCoords3D,
+      brick::numeric::Array1D<FloatType>& zCoords3D)
+    {
+      size_t const numberOfPoints = xCoords0.size();
+      if(yCoords0.size() != numberOfPoints
+         || xCoords1.size() != numberOfPoints
+         || yCoords1.size() != numberOfPoints) {
+        BRICK_THROW(brick::common::ValueException,
+                    "triangulateCalibratedImagePoints()",
+                    "Coordinate arrays must all be the same size.");
+      }
+      if(xCoords3D.size() != numberOfPoints) {
+        xCoords3D.reinit(numberOfPoints);
+      }
+      if(yCoords3D.size() != numberOfPoints) {
+        yCoords3D.reinit(numberOfPoints);
+      }
+      if(zCoords3D.size() != numberOfPoints) {
+        zCoords3D.reinit(numberOfPoints);
+      }
+
+      // In camera 0 coordinates, the first ray starts at the origin
+      // and has direction v_0 = [x_0, y_0, 1]^T.  The second starts
+      // at the camera 1 origin, t, and has direction v_1 = R * [x_1,
+      // y_1, 1]^T, where R and t are the rotation and translation
+      // parts of c0Tc1.  As in findIntersect(), we look for the
+      // distances a_0 and a_1 that minimize
+      //
+      // @verbatim
+      //   || a_0 * v_0 - (t + a_1 * v_1) ||^2
+      // @endverbatim
+      //
+      // and return the midpoint of the two closest points.  The 2x2
+      // normal equations are solved directly by Cramer's rule.
+      FloatType const r00 = c0Tc1.template value<0, 0>();
+      FloatType const r01 = c0Tc1.template value<0, 1>();
+      FloatType const r02 = c0Tc1.template value<0, 2>();
+      FloatType const r10 = c0Tc1.template value<1, 0>();
+      FloatType const r11 = c0Tc1.template value<1, 1>();
+      FloatType const r12 = c0Tc1.template value<1, 2>();
+      FloatType const r20 = c0Tc1.template value<2, 0>();
+      FloatType const r21 = c0Tc1.template value<2, 1>();
+      FloatType const r22 = c0Tc1.template value<2, 2>();
+      FloatType const tx = c0Tc1.template value<0, 3>();
+      FloatType const ty = c0Tc1.template value<1, 3>();
+      FloatType const tz = c0Tc1.template value<2, 3>();
+      FloatType const epsilon = std::numeric_limits<FloatType>::epsilon();
+      FloatType const notANumber = std::numeric_limits<FloatType>::quiet_NaN();
+
+      FloatType const* x0Ptr = xCoords0.data();
+      FloatType const* y0Ptr = yCoords0.data();
+      FloatType const* x1Ptr = xCoords1.data();
+      FloatType const* y1Ptr = yCoords1.data();
+      FloatType* xOutPtr = xCoords3D.data();
+      FloatType* yOutPtr = yCoords3D.data();
+      FloatType* zOutPtr = zCoords3D.data();
+      for(size_t ii = 0; ii < numberOfPoints; ++ii) {
+        FloatType const x0 = x0Ptr[ii];
+        FloatType const y0 = y0Ptr[ii];
+        FloatType const v1x = r00 * x1Ptr[ii] + r01 * y1Ptr[ii] + r02;
+        FloatType const v1y = r10 * x1Ptr[ii] + r11 * y1Ptr[ii] + r12;
+        FloatType const v1z = r20 * x1Ptr[ii] + r21 * y1Ptr[ii] + r22;
+
+        FloatType const v0DotV0 = x0 * x0 + y0 * y0 + FloatType(1);
+        FloatType const v0DotV1 = x0 * v1x + y0 * v1y + v1z;
+        FloatType const v1DotV1 = v1x * v1x + v1y * v1y + v1z * v1z;
+        FloatType const v0DotT = x0 * tx + y0 * ty + tz;
+        FloatType const v1DotT = v1x * tx + v1y * ty + v1z * tz;
+
+        // The determinant is |v_0|^2 |v_1|^2 sin^2(theta), where
+        // theta is the angle between the rays.
+        FloatType const determinant = v0DotV0 * v1DotV1 - v0DotV1 * v0DotV1;
+        FloatType const scale = (determinant > epsilon * v0DotV0 * v1DotV1)
+          ? FloatType(0.5) / determinant : notANumber;
+        FloatType const halfA0 = (v1DotV1 * v0DotT - v0DotV1 * v1DotT) * scale;
+        FloatType const halfA1 = (v0DotV1 * v0DotT - v0DotV0 * v1DotT) * scale;
+
+        xOutPtr[ii] = halfA0 * x0 + halfA1 * v1x + FloatType(0.5) * tx;
+        yOutPtr[ii] = halfA0 * y0 + halfA1 * v1y + FloatType(0.5) * ty;
+        zOutPtr[ii] = halfA0 + halfA1 * v1z + FloatType(0.5) * tz;
+      }
+    }
+
+
     // This function is used internally by fivePointAlgorithm() to
     // generate a 10x20 matrix of coefficients of polynomial
     // constraints.
@@ -719,6 +1678,46 @@ namespace brick {
       brick::numeric::Array2D<FloatType> const& E2Array,
       brick::numeric::Array2D<FloatType> const& E3Array)
     {
+      // Big matrix to accept all of the constraint coefficients.
+      brick::numeric::Array2D<FloatType> AMatrix(10, 20);
+      privateCode::fillFivePointConstraintMatrix<FloatType>(
+        E0Array, E1Array, E2Array, E3Array, AMatrix);
+
+      // Warning(xxx): The action matrix in Stewenius & Nister's paper
+      // doesn't appear to correspond to degree-then-lexicographic
+      // order of monomials.  The right solution to this is to
+      // generate the correct action matrix in fivePointAlgorithm.h,
+      // but instead we temporarily shuffle the columns of our
+      // constraint matrix to match the action matrix.
+      brick::numeric::Array2D<FloatType> A2Matrix(AMatrix.rows(), AMatrix.columns());
+      size_t const* shuffle = privateCode::getFivePointColumnShuffle();
+      for(size_t rowIndex = 0; rowIndex < AMatrix.rows(); ++rowIndex) {
+        for(size_t columnIndex = 0; columnIndex < AMatrix.columns();
+            ++columnIndex) {
+          A2Matrix(rowIndex, columnIndex) =
+            AMatrix(rowIndex, shuffle[columnIndex]);
+        }
+      }
+      return A2Matrix;
+    }
+
+
+    /// @cond privateCode
+    namespace privateCode {
+
+      // Fills in the (unshuffled) 10x20 constraint matrix for
+      // generateFivePointConstraintMatrix() and
+      // fivePointAlgorithmMinimal().  Both InputType and OutputType
+      // need only provide element access using operator()(row,
+      // column).
+      template <class FloatType, class InputType, class OutputType>
+      void
+      fillFivePointConstraintMatrix(InputType const& E0Array,
+                                    InputType const& E1Array,
+                                    InputType const& E2Array,
+                                    InputType const& E3Array,
+                                    OutputType& AMatrix)
+      {
 
       /*
         =====================================================
@@ -997,9 +1996,6 @@ namespace brick {
       FloatType e3rc21_3 = e3rc21_2 * e3rc21;
       FloatType e3rc22_3 = e3rc22_2 * e3rc22;
 
-      // Big matrix to accept all of the constraint coefficients.
-      brick::numeric::Array2D<FloatType> AMatrix(10, 20);
-
 
       // ============= Begin cut & paste section =============
 
@@ -1206,26 +2202,10 @@ namespace brick {
 
 
       // ============= End cut & paste section =============
-
-      // Warning(xxx): The action matrix in Stewenius & Nister's paper
-      // doesn't appear to correspond to degree-then-lexicographic
-      // order of monomials.  The right solution to this is to
-      // generate the correct action matrix in fivePointAlgorithm.h,
-      // but instead we temporarily shuffle the columns of our
-      // constraint matrix to match the action matrix.
-      brick::numeric::Array2D<FloatType> A2Matrix(AMatrix.rows(), AMatrix.columns());
-      brick::numeric::Array1D<int> shuffle(
-        "[0, 1, 3, 6, 2, 4, 7, 5, 8, 9, 10, 11, 13, 12, 14, 15, 16, 17, 18, 19]"
-        );
-      for(size_t rowIndex = 0; rowIndex < AMatrix.rows(); ++rowIndex) {
-        for(size_t columnIndex = 0; columnIndex < AMatrix.columns();
-            ++columnIndex) {
-          A2Matrix(rowIndex, columnIndex) =
-            AMatrix(rowIndex, shuffle[columnIndex]);
-        }
       }
-      return A2Matrix;
-    }
+
+    } // namespace privateCode
+    /// @endcond
 
   } // namespace computerVision
 
@@ -34,6 +34,94 @@ namespace brick {
                          size_t maxNumberOfPasses,
                          size_t& numberOfPassesUsed);
 
+
+    /**
+     * This function computes the exact Euclidean distance from each
+     * pixel of an image to the nearest nonzero ("seed") pixel.
+     * Unlike getEuclideanDistance(), which iterates raster sweeps
+     * until the distances stop changing, this function uses the
+     * separable lower envelope algorithm of Felzenszwalb and
+     * Huttenlocher[1], so it always takes exactly two passes (one
+     * down the columns and one along the rows), each linear in the
+     * number of pixels.  Each pass is divided into bands that run on
+     * concurrent threads.
+     *
+     * [1] P. Felzenszwalb and D. Huttenlocher.  Distance Transforms of
+     * Sampled Functions.  Theory of Computing, 8(19):415-428, 2012.
+     *
+     * @param inputImage This argument is the image to be processed.
+     * Pixels that evaluate to true are seeds.
+     *
+     * @param rowSpacing This argument is the distance between
+     * adjacent rows, and must be positive.
+     *
+     * @param columnSpacing This argument is the distance between
+     * adjacent columns, and must be positive.
+     *
+     * @param isSquared This argument specifies whether to return
+     * squared distances, which saves one square root per pixel.
+     *
+     * @param numberOfThreads This argument specifies how many threads
+     * to use.  Setting it to zero uses one thread per available
+     * processor.
+     *
+     * @return The return value is an array, the same size as
+     * inputImage, of (possibly squared) distances.  If inputImage
+     * contains no seeds, every element is infinity.
+     */
+    template<class FloatType, ImageFormat FORMAT>
+    brick::numeric::Array2D<FloatType>
+    getExactEuclideanDistance(const Image<FORMAT>& inputImage,
+                              FloatType rowSpacing = 1.0,
+                              FloatType columnSpacing = 1.0,
+                              bool isSquared = false,
+                              unsigned int numberOfThreads = 1);
+
+
+    /**
+     * This function works just like the other version of
+     * getExactEuclideanDistance(), but also reports which seed is
+     * nearest to each pixel.  This is useful for Voronoi labelling:
+     * if labelImage assigns a label to each seed, then
+     * labelImage(nearestSeedIndices(row, column)) is the label of the
+     * region containing (row, column).
+     *
+     * @param inputImage This argument is the image to be processed.
+     * Pixels that evaluate to true are seeds.
+     *
+     * @param nearestSeedIndices This argument is used to return the
+     * raster index (row * columns + column) of the nearest seed for
+     * each pixel.  Where there are ties, one of the tied seeds is
+     * chosen arbitrarily.  If inputImage contains no seeds, every
+     * element is set to inputImage.size().  This array will be
+     * reinitialized if it is not already the same shape as
+     * inputImage.
+     *
+     * @param rowSpacing This argument is the distance between
+     * adjacent rows, and must be positive.
+     *
+     * @param columnSpacing This argument is the distance between
+     * adjacent columns, and must be positive.
+     *
+     * @param isSquared This argument specifies whether to return
+     * squared distances.
+     *
+     * @param numberOfThreads This argument specifies how many threads
+     * to use.  Setting it to zero uses one thread per available
+     * processor.
+     *
+     * @return The return value is an array of (possibly squared)
+     * distances.
+     */
+    template<class FloatType, ImageFormat FORMAT>
+    brick::numeric::Array2D<FloatType>
+    getExactEuclideanDistance(const Image<FORMAT>& inputImage,
+                              brick::numeric::Array2D<size_t>& nearestSeedIndices,
+                              FloatType rowSpacing = 1.0,
+                              FloatType columnSpacing = 1.0,
+                              bool isSquared = false,
+                              unsigned int numberOfThreads = 1);
+
   } // namespace computerVision
 
 } // namespace brick
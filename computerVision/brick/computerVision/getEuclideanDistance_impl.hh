@@ -21,6 +21,10 @@
 // #include <brick/computerVision/getEuclideanDistance.hh>
 
 #include <cmath>
+#include <limits>
+#include <vector>
+#include <brick/common/exception.hh>
+#include <brick/common/parallelFor.hh>
 #include <brick/numeric/index2D.hh>
 
 namespace brick {
@@ -54,6 +58,83 @@ namespace brick {
         return false;
       }
 
+
+      // Computes the lower envelope of the parabolas
+      // spacingSquared * (x - q)^2 + gPtr[q], for every q at which
+      // gPtr[q] is finite, and samples it at x = 0 .. size - 1.  The
+      // arrays vPtr (size elements) and zPtr (size + 1 elements) are
+      // scratch space.  On return, outputPtr holds the envelope, and
+      // argminPtr holds the q of the parabola that achieves it.
+      template<class FloatType>
+      void
+      eucDistLowerEnvelope(FloatType const* gPtr,
+                           size_t size,
+                           FloatType spacingSquared,
+                           size_t* vPtr,
+                           FloatType* zPtr,
+                           FloatType* outputPtr,
+                           size_t* argminPtr)
+      {
+        FloatType const infinity = std::numeric_limits<FloatType>::infinity();
+
+        // Build the envelope.  vPtr[0 .. kk] are the parabolas that
+        // make up the envelope, and parabola vPtr[jj] is lowest
+        // between zPtr[jj] and zPtr[jj + 1].
+        size_t numberOfParabolas = 0;
+        for(size_t qq = 0; qq < size; ++qq) {
+          if(gPtr[qq] == infinity) {
+            continue;
+          }
+          FloatType const qOffset =
+            gPtr[qq] + spacingSquared * FloatType(qq) * FloatType(qq);
+          if(numberOfParabolas == 0) {
+            vPtr[0] = qq;
+            zPtr[0] = -infinity;
+            zPtr[1] = infinity;
+            numberOfParabolas = 1;
+            continue;
+          }
+
+          // Discard parabolas that the new one hides.  Since
+          // zPtr[0] is -infinity, at least one always survives.
+          FloatType intersection;
+          while(true) {
+            size_t const pp = vPtr[numberOfParabolas - 1];
+            FloatType const pOffset =
+              gPtr[pp] + spacingSquared * FloatType(pp) * FloatType(pp);
+            intersection = (qOffset - pOffset)
+              / (FloatType(2) * spacingSquared * FloatType(qq - pp));
+            if(intersection > zPtr[numberOfParabolas - 1]) {
+              break;
+            }
+            --numberOfParabolas;
+          }
+          vPtr[numberOfParabolas] = qq;
+          zPtr[numberOfParabolas] = intersection;
+          zPtr[numberOfParabolas + 1] = infinity;
+          ++numberOfParabolas;
+        }
+
+        if(numberOfParabolas == 0) {
+          for(size_t xx = 0; xx < size; ++xx) {
+            outputPtr[xx] = infinity;
+            argminPtr[xx] = size;
+          }
+          return;
+        }
+
+        // Sample it.
+        size_t kk = 0;
+        for(size_t xx = 0; xx < size; ++xx) {
+          while(zPtr[kk + 1] < FloatType(xx)) {
+            ++kk;
+          }
+          FloatType const delta = FloatType(xx) - FloatType(vPtr[kk]);
+          outputPtr[xx] = spacingSquared * delta * delta + gPtr[vPtr[kk]];
+          argminPtr[xx] = vPtr[kk];
+        }
+      }
+
     } // namespace privateCode
     /// @endcond
 
@@ -290,6 +371,134 @@ namespace brick {
       return distanceMap;
     }
 
+
+    template<class FloatType, ImageFormat FORMAT>
+    brick::numeric::Array2D<FloatType>
+    getExactEuclideanDistance(const Image<FORMAT>& inputImage,
+                              FloatType rowSpacing,
+                              FloatType columnSpacing,
+                              bool isSquared,
+                              unsigned int numberOfThreads)
+    {
+      brick::numeric::Array2D<size_t> nearestSeedIndices;
+      return getExactEuclideanDistance<FloatType>(
+        inputImage, nearestSeedIndices, rowSpacing, columnSpacing,
+        isSquared, numberOfThreads);
+    }
+
+
+    template<class FloatType, ImageFormat FORMAT>
+    brick::numeric::Array2D<FloatType>
+    getExactEuclideanDistance(const Image<FORMAT>& inputImage,
+                              brick::numeric::Array2D<size_t>& nearestSeedIndices,
+                              FloatType rowSpacing,
+                              FloatType columnSpacing,
+                              bool isSquared,
+                              unsigned int numberOfThreads)
+    {
+      if(!(rowSpacing > FloatType(0)) || !(columnSpacing > FloatType(0))) {
+        BRICK_THROW(brick::common::ValueException,
+                    "getExactEuclideanDistance()",
+                    "Arguments rowSpacing and columnSpacing must be positive.");
+      }
+
+      size_t const rows = inputImage.rows();
+      size_t const columns = inputImage.columns();
+      brick::numeric::Array2D<FloatType> distanceMap(rows, columns);
+      if(nearestSeedIndices.rows() != rows
+         || nearestSeedIndices.columns() != columns) {
+        nearestSeedIndices.reinit(rows, columns);
+      }
+      if(rows == 0 || columns == 0) {
+        return distanceMap;
+      }
+
+      // First pass: for each pixel, find the nearest seed in the
+      // same column.  Bands of columns are processed in parallel,
+      // but each band walks down (and then back up) the image a row
+      // at a time, so memory is accessed in raster order.  The row
+      // of the nearest seed is stored in nearestSeedIndices, with
+      // the value "rows" indicating that the column has no seeds.
+      brick::common::parallelFor(
+        size_t(0), columns, numberOfThreads,
+        [&](size_t bandBegin, size_t bandEnd, unsigned int) {
+          for(size_t column = bandBegin; column < bandEnd; ++column) {
+            nearestSeedIndices(0, column) = inputImage(0, column) ? 0 : rows;
+          }
+          for(size_t row = 1; row < rows; ++row) {
+            for(size_t column = bandBegin; column < bandEnd; ++column) {
+              nearestSeedIndices(row, column) = inputImage(row, column)
+                ? row : nearestSeedIndices(row - 1, column);
+            }
+          }
+
+          // Sweep back up, keeping whichever seed is closer.  Once
+          // a column has a seed, every downward result is a valid
+          // row index, so "rows" only survives in empty columns.
+          for(size_t row = rows - 1; row-- > 0;) {
+            for(size_t column = bandBegin; column < bandEnd; ++column) {
+              size_t const below = nearestSeedIndices(row + 1, column);
+              size_t& current = nearestSeedIndices(row, column);
+              if(below != rows && below > row
+                 && (current == rows || below - row < row - current)) {
+                current = below;
+              }
+            }
+          }
+        });
+
+      // Second pass: for each row, combine the column distances
+      // using the lower envelope of one parabola per column.  Each
+      // band of rows gets its own scratch space.
+      FloatType const rowSpacingSquared = rowSpacing * rowSpacing;
+      FloatType const columnSpacingSquared = columnSpacing * columnSpacing;
+      FloatType const infinity = std::numeric_limits<FloatType>::infinity();
+      brick::common::parallelFor(
+        size_t(0), rows, numberOfThreads,
+        [&](size_t bandBegin, size_t bandEnd, unsigned int) {
+          std::vector<FloatType> gVector(columns);
+          std::vector<FloatType> zVector(columns + 1);
+          std::vector<size_t> vVector(columns);
+          std::vector<size_t> argminVector(columns);
+          for(size_t row = bandBegin; row < bandEnd; ++row) {
+            size_t* seedRowPtr = &(nearestSeedIndices(row, 0));
+            for(size_t column = 0; column < columns; ++column) {
+              if(seedRowPtr[column] == rows) {
+                gVector[column] = infinity;
+              } else {
+                FloatType const delta =
+                  FloatType(row) - FloatType(seedRowPtr[column]);
+                gVector[column] = rowSpacingSquared * delta * delta;
+              }
+            }
+
+            privateCode::eucDistLowerEnvelope(
+              &(gVector[0]), columns, columnSpacingSquared,
+              &(vVector[0]), &(zVector[0]), &(distanceMap(row, 0)),
+              &(argminVector[0]));
+            if(!isSquared) {
+              FloatType* distancePtr = &(distanceMap(row, 0));
+              for(size_t column = 0; column < columns; ++column) {
+                distancePtr[column] = std::sqrt(distancePtr[column]);
+              }
+            }
+
+            // Convert the nearest column (and the nearest row within
+            // that column) into a raster index.  The seed rows are
+            // read from a copy, since this loop overwrites them.
+            for(size_t column = 0; column < columns; ++column) {
+              vVector[column] = seedRowPtr[column];
+            }
+            for(size_t column = 0; column < columns; ++column) {
+              size_t const seedColumn = argminVector[column];
+              seedRowPtr[column] = (seedColumn == columns)
+                ? rows * columns : vVector[seedColumn] * columns + seedColumn;
+            }
+          }
+        });
+      return distanceMap;
+    }
+
   } // namespace computerVision
 
 } // namespace brick
@@ -10,33 +10,461 @@
 ***************************************************************************
 */
 
+#include <algorithm>
 #include <limits>
 #include <numeric>
 #include <sstream>
+#include <vector>
+#include <brick/common/parallelFor.hh>
 #include <brick/computerVision/histogramEqualize.hh>
 
 namespace brick {
 
   namespace computerVision {
 
+    // Local helper functions.
+    namespace {
+
+      // Bin functor for integer pixel types, in which pixel values
+      // index the histogram directly.
+      struct IntegerBin {
+        template <class PixelType>
+        size_t operator()(PixelType value) const {
+          return static_cast<size_t>(value);
+        }
+      };
+
+
+      // Bin functor for floating point pixel types.  Returns
+      // numberOfBins (one past the last real bin) for NaN, so that
+      // NaN pixels land in a discard bin.
+      struct FloatBin {
+        FloatBin(size_t numberOfBins, double lowerBound, double upperBound)
+          : m_numberOfBins(numberOfBins),
+            m_lowerBound(lowerBound),
+            m_scale(numberOfBins / (upperBound - lowerBound)) {}
+
+        size_t operator()(double value) const {
+          double position = (value - m_lowerBound) * m_scale;
+          if(!(position >= 0.0)) {
+            return (position < 0.0) ? 0 : m_numberOfBins;
+          }
+          if(position >= static_cast<double>(m_numberOfBins)) {
+            return m_numberOfBins - 1;
+          }
+          return static_cast<size_t>(position);
+        }
+
+        size_t m_numberOfBins;
+        double m_lowerBound;
+        double m_scale;
+      };
+
+
+      // One interpolation sample for CLAHE: a pixel is blended from
+      // tiles index0 and index1 with weights (1 - weight) and weight.
+      struct TileWeight {
+        size_t index0;
+        size_t index1;
+        double weight;
+      };
+
+
+      // Number of interleaved histograms filled by
+      // accumulateHistogram().
+      size_t const numberOfBanks = 4;
+
+
+      // Counts pixels into four interleaved histograms, each bankSize
+      // elements long, so that consecutive pixels with the same value
+      // increment different counters, rather than each waiting for
+      // the previous increment to be stored.
+      template <class PixelType, class BinFunctor>
+      inline void
+      accumulateHistogram(PixelType const* pixels, size_t numberOfPixels,
+                          BinFunctor const& binFunctor,
+                          brick::common::UInt32* banks, size_t bankSize)
+      {
+        brick::common::UInt32* bank0 = banks;
+        brick::common::UInt32* bank1 = bank0 + bankSize;
+        brick::common::UInt32* bank2 = bank1 + bankSize;
+        brick::common::UInt32* bank3 = bank2 + bankSize;
+        size_t pixelIndex = 0;
+        for(; pixelIndex + 4 <= numberOfPixels; pixelIndex += 4) {
+          ++(bank0[binFunctor(pixels[pixelIndex])]);
+          ++(bank1[binFunctor(pixels[pixelIndex + 1])]);
+          ++(bank2[binFunctor(pixels[pixelIndex + 2])]);
+          ++(bank3[binFunctor(pixels[pixelIndex + 3])]);
+        }
+        for(; pixelIndex < numberOfPixels; ++pixelIndex) {
+          ++(bank0[binFunctor(pixels[pixelIndex])]);
+        }
+      }
+
+
+      template <ImageFormat FORMAT>
+      void
+      checkImageSize(const Image<FORMAT>& inputImage,
+                     char const* functionName)
+      {
+        if(inputImage.size() > std::numeric_limits<brick::common::UInt32>::max()) {
+          std::ostringstream message;
+          message << "Currently, we can only equalize images with "
+                  << std::numeric_limits<brick::common::UInt32>::max()
+                  << " or fewer pixels.";
+          BRICK_THROW(common::ValueException, functionName,
+                      message.str().c_str());
+        }
+      }
+
+
+      // Does the work for the public getHistogram() functions.  Each
+      // band of rows gets its own set of banks, and everything is
+      // summed at the end.
+      template <ImageFormat FORMAT, class BinFunctor>
+      numeric::Array1D<brick::common::UInt32>
+      computeHistogram(const Image<FORMAT>& inputImage, size_t numberOfBins,
+                       BinFunctor const& binFunctor,
+                       unsigned int numberOfThreads)
+      {
+        checkImageSize(inputImage, "getHistogram()");
+
+        // One extra bin per bank catches values that shouldn't be
+        // counted.
+        size_t const bankSize = numberOfBins + 1;
+        size_t const bandSize = numberOfBanks * bankSize;
+        size_t const numberOfColumns = inputImage.columns();
+        size_t const numberOfBands = brick::common::getNumberOfBands(
+          inputImage.rows(), numberOfThreads);
+        std::vector<brick::common::UInt32> banks(numberOfBands * bandSize, 0);
+
+        if(numberOfColumns != 0) {
+          brick::common::parallelFor(
+            0, inputImage.rows(), numberOfBands,
+            [&](size_t bandBegin, size_t bandEnd, size_t band) {
+              brick::common::UInt32* bandBanks = &(banks[band * bandSize]);
+              for(size_t row = bandBegin; row < bandEnd; ++row) {
+                accumulateHistogram(
+                  inputImage.data(row, 0), numberOfColumns, binFunctor,
+                  bandBanks, bankSize);
+              }
+            });
+        }
+
+        numeric::Array1D<brick::common::UInt32> histogram(numberOfBins);
+        histogram = 0;
+        for(size_t bank = 0; bank < numberOfBands * numberOfBanks; ++bank) {
+          brick::common::UInt32 const* counts = &(banks[bank * bankSize]);
+          for(size_t bin = 0; bin < numberOfBins; ++bin) {
+            histogram[bin] += counts[bin];
+          }
+        }
+        return histogram;
+      }
+
+
+      // Applies a lookup table to every pixel of an image.
+      template <ImageFormat FORMAT>
+      Image<FORMAT>
+      applyMapping(const Image<FORMAT>& inputImage,
+                   std::vector<typename Image<FORMAT>::PixelType> const& mapping,
+                   unsigned int numberOfThreads)
+      {
+        Image<FORMAT> outputImage(inputImage.rows(), inputImage.columns());
+        size_t const numberOfColumns = inputImage.columns();
+        brick::common::parallelFor(
+          0, inputImage.rows(), numberOfThreads,
+          [&](size_t bandBegin, size_t bandEnd, size_t) {
+            for(size_t row = bandBegin; row < bandEnd; ++row) {
+              typename Image<FORMAT>::PixelType const* inPtr =
+                inputImage.data(row, 0);
+              typename Image<FORMAT>::PixelType* outPtr =
+                outputImage.data(row, 0);
+              for(size_t column = 0; column < numberOfColumns; ++column) {
+                outPtr[column] = mapping[inPtr[column]];
+              }
+            }
+          });
+        return outputImage;
+      }
+
+
+      template <ImageFormat FORMAT>
+      Image<FORMAT>
+      histogramEqualizeImpl(const Image<FORMAT>& inputImage,
+                            unsigned int numberOfThreads)
+      {
+        typedef typename Image<FORMAT>::PixelType PixelType;
+
+        // Compute the histogram and CDF.
+        numeric::Array1D<brick::common::UInt32> histogram =
+          getHistogram(inputImage, numberOfThreads);
+        numeric::Array1D<brick::common::UInt32> cdf(histogram.size());
+        std::partial_sum(histogram.begin(), histogram.end(), cdf.begin(),
+                         std::plus<brick::common::UInt32>());
+
+        // Rescale the image according to the CDF.
+        double scaleFactor =
+          static_cast<double>(histogram.size()) / (inputImage.size() + 1);
+        std::vector<PixelType> mapping(histogram.size());
+        for(size_t bin = 0; bin < mapping.size(); ++bin) {
+          mapping[bin] = static_cast<PixelType>(scaleFactor * cdf[bin]);
+        }
+        return applyMapping(inputImage, mapping, numberOfThreads);
+      }
+
+
+      // Clips a tile histogram as described in the documentation of
+      // adaptiveHistogramEqualize(), and converts it into an
+      // equalizing lookup table.
+      template <class PixelType>
+      void
+      computeClippedMapping(brick::common::UInt32* histogram,
+                            size_t numberOfBins, size_t numberOfPixels,
+                            double clipLimit, PixelType* mapping)
+      {
+        if(clipLimit > 0.0) {
+          size_t limit = static_cast<size_t>(
+            clipLimit * numberOfPixels / numberOfBins);
+          limit = std::max(limit, size_t(1));
+
+          size_t excess = 0;
+          for(size_t bin = 0; bin < numberOfBins; ++bin) {
+            if(histogram[bin] > limit) {
+              excess += histogram[bin] - limit;
+              histogram[bin] = static_cast<brick::common::UInt32>(limit);
+            }
+          }
+
+          // Spread the clipped counts evenly, then scatter whatever
+          // doesn't divide evenly across the range.
+          size_t increment = excess / numberOfBins;
+          size_t residual = excess - increment * numberOfBins;
+          for(size_t bin = 0; bin < numberOfBins; ++bin) {
+            histogram[bin] += static_cast<brick::common::UInt32>(increment);
+          }
+          if(residual != 0) {
+            size_t step = std::max(numberOfBins / residual, size_t(1));
+            for(size_t bin = 0; bin < numberOfBins && residual != 0;
+                bin += step, --residual) {
+              ++(histogram[bin]);
+            }
+          }
+        }
+
+        double scale = static_cast<double>(numberOfBins - 1) / numberOfPixels;
+        brick::common::UInt64 sum = 0;
+        for(size_t bin = 0; bin < numberOfBins; ++bin) {
+          sum += histogram[bin];
+          mapping[bin] = static_cast<PixelType>(
+            std::min(sum * scale + 0.5, static_cast<double>(numberOfBins - 1)));
+        }
+      }
+
+
+      // Given the boundaries of the tiles along one axis, returns, for
+      // each pixel coordinate along that axis, the two tiles whose
+      // centers bracket it, and the blending weight.
+      std::vector<TileWeight>
+      getTileWeights(std::vector<size_t> const& bounds)
+      {
+        size_t const numberOfTiles = bounds.size() - 1;
+        size_t const size = bounds.back();
+        std::vector<double> centers(numberOfTiles);
+        for(size_t tile = 0; tile < numberOfTiles; ++tile) {
+          centers[tile] = (bounds[tile] + bounds[tile + 1] - 1) / 2.0;
+        }
+
+        std::vector<TileWeight> weights(size);
+        size_t tile = 0;
+        for(size_t position = 0; position < size; ++position) {
+          double coordinate = static_cast<double>(position);
+          while(tile + 1 < numberOfTiles && centers[tile + 1] <= coordinate) {
+            ++tile;
+          }
+          TileWeight& tileWeight = weights[position];
+          if(coordinate <= centers[0]) {
+            tileWeight.index0 = tileWeight.index1 = 0;
+            tileWeight.weight = 0.0;
+          } else if(tile + 1 >= numberOfTiles) {
+            tileWeight.index0 = tileWeight.index1 = numberOfTiles - 1;
+            tileWeight.weight = 0.0;
+          } else {
+            tileWeight.index0 = tile;
+            tileWeight.index1 = tile + 1;
+            tileWeight.weight = ((coordinate - centers[tile])
+                                 / (centers[tile + 1] - centers[tile]));
+          }
+        }
+        return weights;
+      }
+
+
+      template <ImageFormat FORMAT>
+      Image<FORMAT>
+      adaptiveHistogramEqualizeImpl(const Image<FORMAT>& inputImage,
+                                    double clipLimit, size_t tileGridRows,
+                                    size_t tileGridColumns,
+                                    unsigned int numberOfThreads)
+      {
+        typedef typename Image<FORMAT>::PixelType PixelType;
+        size_t const numberOfBins =
+          static_cast<size_t>(std::numeric_limits<PixelType>::max()) + 1;
+
+        checkImageSize(inputImage, "adaptiveHistogramEqualize()");
+        if(tileGridRows == 0 || tileGridColumns == 0) {
+          BRICK_THROW(common::ValueException, "adaptiveHistogramEqualize()",
+                      "Tile grid dimensions must be nonzero.");
+        }
+        if(clipLimit < 0.0) {
+          BRICK_THROW(common::ValueException, "adaptiveHistogramEqualize()",
+                      "Argument clipLimit must not be negative.");
+        }
+
+        size_t const rows = inputImage.rows();
+        size_t const columns = inputImage.columns();
+        if(rows == 0 || columns == 0) {
+          return Image<FORMAT>(rows, columns);
+        }
+        tileGridRows = std::min(tileGridRows, rows);
+        tileGridColumns = std::min(tileGridColumns, columns);
+
+        // Tile boundaries.  Tile sizes differ by at most one pixel.
+        std::vector<size_t> rowBounds(tileGridRows + 1);
+        for(size_t tile = 0; tile <= tileGridRows; ++tile) {
+          rowBounds[tile] = (tile * rows) / tileGridRows;
+        }
+        std::vector<size_t> columnBounds(tileGridColumns + 1);
+        for(size_t tile = 0; tile <= tileGridColumns; ++tile) {
+          columnBounds[tile] = (tile * columns) / tileGridColumns;
+        }
+
+        // Compute the lookup table for each tile.
+        size_t const numberOfTiles = tileGridRows * tileGridColumns;
+        std::vector<PixelType> mappings(numberOfTiles * numberOfBins);
+        brick::common::parallelFor(
+          0, numberOfTiles, numberOfThreads,
+          [&](size_t tileBegin, size_t tileEnd, size_t) {
+            std::vector<brick::common::UInt32> banks(
+              numberOfBanks * numberOfBins);
+            for(size_t tile = tileBegin; tile < tileEnd; ++tile) {
+              size_t const tileRow = tile / tileGridColumns;
+              size_t const tileColumn = tile % tileGridColumns;
+              size_t const column0 = columnBounds[tileColumn];
+              size_t const tileWidth = columnBounds[tileColumn + 1] - column0;
+
+              std::fill(banks.begin(), banks.end(), 0);
+              for(size_t row = rowBounds[tileRow];
+                  row < rowBounds[tileRow + 1]; ++row) {
+                accumulateHistogram(
+                  inputImage.data(row, column0), tileWidth, IntegerBin(),
+                  &(banks[0]), numberOfBins);
+              }
+              for(size_t bank = 1; bank < numberOfBanks; ++bank) {
+                for(size_t bin = 0; bin < numberOfBins; ++bin) {
+                  banks[bin] += banks[bank * numberOfBins + bin];
+                }
+              }
+
+              size_t const numberOfPixels =
+                tileWidth * (rowBounds[tileRow + 1] - rowBounds[tileRow]);
+              computeClippedMapping(&(banks[0]), numberOfBins, numberOfPixels,
+                                    clipLimit, &(mappings[tile * numberOfBins]));
+            }
+          });
+
+        // Blend the four nearest mappings at each pixel.
+        std::vector<TileWeight> rowWeights = getTileWeights(rowBounds);
+        std::vector<TileWeight> columnWeights = getTileWeights(columnBounds);
+        Image<FORMAT> outputImage(rows, columns);
+        brick::common::parallelFor(
+          0, rows, numberOfThreads,
+          [&](size_t bandBegin, size_t bandEnd, size_t) {
+            for(size_t row = bandBegin; row < bandEnd; ++row) {
+              TileWeight const& rowWeight = rowWeights[row];
+              PixelType const* mappingRow0 =
+                &(mappings[rowWeight.index0 * tileGridColumns * numberOfBins]);
+              PixelType const* mappingRow1 =
+                &(mappings[rowWeight.index1 * tileGridColumns * numberOfBins]);
+              double const weight1 = rowWeight.weight;
+              double const weight0 = 1.0 - weight1;
+
+              PixelType const* inPtr = inputImage.data(row, 0);
+              PixelType* outPtr = outputImage.data(row, 0);
+              for(size_t column = 0; column < columns; ++column) {
+                TileWeight const& columnWeight = columnWeights[column];
+                size_t const offset0 =
+                  columnWeight.index0 * numberOfBins + inPtr[column];
+                size_t const offset1 =
+                  columnWeight.index1 * numberOfBins + inPtr[column];
+                double const upper =
+                  mappingRow0[offset0] + columnWeight.weight
+                  * (double(mappingRow0[offset1]) - mappingRow0[offset0]);
+                double const lower =
+                  mappingRow1[offset0] + columnWeight.weight
+                  * (double(mappingRow1[offset1]) - mappingRow1[offset0]);
+                outPtr[column] = static_cast<PixelType>(
+                  weight0 * upper + weight1 * lower + 0.5);
+              }
+            }
+          });
+        return outputImage;
+      }
+
+    } // namespace
+
+
     // This function computes the histogram of an image.
     numeric::Array1D<brick::common::UInt32>
-    getHistogram(const Image<GRAY8>& inputImage)
+    getHistogram(const Image<GRAY8>& inputImage, unsigned int numberOfThreads)
+    {
+      return computeHistogram(
+        inputImage, std::numeric_limits<Image<GRAY8>::PixelType>::max() + 1,
+        IntegerBin(), numberOfThreads);
+    }
+
+
+    // This function computes the histogram of a 16-bit image.
+    numeric::Array1D<brick::common::UInt32>
+    getHistogram(const Image<GRAY16>& inputImage, unsigned int numberOfThreads)
+    {
+      return computeHistogram(
+        inputImage, std::numeric_limits<Image<GRAY16>::PixelType>::max() + 1,
+        IntegerBin(), numberOfThreads);
+    }
+
+
+    // This function computes the histogram of a floating point image.
+    numeric::Array1D<brick::common::UInt32>
+    getHistogram(const Image<GRAY_FLOAT32>& inputImage,
+                 size_t numberOfBins, double lowerBound, double upperBound,
+                 unsigned int numberOfThreads)
     {
-      if(inputImage.size() > std::numeric_limits<brick::common::UInt32>::max()) {
-        std::ostringstream message;
-        message << "Currently, we can only equalize images with "
-                << std::numeric_limits<int>::max() << " or fewer pixels.";
-        BRICK_THROW(common::ValueException, "histogramEqualize()", message.str().c_str());
+      if(numberOfBins == 0 || !(upperBound > lowerBound)) {
+        BRICK_THROW(common::ValueException, "getHistogram()",
+                    "Argument numberOfBins must be nonzero, and upperBound "
+                    "must be greater than lowerBound.");
       }
+      return computeHistogram(
+        inputImage, numberOfBins,
+        FloatBin(numberOfBins, lowerBound, upperBound), numberOfThreads);
+    }
 
-      numeric::Array1D<brick::common::UInt32> histogram(
-        std::numeric_limits<Image<GRAY8>::PixelType>::max() + 1);
-      histogram = 0;
-      for(size_t pixelIndex = 0; pixelIndex < inputImage.size(); ++pixelIndex) {
-        ++(histogram[inputImage[pixelIndex]]);
+
+    // This function computes the histogram of a floating point image.
+    numeric::Array1D<brick::common::UInt32>
+    getHistogram(const Image<GRAY_FLOAT64>& inputImage,
+                 size_t numberOfBins, double lowerBound, double upperBound,
+                 unsigned int numberOfThreads)
+    {
+      if(numberOfBins == 0 || !(upperBound > lowerBound)) {
+        BRICK_THROW(common::ValueException, "getHistogram()",
+                    "Argument numberOfBins must be nonzero, and upperBound "
+                    "must be greater than lowerBound.");
       }
-      return histogram;
+      return computeHistogram(
+        inputImage, numberOfBins,
+        FloatBin(numberOfBins, lowerBound, upperBound), numberOfThreads);
     }
 
 
@@ -45,22 +473,44 @@ namespace brick {
     // pixel value, and the histogram of the output image is nearly
     // flat.
     Image<GRAY8>
-    histogramEqualize(const Image<GRAY8>& inputImage)
+    histogramEqualize(const Image<GRAY8>& inputImage,
+                      unsigned int numberOfThreads)
     {
-      // Compute the histogram and CDF.
-      numeric::Array1D<brick::common::UInt32> histogram = getHistogram(inputImage);
-      numeric::Array1D<brick::common::UInt32> cdf(histogram.size());
-      std::partial_sum(histogram.begin(), histogram.end(), cdf.begin(),
-                       std::plus<brick::common::UInt32>());
-
-      // Rescale the image according to the CDF.
-      Image<GRAY8> outputImage(inputImage.rows(), inputImage.columns());
-      double scaleFactor = 256.0 / (inputImage.size() + 1);
-      for(size_t pixelIndex = 0; pixelIndex < inputImage.size(); ++pixelIndex) {
-        outputImage[pixelIndex] =
-          static_cast<common::Int8>(scaleFactor * cdf[inputImage[pixelIndex]]);
-      }
-      return outputImage;
+      return histogramEqualizeImpl(inputImage, numberOfThreads);
+    }
+
+
+    // 16-bit version of histogramEqualize().
+    Image<GRAY16>
+    histogramEqualize(const Image<GRAY16>& inputImage,
+                      unsigned int numberOfThreads)
+    {
+      return histogramEqualizeImpl(inputImage, numberOfThreads);
+    }
+
+
+    // This function performs contrast limited adaptive histogram
+    // equalization.
+    Image<GRAY8>
+    adaptiveHistogramEqualize(const Image<GRAY8>& inputImage,
+                              double clipLimit, size_t tileGridRows,
+                              size_t tileGridColumns,
+                              unsigned int numberOfThreads)
+    {
+      return adaptiveHistogramEqualizeImpl(
+        inputImage, clipLimit, tileGridRows, tileGridColumns, numberOfThreads);
+    }
+
+
+    // 16-bit version of adaptiveHistogramEqualize().
+    Image<GRAY16>
+    adaptiveHistogramEqualize(const Image<GRAY16>& inputImage,
+                              double clipLimit, size_t tileGridRows,
+                              size_t tileGridColumns,
+                              unsigned int numberOfThreads)
+    {
+      return adaptiveHistogramEqualizeImpl(
+        inputImage, clipLimit, tileGridRows, tileGridColumns, numberOfThreads);
     }
 
   } // namespace computerVision
@@ -26,15 +26,104 @@ namespace brick {
      * counts the number of pixels with each possible value and returns
      * a 1D array of counts.
      *
+     * Counting is done into several interleaved sub-histograms,
+     * which are summed at the end, so that runs of identical pixel
+     * values don't serialize on a single counter.  If more than one
+     * thread is requested, each thread histograms a band of rows, and
+     * the band histograms are summed.
+     *
      * @param inputImage This argument is the image to be histogrammed.
      *
+     * @param numberOfThreads This argument specifies how many threads
+     * should share the work.  Setting it to zero uses one thread per
+     * available processor.
+     *
      * @return The return value is a 1D array in which the first element
      * indicates the number of pixels having the value 0, the second
      * element indicates the number of pixels having the value 1, and so
      * forth.
      */
     brick::numeric::Array1D<brick::common::UInt32>
-    getHistogram(const Image<GRAY8>& inputImage);
+    getHistogram(const Image<GRAY8>& inputImage,
+                 unsigned int numberOfThreads = 1);
+
+
+    /**
+     * This function computes the histogram of a 16-bit image.  It
+     * works just like the GRAY8 version, but the returned array has
+     * 65536 elements.
+     *
+     * @param inputImage This argument is the image to be histogrammed.
+     *
+     * @param numberOfThreads This argument specifies how many threads
+     * should share the work.  Setting it to zero uses one thread per
+     * available processor.
+     *
+     * @return The return value is a 1D array of counts, indexed by
+     * pixel value.
+     */
+    brick::numeric::Array1D<brick::common::UInt32>
+    getHistogram(const Image<GRAY16>& inputImage,
+                 unsigned int numberOfThreads = 1);
+
+
+    /**
+     * This function computes the histogram of a floating point
+     * image, using numberOfBins equal-width bins spanning the range
+     * [lowerBound, upperBound).  Pixels below lowerBound are counted
+     * in the first bin, pixels at or above upperBound are counted in
+     * the last bin, and NaN pixels are not counted.
+     *
+     * @param inputImage This argument is the image to be histogrammed.
+     *
+     * @param numberOfBins This argument specifies the number of
+     * elements in the returned array.  It must be nonzero.
+     *
+     * @param lowerBound This argument is the lower edge of the first
+     * bin.
+     *
+     * @param upperBound This argument is the upper edge of the last
+     * bin.  It must be greater than lowerBound.
+     *
+     * @param numberOfThreads This argument specifies how many threads
+     * should share the work.  Setting it to zero uses one thread per
+     * available processor.
+     *
+     * @return The return value is a 1D array of counts, in which
+     * element i counts pixels in the range [lowerBound + i * w,
+     * lowerBound + (i + 1) * w), where w is the bin width.
+     */
+    brick::numeric::Array1D<brick::common::UInt32>
+    getHistogram(const Image<GRAY_FLOAT32>& inputImage,
+                 size_t numberOfBins, double lowerBound, double upperBound,
+                 unsigned int numberOfThreads = 1);
+
+
+    /**
+     * This function works just like the GRAY_FLOAT32 version of
+     * getHistogram(), above, but accepts a GRAY_FLOAT64 image.
+     *
+     * @param inputImage This argument is the image to be histogrammed.
+     *
+     * @param numberOfBins This argument specifies the number of
+     * elements in the returned array.  It must be nonzero.
+     *
+     * @param lowerBound This argument is the lower edge of the first
+     * bin.
+     *
+     * @param upperBound This argument is the upper edge of the last
+     * bin.  It must be greater than lowerBound.
+     *
+     * @param numberOfThreads This argument specifies how many threads
+     * should share the work.  Setting it to zero uses one thread per
+     * available processor.
+     *
+     * @return The return value is a 1D array of counts.
+     */
+    brick::numeric::Array1D<brick::common::UInt32>
+    getHistogram(const Image<GRAY_FLOAT64>& inputImage,
+                 size_t numberOfBins, double lowerBound, double upperBound,
+                 unsigned int numberOfThreads = 1);
 
 
     /**
@@ -45,10 +134,105 @@ namespace brick {
      *
      * @param inputImage This argument is the image to be equalized.
      *
+     * @param numberOfThreads This argument specifies how many threads
+     * should share the work.  Setting it to zero uses one thread per
+     * available processor.
+     *
      * @return The return value is the histogram equalized image.
      */
     Image<GRAY8>
-    histogramEqualize(const Image<GRAY8>& inputImage);
+    histogramEqualize(const Image<GRAY8>& inputImage,
+                      unsigned int numberOfThreads = 1);
+
+
+    /**
+     * This function works just like the GRAY8 version of
+     * histogramEqualize(), but for 16-bit images.
+     *
+     * @param inputImage This argument is the image to be equalized.
+     *
+     * @param numberOfThreads This argument specifies how many threads
+     * should share the work.  Setting it to zero uses one thread per
+     * available processor.
+     *
+     * @return The return value is the histogram equalized image.
+     */
+    Image<GRAY16>
+    histogramEqualize(const Image<GRAY16>& inputImage,
+                      unsigned int numberOfThreads = 1);
+
+
+    /**
+     * This function performs contrast limited adaptive histogram
+     * equalization (CLAHE).  The image is divided into a grid of
+     * tiles, a clipped equalization mapping is computed from the
+     * histogram of each tile, and each output pixel is computed by
+     * bilinearly blending the mappings of the four tiles whose
+     * centers surround it.  Clipping limits the slope of each
+     * mapping, and so limits the amplification of noise in nearly
+     * uniform regions.
+     *
+     * @param inputImage This argument is the image to be equalized.
+     *
+     * @param clipLimit This argument limits the height of each tile
+     * histogram, as a multiple of the average bin count for that
+     * tile.  Counts above the limit are redistributed evenly over all
+     * bins.  Values of 1.0 or less give no contrast enhancement, and
+     * setting this argument to zero disables clipping, giving
+     * ordinary (unlimited) adaptive histogram equalization.
+     *
+     * @param tileGridRows This argument specifies how many rows of
+     * tiles to use.  It will be reduced if the image has fewer rows
+     * than this.
+     *
+     * @param tileGridColumns This argument specifies how many columns
+     * of tiles to use.  It will be reduced if the image has fewer
+     * columns than this.
+     *
+     * @param numberOfThreads This argument specifies how many threads
+     * should share the work.  Setting it to zero uses one thread per
+     * available processor.
+     *
+     * @return The return value is the equalized image.
+     */
+    Image<GRAY8>
+    adaptiveHistogramEqualize(const Image<GRAY8>& inputImage,
+                              double clipLimit = 4.0,
+                              size_t tileGridRows = 8,
+                              size_t tileGridColumns = 8,
+                              unsigned int numberOfThreads = 1);
+
+
+    /**
+     * This function works just like the GRAY8 version of
+     * adaptiveHistogramEqualize(), but for 16-bit images.  Each tile
+     * histogram has 65536 bins, so tiles should be large enough to
+     * make the clip limit meaningful.
+     *
+     * @param inputImage This argument is the image to be equalized.
+     *
+     * @param clipLimit This argument limits the height of each tile
+     * histogram, as a multiple of the average bin count for that
+     * tile.
+     *
+     * @param tileGridRows This argument specifies how many rows of
+     * tiles to use.
+     *
+     * @param tileGridColumns This argument specifies how many columns
+     * of tiles to use.
+     *
+     * @param numberOfThreads This argument specifies how many threads
+     * should share the work.  Setting it to zero uses one thread per
+     * available processor.
+     *
+     * @return The return value is the equalized image.
+     */
+    Image<GRAY16>
+    adaptiveHistogramEqualize(const Image<GRAY16>& inputImage,
+                              double clipLimit = 4.0,
+                              size_t tileGridRows = 8,
+                              size_t tileGridColumns = 8,
+                              unsigned int numberOfThreads = 1);
 
   } // namespace computerVision
 
@@ -13,6 +13,7 @@
 #ifndef BRICK_COMPUTERVISION_IMAGEFILTER_HH
 #define BRICK_COMPUTERVISION_IMAGEFILTER_HH
 
+#include <vector>
 #include <brick/computerVision/image.hh>
 #include <brick/computerVision/kernel.hh>
 #include <brick/numeric/convolutionStrategy.hh>
@@ -115,6 +116,122 @@ namespace brick {
       ConvolutionStrategy convolutionStrategy = BRICK_CONVOLVE_PAD_RESULT);
 
 
+    /**
+     ** This enum is used to tell filter2D() how to do its arithmetic.
+     **/
+    enum Filter2DMethod {
+      /** Pick whichever of the methods below is estimated to be cheapest. */
+      FILTER2D_AUTO,
+
+      /** Correlate with the full 2D kernel, as filter2D() always has. */
+      FILTER2D_DIRECT,
+
+      /** Correlate with each term returned by decomposeKernel(), using
+          one pass along the rows and one along the columns per term,
+          and sum the results. */
+      FILTER2D_LOW_RANK,
+
+      /** Correlate in the frequency domain. */
+      FILTER2D_FFT
+    };
+
+
+    /**
+     * This function approximates an arbitrary kernel as a sum of
+     * separable kernels by taking its singular value decomposition
+     * and discarding the smallest singular values.  Filtering with
+     * each of the returned kernels, and adding up the results, is
+     * equivalent (within tolerance) to filtering with the input
+     * kernel, but costs (rank * (rows + columns)) operations per
+     * pixel, rather than (rows * columns).
+     *
+     * This is only meaningful for floating point KernelType.  If the
+     * input kernel is already separable, it is simply copied into the
+     * returned vector.
+     *
+     * @param kernel This argument is the kernel to be decomposed.
+     *
+     * @param relativeTolerance This argument specifies how accurate
+     * the approximation must be.  As few terms as possible are
+     * returned, subject to the constraint that the Frobenius norm of
+     * the difference between the sum of the returned kernels and the
+     * input kernel is no larger than relativeTolerance times the
+     * Frobenius norm of the input kernel.
+     *
+     * @param maximumRank This argument, if nonzero, limits the number
+     * of returned terms, overriding relativeTolerance.
+     *
+     * @return The return value is a vector of separable kernels,
+     * each the same size as the input kernel, in order of decreasing
+     * magnitude.  It is empty if the input kernel is all zeros.
+     */
+    template <class KernelType>
+    std::vector< Kernel<KernelType> >
+    decomposeKernel(const Kernel<KernelType>& kernel,
+                    double relativeTolerance = 1.0E-6,
+                    size_t maximumRank = 0);
+
+
+    /**
+     * This function filters an image with the given kernel, placing
+     * the result into outputImage, and picks among several equivalent
+     * ways of doing the arithmetic.  Large non-separable kernels are
+     * much faster to apply using a low-rank separable approximation
+     * (see decomposeKernel()), or using the FFT, than by direct 2D
+     * correlation.  If argument method is FILTER2D_AUTO, the choice
+     * is made by estimating the number of multiply-adds required by
+     * each approach.
+     *
+     * The result follows the BRICK_CONVOLVE_PAD_RESULT convention:
+     * output pixels for which the kernel doesn't completely overlap
+     * the input image, which form a border of half the kernel size,
+     * are set to fillValue.  Note that this differs from the
+     * separable-kernel branch of the filter2D() overloads above,
+     * whose column pass filters the row pass's border fill.
+     *
+     * Arithmetic is done using the output pixel type, so OutputFormat
+     * should generally be a floating point format.  The FFT and
+     * low-rank methods are approximations, accurate to roughly
+     * relativeTolerance (low-rank) or floating point roundoff (FFT).
+     *
+     * @param outputImage This argument is used to return the result.
+     * It will be reinitialized if it doesn't already have the same
+     * size as image.
+     *
+     * @param kernel This argument is the Kernel instance with which
+     * to filter.
+     *
+     * @param image This argument is the Image to be filtered.
+     *
+     * @param fillValue This argument specifies the value with which
+     * image edges should be padded.
+     *
+     * @param method This argument specifies how to do the filtering.
+     *
+     * @param relativeTolerance This argument is passed to
+     * decomposeKernel() when considering the low-rank method.
+     *
+     * @param numberOfThreads This argument specifies how many threads
+     * should share the work.  Setting it to zero uses one thread per
+     * available processor.  The direct method is single-threaded.
+     *
+     * @return The return value is the method actually used, which is
+     * only interesting if argument method is FILTER2D_AUTO.
+     */
+    template<ImageFormat OutputFormat,
+             ImageFormat ImageFormat,
+             class KernelType>
+    Filter2DMethod
+    filter2D(
+      Image<OutputFormat>& outputImage,
+      const Kernel<KernelType>& kernel,
+      const Image<ImageFormat>& image,
+      const typename ImageFormatTraits<OutputFormat>::PixelType fillValue,
+      Filter2DMethod method,
+      double relativeTolerance = 1.0E-6,
+      unsigned int numberOfThreads = 1);
+
+
     /**
      * This function low-pass filters each column of an image with
      * integer-valued pixels using a binomial approximation to a
@@ -18,8 +18,13 @@
 //
 // #include <brick/computerVision/imageFilter.hh>
 
-// #include <cmath>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <brick/common/parallelFor.hh>
+#include <brick/computerVision/fft2D.hh>
 #include <brick/computerVision/utilities.hh>
+#include <brick/linearAlgebra/linearAlgebra.hh>
 #include <brick/numeric/convolve2D.hh>
 // #include <brick/numeric/functional.hh>
 
@@ -549,6 +554,311 @@ namespace brick {
     }
 
 
+    /// @cond privateCode
+    namespace privateCode {
+
+      // Correlates image with one separable term, and adds the result
+      // to the rows [rowBegin, rowEnd) and columns [columnBegin,
+      // columnEnd) of accumulator.  Argument rowBuffer is scratch
+      // space.
+      template <class AccumulatorType, class KernelType, class PixelType>
+      void
+      filter2DAddSeparableTerm(
+        brick::numeric::Array2D<AccumulatorType>& accumulator,
+        brick::numeric::Array2D<AccumulatorType>& rowBuffer,
+        const Kernel<KernelType>& term,
+        const brick::numeric::Array2D<PixelType>& image,
+        size_t rowBegin, size_t rowEnd,
+        size_t columnBegin, size_t columnEnd,
+        unsigned int numberOfThreads)
+      {
+        brick::numeric::Array1D<KernelType> rowComponent =
+          term.getRowComponent();
+        brick::numeric::Array1D<KernelType> columnComponent =
+          term.getColumnComponent();
+        size_t const validColumns = columnEnd - columnBegin;
+        size_t const halfRows = columnComponent.size() / 2;
+
+        // Filter along the rows.  rowBuffer(row, ii) holds the row
+        // pass result for image pixel (row, columnBegin + ii).  The
+        // loops are ordered so that the inner one runs along the
+        // image row, which vectorizes well.
+        brick::common::parallelFor(
+          0, image.rows(), numberOfThreads,
+          [&](size_t bandBegin, size_t bandEnd, unsigned int) {
+            for(size_t row = bandBegin; row < bandEnd; ++row) {
+              AccumulatorType* outPtr = rowBuffer.data(row, 0);
+              std::fill(outPtr, outPtr + validColumns, AccumulatorType(0));
+              PixelType const* inPtr =
+                image.data(row, 0) + columnBegin - rowComponent.size() / 2;
+              for(size_t jj = 0; jj < rowComponent.size(); ++jj) {
+                AccumulatorType const weight =
+                  static_cast<AccumulatorType>(rowComponent[jj]);
+                PixelType const* tapPtr = inPtr + jj;
+                for(size_t ii = 0; ii < validColumns; ++ii) {
+                  outPtr[ii] += weight
+                    * static_cast<AccumulatorType>(tapPtr[ii]);
+                }
+              }
+            }
+          });
+
+        // Filter along the columns.
+        brick::common::parallelFor(
+          rowBegin, rowEnd, numberOfThreads,
+          [&](size_t bandBegin, size_t bandEnd, unsigned int) {
+            for(size_t row = bandBegin; row < bandEnd; ++row) {
+              AccumulatorType* outPtr = accumulator.data(row, columnBegin);
+              for(size_t jj = 0; jj < columnComponent.size(); ++jj) {
+                AccumulatorType const weight =
+                  static_cast<AccumulatorType>(columnComponent[jj]);
+                AccumulatorType const* tapPtr =
+                  rowBuffer.data(row - halfRows + jj, 0);
+                for(size_t ii = 0; ii < validColumns; ++ii) {
+                  outPtr[ii] += weight * tapPtr[ii];
+                }
+              }
+            }
+          });
+      }
+
+
+      // Correlates image with kernel in the frequency domain, and
+      // writes the rows [rowBegin, rowEnd) and columns [columnBegin,
+      // columnEnd) of result.
+      template <class OutputType, class KernelType, class PixelType>
+      void
+      filter2DUsingFFT(
+        brick::numeric::Array2D<OutputType>& result,
+        const brick::numeric::Array2D<KernelType>& kernel,
+        const brick::numeric::Array2D<PixelType>& image,
+        size_t rowBegin, size_t rowEnd,
+        size_t columnBegin, size_t columnEnd,
+        unsigned int numberOfThreads)
+      {
+        typedef std::complex<brick::common::Float64> ComplexType;
+
+        // Zero padding to the image size is enough, since none of
+        // the output pixels we keep depend on wrapped-around input.
+        size_t const paddedRows = fft2DNextPowerOfTwo(image.rows());
+        size_t const paddedColumns = fft2DNextPowerOfTwo(image.columns());
+        brick::numeric::Array2D<ComplexType> imageSpectrum =
+          fft2DGetSpectrum<ComplexType>(
+            image, paddedRows, paddedColumns, numberOfThreads);
+        brick::numeric::Array2D<ComplexType> product =
+          fft2DGetSpectrum<ComplexType>(
+            kernel, paddedRows, paddedColumns, numberOfThreads);
+
+        // Correlation is multiplication by the complex conjugate in
+        // the frequency domain.  We compute the inverse transform as
+        // conj(FFT(conj(X))) / N, and since the result is real, the
+        // outer conj() can be skipped.  Element (row, column) of the
+        // transformed product is then the correlation of the kernel
+        // with the image window whose upper left corner is at (row,
+        // column).
+        for(size_t ii = 0; ii < product.size(); ++ii) {
+          product[ii] *= std::conj(imageSpectrum[ii]);
+        }
+        fft2DTransform(product, numberOfThreads);
+
+        brick::common::Float64 const scale =
+          1.0 / static_cast<brick::common::Float64>(product.size());
+        size_t const halfRows = kernel.rows() / 2;
+        size_t const halfColumns = kernel.columns() / 2;
+        for(size_t row = rowBegin; row < rowEnd; ++row) {
+          for(size_t column = columnBegin; column < columnEnd; ++column) {
+            result(row, column) = static_cast<OutputType>(
+              product(row - halfRows, column - halfColumns).real() * scale);
+          }
+        }
+      }
+
+    } // namespace privateCode
+    /// @endcond
+
+
+    // This function approximates an arbitrary kernel as a sum of
+    // separable kernels.
+    template <class KernelType>
+    std::vector< Kernel<KernelType> >
+    decomposeKernel(const Kernel<KernelType>& kernel,
+                    double relativeTolerance,
+                    size_t maximumRank)
+    {
+      std::vector< Kernel<KernelType> > result;
+      if(kernel.isSeparable()) {
+        result.push_back(kernel);
+        return result;
+      }
+
+      brick::numeric::Array2D<KernelType> kernelArray = kernel.getArray2D();
+      if(kernelArray.size() == 0) {
+        return result;
+      }
+      brick::numeric::Array2D<brick::common::Float64> inputArray(
+        kernelArray.rows(), kernelArray.columns());
+      for(size_t ii = 0; ii < kernelArray.size(); ++ii) {
+        inputArray[ii] = static_cast<brick::common::Float64>(kernelArray[ii]);
+      }
+      brick::numeric::Array2D<brick::common::Float64> uArray;
+      brick::numeric::Array1D<brick::common::Float64> sigmaArray;
+      brick::numeric::Array2D<brick::common::Float64> vTransposeArray;
+      brick::linearAlgebra::singularValueDecomposition(
+        inputArray, uArray, sigmaArray, vTransposeArray);
+
+      // The squared Frobenius norm of the approximation error is the
+      // sum of the squares of the discarded singular values, so drop
+      // singular values from the small end for as long as that sum
+      // stays within tolerance.
+      brick::common::Float64 totalEnergy = 0.0;
+      for(size_t ii = 0; ii < sigmaArray.size(); ++ii) {
+        totalEnergy += sigmaArray[ii] * sigmaArray[ii];
+      }
+      brick::common::Float64 const allowedError =
+        relativeTolerance * relativeTolerance * totalEnergy;
+      brick::common::Float64 discardedEnergy = 0.0;
+      size_t rank = sigmaArray.size();
+      while(rank > 0) {
+        brick::common::Float64 const energy =
+          sigmaArray[rank - 1] * sigmaArray[rank - 1];
+        if(discardedEnergy + energy > allowedError) {
+          break;
+        }
+        discardedEnergy += energy;
+        --rank;
+      }
+      if(maximumRank != 0 && rank > maximumRank) {
+        rank = maximumRank;
+      }
+
+      // Split each singular value evenly between the row and column
+      // components, so that neither is badly scaled.
+      for(size_t term = 0; term < rank; ++term) {
+        brick::common::Float64 const scale = std::sqrt(sigmaArray[term]);
+        brick::numeric::Array1D<KernelType> rowComponent(
+          vTransposeArray.columns());
+        brick::numeric::Array1D<KernelType> columnComponent(uArray.rows());
+        for(size_t column = 0; column < rowComponent.size(); ++column) {
+          rowComponent[column] = static_cast<KernelType>(
+            scale * vTransposeArray(term, column));
+        }
+        for(size_t row = 0; row < columnComponent.size(); ++row) {
+          columnComponent[row] = static_cast<KernelType>(
+            scale * uArray(row, term));
+        }
+        result.push_back(Kernel<KernelType>(rowComponent, columnComponent));
+      }
+      return result;
+    }
+
+
+    // This function filters an image with the given kernel, picking
+    // among several equivalent ways of doing the arithmetic.
+    template<ImageFormat OutputFormat,
+             ImageFormat ImageFormat,
+             class KernelType>
+    Filter2DMethod
+    filter2D(
+      Image<OutputFormat>& outputImage,
+      const Kernel<KernelType>& kernel,
+      const Image<ImageFormat>& image,
+      const typename ImageFormatTraits<OutputFormat>::PixelType fillValue,
+      Filter2DMethod method,
+      double relativeTolerance,
+      unsigned int numberOfThreads)
+    {
+      typedef typename ImageFormatTraits<OutputFormat>::PixelType
+        OutputPixelType;
+
+      size_t const kernelRows = kernel.getRows();
+      size_t const kernelColumns = kernel.getColumns();
+      if(kernelRows == 0 || kernelColumns == 0) {
+        BRICK_THROW(brick::common::ValueException, "filter2D()",
+                    "Kernel must not be empty.");
+      }
+      if(outputImage.rows() != image.rows()
+         || outputImage.columns() != image.columns()) {
+        outputImage.reinit(image.rows(), image.columns());
+      }
+      outputImage = fillValue;
+
+      // Output pixels inside this region are those for which the
+      // kernel completely overlaps the image.  Everything else
+      // stays at fillValue.
+      if(kernelRows > image.rows() || kernelColumns > image.columns()) {
+        return (method == FILTER2D_AUTO) ? FILTER2D_DIRECT : method;
+      }
+      size_t const rowBegin = kernelRows / 2;
+      size_t const rowEnd = image.rows() - kernelRows / 2;
+      size_t const columnBegin = kernelColumns / 2;
+      size_t const columnEnd = image.columns() - kernelColumns / 2;
+
+      std::vector< Kernel<KernelType> > terms;
+      if(method == FILTER2D_AUTO || method == FILTER2D_LOW_RANK) {
+        terms = decomposeKernel(kernel, relativeTolerance);
+      }
+
+      // Pick a method by estimating the number of multiply-adds
+      // required by each.  The FFT method needs three transforms:
+      // image, kernel, and inverse.
+      if(method == FILTER2D_AUTO) {
+        double const validRows = double(rowEnd - rowBegin);
+        double const validColumns = double(columnEnd - columnBegin);
+        double directCost =
+          validRows * validColumns * double(kernelRows * kernelColumns);
+        double lowRankCost =
+          double(terms.size()) * validColumns
+          * (double(image.rows()) * double(kernelColumns)
+             + validRows * double(kernelRows));
+        double fftCost = 3.0 * privateCode::fft2DTransformCost(
+          image.rows(), image.columns());
+        method = FILTER2D_DIRECT;
+        double bestCost = directCost;
+        if(lowRankCost < bestCost) {
+          method = FILTER2D_LOW_RANK;
+          bestCost = lowRankCost;
+        }
+        if(fftCost < bestCost) {
+          method = FILTER2D_FFT;
+        }
+      }
+
+      switch(method) {
+      case FILTER2D_LOW_RANK:
+      {
+        brick::numeric::Array2D<OutputPixelType> rowBuffer(
+          image.rows(), columnEnd - columnBegin);
+        for(size_t row = rowBegin; row < rowEnd; ++row) {
+          OutputPixelType* outPtr = outputImage.data(row, columnBegin);
+          std::fill(outPtr, outPtr + (columnEnd - columnBegin),
+                    OutputPixelType(0));
+        }
+        for(size_t ii = 0; ii < terms.size(); ++ii) {
+          privateCode::filter2DAddSeparableTerm(
+            outputImage, rowBuffer, terms[ii], image,
+            rowBegin, rowEnd, columnBegin, columnEnd, numberOfThreads);
+        }
+        break;
+      }
+      case FILTER2D_FFT:
+        privateCode::filter2DUsingFFT(
+          outputImage, kernel.getArray2D(), image,
+          rowBegin, rowEnd, columnBegin, columnEnd, numberOfThreads);
+        break;
+      default:
+        outputImage =
+          numeric::correlate2D<OutputPixelType, OutputPixelType>(
+            kernel.getArray2D(), image,
+            numeric::BRICK_CONVOLVE_PAD_RESULT,
+            numeric::BRICK_CONVOLVE_ROI_SAME,
+            fillValue);
+        method = FILTER2D_DIRECT;
+        break;
+      }
+      return method;
+    }
+
+
     // This function low-pass filters each column of an image with
     // integer-valued pixels using a binomial approximation to a
     // Gaussian kernel.
@@ -33,6 +33,18 @@ namespace brick {
      ** which the output pixel should take it's color.  It must take a
      ** single Vector2D<NumericType> instance as its argument, and
      ** return a Vector2D<NumericType> instance.
+     **
+     ** By default, the lookup table stores floating point
+     ** interpolation weights for each output pixel, which is
+     ** accurate, but costs several dozen bytes per pixel.  For large
+     ** images, where streaming the table through memory can take
+     ** longer than the warp itself, the constructor can instead build
+     ** a compact table that stores only a 32-bit source index and two
+     ** 16-bit fixed-point fractional offsets (8 bytes) per pixel.
+     ** With the compact table, GRAY8 and RGB8 images are interpolated
+     ** using integer arithmetic, and the fractional offsets are
+     ** quantized to 1/256 of a pixel.  Other formats are interpolated
+     ** in NumericType, with offsets quantized to 1/65536 of a pixel.
      **/
     template <class NumericType, class TransformFunctor>
     class ImageWarper
@@ -68,10 +80,17 @@ namespace brick {
        * @param transformer This argument is a functor that defines
        * the warp.  Please see the documentation for class ImageWarper
        * for more information.
+       *
+       * @param isCompact This argument specifies whether to build
+       * the compact fixed-point lookup table described in the
+       * documentation for class ImageWarper, rather than the default
+       * floating point table.  The compact table requires that the
+       * input image have fewer than 2^32 - 1 pixels.
        */
       ImageWarper(size_t inputRows, size_t inputColumns,
                   size_t outputRows, size_t outputColumns,
-                  TransformFunctor transformer);
+                  TransformFunctor transformer,
+                  bool isCompact = false);
 
 
       /**
@@ -91,15 +110,48 @@ namespace brick {
        * to use for pixels in the output image that map to input-image
        * pixels that lie outside the boundaries of the input image.
        *
+       * @param numberOfThreads This argument specifies how many
+       * threads should share the work.  Each thread processes a band
+       * of output rows, in tiles small enough that the corresponding
+       * input pixels stay in cache.  Setting this argument to zero
+       * uses one thread per available processor.
+       *
        * @return The return value is the warped output image.
        */
       template <ImageFormat InputFormat, ImageFormat OutputFormat>
       Image<OutputFormat>
       warpImage(Image<InputFormat> const& inputImage,
-                typename Image<OutputFormat>::PixelType defaultValue) const;
+                typename Image<OutputFormat>::PixelType defaultValue,
+                unsigned int numberOfThreads = 1) const;
+
+
+      /**
+       * This member function returns true if the instance was
+       * constructed to use the compact lookup table.
+       *
+       * @return The return value indicates which lookup table is in
+       * use.
+       */
+      bool
+      isCompact() const {return m_isCompact;}
 
     private:
 
+      // Output images are processed in tiles of this size.
+      static const size_t TileRows = 16;
+      static const size_t TileColumns = 256;
+
+      // Compact lookup table entry.  The fractional offsets are
+      // scaled by 65536.  Out-of-bounds pixels are marked by setting
+      // index00 to InvalidIndex.
+      struct CompactSampleInfo {
+        brick::common::UInt32 index00;
+        brick::common::UInt16 xFraction;
+        brick::common::UInt16 yFraction;
+      };
+
+      static const brick::common::UInt32 InvalidIndex = 0xffffffff;
+
       struct SampleInfo {
         NumericType c00;
         NumericType c01;
@@ -109,9 +161,19 @@ namespace brick {
         bool isInBounds;
       };
 
+      // Warps rows [startRow, stopRow) of the output image.
+      template <ImageFormat InputFormat, ImageFormat OutputFormat>
+      void
+      warpRows(Image<InputFormat> const& inputImage,
+               Image<OutputFormat>& outputImage,
+               typename Image<OutputFormat>::PixelType const& defaultValue,
+               size_t startRow, size_t stopRow) const;
+
       size_t m_inputColumns;
       size_t m_inputRows;
+      bool m_isCompact;
       brick::numeric::Array2D<SampleInfo> m_lookupTable;
+      brick::numeric::Array2D<CompactSampleInfo> m_compactLookupTable;
 
     };
 
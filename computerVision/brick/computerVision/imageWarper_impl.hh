@@ -19,20 +19,120 @@
 //
 // #include <brick/computerVision/imageWarper.hh>
 
-#include <brick/numeric/vector2D.hh>
+#include <algorithm>
+#include <sstream>
+#include <brick/common/exception.hh>
 #include <brick/common/mathFunctions.hh>
+#include <brick/common/parallelFor.hh>
+#include <brick/numeric/vector2D.hh>
 
 namespace brick {
 
   namespace computerVision {
 
+    /// @cond privateCode
+    namespace privateCode {
+
+      // Bilinear interpolation using an entry from the compact lookup
+      // table.  This generic version works for any pixel type that
+      // the default lookup table supports.
+      template <class NumericType, class InputPixelType,
+                class OutputPixelType>
+      inline void
+      interpolateCompact(InputPixelType const* inputPtr, size_t columns,
+                         brick::common::UInt16 xFraction,
+                         brick::common::UInt16 yFraction,
+                         OutputPixelType& outputPixel)
+      {
+        NumericType const scale = NumericType(1.0 / 65536.0);
+        NumericType xFrac = xFraction * scale;
+        NumericType yFrac = yFraction * scale;
+        NumericType oneMinusXFrac = 1.0 - xFrac;
+        NumericType oneMinusYFrac = 1.0 - yFrac;
+        outputPixel = (oneMinusXFrac * oneMinusYFrac) * inputPtr[0];
+        outputPixel += (xFrac * oneMinusYFrac) * inputPtr[1];
+        outputPixel += (xFrac * yFrac) * inputPtr[columns + 1];
+        outputPixel += (oneMinusXFrac * yFrac) * inputPtr[columns];
+      }
+
+
+      // Integer interpolation of one 8-bit channel, with weights in
+      // units of 1/256.
+      inline brick::common::UInt8
+      interpolateChannel8(brick::common::UInt32 p00, brick::common::UInt32 p01,
+                          brick::common::UInt32 p10, brick::common::UInt32 p11,
+                          brick::common::UInt32 xWeight,
+                          brick::common::UInt32 yWeight)
+      {
+        brick::common::UInt32 top = p00 * (256 - xWeight) + p01 * xWeight;
+        brick::common::UInt32 bottom = p10 * (256 - xWeight) + p11 * xWeight;
+        return static_cast<brick::common::UInt8>(
+          (top * (256 - yWeight) + bottom * yWeight + 32768) >> 16);
+      }
+
+
+      // Specialization for GRAY8 images.
+      template <class NumericType>
+      inline void
+      interpolateCompact(brick::common::UInt8 const* inputPtr, size_t columns,
+                         brick::common::UInt16 xFraction,
+                         brick::common::UInt16 yFraction,
+                         brick::common::UInt8& outputPixel)
+      {
+        brick::common::UInt32 xWeight = (xFraction + 128) >> 8;
+        brick::common::UInt32 yWeight = (yFraction + 128) >> 8;
+        outputPixel = interpolateChannel8(
+          inputPtr[0], inputPtr[1], inputPtr[columns], inputPtr[columns + 1],
+          xWeight, yWeight);
+      }
+
+
+      // Specialization for RGB8 images.
+      template <class NumericType>
+      inline void
+      interpolateCompact(PixelRGB8 const* inputPtr, size_t columns,
+                         brick::common::UInt16 xFraction,
+                         brick::common::UInt16 yFraction,
+                         PixelRGB8& outputPixel)
+      {
+        brick::common::UInt32 xWeight = (xFraction + 128) >> 8;
+        brick::common::UInt32 yWeight = (yFraction + 128) >> 8;
+        PixelRGB8 const& p00 = inputPtr[0];
+        PixelRGB8 const& p01 = inputPtr[1];
+        PixelRGB8 const& p10 = inputPtr[columns];
+        PixelRGB8 const& p11 = inputPtr[columns + 1];
+        outputPixel.red = interpolateChannel8(
+          p00.red, p01.red, p10.red, p11.red, xWeight, yWeight);
+        outputPixel.green = interpolateChannel8(
+          p00.green, p01.green, p10.green, p11.green, xWeight, yWeight);
+        outputPixel.blue = interpolateChannel8(
+          p00.blue, p01.blue, p10.blue, p11.blue, xWeight, yWeight);
+      }
+
+    } // namespace privateCode
+    /// @endcond
+
+
+    template<class NumericType, class TransformFunctor>
+    const size_t ImageWarper<NumericType, TransformFunctor>::TileRows;
+
+    template<class NumericType, class TransformFunctor>
+    const size_t ImageWarper<NumericType, TransformFunctor>::TileColumns;
+
+    template<class NumericType, class TransformFunctor>
+    const brick::common::UInt32
+    ImageWarper<NumericType, TransformFunctor>::InvalidIndex;
+
+
 
     template<class NumericType, class TransformFunctor>
     ImageWarper<NumericType, TransformFunctor>::
     ImageWarper()
       : m_inputColumns(0),
         m_inputRows(0),
-        m_lookupTable()
+        m_isCompact(false),
+        m_lookupTable(),
+        m_compactLookupTable()
     {
       // Empty.
     }
@@ -42,21 +142,65 @@ namespace brick {
     ImageWarper<NumericType, TransformFunctor>::
     ImageWarper(size_t inputRows, size_t inputColumns,
                 size_t outputRows, size_t outputColumns,
-                TransformFunctor transformer)
+                TransformFunctor transformer,
+                bool isCompact)
       : m_inputColumns(inputColumns),
         m_inputRows(inputRows),
-        m_lookupTable(outputRows, outputColumns)
+        m_isCompact(isCompact),
+        m_lookupTable(),
+        m_compactLookupTable()
     {
+      if(isCompact) {
+        if(inputRows * inputColumns >= InvalidIndex) {
+          BRICK_THROW(brick::common::ValueException,
+                      "ImageWarper::ImageWarper()",
+                      "Input image is too large for a compact lookup table.");
+        }
+        m_compactLookupTable.reinit(outputRows, outputColumns);
+      } else {
+        m_lookupTable.reinit(outputRows, outputColumns);
+      }
+
       for(size_t row = 0; row < outputRows; ++row) {
         for(size_t column = 0; column < outputColumns; ++column) {
           brick::numeric::Vector2D<NumericType> outputCoord(column, row);
           brick::numeric::Vector2D<NumericType> inputCoord =
             transformer(outputCoord);
-          SampleInfo& sampleInfo = m_lookupTable(row, column);
-          if((inputCoord.y() >= 0.0)
+          bool isInBounds =
+            ((inputCoord.y() >= 0.0)
              && (inputCoord.x() >= 0.0)
              && (inputCoord.y() < static_cast<NumericType>(inputRows - 1))
-             && (inputCoord.x() < static_cast<NumericType>(inputColumns - 1))) {
+             && (inputCoord.x() < static_cast<NumericType>(inputColumns - 1)));
+
+          if(isCompact) {
+            CompactSampleInfo& sampleInfo = m_compactLookupTable(row, column);
+            if(isInBounds) {
+              NumericType intPart;
+              NumericType xFrac;
+              NumericType yFrac;
+
+              brick::common::splitFraction(inputCoord.x(), intPart, xFrac);
+              size_t i0 = static_cast<size_t>(intPart);
+
+              brick::common::splitFraction(inputCoord.y(), intPart, yFrac);
+              size_t j0 = static_cast<size_t>(intPart);
+
+              sampleInfo.index00 = static_cast<brick::common::UInt32>(
+                inputColumns * j0 + i0);
+              sampleInfo.xFraction = static_cast<brick::common::UInt16>(
+                std::min(xFrac * 65536.0 + 0.5, 65535.0));
+              sampleInfo.yFraction = static_cast<brick::common::UInt16>(
+                std::min(yFrac * 65536.0 + 0.5, 65535.0));
+            } else {
+              sampleInfo.index00 = InvalidIndex;
+              sampleInfo.xFraction = 0;
+              sampleInfo.yFraction = 0;
+            }
+            continue;
+          }
+
+          SampleInfo& sampleInfo = m_lookupTable(row, column);
+          if(isInBounds) {
 
             NumericType intPart;
             NumericType xFrac;
@@ -100,7 +244,8 @@ namespace brick {
     Image<OutputFormat>
     ImageWarper<NumericType, TransformFunctor>::
     warpImage(Image<InputFormat> const& inputImage,
-              typename Image<OutputFormat>::PixelType defaultValue) const
+              typename Image<OutputFormat>::PixelType defaultValue,
+              unsigned int numberOfThreads) const
     {
       if((inputImage.rows() != m_inputRows)
          || (inputImage.columns() != m_inputColumns)) {
@@ -113,26 +258,84 @@ namespace brick {
                     message.str().c_str());
       }
       Image<OutputFormat> outputImage(
-        m_lookupTable.rows(), m_lookupTable.columns());
-      for(size_t ii = 0; ii < m_lookupTable.size(); ++ii) {
-        SampleInfo const& sampleInfo = m_lookupTable(ii);
-        if(sampleInfo.isInBounds) {
-          typename Image<OutputFormat>::PixelType& outputPixel =
-            outputImage[ii];
-          size_t inputIndex = sampleInfo.index00;
-
-          outputPixel = sampleInfo.c00 * inputImage[inputIndex];
-          ++inputIndex;
-          outputPixel += sampleInfo.c01 * inputImage[inputIndex];
-          inputIndex += m_inputColumns;
-          outputPixel += sampleInfo.c11 * inputImage[inputIndex];
-          --inputIndex;
-          outputPixel += sampleInfo.c10 * inputImage[inputIndex];
-        } else {
-          outputImage[ii] = defaultValue;
+        m_isCompact ? m_compactLookupTable.rows() : m_lookupTable.rows(),
+        m_isCompact ? m_compactLookupTable.columns() : m_lookupTable.columns());
+      brick::common::parallelFor(
+        0, outputImage.rows(), numberOfThreads,
+        [&](size_t startRow, size_t stopRow, size_t) {
+          this->warpRows<InputFormat, OutputFormat>(
+            inputImage, outputImage, defaultValue, startRow, stopRow);
+        });
+      return outputImage;
+    }
+
+
+    template<class NumericType, class TransformFunctor>
+    template <ImageFormat InputFormat, ImageFormat OutputFormat>
+    void
+    ImageWarper<NumericType, TransformFunctor>::
+    warpRows(Image<InputFormat> const& inputImage,
+             Image<OutputFormat>& outputImage,
+             typename Image<OutputFormat>::PixelType const& defaultValue,
+             size_t startRow, size_t stopRow) const
+    {
+      typedef typename Image<InputFormat>::PixelType InputPixelType;
+      typedef typename Image<OutputFormat>::PixelType OutputPixelType;
+
+      InputPixelType const* inputPtr = inputImage.data();
+      size_t const outputColumns = outputImage.columns();
+
+      // Work in tiles so that the input pixels touched by
+      // neighboring output rows are still in cache when they're
+      // needed again.
+      for(size_t tileRow = startRow; tileRow < stopRow; tileRow += TileRows) {
+        size_t const tileStopRow = std::min(tileRow + TileRows, stopRow);
+        for(size_t tileColumn = 0; tileColumn < outputColumns;
+            tileColumn += TileColumns) {
+          size_t const tileWidth =
+            std::min(TileColumns, outputColumns - tileColumn);
+
+          for(size_t row = tileRow; row < tileStopRow; ++row) {
+            OutputPixelType* outputPtr = outputImage.data(row, tileColumn);
+
+            if(m_isCompact) {
+              CompactSampleInfo const* samplePtr =
+                m_compactLookupTable.data(row, tileColumn);
+              for(size_t ii = 0; ii < tileWidth; ++ii) {
+                CompactSampleInfo const& sampleInfo = samplePtr[ii];
+                if(sampleInfo.index00 != InvalidIndex) {
+                  privateCode::interpolateCompact<NumericType>(
+                    inputPtr + sampleInfo.index00, m_inputColumns,
+                    sampleInfo.xFraction, sampleInfo.yFraction,
+                    outputPtr[ii]);
+                } else {
+                  outputPtr[ii] = defaultValue;
+                }
+              }
+              continue;
+            }
+
+            SampleInfo const* samplePtr = m_lookupTable.data(row, tileColumn);
+            for(size_t ii = 0; ii < tileWidth; ++ii) {
+              SampleInfo const& sampleInfo = samplePtr[ii];
+              if(sampleInfo.isInBounds) {
+                OutputPixelType& outputPixel = outputPtr[ii];
+                size_t inputIndex = sampleInfo.index00;
+
+                outputPixel = sampleInfo.c00 * inputPtr[inputIndex];
+                ++inputIndex;
+                outputPixel += sampleInfo.c01 * inputPtr[inputIndex];
+                inputIndex += m_inputColumns;
+                outputPixel += sampleInfo.c11 * inputPtr[inputIndex];
+                --inputIndex;
+                outputPixel += sampleInfo.c10 * inputPtr[inputIndex];
+              } else {
+                outputPtr[ii] = defaultValue;
+              }
+            }
+          }
         }
       }
-      return outputImage;
     }
 
   } // namespace computerVision
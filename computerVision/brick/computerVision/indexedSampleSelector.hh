@@ -0,0 +1,223 @@
+/**
+***************************************************************************
+* @file brick/computerVision/indexedSampleSelector.hh
+*
+* Header file declaring a class template for drawing batches of
+* random sample index sets from populations of things.
+*
+* Copyright (C) 2026 David LaRose, dlr@cs.cmu.edu
+* See accompanying file, LICENSE.TXT, for details.
+*
+***************************************************************************
+*/
+
+#ifndef BRICK_COMPUTERVISION_INDEXEDSAMPLESELECTOR_HH
+#define BRICK_COMPUTERVISION_INDEXEDSAMPLESELECTOR_HH
+
+#include <vector>
+#include <brick/common/types.hh>
+#include <brick/numeric/array2D.hh>
+#include <brick/random/xoshiro256.hh>
+
+namespace brick {
+
+  namespace computerVision {
+
+    /**
+     ** This class template is an alternative to RandomSampleSelector
+     ** for robust statistics algorithms such as RANSAC.  Rather than
+     ** shuffling its copy of the sample population and handing out
+     ** sequences of samples, it leaves the population in place
+     ** (contiguous, and in the order passed to the constructor), and
+     ** hands out sets of indices into it.  Index sets for many
+     ** hypotheses are generated in one call, into an array that can
+     ** be reused from call to call, so drawing samples requires no
+     ** memory allocation.
+     **
+     ** Each index set is drawn without replacement.  By default, every
+     ** subset of the population is equally likely.  Alternatively, if
+     ** a quality score is provided for each sample using
+     ** setSampleQuality(), index sets are drawn according to the
+     ** PROSAC schedule[1], which tries subsets of the highest quality
+     ** samples first, and gradually widens the pool until it is
+     ** equivalent to uniform sampling.
+     **
+     ** Template argument Sample specifies what type of thing will
+     ** make up the population from which random samples will be
+     ** drawn.
+     **
+     ** [1] O. Chum and J. Matas.  Matching with PROSAC - Progressive
+     ** Sample Consensus.  Proceedings of CVPR, 2005.
+     **/
+    template <class Sample>
+    class IndexedSampleSelector {
+    public:
+
+      // ========= Public typedefs. =========
+
+      /**
+       ** This typedef simply mirrors template argument Sample.
+       **/
+      typedef Sample SampleType;
+
+
+      // ========= Public member functions. =========
+
+      /**
+       * The constructor specifies the full population of samples from
+       * which to randomly select.  The input sequence will be copied
+       * to internal storage.  The random number generator is seeded
+       * from the system clock.  Use setSeed() for repeatable
+       * sampling.
+       *
+       * @param sampleSize This argument specifies how many samples
+       * are in each index set.  It must be nonzero, and no larger
+       * than the size of the population.
+       *
+       * @param beginIter This argument and the next specify a
+       * sequence from which to copy the sample population.
+       *
+       * @param endIter This argument and the previous specify a
+       * sequence from which to copy the sample population.
+       */
+      template <class IterType>
+      IndexedSampleSelector(size_t sampleSize,
+                            IterType beginIter, IterType endIter);
+
+
+      /**
+       * This member function returns the number of samples in the
+       * entire population passed to the constructor.
+       *
+       * @return The return value is the size of the entire
+       * population.
+       */
+      size_t
+      getPoolSize() const {return m_sampleVector.size();}
+
+
+      /**
+       * This member function returns one element of the population.
+       *
+       * @param index This argument is an index, such as those
+       * returned by getSampleIndices(), and must be less than
+       * getPoolSize().
+       *
+       * @return The return value is a reference to the requested
+       * sample.
+       */
+      SampleType const&
+      getSample(size_t index) const {return m_sampleVector[index];}
+
+
+      /**
+       * This member function returns the number of indices in each
+       * index set.
+       *
+       * @return The return value is the value of constructor argument
+       * sampleSize.
+       */
+      size_t
+      getSampleSize() const {return m_sampleSize;}
+
+
+      /**
+       * This member function draws index sets for a batch of
+       * hypotheses.  Index sets are distinct within each row, but
+       * are not sorted.  Successive calls continue the same random
+       * (or PROSAC) sequence.
+       *
+       * @param numberOfSampleSets This argument specifies how many
+       * index sets to draw.
+       *
+       * @param sampleIndices This argument is used to return the
+       * index sets, one per row.  If it doesn't already have
+       * numberOfSampleSets rows and getSampleSize() columns, it will
+       * be reinitialized.
+       */
+      void
+      getSampleIndices(size_t numberOfSampleSets,
+                       brick::numeric::Array2D<size_t>& sampleIndices);
+
+
+      /**
+       * This member function restarts the sequence of index sets.  If
+       * setSampleQuality() has been called, the next index set will
+       * again be drawn from the highest quality samples.
+       */
+      void
+      resetSampling();
+
+
+      /**
+       * This member function reseeds the random number generator, and
+       * calls resetSampling(), so that the sequence of index sets is
+       * repeatable.
+       *
+       * @param seed This argument is the new seed.
+       */
+      void
+      setSeed(brick::common::UInt64 seed);
+
+
+      /**
+       * This member function switches on PROSAC sampling, and
+       * restarts the PROSAC schedule.  Larger quality values indicate
+       * samples (for example, feature matches) that are more likely
+       * to be inliers.
+       *
+       * @param beginIter This argument and the next specify a
+       * sequence of quality values, one for each sample in the
+       * population.
+       *
+       * @param endIter This argument and the previous specify a
+       * sequence of quality values.
+       *
+       * @param growthIterations This argument is the number of index
+       * sets after which PROSAC would have drawn as many sets as
+       * uniform RANSAC would, and controls how quickly the pool of
+       * candidates grows.  The default follows Chum and Matas.
+       */
+      template <class IterType>
+      void
+      setSampleQuality(IterType beginIter, IterType endIter,
+                       size_t growthIterations = 200000);
+
+    private:
+
+      void
+      drawIndexSet(size_t* outputPtr);
+
+      size_t m_sampleSize;
+      std::vector<SampleType> m_sampleVector;
+      brick::random::Xoshiro256 m_generator;
+
+      // Partially shuffled permutation of quality ranks.  Each index
+      // set is drawn by a partial Fisher-Yates shuffle over a prefix
+      // of this vector, which is left in place for the next draw.
+      std::vector<size_t> m_permutation;
+
+      // Maps quality rank to position in m_sampleVector.  This is the
+      // identity unless setSampleQuality() has been called.
+      std::vector<size_t> m_rankToIndex;
+
+      // PROSAC state.  See Chum and Matas for the meaning of these.
+      bool m_isProsac;
+      size_t m_growthIterations;
+      size_t m_prosacSubsetSize;
+      size_t m_prosacIteration;
+      size_t m_prosacTnPrime;
+      double m_prosacTn;
+
+    };
+
+  } // namespace computerVision
+
+} // namespace brick
+
+
+// Include file containing definitions of inline and template
+// functions.
+#include <brick/computerVision/indexedSampleSelector_impl.hh>
+
+#endif /* #ifndef BRICK_COMPUTERVISION_INDEXEDSAMPLESELECTOR_HH */
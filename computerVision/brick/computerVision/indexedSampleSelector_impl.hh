@@ -0,0 +1,236 @@
+/**
+***************************************************************************
+* @file brick/computerVision/indexedSampleSelector_impl.hh
+*
+* Header file defining inline and template functions declared in
+* indexedSampleSelector.hh.
+*
+* Copyright (C) 2026 David LaRose, dlr@cs.cmu.edu
+* See accompanying file, LICENSE.TXT, for details.
+*
+***************************************************************************
+*/
+
+#ifndef BRICK_COMPUTERVISION_INDEXEDSAMPLESELECTOR_IMPL_HH
+#define BRICK_COMPUTERVISION_INDEXEDSAMPLESELECTOR_IMPL_HH
+
+// This file is included by indexedSampleSelector.hh, and should not
+// be directly included by user code, so no need to include
+// indexedSampleSelector.hh here.
+//
+// #include <brick/computerVision/indexedSampleSelector.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <brick/common/exception.hh>
+
+namespace brick {
+
+  namespace computerVision {
+
+    /// @cond privateCode
+    namespace privateCode {
+
+      // Orders sample indices by decreasing quality, for use with
+      // std::stable_sort.
+      template <class QualityType>
+      struct ISSQualityComparator {
+        ISSQualityComparator(std::vector<QualityType> const& quality)
+          : m_quality(quality) {}
+
+        bool
+        operator()(size_t index0, size_t index1) const {
+          return m_quality[index0] > m_quality[index1];
+        }
+
+        std::vector<QualityType> const& m_quality;
+      };
+
+    } // namespace privateCode
+    /// @endcond
+
+
+    // The constructor specifies the full population of samples from
+    // which to randomly select.
+    template <class Sample>
+    template <class IterType>
+    IndexedSampleSelector<Sample>::
+    IndexedSampleSelector(size_t sampleSize,
+                          IterType beginIter, IterType endIter)
+      : m_sampleSize(sampleSize),
+        m_sampleVector(beginIter, endIter),
+        m_generator(),
+        m_permutation(m_sampleVector.size()),
+        m_rankToIndex(m_sampleVector.size()),
+        m_isProsac(false),
+        m_growthIterations(0),
+        m_prosacSubsetSize(0),
+        m_prosacIteration(0),
+        m_prosacTnPrime(0),
+        m_prosacTn(0.0)
+    {
+      if(m_sampleSize == 0) {
+        BRICK_THROW(brick::common::ValueException,
+                    "IndexedSampleSelector::IndexedSampleSelector()",
+                    "Argument sampleSize must be nonzero.");
+      }
+      if(m_sampleSize > m_sampleVector.size()) {
+        BRICK_THROW(brick::common::ValueException,
+                    "IndexedSampleSelector::IndexedSampleSelector()",
+                    "Argument sampleSize must be less than or equal to "
+                    "the number of elements in the input sequence.");
+      }
+      for(size_t ii = 0; ii < m_permutation.size(); ++ii) {
+        m_permutation[ii] = ii;
+        m_rankToIndex[ii] = ii;
+      }
+    }
+
+
+    // This member function draws index sets for a batch of
+    // hypotheses.
+    template <class Sample>
+    void
+    IndexedSampleSelector<Sample>::
+    getSampleIndices(size_t numberOfSampleSets,
+                     brick::numeric::Array2D<size_t>& sampleIndices)
+    {
+      if(sampleIndices.rows() != numberOfSampleSets
+         || sampleIndices.columns() != m_sampleSize) {
+        sampleIndices.reinit(numberOfSampleSets, m_sampleSize);
+      }
+      for(size_t ii = 0; ii < numberOfSampleSets; ++ii) {
+        this->drawIndexSet(sampleIndices.data(ii, 0));
+      }
+    }
+
+
+    // This member function restarts the sequence of index sets.
+    template <class Sample>
+    void
+    IndexedSampleSelector<Sample>::
+    resetSampling()
+    {
+      // Swaps done by drawIndexSet() leave m_permutation in a valid
+      // state, so restoring the identity isn't strictly necessary,
+      // but it makes sampling repeatable after setSeed().
+      for(size_t ii = 0; ii < m_permutation.size(); ++ii) {
+        m_permutation[ii] = ii;
+      }
+      if(!m_isProsac) {
+        return;
+      }
+
+      // T_n for n = m, which is the expected number of index sets,
+      // out of growthIterations, that uniform RANSAC would draw
+      // entirely from the top m samples.
+      size_t const poolSize = m_sampleVector.size();
+      m_prosacTn = static_cast<double>(m_growthIterations);
+      for(size_t ii = 0; ii < m_sampleSize; ++ii) {
+        m_prosacTn *= static_cast<double>(m_sampleSize - ii)
+          / static_cast<double>(poolSize - ii);
+      }
+      m_prosacSubsetSize = m_sampleSize;
+      m_prosacIteration = 0;
+      m_prosacTnPrime = 1;
+    }
+
+
+    // This member function reseeds the random number generator, and
+    // restarts the sequence of index sets.
+    template <class Sample>
+    void
+    IndexedSampleSelector<Sample>::
+    setSeed(brick::common::UInt64 seed)
+    {
+      m_generator.setCurrentSeed(seed);
+      this->resetSampling();
+    }
+
+
+    // This member function switches on PROSAC sampling.
+    template <class Sample>
+    template <class IterType>
+    void
+    IndexedSampleSelector<Sample>::
+    setSampleQuality(IterType beginIter, IterType endIter,
+                     size_t growthIterations)
+    {
+      typedef typename std::iterator_traits<IterType>::value_type QualityType;
+      std::vector<QualityType> quality(beginIter, endIter);
+      if(quality.size() != m_sampleVector.size()) {
+        BRICK_THROW(brick::common::ValueException,
+                    "IndexedSampleSelector::setSampleQuality()",
+                    "Input sequence must have one element for each "
+                    "sample in the population.");
+      }
+      for(size_t ii = 0; ii < m_rankToIndex.size(); ++ii) {
+        m_rankToIndex[ii] = ii;
+      }
+      std::stable_sort(m_rankToIndex.begin(), m_rankToIndex.end(),
+                       privateCode::ISSQualityComparator<QualityType>(
+                         quality));
+      m_isProsac = true;
+      m_growthIterations = growthIterations;
+      this->resetSampling();
+    }
+
+
+    // Fills in one index set of m_sampleSize elements.
+    template <class Sample>
+    void
+    IndexedSampleSelector<Sample>::
+    drawIndexSet(size_t* outputPtr)
+    {
+      size_t const poolSize = m_sampleVector.size();
+
+      // By default, draw from the whole population.
+      size_t subsetSize = poolSize;
+      size_t numberToShuffle = m_sampleSize;
+      if(m_isProsac) {
+        // Grow the subset when the schedule says it's time.
+        ++m_prosacIteration;
+        if(m_prosacIteration > m_prosacTnPrime
+           && m_prosacSubsetSize < poolSize) {
+          double const nextTn = m_prosacTn
+            * static_cast<double>(m_prosacSubsetSize + 1)
+            / static_cast<double>(m_prosacSubsetSize + 1 - m_sampleSize);
+          m_prosacTnPrime += static_cast<size_t>(
+            std::ceil(nextTn - m_prosacTn));
+          m_prosacTn = nextTn;
+          ++m_prosacSubsetSize;
+        }
+
+        subsetSize = m_prosacSubsetSize;
+        if(m_prosacTnPrime >= m_prosacIteration) {
+          // Each new index set must include the most recently added
+          // sample, and draw the rest from those ahead of it.
+          --subsetSize;
+          --numberToShuffle;
+          outputPtr[numberToShuffle] = m_rankToIndex[subsetSize];
+        }
+      }
+
+      // Partial Fisher-Yates shuffle of the first subsetSize ranks.
+      // The first numberToShuffle elements of m_permutation become a
+      // uniformly chosen subset.  Positions beyond subsetSize are
+      // never touched, so the invariant that the first n elements
+      // are a permutation of [0, n) holds for every n >= subsetSize,
+      // which is what lets the PROSAC subset grow without resetting
+      // anything.
+      for(size_t ii = 0; ii < numberToShuffle; ++ii) {
+        size_t const jj = static_cast<size_t>(
+          m_generator.uniformInt(static_cast<brick::common::Int32>(ii),
+                                 static_cast<brick::common::Int32>(
+                                   subsetSize)));
+        std::swap(m_permutation[ii], m_permutation[jj]);
+        outputPtr[ii] = m_rankToIndex[m_permutation[ii]];
+      }
+    }
+
+  } // namespace computerVision
+
+} // namespace brick
+
+#endif /* #ifndef BRICK_COMPUTERVISION_INDEXEDSAMPLESELECTOR_IMPL_HH */
@@ -61,10 +61,63 @@ namespace brick {
     };
 
 
+    /**
+     ** This struct reports how long each stage of
+     ** KeypointSelectorBullseye::setImage() took, and how many
+     ** candidate locations survived each stage.  Times are wall-clock
+     ** seconds.
+     **/
+    struct KeypointSelectorBullseyeTimings {
+      /// Time spent estimating the asymmetry threshold.
+      brick::common::Float64 thresholdTime;
+
+      /// Time spent finding candidate bullseye centers.
+      brick::common::Float64 candidateTime;
+
+      /// Time spent rejecting candidates using spoke and symmetry tests.
+      brick::common::Float64 screeningTime;
+
+      /// Time spent computing edges and image gradients.
+      brick::common::Float64 edgeTime;
+
+      /// Time spent fitting and scoring bullseyes.
+      brick::common::Float64 fittingTime;
+
+      /// Time spent computing subpixel keypoint positions.
+      brick::common::Float64 fineTuningTime;
+
+      /// Pyramid level at which candidates were found and screened.
+      brick::common::UInt32 screeningLevel;
+
+      /// Number of candidate bullseye centers found.
+      brick::common::UInt32 numberOfCandidates;
+
+      /// Number of candidates that passed screening and were fitted.
+      brick::common::UInt32 numberOfScreenedCandidates;
+
+      /// Number of keypoints reported.
+      brick::common::UInt32 numberOfKeypoints;
+
+      KeypointSelectorBullseyeTimings()
+        : thresholdTime(0.0),
+          candidateTime(0.0),
+          screeningTime(0.0),
+          edgeTime(0.0),
+          fittingTime(0.0),
+          fineTuningTime(0.0),
+          screeningLevel(0),
+          numberOfCandidates(0),
+          numberOfScreenedCandidates(0),
+          numberOfKeypoints(0) {}
+    };
+
+
     /**
      ** This class template looks for bullseye targets in an input
      ** image.  It does not use a scale space, and operates directly
-     ** on the input image.  Use it like this:
+     ** on the input image, although candidates can optionally be
+     ** found and screened on a downsampled copy of the image (see
+     ** setScreeningLevel()).  Use it like this:
      **
      ** @code
      ** KeypointSelectorBullseye<double> myKeypointSelector(2, 40, 10);
@@ -188,6 +241,64 @@ namespace brick {
       getKeypointsGeneralPosition(Iter iterator) const;
 
 
+      /**
+       * Return stage timings and candidate counts for the most recent
+       * call to member function setImage().
+       *
+       * @return The return value is a KeypointSelectorBullseyeTimings
+       * instance.
+       */
+      KeypointSelectorBullseyeTimings
+      getTimings() const {return m_timings;}
+
+
+      /**
+       * Specify how many threads should share the work of screening,
+       * fitting, and fine-tuning candidate bullseyes.  Each thread
+       * keeps its own bounded list of the best bullseyes found so
+       * far, and the lists are merged at the end.  For well separated
+       * bullseyes the result doesn't depend on the number of threads,
+       * but it can differ slightly from single threaded processing
+       * when overlapping candidates compete for the same place in
+       * the output.  The default is 1.
+       *
+       * @param numberOfThreads This argument specifies the number of
+       * threads.  Setting it to zero uses one thread per available
+       * processor.
+       */
+      void
+      setNumberOfThreads(brick::common::UInt32 numberOfThreads) {
+        m_numberOfThreads = numberOfThreads;
+      }
+
+
+      /**
+       * Enable coarse-to-fine processing, which is much faster on
+       * large images.  When enabled, the image is repeatedly
+       * downsampled by 2x2 averaging, candidate bullseye centers are
+       * found on the reduced image, and candidates that fail the
+       * spoke and symmetry tests at the reduced scale are discarded
+       * without further work.  Each surviving candidate is then
+       * relocated to the most symmetric nearby pixel of the full
+       * resolution image, and edges are computed only in a small
+       * window around it before the bullseye is fitted.
+       *
+       * Bullseye rings must stay at least two pixels wide after
+       * downsampling for the screening to be reliable, so the level
+       * actually used is reduced as necessary to keep (2^level *
+       * 2 * numberOfTransitions) no larger than minRadius.  Member
+       * function getTimings() reports the level that was used.
+       *
+       * @param screeningLevel This argument specifies how many times
+       * to halve the image before screening.  Setting it to zero
+       * (the default) disables coarse-to-fine processing.
+       */
+      void
+      setScreeningLevel(brick::common::UInt32 screeningLevel) {
+        m_screeningLevel = screeningLevel;
+      }
+
+
       /**
        * Process an image to find keypoints.
        *
@@ -250,6 +361,42 @@ namespace brick {
       };
 
 
+      // Candidate bullseye center that has passed screening, along
+      // with the range of radii that fit around it in the image.
+      struct ScreenedCandidate {
+        KeypointBullseye<brick::common::Int32, FloatType> keypoint;
+        brick::common::UInt32 minRadius;
+        brick::common::UInt32 maxRadius;
+      };
+
+
+      // Edge image and gradients for a rectangular region of the
+      // input image, which may be the entire image.
+      struct EdgeRegion {
+        brick::common::UInt32 startRow;
+        brick::common::UInt32 startColumn;
+        Image<GRAY1> edgeImage;
+        brick::numeric::Array2D<FloatType> gradientX;
+        brick::numeric::Array2D<FloatType> gradientY;
+      };
+
+
+      // Scratch buffers used while fitting a bullseye.  Each thread
+      // needs its own.
+      struct FittingWorkspace {
+        std::vector< brick::numeric::Vector2D<FloatType> > bullseyePoints;
+        std::vector<brick::common::UInt32> bullseyeEdgeCounts;
+        std::vector< std::vector< brick::numeric::Vector2D<FloatType> > >
+          edgePositions;
+
+        explicit
+        FittingWorkspace(brick::common::UInt32 numberOfTransitions)
+          : bullseyePoints(),
+            bullseyeEdgeCounts(numberOfTransitions),
+            edgePositions(numberOfTransitions) {}
+      };
+
+
       // Accumulate statistics related to the difference between two
       // pixel values.
       void
@@ -296,11 +443,26 @@ namespace brick {
       describeComponents(Image<GRAY32> const& labelImage,
                          unsigned int const numberOfComponents);
 
+      // Halve the size of an image (levels times) by averaging 2x2
+      // blocks of pixels.
+      Image<GRAY8>
+      downsampleImage(Image<GRAY8> const& inImage,
+                      brick::common::UInt32 levels) const;
+
+
+      // Compute edges in the neighborhood of each screened candidate.
+      std::vector<EdgeRegion>
+      detectEdgesNearCandidates(
+        Image<GRAY8> const& inImage,
+        std::vector<ScreenedCandidate> const& candidates,
+        brick::common::UInt32 margin,
+        brick::common::UInt32 numberOfThreads) const;
+
+
       bool
       estimateBullseye(
         brick::geometry::Bullseye2D<FloatType>& bullseye,
-        std::vector< std::vector< brick::numeric::Vector2D<FloatType> > > const&
-          edgePositions,
+        FittingWorkspace& workspace,
         brick::common::UInt32 numberOfTransitions) const;
 
 
@@ -345,6 +507,7 @@ namespace brick {
       // number of "candidate" points in the image.
       std::vector<brick::numeric::Index2D>
       getCandidatePoints(Image<GRAY8> const& inputImage,
+                         brick::common::UInt32 maxRadius,
                          brick::common::UInt32 startRow,
                          brick::common::UInt32 startColumn,
                          brick::common::UInt32 stopRow,
@@ -403,7 +566,16 @@ namespace brick {
         brick::numeric::Array2D<FloatType> const& gradientX,
         brick::numeric::Array2D<FloatType> const& gradientY,
         brick::common::UInt32 minRadius,
-        brick::common::UInt32 maxRadius) const;
+        brick::common::UInt32 maxRadius,
+        FittingWorkspace& workspace) const;
+
+
+      // Fit bullseyes to screened candidates, and return the best
+      // ones, sorted by decreasing bullseyeMetric.
+      std::vector< KeypointBullseye<brick::common::Int32, FloatType> >
+      fitCandidates(std::vector<ScreenedCandidate> const& candidates,
+                    std::vector<EdgeRegion> const& edgeRegions,
+                    brick::common::UInt32 numberOfThreads) const;
 
 
       bool
@@ -416,6 +588,27 @@ namespace brick {
         bool forceAsymmetry = false) const;
 
 
+      // Screen candidates found at full resolution, discarding those
+      // that fail the spoke and symmetry tests.
+      std::vector<ScreenedCandidate>
+      screenCandidates(Image<GRAY8> const& inImage,
+                       std::vector<brick::numeric::Index2D> const& points,
+                       FloatType asymmetryThreshold,
+                       brick::common::UInt32 numberOfThreads) const;
+
+
+      // Screen candidates found on a downsampled image, and relocate
+      // survivors to the most symmetric nearby full resolution pixel.
+      std::vector<ScreenedCandidate>
+      screenCandidatesCoarse(
+        Image<GRAY8> const& inImage,
+        Image<GRAY8> const& coarseImage,
+        std::vector<brick::numeric::Index2D> const& coarsePoints,
+        brick::common::UInt32 screeningLevel,
+        FloatType coarseAsymmetryThreshold,
+        brick::common::UInt32 numberOfThreads) const;
+
+
       // Insert the new keypoint into a sorted vector, discarding the
       // worst point if the addition would make the vector longer than
       // maxNumberOfBullseyes.
@@ -425,7 +618,7 @@ namespace brick {
         std::vector< KeypointBullseye<brick::common::Int32, FloatType> >&
           keypointVector,
         FloatType minRadius,
-        brick::common::UInt32 maxNumberOfBullseyes);
+        brick::common::UInt32 maxNumberOfBullseyes) const;
 
 
       bool
@@ -443,21 +636,17 @@ namespace brick {
 
       // Private data members.
 
-      std::vector< brick::numeric::Vector2D<FloatType> >
-        m_bullseyePoints;
-      std::vector<brick::common::UInt32>
-        m_bullseyeEdgeCounts;
-      std::vector< std::vector< brick::numeric::Vector2D<FloatType> > >
-        m_edgePositions;
-
       bool m_isGeneralPositionRequired;
       std::vector< KeypointBullseye<brick::common::Int32, FloatType> > m_keypointVector;
       std::vector< KeypointBullseye<FloatType, FloatType> > m_keypointGPVector;
       brick::common::UInt32 m_maxNumberOfBullseyes;
       brick::common::UInt32 m_numberOfTransitions;
+      brick::common::UInt32 m_numberOfThreads;
       brick::common::UInt32 m_maxRadius;
       brick::common::UInt32 m_minRadius;
       brick::common::UInt8 m_minDynamicRange;
+      brick::common::UInt32 m_screeningLevel;
+      KeypointSelectorBullseyeTimings m_timings;
 
     };
 
@@ -20,7 +20,10 @@
 //
 // #include <brick/computerVision/keypointSelectorBullseye.hh>
 
+#include <algorithm>
+#include <chrono>
 #include <brick/common/mathFunctions.hh>
+#include <brick/common/parallelFor.hh>
 #include <brick/computerVision/canny.hh>
 #include <brick/computerVision/connectedComponents.hh>
 #include <brick/computerVision/thresholderSauvola.hh>
@@ -34,6 +37,21 @@ namespace brick {
 
   namespace computerVision {
 
+    /// @cond privateCode
+    namespace privateCode {
+
+      // Wall-clock time in seconds, for reporting stage timings.
+      inline brick::common::Float64
+      getBullseyeTime()
+      {
+        return std::chrono::duration<brick::common::Float64>(
+          std::chrono::steady_clock::now().time_since_epoch()).count();
+      }
+
+    } // namespace privateCode
+    /// @endcond
+
+
     template <class FloatType>
     KeypointSelectorBullseye<FloatType>::
     KeypointSelectorBullseye(brick::common::UInt32 maxNumberOfBullseyes,
@@ -41,17 +59,17 @@ namespace brick {
                              brick::common::UInt32 minRadius,
                              brick::common::UInt32 numberOfTransitions,
                              bool isGeneralPositionRequired)
-      : m_bullseyePoints(),
-        m_bullseyeEdgeCounts(numberOfTransitions),
-        m_edgePositions(numberOfTransitions),
-        m_isGeneralPositionRequired(isGeneralPositionRequired),
+      : m_isGeneralPositionRequired(isGeneralPositionRequired),
         m_keypointVector(),
         m_keypointGPVector(),
         m_maxNumberOfBullseyes(maxNumberOfBullseyes),
         m_numberOfTransitions(numberOfTransitions),
+        m_numberOfThreads(1),
         m_maxRadius(maxRadius),
         m_minRadius(minRadius),
-        m_minDynamicRange(10)
+        m_minDynamicRange(10),
+        m_screeningLevel(0),
+        m_timings()
     {
       // Don't crash if the user confuses the min & max arguments.
       if(m_minRadius > m_maxRadius) {
@@ -62,8 +80,6 @@ namespace brick {
       // even if the user passes in a zero.
       if(0 == numberOfTransitions) {
         m_numberOfTransitions = 1;
-        m_bullseyeEdgeCounts.resize(1);
-        m_edgePositions.resize(1);
       }
     }
 
@@ -355,12 +371,54 @@ namespace brick {
       // Discard last image's keypoints.
       m_keypointVector.clear();
       m_keypointGPVector.clear();
+      m_timings = KeypointSelectorBullseyeTimings();
 
       // Make sure the passed-in image bounds are legal.
       this->checkAndRepairRegionOfInterest(
         startRow, startColumn, stopRow, stopColumn,
         inImage.rows(), inImage.columns());
 
+      brick::common::UInt32 numberOfThreads = m_numberOfThreads;
+      if(0 == numberOfThreads) {
+        numberOfThreads = brick::common::getDefaultNumberOfThreads();
+      }
+
+      // If coarse-to-fine processing is enabled, find and screen
+      // candidates on a downsampled image.  This only works if the
+      // rings of the bullseye are still a couple of pixels wide
+      // after downsampling, so back off to a finer level if
+      // necessary.
+      brick::common::UInt32 screeningLevel = 0;
+      while((screeningLevel < m_screeningLevel)
+            && (((brick::common::UInt32(4) << screeningLevel)
+                 * m_numberOfTransitions) <= m_minRadius)) {
+        ++screeningLevel;
+      }
+      brick::common::UInt32 const scale =
+        brick::common::UInt32(1) << screeningLevel;
+      m_timings.screeningLevel = screeningLevel;
+
+      brick::common::Float64 time0 = privateCode::getBullseyeTime();
+      Image<GRAY8> coarseImage = inImage;
+      brick::common::UInt32 coarseStartRow = startRow;
+      brick::common::UInt32 coarseStartColumn = startColumn;
+      brick::common::UInt32 coarseStopRow = stopRow;
+      brick::common::UInt32 coarseStopColumn = stopColumn;
+      if(screeningLevel != 0) {
+        coarseImage = this->downsampleImage(inImage, screeningLevel);
+        coarseStartRow /= scale;
+        coarseStartColumn /= scale;
+        coarseStopRow /= scale;
+        coarseStopColumn /= scale;
+        this->checkAndRepairRegionOfInterest(
+          coarseStartRow, coarseStartColumn, coarseStopRow, coarseStopColumn,
+          coarseImage.rows(), coarseImage.columns());
+      }
+      brick::common::UInt32 const coarseMinRadius = m_minRadius / scale;
+      brick::common::UInt32 const coarseMaxRadius =
+        (m_maxRadius + scale - 1) / scale;
+      brick::common::Float64 time1 = privateCode::getBullseyeTime();
+
       // We're going to prune most of the image pixels using a
       // threshold based on local asymmetry.  Things that aren't
       // symmetrical aren't bullseyes.  Here we estimate what a normal
@@ -369,95 +427,105 @@ namespace brick {
       //
       // Figure out how many pixels to sample when estimating.
       brick::common::UInt32 numberOfPixelsToSample =
-        (stopRow - startRow) * (stopColumn - startColumn) / 1000;
+        ((coarseStopRow - coarseStartRow)
+         * (coarseStopColumn - coarseStartColumn) / 1000);
       numberOfPixelsToSample = std::max(numberOfPixelsToSample,
                                         static_cast<brick::common::UInt32>(100));
 
       // Do the sampling and estimate the threshold.
       FloatType asymmetryThreshold = this->estimateAsymmetryThreshold(
-        inImage, m_minRadius, m_maxRadius, startRow, startColumn,
-        stopRow, stopColumn, numberOfPixelsToSample);
+        coarseImage, coarseMinRadius, coarseMaxRadius,
+        coarseStartRow, coarseStartColumn, coarseStopRow, coarseStopColumn,
+        numberOfPixelsToSample);
+      brick::common::Float64 time2 = privateCode::getBullseyeTime();
 
       // Using connected components analysis, find pixels that might
       // be at the center of bullseyes.
       std::vector<brick::numeric::Index2D> candidatePoints =
         this->getCandidatePoints(
-          inImage, startRow, startColumn, stopRow, stopColumn);
+          coarseImage, coarseMaxRadius, coarseStartRow, coarseStartColumn,
+          coarseStopRow, coarseStopColumn);
+      brick::common::Float64 time3 = privateCode::getBullseyeTime();
 
 #if CV_KSB_PRINT_STATS
       std::cout << "setImage(): Got " << candidatePoints.size()
                 << " candidate points." << std::endl;
       std::cout << "  This is "
-                << double(candidatePoints.size()) / inImage.size() * 100.0
+                << double(candidatePoints.size()) / coarseImage.size() * 100.0
                 << "% of image pixels." << std::endl;
 #endif /* #if CV_KSB_PRINT_STATS */
 
-      // If a pixel has sufficiently good symmetry, it will be tested
-      // with a more expensive bullseye algorithm that needs to know
-      // which pixels are edges.  Compute an edge image here.  For now
-      // we use the expensive Canny algorithm.
-      brick::numeric::Array2D<FloatType> gradientX;
-      brick::numeric::Array2D<FloatType> gradientY;
-      Image<GRAY1> edgeImage = applyCanny<FloatType>(
-        inImage, gradientX, gradientY);
-
-      // Test every candidate pixel!
-      brick::common::UInt32 totalPixels = 0;
-      brick::common::UInt32 testedPixels = 0;
-      for(auto candidateIter = candidatePoints.begin();
-          candidateIter != candidatePoints.end(); ++candidateIter) {
-
-        ++totalPixels;
-        brick::common::UInt32 row = candidateIter->getRow();
-        brick::common::UInt32 column = candidateIter->getColumn();
-
-        // Tailor fiducial size so we don't run off the side of the
-        // image.
-        brick::common::UInt32 minRadius = m_minRadius;
-        brick::common::UInt32 maxRadius = m_maxRadius;
-        if(!this->adjustFiducialSize(minRadius, maxRadius, row, column,
-                                     inImage.rows(), inImage.columns())) {
-          continue;
-        }
-
-        // Create a candidate keypoint.
-        KeypointBullseye<brick::common::Int32, FloatType> keypoint(
-          row, column);
+      // Member function evaluateBullseyeMetric() is too expensive
+      // to run at every candidate.  Make absolutely sure each
+      // candidate could be a bullseye before proceeding.
+      std::vector<ScreenedCandidate> screenedCandidates;
+      if(screeningLevel == 0) {
+        screenedCandidates = this->screenCandidates(
+          inImage, candidatePoints, asymmetryThreshold, numberOfThreads);
+      } else {
+        screenedCandidates = this->screenCandidatesCoarse(
+          inImage, coarseImage, candidatePoints, screeningLevel,
+          asymmetryThreshold, numberOfThreads);
+      }
+      brick::common::Float64 time4 = privateCode::getBullseyeTime();
 
-        // Member function evaluateBullseyeMetric() is too expensive
-        // to run at every pixel.  Make absolutely sure this could
-        // be a bullseye before proceeding.
-        if(!this->isPlausibleBullseye(
-             keypoint, inImage, minRadius, maxRadius, asymmetryThreshold)) {
-          continue;
-        }
+#if CV_KSB_PRINT_STATS
+      std::cout << "Tested " << screenedCandidates.size()
+                << " (" << (100.0 * screenedCandidates.size())
+          / candidatePoints.size() << "%) of "
+                << candidatePoints.size() << " candidates." << std::endl;
+#endif /* #if CV_KSB_PRINT_STATS */
 
-        // All prescreening passes.  Go ahead with the expensive
-        // bullseye evaluation.
-        this->evaluateBullseyeMetric(keypoint, edgeImage,
-                                     gradientX, gradientY,
-                                     minRadius, maxRadius);
-        if(keypoint.bullseyeMetric >= 0.0) {
-          this->sortedInsert(keypoint, m_keypointVector,
-                             this->m_minRadius, this->m_maxNumberOfBullseyes);
+      // The bullseye fitting code needs to know which pixels are
+      // edges.  For now we use the expensive Canny algorithm.  At
+      // full resolution we compute edges for the whole image, but
+      // in coarse-to-fine mode there are few enough survivors that
+      // it's cheaper to look only at the neighborhood of each one.
+      std::vector<EdgeRegion> edgeRegions;
+      if(!screenedCandidates.empty()) {
+        if(screeningLevel == 0) {
+          edgeRegions.resize(1);
+          edgeRegions[0].startRow = 0;
+          edgeRegions[0].startColumn = 0;
+          edgeRegions[0].edgeImage = applyCanny<FloatType>(
+            inImage, edgeRegions[0].gradientX, edgeRegions[0].gradientY);
+        } else {
+          edgeRegions = this->detectEdgesNearCandidates(
+            inImage, screenedCandidates, 4, numberOfThreads);
         }
-        ++testedPixels;
       }
+      brick::common::Float64 time5 = privateCode::getBullseyeTime();
 
-#if CV_KSB_PRINT_STATS
-      std::cout << "Tested " << testedPixels
-                << " (" << (100.0 * testedPixels) / totalPixels << "%) of "
-                << totalPixels << " pixels." << std::endl;
-#endif /* #if CV_KSB_PRINT_STATS */
+      // All prescreening passes.  Go ahead with the expensive
+      // bullseye evaluation.
+      m_keypointVector = this->fitCandidates(
+        screenedCandidates, edgeRegions, numberOfThreads);
+      brick::common::Float64 time6 = privateCode::getBullseyeTime();
 
-      // Get general position estimates for our
+      // Get general position estimates for our keypoints.
       if(m_isGeneralPositionRequired) {
         m_keypointGPVector.resize(m_keypointVector.size());
-        for(brick::common::UInt32 ii = 0; ii < m_keypointVector.size(); ++ii) {
-          m_keypointGPVector[ii] = this->fineTuneKeypoint(
-            m_keypointVector[ii], inImage);
-        }
-      }
+        brick::common::parallelFor(
+          0, m_keypointVector.size(), numberOfThreads,
+          [&](std::size_t begin, std::size_t end, std::size_t /* band */) {
+            for(std::size_t ii = begin; ii < end; ++ii) {
+              m_keypointGPVector[ii] = this->fineTuneKeypoint(
+                m_keypointVector[ii], inImage);
+            }
+          });
+      }
+      brick::common::Float64 time7 = privateCode::getBullseyeTime();
+
+      // Downsampling is part of finding candidates.
+      m_timings.thresholdTime = time2 - time1;
+      m_timings.candidateTime = (time1 - time0) + (time3 - time2);
+      m_timings.screeningTime = time4 - time3;
+      m_timings.edgeTime = time5 - time4;
+      m_timings.fittingTime = time6 - time5;
+      m_timings.fineTuningTime = time7 - time6;
+      m_timings.numberOfCandidates = candidatePoints.size();
+      m_timings.numberOfScreenedCandidates = screenedCandidates.size();
+      m_timings.numberOfKeypoints = m_keypointVector.size();
     }
 
 
@@ -714,15 +782,116 @@ namespace brick {
     }
 
 
+    template <class FloatType>
+    std::vector< typename KeypointSelectorBullseye<FloatType>::EdgeRegion >
+    KeypointSelectorBullseye<FloatType>::
+    detectEdgesNearCandidates(
+      Image<GRAY8> const& inImage,
+      std::vector<ScreenedCandidate> const& candidates,
+      brick::common::UInt32 margin,
+      brick::common::UInt32 numberOfThreads) const
+    {
+      // Each region must contain every pixel that the bullseye
+      // fitting code might look at, plus enough margin that the
+      // border of the region (where Canny doesn't report edges)
+      // doesn't intrude.
+      std::vector<EdgeRegion> edgeRegions(candidates.size());
+      brick::common::parallelFor(
+        0, candidates.size(), numberOfThreads,
+        [&](std::size_t begin, std::size_t end, std::size_t /* band */) {
+          for(std::size_t ii = begin; ii < end; ++ii) {
+            ScreenedCandidate const& candidate = candidates[ii];
+            brick::common::Int32 halfSize =
+              static_cast<brick::common::Int32>(candidate.maxRadius + margin);
+            brick::common::Int32 startRow =
+              std::max(candidate.keypoint.row - halfSize, 0);
+            brick::common::Int32 startColumn =
+              std::max(candidate.keypoint.column - halfSize, 0);
+            brick::common::Int32 stopRow = std::min(
+              candidate.keypoint.row + halfSize + 1,
+              static_cast<brick::common::Int32>(inImage.rows()));
+            brick::common::Int32 stopColumn = std::min(
+              candidate.keypoint.column + halfSize + 1,
+              static_cast<brick::common::Int32>(inImage.columns()));
+
+            Image<GRAY8> patch(stopRow - startRow, stopColumn - startColumn);
+            for(brick::common::Int32 rr = startRow; rr < stopRow; ++rr) {
+              std::copy(inImage.data(rr, startColumn),
+                        inImage.data(rr, stopColumn),
+                        patch.data(rr - startRow, 0));
+            }
+
+            // Canny's automatic thresholds are derived from gradient
+            // statistics, which in a small window dominated by the
+            // bullseye put the upper threshold above the ring edges
+            // themselves.  Instead, set thresholds from the contrast
+            // measured during screening.  The Gaussian prefilter
+            // reduces the slope of a step edge to roughly 0.4 times
+            // its height, so these thresholds keep the rings while
+            // rejecting noise.
+            FloatType contrast = std::max(
+              FloatType(candidate.keypoint.lightColor)
+              - FloatType(candidate.keypoint.darkColor), FloatType(1.0));
+            FloatType upperThreshold = FloatType(0.1) * contrast;
+            FloatType lowerThreshold = FloatType(0.05) * contrast;
+
+            EdgeRegion& region = edgeRegions[ii];
+            region.startRow = startRow;
+            region.startColumn = startColumn;
+            region.edgeImage = applyCanny<FloatType>(
+              patch, region.gradientX, region.gradientY, 5,
+              upperThreshold, lowerThreshold);
+          }
+        });
+      return edgeRegions;
+    }
+
+
+    template <class FloatType>
+    Image<GRAY8>
+    KeypointSelectorBullseye<FloatType>::
+    downsampleImage(Image<GRAY8> const& inImage,
+                    brick::common::UInt32 levels) const
+    {
+      // Each output pixel is the (rounded) mean of the 2x2 block of
+      // input pixels it covers, so output pixel (row, column) covers
+      // input pixels [2*row, 2*row + 2) x [2*column, 2*column + 2).
+      // An odd last row or column is dropped.
+      Image<GRAY8> result = inImage;
+      for(brick::common::UInt32 level = 0; level < levels; ++level) {
+        Image<GRAY8> reduced(result.rows() / 2, result.columns() / 2);
+        for(brick::common::UInt32 rr = 0; rr < reduced.rows(); ++rr) {
+          brick::common::UInt8 const* row0Ptr = result.data(2 * rr, 0);
+          brick::common::UInt8 const* row1Ptr = result.data(2 * rr + 1, 0);
+          brick::common::UInt8* outputPtr = reduced.data(rr, 0);
+          for(brick::common::UInt32 cc = 0; cc < reduced.columns(); ++cc) {
+            brick::common::UInt32 sum =
+              (static_cast<brick::common::UInt32>(row0Ptr[2 * cc])
+               + row0Ptr[2 * cc + 1] + row1Ptr[2 * cc] + row1Ptr[2 * cc + 1]);
+            outputPtr[cc] = static_cast<brick::common::UInt8>((sum + 2) / 4);
+          }
+        }
+        result = reduced;
+      }
+      return result;
+    }
+
+
     template <class FloatType>
     bool
     KeypointSelectorBullseye<FloatType>::
     estimateBullseye(
       brick::geometry::Bullseye2D<FloatType>& bullseye,
-      std::vector< std::vector< brick::numeric::Vector2D<FloatType> > > const&
-        edgePositions,
+      FittingWorkspace& workspace,
       brick::common::UInt32 numberOfTransitions) const
     {
+      std::vector< std::vector< brick::numeric::Vector2D<FloatType> > > const&
+        edgePositions = workspace.edgePositions;
+      std::vector< brick::numeric::Vector2D<FloatType> >& bullseyePoints =
+        workspace.bullseyePoints;
+      std::vector<brick::common::UInt32>& bullseyeEdgeCounts =
+        workspace.bullseyeEdgeCounts;
+
       // A common failure is to not find any points on the outside
       // ring of the bullseye.  This makes sense: we search from the
       // center, so the outside ring is the one that gets found last.
@@ -732,36 +901,31 @@ namespace brick {
         return false;
       }
 
-      // m_bullseyePoints is really just here to match the
-      // Bullseye2D::estimate() interface.  By making it a member of
-      // *this, we avoid reallocating every time.  Probably this is
-      // false economy, but we'll profile shortly.  Copy all of the
+      // bullseyePoints is really just here to match the
+      // Bullseye2D::estimate() interface.  By keeping it in the
+      // workspace, we avoid reallocating every time.  Copy all of the
       // edge points into it.
-      const_cast<KeypointSelectorBullseye<FloatType>*>(this)->
-        m_bullseyePoints.clear();
-      for(brick::common::UInt32 ii = 0; ii < m_numberOfTransitions; ++ii) {
-        std::copy(m_edgePositions[ii].begin(), m_edgePositions[ii].end(),
-                  std::back_inserter(
-                    const_cast<KeypointSelectorBullseye<FloatType>*>(this)->
-                    m_bullseyePoints));
-        const_cast<KeypointSelectorBullseye<FloatType>*>(this)->
-          m_bullseyeEdgeCounts[ii] = m_edgePositions[ii].size();
+      bullseyePoints.clear();
+      for(brick::common::UInt32 ii = 0; ii < numberOfTransitions; ++ii) {
+        std::copy(edgePositions[ii].begin(), edgePositions[ii].end(),
+                  std::back_inserter(bullseyePoints));
+        bullseyeEdgeCounts[ii] = edgePositions[ii].size();
       }
 
       // We require numberOfTransitions + 2 points because that's what
       // Bullseye2D::estimate() needs.
       // brick::common::UInt32 const numberRequired = numberOfTransitions + 2;
       brick::common::UInt32 const numberRequired = numberOfTransitions + 5;
-      if(m_bullseyePoints.size() < numberRequired) {
+      if(bullseyePoints.size() < numberRequired) {
         return false;
       }
 
       // See if the edges look like a bullseye.
-      brick::numeric::Array1D<FloatType> residuals(m_bullseyePoints.size());
+      brick::numeric::Array1D<FloatType> residuals(bullseyePoints.size());
       try {
         bullseye.estimate(
-          m_bullseyePoints.begin(), m_bullseyePoints.end(),
-          m_bullseyeEdgeCounts.begin(), m_bullseyeEdgeCounts.end(),
+          bullseyePoints.begin(), bullseyePoints.end(),
+          bullseyeEdgeCounts.begin(), bullseyeEdgeCounts.end(),
           residuals.begin());
       } catch(brick::common::ValueException) {
         // Input points weren't good enough to define a bullseye.
@@ -773,9 +937,9 @@ namespace brick {
       // discard the worst 25% of points and hope that the rest are
       // inliers.  Hopefully this gets rid of the occasional bad input
       // point.
-      brick::common::UInt32 numberToRetain = (m_bullseyePoints.size() * 0.75) + 0.5;
+      brick::common::UInt32 numberToRetain = (bullseyePoints.size() * 0.75) + 0.5;
       numberToRetain = std::max(numberToRetain, numberRequired);
-      if(numberToRetain >= m_bullseyePoints.size()) {
+      if(numberToRetain >= bullseyePoints.size()) {
         return true;
       }
 
@@ -798,7 +962,7 @@ namespace brick {
       numberToRetain = std::count_if(
         absResiduals.begin(), absResiduals.end(),
         std::bind2nd(std::less_equal<FloatType>(), maximumAcceptableResidual));
-      if((numberToRetain >= m_bullseyePoints.size())
+      if((numberToRetain >= bullseyePoints.size())
          || (numberToRetain < numberRequired)) {
         return true;
       }
@@ -809,19 +973,14 @@ namespace brick {
       brick::common::UInt32 currentRing = 0;
       brick::common::UInt32 pointsThisRing = 0;
       brick::common::UInt32 outputIndex = 0;
-      for(brick::common::UInt32 ii = 0; ii < m_bullseyePoints.size(); ++ii) {
-        if(pointsThisRing >= m_bullseyeEdgeCounts[currentRing]) {
+      for(brick::common::UInt32 ii = 0; ii < bullseyePoints.size(); ++ii) {
+        if(pointsThisRing >= bullseyeEdgeCounts[currentRing]) {
           ++currentRing;
           pointsThisRing = 0;
         }
         if(absResiduals[ii] > maximumAcceptableResidual) {
           // Found an outlier.  Update bookkeeping and skip it.
-          // Again, we fight with our decision to make
-          // m_bullseyeEdgeCounts be a class member.
-          if(
-            --(const_cast<KeypointSelectorBullseye<FloatType>*>(this)->
-               m_bullseyeEdgeCounts[currentRing]) == 0
-            ) {
+          if(--(bullseyeEdgeCounts[currentRing]) == 0) {
             // We require at least one point in each ring, so we're
             // done.  Fortunately, we still have the bullseye estimate
             // from our non-robust attempt, so return true to indicate
@@ -840,7 +999,7 @@ namespace brick {
         }
 
         // Looks like this point is an inlier.  Copy it.
-        inliers[outputIndex] = m_bullseyePoints[ii];
+        inliers[outputIndex] = bullseyePoints[ii];
         ++outputIndex;
         ++pointsThisRing;
       }
@@ -859,7 +1018,7 @@ namespace brick {
         // have no use for the calculated residuals here.
         bullseye.estimate(
           inliers.begin(), inliers.end(),
-          m_bullseyeEdgeCounts.begin(), m_bullseyeEdgeCounts.end(), false);
+          bullseyeEdgeCounts.begin(), bullseyeEdgeCounts.end(), false);
       } catch(brick::common::ValueException) {
         // If this call throws, we'll just return the un-updated
         // bullseye.
@@ -1049,15 +1208,15 @@ namespace brick {
       brick::numeric::Array2D<FloatType> const& gradientX,
       brick::numeric::Array2D<FloatType> const& gradientY,
       brick::common::UInt32 minRadius,
-      brick::common::UInt32 maxRadius) const
+      brick::common::UInt32 maxRadius,
+      FittingWorkspace& workspace) const
     {
       // Make sure there's no cruft still left in our pre-allocated
       // buffers.
+      std::vector< std::vector< brick::numeric::Vector2D<FloatType> > >&
+        edgePositions = workspace.edgePositions;
       for(brick::common::UInt32 ii = 0; ii < m_numberOfTransitions; ++ii) {
-        // This pre-allocated working buffer idea sucks because it
-        // violates our const-ness promise.
-        const_cast<KeypointSelectorBullseye<FloatType>*>(this)->
-          m_edgePositions[ii].clear();
+        edgePositions[ii].clear();
       }
 
       // Clean the incoming keypoint struct.
@@ -1072,8 +1231,7 @@ namespace brick {
       for(brick::common::UInt32 ii = 1; ii < maxRadius; ++ii) {
         if(testAndRecordEdges(
              edgeImage, keypoint.row, keypoint.column - ii,
-             (const_cast<KeypointSelectorBullseye<FloatType>*>(this)->
-              m_edgePositions),
+             edgePositions,
              edgeCount, m_numberOfTransitions)) {
           break;
         }
@@ -1084,8 +1242,7 @@ namespace brick {
       for(brick::common::UInt32 ii = 1; ii < maxRadius; ++ii) {
         if(testAndRecordEdges(
              edgeImage, keypoint.row, keypoint.column + ii,
-             (const_cast<KeypointSelectorBullseye<FloatType>*>(this)->
-              m_edgePositions),
+             edgePositions,
              edgeCount, m_numberOfTransitions)) {
           break;
         }
@@ -1096,8 +1253,7 @@ namespace brick {
       for(brick::common::UInt32 ii = 1; ii < maxRadius; ++ii) {
         if(testAndRecordEdges(
              edgeImage, keypoint.row - ii, keypoint.column,
-             (const_cast<KeypointSelectorBullseye<FloatType>*>(this)->
-              m_edgePositions),
+             edgePositions,
              edgeCount, m_numberOfTransitions)) {
           break;
         }
@@ -1108,8 +1264,7 @@ namespace brick {
       for(brick::common::UInt32 ii = 1; ii < maxRadius; ++ii) {
         if(testAndRecordEdgesDiagonal(
              edgeImage, keypoint.row - ii, keypoint.column - ii, -1, -1,
-             (const_cast<KeypointSelectorBullseye<FloatType>*>(this)->
-              m_edgePositions),
+             edgePositions,
              edgeCount, m_numberOfTransitions)) {
           break;
         }
@@ -1120,8 +1275,7 @@ namespace brick {
       for(brick::common::UInt32 ii = 1; ii < maxRadius; ++ii) {
         if(testAndRecordEdgesDiagonal(
              edgeImage, keypoint.row - ii, keypoint.column + ii, -1, 1,
-             (const_cast<KeypointSelectorBullseye<FloatType>*>(this)->
-              m_edgePositions), edgeCount, m_numberOfTransitions)) {
+             edgePositions, edgeCount, m_numberOfTransitions)) {
           break;
         }
       }
@@ -1131,8 +1285,7 @@ namespace brick {
       for(brick::common::UInt32 ii = 1; ii < maxRadius; ++ii) {
         if(testAndRecordEdges(
              edgeImage, keypoint.row + ii, keypoint.column,
-             (const_cast<KeypointSelectorBullseye<FloatType>*>(this)->
-              m_edgePositions),
+             edgePositions,
              edgeCount, m_numberOfTransitions)) {
           break;
         }
@@ -1144,8 +1297,7 @@ namespace brick {
       for(brick::common::UInt32 ii = 1; ii < maxRadius; ++ii) {
         if(testAndRecordEdgesDiagonal(
              edgeImage, keypoint.row + ii, keypoint.column - ii, 1, -1,
-             (const_cast<KeypointSelectorBullseye<FloatType>*>(this)->
-              m_edgePositions), edgeCount, m_numberOfTransitions)) {
+             edgePositions, edgeCount, m_numberOfTransitions)) {
           break;
         }
       }
@@ -1155,8 +1307,7 @@ namespace brick {
       for(brick::common::UInt32 ii = 1; ii < maxRadius; ++ii) {
         if(testAndRecordEdgesDiagonal(
              edgeImage, keypoint.row + ii, keypoint.column + ii, 1, 1,
-             (const_cast<KeypointSelectorBullseye<FloatType>*>(this)->
-              m_edgePositions), edgeCount, m_numberOfTransitions)) {
+             edgePositions, edgeCount, m_numberOfTransitions)) {
           break;
         }
       }
@@ -1165,7 +1316,7 @@ namespace brick {
       keypoint.bullseyeMetric = -1.0;
       brick::geometry::Bullseye2D<FloatType> bullseye(m_numberOfTransitions);
       if(this->estimateBullseye(
-           bullseye, m_edgePositions, m_numberOfTransitions)) {
+           bullseye, workspace, m_numberOfTransitions)) {
         FloatType bullseyeMetric = -1.0;
         if(this->validateBullseye(
              bullseye,
@@ -1178,7 +1329,7 @@ namespace brick {
           keypoint.bullseyeMetric = bullseyeMetric;
           keypoint.bullseye = bullseye;
           for(brick::common::UInt32 ii = 0; ii < m_numberOfTransitions; ++ii) {
-            std::copy(m_edgePositions[ii].begin(), m_edgePositions[ii].end(),
+            std::copy(edgePositions[ii].begin(), edgePositions[ii].end(),
                       std::back_inserter(keypoint.seedPoints));
           }
         }
@@ -1226,6 +1377,87 @@ namespace brick {
     }
 
 
+    template <class FloatType>
+    std::vector< KeypointBullseye<brick::common::Int32, FloatType> >
+    KeypointSelectorBullseye<FloatType>::
+    fitCandidates(std::vector<ScreenedCandidate> const& candidates,
+                  std::vector<EdgeRegion> const& edgeRegions,
+                  brick::common::UInt32 numberOfThreads) const
+    {
+      // Each thread keeps its own sorted list of the best keypoints
+      // it has found, and needs its own scratch space.
+      std::vector< std::vector< KeypointBullseye<brick::common::Int32, FloatType> > >
+        bandKeypoints(numberOfThreads);
+      brick::common::parallelFor(
+        0, candidates.size(), numberOfThreads,
+        [&](std::size_t begin, std::size_t end, std::size_t band) {
+          FittingWorkspace workspace(m_numberOfTransitions);
+          for(std::size_t ii = begin; ii < end; ++ii) {
+            ScreenedCandidate const& candidate = candidates[ii];
+
+            // Either there's one region covering the whole image, or
+            // there's one region per candidate.
+            EdgeRegion const& region =
+              (edgeRegions.size() == 1) ? edgeRegions[0] : edgeRegions[ii];
+
+            // Work in the coordinate system of the edge region.
+            KeypointBullseye<brick::common::Int32, FloatType> keypoint =
+              candidate.keypoint;
+            keypoint.row -= region.startRow;
+            keypoint.column -= region.startColumn;
+
+            this->evaluateBullseyeMetric(keypoint, region.edgeImage,
+                                         region.gradientX, region.gradientY,
+                                         candidate.minRadius,
+                                         candidate.maxRadius, workspace);
+            if(keypoint.bullseyeMetric < 0.0) {
+              continue;
+            }
+
+            // Translate back into image coordinates.
+            if(region.startRow != 0 || region.startColumn != 0) {
+              brick::numeric::Vector2D<FloatType> offset(
+                region.startColumn, region.startRow);
+              keypoint.row += region.startRow;
+              keypoint.column += region.startColumn;
+              keypoint.bullseye.setOrigin(keypoint.bullseye.getOrigin() + offset);
+              for(auto seedIter = keypoint.seedPoints.begin();
+                  seedIter != keypoint.seedPoints.end(); ++seedIter) {
+                *seedIter += offset;
+              }
+            }
+            this->sortedInsert(keypoint, bandKeypoints[band],
+                               this->m_minRadius, this->m_maxNumberOfBullseyes);
+          }
+        });
+
+      // Merge the per-thread lists.  Inserting in order of
+      // decreasing bullseyeMetric means that the best of any group
+      // of overlapping keypoints is the one that survives.  The sort
+      // is stable so that ties are resolved the same way as in a
+      // single thread.
+      std::vector< KeypointBullseye<brick::common::Int32, FloatType> >
+        mergedKeypoints;
+      for(brick::common::UInt32 band = 0; band < bandKeypoints.size(); ++band) {
+        std::copy(bandKeypoints[band].begin(), bandKeypoints[band].end(),
+                  std::back_inserter(mergedKeypoints));
+      }
+      std::stable_sort(
+        mergedKeypoints.begin(), mergedKeypoints.end(),
+        [](KeypointBullseye<brick::common::Int32, FloatType> const& xx,
+           KeypointBullseye<brick::common::Int32, FloatType> const& yy)
+        {return xx.bullseyeMetric > yy.bullseyeMetric;});
+
+      std::vector< KeypointBullseye<brick::common::Int32, FloatType> > result;
+      for(auto keypointIter = mergedKeypoints.begin();
+          keypointIter != mergedKeypoints.end(); ++keypointIter) {
+        this->sortedInsert(*keypointIter, result,
+                           this->m_minRadius, this->m_maxNumberOfBullseyes);
+      }
+      return result;
+    }
+
+
     // Uses connected components to limit attention to a small
     // number of "candidate" points in the image.
     // TBD(xxx): Make ROI relevant.
@@ -1233,6 +1465,7 @@ namespace brick {
     std::vector<brick::numeric::Index2D>
     KeypointSelectorBullseye<FloatType>::
     getCandidatePoints(Image<GRAY8> const& inputImage,
+                       brick::common::UInt32 maxRadius,
                        brick::common::UInt32 /* startRow */,
                        brick::common::UInt32 /* startColumn */,
                        brick::common::UInt32 /* stopRow */,
@@ -1247,7 +1480,7 @@ namespace brick {
       // adaptive window size of the thresholder large enough that it
       // won't average out the bullseyes.  We're not very sensitive to
       // parameter kappa, so we leave it at its default value.
-      brick::common::UInt32 const windowRadius = this->m_maxRadius;
+      brick::common::UInt32 const windowRadius = maxRadius;
       brick::common::Float64 const kappa = 0.5;
       ThresholderSauvola<GRAY8> thresholder(windowRadius, kappa);
       Image<GRAY8> binaryImage = thresholder(inputImage);
@@ -1271,8 +1504,7 @@ namespace brick {
       // We'll discard components that are bigger than our largest
       // acceptable bullseye, or are tiny.
       brick::common::UInt32 maxArea = static_cast<brick::common::UInt32>(
-        brick::common::constants::pi * this->m_maxRadius * this->m_maxRadius
-        + 0.5);
+        brick::common::constants::pi * maxRadius * maxRadius + 0.5);
       std::vector<brick::numeric::Index2D> candidatePoints;
       for(auto componentDescriptionIter = componentDescriptionVector.begin();
           componentDescriptionIter != componentDescriptionVector.end();
@@ -1281,7 +1513,7 @@ namespace brick {
         if(description.area > maxArea) {
           continue;
         }
-        if(description.radius > this->m_maxRadius
+        if(description.radius > maxRadius
           || description.radius == 0) {
           continue;
         }
@@ -1418,6 +1650,157 @@ namespace brick {
     }
 
 
+    template <class FloatType>
+    std::vector< typename KeypointSelectorBullseye<FloatType>::ScreenedCandidate >
+    KeypointSelectorBullseye<FloatType>::
+    screenCandidates(Image<GRAY8> const& inImage,
+                     std::vector<brick::numeric::Index2D> const& points,
+                     FloatType asymmetryThreshold,
+                     brick::common::UInt32 numberOfThreads) const
+    {
+      std::vector< std::vector<ScreenedCandidate> > bandCandidates(
+        numberOfThreads);
+      brick::common::parallelFor(
+        0, points.size(), numberOfThreads,
+        [&](std::size_t begin, std::size_t end, std::size_t band) {
+          for(std::size_t ii = begin; ii < end; ++ii) {
+            brick::common::UInt32 row = points[ii].getRow();
+            brick::common::UInt32 column = points[ii].getColumn();
+
+            // Tailor fiducial size so we don't run off the side of
+            // the image.
+            ScreenedCandidate candidate;
+            candidate.minRadius = m_minRadius;
+            candidate.maxRadius = m_maxRadius;
+            if(!this->adjustFiducialSize(
+                 candidate.minRadius, candidate.maxRadius, row, column,
+                 inImage.rows(), inImage.columns())) {
+              continue;
+            }
+
+            candidate.keypoint =
+              KeypointBullseye<brick::common::Int32, FloatType>(row, column);
+            if(this->isPlausibleBullseye(
+                 candidate.keypoint, inImage, candidate.minRadius,
+                 candidate.maxRadius, asymmetryThreshold)) {
+              bandCandidates[band].push_back(candidate);
+            }
+          }
+        });
+
+      // Bands are contiguous, so concatenating them preserves the
+      // order of the input points.
+      std::vector<ScreenedCandidate> result;
+      for(brick::common::UInt32 band = 0; band < bandCandidates.size(); ++band) {
+        std::copy(bandCandidates[band].begin(), bandCandidates[band].end(),
+                  std::back_inserter(result));
+      }
+      return result;
+    }
+
+
+    template <class FloatType>
+    std::vector< typename KeypointSelectorBullseye<FloatType>::ScreenedCandidate >
+    KeypointSelectorBullseye<FloatType>::
+    screenCandidatesCoarse(
+      Image<GRAY8> const& inImage,
+      Image<GRAY8> const& coarseImage,
+      std::vector<brick::numeric::Index2D> const& coarsePoints,
+      brick::common::UInt32 screeningLevel,
+      FloatType coarseAsymmetryThreshold,
+      brick::common::UInt32 numberOfThreads) const
+    {
+      brick::common::Int32 const scale =
+        brick::common::Int32(1) << screeningLevel;
+      brick::common::UInt32 const coarseMinRadius = m_minRadius / scale;
+      brick::common::UInt32 const coarseMaxRadius =
+        (m_maxRadius + scale - 1) / scale;
+      brick::common::Int32 const rows = inImage.rows();
+      brick::common::Int32 const columns = inImage.columns();
+
+      std::vector< std::vector<ScreenedCandidate> > bandCandidates(
+        numberOfThreads);
+      brick::common::parallelFor(
+        0, coarsePoints.size(), numberOfThreads,
+        [&](std::size_t begin, std::size_t end, std::size_t band) {
+          for(std::size_t ii = begin; ii < end; ++ii) {
+            brick::common::UInt32 coarseRow = coarsePoints[ii].getRow();
+            brick::common::UInt32 coarseColumn = coarsePoints[ii].getColumn();
+
+            // Cheap test on the downsampled image.
+            brick::common::UInt32 minRadius = coarseMinRadius;
+            brick::common::UInt32 maxRadius = coarseMaxRadius;
+            if(!this->adjustFiducialSize(
+                 minRadius, maxRadius, coarseRow, coarseColumn,
+                 coarseImage.rows(), coarseImage.columns())) {
+              continue;
+            }
+            KeypointBullseye<brick::common::Int32, FloatType> coarseKeypoint(
+              coarseRow, coarseColumn);
+            if(!this->isPlausibleBullseye(
+                 coarseKeypoint, coarseImage, minRadius, maxRadius,
+                 coarseAsymmetryThreshold)) {
+              continue;
+            }
+
+            // The candidate survived.  Its position is only known to
+            // within a coarse pixel, so search the surrounding full
+            // resolution pixels for the most symmetric plausible
+            // bullseye center.
+            brick::common::Int32 centerRow = coarseRow * scale + scale / 2;
+            brick::common::Int32 centerColumn =
+              coarseColumn * scale + scale / 2;
+            ScreenedCandidate bestCandidate;
+            bool isFound = false;
+            for(brick::common::Int32 row = centerRow - scale;
+                row <= centerRow + scale; ++row) {
+              if(row < 0 || row >= rows) {
+                continue;
+              }
+              for(brick::common::Int32 column = centerColumn - scale;
+                  column <= centerColumn + scale; ++column) {
+                if(column < 0 || column >= columns) {
+                  continue;
+                }
+                ScreenedCandidate candidate;
+                candidate.minRadius = m_minRadius;
+                candidate.maxRadius = m_maxRadius;
+                if(!this->adjustFiducialSize(
+                     candidate.minRadius, candidate.maxRadius, row, column,
+                     inImage.rows(), inImage.columns())) {
+                  continue;
+                }
+                candidate.keypoint =
+                  KeypointBullseye<brick::common::Int32, FloatType>(
+                    row, column);
+                if(!this->isPlausibleBullseye(
+                     candidate.keypoint, inImage, candidate.minRadius,
+                     candidate.maxRadius,
+                     std::numeric_limits<FloatType>::max())) {
+                  continue;
+                }
+                if(!isFound || (candidate.keypoint.asymmetry
+                                < bestCandidate.keypoint.asymmetry)) {
+                  bestCandidate = candidate;
+                  isFound = true;
+                }
+              }
+            }
+            if(isFound) {
+              bandCandidates[band].push_back(bestCandidate);
+            }
+          }
+        });
+
+      std::vector<ScreenedCandidate> result;
+      for(brick::common::UInt32 band = 0; band < bandCandidates.size(); ++band) {
+        std::copy(bandCandidates[band].begin(), bandCandidates[band].end(),
+                  std::back_inserter(result));
+      }
+      return result;
+    }
+
+
     template <class FloatType>
     void
     KeypointSelectorBullseye<FloatType>::
@@ -1425,7 +1808,7 @@ namespace brick {
       KeypointBullseye<brick::common::Int32, FloatType> const& keypoint,
       std::vector< KeypointBullseye<brick::common::Int32, FloatType> >& keypointVector,
       FloatType minRadius,
-      brick::common::UInt32 maxNumberOfBullseyes)
+      brick::common::UInt32 maxNumberOfBullseyes) const
     {
       // Keypoints should not overlap.  This means their centers must
       // be at least 2*radius apart.  We square this distance to avoid
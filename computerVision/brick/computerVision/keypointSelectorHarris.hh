@@ -146,6 +146,35 @@ namespace brick {
       setImage(Image<GRAY8> const& inImage);
 
 
+      /**
+       * Process an image to find keypoints.  This member function
+       * does the same work as setImage() (blurring, gradient
+       * products, windowed integration, and computation of the
+       * Harris indicator), but in a single pass over the image.  Each
+       * thread streams over a band of rows, keeping only the handful
+       * of intermediate rows that are still needed in small rolling
+       * buffers, so no full-size intermediate images are allocated.
+       *
+       * The windowed gradient products are identical to those
+       * computed by setImage().  The Harris indicator, however, is
+       * computed in floating point before the products are rescaled
+       * to avoid overflow, rather than after, so it is slightly more
+       * precise.  Strong keypoints will be the same as those found by
+       * setImage(), but very weak keypoints in nearly flat parts of
+       * the image may differ.
+       *
+       * @param inImage This argument is the image in which to look
+       * for keypoints.
+       *
+       * @param numberOfThreads This argument specifies how many
+       * threads should share the work.  Setting it to zero uses
+       * one thread per available processor.
+       */
+      void
+      setImageFused(Image<GRAY8> const& inImage,
+                    unsigned int numberOfThreads = 1);
+
+
     private:
 
       typedef brick::common::Int32 AccumulatedType;
@@ -178,6 +207,18 @@ namespace brick {
         brick::numeric::Index2D const& corner1);
 
 
+      // Does the work of setImageFused() for output rows in the
+      // range [startRow, stopRow), which must lie within the final
+      // search region.  Returns the largest windowed gradient product
+      // seen in the band.
+      AccumulatedType
+      computeHarrisIndicatorsFused(
+        Image<GRAY8> const& inImage,
+        brick::numeric::Array1D<AccumulatedType> const& blurKernel,
+        brick::numeric::Array1D<AccumulatedType> const& windowKernel,
+        unsigned int startRow, unsigned int stopRow);
+
+
       /* ======== Data members ========= */
       brick::numeric::Array2D<FloatType>       m_harrisIndicators;
       brick::numeric::Array2D<AccumulatedType> m_gradientXX;
@@ -192,6 +233,12 @@ namespace brick {
       brick::numeric::Index2D m_searchRegionCorner0;
       brick::numeric::Index2D m_searchRegionCorner1;
 
+      // Windowed gradient products must be divided by this number
+      // (and Harris indicators by its square) before being reported
+      // to the user.  setImage() rescales eagerly, and so sets it to
+      // one, while setImageFused() defers the rescaling to save a pass.
+      AccumulatedType m_divisor;
+
       // Parameters of the algorithm itself.
       FloatType m_kappa;
       FloatType m_sigma;
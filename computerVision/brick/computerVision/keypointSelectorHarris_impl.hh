@@ -19,8 +19,11 @@
 //
 // #include <brick/computerVision/keypointSelectorHarris.hh>
 
+#include <algorithm>
 #include <brick/common/mathFunctions.hh>
+#include <brick/common/parallelFor.hh>
 #include <brick/computerVision/imageFilter.hh>
+#include <brick/computerVision/kernels.hh>
 #include <brick/numeric/bilinearInterpolator.hh>
 #include <brick/numeric/filter.hh>
 #include <brick/numeric/subpixelInterpolate.hh>
@@ -57,6 +60,7 @@ namespace brick {
         m_gradientYY(),
         m_searchRegionCorner0(0, 0),
         m_searchRegionCorner1(0, 0),
+        m_divisor(1),
         m_kappa(kappa),
         m_sigma(sigma)
     {
@@ -93,6 +97,10 @@ namespace brick {
       unsigned int const startColumn = m_searchRegionCorner0.getColumn();
       unsigned int const stopColumn  = m_searchRegionCorner1.getColumn();
 
+      // Undo any deferred rescaling as we report keypoints.
+      FloatType const valueScale =
+        FloatType(1.0) / (FloatType(m_divisor) * FloatType(m_divisor));
+
       // Iterate over all pixels in the valid region.
       unsigned int rowStep = m_harrisIndicators.getRowStep();
       for(unsigned int row = stopRow - 1; row >= startRow; --row) {
@@ -117,8 +125,9 @@ namespace brick {
              && (*candidatePtr > *(candidatePtr + rowStep - 1))
              && (*candidatePtr > *(candidatePtr - rowStep + 1))) {
             *(iterator++) = KeypointHarris<brick::common::Int32>(
-              row, column, *candidatePtr,
-              xxRow[column], yyRow[column], xyRow[column]);
+              row, column, *candidatePtr * valueScale,
+              xxRow[column] / m_divisor, yyRow[column] / m_divisor,
+              xyRow[column] / m_divisor);
           }
         }
       }
@@ -171,6 +180,10 @@ namespace brick {
       brick::numeric::BilinearInterpolator<AccumulatedType, FloatType>
         yyInterpolator(m_gradientYY);
 
+      // Undo any deferred rescaling as we report keypoints.
+      FloatType const divisor = FloatType(m_divisor);
+      FloatType const valueScale = FloatType(1.0) / (divisor * divisor);
+
       // Iterate over all pixels in the valid region.
       unsigned int rowStep = m_harrisIndicators.getRowStep();
       for(unsigned int row = stopRow - 1; row >= startRow; --row) {
@@ -212,10 +225,10 @@ namespace brick {
                  && common::absoluteValue(columnCoordinate - column) < 1.0) {
 
                 *(iterator++) = KeypointHarris<FloatType>(
-                  rowCoordinate, columnCoordinate, extremeValue,
-                  xxInterpolator(rowCoordinate, columnCoordinate),
-                  xyInterpolator(rowCoordinate, columnCoordinate),
-                  yyInterpolator(rowCoordinate, columnCoordinate));
+                  rowCoordinate, columnCoordinate, extremeValue * valueScale,
+                  xxInterpolator(rowCoordinate, columnCoordinate) / divisor,
+                  xyInterpolator(rowCoordinate, columnCoordinate) / divisor,
+                  yyInterpolator(rowCoordinate, columnCoordinate) / divisor);
 
               }
             }
@@ -353,6 +366,79 @@ namespace brick {
       this->computeHarrisIndicators(
         m_gradientXX, m_gradientXY, m_gradientYY, m_harrisIndicators,
         m_searchRegionCorner0, m_searchRegionCorner1);
+      m_divisor = 1;
+    }
+
+
+    template <class FloatType>
+    void
+    KeypointSelectorHarris<FloatType>::
+    setImageFused(Image<GRAY8> const& inImage, unsigned int numberOfThreads)
+    {
+      // These are the same kernels used by setImage().  See the
+      // comments there for an explanation of the normalization.
+      Kernel<brick::common::Int32> blurKernel =
+        getGaussianKernelBySize<brick::common::Int32>(
+          size_t(5), size_t(5), -1.0, -1.0, true, 256, 256);
+      Kernel<brick::common::Int32> windowKernel =
+        getGaussianKernelBySize<brick::common::Int32>(
+          size_t(11), size_t(11), -1.0, -1.0, true, 45, 45);
+
+      // The blur, gradient, and windowing steps each leave deadspace
+      // at the edges of the image (2, 1, and 5 pixels respectively),
+      // exactly as in setImage().
+      unsigned int const border = 8;
+      unsigned int const rows = inImage.rows();
+      unsigned int const columns = inImage.columns();
+      m_searchRegionCorner0.setValue(border, border);
+      if(rows < 2 * border + 1 || columns < 2 * border + 1) {
+        m_searchRegionCorner1.setValue(border, border);
+        m_divisor = 1;
+        return;
+      }
+      m_searchRegionCorner1.setValue(rows - border, columns - border);
+
+      // Adjust array sizes, if necessary.
+      if((m_gradientXX.rows() != rows) || (m_gradientXX.columns() != columns)) {
+        m_gradientXX.reinit(rows, columns);
+        m_gradientXY.reinit(rows, columns);
+        m_gradientYY.reinit(rows, columns);
+      }
+      if((m_harrisIndicators.rows() != rows)
+         || (m_harrisIndicators.columns() != columns)) {
+        m_harrisIndicators.reinit(rows, columns);
+      }
+
+      // Non-max suppression looks one pixel outside the search
+      // region, so make sure there's nothing stale there.
+      std::fill(m_harrisIndicators.rowBegin(border - 1),
+                m_harrisIndicators.rowEnd(border - 1), FloatType(0));
+      std::fill(m_harrisIndicators.rowBegin(rows - border),
+                m_harrisIndicators.rowEnd(rows - border), FloatType(0));
+      for(unsigned int row = border; row < rows - border; ++row) {
+        m_harrisIndicators(row, border - 1) = FloatType(0);
+        m_harrisIndicators(row, columns - border) = FloatType(0);
+      }
+
+      // Each band of output rows is computed independently, so they
+      // can be farmed out to separate threads.
+      std::vector<AccumulatedType> bandMaxima(
+        brick::common::getNumberOfBands(rows - 2 * border, numberOfThreads),
+        AccumulatedType(0));
+      brick::common::parallelFor(
+        border, rows - border, numberOfThreads,
+        [&](std::size_t startRow, std::size_t stopRow, std::size_t band) {
+          bandMaxima[band] = this->computeHarrisIndicatorsFused(
+            inImage, blurKernel.getRowComponent(),
+            windowKernel.getRowComponent(), startRow, stopRow);
+        });
+
+      // Rather than rescale the windowed gradient products in a
+      // separate pass, record the divisor that setImage() would have
+      // used, and apply it when keypoints are reported.
+      AccumulatedType maxVal =
+        *std::max_element(bandMaxima.begin(), bandMaxima.end());
+      m_divisor = maxVal / 65535 + 1;
     }
 
 
@@ -487,6 +573,182 @@ namespace brick {
       }
     }
 
+
+
+    template <class FloatType>
+    typename KeypointSelectorHarris<FloatType>::AccumulatedType
+    KeypointSelectorHarris<FloatType>::
+    computeHarrisIndicatorsFused(
+      Image<GRAY8> const& inImage,
+      brick::numeric::Array1D<AccumulatedType> const& blurKernel,
+      brick::numeric::Array1D<AccumulatedType> const& windowKernel,
+      unsigned int startRow, unsigned int stopRow)
+    {
+      // The processing chain, for each output row, is: blur the
+      // image rows (5x5), take gradients of the blurred rows (3x3),
+      // multiply gradients, and window the products (11x11).  Each
+      // stage only needs a few rows of the stage before it, so we
+      // keep those rows in small ring buffers that are indexed by
+      // (image row % ring size).
+      int const blurRadius = 2;
+      int const windowRadius = 5;
+      int const blurSize = 2 * blurRadius + 1;
+      int const windowSize = 2 * windowRadius + 1;
+      int const columns = inImage.columns();
+
+      // Column ranges over which each stage produces valid data.
+      int const blurStart = blurRadius;
+      int const blurStop = columns - blurRadius;
+      int const productStart = blurStart + 1;
+      int const productStop = blurStop - 1;
+      int const outputStart = productStart + windowRadius;
+      int const outputStop = productStop - windowRadius;
+
+      brick::numeric::Array2D<AccumulatedType> rowBlurRing(blurSize, columns);
+      brick::numeric::Array2D<AccumulatedType> blurRing(3, columns);
+      brick::numeric::Array2D<AccumulatedType> xxRing(windowSize, columns);
+      brick::numeric::Array2D<AccumulatedType> xyRing(windowSize, columns);
+      brick::numeric::Array2D<AccumulatedType> yyRing(windowSize, columns);
+      AccumulatedType const* blurTaps = blurKernel.data();
+      AccumulatedType const* windowTaps = windowKernel.data();
+      AccumulatedType maxValue = 0;
+
+      // First image row that contributes to this band, and the next
+      // row of each stage to be computed.
+      int const firstProductRow = int(startRow) - windowRadius;
+      int const firstBlurRow = firstProductRow - 1;
+      int nextRowBlurRow = firstBlurRow - blurRadius;
+      int nextBlurRow = firstBlurRow;
+      int nextProductRow = firstProductRow;
+
+      for(int outputRow = startRow; outputRow < int(stopRow); ++outputRow) {
+
+        // Bring the product ring up to date for this output row.
+        for(; nextProductRow <= outputRow + windowRadius; ++nextProductRow) {
+
+          // Blurred rows needed for this product row.
+          for(; nextBlurRow <= nextProductRow + 1; ++nextBlurRow) {
+
+            // Horizontally blurred image rows needed for this blurred row.
+            for(; nextRowBlurRow <= nextBlurRow + blurRadius;
+                ++nextRowBlurRow) {
+              brick::common::UInt8 const* inPtr =
+                inImage.rowBegin(nextRowBlurRow);
+              AccumulatedType* outPtr =
+                rowBlurRing.rowBegin(nextRowBlurRow % blurSize);
+              for(int column = blurStart; column < blurStop; ++column) {
+                AccumulatedType sum = 0;
+                for(int tap = 0; tap < blurSize; ++tap) {
+                  sum += (static_cast<AccumulatedType>(
+                            inPtr[column + tap - blurRadius])
+                          * blurTaps[tap]);
+                }
+                outPtr[column] = sum;
+              }
+            }
+
+            AccumulatedType* outPtr = blurRing.rowBegin(nextBlurRow % 3);
+            std::fill(outPtr + blurStart, outPtr + blurStop,
+                      AccumulatedType(0));
+            for(int tap = 0; tap < blurSize; ++tap) {
+              AccumulatedType const* inPtr = rowBlurRing.rowBegin(
+                (nextBlurRow + tap - blurRadius) % blurSize);
+              AccumulatedType const weight = blurTaps[tap];
+              for(int column = blurStart; column < blurStop; ++column) {
+                outPtr[column] += inPtr[column] * weight;
+              }
+            }
+            for(int column = blurStart; column < blurStop; ++column) {
+              outPtr[column] >>= 16;
+            }
+          }
+
+          // Gradients & products, exactly as in computeGradients().
+          AccumulatedType const* abovePtr =
+            blurRing.rowBegin((nextProductRow - 1) % 3);
+          AccumulatedType const* centerPtr =
+            blurRing.rowBegin(nextProductRow % 3);
+          AccumulatedType const* belowPtr =
+            blurRing.rowBegin((nextProductRow + 1) % 3);
+          int const ringRow = nextProductRow % windowSize;
+          AccumulatedType* xxPtr = xxRing.rowBegin(ringRow);
+          AccumulatedType* xyPtr = xyRing.rowBegin(ringRow);
+          AccumulatedType* yyPtr = yyRing.rowBegin(ringRow);
+          for(int column = productStart; column < productStop; ++column) {
+            AccumulatedType gradientX =
+              ((centerPtr[column + 1] - centerPtr[column - 1]) << 1)
+              + (belowPtr[column + 1] - belowPtr[column - 1])
+              + (abovePtr[column + 1] - abovePtr[column - 1]);
+            AccumulatedType gradientY =
+              ((belowPtr[column] - abovePtr[column]) << 1)
+              + (belowPtr[column - 1] - abovePtr[column - 1])
+              + (belowPtr[column + 1] - abovePtr[column + 1]);
+            xxPtr[column] = gradientX * gradientX;
+            xyPtr[column] = gradientX * gradientY;
+            yyPtr[column] = gradientY * gradientY;
+          }
+
+          // Horizontal part of the windowed integration is done in
+          // place, working left to right.  To make this safe, the sum
+          // centered on column (c + windowRadius) is stored at column
+          // c, so that each write only clobbers an input that has
+          // already been used.  The vertical pass below compensates
+          // for this offset.
+          for(int column = productStart;
+              column < productStop - 2 * windowRadius; ++column) {
+            AccumulatedType xxSum = 0;
+            AccumulatedType xySum = 0;
+            AccumulatedType yySum = 0;
+            for(int tap = 0; tap < windowSize; ++tap) {
+              xxSum += xxPtr[column + tap] * windowTaps[tap];
+              xySum += xyPtr[column + tap] * windowTaps[tap];
+              yySum += yyPtr[column + tap] * windowTaps[tap];
+            }
+            xxPtr[column] = xxSum;
+            xyPtr[column] = xySum;
+            yyPtr[column] = yySum;
+          }
+        }
+
+        // Vertical part of the windowed integration, followed by the
+        // Harris indicator itself.  Note the windowRadius offset
+        // introduced by the in-place horizontal pass above.
+        AccumulatedType* xxOut = m_gradientXX.rowBegin(outputRow);
+        AccumulatedType* xyOut = m_gradientXY.rowBegin(outputRow);
+        AccumulatedType* yyOut = m_gradientYY.rowBegin(outputRow);
+        FloatType* harrisOut = m_harrisIndicators.rowBegin(outputRow);
+        std::fill(xxOut + outputStart, xxOut + outputStop, AccumulatedType(0));
+        std::fill(xyOut + outputStart, xyOut + outputStop, AccumulatedType(0));
+        std::fill(yyOut + outputStart, yyOut + outputStop, AccumulatedType(0));
+        for(int tap = 0; tap < windowSize; ++tap) {
+          int const ringRow = (outputRow + tap - windowRadius) % windowSize;
+          AccumulatedType const* xxIn =
+            xxRing.rowBegin(ringRow) - windowRadius;
+          AccumulatedType const* xyIn =
+            xyRing.rowBegin(ringRow) - windowRadius;
+          AccumulatedType const* yyIn =
+            yyRing.rowBegin(ringRow) - windowRadius;
+          AccumulatedType const weight = windowTaps[tap];
+          for(int column = outputStart; column < outputStop; ++column) {
+            xxOut[column] += xxIn[column] * weight;
+            xyOut[column] += xyIn[column] * weight;
+            yyOut[column] += yyIn[column] * weight;
+          }
+        }
+        for(int column = outputStart; column < outputStop; ++column) {
+          maxValue = std::max(maxValue, xxOut[column]);
+          maxValue = std::max(maxValue, xyOut[column]);
+          maxValue = std::max(maxValue, yyOut[column]);
+          FloatType const determinant =
+            (FloatType(xxOut[column]) * FloatType(yyOut[column])
+             - FloatType(xyOut[column]) * FloatType(xyOut[column]));
+          FloatType const trace = FloatType(xxOut[column]) + yyOut[column];
+          harrisOut[column] = determinant - m_kappa * trace * trace;
+        }
+      }
+      return maxValue;
+    }
+
   } // namespace computerVision
 
 } // namespace brick
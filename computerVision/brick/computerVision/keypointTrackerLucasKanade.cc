@@ -0,0 +1,492 @@
+/**
+***************************************************************************
+* @file brick/computerVision/keypointTrackerLucasKanade.cc
+*
+* Source file defining a class for tracking sparse keypoints from
+* one image to the next using pyramidal Lucas-Kanade.
+*
+* Copyright (C) 2026 David LaRose, dlr@cs.cmu.edu
+* See accompanying file, LICENSE.TXT, for details.
+*
+***************************************************************************
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <brick/common/exception.hh>
+#include <brick/common/parallelFor.hh>
+#include <brick/computerVision/imagePyramidBinomial.hh>
+#include <brick/computerVision/keypointTrackerLucasKanade.hh>
+
+namespace brick {
+
+  namespace computerVision {
+
+    /// @cond privateCode
+    namespace privateCode {
+
+      // Bilinear interpolation weights are scaled by 2^7, so that
+      // weighted sums of 8 bit pixels fit in 16 bits, and
+      // interpolated pixel values are scaled by 2^5.  Window rows are
+      // processed in fixed size blocks, which the compiler can map
+      // onto 16 bit vector arithmetic.
+      const int lucasKanadeWeightBits = 7;
+      const int lucasKanadeValueBits = 5;
+      const size_t lucasKanadeBlockSize = 16;
+
+
+      // Returns the row stride used for windows of the specified
+      // width, which is padded to a whole number of blocks.
+      inline size_t
+      getBlockStride(size_t size)
+      {
+        return ((size + lucasKanadeBlockSize - 1) / lucasKanadeBlockSize
+                * lucasKanadeBlockSize);
+      }
+
+
+      // Returns true if sampleWindow() can interpolate a window of
+      // the specified size, with its upper left pixel at (column,
+      // row), without reading outside the valid region of the image.
+      // Note that sampleWindow() always reads at least one full
+      // block from each row.
+      inline bool
+      isWindowInBounds(Image<GRAY8> const& image, double column, double row,
+                       size_t size, int border)
+      {
+        double const firstColumn = std::floor(column);
+        double const firstRow = std::floor(row);
+        double const width = double(std::max(size, lucasKanadeBlockSize));
+        return (firstColumn >= border
+                && firstRow >= border
+                && firstColumn + width < double(image.columns()) - border
+                && firstRow + size < double(image.rows()) - border);
+      }
+
+
+      // Interpolates one block of lucasKanadeBlockSize pixels.  The
+      // result goes through a local buffer so that the compiler
+      // doesn't have to worry about outputPtr aliasing the input.
+      inline void
+      sampleBlock(brick::common::UInt8 const* upperPtr,
+                  brick::common::UInt8 const* lowerPtr,
+                  brick::common::UInt16 const* weights,
+                  brick::common::Int16* outputPtr)
+      {
+        int const shift = lucasKanadeWeightBits - lucasKanadeValueBits;
+        brick::common::UInt16 const rounding = 1 << (shift - 1);
+        brick::common::Int16 buffer[lucasKanadeBlockSize];
+        for(size_t jj = 0; jj < lucasKanadeBlockSize; ++jj) {
+          buffer[jj] = static_cast<brick::common::Int16>(
+            static_cast<brick::common::UInt16>(
+              weights[0] * upperPtr[jj] + weights[1] * upperPtr[jj + 1]
+              + weights[2] * lowerPtr[jj] + weights[3] * lowerPtr[jj + 1]
+              + rounding) >> shift);
+        }
+        std::copy(buffer, buffer + lucasKanadeBlockSize, outputPtr);
+      }
+
+
+      // Samples a size x size window, with its upper left pixel at
+      // (column, row), using fixed point bilinear interpolation.
+      // Output rows are outputStride elements apart.  If size is less
+      // than lucasKanadeBlockSize, a full block is written to each
+      // row, so outputStride must be at least lucasKanadeBlockSize.
+      // The window must be in bounds.
+      void
+      sampleWindow(Image<GRAY8> const& image, double column, double row,
+                   size_t size, size_t outputStride,
+                   brick::common::Int16* outputPtr)
+      {
+        double const firstColumn = std::floor(column);
+        double const firstRow = std::floor(row);
+        double const alpha = column - firstColumn;
+        double const beta = row - firstRow;
+        double const scale = double(1 << lucasKanadeWeightBits);
+        int weights0 = static_cast<int>(
+          (1.0 - alpha) * (1.0 - beta) * scale + 0.5);
+        int weights1 = static_cast<int>(alpha * (1.0 - beta) * scale + 0.5);
+        int weights2 = static_cast<int>((1.0 - alpha) * beta * scale + 0.5);
+
+        // Rounding the first three weights independently can leave
+        // a remainder of -1 for the fourth, which would wrap in the
+        // unsigned arithmetic of sampleBlock().  When that happens,
+        // the excess comes out of the largest weight instead, so
+        // that all four are non-negative and sum to
+        // 2^lucasKanadeWeightBits.
+        int excess = weights0 + weights1 + weights2
+          - (1 << lucasKanadeWeightBits);
+        if(excess > 0) {
+          int& largest = ((weights0 >= weights1)
+                          ? ((weights0 >= weights2) ? weights0 : weights2)
+                          : ((weights1 >= weights2) ? weights1 : weights2));
+          largest -= excess;
+          excess = 0;
+        }
+        brick::common::UInt16 weights[4];
+        weights[0] = static_cast<brick::common::UInt16>(weights0);
+        weights[1] = static_cast<brick::common::UInt16>(weights1);
+        weights[2] = static_cast<brick::common::UInt16>(weights2);
+        weights[3] = static_cast<brick::common::UInt16>(-excess);
+
+        size_t const column0 = static_cast<size_t>(firstColumn);
+        size_t const row0 = static_cast<size_t>(firstRow);
+        for(size_t ii = 0; ii < size; ++ii) {
+          brick::common::UInt8 const* upperPtr = image.data(row0 + ii, column0);
+          brick::common::UInt8 const* lowerPtr =
+            image.data(row0 + ii + 1, column0);
+          if(size <= lucasKanadeBlockSize) {
+            sampleBlock(upperPtr, lowerPtr, weights, outputPtr);
+          } else {
+            // The last block overlaps its predecessor, rather than
+            // reading past the end of the window.
+            size_t jj = 0;
+            for(; jj + lucasKanadeBlockSize <= size;
+                jj += lucasKanadeBlockSize) {
+              sampleBlock(upperPtr + jj, lowerPtr + jj, weights,
+                          outputPtr + jj);
+            }
+            if(jj < size) {
+              jj = size - lucasKanadeBlockSize;
+              sampleBlock(upperPtr + jj, lowerPtr + jj, weights,
+                          outputPtr + jj);
+            }
+          }
+          outputPtr += outputStride;
+        }
+      }
+
+
+    } // namespace privateCode
+    /// @endcond
+
+
+    // The constructor specifies the tracking window and pyramid
+    // size.
+    KeypointTrackerLucasKanade::
+    KeypointTrackerLucasKanade(unsigned int windowRadius,
+                               unsigned int numberOfLevels)
+      : m_currentLevels(),
+        m_epsilon(0.01),
+        m_maximumIterations(20),
+        m_maximumResidual(255.0),
+        m_minimumEigenvalue(0.01),
+        m_numberOfLevels(numberOfLevels),
+        m_numberOfThreads(1),
+        m_previousLevels(),
+        m_windowRadius(windowRadius)
+    {
+      // Larger windows could overflow the 32 bit sums in trackPoint().
+      if(windowRadius == 0 || windowRadius > 15) {
+        BRICK_THROW(brick::common::ValueException,
+                    "KeypointTrackerLucasKanade::"
+                    "KeypointTrackerLucasKanade()",
+                    "Argument windowRadius must be in the range [1, 15].");
+      }
+      if(numberOfLevels == 0) {
+        BRICK_THROW(brick::common::ValueException,
+                    "KeypointTrackerLucasKanade::"
+                    "KeypointTrackerLucasKanade()",
+                    "Argument numberOfLevels must be at least 1.");
+      }
+    }
+
+
+    // This member function adds a new image to the tracker.
+    void
+    KeypointTrackerLucasKanade::
+    setImage(Image<GRAY8> const& image)
+    {
+      // ImagePyramidBinomial keeps every level at least twice
+      // minimumImageSize, so this makes sure that the coarsest level
+      // is big enough to hold a tracking window.  It can't build a
+      // pyramid at all from an image smaller than that, so smaller
+      // images are used unchanged as a single level.
+      uint32_t const minimumImageSize = m_windowRadius + 2;
+      std::vector< Image<GRAY8> > levels;
+      if(image.rows() >= 2 * minimumImageSize
+         && image.columns() >= 2 * minimumImageSize) {
+        ImagePyramidBinomial<GRAY8, GRAY16> pyramid(
+          image, m_numberOfLevels, minimumImageSize, false, true);
+        for(unsigned int ii = 0; ii < pyramid.getNumberOfLevels(); ++ii) {
+          levels.push_back(pyramid.getLevel(ii));
+        }
+      } else {
+        levels.push_back(image.copy());
+      }
+      m_previousLevels.swap(m_currentLevels);
+      m_currentLevels.swap(levels);
+    }
+
+
+    // This member function tracks keypoints from the previous image
+    // to the current image.
+    void
+    KeypointTrackerLucasKanade::
+    track(std::vector< brick::numeric::Vector2D<double> > const&
+          previousPoints,
+          std::vector< brick::numeric::Vector2D<double> >& currentPoints,
+          std::vector<KeypointTrackStatus>& status,
+          std::vector<double>& residuals,
+          bool useInitialGuess) const
+    {
+      if(m_previousLevels.empty()) {
+        BRICK_THROW(brick::common::StateException,
+                    "KeypointTrackerLucasKanade::track()",
+                    "Member function setImage() must be called twice "
+                    "before tracking.");
+      }
+      if(m_previousLevels[0].rows() != m_currentLevels[0].rows()
+         || m_previousLevels[0].columns() != m_currentLevels[0].columns()) {
+        BRICK_THROW(brick::common::ValueException,
+                    "KeypointTrackerLucasKanade::track()",
+                    "The two most recent images must have the same size.");
+      }
+      if(useInitialGuess) {
+        if(currentPoints.size() != previousPoints.size()) {
+          BRICK_THROW(brick::common::ValueException,
+                      "KeypointTrackerLucasKanade::track()",
+                      "When useInitialGuess is true, currentPoints must "
+                      "have the same size as previousPoints.");
+        }
+      } else {
+        currentPoints.resize(previousPoints.size());
+      }
+      status.resize(previousPoints.size());
+      residuals.resize(previousPoints.size());
+
+      brick::common::parallelFor(
+        0, previousPoints.size(), m_numberOfThreads,
+        [&](size_t pointBegin, size_t pointEnd, size_t /* band */) {
+          Workspace workspace;
+          for(size_t ii = pointBegin; ii < pointEnd; ++ii) {
+            status[ii] = this->trackPoint(
+              previousPoints[ii], currentPoints[ii], residuals[ii],
+              useInitialGuess, workspace);
+          }
+        });
+    }
+
+
+    // ============== Private member functions below this line ==============
+
+    KeypointTrackStatus
+    KeypointTrackerLucasKanade::
+    trackPoint(brick::numeric::Vector2D<double> const& previousPoint,
+               brick::numeric::Vector2D<double>& currentPoint,
+               double& residual, bool useInitialGuess,
+               Workspace& workspace) const
+    {
+      typedef brick::common::Int16 Int16;
+      typedef brick::common::Int32 Int32;
+      typedef brick::common::Int64 Int64;
+      size_t const blockSize = privateCode::lucasKanadeBlockSize;
+
+      // Windows are stored with rows padded to a whole number of
+      // blocks.  The padding of the template and gradients is
+      // zero-initialized by resize(), and never written afterward, so
+      // it doesn't contribute to the sums below, regardless of what
+      // sampleWindow() writes to the padding of the current window.
+      size_t const windowSize = 2 * m_windowRadius + 1;
+      size_t const stride = privateCode::getBlockStride(windowSize);
+      size_t const templateSize = windowSize + 2;
+      size_t const templateStride = std::max(templateSize, blockSize);
+      size_t const numberOfPixels = windowSize * windowSize;
+      workspace.templatePatch.resize(templateSize * templateStride);
+      workspace.templateWindow.resize(windowSize * stride);
+      workspace.gradientX.resize(windowSize * stride);
+      workspace.gradientY.resize(windowSize * stride);
+      workspace.currentPatch.resize(windowSize * stride);
+
+      // Values and gradients are scaled by 2^lucasKanadeValueBits.
+      double const valueScale =
+        double(1 << privateCode::lucasKanadeValueBits);
+      double const radius = m_windowRadius;
+
+      // Displacement from previousPoint, in the coordinates of the
+      // current pyramid level.
+      size_t const numberOfLevels =
+        std::min(m_previousLevels.size(), m_currentLevels.size());
+      double levelScale = 1.0 / double(1 << (numberOfLevels - 1));
+      double displacementX = 0.0;
+      double displacementY = 0.0;
+      if(useInitialGuess) {
+        displacementX = (currentPoint.x() - previousPoint.x()) * levelScale;
+        displacementY = (currentPoint.y() - previousPoint.y()) * levelScale;
+      }
+
+      residual = 0.0;
+      for(size_t levelIndex = numberOfLevels; levelIndex > 0; --levelIndex) {
+        size_t const level = levelIndex - 1;
+        if(levelIndex != numberOfLevels) {
+          displacementX *= 2.0;
+          displacementY *= 2.0;
+          levelScale *= 2.0;
+        }
+        bool const isFinestLevel = (level == 0);
+
+        // Downsampled levels have an invalid one pixel border.
+        int const border = isFinestLevel ? 0 : 1;
+        Image<GRAY8> const& previousImage = m_previousLevels[level];
+        Image<GRAY8> const& currentImage = m_currentLevels[level];
+        double const pointX = previousPoint.x() * levelScale;
+        double const pointY = previousPoint.y() * levelScale;
+
+        // Sample the template (with a one pixel margin for computing
+        // gradients) and compute the normal matrix.
+        if(!privateCode::isWindowInBounds(
+             previousImage, pointX - radius - 1.0, pointY - radius - 1.0,
+             templateSize, border)) {
+          if(isFinestLevel) {
+            currentPoint.setValue(previousPoint.x() + displacementX,
+                                  previousPoint.y() + displacementY);
+            return KEYPOINT_TRACK_OUT_OF_BOUNDS;
+          }
+          continue;
+        }
+        privateCode::sampleWindow(
+          previousImage, pointX - radius - 1.0, pointY - radius - 1.0,
+          templateSize, templateStride, &(workspace.templatePatch[0]));
+
+        Int64 sumXX = 0;
+        Int64 sumXY = 0;
+        Int64 sumYY = 0;
+        for(size_t row = 0; row < windowSize; ++row) {
+          Int16 const* upperPtr =
+            &(workspace.templatePatch[row * templateStride + 1]);
+          Int16 const* centerPtr = upperPtr + templateStride;
+          Int16 const* lowerPtr = centerPtr + templateStride;
+          Int16* templatePtr = &(workspace.templateWindow[row * stride]);
+          Int16* gradientXPtr = &(workspace.gradientX[row * stride]);
+          Int16* gradientYPtr = &(workspace.gradientY[row * stride]);
+          Int32 rowXX = 0;
+          Int32 rowXY = 0;
+          Int32 rowYY = 0;
+          for(size_t column = 0; column < windowSize; ++column) {
+            Int16 const gradientX = static_cast<Int16>(
+              (centerPtr[column + 1] - centerPtr[column - 1]) >> 1);
+            Int16 const gradientY = static_cast<Int16>(
+              (lowerPtr[column] - upperPtr[column]) >> 1);
+            templatePtr[column] = centerPtr[column];
+            gradientXPtr[column] = gradientX;
+            gradientYPtr[column] = gradientY;
+            rowXX += Int32(gradientX) * gradientX;
+            rowXY += Int32(gradientX) * gradientY;
+            rowYY += Int32(gradientY) * gradientY;
+          }
+          sumXX += rowXX;
+          sumXY += rowXY;
+          sumYY += rowYY;
+        }
+
+        double const gXX = double(sumXX);
+        double const gXY = double(sumXY);
+        double const gYY = double(sumYY);
+        double const determinant = gXX * gYY - gXY * gXY;
+        double const minimumEigenvalue =
+          ((gXX + gYY) - std::sqrt((gXX - gYY) * (gXX - gYY)
+                                   + 4.0 * gXY * gXY)) / 2.0;
+        if(minimumEigenvalue / (valueScale * valueScale * numberOfPixels)
+           < m_minimumEigenvalue
+           || determinant <= 0.0) {
+          if(isFinestLevel) {
+            currentPoint.setValue(previousPoint.x() + displacementX,
+                                  previousPoint.y() + displacementY);
+            return KEYPOINT_TRACK_LOW_TEXTURE;
+          }
+          continue;
+        }
+        double const inverseXX = gYY / determinant;
+        double const inverseXY = -gXY / determinant;
+        double const inverseYY = gXX / determinant;
+
+        // Iteratively refine the displacement.  Only the current
+        // image window changes from one iteration to the next.
+        for(unsigned int iteration = 0; iteration < m_maximumIterations;
+            ++iteration) {
+          double const windowX = pointX + displacementX - radius;
+          double const windowY = pointY + displacementY - radius;
+          if(!privateCode::isWindowInBounds(
+               currentImage, windowX, windowY, windowSize, border)) {
+            break;
+          }
+          privateCode::sampleWindow(currentImage, windowX, windowY,
+                                    windowSize, stride,
+                                    &(workspace.currentPatch[0]));
+
+          // Each row sum has at most 32 terms of magnitude less than
+          // 2^25, so it fits in 32 bits.
+          Int64 sumX = 0;
+          Int64 sumY = 0;
+          for(size_t row = 0; row < windowSize; ++row) {
+            Int16 const* currentPtr = &(workspace.currentPatch[row * stride]);
+            Int16 const* templatePtr =
+              &(workspace.templateWindow[row * stride]);
+            Int16 const* gradientXPtr = &(workspace.gradientX[row * stride]);
+            Int16 const* gradientYPtr = &(workspace.gradientY[row * stride]);
+            Int32 rowX = 0;
+            Int32 rowY = 0;
+            for(size_t block = 0; block < stride; block += blockSize) {
+              for(size_t column = 0; column < blockSize; ++column) {
+                Int16 const difference = static_cast<Int16>(
+                  currentPtr[column] - templatePtr[column]);
+                rowX += Int32(difference) * gradientXPtr[column];
+                rowY += Int32(difference) * gradientYPtr[column];
+              }
+              currentPtr += blockSize;
+              templatePtr += blockSize;
+              gradientXPtr += blockSize;
+              gradientYPtr += blockSize;
+            }
+            sumX += rowX;
+            sumY += rowY;
+          }
+
+          double const deltaX =
+            inverseXX * double(sumX) + inverseXY * double(sumY);
+          double const deltaY =
+            inverseXY * double(sumX) + inverseYY * double(sumY);
+          displacementX -= deltaX;
+          displacementY -= deltaY;
+          if(deltaX * deltaX + deltaY * deltaY < m_epsilon * m_epsilon) {
+            break;
+          }
+        }
+      }
+
+      currentPoint.setValue(previousPoint.x() + displacementX,
+                            previousPoint.y() + displacementY);
+
+      // Compare the final window with the template.
+      Image<GRAY8> const& currentImage = m_currentLevels[0];
+      double const windowX = currentPoint.x() - radius;
+      double const windowY = currentPoint.y() - radius;
+      if(!privateCode::isWindowInBounds(currentImage, windowX, windowY,
+                                        windowSize, 0)) {
+        return KEYPOINT_TRACK_OUT_OF_BOUNDS;
+      }
+      privateCode::sampleWindow(currentImage, windowX, windowY,
+                                windowSize, stride,
+                                &(workspace.currentPatch[0]));
+      Int64 sumOfDifferences = 0;
+      for(size_t row = 0; row < windowSize; ++row) {
+        Int16 const* currentPtr = &(workspace.currentPatch[row * stride]);
+        Int16 const* templatePtr = &(workspace.templateWindow[row * stride]);
+        Int32 rowSum = 0;
+        for(size_t column = 0; column < windowSize; ++column) {
+          Int32 const difference =
+            Int32(currentPtr[column]) - templatePtr[column];
+          rowSum += (difference < 0) ? -difference : difference;
+        }
+        sumOfDifferences += rowSum;
+      }
+      residual = double(sumOfDifferences) / (valueScale * numberOfPixels);
+      if(residual > m_maximumResidual) {
+        return KEYPOINT_TRACK_LARGE_RESIDUAL;
+      }
+      return KEYPOINT_TRACK_OK;
+    }
+
+  } // namespace computerVision
+
+} // namespace brick
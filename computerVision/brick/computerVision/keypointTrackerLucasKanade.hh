@@ -0,0 +1,293 @@
+/**
+***************************************************************************
+* @file brick/computerVision/keypointTrackerLucasKanade.hh
+*
+* Header file declaring a class for tracking sparse keypoints from
+* one image to the next using pyramidal Lucas-Kanade.
+*
+* Copyright (C) 2026 David LaRose, dlr@cs.cmu.edu
+* See accompanying file, LICENSE.TXT, for details.
+*
+***************************************************************************
+*/
+
+#ifndef BRICK_COMPUTERVISION_KEYPOINTTRACKERLUCASKANADE_HH
+#define BRICK_COMPUTERVISION_KEYPOINTTRACKERLUCASKANADE_HH
+
+#include <vector>
+#include <brick/common/types.hh>
+#include <brick/computerVision/image.hh>
+#include <brick/numeric/vector2D.hh>
+
+namespace brick {
+
+  namespace computerVision {
+
+    /**
+     ** This enum reports the outcome of tracking a single keypoint
+     ** with KeypointTrackerLucasKanade.
+     **/
+    enum KeypointTrackStatus {
+      /// The keypoint was tracked successfully.
+      KEYPOINT_TRACK_OK,
+
+      /// The tracking window left the image.
+      KEYPOINT_TRACK_OUT_OF_BOUNDS,
+
+      /// The keypoint's neighborhood has too little texture (in at
+      /// least one direction) to be tracked reliably.
+      KEYPOINT_TRACK_LOW_TEXTURE,
+
+      /// The tracked window differs too much from the original.
+      KEYPOINT_TRACK_LARGE_RESIDUAL
+    };
+
+
+    /// @cond privateCode
+    namespace privateCode {
+
+      // Samples a size x size window of image, with its upper left
+      // pixel at (column, row), using fixed point bilinear
+      // interpolation.  Output values are scaled by 32 and output
+      // rows are outputStride elements apart.  At least 16 elements
+      // are written to each row, so outputStride must be at least
+      // that large, and the window (widened to 16 columns, plus one
+      // for interpolation) must be in bounds.  This is exposed only
+      // for testing.
+      void
+      sampleWindow(Image<GRAY8> const& image, double column, double row,
+                   size_t size, size_t outputStride,
+                   brick::common::Int16* outputPtr);
+
+    } // namespace privateCode
+    /// @endcond
+
+
+    /**
+     ** This class tracks keypoints from one image to the next using
+     ** the pyramidal Lucas-Kanade algorithm[1], which is much
+     ** cheaper than re-detecting and re-matching keypoints in each
+     ** image.
+     **
+     ** Each image passed to setImage() is downsampled into an
+     ** ImagePyramidBinomial.  Each keypoint is tracked first at the
+     ** coarsest level, and the result is used as the starting point
+     ** at the next finer level.  At each level, the displacement is
+     ** estimated using the inverse compositional formulation[2], in
+     ** which gradients and the 2x2 normal matrix are computed once
+     ** from the window around the keypoint in the previous image, so
+     ** each iteration only needs to resample the window in the
+     ** current image.  Windows are resampled using fixed point
+     ** bilinear interpolation, and stored with rows padded to a
+     ** multiple of 16 pixels, so that resampling and the
+     ** per-iteration sums run as fixed length loops of 16 and 32 bit
+     ** integer arithmetic, which the compiler can vectorize.
+     ** Independent keypoints are tracked in parallel.
+     **
+     ** Keypoint positions are Vector2D instances in which x is the
+     ** column coordinate and y is the row coordinate, with pixel
+     ** centers at integer coordinates.
+     **
+     ** Example usage:
+     **
+     ** @code
+     **   KeypointTrackerLucasKanade tracker;
+     **   tracker.setImage(image0);
+     **   tracker.setImage(image1);
+     **   std::vector< brick::numeric::Vector2D<double> > points1;
+     **   std::vector<KeypointTrackStatus> status;
+     **   std::vector<double> residuals;
+     **   tracker.track(points0, points1, status, residuals);
+     ** @endcode
+     **
+     ** [1] J. Bouguet, Pyramidal Implementation of the Lucas Kanade
+     ** Feature Tracker.  Intel Corporation, 2000.
+     **
+     ** [2] S. Baker and I. Matthews, Lucas-Kanade 20 Years On: A
+     ** Unifying Framework.  International Journal of Computer
+     ** Vision, 56(3), 2004.
+     **/
+    class KeypointTrackerLucasKanade {
+    public:
+
+      /**
+       * The constructor specifies the tracking window and pyramid
+       * size.
+       *
+       * @param windowRadius This argument specifies the size of the
+       * window that is matched at each pyramid level.  The window is
+       * (2 * windowRadius + 1) pixels on a side.  It must be in the
+       * range [1, 15].
+       *
+       * @param numberOfLevels This argument specifies how many
+       * pyramid levels to use.  Each level allows the tracker to
+       * follow roughly twice as much motion.  Fewer levels will be
+       * used if the images are too small.
+       */
+      KeypointTrackerLucasKanade(unsigned int windowRadius = 7,
+                                 unsigned int numberOfLevels = 4);
+
+
+      /**
+       * This member function returns the number of pyramid levels
+       * built for the most recent image, which may be fewer than
+       * requested in the constructor.
+       *
+       * @return The return value is the number of pyramid levels, or
+       * zero if setImage() has not been called.
+       */
+      unsigned int
+      getNumberOfLevels() const {
+        return static_cast<unsigned int>(m_currentLevels.size());
+      }
+
+
+      /**
+       * This member function adds a new image to the tracker.  The
+       * image passed in the previous call becomes the image from
+       * which keypoints are tracked, and this image becomes the image
+       * to which they are tracked.
+       *
+       * @param image This argument is the new image.  It is
+       * deep-copied into the base of the pyramid.
+       */
+      void
+      setImage(Image<GRAY8> const& image);
+
+
+      /**
+       * This member function sets the convergence criteria for the
+       * iterative estimate at each pyramid level.
+       *
+       * @param maximumIterations This argument specifies how many
+       * iterations are allowed at each level.  The default is 20.
+       *
+       * @param epsilon This argument specifies how small (in pixels)
+       * an update must be for the estimate to be considered
+       * converged.  The default is 0.01.
+       */
+      void
+      setConvergenceCriteria(unsigned int maximumIterations, double epsilon) {
+        m_maximumIterations = maximumIterations;
+        m_epsilon = epsilon;
+      }
+
+
+      /**
+       * This member function sets the threshold for
+       * KEYPOINT_TRACK_LARGE_RESIDUAL.
+       *
+       * @param maximumResidual This argument specifies the largest
+       * allowable residual, in gray levels.  Please see track() for a
+       * definition of the residual.  The default is 255, which never
+       * rejects a keypoint.
+       */
+      void
+      setMaximumResidual(double maximumResidual) {
+        m_maximumResidual = maximumResidual;
+      }
+
+
+      /**
+       * This member function sets the threshold for
+       * KEYPOINT_TRACK_LOW_TEXTURE.  Keypoints are rejected if the
+       * smaller eigenvalue of the normal matrix, divided by the
+       * number of pixels in the window, is less than this threshold.
+       * The eigenvalue is computed from central difference
+       * gradients in gray levels per pixel.
+       *
+       * @param minimumEigenvalue This argument specifies the
+       * threshold.  The default is 0.01.
+       */
+      void
+      setMinimumEigenvalue(double minimumEigenvalue) {
+        m_minimumEigenvalue = minimumEigenvalue;
+      }
+
+
+      /**
+       * This member function specifies how many threads should share
+       * the work.
+       *
+       * @param numberOfThreads This argument specifies the number of
+       * threads.  Setting it to zero uses one thread per available
+       * processor.  The default is 1.
+       */
+      void
+      setNumberOfThreads(unsigned int numberOfThreads) {
+        m_numberOfThreads = numberOfThreads;
+      }
+
+
+      /**
+       * This member function tracks keypoints from the previous image
+       * to the current image, where "previous" and "current" refer to
+       * the two most recent calls to setImage().
+       *
+       * @param previousPoints This argument specifies keypoint
+       * positions in the previous image.
+       *
+       * @param currentPoints This argument returns the keypoint
+       * positions in the current image.  If useInitialGuess is true,
+       * it must have the same size as previousPoints on entry, and
+       * its contents are used as the starting estimate.  Otherwise,
+       * tracking starts from the previous position.  Entries for
+       * keypoints that couldn't be tracked hold the best available
+       * estimate.
+       *
+       * @param status This argument returns the outcome of tracking
+       * each keypoint.
+       *
+       * @param residuals This argument returns, for each keypoint,
+       * the mean absolute difference in gray levels between the
+       * window around the keypoint in the previous image and the
+       * window around its tracked position in the current image.
+       *
+       * @param useInitialGuess This argument specifies whether the
+       * contents of currentPoints should be used as the starting
+       * estimate.
+       */
+      void
+      track(std::vector< brick::numeric::Vector2D<double> > const&
+            previousPoints,
+            std::vector< brick::numeric::Vector2D<double> >& currentPoints,
+            std::vector<KeypointTrackStatus>& status,
+            std::vector<double>& residuals,
+            bool useInitialGuess = false) const;
+
+    private:
+
+      // Per-thread scratch space for one keypoint.
+      struct Workspace {
+        std::vector<brick::common::Int16> templatePatch;
+        std::vector<brick::common::Int16> templateWindow;
+        std::vector<brick::common::Int16> gradientX;
+        std::vector<brick::common::Int16> gradientY;
+        std::vector<brick::common::Int16> currentPatch;
+      };
+
+
+      // Tracks a single keypoint, returning its status.
+      KeypointTrackStatus
+      trackPoint(brick::numeric::Vector2D<double> const& previousPoint,
+                 brick::numeric::Vector2D<double>& currentPoint,
+                 double& residual, bool useInitialGuess,
+                 Workspace& workspace) const;
+
+
+      std::vector< Image<GRAY8> > m_currentLevels;
+      double m_epsilon;
+      unsigned int m_maximumIterations;
+      double m_maximumResidual;
+      double m_minimumEigenvalue;
+      unsigned int m_numberOfLevels;
+      unsigned int m_numberOfThreads;
+      std::vector< Image<GRAY8> > m_previousLevels;
+      unsigned int m_windowRadius;
+    };
+
+  } // namespace computerVision
+
+} // namespace brick
+
+#endif /* #ifndef BRICK_COMPUTERVISION_KEYPOINTTRACKERLUCASKANADE_HH */
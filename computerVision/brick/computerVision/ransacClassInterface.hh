@@ -14,6 +14,7 @@
 #define BRICK_COMPUTERVISION_RANSACCLASSINTERFACE_HH
 
 #include <vector>
+#include <brick/computerVision/indexedSampleSelector.hh>
 #include <brick/computerVision/randomSampleSelector.hh>
 
 namespace brick {
@@ -423,6 +424,311 @@ namespace brick {
 
     }; // class RansacProblem
 
+
+    /**
+     ** This class template implements the same algorithm as class
+     ** Ransac, but works with problem classes that estimate models
+     ** from sets of indices into a fixed, contiguous sample store,
+     ** rather than from sequences of samples.  Index sets for many
+     ** hypotheses are drawn at once, and all working storage
+     ** (including the consensus set, which is a sorted list of
+     ** indices) is allocated before the first hypothesis is tested,
+     ** so the main loop does no memory allocation of its own.
+     **
+     ** The template argument, Problem, provides all of the
+     ** user-supplied problem-specific code.  The easiest way to make
+     ** an appropriate Problem class is to derive from class
+     ** IndexedRansacProblem, below.
+     **/
+    template <class Problem>
+    class IndexedRansac {
+    public:
+
+      /**
+       ** This typedef simply shadows template argument Problem.
+       **/
+      typedef Problem ProblemType;
+
+
+      /**
+       ** This typedef indicates the type of model that will be
+       ** estimated by the RANSAC algorithm.
+       **/
+      typedef typename Problem::ModelType ResultType;
+
+
+      /**
+       * This constructor sets up the IndexedRansac instance so that
+       * it is ready to solve the model fitting problem, but does not
+       * run the RANSAC algorithm.  The arguments have the same
+       * meaning as for the Ransac constructor.
+       *
+       * @param problem This argument is a class instance implementing
+       * the IndexedRansacProblem interface.
+       *
+       * @param minimumConsensusSize This argument specifies the
+       * smallest consensus set that should be taken as proof that the
+       * correct model has been found.  Zero means compute an
+       * appropriate value from requiredConfidence.
+       *
+       * @param requiredConfidence This argument indicates how
+       * confident we need to be that one run of the RANSAC algorithm
+       * will find the correct model.
+       *
+       * @param inlierProbability This argument indicates the
+       * likelihood that any particular sample is an inlier.
+       *
+       * @param verbosity This argument controls how much is printed
+       * to standard output.
+       */
+      IndexedRansac(ProblemType const& problem,
+                    size_t minimumConsensusSize = 0,
+                    double requiredConfidence = 0.99,
+                    double inlierProbability = 0.5,
+                    unsigned int verbosity = 0);
+
+
+      /**
+       * The destructor cleans up any system resources and destroys *this.
+       */
+      virtual
+      ~IndexedRansac() {}
+
+
+      /**
+       * Calculate which input samples are consistent with the
+       * specified model.
+       *
+       * @param model This argument is normally the result of a call
+       * to IndexedRansac::getResult().
+       *
+       * @return The return value is a sorted vector of the indices
+       * of those samples that are consistent with the model.
+       */
+      std::vector<size_t>
+      getConsensusSet(ResultType const& model);
+
+
+      /**
+       * This member function provides access to the problem instance
+       * that was copied by the constructor, for example, so that the
+       * calling context can call setSeed() or setSampleQuality().
+       *
+       * @return The return value is a reference to the problem.
+       */
+      ProblemType&
+      getProblem() {return m_problem;}
+
+
+      /**
+       * This member function runs the RANSAC algorithm and returns
+       * the computed model.
+       *
+       * @return The return value is the best model estimate returned
+       * by the RANSAC algorithm.
+       */
+      virtual ResultType
+      getResult();
+
+
+      /**
+       * This member function controls how many index sets are drawn
+       * from the problem in each call to its getSampleIndices()
+       * member function.  Larger batches amortize the cost of the
+       * call, but waste some work if RANSAC terminates early.
+       *
+       * @param batchSize This argument specifies the number of index
+       * sets per batch, and must be nonzero.
+       */
+      void
+      setBatchSize(size_t batchSize);
+
+
+      /**
+       * Overrides the computed number of RANSAC iterations.  See
+       * Ransac::setNumberOfRandomSampleSets().
+       *
+       * @param numberOfRandomSampleSets This argument specifies the
+       * maximum number of allowable RANSAC iterations.
+       */
+      void
+      setNumberOfRandomSampleSets(int numberOfRandomSampleSets) {
+        m_numberOfRandomSampleSets = numberOfRandomSampleSets;
+      }
+
+
+      /**
+       * Controls how many times a model may be refined on each
+       * RANSAC iteration.  See Ransac::setNumberOfRefinements().
+       *
+       * @param numberOfRefinements This argument specifies the
+       * maximum number of allowable refinements per iteration, or a
+       * negative number to refine until convergence.
+       */
+      void
+      setNumberOfRefinements(int numberOfRefinements) {
+        m_numberOfRefinements = numberOfRefinements;
+      }
+
+    protected:
+
+      void
+      computeConsensusSet(ResultType const& model,
+                          std::vector<double>& errorMetrics,
+                          std::vector<size_t>& consensusSet);
+
+      bool
+      estimate(ResultType& model);
+
+      bool
+      isConverged(std::vector<size_t> const& consensusSet,
+                  std::vector<size_t> const& previousConsensusSet,
+                  size_t& strikes,
+                  int refinementCount);
+
+
+      size_t m_batchSize;
+      size_t m_minimumConsensusSize;
+      size_t m_numberOfRandomSampleSets;
+      int m_numberOfRefinements;
+      ProblemType m_problem;
+      unsigned int m_verbosity;
+    };
+
+
+    /**
+     ** This class template implements the "Problem" interface
+     ** required by the IndexedRansac class, above.  It plays the same
+     ** role as RansacProblem, but the samples stay in one contiguous
+     ** store, provided by parent class IndexedSampleSelector, and
+     ** models are estimated from sets of indices into that store.
+     ** Use this->getSample(index) to access individual samples.
+     **
+     ** Template argument Sample specifies what type of sample (2D
+     ** points, 3D points, etc.) are used to estimate the model.
+     ** Template argument Model specifies the actual type of a model.
+     **/
+    template <class Sample, class Model>
+    class IndexedRansacProblem
+      : public IndexedSampleSelector<Sample>
+    {
+    public:
+
+      /**
+       ** This typedef simply mirrors the "Model" template argument
+       ** described in the documentation for this class.
+       **/
+      typedef Model ModelType;
+
+
+      /**
+       ** This typedef simply mirrors the "Sample" template argument
+       ** described in the documentation for this class.
+       **/
+      typedef Sample SampleType;
+
+
+      /**
+       * This constructor copies the sample population into the
+       * contiguous store from which index sets are drawn.
+       *
+       * @param sampleSize This argument specifies how many samples
+       * are required by estimateModel() to compute a model.
+       *
+       * @param beginIter This argument is an iterator pointing to the
+       * first element of a sequence of samples against which the
+       * RANSAC algorithm will be run.
+       *
+       * @param endIter This argument points, in the normal STL way,
+       * one element past the end of the sequence started by argument
+       * beginIter.
+       */
+      template <class IterType>
+      IndexedRansacProblem(size_t sampleSize,
+                           IterType beginIter, IterType endIter)
+        : IndexedSampleSelector<SampleType>(sampleSize, beginIter, endIter) {}
+
+
+      /**
+       * The destructor cleans up any system resources and destroys *this.
+       */
+      virtual
+      ~IndexedRansacProblem() {}
+
+
+      /**
+       * Subclasses may override this member function to reset
+       * internal state prior to the beginning of each iteration of
+       * the RANSAC algorithm.  See RansacProblem::beginIteration().
+       *
+       * @param iterationNumber This argument starts at zero and
+       * increments with each call to beginIteration().
+       */
+      virtual void
+      beginIteration(size_t /* iterationNumber */) {}
+
+
+      /**
+       * This member function should compute the error of every
+       * sample in the population with respect to the specified
+       * model.
+       *
+       * @param model This argument specifies the model against which
+       * to test.
+       *
+       * @param outputPtr This argument points to the first of
+       * this->getPoolSize() doubles, which should be filled with the
+       * error value for the corresponding sample.
+       */
+      virtual void
+      computeError(ModelType const& model, double* outputPtr) = 0;
+
+
+      /**
+       * This member function should compute the best fit model
+       * based on a subset of the samples.  The subset will contain
+       * at least this->getSampleSize() samples, and will have more
+       * when the model is being refined using a consensus set.
+       *
+       * @param indexBegin This argument points to the first of a
+       * sequence of indices into the sample population.
+       *
+       * @param indexEnd This argument points one past the last
+       * element of the sequence of indices.
+       *
+       * @return The return value is a model instance based on the
+       * indicated samples.
+       */
+      virtual ModelType
+      estimateModel(size_t const* indexBegin, size_t const* indexEnd) = 0;
+
+
+      /**
+       * This member function controls how the inlier/outlier decision
+       * is made during RANSAC operation.  For now, the only thing you
+       * can return is BRICK_CV_NAIVE_ERROR_THRESHOLD.
+       *
+       * @return The return value indicates the inlier strategy.
+       */
+      RansacInlierStrategy
+      getInlierStrategy() {
+        return BRICK_CV_NAIVE_ERROR_THRESHOLD;
+      }
+
+
+      /**
+       * This member function should return a threshold against which
+       * error values (computed by this->computeError()) should be
+       * compared.  Samples with error smaller than this threshold
+       * are considered to be inliers.
+       *
+       * @return The return value is the inlier/outlier threshold.
+       */
+      virtual double
+      getNaiveErrorThreshold() = 0;
+
+    }; // class IndexedRansacProblem
+
   } // namespace computerVision
 
 } // namespace brick
@@ -24,6 +24,7 @@
 #include <functional>
 #include <iostream>
 #include <brick/common/exception.hh>
+#include <brick/computerVision/ransac.hh>
 #include <brick/numeric/maxRecorder.hh>
 
 namespace brick {
@@ -294,6 +295,251 @@ namespace brick {
       return false;
     }
 
+
+    // The constructor sets up the IndexedRansac instance, but does
+    // not run the RANSAC algorithm.
+    template <class Problem>
+    IndexedRansac<Problem>::
+    IndexedRansac(Problem const& problem,
+                  size_t minimumConsensusSize,
+                  double requiredConfidence,
+                  double inlierProbability,
+                  unsigned int verbosity)
+      : m_batchSize(64),
+        m_minimumConsensusSize(minimumConsensusSize),
+        m_numberOfRandomSampleSets(),
+        m_numberOfRefinements(-1),
+        m_problem(problem),
+        m_verbosity(verbosity)
+    {
+      size_t sampleSize = m_problem.getSampleSize();
+
+      // This checks the range of both probability arguments.
+      m_numberOfRandomSampleSets = ransacGetRequiredIterations(
+        sampleSize, requiredConfidence, inlierProbability);
+
+      if(m_minimumConsensusSize == 0) {
+        // Same heuristic as Ransac::Ransac().
+        int extraSamples = static_cast<int>(
+          std::log(1.0 - requiredConfidence) / std::log(0.5) + 0.5);
+        if(extraSamples < 0) {
+          extraSamples = 0;
+        }
+        m_minimumConsensusSize = sampleSize + extraSamples;
+      }
+    }
+
+
+    // Calculate which input samples are consistent with the
+    // specified model.
+    template <class Problem>
+    std::vector<size_t>
+    IndexedRansac<Problem>::
+    getConsensusSet(ResultType const& model)
+    {
+      std::vector<double> errorMetrics(m_problem.getPoolSize());
+      std::vector<size_t> consensusSet;
+      consensusSet.reserve(m_problem.getPoolSize());
+      this->computeConsensusSet(model, errorMetrics, consensusSet);
+      return consensusSet;
+    }
+
+
+    // This member function runs the RANSAC algorithm and returns
+    // the computed model.
+    template <class Problem>
+    typename IndexedRansac<Problem>::ResultType
+    IndexedRansac<Problem>::
+    getResult()
+    {
+      ResultType result;
+      this->estimate(result);
+      return result;
+    }
+
+
+    // This member function controls how many index sets are drawn
+    // at a time.
+    template <class Problem>
+    void
+    IndexedRansac<Problem>::
+    setBatchSize(size_t batchSize)
+    {
+      if(batchSize == 0) {
+        BRICK_THROW(common::ValueException, "IndexedRansac::setBatchSize()",
+                    "Argument batchSize must be nonzero.");
+      }
+      m_batchSize = batchSize;
+    }
+
+
+    template <class Problem>
+    void
+    IndexedRansac<Problem>::
+    computeConsensusSet(ResultType const& model,
+                        std::vector<double>& errorMetrics,
+                        std::vector<size_t>& consensusSet)
+    {
+      if(m_problem.getInlierStrategy() != BRICK_CV_NAIVE_ERROR_THRESHOLD) {
+        BRICK_THROW(brick::common::NotImplementedException,
+                    "IndexedRansac::computeConsensusSet()",
+                    "Currently only naive error thresholding is supported.");
+      }
+
+      // Apply error function to entire set.
+      m_problem.computeError(model, &(errorMetrics[0]));
+
+      // Find out which samples are within tolerance.  The caller has
+      // reserved enough space that push_back() never reallocates.
+      double threshold = m_problem.getNaiveErrorThreshold();
+      consensusSet.clear();
+      for(size_t ii = 0; ii < errorMetrics.size(); ++ii) {
+        if(errorMetrics[ii] < threshold) {
+          consensusSet.push_back(ii);
+        }
+      }
+    }
+
+
+    template <class Problem>
+    bool
+    IndexedRansac<Problem>::
+    estimate(typename IndexedRansac<Problem>::ResultType& model)
+    {
+      size_t const poolSize = m_problem.getPoolSize();
+      size_t const sampleSize = m_problem.getSampleSize();
+
+      // All of the working storage for the main loop.
+      brick::numeric::Array2D<size_t> sampleIndices(
+        std::min(m_batchSize, m_numberOfRandomSampleSets), sampleSize);
+      std::vector<double> errorMetrics(poolSize);
+      std::vector<size_t> consensusSet;
+      std::vector<size_t> previousConsensusSet;
+      consensusSet.reserve(poolSize);
+      previousConsensusSet.reserve(poolSize);
+
+      brick::numeric::MaxRecorder<size_t, ResultType> maxRecorder;
+      size_t batchRow = sampleIndices.rows();
+      for(size_t iteration = 0; iteration < m_numberOfRandomSampleSets;
+          ++iteration) {
+        if(m_verbosity >= 3) {
+          std::cout << "IndexedRansac: running sample #" << iteration
+                    << " of " << m_numberOfRandomSampleSets << std::endl;
+        }
+
+        // Select samples, drawing a new batch of index sets if
+        // necessary.
+        if(batchRow >= sampleIndices.rows()) {
+          m_problem.getSampleIndices(sampleIndices.rows(), sampleIndices);
+          batchRow = 0;
+        }
+        size_t const* indexBegin = sampleIndices.data(batchRow, 0);
+        size_t const* indexEnd = indexBegin + sampleSize;
+        ++batchRow;
+
+        // Let the problem reset any state it keeps during the
+        // refinement loop.
+        m_problem.beginIteration(iteration);
+
+        previousConsensusSet.clear();
+        size_t strikes = 0;
+        int refinementCount = 0;
+        while(1) {
+          // Fit the model to the reduced set.
+          model = m_problem.estimateModel(indexBegin, indexEnd);
+
+          // Identify the consensus set, made up of samples that are
+          // sufficiently consistent with the model estimate.
+          this->computeConsensusSet(model, errorMetrics, consensusSet);
+
+          if(m_verbosity >= 3) {
+            std::cout
+              << "IndexedRansac:   consensus set size is "
+              << consensusSet.size()
+              << " (vs. " << m_minimumConsensusSize << ")" << std::endl;
+          }
+
+          // See if this iteration has converged yet.
+          if(this->isConverged(consensusSet, previousConsensusSet,
+                               strikes, refinementCount)) {
+            break;
+          }
+
+          // Not converged yet... loop so we can recompute the model
+          // using the new consensus set.  Swapping, rather than
+          // copying, keeps the indices we're about to use safe from
+          // the next call to computeConsensusSet().
+          previousConsensusSet.swap(consensusSet);
+          indexBegin = &(previousConsensusSet[0]);
+          indexEnd = indexBegin + previousConsensusSet.size();
+          ++refinementCount;
+        }
+
+        // OK, we've converged to a "best" result for this iteration.
+        // Is it good enough to terminate?
+        if(consensusSet.size() > m_minimumConsensusSize) {
+          return true;
+        }
+
+        // Not ready to terminate yet, but remember this model (if
+        // it's the best so far) in case we don't find any better.
+        maxRecorder.test(consensusSet.size(), model);
+      }
+
+      // Looks like we never found a gold plated correct answer.
+      // Return the best we found, and return false to indicate our
+      // frustration.
+      model = maxRecorder.getPayload();
+
+      if(m_verbosity >= 3) {
+        std::cout
+          << "IndexedRansac: terminating with best consensus set size of "
+          << maxRecorder.getMaximum() << std::endl;
+      }
+      return false;
+    }
+
+
+    template <class Problem>
+    bool
+    IndexedRansac<Problem>::
+    isConverged(std::vector<size_t> const& consensusSet,
+                std::vector<size_t> const& previousConsensusSet,
+                size_t& strikes,
+                int refinementCount)
+    {
+      // Do we even have enough matching points to continue
+      // iteration?
+      if(consensusSet.size() < m_problem.getSampleSize()) {
+        return true;
+      }
+
+      // Are we permitted to refine the model again?
+      if(m_numberOfRefinements >= 0
+         && refinementCount >= m_numberOfRefinements) {
+        return true;
+      }
+
+      // There's no previous consensus set on the first pass.
+      if(refinementCount > 0) {
+        // Does it look like we're in a cycle of adding/subtracting the
+        // same points?
+        if(consensusSet.size() <= previousConsensusSet.size()) {
+          ++strikes;
+        }
+        if(strikes > 10) {
+          return true;
+        }
+
+        // Are we selecting the same set as last time?  Both sets are
+        // sorted, so this is a simple comparison.
+        if(consensusSet == previousConsensusSet) {
+          return true;
+        }
+      }
+      return false;
+    }
+
   } // namespace computerVision
 
 } // namespace brick
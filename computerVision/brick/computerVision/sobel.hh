@@ -14,11 +14,22 @@
 #define BRICK_COMPUTERVISION_SOBEL_HH
 
 #include <brick/computerVision/image.hh>
+#include <brick/numeric/array2D.hh>
 
 namespace brick {
 
   namespace computerVision {
 
+    /**
+     ** This enum specifies how applySobel() combines the X and Y
+     ** gradient components into a gradient magnitude.
+     **/
+    enum SobelNorm {
+      BRICK_SOBEL_L1_NORM,  ///< abs(gradientX) + abs(gradientY).
+      BRICK_SOBEL_L2_NORM   ///< sqrt(gradientX^2 + gradientY^2).
+    };
+
+
 
     /**
      * This function applies the sobel edge operator in the X
@@ -75,6 +86,147 @@ namespace brick {
     Image<FORMAT>
     applySobelY(const Image<FORMAT>& inputImage, bool normalizeResult=false);
 
+
+    /**
+     * This function applies the sobel edge operator in both the X and
+     * Y directions in a single pass over the input image, writing the
+     * results to arrays of a (usually wider) type of the caller's
+     * choosing.  For example, GRAY8 gradients fit in
+     * brick::common::Int16, and GRAY16 gradients fit in
+     * brick::common::Int32, so there is no need to convert the image
+     * to a wider format first.  Border pixels are handled exactly as
+     * in applySobelX() and applySobelY(), and floating point results
+     * are bit-identical to theirs.
+     *
+     * The image is processed one row at a time, with the inner loops
+     * running over contiguous pixels so that the compiler can
+     * vectorize them.  Rows are addressed individually, so input and
+     * output arrays may have padded rows (a row step larger than
+     * the number of columns).  Rows can be divided among several
+     * threads.
+     *
+     * Use it like this:
+     *
+     * @code
+     *   Image<GRAY8> image = readPGM8(fileName);
+     *   brick::numeric::Array2D<brick::common::Int16> gradientX;
+     *   brick::numeric::Array2D<brick::common::Int16> gradientY;
+     *   applySobel(image, gradientX, gradientY);
+     * @endcode
+     *
+     * @param inputImage This argument is the image to be convolved.
+     * It must be 2x2 or larger.
+     *
+     * @param gradientX This argument is used to return the result of
+     * applying the X direction kernel (see applySobelX()).  It will
+     * be reinitialized if it doesn't already have the same shape as
+     * inputImage.  GradientType must be signed, and able to hold 8
+     * times the range of the input pixel values.
+     *
+     * @param gradientY This argument is used to return the result of
+     * applying the Y direction kernel (see applySobelY()).  It will
+     * be reinitialized if it doesn't already have the same shape as
+     * inputImage.
+     *
+     * @param numberOfThreads This argument specifies how many threads
+     * should share the work.  Setting it to zero uses one thread per
+     * available processor.
+     */
+    template <class GradientType, ImageFormat FORMAT>
+    void
+    applySobel(const Image<FORMAT>& inputImage,
+               brick::numeric::Array2D<GradientType>& gradientX,
+               brick::numeric::Array2D<GradientType>& gradientY,
+               unsigned int numberOfThreads = 1);
+
+
+    /**
+     * This function works just like the three-argument version of
+     * applySobel(), but also computes the gradient magnitude while
+     * each row of gradients is still in cache.  For integer
+     * GradientType, the L2 magnitude is rounded to the nearest
+     * integer.
+     *
+     * @param inputImage This argument is the image to be convolved.
+     *
+     * @param gradientX This argument is used to return the X
+     * component of the gradient.
+     *
+     * @param gradientY This argument is used to return the Y
+     * component of the gradient.
+     *
+     * @param magnitude This argument is used to return the gradient
+     * magnitude.  It will be reinitialized if it doesn't already have
+     * the same shape as inputImage.
+     *
+     * @param norm This argument specifies whether to compute the L1
+     * or the L2 magnitude.
+     *
+     * @param numberOfThreads This argument specifies how many threads
+     * should share the work.  Setting it to zero uses one thread per
+     * available processor.
+     */
+    template <class GradientType, ImageFormat FORMAT>
+    void
+    applySobel(const Image<FORMAT>& inputImage,
+               brick::numeric::Array2D<GradientType>& gradientX,
+               brick::numeric::Array2D<GradientType>& gradientY,
+               brick::numeric::Array2D<GradientType>& magnitude,
+               SobelNorm norm = BRICK_SOBEL_L2_NORM,
+               unsigned int numberOfThreads = 1);
+
+
+    /**
+     * This function works just like the four-argument version of
+     * applySobel(), but also quantizes the gradient direction.  The
+     * circle of directions is divided into numberOfOrientations equal
+     * bins, where bin k is centered on the direction 2*pi*k /
+     * numberOfOrientations, measured from the positive X (column)
+     * axis toward the positive Y (row) axis.  With the default of 8
+     * bins, bin 0 is a gradient pointing toward increasing column
+     * number, bin 2 is a gradient pointing toward increasing row
+     * number, and so on.  Opposite directions differ by
+     * numberOfOrientations / 2, so (bin % 4) gives the 4 undirected
+     * orientations used by non-maximum suppression.  Pixels with zero
+     * gradient are assigned bin 0.  Bins are assigned by comparing
+     * against precomputed bin boundaries, without calling atan2().
+     *
+     * @param inputImage This argument is the image to be convolved.
+     *
+     * @param gradientX This argument is used to return the X
+     * component of the gradient.
+     *
+     * @param gradientY This argument is used to return the Y
+     * component of the gradient.
+     *
+     * @param magnitude This argument is used to return the gradient
+     * magnitude.
+     *
+     * @param orientation This argument is used to return the
+     * quantized gradient direction.  It will be reinitialized if it
+     * doesn't already have the same shape as inputImage.
+     *
+     * @param numberOfOrientations This argument specifies how many
+     * direction bins to use.  It must be in the range [1, 256].
+     *
+     * @param norm This argument specifies whether to compute the L1
+     * or the L2 magnitude.
+     *
+     * @param numberOfThreads This argument specifies how many threads
+     * should share the work.  Setting it to zero uses one thread per
+     * available processor.
+     */
+    template <class GradientType, ImageFormat FORMAT>
+    void
+    applySobel(const Image<FORMAT>& inputImage,
+               brick::numeric::Array2D<GradientType>& gradientX,
+               brick::numeric::Array2D<GradientType>& gradientY,
+               brick::numeric::Array2D<GradientType>& magnitude,
+               brick::numeric::Array2D<brick::common::UInt8>& orientation,
+               unsigned int numberOfOrientations = 8,
+               SobelNorm norm = BRICK_SOBEL_L2_NORM,
+               unsigned int numberOfThreads = 1);
+
   } // namespace computerVision
 
 } // namespace brick
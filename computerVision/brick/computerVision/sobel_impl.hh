@@ -18,6 +18,13 @@
 //
 // #include <brick/computerVision/sobel.hh>
 
+#include <cmath>
+#include <type_traits>
+#include <vector>
+#include <brick/common/constants.hh>
+#include <brick/common/mathFunctions.hh>
+#include <brick/common/parallelFor.hh>
+
 namespace brick {
 
   namespace computerVision {
@@ -214,6 +221,350 @@ namespace brick {
     }
 
 
+    /// @cond privateCode
+    namespace privateCode {
+
+      // Sobel gradients for the first or last row of the image.
+      // Rows above the top (or below the bottom) of the image are
+      // extrapolated with constant first derivative, as in
+      // applySobelX() and applySobelY(), which reduces the Y kernel
+      // to a one-sided difference between lowPtr and highPtr.
+      // Pointer centerPtr is the row being computed, and equals
+      // either lowPtr or highPtr.
+      template <class GradientType, class PixelType>
+      void
+      sobelBorderRow(PixelType const* lowPtr,
+                     PixelType const* centerPtr,
+                     PixelType const* highPtr,
+                     size_t columns,
+                     GradientType* gradientXPtr,
+                     GradientType* gradientYPtr)
+      {
+        size_t const last = columns - 1;
+        gradientXPtr[0] = (
+          8 * (GradientType(centerPtr[1]) - GradientType(centerPtr[0])));
+        gradientYPtr[0] = (
+          8 * (GradientType(highPtr[0]) - GradientType(lowPtr[0])));
+        for(size_t column = 1; column < last; ++column) {
+          gradientXPtr[column] = (
+            4 * (GradientType(centerPtr[column + 1])
+                 - GradientType(centerPtr[column - 1])));
+          gradientYPtr[column] = (
+            2 * (GradientType(highPtr[column - 1])
+                 - GradientType(lowPtr[column - 1]))
+            + 4 * (GradientType(highPtr[column])
+                   - GradientType(lowPtr[column]))
+            + 2 * (GradientType(highPtr[column + 1])
+                   - GradientType(lowPtr[column + 1])));
+        }
+        gradientXPtr[last] = (
+          8 * (GradientType(centerPtr[last])
+               - GradientType(centerPtr[last - 1])));
+        gradientYPtr[last] = (
+          8 * (GradientType(highPtr[last]) - GradientType(lowPtr[last])));
+      }
+
+
+      // Sobel gradients for a row that has neighbors both above and
+      // below.
+      template <class GradientType, class PixelType>
+      void
+      sobelInteriorRow(PixelType const* upPtr,
+                       PixelType const* centerPtr,
+                       PixelType const* downPtr,
+                       size_t columns,
+                       GradientType* gradientXPtr,
+                       GradientType* gradientYPtr)
+      {
+        size_t const last = columns - 1;
+        gradientXPtr[0] = (
+          2 * (GradientType(upPtr[1]) - GradientType(upPtr[0]))
+          + 4 * (GradientType(centerPtr[1]) - GradientType(centerPtr[0]))
+          + 2 * (GradientType(downPtr[1]) - GradientType(downPtr[0])));
+        gradientYPtr[0] = (
+          4 * (GradientType(downPtr[0]) - GradientType(upPtr[0])));
+        for(size_t column = 1; column < last; ++column) {
+          gradientXPtr[column] = (
+            (GradientType(upPtr[column + 1]) - GradientType(upPtr[column - 1]))
+            + 2 * (GradientType(centerPtr[column + 1])
+                   - GradientType(centerPtr[column - 1]))
+            + (GradientType(downPtr[column + 1])
+               - GradientType(downPtr[column - 1])));
+          gradientYPtr[column] = (
+            (GradientType(downPtr[column - 1]) - GradientType(upPtr[column - 1]))
+            + 2 * (GradientType(downPtr[column]) - GradientType(upPtr[column]))
+            + (GradientType(downPtr[column + 1])
+               - GradientType(upPtr[column + 1])));
+        }
+        gradientXPtr[last] = (
+          2 * (GradientType(upPtr[last]) - GradientType(upPtr[last - 1]))
+          + 4 * (GradientType(centerPtr[last])
+                 - GradientType(centerPtr[last - 1]))
+          + 2 * (GradientType(downPtr[last]) - GradientType(downPtr[last - 1])));
+        gradientYPtr[last] = (
+          4 * (GradientType(downPtr[last]) - GradientType(upPtr[last])));
+      }
+
+
+      // L2 magnitude.  Integer gradients are squared in double
+      // precision to avoid overflow, and the result is rounded.
+      template <class GradientType>
+      inline GradientType
+      sobelL2Norm(GradientType gradientX, GradientType gradientY,
+                  std::true_type /* isIntegral */)
+      {
+        return static_cast<GradientType>(
+          std::sqrt(static_cast<double>(gradientX) * gradientX
+                    + static_cast<double>(gradientY) * gradientY) + 0.5);
+      }
+
+
+      template <class GradientType>
+      inline GradientType
+      sobelL2Norm(GradientType gradientX, GradientType gradientY,
+                  std::false_type /* isIntegral */)
+      {
+        return brick::common::squareRoot(
+          gradientX * gradientX + gradientY * gradientY);
+      }
+
+
+      template <class GradientType>
+      void
+      sobelMagnitudeRow(GradientType const* gradientXPtr,
+                        GradientType const* gradientYPtr,
+                        size_t columns, SobelNorm norm,
+                        GradientType* magnitudePtr)
+      {
+        if(norm == BRICK_SOBEL_L1_NORM) {
+          for(size_t column = 0; column < columns; ++column) {
+            magnitudePtr[column] = (
+              brick::common::absoluteValue(gradientXPtr[column])
+              + brick::common::absoluteValue(gradientYPtr[column]));
+          }
+        } else {
+          for(size_t column = 0; column < columns; ++column) {
+            magnitudePtr[column] = sobelL2Norm(
+              gradientXPtr[column], gradientYPtr[column],
+              typename std::is_integral<GradientType>::type());
+          }
+        }
+      }
+
+
+      // Quantizes gradient direction into equal angular bins.  The
+      // boundaries between bins that lie in the half plane Y >= 0
+      // are stored as unit vectors in m_upperBoundaries, and the
+      // remaining boundaries, rotated by pi, in m_lowerBoundaries.
+      // Within a half plane, a direction is past a boundary exactly
+      // when the 2D cross product of the boundary with the direction
+      // is non-negative, so the bin number is just a count of
+      // boundaries passed.
+      class SobelOrientationQuantizer {
+      public:
+
+        explicit
+        SobelOrientationQuantizer(unsigned int numberOfOrientations)
+          : m_numberOfOrientations(numberOfOrientations),
+            m_upperBoundaries(),
+            m_lowerBoundaries()
+        {
+          double const binWidth =
+            2.0 * brick::common::constants::pi / numberOfOrientations;
+          for(unsigned int ii = 0; ii < numberOfOrientations; ++ii) {
+            double angle = (ii + 0.5) * binWidth;
+            if(angle < brick::common::constants::pi) {
+              m_upperBoundaries.push_back(std::cos(angle));
+              m_upperBoundaries.push_back(std::sin(angle));
+            } else {
+              angle -= brick::common::constants::pi;
+              m_lowerBoundaries.push_back(std::cos(angle));
+              m_lowerBoundaries.push_back(std::sin(angle));
+            }
+          }
+        }
+
+
+        template <class GradientType>
+        brick::common::UInt8
+        operator()(GradientType gradientX, GradientType gradientY) const {
+          double xx = static_cast<double>(gradientX);
+          double yy = static_cast<double>(gradientY);
+          if(xx == 0.0 && yy == 0.0) {
+            return 0;
+          }
+
+          // Upper half plane includes the positive X axis, and
+          // the lower half plane includes the negative X axis.
+          unsigned int bin = 0;
+          std::vector<double> const* boundariesPtr = &m_upperBoundaries;
+          if(yy < 0.0 || (yy == 0.0 && xx < 0.0)) {
+            bin = m_upperBoundaries.size() / 2;
+            boundariesPtr = &m_lowerBoundaries;
+            xx = -xx;
+            yy = -yy;
+          }
+          std::vector<double> const& boundaries = *boundariesPtr;
+          for(size_t ii = 0; ii < boundaries.size(); ii += 2) {
+            bin += ((boundaries[ii] * yy - boundaries[ii + 1] * xx) >= 0.0);
+          }
+          return static_cast<brick::common::UInt8>(
+            (bin == m_numberOfOrientations) ? 0 : bin);
+        }
+
+      private:
+
+        unsigned int m_numberOfOrientations;
+        std::vector<double> m_upperBoundaries;
+        std::vector<double> m_lowerBoundaries;
+      };
+
+
+      // Shared implementation of all of the applySobel() overloads.
+      // Pointers magnitudePtr and orientationPtr may be null.
+      template <class GradientType, ImageFormat FORMAT>
+      void
+      applySobel(const Image<FORMAT>& inputImage,
+                 brick::numeric::Array2D<GradientType>& gradientX,
+                 brick::numeric::Array2D<GradientType>& gradientY,
+                 brick::numeric::Array2D<GradientType>* magnitudePtr,
+                 SobelNorm norm,
+                 brick::numeric::Array2D<brick::common::UInt8>* orientationPtr,
+                 unsigned int numberOfOrientations,
+                 unsigned int numberOfThreads)
+      {
+        typedef typename Image<FORMAT>::PixelType PixelType;
+
+        // Argument checking.
+        size_t const rows = inputImage.rows();
+        size_t const columns = inputImage.columns();
+        if(rows < 2 || columns < 2) {
+          BRICK_THROW(brick::common::ValueException, "applySobel()",
+                      "Argument inputImage must be 2x2 or larger.");
+        }
+        if(orientationPtr != 0
+           && (numberOfOrientations == 0 || numberOfOrientations > 256)) {
+          BRICK_THROW(brick::common::ValueException, "applySobel()",
+                      "Argument numberOfOrientations must be in the "
+                      "range [1, 256].");
+        }
+
+        // Make sure the output arrays are the right size, without
+        // disturbing any that already are.
+        if(gradientX.rows() != rows || gradientX.columns() != columns) {
+          gradientX.reinit(rows, columns);
+        }
+        if(gradientY.rows() != rows || gradientY.columns() != columns) {
+          gradientY.reinit(rows, columns);
+        }
+        if(magnitudePtr != 0
+           && (magnitudePtr->rows() != rows
+               || magnitudePtr->columns() != columns)) {
+          magnitudePtr->reinit(rows, columns);
+        }
+        if(orientationPtr != 0
+           && (orientationPtr->rows() != rows
+               || orientationPtr->columns() != columns)) {
+          orientationPtr->reinit(rows, columns);
+        }
+        SobelOrientationQuantizer quantizer(
+          orientationPtr != 0 ? numberOfOrientations : 1);
+
+        brick::common::parallelFor(
+          0, rows, numberOfThreads,
+          [&](size_t rowBegin, size_t rowEnd, size_t /* band */) {
+            for(size_t row = rowBegin; row < rowEnd; ++row) {
+              PixelType const* centerPtr = inputImage.data(row, 0);
+              GradientType* gradientXPtr = gradientX.data(row, 0);
+              GradientType* gradientYPtr = gradientY.data(row, 0);
+              if(row == 0) {
+                sobelBorderRow(centerPtr, centerPtr, inputImage.data(1, 0),
+                               columns, gradientXPtr, gradientYPtr);
+              } else if(row == rows - 1) {
+                sobelBorderRow(inputImage.data(row - 1, 0), centerPtr,
+                               centerPtr, columns, gradientXPtr, gradientYPtr);
+              } else {
+                sobelInteriorRow(inputImage.data(row - 1, 0), centerPtr,
+                                 inputImage.data(row + 1, 0), columns,
+                                 gradientXPtr, gradientYPtr);
+              }
+
+              if(magnitudePtr != 0) {
+                sobelMagnitudeRow(gradientXPtr, gradientYPtr, columns, norm,
+                                  magnitudePtr->data(row, 0));
+              }
+              if(orientationPtr != 0) {
+                brick::common::UInt8* binPtr = orientationPtr->data(row, 0);
+                for(size_t column = 0; column < columns; ++column) {
+                  binPtr[column] = quantizer(gradientXPtr[column],
+                                             gradientYPtr[column]);
+                }
+              }
+            }
+          });
+      }
+
+    } // namespace privateCode
+    /// @endcond
+
+
+    // This function applies the sobel edge operator in both the X
+    // and Y directions.
+    template <class GradientType, ImageFormat FORMAT>
+    void
+    applySobel(const Image<FORMAT>& inputImage,
+               brick::numeric::Array2D<GradientType>& gradientX,
+               brick::numeric::Array2D<GradientType>& gradientY,
+               unsigned int numberOfThreads)
+    {
+      privateCode::applySobel(
+        inputImage, gradientX, gradientY,
+        static_cast<brick::numeric::Array2D<GradientType>*>(0),
+        BRICK_SOBEL_L2_NORM,
+        static_cast<brick::numeric::Array2D<brick::common::UInt8>*>(0),
+        1, numberOfThreads);
+    }
+
+
+    // This function applies the sobel edge operator in both the X
+    // and Y directions, and computes gradient magnitude.
+    template <class GradientType, ImageFormat FORMAT>
+    void
+    applySobel(const Image<FORMAT>& inputImage,
+               brick::numeric::Array2D<GradientType>& gradientX,
+               brick::numeric::Array2D<GradientType>& gradientY,
+               brick::numeric::Array2D<GradientType>& magnitude,
+               SobelNorm norm,
+               unsigned int numberOfThreads)
+    {
+      privateCode::applySobel(inputImage, gradientX, gradientY,
+                              &magnitude, norm,
+                              static_cast<brick::numeric::Array2D<
+                                brick::common::UInt8>*>(0),
+                              1, numberOfThreads);
+    }
+
+
+    // This function applies the sobel edge operator in both the X
+    // and Y directions, and computes gradient magnitude and
+    // quantized orientation.
+    template <class GradientType, ImageFormat FORMAT>
+    void
+    applySobel(const Image<FORMAT>& inputImage,
+               brick::numeric::Array2D<GradientType>& gradientX,
+               brick::numeric::Array2D<GradientType>& gradientY,
+               brick::numeric::Array2D<GradientType>& magnitude,
+               brick::numeric::Array2D<brick::common::UInt8>& orientation,
+               unsigned int numberOfOrientations,
+               SobelNorm norm,
+               unsigned int numberOfThreads)
+    {
+      privateCode::applySobel(inputImage, gradientX, gradientY,
+                              &magnitude, norm, &orientation,
+                              numberOfOrientations, numberOfThreads);
+    }
+
+
   } // namespace computerVision
 
 } // namespace brick
@@ -0,0 +1,630 @@
+/**
+***************************************************************************
+* @file brick/computerVision/stereoMatcherBlock.cc
+*
+* Source file defining a class for computing dense disparity maps
+* from rectified stereo pairs.
+*
+* Copyright (C) 2026 David LaRose, dlr@cs.cmu.edu
+* See accompanying file, LICENSE.TXT, for details.
+*
+***************************************************************************
+*/
+
+#include <algorithm>
+#include <limits>
+#include <brick/common/exception.hh>
+#include <brick/common/parallelFor.hh>
+#include <brick/computerVision/stereoMatcherBlock.hh>
+
+namespace brick {
+
+  namespace computerVision {
+
+    /// @cond privateCode
+    namespace privateCode {
+
+      inline size_t
+      clampIndex(long index, size_t size)
+      {
+        if(index < 0) {
+          return 0;
+        }
+        if(static_cast<size_t>(index) >= size) {
+          return size - 1;
+        }
+        return static_cast<size_t>(index);
+      }
+
+
+      // Counts set bits without relying on compiler builtins.
+      inline brick::common::UInt32
+      countBits(brick::common::UInt32 value)
+      {
+        value = value - ((value >> 1) & 0x55555555u);
+        value = (value & 0x33333333u) + ((value >> 2) & 0x33333333u);
+        value = (value + (value >> 4)) & 0x0f0f0f0fu;
+        return (value * 0x01010101u) >> 24;
+      }
+
+
+      // One step of the SGM recursion along a path.  Argument
+      // previousPtr points to the path costs of the previous pixel
+      // along the path, or is null at the start of the path.  The
+      // new path costs are written to currentPtr and added to
+      // sumPtr, and their minimum is returned.
+      inline brick::common::UInt32
+      updatePathCosts(brick::common::UInt16 const* costPtr,
+                      brick::common::UInt32 const* previousPtr,
+                      brick::common::UInt32 previousMinimum,
+                      brick::common::UInt32 smallPenalty,
+                      brick::common::UInt32 largePenalty,
+                      size_t numberOfDisparities,
+                      brick::common::UInt32* currentPtr,
+                      brick::common::UInt32* sumPtr)
+      {
+        typedef brick::common::UInt32 CostType;
+        CostType minimum = std::numeric_limits<CostType>::max();
+        if(previousPtr == 0) {
+          for(size_t ii = 0; ii < numberOfDisparities; ++ii) {
+            currentPtr[ii] = costPtr[ii];
+            sumPtr[ii] += currentPtr[ii];
+            minimum = std::min(minimum, currentPtr[ii]);
+          }
+          return minimum;
+        }
+
+        // The first and last disparities have only one neighbor, and
+        // are handled outside the main loop so that it has no
+        // branches.
+        size_t const last = numberOfDisparities - 1;
+        CostType const jumpCost = previousMinimum + largePenalty;
+        CostType best = std::min(previousPtr[0], jumpCost);
+        if(last > 0) {
+          best = std::min(best, previousPtr[1] + smallPenalty);
+        }
+        currentPtr[0] = costPtr[0] + best - previousMinimum;
+        sumPtr[0] += currentPtr[0];
+        minimum = currentPtr[0];
+        for(size_t ii = 1; ii < last; ++ii) {
+          best = std::min(
+            std::min(previousPtr[ii], jumpCost),
+            std::min(previousPtr[ii - 1], previousPtr[ii + 1]) + smallPenalty);
+          currentPtr[ii] = costPtr[ii] + best - previousMinimum;
+          sumPtr[ii] += currentPtr[ii];
+          minimum = std::min(minimum, currentPtr[ii]);
+        }
+        if(last > 0) {
+          best = std::min(std::min(previousPtr[last], jumpCost),
+                          previousPtr[last - 1] + smallPenalty);
+          currentPtr[last] = costPtr[last] + best - previousMinimum;
+          sumPtr[last] += currentPtr[last];
+          minimum = std::min(minimum, currentPtr[last]);
+        }
+        return minimum;
+      }
+
+    } // namespace privateCode
+    /// @endcond
+
+
+    // The constructor specifies the search range and matching cost.
+    StereoMatcherBlock::
+    StereoMatcherBlock(unsigned int minimumDisparity,
+                       unsigned int numberOfDisparities,
+                       unsigned int blockRadius,
+                       StereoCost costType)
+      : m_blockRadius(blockRadius),
+        m_costType(costType),
+        m_isSubpixel(true),
+        m_largePenalty(0),
+        m_leftRightTolerance(1),
+        m_minimumDisparity(0),
+        m_numberOfDisparities(1),
+        m_numberOfPaths(0),
+        m_numberOfThreads(1),
+        m_smallPenalty(0)
+    {
+      this->setDisparityRange(minimumDisparity, numberOfDisparities);
+    }
+
+
+    // This member function computes a disparity map for a rectified
+    // stereo pair.
+    Image<GRAY_FLOAT32>
+    StereoMatcherBlock::
+    computeDisparity(Image<GRAY8> const& leftImage,
+                     Image<GRAY8> const& rightImage) const
+    {
+      size_t const rows = leftImage.rows();
+      size_t const columns = leftImage.columns();
+      if(rightImage.rows() != rows || rightImage.columns() != columns) {
+        BRICK_THROW(brick::common::ValueException,
+                    "StereoMatcherBlock::computeDisparity()",
+                    "Arguments leftImage and rightImage must have the "
+                    "same size.");
+      }
+      Image<GRAY_FLOAT32> disparityImage(rows, columns);
+      if(rows == 0 || columns == 0) {
+        return disparityImage;
+      }
+
+      brick::numeric::Array2D<brick::common::UInt32> leftPixels =
+        this->getPixelDescriptors(leftImage);
+      brick::numeric::Array2D<brick::common::UInt32> rightPixels =
+        this->getPixelDescriptors(rightImage);
+
+      if(m_numberOfPaths == 0) {
+        // Plain block matching needs only one row of summed costs at
+        // a time, so each band streams its rows independently.
+        brick::common::parallelFor(
+          0, rows, m_numberOfThreads,
+          [&](size_t rowBegin, size_t rowEnd, size_t /* band */) {
+            std::vector<brick::common::Int32> rightBest(columns);
+            this->computeBlockCosts(
+              leftPixels, rightPixels, rowBegin, rowEnd,
+              [&](size_t row, CostType const* costs) {
+                this->chooseDisparities(costs, columns, rightBest,
+                                        disparityImage.data(row, 0));
+              });
+          });
+        return disparityImage;
+      }
+
+      // SGM needs the full cost volume.  Summed costs are saturated
+      // to 16 bits to halve its size.
+      size_t const rowSize = columns * m_numberOfDisparities;
+      brick::numeric::Array2D<PixelCostType> costs(rows, rowSize);
+      brick::common::parallelFor(
+        0, rows, m_numberOfThreads,
+        [&](size_t rowBegin, size_t rowEnd, size_t /* band */) {
+          CostType const maximumCost =
+            std::numeric_limits<PixelCostType>::max();
+          this->computeBlockCosts(
+            leftPixels, rightPixels, rowBegin, rowEnd,
+            [&](size_t row, CostType const* blockCosts) {
+              PixelCostType* outputPtr = costs.data(row, 0);
+              for(size_t ii = 0; ii < rowSize; ++ii) {
+                outputPtr[ii] = static_cast<PixelCostType>(
+                  std::min(blockCosts[ii], maximumCost));
+              }
+            });
+        });
+
+      brick::numeric::Array2D<CostType> sums;
+      this->refineSemiGlobal(costs, rows, columns, sums);
+
+      brick::common::parallelFor(
+        0, rows, m_numberOfThreads,
+        [&](size_t rowBegin, size_t rowEnd, size_t /* band */) {
+          std::vector<brick::common::Int32> rightBest(columns);
+          for(size_t row = rowBegin; row < rowEnd; ++row) {
+            this->chooseDisparities(sums.data(row, 0), columns, rightBest,
+                                    disparityImage.data(row, 0));
+          }
+        });
+      return disparityImage;
+    }
+
+
+    // This member function changes the range of disparities to be
+    // searched.
+    void
+    StereoMatcherBlock::
+    setDisparityRange(unsigned int minimumDisparity,
+                      unsigned int numberOfDisparities)
+    {
+      if(numberOfDisparities == 0) {
+        BRICK_THROW(brick::common::ValueException,
+                    "StereoMatcherBlock::setDisparityRange()",
+                    "Argument numberOfDisparities must be at least 1.");
+      }
+      m_minimumDisparity = minimumDisparity;
+      m_numberOfDisparities = numberOfDisparities;
+    }
+
+
+    // This member function enables or disables semi-global
+    // matching.
+    void
+    StereoMatcherBlock::
+    setNumberOfPaths(unsigned int numberOfPaths)
+    {
+      if(numberOfPaths != 0 && numberOfPaths != 4 && numberOfPaths != 8) {
+        BRICK_THROW(brick::common::ValueException,
+                    "StereoMatcherBlock::setNumberOfPaths()",
+                    "Argument numberOfPaths must be 0, 4, or 8.");
+      }
+      m_numberOfPaths = numberOfPaths;
+    }
+
+
+    // ============== Private member functions below this line ==============
+
+    void
+    StereoMatcherBlock::
+    chooseDisparities(CostType const* costs, size_t columns,
+                      std::vector<brick::common::Int32>& rightBest,
+                      brick::common::Float32* outputPtr) const
+    {
+      long const numberOfDisparities = m_numberOfDisparities;
+      long const minimumDisparity = m_minimumDisparity;
+      long const numberOfColumns = static_cast<long>(columns);
+
+      // Winning disparity of each right image pixel, for the
+      // left-right check.  Right pixel x at disparity index ii
+      // corresponds to left pixel (x + minimumDisparity + ii).
+      if(m_leftRightTolerance >= 0) {
+        for(long xx = 0; xx < numberOfColumns; ++xx) {
+          long const maximumIndex = std::min(
+            numberOfDisparities, numberOfColumns - xx - minimumDisparity);
+          brick::common::Int32 bestIndex = -1;
+          CostType bestCost = std::numeric_limits<CostType>::max();
+          CostType const* costPtr =
+            costs + (xx + minimumDisparity) * numberOfDisparities;
+          for(long ii = 0; ii < maximumIndex; ++ii) {
+            if(*costPtr < bestCost) {
+              bestCost = *costPtr;
+              bestIndex = static_cast<brick::common::Int32>(ii);
+            }
+            costPtr += numberOfDisparities + 1;
+          }
+          rightBest[xx] = bestIndex;
+        }
+      }
+
+      for(long column = 0; column < numberOfColumns; ++column) {
+        outputPtr[column] = getInvalidDisparity();
+        long const firstMatch = column - minimumDisparity;
+        if(firstMatch < 0) {
+          continue;
+        }
+        long const numberOfCandidates =
+          std::min(numberOfDisparities, firstMatch + 1);
+        CostType const* costPtr = costs + column * numberOfDisparities;
+        long bestIndex = static_cast<long>(
+          std::min_element(costPtr, costPtr + numberOfCandidates) - costPtr);
+
+        if(m_leftRightTolerance >= 0) {
+          long const otherIndex = rightBest[firstMatch - bestIndex];
+          long const difference = otherIndex - bestIndex;
+          if(difference > m_leftRightTolerance
+             || -difference > m_leftRightTolerance) {
+            continue;
+          }
+        }
+
+        brick::common::Float32 disparity =
+          static_cast<brick::common::Float32>(minimumDisparity + bestIndex);
+        if(m_isSubpixel && bestIndex > 0
+           && bestIndex < numberOfCandidates - 1) {
+          double const previousCost = costPtr[bestIndex - 1];
+          double const bestCost = costPtr[bestIndex];
+          double const nextCost = costPtr[bestIndex + 1];
+          double const slope =
+            std::max(previousCost, nextCost) - bestCost;
+          if(slope > 0.0) {
+            disparity += static_cast<brick::common::Float32>(
+              (previousCost - nextCost) / (2.0 * slope));
+          }
+        }
+        outputPtr[column] = disparity;
+      }
+    }
+
+
+    template <class Functor>
+    void
+    StereoMatcherBlock::
+    computeBlockCosts(
+      brick::numeric::Array2D<brick::common::UInt32> const& leftPixels,
+      brick::numeric::Array2D<brick::common::UInt32> const& rightPixels,
+      size_t rowBegin, size_t rowEnd, Functor functor) const
+    {
+      size_t const rows = leftPixels.rows();
+      size_t const columns = leftPixels.columns();
+      size_t const numberOfDisparities = m_numberOfDisparities;
+      size_t const rowSize = columns * numberOfDisparities;
+      long const radius = static_cast<long>(m_blockRadius);
+      size_t const windowSize = 2 * m_blockRadius + 1;
+
+      // Per-pixel costs for each row of the current block window are
+      // kept in a ring buffer so that they can be subtracted from the
+      // column sums as the window slides down.  Window rows outside
+      // the image repeat the first or last image row.
+      std::vector<PixelCostType> ringBuffer(windowSize * rowSize);
+      std::vector<CostType> columnSums(rowSize, 0);
+      std::vector<CostType> blockSums(rowSize);
+      std::vector<CostType> runningSum(numberOfDisparities);
+
+      for(long offset = -radius; offset <= radius; ++offset) {
+        size_t const sourceRow =
+          privateCode::clampIndex(static_cast<long>(rowBegin) + offset, rows);
+        PixelCostType* slotPtr = &(ringBuffer[(offset + radius) * rowSize]);
+        this->computePixelCosts(leftPixels.data(sourceRow, 0),
+                                rightPixels.data(sourceRow, 0),
+                                columns, slotPtr);
+        for(size_t ii = 0; ii < rowSize; ++ii) {
+          columnSums[ii] += slotPtr[ii];
+        }
+      }
+
+      for(size_t row = rowBegin; row < rowEnd; ++row) {
+        if(row != rowBegin) {
+          // The ring buffer slot that held the row leaving the window
+          // is refilled with the row entering it.
+          size_t const slot = (row - rowBegin + windowSize - 1) % windowSize;
+          PixelCostType* slotPtr = &(ringBuffer[slot * rowSize]);
+          size_t const sourceRow = privateCode::clampIndex(
+            static_cast<long>(row) + radius, rows);
+          for(size_t ii = 0; ii < rowSize; ++ii) {
+            columnSums[ii] -= slotPtr[ii];
+          }
+          this->computePixelCosts(leftPixels.data(sourceRow, 0),
+                                  rightPixels.data(sourceRow, 0),
+                                  columns, slotPtr);
+          for(size_t ii = 0; ii < rowSize; ++ii) {
+            columnSums[ii] += slotPtr[ii];
+          }
+        }
+
+        if(radius == 0) {
+          functor(row, &(columnSums[0]));
+          continue;
+        }
+
+        // Slide the block horizontally, again repeating edge columns.
+        std::fill(runningSum.begin(), runningSum.end(), CostType(0));
+        for(long offset = -radius; offset <= radius; ++offset) {
+          CostType const* sumPtr = &(columnSums[
+              privateCode::clampIndex(offset, columns) * numberOfDisparities]);
+          for(size_t ii = 0; ii < numberOfDisparities; ++ii) {
+            runningSum[ii] += sumPtr[ii];
+          }
+        }
+        std::copy(runningSum.begin(), runningSum.end(), blockSums.begin());
+        for(long column = 1; column < static_cast<long>(columns); ++column) {
+          CostType const* enteringPtr = &(columnSums[
+              privateCode::clampIndex(column + radius, columns)
+              * numberOfDisparities]);
+          CostType const* leavingPtr = &(columnSums[
+              privateCode::clampIndex(column - radius - 1, columns)
+              * numberOfDisparities]);
+          CostType* outputPtr = &(blockSums[column * numberOfDisparities]);
+          for(size_t ii = 0; ii < numberOfDisparities; ++ii) {
+            runningSum[ii] += enteringPtr[ii] - leavingPtr[ii];
+            outputPtr[ii] = runningSum[ii];
+          }
+        }
+        functor(row, &(blockSums[0]));
+      }
+    }
+
+
+    void
+    StereoMatcherBlock::
+    computePixelCosts(brick::common::UInt32 const* leftPtr,
+                      brick::common::UInt32 const* rightPtr,
+                      size_t columns, PixelCostType* costPtr) const
+    {
+      long const numberOfDisparities = m_numberOfDisparities;
+      PixelCostType const maximumCost = this->getMaximumPixelCost();
+      for(long column = 0; column < static_cast<long>(columns); ++column) {
+        // Candidate ii compares against right image column
+        // (firstMatch - ii).  Candidates that fall off the left edge
+        // of the right image get the largest possible cost.
+        long const firstMatch = column - static_cast<long>(m_minimumDisparity);
+        long const numberOfCandidates = std::max(
+          0L, std::min(numberOfDisparities, firstMatch + 1));
+        brick::common::UInt32 const leftValue = leftPtr[column];
+        brick::common::UInt32 const* matchPtr = rightPtr + firstMatch;
+        PixelCostType* outputPtr = costPtr + column * numberOfDisparities;
+        if(m_costType == STEREO_COST_CENSUS) {
+          for(long ii = 0; ii < numberOfCandidates; ++ii) {
+            outputPtr[ii] = static_cast<PixelCostType>(
+              privateCode::countBits(leftValue ^ matchPtr[-ii]));
+          }
+        } else {
+          for(long ii = 0; ii < numberOfCandidates; ++ii) {
+            brick::common::Int32 difference =
+              static_cast<brick::common::Int32>(leftValue)
+              - static_cast<brick::common::Int32>(matchPtr[-ii]);
+            outputPtr[ii] = static_cast<PixelCostType>(
+              (difference < 0) ? -difference : difference);
+          }
+        }
+        for(long ii = numberOfCandidates; ii < numberOfDisparities; ++ii) {
+          outputPtr[ii] = maximumCost;
+        }
+      }
+    }
+
+
+    StereoMatcherBlock::PixelCostType
+    StereoMatcherBlock::
+    getMaximumPixelCost() const
+    {
+      return (m_costType == STEREO_COST_CENSUS) ? 24 : 255;
+    }
+
+
+    brick::numeric::Array2D<brick::common::UInt32>
+    StereoMatcherBlock::
+    getPixelDescriptors(Image<GRAY8> const& image) const
+    {
+      size_t const rows = image.rows();
+      size_t const columns = image.columns();
+      brick::numeric::Array2D<brick::common::UInt32> descriptors(
+        rows, columns);
+
+      if(m_costType != STEREO_COST_CENSUS) {
+        for(size_t row = 0; row < rows; ++row) {
+          brick::common::UInt8 const* inputPtr = image.data(row, 0);
+          brick::common::UInt32* outputPtr = descriptors.data(row, 0);
+          for(size_t column = 0; column < columns; ++column) {
+            outputPtr[column] = inputPtr[column];
+          }
+        }
+        return descriptors;
+      }
+
+      // 5x5 census transform.  Each of the 24 neighbors of a pixel
+      // contributes one bit, which is set if the neighbor is darker
+      // than the center.  Neighbors outside the image repeat the
+      // nearest edge pixel.
+      brick::common::parallelFor(
+        0, rows, m_numberOfThreads,
+        [&](size_t rowBegin, size_t rowEnd, size_t /* band */) {
+          std::vector<long> columnIndices(columns + 4);
+          for(size_t ii = 0; ii < columnIndices.size(); ++ii) {
+            columnIndices[ii] = privateCode::clampIndex(
+              static_cast<long>(ii) - 2, columns);
+          }
+          for(size_t row = rowBegin; row < rowEnd; ++row) {
+            brick::common::UInt8 const* rowPtrs[5];
+            for(long offset = -2; offset <= 2; ++offset) {
+              rowPtrs[offset + 2] = image.data(
+                privateCode::clampIndex(static_cast<long>(row) + offset,
+                                        rows), 0);
+            }
+            brick::common::UInt32* outputPtr = descriptors.data(row, 0);
+            for(size_t column = 0; column < columns; ++column) {
+              brick::common::UInt8 const center = rowPtrs[2][column];
+              brick::common::UInt32 bits = 0;
+              for(size_t ii = 0; ii < 5; ++ii) {
+                for(size_t jj = 0; jj < 5; ++jj) {
+                  if(ii == 2 && jj == 2) {
+                    continue;
+                  }
+                  bits = (bits << 1)
+                    | (rowPtrs[ii][columnIndices[column + jj]] < center);
+                }
+              }
+              outputPtr[column] = bits;
+            }
+          }
+        });
+      return descriptors;
+    }
+
+
+    void
+    StereoMatcherBlock::
+    refineSemiGlobal(brick::numeric::Array2D<PixelCostType> const& costs,
+                     size_t rows, size_t columns,
+                     brick::numeric::Array2D<CostType>& sums) const
+    {
+      size_t const numberOfDisparities = m_numberOfDisparities;
+      size_t const rowSize = columns * numberOfDisparities;
+
+      // Default penalties scale with the range of the block costs.
+      CostType const blockArea =
+        (2 * m_blockRadius + 1) * (2 * m_blockRadius + 1);
+      CostType const unitPenalty =
+        (m_costType == STEREO_COST_CENSUS) ? blockArea : 8 * blockArea;
+      CostType const smallPenalty =
+        (m_smallPenalty != 0) ? m_smallPenalty : unitPenalty;
+      CostType const largePenalty = std::max(
+        smallPenalty, (m_largePenalty != 0) ? m_largePenalty : 4 * unitPenalty);
+
+      sums.reinit(rows, rowSize);
+      sums = CostType(0);
+
+      // Horizontal paths are independent from row to row.
+      brick::common::parallelFor(
+        0, rows, m_numberOfThreads,
+        [&](size_t rowBegin, size_t rowEnd, size_t /* band */) {
+          std::vector<CostType> previous(numberOfDisparities);
+          std::vector<CostType> current(numberOfDisparities);
+          for(size_t row = rowBegin; row < rowEnd; ++row) {
+            PixelCostType const* costPtr = costs.data(row, 0);
+            CostType* sumPtr = sums.data(row, 0);
+
+            CostType minimum = 0;
+            for(size_t column = 0; column < columns; ++column) {
+              size_t const offset = column * numberOfDisparities;
+              minimum = privateCode::updatePathCosts(
+                costPtr + offset, (column == 0) ? 0 : &(previous[0]),
+                minimum, smallPenalty, largePenalty, numberOfDisparities,
+                &(current[0]), sumPtr + offset);
+              previous.swap(current);
+            }
+            for(size_t column = columns; column > 0; --column) {
+              size_t const offset = (column - 1) * numberOfDisparities;
+              minimum = privateCode::updatePathCosts(
+                costPtr + offset, (column == columns) ? 0 : &(previous[0]),
+                minimum, smallPenalty, largePenalty, numberOfDisparities,
+                &(current[0]), sumPtr + offset);
+              previous.swap(current);
+            }
+          }
+        });
+
+      // Vertical and diagonal paths each follow a line of pixels
+      // whose column changes by columnStep from one row to the next,
+      // so that (column + columnStep * step) is constant along the
+      // line.  Lines are independent of each other, so each thread
+      // takes a band of adjacent lines and sweeps it from one end of
+      // the image to the other, top to bottom and then bottom to
+      // top.  At each row, a band covers a contiguous run of
+      // columns.  This starts threads once per pass and direction,
+      // rather than once per row.  Different directions add into
+      // the same elements of sums, so they're handled one at a time.
+      long const numberOfDirections = (m_numberOfPaths == 8) ? 3 : 1;
+      long const firstDirection = (m_numberOfPaths == 8) ? -1 : 0;
+      long const numberOfRows = static_cast<long>(rows);
+      long const numberOfColumns = static_cast<long>(columns);
+      for(int pass = 0; pass < 2; ++pass) {
+        for(long direction = 0; direction < numberOfDirections;
+            ++direction) {
+          long const columnStep = firstDirection + direction;
+          long const lineBegin = std::min(0L, columnStep * (numberOfRows - 1));
+          long const lineEnd =
+            numberOfColumns + std::max(0L, columnStep * (numberOfRows - 1));
+          brick::common::parallelFor(
+            0, static_cast<size_t>(lineEnd - lineBegin), m_numberOfThreads,
+            [&](size_t bandBegin, size_t bandEnd, size_t /* band */) {
+              long const firstLine = lineBegin + static_cast<long>(bandBegin);
+              long const lastLine = lineBegin + static_cast<long>(bandEnd);
+              size_t const bandSize = bandEnd - bandBegin;
+              std::vector<CostType> previous(bandSize * numberOfDisparities);
+              std::vector<CostType> current(bandSize * numberOfDisparities);
+              std::vector<CostType> previousMinima(bandSize);
+              std::vector<CostType> currentMinima(bandSize);
+              for(long step = 0; step < numberOfRows; ++step) {
+                size_t const row = static_cast<size_t>(
+                  (pass == 0) ? step : numberOfRows - 1 - step);
+                PixelCostType const* costPtr = costs.data(row, 0);
+                CostType* sumPtr = sums.data(row, 0);
+                long const shift = columnStep * step;
+                long const columnBegin = std::max(0L, firstLine - shift);
+                long const columnEnd =
+                  std::min(numberOfColumns, lastLine - shift);
+                for(long column = columnBegin; column < columnEnd;
+                    ++column) {
+                  // Position of this pixel's line within the band.
+                  size_t const slot =
+                    static_cast<size_t>(column + shift - firstLine);
+                  long const previousColumn = column + columnStep;
+                  bool const isStart =
+                    (step == 0 || previousColumn < 0
+                     || previousColumn >= numberOfColumns);
+                  size_t const offset = column * numberOfDisparities;
+                  currentMinima[slot] = privateCode::updatePathCosts(
+                    costPtr + offset,
+                    isStart ? 0 : &(previous[slot * numberOfDisparities]),
+                    isStart ? 0 : previousMinima[slot],
+                    smallPenalty, largePenalty, numberOfDisparities,
+                    &(current[slot * numberOfDisparities]), sumPtr + offset);
+                }
+                previous.swap(current);
+                previousMinima.swap(currentMinima);
+              }
+            });
+        }
+      }
+    }
+
+  } // namespace computerVision
+
+} // namespace brick
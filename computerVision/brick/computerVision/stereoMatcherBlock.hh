@@ -0,0 +1,322 @@
+/**
+***************************************************************************
+* @file brick/computerVision/stereoMatcherBlock.hh
+*
+* Header file declaring a class for computing dense disparity maps
+* from rectified stereo pairs.
+*
+* Copyright (C) 2026 David LaRose, dlr@cs.cmu.edu
+* See accompanying file, LICENSE.TXT, for details.
+*
+***************************************************************************
+*/
+
+#ifndef BRICK_COMPUTERVISION_STEREOMATCHERBLOCK_HH
+#define BRICK_COMPUTERVISION_STEREOMATCHERBLOCK_HH
+
+#include <vector>
+#include <brick/common/types.hh>
+#include <brick/computerVision/image.hh>
+#include <brick/numeric/array2D.hh>
+
+namespace brick {
+
+  namespace computerVision {
+
+    /**
+     ** This enum specifies how StereoMatcherBlock compares pixels
+     ** between the left and right images.
+     **/
+    enum StereoCost {
+      /// Absolute difference of pixel intensities.  This is the
+      /// cheapest cost, but is sensitive to gain and bias differences
+      /// between the two cameras.
+      STEREO_COST_SAD,
+
+      /// Hamming distance between 5x5 census transforms.  This
+      /// depends only on the ordering of intensities within each 5x5
+      /// neighborhood, so it is robust to gain and bias differences.
+      STEREO_COST_CENSUS
+    };
+
+
+    /**
+     ** This class computes dense disparity maps from rectified stereo
+     ** pairs, such as those produced using stereoRectify().  The
+     ** matching cost of each pixel at each candidate disparity is
+     ** summed over a square block using running sums, so the cost per
+     ** disparity evaluation doesn't depend on block size.  The summed
+     ** costs can optionally be refined by semi-global matching
+     ** (SGM)[1] along 4 or 8 paths, which greatly reduces errors in
+     ** weakly textured regions.
+     **
+     ** Disparity follows the convention of getReprojectionMatrix():
+     ** a pixel at column u in the left image matches column (u - d)
+     ** in the right image, so d is positive for points in front of a
+     ** conventional left-right camera pair.  Disparities that fail a
+     ** left-right consistency check, or for which no candidate
+     ** disparity lies within the right image, are reported as
+     ** getInvalidDisparity().
+     **
+     ** Pixel costs, running sums, and path costs are all laid out
+     ** with disparity as the fastest varying index, so that inner
+     ** loops run over contiguous disparity candidates and can be
+     ** vectorized by the compiler.  Row bands (or, for SGM, rows and
+     ** columns) are distributed across threads using parallelFor().
+     **
+     ** Example usage:
+     **
+     ** @code
+     **   StereoMatcherBlock matcher(0, 64, 3, STEREO_COST_CENSUS);
+     **   matcher.setNumberOfPaths(8);
+     **   Image<GRAY_FLOAT32> disparity =
+     **     matcher.computeDisparity(leftImage, rightImage);
+     ** @endcode
+     **
+     ** [1] H. Hirschmuller, Stereo Processing by Semiglobal Matching
+     ** and Mutual Information.  IEEE Transactions on Pattern Analysis
+     ** and Machine Intelligence, 30(2), 2008.
+     **/
+    class StereoMatcherBlock {
+    public:
+
+      /**
+       * The constructor specifies the search range and the matching
+       * cost.  Other parameters take their default values, and can
+       * be changed using the set*() member functions.
+       *
+       * @param minimumDisparity This argument specifies the smallest
+       * disparity to be considered.
+       *
+       * @param numberOfDisparities This argument specifies how many
+       * disparities, starting with minimumDisparity, will be
+       * considered.  It must be at least 1.
+       *
+       * @param blockRadius This argument specifies the size of the
+       * block over which costs are summed.  The block is (2 *
+       * blockRadius + 1) pixels on a side.  Setting this to zero
+       * disables block summing, which is sometimes useful with SGM.
+       *
+       * @param costType This argument specifies how pixels are
+       * compared.
+       */
+      StereoMatcherBlock(unsigned int minimumDisparity = 0,
+                         unsigned int numberOfDisparities = 64,
+                         unsigned int blockRadius = 3,
+                         StereoCost costType = STEREO_COST_SAD);
+
+
+      /**
+       * This member function computes a disparity map for a
+       * rectified stereo pair.
+       *
+       * @param leftImage This argument is the left (reference) image.
+       *
+       * @param rightImage This argument is the right image.  It must
+       * have the same size as leftImage.
+       *
+       * @return The return value has the same size as leftImage, and
+       * contains the disparity of each left image pixel, or
+       * getInvalidDisparity() where no reliable disparity was found.
+       */
+      Image<GRAY_FLOAT32>
+      computeDisparity(Image<GRAY8> const& leftImage,
+                       Image<GRAY8> const& rightImage) const;
+
+
+      /**
+       * This member function returns the value used to mark pixels
+       * in the disparity map for which no disparity was found.
+       *
+       * @return The return value is -1.0.
+       */
+      static brick::common::Float32
+      getInvalidDisparity() {return -1.0f;}
+
+
+      /**
+       * This member function changes the size of the block over
+       * which costs are summed.  Please see the constructor
+       * documentation for details.
+       *
+       * @param blockRadius This argument specifies the new block
+       * radius.
+       */
+      void
+      setBlockRadius(unsigned int blockRadius) {m_blockRadius = blockRadius;}
+
+
+      /**
+       * This member function selects the matching cost.
+       *
+       * @param costType This argument specifies how pixels are
+       * compared.
+       */
+      void
+      setCostType(StereoCost costType) {m_costType = costType;}
+
+
+      /**
+       * This member function changes the range of disparities to be
+       * searched.
+       *
+       * @param minimumDisparity This argument specifies the smallest
+       * disparity to be considered.
+       *
+       * @param numberOfDisparities This argument specifies how many
+       * disparities will be considered.  It must be at least 1.
+       */
+      void
+      setDisparityRange(unsigned int minimumDisparity,
+                        unsigned int numberOfDisparities);
+
+
+      /**
+       * This member function sets the tolerance for the left-right
+       * consistency check.  The winning disparity of each left image
+       * pixel is compared with the winning disparity of the right
+       * image pixel it matches (computed from the same costs), and is
+       * discarded if the two differ by more than the tolerance.
+       *
+       * @param tolerance This argument specifies the largest allowable
+       * difference, in pixels.  Setting it to a negative number
+       * disables the check.  The default is 1.
+       */
+      void
+      setLeftRightTolerance(int tolerance) {m_leftRightTolerance = tolerance;}
+
+
+      /**
+       * This member function specifies how many threads should share
+       * the work.
+       *
+       * @param numberOfThreads This argument specifies the number of
+       * threads.  Setting it to zero uses one thread per available
+       * processor.  The default is 1.
+       */
+      void
+      setNumberOfThreads(unsigned int numberOfThreads) {
+        m_numberOfThreads = numberOfThreads;
+      }
+
+
+      /**
+       * This member function enables or disables semi-global
+       * matching.
+       *
+       * @param numberOfPaths This argument must be 0, 4, or 8.
+       * Setting it to 0 (the default) selects winner-take-all
+       * block matching.  Setting it to 4 aggregates along horizontal
+       * and vertical paths, and setting it to 8 adds diagonal paths.
+       */
+      void
+      setNumberOfPaths(unsigned int numberOfPaths);
+
+
+      /**
+       * This member function sets the SGM smoothness penalties.  It
+       * has no effect unless setNumberOfPaths() has been called with
+       * a nonzero argument.
+       *
+       * @param smallPenalty This argument specifies the penalty for
+       * disparity changes of one pixel between neighbors.  Setting it
+       * to zero chooses a default that scales with block area and
+       * cost type.
+       *
+       * @param largePenalty This argument specifies the penalty for
+       * larger disparity changes.  Setting it to zero chooses a
+       * default that scales with block area and cost type.  It is
+       * increased to smallPenalty if it is smaller.
+       */
+      void
+      setSmoothnessPenalties(brick::common::UInt32 smallPenalty,
+                             brick::common::UInt32 largePenalty) {
+        m_smallPenalty = smallPenalty;
+        m_largePenalty = largePenalty;
+      }
+
+
+      /**
+       * This member function enables or disables sub-pixel
+       * refinement, which fits a symmetric "V" (two lines of equal
+       * and opposite slope) to the costs of the winning disparity and
+       * its two neighbors.  This suits the roughly linear growth of
+       * SAD and census costs away from the minimum better than a
+       * parabola does.
+       *
+       * @param flag This argument should be true (the default) to
+       * enable refinement, or false to report integer disparities.
+       */
+      void
+      setSubpixel(bool flag) {m_isSubpixel = flag;}
+
+    private:
+
+      typedef brick::common::UInt16 PixelCostType;
+      typedef brick::common::UInt32 CostType;
+
+      // Finds the winning disparity of each pixel in one row of the
+      // left image, given costs laid out as costs[column *
+      // m_numberOfDisparities + disparityIndex], and writes the
+      // result to outputPtr.  Argument rightBest is scratch space.
+      void
+      chooseDisparities(CostType const* costs, size_t columns,
+                        std::vector<brick::common::Int32>& rightBest,
+                        brick::common::Float32* outputPtr) const;
+
+
+      // Computes block-summed costs for rows [rowBegin, rowEnd), and
+      // passes each row to functor(row, costs).
+      template <class Functor>
+      void
+      computeBlockCosts(brick::numeric::Array2D<brick::common::UInt32> const&
+                        leftPixels,
+                        brick::numeric::Array2D<brick::common::UInt32> const&
+                        rightPixels,
+                        size_t rowBegin, size_t rowEnd,
+                        Functor functor) const;
+
+
+      // Computes the per-pixel cost of every candidate disparity for
+      // one row.
+      void
+      computePixelCosts(brick::common::UInt32 const* leftPtr,
+                        brick::common::UInt32 const* rightPtr,
+                        size_t columns, PixelCostType* costPtr) const;
+
+
+      // Returns the largest possible per-pixel cost.
+      PixelCostType
+      getMaximumPixelCost() const;
+
+
+      // Converts an input image to the per-pixel representation used
+      // by computePixelCosts().
+      brick::numeric::Array2D<brick::common::UInt32>
+      getPixelDescriptors(Image<GRAY8> const& image) const;
+
+
+      // Runs semi-global matching over the block-summed costs.
+      void
+      refineSemiGlobal(brick::numeric::Array2D<PixelCostType> const& costs,
+                       size_t rows, size_t columns,
+                       brick::numeric::Array2D<CostType>& sums) const;
+
+
+      unsigned int m_blockRadius;
+      StereoCost m_costType;
+      bool m_isSubpixel;
+      brick::common::UInt32 m_largePenalty;
+      int m_leftRightTolerance;
+      unsigned int m_minimumDisparity;
+      unsigned int m_numberOfDisparities;
+      unsigned int m_numberOfPaths;
+      unsigned int m_numberOfThreads;
+      brick::common::UInt32 m_smallPenalty;
+    };
+
+  } // namespace computerVision
+
+} // namespace brick
+
+#endif /* #ifndef BRICK_COMPUTERVISION_STEREOMATCHERBLOCK_HH */
@@ -0,0 +1,312 @@
+/**
+***************************************************************************
+* @file brick/computerVision/templateMatcherNCC.hh
+*
+* Header file declaring a class template for locating a template
+* image within a larger image using normalized cross-correlation.
+*
+* Copyright (C) 2026 David LaRose, dlr@cs.cmu.edu
+* See accompanying file, LICENSE.TXT, for details.
+*
+***************************************************************************
+*/
+
+#ifndef BRICK_COMPUTERVISION_TEMPLATEMATCHERNCC_HH
+#define BRICK_COMPUTERVISION_TEMPLATEMATCHERNCC_HH
+
+#include <complex>
+#include <vector>
+#include <brick/computerVision/image.hh>
+#include <brick/numeric/array2D.hh>
+#include <brick/numeric/index2D.hh>
+
+namespace brick {
+
+  namespace computerVision {
+
+    /**
+     ** This enum specifies how TemplateMatcherNCC computes the
+     ** correlation between the template and the image.
+     **/
+    enum TemplateMatchMethod {
+      /// Choose whichever of the other methods is expected to be
+      /// faster, based on the sizes of the template and image.
+      TEMPLATE_MATCH_AUTO,
+
+      /// Correlate directly in the image domain.  This is faster for
+      /// small templates.
+      TEMPLATE_MATCH_DIRECT,
+
+      /// Correlate by multiplication in the frequency domain.  This
+      /// is faster for large templates.
+      TEMPLATE_MATCH_FFT
+    };
+
+
+    /**
+     ** This class template computes the normalized cross-correlation
+     ** (NCC) between a template image and every same-sized window of
+     ** a larger image.  Local image means and variances are computed
+     ** using summed-area tables (see numeric::BoxIntegrator2D), and
+     ** the correlation itself is computed either directly or using
+     ** the FFT, so the cost of each score is independent of the
+     ** number of template pixels for large templates.
+     **
+     ** Optionally, a mask can be supplied along with the template, in
+     ** which case only template pixels with nonzero mask values
+     ** contribute to the score.
+     **
+     ** Template argument FloatType specifies the type used for
+     ** computation, and should usually be double.  Images and
+     ** templates must have a single-channel (grayscale) format.
+     **
+     ** Example usage:
+     **
+     ** @code
+     **   TemplateMatcherNCC<double> matcher(templateImage);
+     **   double score;
+     **   brick::numeric::Index2D position =
+     **     matcher.findBestMatch(image, score);
+     ** @endcode
+     **/
+    template <class FloatType = double>
+    class TemplateMatcherNCC {
+    public:
+
+      /**
+       * The default constructor creates a matcher with an empty
+       * template.  Call setTemplate() before using it.
+       */
+      TemplateMatcherNCC();
+
+
+      /**
+       * This constructor sets the template to be matched.  It is
+       * equivalent to default construction followed by a call to
+       * setTemplate().
+       *
+       * @param templateImage This argument is the template to be
+       * matched.
+       */
+      template <ImageFormat Format>
+      explicit
+      TemplateMatcherNCC(Image<Format> const& templateImage);
+
+
+      /**
+       * This constructor sets a masked template.  It is equivalent
+       * to default construction followed by a call to setTemplate().
+       *
+       * @param templateImage This argument is the template to be
+       * matched.
+       *
+       * @param mask This argument must have the same size as
+       * templateImage.  Only template pixels at which the mask is
+       * nonzero contribute to the matching score.
+       */
+      template <ImageFormat Format>
+      TemplateMatcherNCC(Image<Format> const& templateImage,
+                         Image<GRAY8> const& mask);
+
+
+      /**
+       * This member function computes the NCC score of the template
+       * at every position where it fits entirely within the image.
+       * Scores range from -1 to 1.  Positions where the image (or the
+       * template) has zero variance, so that NCC is undefined, get a
+       * score of 0.
+       *
+       * @param image This argument is the image to be searched.  It
+       * must be at least as large as the template.
+       *
+       * @param method This argument specifies whether to compute the
+       * correlation directly or using the FFT.
+       *
+       * @param numberOfThreads This argument specifies how many
+       * threads should share the work.  Setting it to zero uses one
+       * thread per available processor.
+       *
+       * @return The return value has (image.rows() - templateRows +
+       * 1) rows and (image.columns() - templateColumns + 1) columns.
+       * Element (row, column) is the score of the template with its
+       * upper left corner at pixel (row, column) of the image.
+       */
+      template <ImageFormat Format>
+      brick::numeric::Array2D<FloatType>
+      computeScoreMap(Image<Format> const& image,
+                      TemplateMatchMethod method = TEMPLATE_MATCH_AUTO,
+                      unsigned int numberOfThreads = 1) const;
+
+
+      /**
+       * This member function finds the position at which the
+       * template best matches the image using a coarse-to-fine
+       * search.  The image and template are repeatedly subsampled by
+       * a factor of two, a full score map is computed at the coarsest
+       * level, and the best match is then refined at each finer
+       * level by searching only a small neighborhood around the
+       * position predicted by the previous level.  This is much
+       * faster than computeScoreMap() for large images, but can miss
+       * the true best match if the template contains only fine
+       * detail that doesn't survive subsampling.
+       *
+       * @param image This argument is the image to be searched.  It
+       * must be at least as large as the template.
+       *
+       * @param score This argument returns the NCC score of the best
+       * match.
+       *
+       * @param numberOfLevels This argument specifies how many
+       * pyramid levels to use.  Setting it to 1 computes the full
+       * score map at the original resolution.  Setting it to 0
+       * chooses as many levels as possible while keeping the
+       * subsampled template at least 8 pixels on a side.
+       *
+       * @param searchRadius This argument specifies how far from the
+       * predicted position, in pixels, to search at each finer level.
+       *
+       * @param numberOfThreads This argument specifies how many
+       * threads should share the work.  Setting it to zero uses one
+       * thread per available processor.
+       *
+       * @return The return value is the position of the upper left
+       * corner of the template at the best match.
+       */
+      template <ImageFormat Format>
+      brick::numeric::Index2D
+      findBestMatch(Image<Format> const& image, FloatType& score,
+                    unsigned int numberOfLevels = 0,
+                    unsigned int searchRadius = 2,
+                    unsigned int numberOfThreads = 1) const;
+
+
+      /**
+       * This member function returns the number of columns in the
+       * template.
+       *
+       * @return The return value is the template width.
+       */
+      size_t
+      getTemplateColumns() const;
+
+
+      /**
+       * This member function returns the number of rows in the
+       * template.
+       *
+       * @return The return value is the template height.
+       */
+      size_t
+      getTemplateRows() const;
+
+
+      /**
+       * This member function sets the template to be matched.
+       *
+       * @param templateImage This argument is the template to be
+       * matched.
+       */
+      template <ImageFormat Format>
+      void
+      setTemplate(Image<Format> const& templateImage);
+
+
+      /**
+       * This member function sets a masked template.
+       *
+       * @param templateImage This argument is the template to be
+       * matched.
+       *
+       * @param mask This argument must have the same size as
+       * templateImage.  Only template pixels at which the mask is
+       * nonzero contribute to the matching score.
+       */
+      template <ImageFormat Format>
+      void
+      setTemplate(Image<Format> const& templateImage,
+                  Image<GRAY8> const& mask);
+
+    private:
+
+      typedef std::complex<FloatType> ComplexType;
+
+      // Precomputed template data for one level of the pyramid.
+      struct Level {
+        // Mask-weighted template with the (weighted) mean removed.
+        brick::numeric::Array2D<FloatType> zeroMeanTemplate;
+
+        // Per-pixel weights, all ones if there's no mask.
+        brick::numeric::Array2D<FloatType> mask;
+
+        // Sum of mask weights.
+        FloatType maskSum;
+
+        // Square root of the weighted template variance (times
+        // maskSum).
+        FloatType templateNorm;
+      };
+
+
+      // Computes the score for every position at which the template
+      // of the specified level fits within image.
+      void
+      computeScores(brick::numeric::Array2D<FloatType> const& image,
+                    Level const& level,
+                    TemplateMatchMethod method,
+                    unsigned int numberOfThreads,
+                    brick::numeric::Array2D<FloatType>& scores) const;
+
+
+      // Computes the valid correlation result(row, column) =
+      // sum(kernel(i, j) * image(row + i, column + j)).
+      void
+      correlateDirect(brick::numeric::Array2D<FloatType> const& image,
+                      brick::numeric::Array2D<FloatType> const& kernel,
+                      unsigned int numberOfThreads,
+                      brick::numeric::Array2D<FloatType>& result) const;
+
+
+      // Frequency domain version of correlateDirect().  Argument
+      // imageSpectrum is the output of privateCode::fft2DGetSpectrum()
+      // for the image.
+      void
+      correlateFFT(brick::numeric::Array2D<ComplexType> const& imageSpectrum,
+                   brick::numeric::Array2D<FloatType> const& kernel,
+                   size_t resultRows, size_t resultColumns,
+                   unsigned int numberOfThreads,
+                   brick::numeric::Array2D<FloatType>& result) const;
+
+
+      // Sets up m_levels, starting with the full resolution
+      // template.
+      void
+      setLevels(brick::numeric::Array2D<FloatType> const& templateArray,
+                brick::numeric::Array2D<FloatType> const& mask);
+
+
+      // Returns the mask-weighted 2x2 average of the input.  An
+      // empty mask weights all pixels equally.
+      brick::numeric::Array2D<FloatType>
+      subsample(brick::numeric::Array2D<FloatType> const& input,
+                brick::numeric::Array2D<FloatType> const& mask) const;
+
+
+      template <ImageFormat Format>
+      brick::numeric::Array2D<FloatType>
+      toArray(Image<Format> const& image) const;
+
+
+      std::vector<Level> m_levels;
+      bool m_isMasked;
+    };
+
+  } // namespace computerVision
+
+} // namespace brick
+
+
+// Include file containing definitions of inline and template
+// functions.
+#include <brick/computerVision/templateMatcherNCC_impl.hh>
+
+#endif /* #ifndef BRICK_COMPUTERVISION_TEMPLATEMATCHERNCC_HH */
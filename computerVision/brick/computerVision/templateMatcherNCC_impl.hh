@@ -0,0 +1,615 @@
+/**
+***************************************************************************
+* @file brick/computerVision/templateMatcherNCC_impl.hh
+*
+* Header file defining inline and template functions declared in
+* templateMatcherNCC.hh.
+*
+* Copyright (C) 2026 David LaRose, dlr@cs.cmu.edu
+* See accompanying file, LICENSE.TXT, for details.
+*
+***************************************************************************
+*/
+
+#ifndef BRICK_COMPUTERVISION_TEMPLATEMATCHERNCC_IMPL_HH
+#define BRICK_COMPUTERVISION_TEMPLATEMATCHERNCC_IMPL_HH
+
+// This file is included by templateMatcherNCC.hh, and should not be
+// directly included by user code, so no need to include
+// templateMatcherNCC.hh here.
+//
+// #include <brick/computerVision/templateMatcherNCC.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <brick/common/exception.hh>
+#include <brick/common/parallelFor.hh>
+#include <brick/common/types.hh>
+#include <brick/computerVision/fft2D.hh>
+#include <brick/numeric/boxIntegrator2D.hh>
+
+namespace brick {
+
+  namespace computerVision {
+
+    /// @cond privateCode
+    namespace privateCode {
+
+      // Functor used with BoxIntegrator2D to sum squared pixel values.
+      template <class FloatType>
+      struct TemplateMatcherSquareFunctor {
+        brick::common::Float64
+        operator()(FloatType const& value) const {
+          return static_cast<brick::common::Float64>(value) * value;
+        }
+      };
+
+
+    } // namespace privateCode
+    /// @endcond
+
+
+    // The default constructor creates a matcher with an empty
+    // template.
+    template <class FloatType>
+    TemplateMatcherNCC<FloatType>::
+    TemplateMatcherNCC()
+      : m_levels(),
+        m_isMasked(false)
+    {
+      // Empty.
+    }
+
+
+    // This constructor sets the template to be matched.
+    template <class FloatType>
+    template <ImageFormat Format>
+    TemplateMatcherNCC<FloatType>::
+    TemplateMatcherNCC(Image<Format> const& templateImage)
+      : m_levels(),
+        m_isMasked(false)
+    {
+      this->setTemplate(templateImage);
+    }
+
+
+    // This constructor sets a masked template.
+    template <class FloatType>
+    template <ImageFormat Format>
+    TemplateMatcherNCC<FloatType>::
+    TemplateMatcherNCC(Image<Format> const& templateImage,
+                       Image<GRAY8> const& mask)
+      : m_levels(),
+        m_isMasked(false)
+    {
+      this->setTemplate(templateImage, mask);
+    }
+
+
+    // This member function computes the NCC score of the template at
+    // every position where it fits entirely within the image.
+    template <class FloatType>
+    template <ImageFormat Format>
+    brick::numeric::Array2D<FloatType>
+    TemplateMatcherNCC<FloatType>::
+    computeScoreMap(Image<Format> const& image,
+                    TemplateMatchMethod method,
+                    unsigned int numberOfThreads) const
+    {
+      if(m_levels.empty()) {
+        BRICK_THROW(brick::common::StateException,
+                    "TemplateMatcherNCC::computeScoreMap()",
+                    "Template has not been set.");
+      }
+      if(image.rows() < this->getTemplateRows()
+         || image.columns() < this->getTemplateColumns()) {
+        BRICK_THROW(brick::common::ValueException,
+                    "TemplateMatcherNCC::computeScoreMap()",
+                    "Image must be at least as large as the template.");
+      }
+      brick::numeric::Array2D<FloatType> scores;
+      this->computeScores(this->toArray(image), m_levels[0], method,
+                          numberOfThreads, scores);
+      return scores;
+    }
+
+
+    // This member function finds the position at which the template
+    // best matches the image using a coarse-to-fine search.
+    template <class FloatType>
+    template <ImageFormat Format>
+    brick::numeric::Index2D
+    TemplateMatcherNCC<FloatType>::
+    findBestMatch(Image<Format> const& image, FloatType& score,
+                  unsigned int numberOfLevels,
+                  unsigned int searchRadius,
+                  unsigned int numberOfThreads) const
+    {
+      if(m_levels.empty()) {
+        BRICK_THROW(brick::common::StateException,
+                    "TemplateMatcherNCC::findBestMatch()",
+                    "Template has not been set.");
+      }
+      if(image.rows() < this->getTemplateRows()
+         || image.columns() < this->getTemplateColumns()) {
+        BRICK_THROW(brick::common::ValueException,
+                    "TemplateMatcherNCC::findBestMatch()",
+                    "Image must be at least as large as the template.");
+      }
+
+      // Decide how many pyramid levels to use.
+      std::size_t levelCount = 1;
+      if(numberOfLevels == 0) {
+        while(levelCount < m_levels.size()
+              && m_levels[levelCount].zeroMeanTemplate.rows() >= 8
+              && m_levels[levelCount].zeroMeanTemplate.columns() >= 8) {
+          ++levelCount;
+        }
+      } else {
+        levelCount = std::min(static_cast<std::size_t>(numberOfLevels),
+                              m_levels.size());
+      }
+
+      // Build the image pyramid.  Since the image is at least as big
+      // as the template, each subsampled image is at least as big as
+      // the corresponding subsampled template.
+      std::vector< brick::numeric::Array2D<FloatType> > pyramid(levelCount);
+      pyramid[0] = this->toArray(image);
+      brick::numeric::Array2D<FloatType> noMask;
+      for(std::size_t level = 1; level < levelCount; ++level) {
+        pyramid[level] = this->subsample(pyramid[level - 1], noMask);
+      }
+
+      // Exhaustive search at the coarsest level.
+      brick::numeric::Array2D<FloatType> scores;
+      this->computeScores(pyramid[levelCount - 1], m_levels[levelCount - 1],
+                          TEMPLATE_MATCH_AUTO, numberOfThreads, scores);
+      std::size_t bestIndex = static_cast<std::size_t>(
+        std::max_element(scores.begin(), scores.end()) - scores.begin());
+      int bestRow = static_cast<int>(bestIndex / scores.columns());
+      int bestColumn = static_cast<int>(bestIndex % scores.columns());
+      score = scores[bestIndex];
+
+      // Refine at each finer level, searching only near the position
+      // predicted by the previous level.
+      int radius = static_cast<int>(searchRadius);
+      for(std::size_t level = levelCount - 1; level > 0; --level) {
+        brick::numeric::Array2D<FloatType> const& fineImage =
+          pyramid[level - 1];
+        Level const& fineLevel = m_levels[level - 1];
+        int templateRows =
+          static_cast<int>(fineLevel.zeroMeanTemplate.rows());
+        int templateColumns =
+          static_cast<int>(fineLevel.zeroMeanTemplate.columns());
+        int lastRow = static_cast<int>(fineImage.rows()) - templateRows;
+        int lastColumn =
+          static_cast<int>(fineImage.columns()) - templateColumns;
+
+        int row0 = std::max(std::min(2 * bestRow - radius, lastRow), 0);
+        int row1 = std::min(2 * bestRow + 1 + radius, lastRow);
+        int column0 =
+          std::max(std::min(2 * bestColumn - radius, lastColumn), 0);
+        int column1 = std::min(2 * bestColumn + 1 + radius, lastColumn);
+
+        // Copy out just the part of the image that the search
+        // window touches.
+        brick::numeric::Array2D<FloatType> window(
+          row1 - row0 + templateRows, column1 - column0 + templateColumns);
+        for(std::size_t row = 0; row < window.rows(); ++row) {
+          std::copy(fineImage.data(row + row0, column0),
+                    fineImage.data(row + row0, column0) + window.columns(),
+                    window.data(row, 0));
+        }
+
+        this->computeScores(window, fineLevel, TEMPLATE_MATCH_DIRECT,
+                            numberOfThreads, scores);
+        bestIndex = static_cast<std::size_t>(
+          std::max_element(scores.begin(), scores.end()) - scores.begin());
+        bestRow = row0 + static_cast<int>(bestIndex / scores.columns());
+        bestColumn = column0 + static_cast<int>(bestIndex % scores.columns());
+        score = scores[bestIndex];
+      }
+      return brick::numeric::Index2D(bestRow, bestColumn);
+    }
+
+
+    // This member function returns the number of columns in the
+    // template.
+    template <class FloatType>
+    size_t
+    TemplateMatcherNCC<FloatType>::
+    getTemplateColumns() const
+    {
+      return m_levels.empty() ? 0 : m_levels[0].zeroMeanTemplate.columns();
+    }
+
+
+    // This member function returns the number of rows in the
+    // template.
+    template <class FloatType>
+    size_t
+    TemplateMatcherNCC<FloatType>::
+    getTemplateRows() const
+    {
+      return m_levels.empty() ? 0 : m_levels[0].zeroMeanTemplate.rows();
+    }
+
+
+    // This member function sets the template to be matched.
+    template <class FloatType>
+    template <ImageFormat Format>
+    void
+    TemplateMatcherNCC<FloatType>::
+    setTemplate(Image<Format> const& templateImage)
+    {
+      brick::numeric::Array2D<FloatType> mask(
+        templateImage.rows(), templateImage.columns());
+      mask = FloatType(1);
+      m_isMasked = false;
+      this->setLevels(this->toArray(templateImage), mask);
+    }
+
+
+    // This member function sets a masked template.
+    template <class FloatType>
+    template <ImageFormat Format>
+    void
+    TemplateMatcherNCC<FloatType>::
+    setTemplate(Image<Format> const& templateImage,
+                Image<GRAY8> const& mask)
+    {
+      if(mask.rows() != templateImage.rows()
+         || mask.columns() != templateImage.columns()) {
+        BRICK_THROW(brick::common::ValueException,
+                    "TemplateMatcherNCC::setTemplate()",
+                    "Mask must have the same size as the template.");
+      }
+      brick::numeric::Array2D<FloatType> weights(mask.rows(), mask.columns());
+      for(std::size_t ii = 0; ii < mask.size(); ++ii) {
+        weights[ii] = (mask[ii] != 0) ? FloatType(1) : FloatType(0);
+      }
+      m_isMasked = true;
+      this->setLevels(this->toArray(templateImage), weights);
+    }
+
+
+    template <class FloatType>
+    void
+    TemplateMatcherNCC<FloatType>::
+    computeScores(brick::numeric::Array2D<FloatType> const& inputImage,
+                  Level const& level,
+                  TemplateMatchMethod method,
+                  unsigned int numberOfThreads,
+                  brick::numeric::Array2D<FloatType>& scores) const
+    {
+      std::size_t const templateRows = level.zeroMeanTemplate.rows();
+      std::size_t const templateColumns = level.zeroMeanTemplate.columns();
+      std::size_t const outputRows = inputImage.rows() - templateRows + 1;
+      std::size_t const outputColumns =
+        inputImage.columns() - templateColumns + 1;
+
+      // NCC doesn't depend on the image mean, so remove it.  This
+      // keeps the intermediate sums small, which reduces roundoff
+      // error when computing local variances.
+      brick::numeric::Array2D<FloatType> image(
+        inputImage.rows(), inputImage.columns());
+      brick::common::Float64 imageMean = 0.0;
+      for(std::size_t ii = 0; ii < inputImage.size(); ++ii) {
+        imageMean += inputImage[ii];
+      }
+      imageMean /= inputImage.size();
+      for(std::size_t ii = 0; ii < inputImage.size(); ++ii) {
+        image[ii] = static_cast<FloatType>(inputImage[ii] - imageMean);
+      }
+
+      // Pick a method by estimating the cost of each.
+      if(method == TEMPLATE_MATCH_AUTO) {
+        std::size_t nonzeroCount = 0;
+        for(std::size_t ii = 0; ii < level.mask.size(); ++ii) {
+          if(level.mask[ii] != FloatType(0)) {
+            ++nonzeroCount;
+          }
+        }
+        std::size_t numberOfCorrelations = m_isMasked ? 3 : 1;
+        double directCost = (double(outputRows) * double(outputColumns)
+                             * double(nonzeroCount) * numberOfCorrelations);
+        double numberOfTransforms =
+          m_isMasked ? (2.0 + 2.0 * numberOfCorrelations) : 3.0;
+        double fftCost = numberOfTransforms * privateCode::fft2DTransformCost(
+          inputImage.rows(), inputImage.columns());
+        method = (fftCost < directCost) ? TEMPLATE_MATCH_FFT
+          : TEMPLATE_MATCH_DIRECT;
+      }
+
+      // Correlate with the template.  If there's a mask, also
+      // compute the local (weighted) sums of pixel values and squared
+      // pixel values.
+      brick::numeric::Array2D<FloatType> numerator;
+      brick::numeric::Array2D<FloatType> localSums;
+      brick::numeric::Array2D<FloatType> localSquaredSums;
+      brick::numeric::Array2D<FloatType> squaredImage;
+      if(m_isMasked) {
+        squaredImage.reinit(image.rows(), image.columns());
+        for(std::size_t ii = 0; ii < image.size(); ++ii) {
+          squaredImage[ii] = image[ii] * image[ii];
+        }
+      }
+      if(method == TEMPLATE_MATCH_FFT) {
+        std::size_t paddedRows =
+          privateCode::fft2DNextPowerOfTwo(image.rows());
+        std::size_t paddedColumns =
+          privateCode::fft2DNextPowerOfTwo(image.columns());
+        brick::numeric::Array2D<ComplexType> imageSpectrum =
+          privateCode::fft2DGetSpectrum<ComplexType>(
+            image, paddedRows, paddedColumns, numberOfThreads);
+        this->correlateFFT(imageSpectrum, level.zeroMeanTemplate,
+                           outputRows, outputColumns, numberOfThreads,
+                           numerator);
+        if(m_isMasked) {
+          this->correlateFFT(imageSpectrum, level.mask,
+                             outputRows, outputColumns, numberOfThreads,
+                             localSums);
+          imageSpectrum = privateCode::fft2DGetSpectrum<ComplexType>(
+            squaredImage, paddedRows, paddedColumns, numberOfThreads);
+          this->correlateFFT(imageSpectrum, level.mask,
+                             outputRows, outputColumns, numberOfThreads,
+                             localSquaredSums);
+        }
+      } else {
+        this->correlateDirect(image, level.zeroMeanTemplate,
+                              numberOfThreads, numerator);
+        if(m_isMasked) {
+          this->correlateDirect(image, level.mask, numberOfThreads,
+                                localSums);
+          this->correlateDirect(squaredImage, level.mask, numberOfThreads,
+                                localSquaredSums);
+        }
+      }
+
+      // Without a mask, the local sums come from summed area tables.
+      typedef brick::numeric::BoxIntegrator2D<
+        FloatType, brick::common::Float64> Integrator;
+      Integrator sumIntegrator;
+      Integrator squaredSumIntegrator;
+      if(!m_isMasked) {
+        sumIntegrator.setArray(image);
+        squaredSumIntegrator.setArray(
+          image, privateCode::TemplateMatcherSquareFunctor<FloatType>());
+      }
+
+      // Combine everything into normalized scores.  The integrators
+      // are only read from here on, so all threads share them.
+      // Copying them would touch their (non-atomic) reference counts.
+      scores.reinit(outputRows, outputColumns);
+      FloatType const relativeThreshold =
+        std::sqrt(std::numeric_limits<FloatType>::epsilon());
+      FloatType const maskSum = level.maskSum;
+      FloatType const templateNorm = level.templateNorm;
+      bool const isMasked = m_isMasked;
+      Integrator const& constSumIntegrator = sumIntegrator;
+      Integrator const& constSquaredSumIntegrator = squaredSumIntegrator;
+      brick::common::parallelFor(
+        0, outputRows, numberOfThreads,
+        [&](std::size_t rowBegin, std::size_t rowEnd, std::size_t) {
+          for(std::size_t row = rowBegin; row < rowEnd; ++row) {
+            for(std::size_t column = 0; column < outputColumns; ++column) {
+              FloatType sum;
+              FloatType squaredSum;
+              if(isMasked) {
+                sum = localSums(row, column);
+                squaredSum = localSquaredSums(row, column);
+              } else {
+                brick::numeric::Index2D corner0(
+                  static_cast<int>(row), static_cast<int>(column));
+                brick::numeric::Index2D corner1(
+                  static_cast<int>(row + templateRows),
+                  static_cast<int>(column + templateColumns));
+                sum = static_cast<FloatType>(
+                  constSumIntegrator.getIntegral(corner0, corner1));
+                squaredSum = static_cast<FloatType>(
+                  constSquaredSumIntegrator.getIntegral(corner0, corner1));
+              }
+              FloatType variance = squaredSum - sum * sum / maskSum;
+              FloatType& score = scores(row, column);
+              if(templateNorm <= FloatType(0)
+                 || variance <= relativeThreshold * squaredSum) {
+                score = FloatType(0);
+              } else {
+                score = numerator(row, column)
+                  / (templateNorm * std::sqrt(variance));
+                score = std::max(FloatType(-1), std::min(FloatType(1), score));
+              }
+            }
+          }
+        });
+    }
+
+
+    template <class FloatType>
+    void
+    TemplateMatcherNCC<FloatType>::
+    correlateDirect(brick::numeric::Array2D<FloatType> const& image,
+                    brick::numeric::Array2D<FloatType> const& kernel,
+                    unsigned int numberOfThreads,
+                    brick::numeric::Array2D<FloatType>& result) const
+    {
+      std::size_t const outputRows = image.rows() - kernel.rows() + 1;
+      std::size_t const outputColumns = image.columns() - kernel.columns() + 1;
+      result.reinit(outputRows, outputColumns);
+      result = FloatType(0);
+
+      // Each output row accumulates one scaled, shifted image row per
+      // kernel element.  The inner loop is a simple multiply-add over
+      // contiguous memory, which the compiler can vectorize.
+      brick::common::parallelFor(
+        0, outputRows, numberOfThreads,
+        [&](std::size_t rowBegin, std::size_t rowEnd, std::size_t) {
+          for(std::size_t row = rowBegin; row < rowEnd; ++row) {
+            FloatType* outputPtr = result.data(row, 0);
+            for(std::size_t ii = 0; ii < kernel.rows(); ++ii) {
+              FloatType const* kernelPtr = kernel.data(ii, 0);
+              for(std::size_t jj = 0; jj < kernel.columns(); ++jj) {
+                FloatType const weight = kernelPtr[jj];
+                if(weight == FloatType(0)) {
+                  continue;
+                }
+                FloatType const* inputPtr = image.data(row + ii, jj);
+                for(std::size_t column = 0; column < outputColumns;
+                    ++column) {
+                  outputPtr[column] += weight * inputPtr[column];
+                }
+              }
+            }
+          }
+        });
+    }
+
+
+    template <class FloatType>
+    void
+    TemplateMatcherNCC<FloatType>::
+    correlateFFT(brick::numeric::Array2D<ComplexType> const& imageSpectrum,
+                 brick::numeric::Array2D<FloatType> const& kernel,
+                 size_t resultRows, size_t resultColumns,
+                 unsigned int numberOfThreads,
+                 brick::numeric::Array2D<FloatType>& result) const
+    {
+      // Correlation is multiplication by the complex conjugate in
+      // the frequency domain.  We compute the inverse transform as
+      // conj(FFT(conj(X))) / N, and since we only need the real part
+      // of the result, the outer conj() can be skipped.
+      brick::numeric::Array2D<ComplexType> product =
+        privateCode::fft2DGetSpectrum<ComplexType>(
+          kernel, imageSpectrum.rows(), imageSpectrum.columns(),
+          numberOfThreads);
+      for(std::size_t ii = 0; ii < product.size(); ++ii) {
+        product[ii] *= std::conj(imageSpectrum[ii]);
+      }
+      privateCode::fft2DTransform(product, numberOfThreads);
+
+      FloatType const scale = FloatType(1) / FloatType(product.size());
+      result.reinit(resultRows, resultColumns);
+      for(std::size_t row = 0; row < resultRows; ++row) {
+        for(std::size_t column = 0; column < resultColumns; ++column) {
+          result(row, column) = product(row, column).real() * scale;
+        }
+      }
+    }
+
+
+    template <class FloatType>
+    void
+    TemplateMatcherNCC<FloatType>::
+    setLevels(brick::numeric::Array2D<FloatType> const& templateArray,
+              brick::numeric::Array2D<FloatType> const& mask)
+    {
+      m_levels.clear();
+      if(templateArray.size() == 0) {
+        BRICK_THROW(brick::common::ValueException,
+                    "TemplateMatcherNCC::setTemplate()",
+                    "Template must not be empty.");
+      }
+
+      brick::numeric::Array2D<FloatType> currentTemplate = templateArray;
+      brick::numeric::Array2D<FloatType> currentMask = mask;
+      while(true) {
+        Level level;
+        brick::common::Float64 maskSum = 0.0;
+        brick::common::Float64 weightedSum = 0.0;
+        for(std::size_t ii = 0; ii < currentTemplate.size(); ++ii) {
+          maskSum += currentMask[ii];
+          weightedSum += currentMask[ii] * currentTemplate[ii];
+        }
+        if(maskSum <= 0.0) {
+          if(m_levels.empty()) {
+            BRICK_THROW(brick::common::ValueException,
+                        "TemplateMatcherNCC::setTemplate()",
+                        "Mask must have at least one nonzero pixel.");
+          }
+          break;
+        }
+        brick::common::Float64 mean = weightedSum / maskSum;
+        brick::common::Float64 sumOfSquares = 0.0;
+        level.zeroMeanTemplate.reinit(
+          currentTemplate.rows(), currentTemplate.columns());
+        for(std::size_t ii = 0; ii < currentTemplate.size(); ++ii) {
+          brick::common::Float64 difference = currentTemplate[ii] - mean;
+          level.zeroMeanTemplate[ii] =
+            static_cast<FloatType>(currentMask[ii] * difference);
+          sumOfSquares += currentMask[ii] * difference * difference;
+        }
+        level.mask = currentMask;
+        level.maskSum = static_cast<FloatType>(maskSum);
+        level.templateNorm = static_cast<FloatType>(std::sqrt(sumOfSquares));
+        m_levels.push_back(level);
+
+        if(std::min(currentTemplate.rows(), currentTemplate.columns()) < 8) {
+          break;
+        }
+        brick::numeric::Array2D<FloatType> nextTemplate =
+          this->subsample(currentTemplate, currentMask);
+        brick::numeric::Array2D<FloatType> noMask;
+        currentMask = this->subsample(currentMask, noMask);
+        currentTemplate = nextTemplate;
+      }
+    }
+
+
+    template <class FloatType>
+    brick::numeric::Array2D<FloatType>
+    TemplateMatcherNCC<FloatType>::
+    subsample(brick::numeric::Array2D<FloatType> const& input,
+              brick::numeric::Array2D<FloatType> const& mask) const
+    {
+      brick::numeric::Array2D<FloatType> result(
+        input.rows() / 2, input.columns() / 2);
+      for(std::size_t row = 0; row < result.rows(); ++row) {
+        FloatType const* inputPtr0 = input.data(2 * row, 0);
+        FloatType const* inputPtr1 = input.data(2 * row + 1, 0);
+        FloatType* outputPtr = result.data(row, 0);
+        if(mask.size() == 0) {
+          for(std::size_t column = 0; column < result.columns(); ++column) {
+            outputPtr[column] = FloatType(0.25) * (
+              inputPtr0[2 * column] + inputPtr0[2 * column + 1]
+              + inputPtr1[2 * column] + inputPtr1[2 * column + 1]);
+          }
+        } else {
+          FloatType const* maskPtr0 = mask.data(2 * row, 0);
+          FloatType const* maskPtr1 = mask.data(2 * row + 1, 0);
+          for(std::size_t column = 0; column < result.columns(); ++column) {
+            FloatType weight = (maskPtr0[2 * column] + maskPtr0[2 * column + 1]
+                                + maskPtr1[2 * column]
+                                + maskPtr1[2 * column + 1]);
+            FloatType sum = (
+              maskPtr0[2 * column] * inputPtr0[2 * column]
+              + maskPtr0[2 * column + 1] * inputPtr0[2 * column + 1]
+              + maskPtr1[2 * column] * inputPtr1[2 * column]
+              + maskPtr1[2 * column + 1] * inputPtr1[2 * column + 1]);
+            outputPtr[column] =
+              (weight > FloatType(0)) ? sum / weight : FloatType(0);
+          }
+        }
+      }
+      return result;
+    }
+
+
+    template <class FloatType>
+    template <ImageFormat Format>
+    brick::numeric::Array2D<FloatType>
+    TemplateMatcherNCC<FloatType>::
+    toArray(Image<Format> const& image) const
+    {
+      brick::numeric::Array2D<FloatType> result(image.rows(), image.columns());
+      for(std::size_t ii = 0; ii < image.size(); ++ii) {
+        result[ii] = static_cast<FloatType>(image[ii]);
+      }
+      return result;
+    }
+
+  } // namespace computerVision
+
+} // namespace brick
+
+#endif /* #ifndef BRICK_COMPUTERVISION_TEMPLATEMATCHERNCC_IMPL_HH */
@@ -0,0 +1,480 @@
+/**
+***************************************************************************
+* @file calibrationObjectiveMultiViewTest.cc
+*
+* Source file defining tests for the CalibrationObjectiveMultiView
+* class template.
+*
+* Copyright (C) 2026 David LaRose, dlr@cs.cmu.edu
+* See accompanying file, LICENSE.TXT, for details.
+*
+***************************************************************************
+**/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <vector>
+#include <brick/computerVision/calibrationObjectiveMultiView.hh>
+#include <brick/computerVision/cameraIntrinsicsPlumbBob.hh>
+#include <brick/computerVision/cameraIntrinsicsRational.hh>
+#include <brick/numeric/rotations.hh>
+#include <brick/optimization/gradientFunctionLM.hh>
+#include <brick/test/testFixture.hh>
+
+using namespace brick::common;
+using namespace brick::computerVision;
+using namespace brick::numeric;
+using namespace brick::optimization;
+using namespace brick::test;
+
+namespace {
+
+  // Exposes the residual vector of a CalibrationObjectiveMultiView
+  // instance so that GradientFunctionLM can differentiate it
+  // numerically.
+  template <class Intrinsics>
+  class ResidualFunctor
+    : public std::unary_function<Array1D<double>, Array1D<double> > {
+  public:
+    ResidualFunctor(CalibrationObjectiveMultiView<Intrinsics> const& objective)
+      : m_objective(objective) {}
+
+    Array1D<double>
+    operator()(Array1D<double> const& theta) {
+      return m_objective.computeResiduals(theta);
+    }
+
+  private:
+    CalibrationObjectiveMultiView<Intrinsics> m_objective;
+  };
+
+} // namespace
+
+
+class CalibrationObjectiveMultiViewTest
+  : public TestFixture<CalibrationObjectiveMultiViewTest> {
+
+public:
+
+  CalibrationObjectiveMultiViewTest();
+  ~CalibrationObjectiveMultiViewTest() {}
+
+  void setUp(const std::string& /* testName */) {}
+  void tearDown(const std::string& /* testName */) {}
+
+  // Tests.
+  void testComputeGradientAndHessianPlumbBob();
+  void testComputeGradientAndHessianRational();
+  void testComputeResiduals();
+  void testGetParameters();
+  void testNumberOfThreads();
+  void testExecutionTime();
+
+private:
+
+  template <class Intrinsics>
+  void
+  checkGradientAndHessian(Intrinsics const& intrinsics);
+
+  template <class Intrinsics>
+  CalibrationObjectiveMultiView<Intrinsics>
+  getObjective(Intrinsics const& intrinsics,
+               std::vector< Transform3D<double> >& cameraTworldVector,
+               std::size_t numberOfViews, std::size_t gridSize,
+               unsigned int numberOfThreads);
+
+  CameraIntrinsicsPlumbBob<double>
+  getIntrinsicsPlumbBob();
+
+  CameraIntrinsicsRational<double>
+  getIntrinsicsRational();
+
+  Array1D<double>
+  getPerturbedParameters(Array1D<double> const& theta);
+
+  double m_defaultTolerance;
+  double m_gradientTolerance;
+
+}; // class CalibrationObjectiveMultiViewTest
+
+
+/* ============== Member Function Definititions ============== */
+
+CalibrationObjectiveMultiViewTest::
+CalibrationObjectiveMultiViewTest()
+  : TestFixture<CalibrationObjectiveMultiViewTest>(
+      "CalibrationObjectiveMultiViewTest"),
+    m_defaultTolerance(1.0E-10),
+    m_gradientTolerance(1.0E-4)
+{
+  BRICK_TEST_REGISTER_MEMBER(testComputeGradientAndHessianPlumbBob);
+  BRICK_TEST_REGISTER_MEMBER(testComputeGradientAndHessianRational);
+  BRICK_TEST_REGISTER_MEMBER(testComputeResiduals);
+  BRICK_TEST_REGISTER_MEMBER(testGetParameters);
+  BRICK_TEST_REGISTER_MEMBER(testNumberOfThreads);
+  // BRICK_TEST_REGISTER_MEMBER(testExecutionTime);
+}
+
+
+void
+CalibrationObjectiveMultiViewTest::
+testComputeGradientAndHessianPlumbBob()
+{
+  CameraIntrinsicsPlumbBob<double> intrinsics = this->getIntrinsicsPlumbBob();
+  this->checkGradientAndHessian(intrinsics);
+  intrinsics.allowSkew(false);
+  intrinsics.allowSixthOrderRadial(false);
+  this->checkGradientAndHessian(intrinsics);
+}
+
+
+void
+CalibrationObjectiveMultiViewTest::
+testComputeGradientAndHessianRational()
+{
+  this->checkGradientAndHessian(this->getIntrinsicsRational());
+}
+
+
+void
+CalibrationObjectiveMultiViewTest::
+testComputeResiduals()
+{
+  CameraIntrinsicsRational<double> intrinsics = this->getIntrinsicsRational();
+  std::vector< Transform3D<double> > cameraTworldVector;
+  CalibrationObjectiveMultiView< CameraIntrinsicsRational<double> >
+    objective = this->getObjective(intrinsics, cameraTworldVector, 4, 5, 1);
+  BRICK_TEST_ASSERT(objective.getNumberOfViews() == 4);
+  BRICK_TEST_ASSERT(objective.getNumberOfResiduals() == 4 * 5 * 5 * 2);
+
+  // At the true parameters, the synthetic data projects perfectly.
+  Array1D<double> theta =
+    objective.getParameters(intrinsics, cameraTworldVector);
+  Array1D<double> residuals = objective.computeResiduals(theta);
+  BRICK_TEST_ASSERT(residuals.size() == objective.getNumberOfResiduals());
+  for(std::size_t ii = 0; ii < residuals.size(); ++ii) {
+    BRICK_TEST_ASSERT(std::fabs(residuals[ii]) < m_defaultTolerance);
+  }
+
+  // Away from the true parameters, operator()() should report the
+  // sum of squared residuals.
+  theta = this->getPerturbedParameters(theta);
+  residuals = objective.computeResiduals(theta);
+  double sumOfSquares = 0.0;
+  for(std::size_t ii = 0; ii < residuals.size(); ++ii) {
+    sumOfSquares += residuals[ii] * residuals[ii];
+  }
+  BRICK_TEST_ASSERT(sumOfSquares > 1.0);
+  BRICK_TEST_ASSERT(
+    approximatelyEqual(objective(theta), sumOfSquares,
+                       m_defaultTolerance * sumOfSquares));
+}
+
+
+void
+CalibrationObjectiveMultiViewTest::
+testGetParameters()
+{
+  CameraIntrinsicsPlumbBob<double> intrinsics = this->getIntrinsicsPlumbBob();
+  std::vector< Transform3D<double> > cameraTworldVector;
+  CalibrationObjectiveMultiView< CameraIntrinsicsPlumbBob<double> >
+    objective = this->getObjective(intrinsics, cameraTworldVector, 3, 4, 1);
+
+  Array1D<double> theta =
+    objective.getParameters(intrinsics, cameraTworldVector);
+  BRICK_TEST_ASSERT(theta.size() == objective.getNumberOfParameters());
+  BRICK_TEST_ASSERT(theta.size() == intrinsics.getParameters().size() + 3 * 7);
+
+  // Quaternion scale shouldn't matter.
+  for(std::size_t ii = 0; ii < 4; ++ii) {
+    theta[intrinsics.getParameters().size() + 7 + ii] *= 3.0;
+  }
+
+  CameraIntrinsicsPlumbBob<double> recoveredIntrinsics;
+  std::vector< Transform3D<double> > recoveredCameraTworldVector;
+  objective.getCalibration(
+    theta, recoveredIntrinsics, recoveredCameraTworldVector);
+  BRICK_TEST_ASSERT(recoveredIntrinsics.getNumPixelsX()
+                    == intrinsics.getNumPixelsX());
+  BRICK_TEST_ASSERT(recoveredIntrinsics.getNumPixelsY()
+                    == intrinsics.getNumPixelsY());
+  Array1D<double> referenceParameters = intrinsics.getParameters();
+  Array1D<double> recoveredParameters = recoveredIntrinsics.getParameters();
+  BRICK_TEST_ASSERT(recoveredParameters.size() == referenceParameters.size());
+  for(std::size_t ii = 0; ii < referenceParameters.size(); ++ii) {
+    BRICK_TEST_ASSERT(
+      approximatelyEqual(recoveredParameters[ii], referenceParameters[ii],
+                         m_defaultTolerance));
+  }
+  BRICK_TEST_ASSERT(recoveredCameraTworldVector.size()
+                    == cameraTworldVector.size());
+  for(std::size_t viewIndex = 0; viewIndex < cameraTworldVector.size();
+      ++viewIndex) {
+    for(std::size_t row = 0; row < 4; ++row) {
+      for(std::size_t column = 0; column < 4; ++column) {
+        BRICK_TEST_ASSERT(
+          approximatelyEqual(
+            recoveredCameraTworldVector[viewIndex](row, column),
+            cameraTworldVector[viewIndex](row, column), m_defaultTolerance));
+      }
+    }
+  }
+
+  // Mismatched pose count should be rejected.
+  cameraTworldVector.pop_back();
+  BRICK_TEST_ASSERT_EXCEPTION(
+    ValueException, objective.getParameters(intrinsics, cameraTworldVector));
+}
+
+
+void
+CalibrationObjectiveMultiViewTest::
+testNumberOfThreads()
+{
+  CameraIntrinsicsRational<double> intrinsics = this->getIntrinsicsRational();
+  std::vector< Transform3D<double> > cameraTworldVector;
+  CalibrationObjectiveMultiView< CameraIntrinsicsRational<double> >
+    objective = this->getObjective(intrinsics, cameraTworldVector, 11, 6, 1);
+  Array1D<double> theta = this->getPerturbedParameters(
+    objective.getParameters(intrinsics, cameraTworldVector));
+
+  Array1D<double> referenceGradient;
+  Array2D<double> referenceHessian;
+  objective.computeGradientAndHessian(
+    theta, referenceGradient, referenceHessian);
+  double referenceError = objective(theta);
+
+  for(unsigned int numberOfThreads = 2; numberOfThreads < 5;
+      ++numberOfThreads) {
+    objective.setNumberOfThreads(numberOfThreads);
+
+    // Residuals are computed independently, so the error should be
+    // identical.
+    BRICK_TEST_ASSERT(objective(theta) == referenceError);
+
+    // The intrinsic blocks are summed in a different order, so
+    // allow for rounding.
+    Array1D<double> gradient;
+    Array2D<double> hessian;
+    objective.computeGradientAndHessian(theta, gradient, hessian);
+    BRICK_TEST_ASSERT(gradient.size() == referenceGradient.size());
+    BRICK_TEST_ASSERT(hessian.rows() == referenceHessian.rows());
+    BRICK_TEST_ASSERT(hessian.columns() == referenceHessian.columns());
+    for(std::size_t ii = 0; ii < gradient.size(); ++ii) {
+      BRICK_TEST_ASSERT(
+        std::fabs(gradient[ii] - referenceGradient[ii])
+        <= m_defaultTolerance * (1.0 + std::fabs(referenceGradient[ii])));
+    }
+    for(std::size_t ii = 0; ii < hessian.size(); ++ii) {
+      BRICK_TEST_ASSERT(
+        std::fabs(hessian[ii] - referenceHessian[ii])
+        <= m_defaultTolerance * (1.0 + std::fabs(referenceHessian[ii])));
+    }
+  }
+}
+
+
+void
+CalibrationObjectiveMultiViewTest::
+testExecutionTime()
+{
+  // Calibrating a rational camera from many views of a 10x10
+  // target.  Numerical differentiation (as done by
+  // GradientFunctionLM) costs O(views^2) per iteration, so it is
+  // only timed for the smaller problem.
+  std::size_t const gridSize = 10;
+  std::size_t const numberOfRepetitions = 5;
+  for(std::size_t numberOfViews = 20; numberOfViews <= 200;
+      numberOfViews *= 10) {
+    CameraIntrinsicsRational<double> intrinsics =
+      this->getIntrinsicsRational();
+    std::vector< Transform3D<double> > cameraTworldVector;
+    CalibrationObjectiveMultiView< CameraIntrinsicsRational<double> >
+      objective = this->getObjective(
+        intrinsics, cameraTworldVector, numberOfViews, gridSize, 1);
+    Array1D<double> theta = this->getPerturbedParameters(
+      objective.getParameters(intrinsics, cameraTworldVector));
+    Array1D<double> gradient;
+    Array2D<double> hessian;
+
+    std::cout << "\n" << numberOfViews << " views, "
+              << gridSize * gridSize << " points each:" << std::endl;
+    if(numberOfViews <= 20) {
+      typedef ResidualFunctor< CameraIntrinsicsRational<double> > Residuals;
+      GradientFunctionLM<Residuals, double> gradientFunction(
+        (Residuals(objective)));
+      auto startTime = std::chrono::steady_clock::now();
+      gradientFunction.computeGradientAndHessian(theta, gradient, hessian);
+      auto stopTime = std::chrono::steady_clock::now();
+      std::cout << "  numeric:              "
+                << std::chrono::duration<double>(
+                  stopTime - startTime).count() * 1000.0
+                << " ms" << std::endl;
+    }
+
+    for(unsigned int numberOfThreads = 1; numberOfThreads <= 4;
+        numberOfThreads *= 2) {
+      objective.setNumberOfThreads(numberOfThreads);
+      auto startTime = std::chrono::steady_clock::now();
+      for(std::size_t ii = 0; ii < numberOfRepetitions; ++ii) {
+        objective.computeGradientAndHessian(theta, gradient, hessian);
+      }
+      auto stopTime = std::chrono::steady_clock::now();
+      std::cout << "  analytic, " << numberOfThreads << " thread(s): "
+                << std::chrono::duration<double>(
+                  stopTime - startTime).count() * 1000.0
+                   / numberOfRepetitions
+                << " ms" << std::endl;
+    }
+  }
+}
+
+
+template <class Intrinsics>
+void
+CalibrationObjectiveMultiViewTest::
+checkGradientAndHessian(Intrinsics const& intrinsics)
+{
+  std::vector< Transform3D<double> > cameraTworldVector;
+  CalibrationObjectiveMultiView<Intrinsics> objective =
+    this->getObjective(intrinsics, cameraTworldVector, 5, 6, 1);
+  Array1D<double> theta = this->getPerturbedParameters(
+    objective.getParameters(intrinsics, cameraTworldVector));
+
+  Array1D<double> gradient;
+  Array2D<double> hessian;
+  objective.computeGradientAndHessian(theta, gradient, hessian);
+
+  Array1D<double> referenceGradient;
+  Array2D<double> referenceHessian;
+  GradientFunctionLM<ResidualFunctor<Intrinsics>, double> gradientFunction(
+    (ResidualFunctor<Intrinsics>(objective)));
+  gradientFunction.computeGradientAndHessian(
+    theta, referenceGradient, referenceHessian);
+
+  BRICK_TEST_ASSERT(gradient.size() == theta.size());
+  BRICK_TEST_ASSERT(hessian.rows() == theta.size());
+  BRICK_TEST_ASSERT(hessian.columns() == theta.size());
+
+  // Scale tolerances to the largest element, since many elements
+  // are nearly zero.
+  double gradientScale = 0.0;
+  for(std::size_t ii = 0; ii < referenceGradient.size(); ++ii) {
+    gradientScale = std::max(gradientScale, std::fabs(referenceGradient[ii]));
+  }
+  double hessianScale = 0.0;
+  for(std::size_t ii = 0; ii < referenceHessian.size(); ++ii) {
+    hessianScale = std::max(hessianScale, std::fabs(referenceHessian[ii]));
+  }
+  for(std::size_t ii = 0; ii < gradient.size(); ++ii) {
+    BRICK_TEST_ASSERT(
+      std::fabs(gradient[ii] - referenceGradient[ii])
+      <= m_gradientTolerance * gradientScale);
+  }
+  for(std::size_t ii = 0; ii < hessian.size(); ++ii) {
+    BRICK_TEST_ASSERT(
+      std::fabs(hessian[ii] - referenceHessian[ii])
+      <= m_gradientTolerance * hessianScale);
+  }
+}
+
+
+template <class Intrinsics>
+CalibrationObjectiveMultiView<Intrinsics>
+CalibrationObjectiveMultiViewTest::
+getObjective(Intrinsics const& intrinsics,
+             std::vector< Transform3D<double> >& cameraTworldVector,
+             std::size_t numberOfViews, std::size_t gridSize,
+             unsigned int numberOfThreads)
+{
+  // A planar target with 5cm squares.
+  std::vector< Vector3D<double> > points3D;
+  for(std::size_t row = 0; row < gridSize; ++row) {
+    for(std::size_t column = 0; column < gridSize; ++column) {
+      points3D.push_back(Vector3D<double>(0.05 * column, 0.05 * row, 0.0));
+    }
+  }
+  double const targetCenter = 0.025 * (gridSize - 1);
+
+  // Views from a variety of angles, each roughly centered on the
+  // target.
+  CalibrationObjectiveMultiView<Intrinsics> objective(
+    intrinsics, numberOfThreads);
+  cameraTworldVector.clear();
+  for(std::size_t viewIndex = 0; viewIndex < numberOfViews; ++viewIndex) {
+    double phase = 2.0 * viewIndex;
+    Transform3D<double> cameraTworld = rollPitchYawToTransform3D(
+      Vector3D<double>(0.4 * std::sin(phase), 0.4 * std::cos(1.3 * phase),
+                       0.3 * std::sin(0.7 * phase)));
+    Vector3D<double> rotatedCenter =
+      cameraTworld * Vector3D<double>(targetCenter, targetCenter, 0.0);
+    cameraTworld.setValue(0, 3, -rotatedCenter.x() + 0.05 * std::cos(phase));
+    cameraTworld.setValue(1, 3, -rotatedCenter.y() + 0.05 * std::sin(phase));
+    cameraTworld.setValue(2, 3, -rotatedCenter.z() + 0.6 + 0.1 * (viewIndex % 3));
+    cameraTworldVector.push_back(cameraTworld);
+
+    std::vector< Vector2D<double> > points2D;
+    for(std::size_t ii = 0; ii < points3D.size(); ++ii) {
+      points2D.push_back(intrinsics.project(cameraTworld * points3D[ii]));
+    }
+    objective.addView(points3D.begin(), points3D.end(), points2D.begin());
+  }
+  return objective;
+}
+
+
+CameraIntrinsicsPlumbBob<double>
+CalibrationObjectiveMultiViewTest::
+getIntrinsicsPlumbBob()
+{
+  return CameraIntrinsicsPlumbBob<double>(
+    640, 480, 500.0, 510.0, 320.0, 240.0, 0.001,
+    -0.2, 0.05, 0.001, -0.001, 0.0005);
+}
+
+
+CameraIntrinsicsRational<double>
+CalibrationObjectiveMultiViewTest::
+getIntrinsicsRational()
+{
+  return CameraIntrinsicsRational<double>(
+    640, 480, 500.0, 510.0, 320.0, 240.0,
+    -0.2, 0.05, 0.001, 0.02, 0.003, 0.0001, -0.001, 0.0005);
+}
+
+
+Array1D<double>
+CalibrationObjectiveMultiViewTest::
+getPerturbedParameters(Array1D<double> const& theta)
+{
+  // Small deterministic perturbations, proportional to each
+  // parameter's size.
+  Array1D<double> result = theta.copy();
+  for(std::size_t ii = 0; ii < result.size(); ++ii) {
+    result[ii] += 0.01 * std::sin(3.0 * ii + 1.0) * (std::fabs(theta[ii]) + 0.01);
+  }
+  return result;
+}
+
+
+#if 0
+
+int main(int argc, char** argv)
+{
+  CalibrationObjectiveMultiViewTest currentTest;
+  bool result = currentTest.run();
+  return (result ? 0 : 1);
+}
+
+#else
+
+namespace {
+
+  CalibrationObjectiveMultiViewTest currentTest;
+
+}
+
+#endif
@@ -11,6 +11,8 @@
 **/
 
 
+#include <cmath>
+#include <vector>
 #include <brick/common/functional.hh>
 #include <brick/computerVision/calibrationTools.hh>
 #include <brick/computerVision/cameraIntrinsicsPinhole.hh>
@@ -46,6 +48,7 @@ public:
   void testEstimateCameraIntrinsicsPinhole();
   void testEstimateCameraParameters();
   void testEstimateCameraParametersConstrained();
+  void testEstimateCameraParametersMultiView();
   void testEstimateCameraParametersPinhole();
   void testEstimateTransform3DTo2D();
   void testEstimateProjectedAreaAndCentroid();
@@ -111,6 +114,7 @@ CalibrationToolsTest()
   BRICK_TEST_REGISTER_MEMBER(testEstimateCameraIntrinsicsPinhole);
   BRICK_TEST_REGISTER_MEMBER(testEstimateCameraParameters);
   BRICK_TEST_REGISTER_MEMBER(testEstimateCameraParametersConstrained);
+  BRICK_TEST_REGISTER_MEMBER(testEstimateCameraParametersMultiView);
   BRICK_TEST_REGISTER_MEMBER(testEstimateCameraParametersPinhole);
   BRICK_TEST_REGISTER_MEMBER(testEstimateTransform3DTo2D);
   BRICK_TEST_REGISTER_MEMBER(testEstimateProjectedAreaAndCentroid);
@@ -357,6 +361,93 @@ testEstimateCameraParametersConstrained()
 }
 
 
+void
+CalibrationToolsTest::
+testEstimateCameraParametersMultiView()
+{
+  CameraIntrinsicsPlumbBob<double> referenceIntrinsics(
+    640, 480, 500.0, 510.0, 320.0, 240.0, 0.001,
+    -0.2, 0.05, 0.001, -0.001, 0.0005);
+
+  // A planar target seen from several angles.
+  std::vector< Vector3D<double> > targetPoints;
+  for(double yCoord = 0.0; yCoord < 0.39; yCoord += 0.05) {
+    for(double xCoord = 0.0; xCoord < 0.49; xCoord += 0.05) {
+      targetPoints.push_back(Vector3D<double>(xCoord, yCoord, 0.0));
+    }
+  }
+  std::size_t const numberOfViews = 8;
+  std::vector< std::vector< Vector3D<double> > > points3DVector;
+  std::vector< std::vector< Vector2D<double> > > points2DVector;
+  std::vector< Transform3D<double> > referenceCameraTworldVector;
+  std::vector< Transform3D<double> > cameraTworldVector;
+  for(std::size_t viewIndex = 0; viewIndex < numberOfViews; ++viewIndex) {
+    double phase = 0.8 * viewIndex;
+    Transform3D<double> cameraTworld = rollPitchYawToTransform3D(
+      Vector3D<double>(0.5 * std::sin(phase), 0.5 * std::cos(phase),
+                       0.2 * std::sin(2.0 * phase)));
+    Vector3D<double> center = cameraTworld * Vector3D<double>(0.225, 0.175, 0.0);
+    cameraTworld.setValue<0, 3>(-center.x());
+    cameraTworld.setValue<1, 3>(-center.y());
+    cameraTworld.setValue<2, 3>(0.7 - center.z());
+    referenceCameraTworldVector.push_back(cameraTworld);
+
+    std::vector< Vector3D<double> > points3D_camera;
+    for(std::size_t ii = 0; ii < targetPoints.size(); ++ii) {
+      points3D_camera.push_back(cameraTworld * targetPoints[ii]);
+    }
+    std::vector< Vector2D<double> > points2D;
+    this->compute2DTestData(points2D, points3D_camera, referenceIntrinsics);
+    points3DVector.push_back(targetPoints);
+    points2DVector.push_back(points2D);
+
+    // Start from a slightly wrong pose.
+    Transform3D<double> offset = rollPitchYawToTransform3D(
+      Vector3D<double>(0.02, -0.01, 0.015));
+    offset.setValue<0, 3>(0.01);
+    offset.setValue<1, 3>(-0.02);
+    offset.setValue<2, 3>(0.03);
+    cameraTworldVector.push_back(offset * cameraTworld);
+  }
+
+  // Start from a distortion-free guess with the wrong focal length.
+  for(unsigned int numberOfThreads = 1; numberOfThreads <= 2;
+      ++numberOfThreads) {
+    CameraIntrinsicsPlumbBob<double> recoveredIntrinsics(
+      640, 480, 450.0, 450.0, 310.0, 250.0, 0.0,
+      0.0, 0.0, 0.0, 0.0, 0.0);
+    std::vector< Transform3D<double> > recoveredCameraTworldVector =
+      cameraTworldVector;
+    CameraParameterEstimationStatistics<double> statistics;
+    estimateCameraParametersMultiView(
+      recoveredIntrinsics, recoveredCameraTworldVector, statistics,
+      points3DVector, points2DVector, numberOfThreads);
+
+    BRICK_TEST_ASSERT(statistics.getConditionNumber(numberOfViews) < 1.0E12);
+    BRICK_TEST_ASSERT(
+      this->checkIntrinsicsEqual(
+        recoveredIntrinsics, referenceIntrinsics, m_relaxedTolerance));
+    BRICK_TEST_ASSERT(recoveredCameraTworldVector.size() == numberOfViews);
+    for(std::size_t viewIndex = 0; viewIndex < numberOfViews; ++viewIndex) {
+      BRICK_TEST_ASSERT(
+        this->checkTransformEqual(
+          recoveredCameraTworldVector[viewIndex],
+          referenceCameraTworldVector[viewIndex], m_relaxedTolerance));
+    }
+  }
+
+  // Each view needs a pose.
+  CameraIntrinsicsPlumbBob<double> recoveredIntrinsics(referenceIntrinsics);
+  CameraParameterEstimationStatistics<double> statistics;
+  cameraTworldVector.pop_back();
+  BRICK_TEST_ASSERT_EXCEPTION(
+    ValueException,
+    estimateCameraParametersMultiView(
+      recoveredIntrinsics, cameraTworldVector, statistics,
+      points3DVector, points2DVector));
+}
+
+
 void
 CalibrationToolsTest::
 testEstimateCameraParametersPinhole()
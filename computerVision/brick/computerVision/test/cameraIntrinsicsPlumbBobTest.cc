@@ -10,6 +10,7 @@
 ***************************************************************************
 **/
 
+#include <cmath>
 #include <brick/numeric/differentiableScalar.hh>
 #include <brick/common/functional.hh>
 #include <brick/computerVision/cameraIntrinsicsPlumbBob.hh>
@@ -41,6 +42,7 @@ public:
   void testConstructor__void();
   void testConstructor__args();
   void testProject();
+  void testProjectWithJacobian();
   void testReverseProject();
   void testReverseProjectEM();
   void testStreamOperators();
@@ -104,6 +106,7 @@ CameraIntrinsicsPlumbBobTest()
   BRICK_TEST_REGISTER_MEMBER(testConstructor__void);
   BRICK_TEST_REGISTER_MEMBER(testConstructor__args);
   BRICK_TEST_REGISTER_MEMBER(testProject);
+  BRICK_TEST_REGISTER_MEMBER(testProjectWithJacobian);
   BRICK_TEST_REGISTER_MEMBER(testReverseProject);
   BRICK_TEST_REGISTER_MEMBER(testReverseProjectEM);
   BRICK_TEST_REGISTER_MEMBER(testStreamOperators);
@@ -310,6 +313,86 @@ testProject()
 }
 
 
+void
+CameraIntrinsicsPlumbBobTest::
+testProjectWithJacobian()
+{
+  double constexpr epsilon = 1.0E-6;
+
+  // Check both the full model and the constrained model, which
+  // has fewer parameters.
+  for(int constrained = 0; constrained < 2; ++constrained) {
+    CameraIntrinsicsPlumbBob<double> intrinsics = this->getIntrinsicsInstance();
+    if(constrained) {
+      intrinsics.allowSkew(false);
+      intrinsics.allowSixthOrderRadial(false);
+    }
+    Array1D<double> parameters = intrinsics.getParameters();
+    Array2D<double> dPixelDParameters;
+    Array2D<double> dPixelDPoint;
+    for(double zCoord = 1.0; zCoord < 10.0; zCoord += 2.1) {
+      for(double yCoord = -1.0; yCoord < 1.0; yCoord += 0.3) {
+        for(double xCoord = -1.0; xCoord < 1.0; xCoord += 0.3) {
+          Vector3D<double> cameraCoord(xCoord, yCoord, zCoord);
+          Vector2D<double> pixelCoord;
+          intrinsics.projectWithJacobian(
+            cameraCoord, pixelCoord, dPixelDParameters, dPixelDPoint);
+
+          Vector2D<double> referencePixel = intrinsics.project(cameraCoord);
+          BRICK_TEST_ASSERT(approximatelyEqual(
+                              pixelCoord.x(), referencePixel.x(),
+                              m_defaultTolerance));
+          BRICK_TEST_ASSERT(approximatelyEqual(
+                              pixelCoord.y(), referencePixel.y(),
+                              m_defaultTolerance));
+          BRICK_TEST_ASSERT(dPixelDParameters.rows() == 2);
+          BRICK_TEST_ASSERT(dPixelDParameters.columns() == parameters.size());
+          BRICK_TEST_ASSERT(dPixelDPoint.rows() == 2);
+          BRICK_TEST_ASSERT(dPixelDPoint.columns() == 3);
+
+          // Compare with central differences, parameters first.
+          CameraIntrinsicsPlumbBob<double> perturbed(intrinsics);
+          for(std::size_t ii = 0; ii < parameters.size(); ++ii) {
+            Array1D<double> parametersPlus = parameters.copy();
+            Array1D<double> parametersMinus = parameters.copy();
+            parametersPlus[ii] += epsilon;
+            parametersMinus[ii] -= epsilon;
+            perturbed.setParameters(parametersPlus);
+            Vector2D<double> pixelPlus = perturbed.project(cameraCoord);
+            perturbed.setParameters(parametersMinus);
+            Vector2D<double> pixelMinus = perturbed.project(cameraCoord);
+            Vector2D<double> referenceDerivative =
+              (pixelPlus - pixelMinus) / (2.0 * epsilon);
+            BRICK_TEST_ASSERT(
+              std::fabs(dPixelDParameters(0, ii) - referenceDerivative.x())
+              <= m_gradientTolerance * (1.0 + std::fabs(referenceDerivative.x())));
+            BRICK_TEST_ASSERT(
+              std::fabs(dPixelDParameters(1, ii) - referenceDerivative.y())
+              <= m_gradientTolerance * (1.0 + std::fabs(referenceDerivative.y())));
+          }
+
+          // ...then the point coordinates.
+          for(std::size_t ii = 0; ii < 3; ++ii) {
+            Vector3D<double> offset(ii == 0 ? epsilon : 0.0,
+                                    ii == 1 ? epsilon : 0.0,
+                                    ii == 2 ? epsilon : 0.0);
+            Vector2D<double> referenceDerivative =
+              (intrinsics.project(cameraCoord + offset)
+               - intrinsics.project(cameraCoord - offset)) / (2.0 * epsilon);
+            BRICK_TEST_ASSERT(
+              std::fabs(dPixelDPoint(0, ii) - referenceDerivative.x())
+              <= m_gradientTolerance * (1.0 + std::fabs(referenceDerivative.x())));
+            BRICK_TEST_ASSERT(
+              std::fabs(dPixelDPoint(1, ii) - referenceDerivative.y())
+              <= m_gradientTolerance * (1.0 + std::fabs(referenceDerivative.y())));
+          }
+        }
+      }
+    }
+  }
+}
+
+
 void
 CameraIntrinsicsPlumbBobTest::
 testReverseProject()
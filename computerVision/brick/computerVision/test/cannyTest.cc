@@ -35,6 +35,7 @@ namespace brick {
 
       // Tests.
       void testCanny();
+      void testCannyStreaming();
 
     private:
 
@@ -48,6 +49,7 @@ namespace brick {
       : brick::test::TestFixture<CannyTest>("CannyTest")
     {
       BRICK_TEST_REGISTER_MEMBER(testCanny);
+      BRICK_TEST_REGISTER_MEMBER(testCannyStreaming);
     }
 
 
@@ -67,6 +69,61 @@ namespace brick {
       }
     }
 
+
+
+    void
+    CannyTest::
+    testCannyStreaming()
+    {
+      Image<GRAY8> inputImage0 = readPGM8(getTestImageFileNamePGM0());
+
+      // Explicit thresholds, compared with the stored reference.
+      // Border pixels are excluded, since applyCanny() can find
+      // spurious edges where the blurred image is zero-padded.
+      Image<GRAY8> referenceImage = readPGM8(getEdgeImageFileNamePGM0());
+      Image<GRAY1> binaryImage =
+        applyCannyStreaming<double>(inputImage0, 5, 5.0, 1.0, 3.0, 0.0, 3);
+      BRICK_TEST_ASSERT(binaryImage.rows() == referenceImage.rows());
+      BRICK_TEST_ASSERT(binaryImage.columns() == referenceImage.columns());
+      size_t const border = 5;
+      size_t numberOfDifferences = 0;
+      size_t numberOfEdges = 0;
+      for(size_t row = border; row < binaryImage.rows() - border; ++row) {
+        for(size_t column = border; column < binaryImage.columns() - border;
+            ++column) {
+          bool isReferenceEdge = (referenceImage(row, column) != 0);
+          if(binaryImage(row, column) != isReferenceEdge) {
+            ++numberOfDifferences;
+          }
+          if(isReferenceEdge) {
+            ++numberOfEdges;
+          }
+        }
+      }
+      BRICK_TEST_ASSERT(numberOfEdges > 0);
+      BRICK_TEST_ASSERT(numberOfDifferences == 0);
+
+      // Automatic thresholds, compared with applyCanny().  Results
+      // should not depend on the number of threads.
+      Image<GRAY1> referenceImage1 = applyCanny<double>(inputImage0);
+      Image<GRAY1> binaryImage1 = applyCannyStreaming<double>(inputImage0);
+      Image<GRAY1> binaryImage2 =
+        applyCannyStreaming<double>(inputImage0, 5, 0.0, 0.0, 3.0, 0.0, 4);
+      numberOfDifferences = 0;
+      numberOfEdges = 0;
+      for(size_t index0 = 0; index0 < binaryImage1.size(); ++index0) {
+        BRICK_TEST_ASSERT(binaryImage1[index0] == binaryImage2[index0]);
+        if(binaryImage1[index0] != referenceImage1[index0]) {
+          ++numberOfDifferences;
+        }
+        if(referenceImage1[index0]) {
+          ++numberOfEdges;
+        }
+      }
+      BRICK_TEST_ASSERT(numberOfEdges > 0);
+      BRICK_TEST_ASSERT(numberOfDifferences == 0);
+    }
+
   } // namespace computerVision
 
 } // namespace brick
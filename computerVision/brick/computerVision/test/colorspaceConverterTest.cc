@@ -41,6 +41,7 @@ namespace brick {
       void testBGRA8ToRGB8();
       void testRGBA8ToRGB8();
       void testHSV_FLOAT64ToRGB8();
+      void testConvertRow();
     private:
 
     }; // class ColorspaceConverterTest
@@ -63,6 +64,7 @@ namespace brick {
       BRICK_TEST_REGISTER_MEMBER(testRGBA8ToRGB8);
       BRICK_TEST_REGISTER_MEMBER(testRGBA8ToRGB8);
       BRICK_TEST_REGISTER_MEMBER(testHSV_FLOAT64ToRGB8);
+      BRICK_TEST_REGISTER_MEMBER(testConvertRow);
     }
 
 
@@ -392,6 +394,69 @@ namespace brick {
       }
     }
 
+
+    void
+    ColorspaceConverterTest::
+    testConvertRow()
+    {
+      // Build one long row containing a sampling of RGB values,
+      // including the extremes, then check that the row conversion
+      // (which has table-driven fast paths for some formats) exactly
+      // matches per-pixel conversion.
+      std::vector<PixelRGB8> inputPixels;
+      for(brick::common::UnsignedInt16 redValue = 0; redValue < 256; redValue += 5) {
+        for(brick::common::UnsignedInt16 greenValue = 0; greenValue < 256; greenValue += 5) {
+          for(brick::common::UnsignedInt16 blueValue = 0; blueValue < 256; blueValue += 5) {
+            inputPixels.push_back(
+              PixelRGB8(static_cast<brick::common::UnsignedInt8>(redValue),
+                        static_cast<brick::common::UnsignedInt8>(greenValue),
+                        static_cast<brick::common::UnsignedInt8>(blueValue)));
+          }
+        }
+      }
+      inputPixels.push_back(PixelRGB8(255, 255, 254));
+      inputPixels.push_back(PixelRGB8(254, 255, 255));
+      inputPixels.push_back(PixelRGB8(255, 254, 255));
+      size_t const numberOfPixels = inputPixels.size();
+
+      {
+        ColorspaceConverter<RGB8, GRAY8> converter;
+        std::vector<brick::common::UnsignedInt8> outputPixels(numberOfPixels);
+        converter.convertRow(&(inputPixels[0]), &(outputPixels[0]),
+                             numberOfPixels);
+        for(size_t ii = 0; ii < numberOfPixels; ++ii) {
+          BRICK_TEST_ASSERT(outputPixels[ii] == converter(inputPixels[ii]));
+        }
+      }
+      {
+        ColorspaceConverter<RGB8, HSV_FLOAT64> converter;
+        std::vector<PixelHSVFloat64> outputPixels(numberOfPixels);
+        converter.convertRow(&(inputPixels[0]), &(outputPixels[0]),
+                             numberOfPixels);
+        for(size_t ii = 0; ii < numberOfPixels; ++ii) {
+          BRICK_TEST_ASSERT(outputPixels[ii] == converter(inputPixels[ii]));
+        }
+      }
+      {
+        ColorspaceConverter<RGB8, YIQ_FLOAT64> converter;
+        std::vector<PixelYIQFloat64> outputPixels(numberOfPixels);
+        converter.convertRow(&(inputPixels[0]), &(outputPixels[0]),
+                             numberOfPixels);
+        for(size_t ii = 0; ii < numberOfPixels; ++ii) {
+          BRICK_TEST_ASSERT(outputPixels[ii] == converter(inputPixels[ii]));
+        }
+      }
+      {
+        ColorspaceConverter<RGB8, BGRA8> converter;
+        std::vector<PixelBGRA8> outputPixels(numberOfPixels);
+        converter.convertRow(&(inputPixels[0]), &(outputPixels[0]),
+                             numberOfPixels);
+        for(size_t ii = 0; ii < numberOfPixels; ++ii) {
+          BRICK_TEST_ASSERT(outputPixels[ii] == converter(inputPixels[ii]));
+        }
+      }
+    }
+
   } // namespace computerVision
 
 } // namespace brick
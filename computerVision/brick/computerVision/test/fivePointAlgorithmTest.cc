@@ -60,10 +60,14 @@ namespace brick {
 
       // Tests.
       void testFivePointAlgorithm();
+      void testFivePointAlgorithmMinimal();
       void testFivePointAlgorithmRobust__Iter_Iter_Iter_size_t();
       void testFivePointAlgorithmRobust__Iter_Iter_Iter_Iter_size_t();
       void testGetCameraMotionFromEssentialMatrix();
       void testTriangulateCalibratedImagePoint();
+      void testComputeEpipolarErrors();
+      void testGetEpipolarInliers();
+      void testTriangulateCalibratedImagePoints();
 
     private:
 
@@ -121,12 +125,16 @@ namespace brick {
         m_defaultTolerance(1.0E-5)
     {
       BRICK_TEST_REGISTER_MEMBER(testFivePointAlgorithm);
+      BRICK_TEST_REGISTER_MEMBER(testFivePointAlgorithmMinimal);
       BRICK_TEST_REGISTER_MEMBER(
         testFivePointAlgorithmRobust__Iter_Iter_Iter_size_t);
       BRICK_TEST_REGISTER_MEMBER(
         testFivePointAlgorithmRobust__Iter_Iter_Iter_Iter_size_t);
       BRICK_TEST_REGISTER_MEMBER(testGetCameraMotionFromEssentialMatrix);
       BRICK_TEST_REGISTER_MEMBER(testTriangulateCalibratedImagePoint);
+      BRICK_TEST_REGISTER_MEMBER(testComputeEpipolarErrors);
+      BRICK_TEST_REGISTER_MEMBER(testGetEpipolarInliers);
+      BRICK_TEST_REGISTER_MEMBER(testTriangulateCalibratedImagePoints);
     }
 
 
@@ -181,6 +189,74 @@ namespace brick {
     }
 
 
+    void
+    FivePointAlgorithmTest::
+    testFivePointAlgorithmMinimal()
+    {
+      std::vector< num::Vector2D<cmn::Float64> > qVector;
+      std::vector< num::Vector2D<cmn::Float64> > qPrimeVector;
+      this->getTestPoints(qVector, qPrimeVector);
+      qVector.resize(5);
+      qPrimeVector.resize(5);
+
+      // Random point sets, as well as the structured test points,
+      // should give the same candidates as fivePointAlgorithm(), up
+      // to scale.
+      brick::random::PseudoRandom pRandom(7);
+      for(size_t trial = 0; trial < 50; ++trial) {
+        if(trial != 0) {
+          for(size_t ii = 0; ii < 5; ++ii) {
+            qVector[ii].setValue(pRandom.uniform(-1.0, 1.0),
+                                 pRandom.uniform(-1.0, 1.0));
+            qPrimeVector[ii].setValue(pRandom.uniform(-1.0, 1.0),
+                                      pRandom.uniform(-1.0, 1.0));
+          }
+        }
+        std::vector< num::Array2D<cmn::Float64> > EVector =
+          fivePointAlgorithm<cmn::Float64>(
+            qVector.begin(), qVector.end(), qPrimeVector.begin());
+        cmn::Float64 candidates[10][9];
+        size_t numberOfCandidates = fivePointAlgorithmMinimal(
+          qVector.begin(), qPrimeVector.begin(), candidates);
+        BRICK_TEST_ASSERT(numberOfCandidates == EVector.size());
+
+        for(size_t ii = 0; ii < numberOfCandidates; ++ii) {
+          // Candidates should have unit norm.
+          cmn::Float64 sumOfSquares = 0.0;
+          for(size_t kk = 0; kk < 9; ++kk) {
+            sumOfSquares += candidates[ii][kk] * candidates[ii][kk];
+          }
+          BRICK_TEST_ASSERT(approximatelyEqual(sumOfSquares, 1.0, 1.0E-12));
+
+          // Look for a matching matrix in EVector.  Order and sign
+          // are arbitrary.
+          bool isFound = false;
+          for(size_t jj = 0; jj < EVector.size(); ++jj) {
+            cmn::Float64 norm = 0.0;
+            for(size_t kk = 0; kk < 9; ++kk) {
+              norm += EVector[jj][kk] * EVector[jj][kk];
+            }
+            norm = std::sqrt(norm);
+            cmn::Float64 plusDistance = 0.0;
+            cmn::Float64 minusDistance = 0.0;
+            for(size_t kk = 0; kk < 9; ++kk) {
+              cmn::Float64 element = EVector[jj][kk] / norm;
+              plusDistance = std::max(
+                plusDistance, std::fabs(element - candidates[ii][kk]));
+              minusDistance = std::max(
+                minusDistance, std::fabs(element + candidates[ii][kk]));
+            }
+            if(std::min(plusDistance, minusDistance) < m_defaultTolerance) {
+              isFound = true;
+              break;
+            }
+          }
+          BRICK_TEST_ASSERT(isFound);
+        }
+      }
+    }
+
+
     void
     FivePointAlgorithmTest::
     testFivePointAlgorithmRobust__Iter_Iter_Iter_size_t()
@@ -426,6 +502,216 @@ namespace brick {
     }
 
 
+    void
+    FivePointAlgorithmTest::
+    testComputeEpipolarErrors()
+    {
+      // An arbitrary fundamental matrix, and arbitrary points.
+      num::Array2D<cmn::Float64> FF(
+        "[[0.1, -2.0, 0.3], [1.5, 0.2, -0.7], [-0.4, 0.9, 0.05]]");
+      num::Array2D<cmn::Float64> FTranspose = FF.transpose();
+      size_t const numberOfPoints = 37;
+      num::Array1D<cmn::Float64> xCoords0(numberOfPoints);
+      num::Array1D<cmn::Float64> yCoords0(numberOfPoints);
+      num::Array1D<cmn::Float64> xCoords1(numberOfPoints);
+      num::Array1D<cmn::Float64> yCoords1(numberOfPoints);
+      for(size_t ii = 0; ii < numberOfPoints; ++ii) {
+        xCoords0[ii] = std::cos(0.3 * ii);
+        yCoords0[ii] = std::sin(0.7 * ii) - 0.2;
+        xCoords1[ii] = 0.5 * std::sin(1.1 * ii) + 0.1;
+        yCoords1[ii] = std::cos(0.9 * ii);
+      }
+
+      num::Array1D<cmn::Float64> distances;
+      num::Array1D<cmn::Float64> sampsonErrors;
+      num::Array1D<cmn::Float64> symmetricDistances;
+      computeEpipolarErrors(FF, xCoords0, yCoords0, xCoords1, yCoords1,
+                            distances);
+      computeEpipolarErrors(FF, xCoords0, yCoords0, xCoords1, yCoords1,
+                            sampsonErrors, BRICK_CV_SAMPSON_ERROR);
+      computeEpipolarErrors(FF, xCoords0, yCoords0, xCoords1, yCoords1,
+                            symmetricDistances,
+                            BRICK_CV_SYMMETRIC_EPIPOLAR_DISTANCE);
+      BRICK_TEST_ASSERT(distances.size() == numberOfPoints);
+      BRICK_TEST_ASSERT(sampsonErrors.size() == numberOfPoints);
+      BRICK_TEST_ASSERT(symmetricDistances.size() == numberOfPoints);
+
+      for(size_t ii = 0; ii < numberOfPoints; ++ii) {
+        num::Vector2D<cmn::Float64> q0(xCoords0[ii], yCoords0[ii]);
+        num::Vector2D<cmn::Float64> q1(xCoords1[ii], yCoords1[ii]);
+        cmn::Float64 distance1 = checkEpipolarConstraint(FF, q0, q1);
+        cmn::Float64 distance0 = checkEpipolarConstraint(FTranspose, q1, q0);
+        BRICK_TEST_ASSERT(
+          approximatelyEqual(distances[ii], distance1, m_defaultTolerance));
+        BRICK_TEST_ASSERT(
+          approximatelyEqual(symmetricDistances[ii], distance0 + distance1,
+                             m_defaultTolerance));
+
+        num::Array1D<cmn::Float64> qq0(3);
+        num::Array1D<cmn::Float64> qq1(3);
+        qq0[0] = q0.x(); qq0[1] = q0.y(); qq0[2] = 1.0;
+        qq1[0] = q1.x(); qq1[1] = q1.y(); qq1[2] = 1.0;
+        num::Array1D<cmn::Float64> line1 = num::matrixMultiply<cmn::Float64>(FF, qq0);
+        num::Array1D<cmn::Float64> line0 =
+          num::matrixMultiply<cmn::Float64>(FTranspose, qq1);
+        cmn::Float64 algebraicError = num::dot<cmn::Float64>(qq1, line1);
+        cmn::Float64 sampsonError =
+          algebraicError * algebraicError
+          / (line1[0] * line1[0] + line1[1] * line1[1]
+             + line0[0] * line0[0] + line0[1] * line0[1]);
+        BRICK_TEST_ASSERT(
+          approximatelyEqual(sampsonErrors[ii], sampsonError,
+                             m_defaultTolerance));
+      }
+
+      // Mismatched inputs should be rejected.
+      num::Array1D<cmn::Float64> shortArray(numberOfPoints - 1);
+      BRICK_TEST_ASSERT_EXCEPTION(
+        cmn::ValueException,
+        computeEpipolarErrors(FF, xCoords0, shortArray, xCoords1, yCoords1,
+                              distances));
+    }
+
+
+    void
+    FivePointAlgorithmTest::
+    testGetEpipolarInliers()
+    {
+      // Points with known epipolar geometry, plus a few mismatches.
+      std::vector< num::Vector2D<cmn::Float64> > qVector;
+      std::vector< num::Vector2D<cmn::Float64> > qPrimeVector;
+      for(size_t transformNumber = 0; transformNumber < 5; ++transformNumber) {
+        this->getTestPoints(qVector, qPrimeVector, transformNumber);
+        std::vector< num::Array2D<cmn::Float64> > EVector =
+          fivePointAlgorithm<cmn::Float64>(
+            qVector.begin(), qVector.begin() + 5, qPrimeVector.begin());
+
+        size_t const numberOfPoints = qVector.size();
+        num::Array1D<cmn::Float64> xCoords0(numberOfPoints);
+        num::Array1D<cmn::Float64> yCoords0(numberOfPoints);
+        num::Array1D<cmn::Float64> xCoords1(numberOfPoints);
+        num::Array1D<cmn::Float64> yCoords1(numberOfPoints);
+        for(size_t ii = 0; ii < numberOfPoints; ++ii) {
+          xCoords0[ii] = qVector[ii].x();
+          yCoords0[ii] = qVector[ii].y();
+          xCoords1[ii] = qPrimeVector[ii].x();
+          yCoords1[ii] = qPrimeVector[ii].y();
+        }
+
+        // Corrupt every third correspondence.
+        size_t numberOfOutliers = 0;
+        for(size_t ii = 2; ii < numberOfPoints; ii += 3) {
+          yCoords1[ii] += 0.5;
+          ++numberOfOutliers;
+        }
+
+        // At least one of the candidates is the right one.
+        size_t bestCount = 0;
+        for(size_t jj = 0; jj < EVector.size(); ++jj) {
+          num::Array1D<bool> inlierMask;
+          num::Array1D<cmn::Float64> errors;
+          cmn::Float64 const threshold = 1.0E-8;
+          size_t count = getEpipolarInliers(
+            EVector[jj], xCoords0, yCoords0, xCoords1, yCoords1,
+            threshold, inlierMask, BRICK_CV_SAMPSON_ERROR);
+          computeEpipolarErrors(
+            EVector[jj], xCoords0, yCoords0, xCoords1, yCoords1,
+            errors, BRICK_CV_SAMPSON_ERROR);
+
+          BRICK_TEST_ASSERT(inlierMask.size() == numberOfPoints);
+          size_t maskCount = 0;
+          for(size_t ii = 0; ii < numberOfPoints; ++ii) {
+            BRICK_TEST_ASSERT(inlierMask[ii] == (errors[ii] <= threshold));
+            maskCount += inlierMask[ii] ? 1 : 0;
+          }
+          BRICK_TEST_ASSERT(count == maskCount);
+          bestCount = std::max(bestCount, count);
+        }
+        BRICK_TEST_ASSERT(bestCount == numberOfPoints - numberOfOutliers);
+      }
+    }
+
+
+    void
+    FivePointAlgorithmTest::
+    testTriangulateCalibratedImagePoints()
+    {
+      std::vector< num::Vector3D<cmn::Float64> > targetVector;
+      this->getTestPoints3D(targetVector, true);
+
+      std::vector< num::Transform3D<cmn::Float64> > worldTcam0Vector;
+      std::vector< num::Transform3D<cmn::Float64> > worldTcam1Vector;
+      this->getCameraPoses(worldTcam0Vector, worldTcam1Vector);
+
+      size_t const numberOfPoints = targetVector.size();
+      for(size_t jj = 0; jj < worldTcam0Vector.size(); ++jj) {
+        num::Transform3D<cmn::Float64> cam0Tworld = worldTcam0Vector[jj].invert();
+        num::Transform3D<cmn::Float64> cam1Tworld = worldTcam1Vector[jj].invert();
+        num::Transform3D<cmn::Float64> cam0Tcam1 =
+          cam0Tworld * worldTcam1Vector[jj];
+
+        num::Array1D<cmn::Float64> xCoords0(numberOfPoints);
+        num::Array1D<cmn::Float64> yCoords0(numberOfPoints);
+        num::Array1D<cmn::Float64> xCoords1(numberOfPoints);
+        num::Array1D<cmn::Float64> yCoords1(numberOfPoints);
+        std::vector< num::Vector3D<cmn::Float64> > target0Vector;
+        for(size_t ii = 0; ii < numberOfPoints; ++ii) {
+          num::Vector3D<cmn::Float64> target0 = cam0Tworld * targetVector[ii];
+          num::Vector3D<cmn::Float64> target1 = cam1Tworld * targetVector[ii];
+          xCoords0[ii] = target0.x() / target0.z();
+          yCoords0[ii] = target0.y() / target0.z();
+          xCoords1[ii] = target1.x() / target1.z();
+          yCoords1[ii] = target1.y() / target1.z();
+          target0Vector.push_back(target0);
+        }
+
+        // Make the last correspondence noisy, so that the rays don't
+        // quite intersect.
+        yCoords1[numberOfPoints - 1] += 0.01;
+
+        num::Array1D<cmn::Float64> xCoords3D;
+        num::Array1D<cmn::Float64> yCoords3D;
+        num::Array1D<cmn::Float64> zCoords3D;
+        triangulateCalibratedImagePoints(
+          cam0Tcam1, xCoords0, yCoords0, xCoords1, yCoords1,
+          xCoords3D, yCoords3D, zCoords3D);
+        BRICK_TEST_ASSERT(xCoords3D.size() == numberOfPoints);
+        BRICK_TEST_ASSERT(yCoords3D.size() == numberOfPoints);
+        BRICK_TEST_ASSERT(zCoords3D.size() == numberOfPoints);
+
+        for(size_t ii = 0; ii < numberOfPoints; ++ii) {
+          num::Vector3D<cmn::Float64> recovered(
+            xCoords3D[ii], yCoords3D[ii], zCoords3D[ii]);
+          num::Vector3D<cmn::Float64> reference =
+            triangulateCalibratedImagePoint(
+              cam0Tcam1,
+              num::Vector2D<cmn::Float64>(xCoords0[ii], yCoords0[ii]),
+              num::Vector2D<cmn::Float64>(xCoords1[ii], yCoords1[ii]));
+          BRICK_TEST_ASSERT(this->isApproximatelyEqual(recovered, reference));
+          if(ii != numberOfPoints - 1) {
+            BRICK_TEST_ASSERT(
+              this->isApproximatelyEqual(recovered, target0Vector[ii]));
+          }
+        }
+      }
+
+      // Parallel rays give NaN.
+      num::Transform3D<cmn::Float64> cam0Tcam1(1.0, 0.0, 0.0, 1.0,
+                                               0.0, 1.0, 0.0, 0.0,
+                                               0.0, 0.0, 1.0, 0.0,
+                                               0.0, 0.0, 0.0, 1.0);
+      num::Array1D<cmn::Float64> coords("[0.2]");
+      num::Array1D<cmn::Float64> xCoords3D;
+      num::Array1D<cmn::Float64> yCoords3D;
+      num::Array1D<cmn::Float64> zCoords3D;
+      triangulateCalibratedImagePoints(
+        cam0Tcam1, coords, coords, coords, coords,
+        xCoords3D, yCoords3D, zCoords3D);
+      BRICK_TEST_ASSERT(xCoords3D[0] != xCoords3D[0]);
+      BRICK_TEST_ASSERT(zCoords3D[0] != zCoords3D[0]);
+    }
+
+
     void
     FivePointAlgorithmTest::
     getCameraPoses(std::vector< num::Transform3D<cmn::Float64> >& worldTcam0Vector,
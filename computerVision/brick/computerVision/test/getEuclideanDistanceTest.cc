@@ -10,6 +10,7 @@
 ***************************************************************************
 **/
 
+#include <limits>
 #include <brick/computerVision/getEuclideanDistance.hh>
 #include <brick/test/testFixture.hh>
 
@@ -30,6 +31,7 @@ namespace brick {
 
       // Tests.
       void testGetEuclideanDistance();
+      void testGetExactEuclideanDistance();
 
     private:
 
@@ -43,6 +45,7 @@ namespace brick {
       : brick::test::TestFixture<GetEuclideanDistanceTest>("GetEuclideanDistanceTest")
     {
       BRICK_TEST_REGISTER_MEMBER(testGetEuclideanDistance);
+      BRICK_TEST_REGISTER_MEMBER(testGetExactEuclideanDistance);
     }
 
 
@@ -127,6 +130,93 @@ namespace brick {
 
     }
 
+
+
+    void
+    GetEuclideanDistanceTest::
+    testGetExactEuclideanDistance()
+    {
+      // Scattered seeds, including a cluster and some on the border,
+      // and an empty column.
+      const size_t testImageRows = 67;
+      const size_t testImageColumns = 83;
+      Image<GRAY8> testImage(testImageRows, testImageColumns);
+      testImage = common::UnsignedInt8(0);
+      for(size_t ii = 0; ii < 40; ++ii) {
+        size_t row = (ii * 37 + 11) % testImageRows;
+        size_t column = (ii * 53 + 7) % testImageColumns;
+        if(column != 20) {
+          testImage(row, column) = common::UnsignedInt8(1);
+        }
+      }
+      testImage(0, 0) = common::UnsignedInt8(1);
+      testImage(testImageRows - 1, testImageColumns - 1) =
+        common::UnsignedInt8(1);
+
+      double const rowSpacing = 1.7;
+      double const columnSpacing = 0.6;
+      numeric::Array2D<size_t> nearestSeedIndices;
+      numeric::Array2D<double> distances = getExactEuclideanDistance<double>(
+        testImage, nearestSeedIndices, rowSpacing, columnSpacing, false, 3);
+      numeric::Array2D<double> squaredDistances =
+        getExactEuclideanDistance<double>(
+          testImage, rowSpacing, columnSpacing, true, 1);
+
+      BRICK_TEST_ASSERT(distances.rows() == testImageRows);
+      BRICK_TEST_ASSERT(distances.columns() == testImageColumns);
+      BRICK_TEST_ASSERT(nearestSeedIndices.rows() == testImageRows);
+      BRICK_TEST_ASSERT(nearestSeedIndices.columns() == testImageColumns);
+      for(size_t row = 0; row < testImageRows; ++row) {
+        for(size_t column = 0; column < testImageColumns; ++column) {
+          // Brute force reference.
+          double referenceSquared = std::numeric_limits<double>::max();
+          for(size_t index0 = 0; index0 < testImage.size(); ++index0) {
+            if(testImage(index0)) {
+              double deltaU = columnSpacing * (
+                double(column) - double(index0 % testImageColumns));
+              double deltaV = rowSpacing * (
+                double(row) - double(index0 / testImageColumns));
+              referenceSquared = std::min(
+                referenceSquared, deltaU * deltaU + deltaV * deltaV);
+            }
+          }
+          BRICK_TEST_ASSERT(
+            approximatelyEqual(distances(row, column),
+                               std::sqrt(referenceSquared), 1.0E-9));
+          BRICK_TEST_ASSERT(
+            approximatelyEqual(squaredDistances(row, column),
+                               referenceSquared, 1.0E-9));
+
+          // The reported seed must be a seed, and must be at the
+          // reported distance.
+          size_t seedIndex = nearestSeedIndices(row, column);
+          BRICK_TEST_ASSERT(seedIndex < testImage.size());
+          BRICK_TEST_ASSERT(testImage(seedIndex) != 0);
+          double deltaU = columnSpacing * (
+            double(column) - double(seedIndex % testImageColumns));
+          double deltaV = rowSpacing * (
+            double(row) - double(seedIndex / testImageColumns));
+          BRICK_TEST_ASSERT(
+            approximatelyEqual(deltaU * deltaU + deltaV * deltaV,
+                               referenceSquared, 1.0E-9));
+        }
+      }
+
+      // An image with no seeds.
+      testImage = common::UnsignedInt8(0);
+      distances = getExactEuclideanDistance<double>(
+        testImage, nearestSeedIndices);
+      for(size_t index0 = 0; index0 < distances.size(); ++index0) {
+        BRICK_TEST_ASSERT(
+          distances(index0) == std::numeric_limits<double>::infinity());
+        BRICK_TEST_ASSERT(nearestSeedIndices(index0) == testImage.size());
+      }
+
+      BRICK_TEST_ASSERT_EXCEPTION(
+        common::ValueException,
+        getExactEuclideanDistance<double>(testImage, 0.0, 1.0));
+    }
+
   } // namespace computerVision
 
 } // namespace brick
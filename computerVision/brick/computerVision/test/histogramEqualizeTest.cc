@@ -0,0 +1,431 @@
+/**
+***************************************************************************
+* @file histogramEqualizeTest.cc
+*
+* Source file defining tests for histogram equalization routines.
+*
+* Copyright (C) 2026 David LaRose, dlr@cs.cmu.edu
+* See accompanying file, LICENSE.TXT, for details.
+*
+***************************************************************************
+**/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <brick/computerVision/histogramEqualize.hh>
+#include <brick/computerVision/imageIO.hh>
+#include <brick/computerVision/test/testImages.hh>
+#include <brick/test/testFixture.hh>
+#include <brick/utilities/timeUtilities.hh>
+
+namespace brick {
+
+  namespace computerVision {
+
+    class HistogramEqualizeTest
+      : public brick::test::TestFixture<HistogramEqualizeTest> {
+
+    public:
+
+      HistogramEqualizeTest();
+      ~HistogramEqualizeTest() {}
+
+      void setUp(const std::string& /* testName */) {}
+      void tearDown(const std::string& /* testName */) {}
+
+      // Tests.
+      void testGetHistogram();
+      void testGetHistogram16();
+      void testGetHistogramFloat();
+      void testHistogramEqualize();
+      void testAdaptiveHistogramEqualize();
+      void testAdaptiveHistogramEqualize16();
+      void testExceptions();
+      void testExecutionTime();
+
+    private:
+
+      // Pseudo-random 16-bit image with values concentrated in
+      // [offset, offset + range).
+      Image<GRAY16>
+      getTestImage16(size_t rows, size_t columns, unsigned int offset,
+                     unsigned int range);
+
+    }; // class HistogramEqualizeTest
+
+
+    /* ============== Member Function Definititions ============== */
+
+    HistogramEqualizeTest::
+    HistogramEqualizeTest()
+      : brick::test::TestFixture<HistogramEqualizeTest>("HistogramEqualizeTest")
+    {
+      BRICK_TEST_REGISTER_MEMBER(testGetHistogram);
+      BRICK_TEST_REGISTER_MEMBER(testGetHistogram16);
+      BRICK_TEST_REGISTER_MEMBER(testGetHistogramFloat);
+      BRICK_TEST_REGISTER_MEMBER(testHistogramEqualize);
+      BRICK_TEST_REGISTER_MEMBER(testAdaptiveHistogramEqualize);
+      BRICK_TEST_REGISTER_MEMBER(testAdaptiveHistogramEqualize16);
+      BRICK_TEST_REGISTER_MEMBER(testExceptions);
+      // BRICK_TEST_REGISTER_MEMBER(testExecutionTime);
+    }
+
+
+    void
+    HistogramEqualizeTest::
+    testGetHistogram()
+    {
+      Image<GRAY8> inputImage = readPGM8(getBullseyeFileNamePGM0());
+      numeric::Array1D<brick::common::UInt32> reference(256);
+      reference = 0;
+      for(size_t ii = 0; ii < inputImage.size(); ++ii) {
+        ++(reference[inputImage[ii]]);
+      }
+
+      for(unsigned int numberOfThreads = 0; numberOfThreads < 5;
+          ++numberOfThreads) {
+        numeric::Array1D<brick::common::UInt32> histogram =
+          getHistogram(inputImage, numberOfThreads);
+        BRICK_TEST_ASSERT(histogram.size() == 256);
+        for(size_t bin = 0; bin < histogram.size(); ++bin) {
+          BRICK_TEST_ASSERT(histogram[bin] == reference[bin]);
+        }
+      }
+
+      // Uniform image with a width that isn't a multiple of the
+      // number of sub-histograms.
+      Image<GRAY8> uniformImage(5, 7);
+      uniformImage = 200;
+      numeric::Array1D<brick::common::UInt32> histogram =
+        getHistogram(uniformImage, 2);
+      for(size_t bin = 0; bin < histogram.size(); ++bin) {
+        BRICK_TEST_ASSERT(histogram[bin] == ((bin == 200) ? 35u : 0u));
+      }
+    }
+
+
+    void
+    HistogramEqualizeTest::
+    testGetHistogram16()
+    {
+      Image<GRAY16> inputImage = this->getTestImage16(37, 53, 0, 65536);
+      inputImage(3, 4) = 65535;
+      numeric::Array1D<brick::common::UInt32> reference(65536);
+      reference = 0;
+      for(size_t ii = 0; ii < inputImage.size(); ++ii) {
+        ++(reference[inputImage[ii]]);
+      }
+
+      for(unsigned int numberOfThreads = 1; numberOfThreads < 4;
+          ++numberOfThreads) {
+        numeric::Array1D<brick::common::UInt32> histogram =
+          getHistogram(inputImage, numberOfThreads);
+        BRICK_TEST_ASSERT(histogram.size() == 65536);
+        for(size_t bin = 0; bin < histogram.size(); ++bin) {
+          BRICK_TEST_ASSERT(histogram[bin] == reference[bin]);
+        }
+      }
+    }
+
+
+    void
+    HistogramEqualizeTest::
+    testGetHistogramFloat()
+    {
+      Image<GRAY_FLOAT64> inputImage(3, 5);
+      double values[] = {-1.0, 0.0, 0.24, 0.25, 0.5,
+                         0.74, 0.75, 0.99, 1.0, 2.0,
+                         0.1, 0.3, 0.6, 0.9,
+                         std::numeric_limits<double>::quiet_NaN()};
+      std::copy(values, values + 15, inputImage.begin());
+
+      // Bins are [0, 0.25), [0.25, 0.5), [0.5, 0.75), [0.75, 1.0).
+      brick::common::UInt32 expected[] = {4, 2, 3, 5};
+      for(unsigned int numberOfThreads = 1; numberOfThreads < 4;
+          ++numberOfThreads) {
+        numeric::Array1D<brick::common::UInt32> histogram =
+          getHistogram(inputImage, 4, 0.0, 1.0, numberOfThreads);
+        BRICK_TEST_ASSERT(histogram.size() == 4);
+        for(size_t bin = 0; bin < histogram.size(); ++bin) {
+          BRICK_TEST_ASSERT(histogram[bin] == expected[bin]);
+        }
+      }
+
+      Image<GRAY_FLOAT32> inputImage32(3, 5);
+      std::copy(values, values + 15, inputImage32.begin());
+      numeric::Array1D<brick::common::UInt32> histogram =
+        getHistogram(inputImage32, 4, 0.0, 1.0);
+      for(size_t bin = 0; bin < histogram.size(); ++bin) {
+        BRICK_TEST_ASSERT(histogram[bin] == expected[bin]);
+      }
+    }
+
+
+    void
+    HistogramEqualizeTest::
+    testHistogramEqualize()
+    {
+      Image<GRAY8> inputImage = readPGM8(getBullseyeFileNamePGM0());
+
+      // Straightforward reference implementation.
+      numeric::Array1D<brick::common::UInt32> histogram =
+        getHistogram(inputImage);
+      numeric::Array1D<brick::common::UInt32> cdf(256);
+      brick::common::UInt32 sum = 0;
+      for(size_t bin = 0; bin < 256; ++bin) {
+        sum += histogram[bin];
+        cdf[bin] = sum;
+      }
+      double scaleFactor = 256.0 / (inputImage.size() + 1);
+
+      for(unsigned int numberOfThreads = 0; numberOfThreads < 4;
+          ++numberOfThreads) {
+        Image<GRAY8> outputImage =
+          histogramEqualize(inputImage, numberOfThreads);
+        BRICK_TEST_ASSERT(outputImage.rows() == inputImage.rows());
+        BRICK_TEST_ASSERT(outputImage.columns() == inputImage.columns());
+        for(size_t ii = 0; ii < inputImage.size(); ++ii) {
+          BRICK_TEST_ASSERT(
+            outputImage[ii] == static_cast<brick::common::UInt8>(
+              scaleFactor * cdf[inputImage[ii]]));
+        }
+      }
+
+      // The 16-bit version should spread a narrow range of values
+      // over (nearly) the full output range.
+      Image<GRAY16> inputImage16 = this->getTestImage16(40, 60, 1000, 50);
+      Image<GRAY16> outputImage16 = histogramEqualize(inputImage16, 2);
+      brick::common::UInt16 minimum = 65535;
+      brick::common::UInt16 maximum = 0;
+      for(size_t ii = 0; ii < inputImage16.size(); ++ii) {
+        minimum = std::min(minimum, outputImage16[ii]);
+        maximum = std::max(maximum, outputImage16[ii]);
+        for(size_t jj = 0; jj < ii; jj += 97) {
+          if(inputImage16[jj] < inputImage16[ii]) {
+            BRICK_TEST_ASSERT(outputImage16[jj] < outputImage16[ii]);
+          }
+        }
+      }
+      BRICK_TEST_ASSERT(minimum < 2000);
+      BRICK_TEST_ASSERT(maximum > 64000);
+    }
+
+
+    void
+    HistogramEqualizeTest::
+    testAdaptiveHistogramEqualize()
+    {
+      Image<GRAY8> inputImage = readPGM8(getBullseyeFileNamePGM0());
+
+      // With a single tile and no clipping, this is ordinary
+      // histogram equalization, with output in [0, 255].
+      numeric::Array1D<brick::common::UInt32> histogram =
+        getHistogram(inputImage);
+      numeric::Array1D<brick::common::UInt8> mapping(256);
+      brick::common::UInt32 sum = 0;
+      for(size_t bin = 0; bin < 256; ++bin) {
+        sum += histogram[bin];
+        mapping[bin] = static_cast<brick::common::UInt8>(
+          sum * (255.0 / inputImage.size()) + 0.5);
+      }
+      Image<GRAY8> outputImage =
+        adaptiveHistogramEqualize(inputImage, 0.0, 1, 1);
+      for(size_t ii = 0; ii < inputImage.size(); ++ii) {
+        BRICK_TEST_ASSERT(outputImage[ii] == mapping[inputImage[ii]]);
+      }
+
+      // A clip limit that is never reached has no effect.
+      outputImage = adaptiveHistogramEqualize(inputImage, 1000.0, 1, 1);
+      for(size_t ii = 0; ii < inputImage.size(); ++ii) {
+        BRICK_TEST_ASSERT(outputImage[ii] == mapping[inputImage[ii]]);
+      }
+
+      // Result must not depend on the number of threads.  Use a tile
+      // grid that doesn't evenly divide the image.
+      Image<GRAY8> referenceImage =
+        adaptiveHistogramEqualize(inputImage, 3.0, 5, 7, 1);
+      for(unsigned int numberOfThreads = 0; numberOfThreads < 4;
+          ++numberOfThreads) {
+        outputImage = adaptiveHistogramEqualize(
+          inputImage, 3.0, 5, 7, numberOfThreads);
+        for(size_t ii = 0; ii < inputImage.size(); ++ii) {
+          BRICK_TEST_ASSERT(outputImage[ii] == referenceImage[ii]);
+        }
+      }
+
+      // Blending should avoid visible tile boundaries on a smooth
+      // ramp: neighboring output pixels should never differ by much
+      // more than the contrast gain allowed by the clip limit.
+      Image<GRAY8> rampImage(64, 256);
+      for(size_t row = 0; row < rampImage.rows(); ++row) {
+        for(size_t column = 0; column < rampImage.columns(); ++column) {
+          rampImage(row, column) =
+            static_cast<brick::common::UInt8>((column + row / 8) & 0xff);
+        }
+      }
+      outputImage = adaptiveHistogramEqualize(rampImage, 2.0, 4, 4);
+      for(size_t row = 0; row < rampImage.rows(); ++row) {
+        for(size_t column = 1; column < 255 - 8; ++column) {
+          int difference = (static_cast<int>(outputImage(row, column))
+                            - static_cast<int>(outputImage(row, column - 1)));
+          BRICK_TEST_ASSERT(std::abs(difference) <= 8);
+        }
+      }
+
+      // Tiny images reduce the tile grid rather than failing.
+      Image<GRAY8> tinyImage(3, 2);
+      tinyImage = 17;
+      outputImage = adaptiveHistogramEqualize(tinyImage, 2.0, 8, 8);
+      BRICK_TEST_ASSERT(outputImage.rows() == 3);
+      BRICK_TEST_ASSERT(outputImage.columns() == 2);
+    }
+
+
+    void
+    HistogramEqualizeTest::
+    testAdaptiveHistogramEqualize16()
+    {
+      // A low contrast 16-bit image should have its contrast
+      // stretched, and the result must not depend on threading.
+      Image<GRAY16> inputImage = this->getTestImage16(120, 160, 30000, 200);
+      Image<GRAY16> referenceImage =
+        adaptiveHistogramEqualize(inputImage, 0.0, 3, 4, 1);
+      Image<GRAY16> outputImage =
+        adaptiveHistogramEqualize(inputImage, 0.0, 3, 4, 3);
+      brick::common::UInt16 minimum = 65535;
+      brick::common::UInt16 maximum = 0;
+      for(size_t ii = 0; ii < inputImage.size(); ++ii) {
+        BRICK_TEST_ASSERT(outputImage[ii] == referenceImage[ii]);
+        minimum = std::min(minimum, outputImage[ii]);
+        maximum = std::max(maximum, outputImage[ii]);
+      }
+      BRICK_TEST_ASSERT(minimum < 5000);
+      BRICK_TEST_ASSERT(maximum > 60000);
+    }
+
+
+    void
+    HistogramEqualizeTest::
+    testExceptions()
+    {
+      Image<GRAY8> inputImage(10, 10);
+      inputImage = 0;
+      BRICK_TEST_ASSERT_EXCEPTION(
+        brick::common::ValueException,
+        adaptiveHistogramEqualize(inputImage, 2.0, 0, 4));
+      BRICK_TEST_ASSERT_EXCEPTION(
+        brick::common::ValueException,
+        adaptiveHistogramEqualize(inputImage, -1.0, 4, 4));
+
+      Image<GRAY_FLOAT32> floatImage(10, 10);
+      floatImage = 0.0;
+      BRICK_TEST_ASSERT_EXCEPTION(
+        brick::common::ValueException,
+        getHistogram(floatImage, 0, 0.0, 1.0));
+      BRICK_TEST_ASSERT_EXCEPTION(
+        brick::common::ValueException,
+        getHistogram(floatImage, 10, 1.0, 1.0));
+    }
+
+
+    void
+    HistogramEqualizeTest::
+    testExecutionTime()
+    {
+      // 20 Mpixel test images.
+      size_t const rows = 4000;
+      size_t const columns = 5000;
+      Image<GRAY16> image16 = this->getTestImage16(rows, columns, 0, 4096);
+      Image<GRAY8> image8(rows, columns);
+      for(size_t ii = 0; ii < image8.size(); ++ii) {
+        image8[ii] = static_cast<brick::common::UInt8>(image16[ii] >> 4);
+      }
+      Image<GRAY8> uniformImage(rows, columns);
+      uniformImage = 128;
+
+      // Single-counter loop, for comparison.
+      double startTime = brick::utilities::getCurrentTime();
+      numeric::Array1D<brick::common::UInt32> histogram(256);
+      histogram = 0;
+      for(size_t ii = 0; ii < uniformImage.size(); ++ii) {
+        ++(histogram[uniformImage[ii]]);
+      }
+      double stopTime = brick::utilities::getCurrentTime();
+      std::cout << "Single counter, uniform 8-bit: "
+                << stopTime - startTime << " s" << std::endl;
+
+      startTime = brick::utilities::getCurrentTime();
+      histogram = getHistogram(uniformImage);
+      stopTime = brick::utilities::getCurrentTime();
+      std::cout << "getHistogram(), uniform 8-bit: "
+                << stopTime - startTime << " s" << std::endl;
+
+      startTime = brick::utilities::getCurrentTime();
+      histogram = getHistogram(image8, 0);
+      stopTime = brick::utilities::getCurrentTime();
+      std::cout << "getHistogram(), 8-bit, all threads: "
+                << stopTime - startTime << " s" << std::endl;
+
+      startTime = brick::utilities::getCurrentTime();
+      histogram = getHistogram(image16, 0);
+      stopTime = brick::utilities::getCurrentTime();
+      std::cout << "getHistogram(), 16-bit, all threads: "
+                << stopTime - startTime << " s" << std::endl;
+
+      startTime = brick::utilities::getCurrentTime();
+      Image<GRAY8> output8 = adaptiveHistogramEqualize(image8, 4.0, 8, 8, 0);
+      stopTime = brick::utilities::getCurrentTime();
+      std::cout << "adaptiveHistogramEqualize(), 8-bit, all threads: "
+                << stopTime - startTime << " s" << std::endl;
+
+      startTime = brick::utilities::getCurrentTime();
+      Image<GRAY16> output16 = adaptiveHistogramEqualize(image16, 4.0, 8, 8, 0);
+      stopTime = brick::utilities::getCurrentTime();
+      std::cout << "adaptiveHistogramEqualize(), 16-bit, all threads: "
+                << stopTime - startTime << " s" << std::endl;
+    }
+
+
+    Image<GRAY16>
+    HistogramEqualizeTest::
+    getTestImage16(size_t rows, size_t columns, unsigned int offset,
+                   unsigned int range)
+    {
+      // Simple linear congruential generator, so that results are
+      // repeatable across platforms.
+      Image<GRAY16> image(rows, columns);
+      brick::common::UInt32 state = 12345;
+      for(size_t ii = 0; ii < image.size(); ++ii) {
+        state = state * 1664525u + 1013904223u;
+        image[ii] = static_cast<brick::common::UInt16>(
+          offset + (state >> 8) % range);
+      }
+      return image;
+    }
+
+  } // namespace computerVision
+
+} // namespace brick
+
+
+#if 0
+
+int main(int argc, char** argv)
+{
+  brick::computerVision::HistogramEqualizeTest currentTest;
+  bool result = currentTest.run();
+  return (result ? 0 : 1);
+}
+
+#else
+
+namespace {
+
+  brick::computerVision::HistogramEqualizeTest currentTest;
+
+}
+
+#endif
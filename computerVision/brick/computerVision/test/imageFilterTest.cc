@@ -42,6 +42,8 @@ namespace brick {
       void testFilter2D_nonSeparable();
       void testFilter2D_separable_i();
       void testFilter2D_separable();
+      void testDecomposeKernel();
+      void testFilter2D_methods();
       void testFilterColumnsBinomial();
       void testFilterRowsBinomial();
 
@@ -79,6 +81,8 @@ namespace brick {
       BRICK_TEST_REGISTER_MEMBER(testFilter2D_nonSeparable);
       BRICK_TEST_REGISTER_MEMBER(testFilter2D_separable_i);
       BRICK_TEST_REGISTER_MEMBER(testFilter2D_separable);
+      BRICK_TEST_REGISTER_MEMBER(testDecomposeKernel);
+      BRICK_TEST_REGISTER_MEMBER(testFilter2D_methods);
       BRICK_TEST_REGISTER_MEMBER(testFilterColumnsBinomial);
       BRICK_TEST_REGISTER_MEMBER(testFilterRowsBinomial);
     }
@@ -242,6 +246,134 @@ namespace brick {
     }
 
 
+    void
+    ImageFilterTest::
+    testDecomposeKernel()
+    {
+      // An outer product should decompose into a single term.
+      numeric::Array1D<double> kernelRow("[1.0, 3.0, 4.0, -2.0]");
+      numeric::Array1D<double> kernelColumn("[3.0, 0.0, 2.0, 4.0, 1.0]");
+      Kernel<double> separableKernel(kernelRow, kernelColumn);
+      Kernel<double> kernel0(separableKernel.getArray2D());
+      BRICK_TEST_ASSERT(!kernel0.isSeparable());
+      std::vector< Kernel<double> > terms = decomposeKernel(kernel0, 1.0E-9);
+      BRICK_TEST_ASSERT(terms.size() == 1);
+      BRICK_TEST_ASSERT(terms[0].isSeparable());
+      BRICK_TEST_ASSERT(terms[0].getRows() == kernelColumn.size());
+      BRICK_TEST_ASSERT(terms[0].getColumns() == kernelRow.size());
+      numeric::Array2D<double> referenceArray = kernel0.getArray2D();
+      numeric::Array2D<double> termArray = terms[0].getArray2D();
+      double tolerance = 1.0E-10;
+      for(size_t ii = 0; ii < referenceArray.size(); ++ii) {
+        BRICK_TEST_ASSERT(
+          approximatelyEqual(termArray[ii], referenceArray[ii], tolerance));
+      }
+
+      // Kernels that are already separable are passed through.
+      terms = decomposeKernel(separableKernel);
+      BRICK_TEST_ASSERT(terms.size() == 1);
+      BRICK_TEST_ASSERT(terms[0].isSeparable());
+
+      // A difference of Gaussians has rank two.  A generic kernel
+      // needs every term, and the sum of the terms should reproduce
+      // it.
+      numeric::Array2D<double> dogArray(7, 7);
+      numeric::Array2D<double> genericArray(7, 9);
+      for(size_t row = 0; row < dogArray.rows(); ++row) {
+        for(size_t column = 0; column < dogArray.columns(); ++column) {
+          double rr = double(row) - 3.0;
+          double cc = double(column) - 3.0;
+          dogArray(row, column) = (std::exp(-(rr * rr + cc * cc) / 2.0)
+                                   - std::exp(-(rr * rr + cc * cc) / 8.0));
+        }
+      }
+      for(size_t ii = 0; ii < genericArray.size(); ++ii) {
+        genericArray[ii] = std::sin(0.7 * double(ii * ii));
+      }
+      terms = decomposeKernel(Kernel<double>(dogArray), 1.0E-9);
+      BRICK_TEST_ASSERT(terms.size() == 2);
+      terms = decomposeKernel(Kernel<double>(genericArray), 1.0E-9);
+      BRICK_TEST_ASSERT(terms.size() == 7);
+      numeric::Array2D<double> sumArray(genericArray.rows(),
+                                        genericArray.columns());
+      sumArray = 0.0;
+      for(size_t ii = 0; ii < terms.size(); ++ii) {
+        sumArray += terms[ii].getArray2D();
+      }
+      for(size_t ii = 0; ii < genericArray.size(); ++ii) {
+        BRICK_TEST_ASSERT(
+          approximatelyEqual(sumArray[ii], genericArray[ii], tolerance));
+      }
+
+      // Loosening the tolerance, or limiting the rank, should drop
+      // terms.
+      terms = decomposeKernel(Kernel<double>(genericArray), 0.9);
+      BRICK_TEST_ASSERT(terms.size() < 7);
+      terms = decomposeKernel(Kernel<double>(genericArray), 1.0E-9, 3);
+      BRICK_TEST_ASSERT(terms.size() == 3);
+    }
+
+
+    void
+    ImageFilterTest::
+    testFilter2D_methods()
+    {
+      Image<GRAY8> inputImage = readPGM8(getTestImageFileNamePGM0());
+      numeric::Array2D<double> kernelData(9, 11);
+      for(size_t row = 0; row < kernelData.rows(); ++row) {
+        for(size_t column = 0; column < kernelData.columns(); ++column) {
+          double rr = double(row) - 4.0;
+          double cc = double(column) - 5.0;
+          kernelData(row, column) =
+            (std::exp(-(rr * rr + cc * cc) / 4.0)
+             - 0.5 * std::exp(-(rr * rr + 0.5 * cc * cc + rr * cc) / 12.0));
+        }
+      }
+      Kernel<double> kernel0(kernelData);
+      Image<GRAY_FLOAT64> inputImage0(inputImage.rows(), inputImage.columns());
+      inputImage0.copy(inputImage);
+      Image<GRAY_FLOAT64> referenceImage = localFilter2D(
+        kernelData, inputImage0);
+
+      Filter2DMethod methods[] = {
+        FILTER2D_DIRECT, FILTER2D_LOW_RANK, FILTER2D_FFT, FILTER2D_AUTO};
+      unsigned int threadCounts[] = {1, 3};
+      double tolerance = 1.0E-8;
+      for(size_t ii = 0; ii < 4; ++ii) {
+        for(size_t jj = 0; jj < 2; ++jj) {
+          Image<GRAY_FLOAT64> resultImage;
+          Filter2DMethod usedMethod = filter2D(
+            resultImage, kernel0, inputImage, 0.0, methods[ii],
+            1.0E-12, threadCounts[jj]);
+          BRICK_TEST_ASSERT(usedMethod != FILTER2D_AUTO);
+          BRICK_TEST_ASSERT(methods[ii] == FILTER2D_AUTO
+                            || usedMethod == methods[ii]);
+          BRICK_TEST_ASSERT(resultImage.rows() == referenceImage.rows());
+          BRICK_TEST_ASSERT(
+            resultImage.columns() == referenceImage.columns());
+          for(size_t kk = 0; kk < resultImage.size(); ++kk) {
+            BRICK_TEST_ASSERT(
+              approximatelyEqual(
+                resultImage[kk], referenceImage[kk], tolerance));
+          }
+        }
+      }
+
+      // Border pixels should get fillValue.
+      Image<GRAY_FLOAT64> resultImage;
+      filter2D(resultImage, kernel0, inputImage, -1.0, FILTER2D_LOW_RANK,
+               1.0E-12);
+      BRICK_TEST_ASSERT(resultImage(0, 0) == -1.0);
+      BRICK_TEST_ASSERT(resultImage(3, 20) == -1.0);
+      BRICK_TEST_ASSERT(resultImage(20, 4) == -1.0);
+      BRICK_TEST_ASSERT(resultImage(resultImage.rows() - 4, 20) == -1.0);
+      BRICK_TEST_ASSERT(resultImage(20, resultImage.columns() - 5) == -1.0);
+      BRICK_TEST_ASSERT(
+        approximatelyEqual(resultImage(4, 5), referenceImage(4, 5),
+                           tolerance));
+    }
+
+
     void
     ImageFilterTest::
     testFilterColumnsBinomial()
@@ -10,6 +10,8 @@
 ***************************************************************************
 **/
 
+#include <algorithm>
+#include <cmath>
 #include <brick/computerVision/imageWarper.hh>
 #include <brick/test/testFixture.hh>
 
@@ -33,6 +35,7 @@ namespace brick {
       // Tests.
       void testImageWarper();
       void testImageWarperRGB();
+      void testImageWarperCompact();
 
     private:
 
@@ -47,6 +50,23 @@ namespace brick {
         num::Vector2D<FloatType> m_shift;
       };
 
+      template <class FloatType>
+      struct RadialWarpFunctor {
+        RadialWarpFunctor(FloatType xCenter, FloatType yCenter,
+                          FloatType kappa)
+          : m_center(xCenter, yCenter), m_kappa(kappa) {}
+
+        num::Vector2D<FloatType>
+        operator()(num::Vector2D<FloatType> const& arg) const {
+          num::Vector2D<FloatType> offset = arg - m_center;
+          FloatType r2 = offset.x() * offset.x() + offset.y() * offset.y();
+          return m_center + offset * (FloatType(1.0) + m_kappa * r2);
+        }
+
+        num::Vector2D<FloatType> m_center;
+        FloatType m_kappa;
+      };
+
       template <class FloatType>
       struct StretchXWarpFunctor {
         StretchXWarpFunctor(FloatType stretchFactor)
@@ -96,6 +116,7 @@ namespace brick {
     {
       BRICK_TEST_REGISTER_MEMBER(testImageWarper);
       BRICK_TEST_REGISTER_MEMBER(testImageWarperRGB);
+      BRICK_TEST_REGISTER_MEMBER(testImageWarperCompact);
     }
 
 
@@ -313,6 +334,113 @@ namespace brick {
       }
     }
 
+    void
+    ImageWarperTest::
+    testImageWarperCompact()
+    {
+      // Smoothly varying test images, so that quantization of the
+      // interpolation weights has a bounded effect.
+      size_t const rows = 97;
+      size_t const columns = 131;
+      Image<GRAY8> grayImage(rows, columns);
+      Image<GRAY_FLOAT64> floatImage(rows, columns);
+      Image<RGB8> rgbImage(rows, columns);
+      for(size_t row = 0; row < rows; ++row) {
+        for(size_t column = 0; column < columns; ++column) {
+          common::UInt8 value = static_cast<common::UInt8>(
+            (row * 7 + column * 3) % 256);
+          grayImage(row, column) = value;
+          floatImage(row, column) = value;
+          rgbImage(row, column) = PixelRGB8(
+            value, static_cast<common::UInt8>(2 * column),
+            static_cast<common::UInt8>(255 - row));
+        }
+      }
+
+      // Barrel distortion, as for lens undistortion.  The output
+      // image is bigger than the input, so some pixels map out of
+      // bounds.
+      size_t const outputRows = 120;
+      size_t const outputColumns = 300;
+      RadialWarpFunctor<common::Float64> radialWarpFunctor(
+        70.0, 45.0, 2.0E-5);
+      ImageWarper< common::Float64, RadialWarpFunctor<common::Float64> >
+        fullWarper(rows, columns, outputRows, outputColumns,
+                   radialWarpFunctor);
+      ImageWarper< common::Float64, RadialWarpFunctor<common::Float64> >
+        compactWarper(rows, columns, outputRows, outputColumns,
+                      radialWarpFunctor, true);
+      BRICK_TEST_ASSERT(!fullWarper.isCompact());
+      BRICK_TEST_ASSERT(compactWarper.isCompact());
+
+      Image<GRAY_FLOAT64> referenceImage =
+        fullWarper.warpImage<GRAY_FLOAT64, GRAY_FLOAT64>(floatImage, -1.0);
+      Image<GRAY_FLOAT64> floatResult =
+        compactWarper.warpImage<GRAY_FLOAT64, GRAY_FLOAT64>(floatImage, -1.0);
+      Image<GRAY8> grayResult =
+        compactWarper.warpImage<GRAY8, GRAY8>(grayImage, 0);
+      Image<RGB8> rgbResult = compactWarper.warpImage<RGB8, RGB8>(
+        rgbImage, PixelRGB8(1, 2, 3));
+
+      size_t numberOfInBoundsPixels = 0;
+      for(size_t row = 0; row < outputRows; ++row) {
+        for(size_t column = 0; column < outputColumns; ++column) {
+          num::Vector2D<common::Float64> inputCoord =
+            radialWarpFunctor(num::Vector2D<common::Float64>(column, row));
+          if(!this->isInBounds(inputCoord, floatImage)) {
+            BRICK_TEST_ASSERT(referenceImage(row, column) == -1.0);
+            BRICK_TEST_ASSERT(floatResult(row, column) == -1.0);
+            BRICK_TEST_ASSERT(grayResult(row, column) == 0);
+            BRICK_TEST_ASSERT(rgbResult(row, column) == PixelRGB8(1, 2, 3));
+            continue;
+          }
+          ++numberOfInBoundsPixels;
+
+          // Skip pixels that straddle the wraparound in the test
+          // pattern, where interpolation error is magnified.
+          size_t row0 = static_cast<size_t>(inputCoord.y());
+          size_t column0 = static_cast<size_t>(inputCoord.x());
+          common::Float64 patternStep = std::fabs(
+            floatImage(row0 + 1, column0 + 1) - floatImage(row0, column0));
+          if(patternStep > 20.0) {
+            continue;
+          }
+
+          // 16-bit fractions for floating point formats.
+          BRICK_TEST_ASSERT(
+            approximatelyEqual(floatResult(row, column),
+                               referenceImage(row, column), 1.0E-3));
+
+          // 8-bit fractions and integer rounding for GRAY8 and RGB8.
+          BRICK_TEST_ASSERT(
+            std::fabs(grayResult(row, column) - referenceImage(row, column))
+            <= 0.6);
+          BRICK_TEST_ASSERT(rgbResult(row, column).red
+                            == grayResult(row, column));
+        }
+      }
+      BRICK_TEST_ASSERT(numberOfInBoundsPixels > outputRows * outputColumns / 4);
+      BRICK_TEST_ASSERT(
+        numberOfInBoundsPixels < outputRows * outputColumns);
+
+      // Results should not depend on the number of threads.
+      for(unsigned int numberOfThreads = 2; numberOfThreads <= 4;
+          ++numberOfThreads) {
+        Image<GRAY_FLOAT64> referenceImage2 =
+          fullWarper.warpImage<GRAY_FLOAT64, GRAY_FLOAT64>(
+            floatImage, -1.0, numberOfThreads);
+        Image<RGB8> rgbResult2 = compactWarper.warpImage<RGB8, RGB8>(
+          rgbImage, PixelRGB8(1, 2, 3), numberOfThreads);
+        BRICK_TEST_ASSERT(
+          std::equal(referenceImage2.begin(), referenceImage2.end(),
+                     referenceImage.begin()));
+        BRICK_TEST_ASSERT(
+          std::equal(rgbResult2.begin(), rgbResult2.end(),
+                     rgbResult.begin()));
+      }
+    }
+
+
     template <ImageFormat Format, class FloatType>
     bool
     ImageWarperTest::
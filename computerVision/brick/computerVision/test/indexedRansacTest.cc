@@ -0,0 +1,235 @@
+/**
+***************************************************************************
+* @file brick/computerVision/indexedRansacTest.cc
+*
+* Source file defining tests for the IndexedRansac class template.
+*
+* Copyright (C) 2026 David LaRose, dlr@cs.cmu.edu
+* See accompanying file, LICENSE.TXT, for details.
+*
+***************************************************************************
+**/
+
+#include <cmath>
+#include <utility>
+#include <vector>
+#include <brick/computerVision/ransacClassInterface.hh>
+#include <brick/numeric/vector2D.hh>
+#include <brick/test/testFixture.hh>
+
+namespace num = brick::numeric;
+
+namespace brick {
+
+  namespace computerVision {
+
+    class IndexedRansacTest
+      : public brick::test::TestFixture<IndexedRansacTest> {
+
+    public:
+
+      IndexedRansacTest();
+      ~IndexedRansacTest() {}
+
+      void setUp(const std::string& /* testName */) {}
+      void tearDown(const std::string& /* testName */) {}
+
+      // Tests.
+      void testGetResult();
+      void testGetResultProsac();
+
+    private:
+
+      // Builds a set of points on the line y = 2x + 1, with some
+      // noise, followed by a set of outliers, all of which are at
+      // least 0.5 away from the line.
+      std::vector< num::Vector2D<double> >
+      getTestPoints();
+
+      double m_defaultTolerance;
+      size_t m_numberOfInliers;
+      size_t m_numberOfOutliers;
+
+    }; // class IndexedRansacTest
+
+
+    /* ===== Declarations for a simple IndexedRansac Problem ====== */
+
+    // Estimates a line, represented as (slope, intercept), from a
+    // collection of 2D points.
+    class IndexedLineFittingProblem
+      : public IndexedRansacProblem< num::Vector2D<double>,
+                                     std::pair<double, double> >
+    {
+    public:
+
+      template <class IterType>
+      IndexedLineFittingProblem(IterType beginIter, IterType endIter)
+        : IndexedRansacProblem< num::Vector2D<double>,
+                                std::pair<double, double> >(
+                                  2, beginIter, endIter) {}
+
+
+      // Least squares fit to the indicated points.
+      std::pair<double, double>
+      estimateModel(size_t const* indexBegin, size_t const* indexEnd) {
+        double sumX = 0.0;
+        double sumY = 0.0;
+        double sumXX = 0.0;
+        double sumXY = 0.0;
+        double count = static_cast<double>(indexEnd - indexBegin);
+        while(indexBegin != indexEnd) {
+          num::Vector2D<double> const& point = this->getSample(*indexBegin);
+          sumX += point.x();
+          sumY += point.y();
+          sumXX += point.x() * point.x();
+          sumXY += point.x() * point.y();
+          ++indexBegin;
+        }
+        double slope = ((count * sumXY - sumX * sumY)
+                        / (count * sumXX - sumX * sumX));
+        double intercept = (sumY - slope * sumX) / count;
+        return std::make_pair(slope, intercept);
+      }
+
+
+      // Vertical distance from each point to the line.
+      void
+      computeError(std::pair<double, double> const& model,
+                   double* outputPtr) {
+        for(size_t ii = 0; ii < this->getPoolSize(); ++ii) {
+          num::Vector2D<double> const& point = this->getSample(ii);
+          outputPtr[ii] = std::fabs(
+            point.y() - (model.first * point.x() + model.second));
+        }
+      }
+
+
+      double
+      getNaiveErrorThreshold() {return 0.1;}
+
+    };
+
+
+    /* ============== Member Function Definititions ============== */
+
+    IndexedRansacTest::
+    IndexedRansacTest()
+      : brick::test::TestFixture<IndexedRansacTest>("IndexedRansacTest"),
+        m_defaultTolerance(1.0E-2),
+        m_numberOfInliers(60),
+        m_numberOfOutliers(40)
+    {
+      BRICK_TEST_REGISTER_MEMBER(testGetResult);
+      BRICK_TEST_REGISTER_MEMBER(testGetResultProsac);
+    }
+
+
+    void
+    IndexedRansacTest::
+    testGetResult()
+    {
+      std::vector< num::Vector2D<double> > points = this->getTestPoints();
+      IndexedLineFittingProblem problem(points.begin(), points.end());
+      problem.setSeed(2026);
+
+      // Require nearly all of the inliers so that RANSAC keeps going
+      // until it finds the right answer.
+      IndexedRansac<IndexedLineFittingProblem> ransac(
+        problem, m_numberOfInliers - 2, 0.999, 0.5);
+      ransac.setBatchSize(7);
+      std::pair<double, double> model = ransac.getResult();
+      BRICK_TEST_ASSERT(
+        approximatelyEqual(model.first, 2.0, m_defaultTolerance));
+      BRICK_TEST_ASSERT(
+        approximatelyEqual(model.second, 1.0, m_defaultTolerance));
+
+      std::vector<size_t> consensusSet = ransac.getConsensusSet(model);
+      BRICK_TEST_ASSERT(consensusSet.size() == m_numberOfInliers);
+      for(size_t ii = 0; ii < consensusSet.size(); ++ii) {
+        BRICK_TEST_ASSERT(consensusSet[ii] == ii);
+      }
+
+      BRICK_TEST_ASSERT_EXCEPTION(common::ValueException,
+                                  ransac.setBatchSize(0));
+      BRICK_TEST_ASSERT_EXCEPTION(
+        common::ValueException,
+        IndexedRansac<IndexedLineFittingProblem>(problem, 0, 1.0, 0.5));
+    }
+
+
+    void
+    IndexedRansacTest::
+    testGetResultProsac()
+    {
+      std::vector< num::Vector2D<double> > points = this->getTestPoints();
+      IndexedLineFittingProblem problem(points.begin(), points.end());
+      problem.setSeed(7);
+
+      // Mostly accurate quality scores: inliers score higher, except
+      // for a few.
+      std::vector<double> quality(points.size());
+      for(size_t ii = 0; ii < quality.size(); ++ii) {
+        quality[ii] = (ii < m_numberOfInliers) ? 1.0 : 0.0;
+        quality[ii] += 0.01 * static_cast<double>((ii * 37) % 11);
+      }
+      quality[3] = -1.0;
+      quality[m_numberOfInliers + 5] = 1.05;
+      problem.setSampleQuality(quality.begin(), quality.end());
+
+      // With good quality scores, the very first hypothesis is built
+      // from inliers, so a single iteration suffices.
+      IndexedRansac<IndexedLineFittingProblem> ransac(
+        problem, m_numberOfInliers - 2, 0.999, 0.5);
+      ransac.setNumberOfRandomSampleSets(1);
+      std::pair<double, double> model = ransac.getResult();
+      BRICK_TEST_ASSERT(
+        approximatelyEqual(model.first, 2.0, m_defaultTolerance));
+      BRICK_TEST_ASSERT(
+        approximatelyEqual(model.second, 1.0, m_defaultTolerance));
+    }
+
+
+    std::vector< num::Vector2D<double> >
+    IndexedRansacTest::
+    getTestPoints()
+    {
+      std::vector< num::Vector2D<double> > points;
+      for(size_t ii = 0; ii < m_numberOfInliers; ++ii) {
+        double xx = 0.1 * static_cast<double>(ii) - 3.0;
+        double noise = 0.02 * std::sin(17.0 * static_cast<double>(ii));
+        points.push_back(num::Vector2D<double>(xx, 2.0 * xx + 1.0 + noise));
+      }
+      for(size_t ii = 0; ii < m_numberOfOutliers; ++ii) {
+        double xx = 0.13 * static_cast<double>(ii) - 2.5;
+        double offset = 0.5 + 2.0 * std::fabs(
+          std::cos(3.0 * static_cast<double>(ii)));
+        double yy = 2.0 * xx + 1.0 + ((ii % 2) ? offset : -offset);
+        points.push_back(num::Vector2D<double>(xx, yy));
+      }
+      return points;
+    }
+
+  } // namespace computerVision
+
+} // namespace brick
+
+
+#if 0
+
+int main(int argc, char** argv)
+{
+  brick::computerVision::IndexedRansacTest currentTest;
+  bool result = currentTest.run();
+  return (result ? 0 : 1);
+}
+
+#else
+
+namespace {
+
+  brick::computerVision::IndexedRansacTest currentTest;
+
+}
+
+#endif
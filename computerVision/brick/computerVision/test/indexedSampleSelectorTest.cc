@@ -0,0 +1,299 @@
+/**
+***************************************************************************
+* @file brick/computerVision/indexedSampleSelectorTest.cc
+*
+* Source file defining tests for IndexedSampleSelector.
+*
+* Copyright (C) 2026 David LaRose, dlr@cs.cmu.edu
+* See accompanying file, LICENSE.TXT, for details.
+*
+***************************************************************************
+**/
+
+#include <vector>
+#include <brick/common/exception.hh>
+#include <brick/computerVision/indexedSampleSelector.hh>
+#include <brick/numeric/array2D.hh>
+#include <brick/test/testFixture.hh>
+
+namespace brick {
+
+  namespace computerVision {
+
+    class IndexedSampleSelectorTest
+      : public brick::test::TestFixture<IndexedSampleSelectorTest> {
+
+    public:
+
+      IndexedSampleSelectorTest();
+      ~IndexedSampleSelectorTest() {}
+
+      void setUp(const std::string& /* testName */) {}
+      void tearDown(const std::string& /* testName */) {}
+
+      // Tests.
+      void testConstructor();
+      void testGetSampleIndices();
+      void testSetSampleQuality();
+      void testSetSeed();
+
+    private:
+
+      bool
+      isValidIndexSet(brick::numeric::Array2D<size_t> const& sampleIndices,
+                      size_t row, size_t poolSize);
+
+      std::vector<int>
+      getTestVector(size_t numberOfElements);
+
+    }; // class IndexedSampleSelectorTest
+
+
+    /* ============== Member Function Definititions ============== */
+
+    IndexedSampleSelectorTest::
+    IndexedSampleSelectorTest()
+      : brick::test::TestFixture<IndexedSampleSelectorTest>(
+        "IndexedSampleSelectorTest")
+    {
+      BRICK_TEST_REGISTER_MEMBER(testConstructor);
+      BRICK_TEST_REGISTER_MEMBER(testGetSampleIndices);
+      BRICK_TEST_REGISTER_MEMBER(testSetSampleQuality);
+      BRICK_TEST_REGISTER_MEMBER(testSetSeed);
+    }
+
+
+    void
+    IndexedSampleSelectorTest::
+    testConstructor()
+    {
+      std::vector<int> testVector = this->getTestVector(10);
+      IndexedSampleSelector<int> selector(
+        3, testVector.begin(), testVector.end());
+      BRICK_TEST_ASSERT(selector.getPoolSize() == testVector.size());
+      BRICK_TEST_ASSERT(selector.getSampleSize() == 3);
+      for(size_t ii = 0; ii < testVector.size(); ++ii) {
+        BRICK_TEST_ASSERT(selector.getSample(ii) == testVector[ii]);
+      }
+
+      BRICK_TEST_ASSERT_EXCEPTION(
+        brick::common::ValueException,
+        IndexedSampleSelector<int>(0, testVector.begin(), testVector.end()));
+      BRICK_TEST_ASSERT_EXCEPTION(
+        brick::common::ValueException,
+        IndexedSampleSelector<int>(11, testVector.begin(), testVector.end()));
+    }
+
+
+    void
+    IndexedSampleSelectorTest::
+    testGetSampleIndices()
+    {
+      size_t const poolSize = 20;
+      size_t const sampleSize = 4;
+      size_t const numberOfSampleSets = 5000;
+      std::vector<int> testVector = this->getTestVector(poolSize);
+      IndexedSampleSelector<int> selector(
+        sampleSize, testVector.begin(), testVector.end());
+      selector.setSeed(12345);
+
+      // Draw in a few batches, reusing the same array.
+      brick::numeric::Array2D<size_t> sampleIndices;
+      std::vector<size_t> counts(poolSize, 0);
+      for(size_t batch = 0; batch < 5; ++batch) {
+        selector.getSampleIndices(numberOfSampleSets / 5, sampleIndices);
+        BRICK_TEST_ASSERT(sampleIndices.rows() == numberOfSampleSets / 5);
+        BRICK_TEST_ASSERT(sampleIndices.columns() == sampleSize);
+        for(size_t row = 0; row < sampleIndices.rows(); ++row) {
+          BRICK_TEST_ASSERT(
+            this->isValidIndexSet(sampleIndices, row, poolSize));
+          for(size_t column = 0; column < sampleSize; ++column) {
+            ++counts[sampleIndices(row, column)];
+          }
+        }
+      }
+
+      // Each index is expected to appear 1000 times.  The standard
+      // deviation is about 28, so this is a loose test.
+      for(size_t ii = 0; ii < poolSize; ++ii) {
+        BRICK_TEST_ASSERT(counts[ii] > 850);
+        BRICK_TEST_ASSERT(counts[ii] < 1150);
+      }
+
+      // Sampling the whole population should give a permutation.
+      IndexedSampleSelector<int> fullSelector(
+        poolSize, testVector.begin(), testVector.end());
+      fullSelector.getSampleIndices(10, sampleIndices);
+      for(size_t row = 0; row < sampleIndices.rows(); ++row) {
+        BRICK_TEST_ASSERT(
+          this->isValidIndexSet(sampleIndices, row, poolSize));
+      }
+    }
+
+
+    void
+    IndexedSampleSelectorTest::
+    testSetSampleQuality()
+    {
+      size_t const poolSize = 20;
+      size_t const sampleSize = 4;
+      std::vector<int> testVector = this->getTestVector(poolSize);
+      IndexedSampleSelector<int> selector(
+        sampleSize, testVector.begin(), testVector.end());
+      selector.setSeed(54321);
+
+      // Quality increases with index, so index (poolSize - 1 - rank)
+      // has quality rank "rank."
+      std::vector<double> quality(poolSize);
+      for(size_t ii = 0; ii < poolSize; ++ii) {
+        quality[ii] = static_cast<double>(ii);
+      }
+      selector.setSampleQuality(quality.begin(), quality.end());
+
+      brick::numeric::Array2D<size_t> sampleIndices;
+      selector.getSampleIndices(100, sampleIndices);
+
+      // The first index set is exactly the top sampleSize samples.
+      std::vector<bool> isPresent(poolSize, false);
+      for(size_t column = 0; column < sampleSize; ++column) {
+        isPresent[sampleIndices(0, column)] = true;
+      }
+      for(size_t rank = 0; rank < sampleSize; ++rank) {
+        BRICK_TEST_ASSERT(isPresent[poolSize - 1 - rank]);
+      }
+
+      // With the default growth schedule, the next 100 or so index
+      // sets are drawn from the top five samples, and must include
+      // the fifth.
+      for(size_t row = 1; row < sampleIndices.rows(); ++row) {
+        BRICK_TEST_ASSERT(
+          this->isValidIndexSet(sampleIndices, row, poolSize));
+        bool includesNewest = false;
+        for(size_t column = 0; column < sampleSize; ++column) {
+          size_t rank = poolSize - 1 - sampleIndices(row, column);
+          BRICK_TEST_ASSERT(rank < sampleSize + 1);
+          if(rank == sampleSize) {
+            includesNewest = true;
+          }
+        }
+        BRICK_TEST_ASSERT(includesNewest);
+      }
+
+      // Eventually, every sample gets used.  With the default
+      // schedule, that takes a long time, so speed things up.
+      selector.setSampleQuality(quality.begin(), quality.end(), 2000);
+      selector.getSampleIndices(20000, sampleIndices);
+      std::vector<size_t> counts(poolSize, 0);
+      for(size_t row = 0; row < sampleIndices.rows(); ++row) {
+        BRICK_TEST_ASSERT(
+          this->isValidIndexSet(sampleIndices, row, poolSize));
+        for(size_t column = 0; column < sampleSize; ++column) {
+          ++counts[sampleIndices(row, column)];
+        }
+      }
+      for(size_t ii = 0; ii < poolSize; ++ii) {
+        BRICK_TEST_ASSERT(counts[ii] > 0);
+      }
+
+      // Restarting the schedule goes back to the top samples.
+      selector.resetSampling();
+      selector.getSampleIndices(1, sampleIndices);
+      for(size_t column = 0; column < sampleSize; ++column) {
+        BRICK_TEST_ASSERT(sampleIndices(0, column) >= poolSize - sampleSize);
+      }
+
+      BRICK_TEST_ASSERT_EXCEPTION(
+        brick::common::ValueException,
+        selector.setSampleQuality(quality.begin(), quality.end() - 1));
+    }
+
+
+    void
+    IndexedSampleSelectorTest::
+    testSetSeed()
+    {
+      std::vector<int> testVector = this->getTestVector(50);
+      IndexedSampleSelector<int> selector0(
+        7, testVector.begin(), testVector.end());
+      IndexedSampleSelector<int> selector1(
+        7, testVector.begin(), testVector.end());
+      brick::numeric::Array2D<size_t> sampleIndices0;
+      brick::numeric::Array2D<size_t> sampleIndices1;
+
+      // Same seed, same sequence, even if one selector has already
+      // been used.
+      selector0.getSampleIndices(13, sampleIndices0);
+      selector0.setSeed(99);
+      selector1.setSeed(99);
+      selector0.getSampleIndices(200, sampleIndices0);
+      selector1.getSampleIndices(200, sampleIndices1);
+      for(size_t ii = 0; ii < sampleIndices0.size(); ++ii) {
+        BRICK_TEST_ASSERT(sampleIndices0[ii] == sampleIndices1[ii]);
+      }
+
+      // Different seed, different sequence.
+      selector1.setSeed(100);
+      selector1.getSampleIndices(200, sampleIndices1);
+      size_t numberOfDifferences = 0;
+      for(size_t ii = 0; ii < sampleIndices0.size(); ++ii) {
+        if(sampleIndices0[ii] != sampleIndices1[ii]) {
+          ++numberOfDifferences;
+        }
+      }
+      BRICK_TEST_ASSERT(numberOfDifferences > sampleIndices0.size() / 2);
+    }
+
+
+    bool
+    IndexedSampleSelectorTest::
+    isValidIndexSet(brick::numeric::Array2D<size_t> const& sampleIndices,
+                    size_t row, size_t poolSize)
+    {
+      for(size_t column = 0; column < sampleIndices.columns(); ++column) {
+        if(sampleIndices(row, column) >= poolSize) {
+          return false;
+        }
+        for(size_t previous = 0; previous < column; ++previous) {
+          if(sampleIndices(row, column) == sampleIndices(row, previous)) {
+            return false;
+          }
+        }
+      }
+      return true;
+    }
+
+
+    std::vector<int>
+    IndexedSampleSelectorTest::
+    getTestVector(size_t numberOfElements)
+    {
+      std::vector<int> result(numberOfElements);
+      for(size_t ii = 0; ii < numberOfElements; ++ii) {
+        result[ii] = static_cast<int>(3 * ii + 1);
+      }
+      return result;
+    }
+
+  } // namespace computerVision
+
+} // namespace brick
+
+
+#if 0
+
+int main(int argc, char** argv)
+{
+  brick::computerVision::IndexedSampleSelectorTest currentTest;
+  bool result = currentTest.run();
+  return (result ? 0 : 1);
+}
+
+#else
+
+namespace {
+
+  brick::computerVision::IndexedSampleSelectorTest currentTest;
+
+}
+
+#endif
@@ -10,6 +10,8 @@
 ***************************************************************************
 **/
 
+#include <algorithm>
+#include <cmath>
 #include <iomanip>
 #include <iostream>
 
@@ -44,10 +46,16 @@ namespace brick {
 
       // Tests.
       void testKeypointSelectorBullseye();
+      void testCoarseToFine();
       void testExecutionTime();
 
     private:
 
+      Image<GRAY8>
+      drawBullseyes(brick::common::UInt32 rows, brick::common::UInt32 columns,
+                    std::vector< numeric::Vector2D<double> > const& centers,
+                    double ringWidth);
+
       double m_defaultTolerance;
 
     }; // class KeypointSelectorBullseyeTest
@@ -61,6 +69,7 @@ namespace brick {
         m_defaultTolerance(1.0E-8)
     {
       BRICK_TEST_REGISTER_MEMBER(testKeypointSelectorBullseye);
+      BRICK_TEST_REGISTER_MEMBER(testCoarseToFine);
       // BRICK_TEST_REGISTER_MEMBER(testExecutionTime);
     }
 
@@ -214,6 +223,84 @@ namespace brick {
       }
     }
 
+    void
+    KeypointSelectorBullseyeTest::
+    testCoarseToFine()
+    {
+      // Bullseyes with 8 pixel wide rings are big enough to be
+      // screened at half resolution, but not at quarter resolution.
+      std::vector< numeric::Vector2D<double> > centers;
+      for(brick::common::UInt32 ii = 0; ii < 2; ++ii) {
+        for(brick::common::UInt32 jj = 0; jj < 3; ++jj) {
+          centers.push_back(numeric::Vector2D<double>(
+                              100.0 + 200.0 * jj + 0.3 * ii,
+                              100.0 + 200.0 * ii + 0.6 * jj));
+        }
+      }
+      Image<GRAY8> inputImage = this->drawBullseyes(400, 600, centers, 8.0);
+
+      // Reference result at full resolution, single threaded.
+      KeypointSelectorBullseye<double> referenceSelector(6, 40, 12);
+      referenceSelector.setImage(inputImage);
+      std::vector< KeypointBullseye<double> > referenceKeypoints =
+        referenceSelector.getKeypointsGeneralPosition();
+      BRICK_TEST_ASSERT(referenceKeypoints.size() == centers.size());
+      KeypointSelectorBullseyeTimings timings = referenceSelector.getTimings();
+      BRICK_TEST_ASSERT(timings.screeningLevel == 0);
+      BRICK_TEST_ASSERT(timings.numberOfKeypoints == centers.size());
+      BRICK_TEST_ASSERT(timings.numberOfScreenedCandidates >= centers.size());
+      BRICK_TEST_ASSERT(timings.numberOfCandidates
+                        >= timings.numberOfScreenedCandidates);
+
+      auto rasterOrder = [](KeypointBullseye<double> const& xx,
+                            KeypointBullseye<double> const& yy) {
+        return (xx.row < yy.row - 1.0)
+        || ((xx.row < yy.row + 1.0) && (xx.column < yy.column));
+      };
+      std::sort(referenceKeypoints.begin(), referenceKeypoints.end(),
+                rasterOrder);
+      for(brick::common::UInt32 ii = 0; ii < centers.size(); ++ii) {
+        BRICK_TEST_ASSERT(
+          brick::test::approximatelyEqual(
+            referenceKeypoints[ii].row, centers[ii].y(), 0.5));
+        BRICK_TEST_ASSERT(
+          brick::test::approximatelyEqual(
+            referenceKeypoints[ii].column, centers[ii].x(), 0.5));
+      }
+
+      // Coarse-to-fine processing and multiple threads should find
+      // exactly the same bullseyes.  Asking for too many levels
+      // should silently fall back to a level that works.
+      for(brick::common::UInt32 screeningLevel = 0; screeningLevel < 3;
+          ++screeningLevel) {
+        for(brick::common::UInt32 numberOfThreads = 1; numberOfThreads < 4;
+            numberOfThreads += 2) {
+          KeypointSelectorBullseye<double> selector(6, 40, 12);
+          selector.setScreeningLevel(screeningLevel);
+          selector.setNumberOfThreads(numberOfThreads);
+          selector.setImage(inputImage);
+          std::vector< KeypointBullseye<double> > keypoints =
+            selector.getKeypointsGeneralPosition();
+          BRICK_TEST_ASSERT(
+            selector.getTimings().screeningLevel
+            == std::min(screeningLevel, brick::common::UInt32(1)));
+          BRICK_TEST_ASSERT(keypoints.size() == referenceKeypoints.size());
+          std::sort(keypoints.begin(), keypoints.end(), rasterOrder);
+          for(brick::common::UInt32 ii = 0; ii < keypoints.size(); ++ii) {
+            BRICK_TEST_ASSERT(
+              brick::test::approximatelyEqual(
+                keypoints[ii].row, referenceKeypoints[ii].row,
+                m_defaultTolerance));
+            BRICK_TEST_ASSERT(
+              brick::test::approximatelyEqual(
+                keypoints[ii].column, referenceKeypoints[ii].column,
+                m_defaultTolerance));
+          }
+        }
+      }
+    }
+
+
     void
     KeypointSelectorBullseyeTest::
     testExecutionTime()
@@ -252,6 +339,50 @@ namespace brick {
                 << t1 - t0 << " seconds" << std::endl;
     }
 
+    Image<GRAY8>
+    KeypointSelectorBullseyeTest::
+    drawBullseyes(brick::common::UInt32 rows, brick::common::UInt32 columns,
+                  std::vector< numeric::Vector2D<double> > const& centers,
+                  double ringWidth)
+    {
+      // Lightly textured background, so that the detector has some
+      // non-bullseye structure to reject.
+      Image<GRAY8> image(rows, columns);
+      for(brick::common::UInt32 rr = 0; rr < rows; ++rr) {
+        for(brick::common::UInt32 cc = 0; cc < columns; ++cc) {
+          image(rr, cc) = 180 + (rr * 7 + cc * 13) % 17;
+        }
+      }
+
+      // Dark center, light ring, dark ring, antialiased by 4x4
+      // supersampling.
+      int const extent = static_cast<int>(3.0 * ringWidth + 2.0);
+      for(auto center = centers.begin(); center != centers.end(); ++center) {
+        int const centerRow = static_cast<int>(center->y());
+        int const centerColumn = static_cast<int>(center->x());
+        for(int rr = centerRow - extent; rr <= centerRow + extent; ++rr) {
+          for(int cc = centerColumn - extent; cc <= centerColumn + extent;
+              ++cc) {
+            int darkCount = 0;
+            for(int ss = 0; ss < 16; ++ss) {
+              double dy = rr + ((ss / 4) + 0.5) / 4.0 - center->y();
+              double dx = cc + ((ss % 4) + 0.5) / 4.0 - center->x();
+              double radius = std::sqrt(dx * dx + dy * dy);
+              if(radius < ringWidth
+                 || (radius >= 2.0 * ringWidth && radius < 3.0 * ringWidth)) {
+                ++darkCount;
+              }
+            }
+            if(darkCount != 0) {
+              image(rr, cc) = static_cast<brick::common::UInt8>(
+                image(rr, cc) - (darkCount * 150) / 16);
+            }
+          }
+        }
+      }
+      return image;
+    }
+
   } // namespace computerVision
 
 } // namespace brick
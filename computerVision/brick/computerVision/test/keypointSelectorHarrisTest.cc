@@ -43,6 +43,7 @@ namespace brick {
 
       // Tests.
       void testKeypointSelectorHarris();
+      void testSetImageFused();
 
       // Legacy functions.
       void exerciseKeypointSelectorHarris(std::string const& fileName,
@@ -63,6 +64,7 @@ namespace brick {
         m_defaultTolerance(1.0E-8)
     {
       BRICK_TEST_REGISTER_MEMBER(testKeypointSelectorHarris);
+      BRICK_TEST_REGISTER_MEMBER(testSetImageFused);
     }
 
 
@@ -121,6 +123,98 @@ namespace brick {
     }
 
 
+    void
+    KeypointSelectorHarrisTest::
+    testSetImageFused()
+    {
+      // The fused implementation should find the same corners as
+      // setImage() on our synthetic test image.
+      Image<GRAY8> squareImage(100, 120);
+      squareImage = brick::common::UInt8(60);
+      squareImage.getROI(numeric::Index2D(20, 30), numeric::Index2D(60, 70)) =
+        common::UInt8(128);
+      KeypointSelectorHarris<double> referenceSelector;
+      KeypointSelectorHarris<double> selector;
+      referenceSelector.setImage(squareImage);
+      selector.setImageFused(squareImage);
+      std::vector< KeypointHarris<int> > referenceKeypoints =
+        referenceSelector.getKeypoints();
+      std::vector< KeypointHarris<int> > keypoints = selector.getKeypoints();
+      BRICK_TEST_ASSERT(keypoints.size() == referenceKeypoints.size());
+      for(unsigned int ii = 0; ii < keypoints.size(); ++ii) {
+        BRICK_TEST_ASSERT(keypoints[ii].row == referenceKeypoints[ii].row);
+        BRICK_TEST_ASSERT(
+          keypoints[ii].column == referenceKeypoints[ii].column);
+      }
+
+      // On a real image, setImage() quantizes away the differences
+      // between very weak keypoints, so we only require that the
+      // strong ones match.  We also skip the outermost rows and
+      // columns of the search region, since setImage() compares them
+      // against uninitialized neighbors during non-max suppression.
+      Image<GRAY8> inputImage = readPGM8(getTestImageFileNamePGM0());
+      referenceSelector.setImage(inputImage);
+      referenceKeypoints = referenceSelector.getKeypoints();
+      double maxValue = 0.0;
+      for(unsigned int ii = 0; ii < referenceKeypoints.size(); ++ii) {
+        maxValue = std::max(maxValue, double(referenceKeypoints[ii].value));
+      }
+      BRICK_TEST_ASSERT(maxValue > 0.0);
+
+      std::vector< KeypointHarris<int> > singleThreadKeypoints;
+      for(unsigned int numberOfThreads = 1; numberOfThreads < 5;
+          ++numberOfThreads) {
+        selector.setImageFused(inputImage, numberOfThreads);
+        keypoints = selector.getKeypoints();
+
+        // Thread count must not affect the result at all.
+        if(numberOfThreads == 1) {
+          singleThreadKeypoints = keypoints;
+        }
+        BRICK_TEST_ASSERT(keypoints.size() == singleThreadKeypoints.size());
+        for(unsigned int ii = 0; ii < keypoints.size(); ++ii) {
+          BRICK_TEST_ASSERT(keypoints[ii].row == singleThreadKeypoints[ii].row);
+          BRICK_TEST_ASSERT(
+            keypoints[ii].column == singleThreadKeypoints[ii].column);
+          BRICK_TEST_ASSERT(
+            keypoints[ii].value == singleThreadKeypoints[ii].value);
+        }
+
+        unsigned int numberOfStrongKeypoints = 0;
+        for(unsigned int ii = 0; ii < referenceKeypoints.size(); ++ii) {
+          if(referenceKeypoints[ii].value < 0.01 * maxValue
+             || referenceKeypoints[ii].row <= 8
+             || referenceKeypoints[ii].row >= int(inputImage.rows()) - 9
+             || referenceKeypoints[ii].column <= 8
+             || referenceKeypoints[ii].column
+                >= int(inputImage.columns()) - 9) {
+            continue;
+          }
+          ++numberOfStrongKeypoints;
+          bool isFound = false;
+          for(unsigned int jj = 0; jj < keypoints.size(); ++jj) {
+            if(keypoints[jj].row == referenceKeypoints[ii].row
+               && keypoints[jj].column == referenceKeypoints[ii].column) {
+              BRICK_TEST_ASSERT(
+                brick::test::approximatelyEqual(
+                  double(keypoints[jj].value),
+                  double(referenceKeypoints[ii].value),
+                  0.01 * referenceKeypoints[ii].value));
+              isFound = true;
+              break;
+            }
+          }
+          BRICK_TEST_ASSERT(isFound);
+        }
+        BRICK_TEST_ASSERT(numberOfStrongKeypoints > 10);
+      }
+
+      // Tiny images have no valid search region, but shouldn't crash.
+      selector.setImageFused(Image<GRAY8>(10, 12), 2);
+      BRICK_TEST_ASSERT(selector.getKeypoints().size() == 0);
+    }
+
+
     void
     KeypointSelectorHarrisTest::
     exerciseKeypointSelectorHarris(std::string const& fileName,
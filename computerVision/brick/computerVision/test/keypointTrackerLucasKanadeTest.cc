@@ -0,0 +1,452 @@
+/**
+***************************************************************************
+* @file brick/computerVision/test/keypointTrackerLucasKanadeTest.cc
+*
+* Source file defining tests for the KeypointTrackerLucasKanade class.
+*
+* Copyright (C) 2026 David LaRose, dlr@cs.cmu.edu
+* See accompanying file, LICENSE.TXT, for details.
+*
+***************************************************************************
+**/
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+#include <brick/common/exception.hh>
+#include <brick/computerVision/keypointTrackerLucasKanade.hh>
+#include <brick/test/testFixture.hh>
+#include <brick/utilities/timeUtilities.hh>
+
+namespace brick {
+
+  namespace computerVision {
+
+    class KeypointTrackerLucasKanadeTest
+      : public brick::test::TestFixture<KeypointTrackerLucasKanadeTest> {
+
+    public:
+
+      KeypointTrackerLucasKanadeTest();
+      ~KeypointTrackerLucasKanadeTest() {}
+
+      void setUp(const std::string& /* testName */) {}
+      void tearDown(const std::string& /* testName */) {}
+
+      // Tests.
+      void testTrack();
+      void testTrackInitialGuess();
+      void testTrackStatus();
+      void testTrackThreads();
+      void testExceptions();
+      void testSampleWindow();
+      void testSmallImage();
+      void testExecutionTime();
+
+    private:
+
+      // Returns a grid of points, spaced by the specified step, in the
+      // interior of an image of the specified size.
+      std::vector< brick::numeric::Vector2D<double> >
+      getGrid(size_t rows, size_t columns, size_t margin, size_t step);
+
+      // Renders a smooth, textured test pattern, with its origin
+      // moved to (offsetX, offsetY).
+      Image<GRAY8>
+      getTestImage(size_t rows, size_t columns,
+                   double offsetX, double offsetY);
+
+      double m_defaultTolerance;
+
+    }; // class KeypointTrackerLucasKanadeTest
+
+
+    /* ============== Member Function Definititions ============== */
+
+    KeypointTrackerLucasKanadeTest::
+    KeypointTrackerLucasKanadeTest()
+      : brick::test::TestFixture<KeypointTrackerLucasKanadeTest>(
+          "KeypointTrackerLucasKanadeTest"),
+        m_defaultTolerance(0.05)
+    {
+      BRICK_TEST_REGISTER_MEMBER(testTrack);
+      BRICK_TEST_REGISTER_MEMBER(testTrackInitialGuess);
+      BRICK_TEST_REGISTER_MEMBER(testTrackStatus);
+      BRICK_TEST_REGISTER_MEMBER(testTrackThreads);
+      BRICK_TEST_REGISTER_MEMBER(testExceptions);
+      BRICK_TEST_REGISTER_MEMBER(testSampleWindow);
+      BRICK_TEST_REGISTER_MEMBER(testSmallImage);
+      // BRICK_TEST_REGISTER_MEMBER(testExecutionTime);
+    }
+
+
+    void
+    KeypointTrackerLucasKanadeTest::
+    testTrack()
+    {
+      size_t const rows = 240;
+      size_t const columns = 320;
+      // Points near the image border can't use the coarser levels,
+      // so keep well away from it.
+      std::vector< brick::numeric::Vector2D<double> > previousPoints =
+        this->getGrid(rows, columns, 60, 20);
+
+      // Small motions can be tracked without a pyramid, but larger
+      // ones need several levels.
+      double const motions[][3] = {{0.4, -0.3, 1},
+                                   {3.3, -2.7, 3},
+                                   {11.6, 7.2, 4},
+                                   {-17.3, 9.8, 4}};
+      for(size_t ii = 0; ii < 4; ++ii) {
+        double const motionX = motions[ii][0];
+        double const motionY = motions[ii][1];
+        KeypointTrackerLucasKanade tracker(
+          7, static_cast<unsigned int>(motions[ii][2]));
+        tracker.setImage(this->getTestImage(rows, columns, 0.0, 0.0));
+        tracker.setImage(
+          this->getTestImage(rows, columns, motionX, motionY));
+        BRICK_TEST_ASSERT(tracker.getNumberOfLevels() == motions[ii][2]);
+
+        std::vector< brick::numeric::Vector2D<double> > currentPoints;
+        std::vector<KeypointTrackStatus> status;
+        std::vector<double> residuals;
+        tracker.track(previousPoints, currentPoints, status, residuals);
+        BRICK_TEST_ASSERT(currentPoints.size() == previousPoints.size());
+        BRICK_TEST_ASSERT(status.size() == previousPoints.size());
+        BRICK_TEST_ASSERT(residuals.size() == previousPoints.size());
+        for(size_t jj = 0; jj < previousPoints.size(); ++jj) {
+          BRICK_TEST_ASSERT(status[jj] == KEYPOINT_TRACK_OK);
+          BRICK_TEST_ASSERT(
+            std::fabs(currentPoints[jj].x() - previousPoints[jj].x()
+                      - motionX) < m_defaultTolerance);
+          BRICK_TEST_ASSERT(
+            std::fabs(currentPoints[jj].y() - previousPoints[jj].y()
+                      - motionY) < m_defaultTolerance);
+          BRICK_TEST_ASSERT(residuals[jj] < 1.0);
+        }
+      }
+    }
+
+
+    void
+    KeypointTrackerLucasKanadeTest::
+    testTrackInitialGuess()
+    {
+      size_t const rows = 240;
+      size_t const columns = 320;
+      std::vector< brick::numeric::Vector2D<double> > previousPoints =
+        this->getGrid(rows, columns, 60, 20);
+      double const motionX = 30.7;
+      double const motionY = -25.4;
+
+      // A single level can't follow this much motion without help.
+      KeypointTrackerLucasKanade tracker(7, 1);
+      tracker.setImage(this->getTestImage(rows, columns, 0.0, 0.0));
+      tracker.setImage(this->getTestImage(rows, columns, motionX, motionY));
+
+      std::vector< brick::numeric::Vector2D<double> > currentPoints;
+      std::vector<KeypointTrackStatus> status;
+      std::vector<double> residuals;
+      for(size_t jj = 0; jj < previousPoints.size(); ++jj) {
+        currentPoints.push_back(
+          previousPoints[jj]
+          + brick::numeric::Vector2D<double>(motionX + 1.5, motionY - 1.0));
+      }
+      tracker.track(previousPoints, currentPoints, status, residuals, true);
+      for(size_t jj = 0; jj < previousPoints.size(); ++jj) {
+        BRICK_TEST_ASSERT(status[jj] == KEYPOINT_TRACK_OK);
+        BRICK_TEST_ASSERT(
+          std::fabs(currentPoints[jj].x() - previousPoints[jj].x()
+                    - motionX) < m_defaultTolerance);
+        BRICK_TEST_ASSERT(
+          std::fabs(currentPoints[jj].y() - previousPoints[jj].y()
+                    - motionY) < m_defaultTolerance);
+      }
+    }
+
+
+    void
+    KeypointTrackerLucasKanadeTest::
+    testTrackStatus()
+    {
+      size_t const rows = 240;
+      size_t const columns = 320;
+      Image<GRAY8> image0 = this->getTestImage(rows, columns, 0.0, 0.0);
+      Image<GRAY8> image1 = this->getTestImage(rows, columns, 2.2, 1.3);
+
+      // A flat patch in both images, and a patch that changes
+      // completely from one image to the next.
+      for(size_t row = 100; row < 140; ++row) {
+        for(size_t column = 40; column < 80; ++column) {
+          image0(row, column) = 128;
+          image1(row, column) = 128;
+        }
+        for(size_t column = 200; column < 240; ++column) {
+          image1(row, column) = 255 - image1(row, column);
+        }
+      }
+
+      KeypointTrackerLucasKanade tracker(5, 3);
+      tracker.setMaximumResidual(10.0);
+      tracker.setImage(image0);
+      tracker.setImage(image1);
+
+      std::vector< brick::numeric::Vector2D<double> > previousPoints;
+      previousPoints.push_back(brick::numeric::Vector2D<double>(160.0, 60.0));
+      previousPoints.push_back(brick::numeric::Vector2D<double>(3.0, 60.0));
+      previousPoints.push_back(brick::numeric::Vector2D<double>(316.5, 60.0));
+      previousPoints.push_back(brick::numeric::Vector2D<double>(60.0, 120.0));
+      previousPoints.push_back(brick::numeric::Vector2D<double>(220.0, 120.0));
+
+      std::vector< brick::numeric::Vector2D<double> > currentPoints;
+      std::vector<KeypointTrackStatus> status;
+      std::vector<double> residuals;
+      tracker.track(previousPoints, currentPoints, status, residuals);
+      BRICK_TEST_ASSERT(status[0] == KEYPOINT_TRACK_OK);
+      BRICK_TEST_ASSERT(status[1] == KEYPOINT_TRACK_OUT_OF_BOUNDS);
+      BRICK_TEST_ASSERT(status[2] == KEYPOINT_TRACK_OUT_OF_BOUNDS);
+      BRICK_TEST_ASSERT(status[3] == KEYPOINT_TRACK_LOW_TEXTURE);
+      BRICK_TEST_ASSERT(status[4] == KEYPOINT_TRACK_LARGE_RESIDUAL);
+      BRICK_TEST_ASSERT(residuals[4] > 10.0);
+    }
+
+
+    void
+    KeypointTrackerLucasKanadeTest::
+    testTrackThreads()
+    {
+      size_t const rows = 240;
+      size_t const columns = 320;
+      std::vector< brick::numeric::Vector2D<double> > previousPoints =
+        this->getGrid(rows, columns, 10, 7);
+
+      KeypointTrackerLucasKanade tracker;
+      tracker.setImage(this->getTestImage(rows, columns, 0.0, 0.0));
+      tracker.setImage(this->getTestImage(rows, columns, 5.2, -3.9));
+
+      std::vector< brick::numeric::Vector2D<double> > referencePoints;
+      std::vector<KeypointTrackStatus> referenceStatus;
+      std::vector<double> referenceResiduals;
+      tracker.track(previousPoints, referencePoints, referenceStatus,
+                    referenceResiduals);
+      for(unsigned int numberOfThreads = 2; numberOfThreads < 5;
+          ++numberOfThreads) {
+        tracker.setNumberOfThreads(numberOfThreads);
+        std::vector< brick::numeric::Vector2D<double> > currentPoints;
+        std::vector<KeypointTrackStatus> status;
+        std::vector<double> residuals;
+        tracker.track(previousPoints, currentPoints, status, residuals);
+        for(size_t jj = 0; jj < previousPoints.size(); ++jj) {
+          BRICK_TEST_ASSERT(currentPoints[jj].x() == referencePoints[jj].x());
+          BRICK_TEST_ASSERT(currentPoints[jj].y() == referencePoints[jj].y());
+          BRICK_TEST_ASSERT(status[jj] == referenceStatus[jj]);
+          BRICK_TEST_ASSERT(residuals[jj] == referenceResiduals[jj]);
+        }
+      }
+    }
+
+
+    void
+    KeypointTrackerLucasKanadeTest::
+    testExceptions()
+    {
+      BRICK_TEST_ASSERT_EXCEPTION(brick::common::ValueException,
+                                  KeypointTrackerLucasKanade(0));
+      BRICK_TEST_ASSERT_EXCEPTION(brick::common::ValueException,
+                                  KeypointTrackerLucasKanade(16));
+      BRICK_TEST_ASSERT_EXCEPTION(brick::common::ValueException,
+                                  KeypointTrackerLucasKanade(7, 0));
+
+      std::vector< brick::numeric::Vector2D<double> > previousPoints(
+        3, brick::numeric::Vector2D<double>(50.0, 50.0));
+      std::vector< brick::numeric::Vector2D<double> > currentPoints;
+      std::vector<KeypointTrackStatus> status;
+      std::vector<double> residuals;
+
+      KeypointTrackerLucasKanade tracker;
+      tracker.setImage(this->getTestImage(100, 100, 0.0, 0.0));
+      BRICK_TEST_ASSERT_EXCEPTION(
+        brick::common::StateException,
+        tracker.track(previousPoints, currentPoints, status, residuals));
+
+      tracker.setImage(this->getTestImage(100, 100, 1.0, 0.0));
+      BRICK_TEST_ASSERT_EXCEPTION(
+        brick::common::ValueException,
+        tracker.track(previousPoints, currentPoints, status, residuals,
+                      true));
+
+      tracker.setImage(this->getTestImage(100, 120, 1.0, 0.0));
+      BRICK_TEST_ASSERT_EXCEPTION(
+        brick::common::ValueException,
+        tracker.track(previousPoints, currentPoints, status, residuals));
+    }
+
+
+    void
+    KeypointTrackerLucasKanadeTest::
+    testSampleWindow()
+    {
+      // Dark everywhere except a single bright pixel, so that the
+      // lower right interpolation weight is isolated.  Rounding each
+      // weight independently used to make that weight negative for
+      // offsets such as (0.437, 0.007), and the sample wrapped to a
+      // large value.
+      Image<GRAY8> image(4, 32);
+      image = brick::common::UInt8(0);
+      image(1, 1) = 255;
+
+      // Interpolated values are scaled by 32, and each weight is
+      // accurate to 1.5 / 128.
+      double const valueScale = 32.0;
+      double const tolerance = 255.0 * 1.5 / 128.0 * valueScale + 1.0;
+      brick::common::Int16 output[16];
+      for(size_t ii = 0; ii <= 1000; ii += 3) {
+        for(size_t jj = 0; jj <= 1000; jj += 3) {
+          double const alpha = std::min(ii / 1000.0, 0.999);
+          double const beta = std::min(jj / 1000.0, 0.999);
+          privateCode::sampleWindow(image, alpha, beta, 1, 16, output);
+          double const reference = alpha * beta * 255.0 * valueScale;
+          BRICK_TEST_ASSERT(output[0] >= 0);
+          BRICK_TEST_ASSERT(std::fabs(output[0] - reference) <= tolerance);
+        }
+      }
+      privateCode::sampleWindow(image, 0.437, 0.007, 1, 16, output);
+      BRICK_TEST_ASSERT(output[0] >= 0);
+      BRICK_TEST_ASSERT(output[0] <= tolerance);
+
+      // Interpolating a bright image should never exceed the
+      // brightest pixel.
+      image = brick::common::UInt8(255);
+      for(size_t ii = 0; ii <= 1000; ii += 7) {
+        for(size_t jj = 0; jj <= 1000; jj += 7) {
+          double const alpha = std::min(ii / 1000.0, 0.999);
+          double const beta = std::min(jj / 1000.0, 0.999);
+          privateCode::sampleWindow(image, alpha, beta, 1, 16, output);
+          BRICK_TEST_ASSERT(output[0] == 255 * valueScale);
+        }
+      }
+    }
+
+
+    void
+    KeypointTrackerLucasKanadeTest::
+    testSmallImage()
+    {
+      // Images too small for even a two level pyramid are used as a
+      // single level, rather than making ImagePyramidBinomial throw.
+      for(size_t size = 8; size < 24; ++size) {
+        KeypointTrackerLucasKanade tracker(7, 4);
+        tracker.setImage(this->getTestImage(size, size, 0.0, 0.0));
+        tracker.setImage(this->getTestImage(size, size, 0.5, 0.0));
+        BRICK_TEST_ASSERT(tracker.getNumberOfLevels() == 1);
+
+        std::vector< brick::numeric::Vector2D<double> > previousPoints(
+          1, brick::numeric::Vector2D<double>(size / 2.0, size / 2.0));
+        std::vector< brick::numeric::Vector2D<double> > currentPoints;
+        std::vector<KeypointTrackStatus> status;
+        std::vector<double> residuals;
+        tracker.track(previousPoints, currentPoints, status, residuals);
+        BRICK_TEST_ASSERT(currentPoints.size() == 1);
+        BRICK_TEST_ASSERT(status.size() == 1);
+      }
+    }
+
+
+    void
+    KeypointTrackerLucasKanadeTest::
+    testExecutionTime()
+    {
+      size_t const rows = 1080;
+      size_t const columns = 1920;
+      Image<GRAY8> image0 = this->getTestImage(rows, columns, 0.0, 0.0);
+      Image<GRAY8> image1 = this->getTestImage(rows, columns, 6.3, -4.1);
+
+      // About 2000 points.
+      std::vector< brick::numeric::Vector2D<double> > previousPoints =
+        this->getGrid(rows, columns, 60, 30);
+      previousPoints.resize(2000);
+
+      KeypointTrackerLucasKanade tracker;
+      double t0 = brick::utilities::getCurrentTime();
+      tracker.setImage(image0);
+      tracker.setImage(image1);
+      double t1 = brick::utilities::getCurrentTime();
+
+      std::vector< brick::numeric::Vector2D<double> > currentPoints;
+      std::vector<KeypointTrackStatus> status;
+      std::vector<double> residuals;
+      tracker.track(previousPoints, currentPoints, status, residuals);
+      double t2 = brick::utilities::getCurrentTime();
+
+      std::cout << "Pyramids for two " << columns << "x" << rows
+                << " images: " << std::fixed << std::setprecision(5)
+                << t1 - t0 << " s.\n"
+                << "Tracking " << previousPoints.size() << " points: "
+                << t2 - t1 << " s." << std::endl;
+    }
+
+
+    std::vector< brick::numeric::Vector2D<double> >
+    KeypointTrackerLucasKanadeTest::
+    getGrid(size_t rows, size_t columns, size_t margin, size_t step)
+    {
+      std::vector< brick::numeric::Vector2D<double> > points;
+      for(size_t row = margin; row + margin < rows; row += step) {
+        for(size_t column = margin; column + margin < columns;
+            column += step) {
+          points.push_back(
+            brick::numeric::Vector2D<double>(column + 0.25, row + 0.5));
+        }
+      }
+      return points;
+    }
+
+
+    Image<GRAY8>
+    KeypointTrackerLucasKanadeTest::
+    getTestImage(size_t rows, size_t columns, double offsetX, double offsetY)
+    {
+      // Sum of sinusoids with periods of 10 to 70 pixels, so that
+      // there's texture at every pyramid level.
+      Image<GRAY8> image(rows, columns);
+      for(size_t row = 0; row < rows; ++row) {
+        double const yy = row - offsetY;
+        for(size_t column = 0; column < columns; ++column) {
+          double const xx = column - offsetX;
+          double value = (
+            128.0
+            + 30.0 * std::sin(0.09 * xx + 0.02 * yy)
+            + 30.0 * std::sin(0.013 * xx - 0.085 * yy + 1.0)
+            + 20.0 * std::sin(0.31 * xx + 0.47 * yy + 2.0)
+            + 20.0 * std::sin(0.53 * xx - 0.37 * yy + 3.0));
+          image(row, column) = static_cast<brick::common::UInt8>(value + 0.5);
+        }
+      }
+      return image;
+    }
+
+  } // namespace computerVision
+
+} // namespace brick
+
+
+#if 0
+
+int main(int argc, char** argv)
+{
+  brick::computerVision::KeypointTrackerLucasKanadeTest currentTest;
+  bool result = currentTest.run();
+  return (result ? 0 : 1);
+}
+
+#else
+
+namespace {
+
+  brick::computerVision::KeypointTrackerLucasKanadeTest currentTest;
+
+}
+
+#endif
@@ -11,6 +11,7 @@
 ***************************************************************************
 **/
 
+#include <cmath>
 #include <brick/computerVision/test/testImages.hh>
 #include <brick/computerVision/sobel.hh>
 #include <brick/test/testFixture.hh>
@@ -33,6 +34,10 @@ namespace brick {
       // Tests.
       void testSobelX();
       void testSobelY();
+      void testApplySobel();
+      void testApplySobelGray8();
+      void testApplySobelMagnitude();
+      void testApplySobelOrientation();
 
     private:
 
@@ -47,6 +52,10 @@ namespace brick {
     {
       BRICK_TEST_REGISTER_MEMBER(testSobelX);
       BRICK_TEST_REGISTER_MEMBER(testSobelY);
+      BRICK_TEST_REGISTER_MEMBER(testApplySobel);
+      BRICK_TEST_REGISTER_MEMBER(testApplySobelGray8);
+      BRICK_TEST_REGISTER_MEMBER(testApplySobelMagnitude);
+      BRICK_TEST_REGISTER_MEMBER(testApplySobelOrientation);
     }
 
 
@@ -107,6 +116,218 @@ namespace brick {
       }
     }
 
+
+    void
+    SobelTest::
+    testApplySobel()
+    {
+      brick::numeric::Array2D<brick::common::Int32> inputArray(
+        "[[ 0,  1,  0, -2],"
+        " [ 7,  5,  2,  3],"
+        " [10,  9,  8,  7],"
+        " [ 3,  2,  3,  4],"
+        " [ 2,  2,  5,  9]]");
+
+      // Results should match the single-direction functions, whether
+      // or not the input rows are contiguous in memory, and however
+      // many threads are used.
+      Image<GRAY_SIGNED32> inputImage = inputArray;
+      Image<GRAY_SIGNED32> referenceX = applySobelX(inputImage);
+      Image<GRAY_SIGNED32> referenceY = applySobelY(inputImage);
+
+      brick::numeric::Array2D<brick::common::Int32> paddedArray(
+        inputArray.rows() + 2, inputArray.columns() + 3);
+      paddedArray = 1000;
+      brick::numeric::Array2D<brick::common::Int32> regionArray =
+        paddedArray.getRegion(
+          brick::numeric::Index2D(1, 2),
+          brick::numeric::Index2D(inputArray.rows() + 1,
+                                  inputArray.columns() + 2));
+      for(size_t row = 0; row < inputArray.rows(); ++row) {
+        for(size_t column = 0; column < inputArray.columns(); ++column) {
+          regionArray(row, column) = inputArray(row, column);
+        }
+      }
+      Image<GRAY_SIGNED32> stridedImage = regionArray;
+      BRICK_TEST_ASSERT(!stridedImage.isContiguous());
+
+      for(unsigned int numberOfThreads = 1; numberOfThreads <= 3;
+          ++numberOfThreads) {
+        brick::numeric::Array2D<brick::common::Int32> gradientX;
+        brick::numeric::Array2D<brick::common::Int32> gradientY;
+        applySobel(inputImage, gradientX, gradientY, numberOfThreads);
+        BRICK_TEST_ASSERT(gradientX.rows() == referenceX.rows());
+        BRICK_TEST_ASSERT(gradientX.columns() == referenceX.columns());
+        BRICK_TEST_ASSERT(gradientY.rows() == referenceY.rows());
+        BRICK_TEST_ASSERT(gradientY.columns() == referenceY.columns());
+        for(size_t index0 = 0; index0 < referenceX.size(); ++index0) {
+          BRICK_TEST_ASSERT(gradientX[index0] == referenceX[index0]);
+          BRICK_TEST_ASSERT(gradientY[index0] == referenceY[index0]);
+        }
+
+        brick::numeric::Array2D<double> stridedX;
+        brick::numeric::Array2D<double> stridedY;
+        applySobel(stridedImage, stridedX, stridedY, numberOfThreads);
+        BRICK_TEST_ASSERT(stridedX.rows() == referenceX.rows());
+        BRICK_TEST_ASSERT(stridedX.columns() == referenceX.columns());
+        for(size_t index0 = 0; index0 < referenceX.size(); ++index0) {
+          BRICK_TEST_ASSERT(stridedX[index0] == referenceX[index0]);
+          BRICK_TEST_ASSERT(stridedY[index0] == referenceY[index0]);
+        }
+      }
+
+      // Tiny images should be rejected.
+      Image<GRAY_SIGNED32> tinyImage(1, 4);
+      tinyImage = 0;
+      brick::numeric::Array2D<brick::common::Int32> gradientX;
+      brick::numeric::Array2D<brick::common::Int32> gradientY;
+      BRICK_TEST_ASSERT_EXCEPTION(
+        brick::common::ValueException,
+        applySobel(tinyImage, gradientX, gradientY));
+    }
+
+
+    void
+    SobelTest::
+    testApplySobelGray8()
+    {
+      // A step edge from 0 to 255 overflows 8 bits, but should be
+      // represented exactly in a wider output type.
+      Image<GRAY8> inputImage(6, 7);
+      for(size_t row = 0; row < inputImage.rows(); ++row) {
+        for(size_t column = 0; column < inputImage.columns(); ++column) {
+          inputImage(row, column) = (column < 3) ? 0 : 255;
+        }
+      }
+
+      brick::numeric::Array2D<brick::common::Int16> gradientX;
+      brick::numeric::Array2D<brick::common::Int16> gradientY;
+      applySobel(inputImage, gradientX, gradientY);
+      for(size_t row = 0; row < inputImage.rows(); ++row) {
+        for(size_t column = 0; column < inputImage.columns(); ++column) {
+          brick::common::Int16 expectedX =
+            (column == 2 || column == 3) ? 4 * 255 : 0;
+          BRICK_TEST_ASSERT(gradientX(row, column) == expectedX);
+          BRICK_TEST_ASSERT(gradientY(row, column) == 0);
+        }
+      }
+    }
+
+
+    void
+    SobelTest::
+    testApplySobelMagnitude()
+    {
+      // Interior gradient of this ramp is (8 * 3, 8 * 4), or 5 * 8 in
+      // the L2 norm and 7 * 8 in the L1 norm.
+      Image<GRAY_SIGNED32> inputImage(5, 6);
+      for(size_t row = 0; row < inputImage.rows(); ++row) {
+        for(size_t column = 0; column < inputImage.columns(); ++column) {
+          inputImage(row, column) = 3 * column + 4 * row;
+        }
+      }
+
+      brick::numeric::Array2D<brick::common::Int32> gradientX;
+      brick::numeric::Array2D<brick::common::Int32> gradientY;
+      brick::numeric::Array2D<brick::common::Int32> magnitude;
+      applySobel(inputImage, gradientX, gradientY, magnitude,
+                 BRICK_SOBEL_L2_NORM);
+      BRICK_TEST_ASSERT(magnitude.rows() == inputImage.rows());
+      BRICK_TEST_ASSERT(magnitude.columns() == inputImage.columns());
+      for(size_t row = 0; row < inputImage.rows(); ++row) {
+        for(size_t column = 0; column < inputImage.columns(); ++column) {
+          BRICK_TEST_ASSERT(gradientX(row, column) == 24);
+          BRICK_TEST_ASSERT(gradientY(row, column) == 32);
+          BRICK_TEST_ASSERT(magnitude(row, column) == 40);
+        }
+      }
+
+      applySobel(inputImage, gradientX, gradientY, magnitude,
+                 BRICK_SOBEL_L1_NORM);
+      for(size_t index0 = 0; index0 < magnitude.size(); ++index0) {
+        BRICK_TEST_ASSERT(magnitude[index0] == 56);
+      }
+
+      // Floating point magnitude should match a direct computation.
+      Image<GRAY_FLOAT64> floatImage(5, 6);
+      for(size_t index0 = 0; index0 < floatImage.size(); ++index0) {
+        floatImage[index0] = std::sin(0.7 * index0);
+      }
+      brick::numeric::Array2D<double> floatX;
+      brick::numeric::Array2D<double> floatY;
+      brick::numeric::Array2D<double> floatMagnitude;
+      applySobel(floatImage, floatX, floatY, floatMagnitude);
+      for(size_t index0 = 0; index0 < floatMagnitude.size(); ++index0) {
+        BRICK_TEST_ASSERT(
+          floatMagnitude[index0]
+          == std::sqrt(floatX[index0] * floatX[index0]
+                       + floatY[index0] * floatY[index0]));
+      }
+    }
+
+
+    void
+    SobelTest::
+    testApplySobelOrientation()
+    {
+      // Each image is a linear ramp, so every pixel has the same
+      // gradient direction.  Rows are (x slope, y slope, expected bin
+      // with 8 orientations, expected bin with 4 orientations).
+      brick::numeric::Array2D<brick::common::Int32> rampArray(
+        "[[ 1,  0, 0, 0],"
+        " [ 3,  1, 0, 0],"
+        " [ 3,  2, 1, 0],"
+        " [ 1,  3, 2, 1],"
+        " [ 0,  1, 2, 1],"
+        " [-2,  1, 3, 2],"
+        " [-1,  0, 4, 2],"
+        " [-2, -1, 5, 2],"
+        " [ 0, -1, 6, 3],"
+        " [ 2, -1, 7, 0],"
+        " [ 3, -1, 0, 0],"
+        " [ 0,  0, 0, 0]]");
+
+      for(size_t ramp = 0; ramp < rampArray.rows(); ++ramp) {
+        Image<GRAY_SIGNED32> inputImage(4, 5);
+        for(size_t row = 0; row < inputImage.rows(); ++row) {
+          for(size_t column = 0; column < inputImage.columns(); ++column) {
+            inputImage(row, column) = (rampArray(ramp, 0) * column
+                                       + rampArray(ramp, 1) * row);
+          }
+        }
+
+        brick::numeric::Array2D<double> gradientX;
+        brick::numeric::Array2D<double> gradientY;
+        brick::numeric::Array2D<double> magnitude;
+        brick::numeric::Array2D<brick::common::UInt8> orientation;
+        applySobel(inputImage, gradientX, gradientY, magnitude, orientation);
+        for(size_t index0 = 0; index0 < orientation.size(); ++index0) {
+          BRICK_TEST_ASSERT(orientation[index0] == rampArray(ramp, 2));
+        }
+
+        applySobel(inputImage, gradientX, gradientY, magnitude, orientation,
+                   4);
+        for(size_t index0 = 0; index0 < orientation.size(); ++index0) {
+          BRICK_TEST_ASSERT(orientation[index0] == rampArray(ramp, 3));
+        }
+      }
+
+      Image<GRAY_SIGNED32> inputImage(4, 5);
+      inputImage = 0;
+      brick::numeric::Array2D<double> gradientX;
+      brick::numeric::Array2D<double> gradientY;
+      brick::numeric::Array2D<double> magnitude;
+      brick::numeric::Array2D<brick::common::UInt8> orientation;
+      BRICK_TEST_ASSERT_EXCEPTION(
+        brick::common::ValueException,
+        applySobel(inputImage, gradientX, gradientY, magnitude, orientation,
+                   0));
+      BRICK_TEST_ASSERT_EXCEPTION(
+        brick::common::ValueException,
+        applySobel(inputImage, gradientX, gradientY, magnitude, orientation,
+                   257));
+    }
+
   } // namespace computerVision
 
 } // namespace brick
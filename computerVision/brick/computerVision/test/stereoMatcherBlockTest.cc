@@ -0,0 +1,518 @@
+/**
+***************************************************************************
+* @file brick/computerVision/test/stereoMatcherBlockTest.cc
+*
+* Source file defining tests for the StereoMatcherBlock class.
+*
+* Copyright (C) 2026 David LaRose, dlr@cs.cmu.edu
+* See accompanying file, LICENSE.TXT, for details.
+*
+***************************************************************************
+**/
+
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+#include <brick/common/exception.hh>
+#include <brick/computerVision/stereoMatcherBlock.hh>
+#include <brick/test/testFixture.hh>
+#include <brick/utilities/timeUtilities.hh>
+
+namespace brick {
+
+  namespace computerVision {
+
+    class StereoMatcherBlockTest
+      : public brick::test::TestFixture<StereoMatcherBlockTest> {
+
+    public:
+
+      StereoMatcherBlockTest();
+      ~StereoMatcherBlockTest() {}
+
+      void setUp(const std::string& /* testName */) {}
+      void tearDown(const std::string& /* testName */) {}
+
+      // Tests.
+      void testComputeDisparity();
+      void testLeftRightCheck();
+      void testSemiGlobal();
+      void testSubpixel();
+      void testThreads();
+      void testExceptions();
+      void testExecutionTime();
+
+    private:
+
+      // Returns a smooth, non-repeating texture with values in the
+      // range [0, 255].
+      Image<GRAY_FLOAT64>
+      getTexture(size_t rows, size_t columns, unsigned int seed);
+
+      // Samples texture at (row, column + shift), interpolating
+      // linearly between columns.
+      brick::common::UInt8
+      sampleTexture(Image<GRAY_FLOAT64> const& texture,
+                    size_t row, double column);
+
+      // Builds a stereo pair in which every pixel has the same
+      // disparity.
+      void
+      getShiftedPair(Image<GRAY_FLOAT64> const& texture,
+                     size_t columns, double disparity,
+                     Image<GRAY8>& leftImage, Image<GRAY8>& rightImage);
+
+      size_t m_columns;
+      size_t m_rows;
+
+    }; // class StereoMatcherBlockTest
+
+
+    /* ============== Member Function Definititions ============== */
+
+    StereoMatcherBlockTest::
+    StereoMatcherBlockTest()
+      : brick::test::TestFixture<StereoMatcherBlockTest>(
+          "StereoMatcherBlockTest"),
+        m_columns(96),
+        m_rows(48)
+    {
+      BRICK_TEST_REGISTER_MEMBER(testComputeDisparity);
+      BRICK_TEST_REGISTER_MEMBER(testLeftRightCheck);
+      BRICK_TEST_REGISTER_MEMBER(testSemiGlobal);
+      BRICK_TEST_REGISTER_MEMBER(testSubpixel);
+      BRICK_TEST_REGISTER_MEMBER(testThreads);
+      BRICK_TEST_REGISTER_MEMBER(testExceptions);
+      // BRICK_TEST_REGISTER_MEMBER(testExecutionTime);
+    }
+
+
+    void
+    StereoMatcherBlockTest::
+    testComputeDisparity()
+    {
+      Image<GRAY_FLOAT64> texture = this->getTexture(m_rows, m_columns + 32, 1);
+      Image<GRAY8> leftImage;
+      Image<GRAY8> rightImage;
+      unsigned int const disparity = 7;
+      this->getShiftedPair(texture, m_columns, disparity,
+                           leftImage, rightImage);
+
+      StereoCost const costTypes[] = {STEREO_COST_SAD, STEREO_COST_CENSUS};
+      unsigned int const blockRadii[] = {1, 2, 4};
+      for(size_t ii = 0; ii < 2; ++ii) {
+        for(size_t jj = 0; jj < 3; ++jj) {
+          unsigned int const minimumDisparity = 3;
+          unsigned int const numberOfDisparities = 16;
+          StereoMatcherBlock matcher(minimumDisparity, numberOfDisparities,
+                                     blockRadii[jj], costTypes[ii]);
+          matcher.setSubpixel(false);
+          Image<GRAY_FLOAT32> result =
+            matcher.computeDisparity(leftImage, rightImage);
+          BRICK_TEST_ASSERT(result.rows() == leftImage.rows());
+          BRICK_TEST_ASSERT(result.columns() == leftImage.columns());
+
+          // Pixels too close to the left edge have no candidates.
+          for(size_t row = 0; row < result.rows(); ++row) {
+            for(size_t column = 0; column < minimumDisparity; ++column) {
+              BRICK_TEST_ASSERT(result(row, column)
+                                == StereoMatcherBlock::getInvalidDisparity());
+            }
+          }
+
+          // Once the whole block (and the whole census window) has
+          // its match inside the right image, results should be
+          // exact.  The census windows of the last two columns of
+          // the left image are clipped by the image edge, but those
+          // of their matches in the right image are not.
+          size_t const startColumn =
+            minimumDisparity + numberOfDisparities + blockRadii[jj] + 2;
+          for(size_t row = 0; row < result.rows(); ++row) {
+            for(size_t column = startColumn; column < result.columns() - 2;
+                ++column) {
+              BRICK_TEST_ASSERT(result(row, column) == disparity);
+            }
+          }
+        }
+      }
+    }
+
+
+    void
+    StereoMatcherBlockTest::
+    testLeftRightCheck()
+    {
+      // A textured square floats in front of a textured background.
+      // Background pixels just to the left of the square are hidden
+      // from the right camera.
+      unsigned int const backgroundDisparity = 4;
+      unsigned int const foregroundDisparity = 12;
+      size_t const squareRow0 = 12;
+      size_t const squareRow1 = 36;
+      size_t const squareColumn0 = 40;
+      size_t const squareColumn1 = 72;
+      Image<GRAY_FLOAT64> background =
+        this->getTexture(m_rows, m_columns + 16, 2);
+      Image<GRAY_FLOAT64> foreground =
+        this->getTexture(m_rows, m_columns + 16, 3);
+
+      Image<GRAY8> leftImage(m_rows, m_columns);
+      Image<GRAY8> rightImage(m_rows, m_columns);
+      for(size_t row = 0; row < m_rows; ++row) {
+        bool const isSquareRow = (row >= squareRow0 && row < squareRow1);
+        for(size_t column = 0; column < m_columns; ++column) {
+          bool isSquare = (isSquareRow && column >= squareColumn0
+                           && column < squareColumn1);
+          leftImage(row, column) = this->sampleTexture(
+            isSquare ? foreground : background, row, column);
+
+          size_t const squareColumn = column + foregroundDisparity;
+          isSquare = (isSquareRow && squareColumn >= squareColumn0
+                      && squareColumn < squareColumn1);
+          rightImage(row, column) =
+            isSquare
+            ? this->sampleTexture(foreground, row, squareColumn)
+            : this->sampleTexture(background, row,
+                                  column + backgroundDisparity);
+        }
+      }
+
+      unsigned int const blockRadius = 2;
+      StereoMatcherBlock matcher(0, 24, blockRadius);
+      matcher.setSubpixel(false);
+      Image<GRAY_FLOAT32> checkedResult =
+        matcher.computeDisparity(leftImage, rightImage);
+      matcher.setLeftRightTolerance(-1);
+      Image<GRAY_FLOAT32> uncheckedResult =
+        matcher.computeDisparity(leftImage, rightImage);
+
+      size_t const occludedColumn0 =
+        squareColumn0 - (foregroundDisparity - backgroundDisparity);
+      size_t numberOfOccluded = 0;
+      size_t numberOfInvalidOccluded = 0;
+      for(size_t row = squareRow0 + blockRadius;
+          row < squareRow1 - blockRadius; ++row) {
+        for(size_t column = 24 + blockRadius; column < m_columns; ++column) {
+          // Only the check can reject pixels.
+          if(uncheckedResult(row, column)
+             == StereoMatcherBlock::getInvalidDisparity()) {
+            BRICK_TEST_ASSERT(false);
+          }
+
+          if(column >= occludedColumn0 + blockRadius
+             && column + blockRadius < squareColumn0) {
+            // Occluded pixels have no correct match.
+            ++numberOfOccluded;
+            if(checkedResult(row, column)
+               == StereoMatcherBlock::getInvalidDisparity()) {
+              ++numberOfInvalidOccluded;
+            }
+          } else if(column + blockRadius < occludedColumn0
+                    || (column >= squareColumn0 + blockRadius
+                        && column + blockRadius < squareColumn1)
+                    || column >= squareColumn1 + blockRadius) {
+            // Pixels whose blocks don't straddle an edge or an
+            // occlusion should be correct, and should pass the check.
+            float expectedDisparity =
+              (column >= squareColumn0 && column < squareColumn1)
+              ? foregroundDisparity : backgroundDisparity;
+            BRICK_TEST_ASSERT(checkedResult(row, column) == expectedDisparity);
+            BRICK_TEST_ASSERT(uncheckedResult(row, column)
+                              == expectedDisparity);
+          }
+        }
+      }
+      BRICK_TEST_ASSERT(numberOfOccluded != 0);
+      BRICK_TEST_ASSERT(numberOfInvalidOccluded * 10 >= numberOfOccluded * 9);
+    }
+
+
+    void
+    StereoMatcherBlockTest::
+    testSemiGlobal()
+    {
+      // Block matching can't find disparities in the middle of a
+      // featureless region, but SGM should fill them in from the
+      // textured surroundings.
+      size_t const flatRow0 = 10;
+      size_t const flatRow1 = 38;
+      size_t const flatColumn0 = 40;
+      size_t const flatColumn1 = 80;
+      unsigned int const disparity = 6;
+      Image<GRAY_FLOAT64> texture = this->getTexture(m_rows, m_columns + 32, 4);
+      for(size_t row = flatRow0; row < flatRow1; ++row) {
+        for(size_t column = flatColumn0; column < flatColumn1 + disparity;
+            ++column) {
+          texture(row, column) = 100.0;
+        }
+      }
+      Image<GRAY8> leftImage;
+      Image<GRAY8> rightImage;
+      this->getShiftedPair(texture, m_columns, disparity,
+                           leftImage, rightImage);
+
+      unsigned int const blockRadius = 2;
+      for(unsigned int numberOfPaths = 0; numberOfPaths <= 8;
+          numberOfPaths += 4) {
+        StereoMatcherBlock matcher(0, 16, blockRadius, STEREO_COST_CENSUS);
+        matcher.setSubpixel(false);
+        matcher.setNumberOfPaths(numberOfPaths);
+        Image<GRAY_FLOAT32> result =
+          matcher.computeDisparity(leftImage, rightImage);
+
+        size_t numberOfFlat = 0;
+        size_t numberOfCorrectFlat = 0;
+        for(size_t row = 0; row < m_rows; ++row) {
+          for(size_t column = 16 + blockRadius + 2; column < m_columns;
+              ++column) {
+            bool const isFlat =
+              (row >= flatRow0 + blockRadius + 2
+               && row + blockRadius + 2 < flatRow1
+               && column >= flatColumn0 + blockRadius + 2
+               && column + blockRadius + 2 < flatColumn1);
+            if(isFlat) {
+              ++numberOfFlat;
+              if(result(row, column) == disparity) {
+                ++numberOfCorrectFlat;
+              }
+            } else if(row + blockRadius + 2 < flatRow0
+                      || row >= flatRow1 + blockRadius + 2
+                      || column + blockRadius + 2 < flatColumn0
+                      || column >= flatColumn1 + blockRadius + 2) {
+              // Textured regions should be right with or without SGM.
+              BRICK_TEST_ASSERT(result(row, column) == disparity);
+            }
+          }
+        }
+        BRICK_TEST_ASSERT(numberOfFlat != 0);
+        if(numberOfPaths == 0) {
+          BRICK_TEST_ASSERT(numberOfCorrectFlat * 2 < numberOfFlat);
+        } else {
+          BRICK_TEST_ASSERT(numberOfCorrectFlat == numberOfFlat);
+        }
+      }
+    }
+
+
+    void
+    StereoMatcherBlockTest::
+    testSubpixel()
+    {
+      Image<GRAY_FLOAT64> texture = this->getTexture(m_rows, m_columns + 32, 5);
+      double const disparities[] = {5.0, 5.25, 5.5, 5.75};
+      for(size_t ii = 0; ii < 4; ++ii) {
+        Image<GRAY8> leftImage;
+        Image<GRAY8> rightImage;
+        this->getShiftedPair(texture, m_columns, disparities[ii],
+                             leftImage, rightImage);
+
+        StereoMatcherBlock matcher(0, 16, 3);
+        Image<GRAY_FLOAT32> result =
+          matcher.computeDisparity(leftImage, rightImage);
+
+        double errorSum = 0.0;
+        size_t count = 0;
+        for(size_t row = 0; row < m_rows; ++row) {
+          for(size_t column = 24; column < m_columns; ++column) {
+            BRICK_TEST_ASSERT(
+              std::fabs(result(row, column) - disparities[ii]) < 0.5);
+            errorSum += result(row, column) - disparities[ii];
+            ++count;
+          }
+        }
+
+        // Sub-pixel fitting is biased toward integers, but should
+        // still be much better than rounding.
+        BRICK_TEST_ASSERT(std::fabs(errorSum / count) < 0.1);
+      }
+    }
+
+
+    void
+    StereoMatcherBlockTest::
+    testThreads()
+    {
+      Image<GRAY_FLOAT64> texture = this->getTexture(m_rows, m_columns + 32, 6);
+      Image<GRAY8> leftImage;
+      Image<GRAY8> rightImage;
+      this->getShiftedPair(texture, m_columns, 9.3, leftImage, rightImage);
+
+      for(unsigned int numberOfPaths = 0; numberOfPaths <= 8;
+          numberOfPaths += 4) {
+        StereoMatcherBlock matcher(2, 20, 2, STEREO_COST_CENSUS);
+        matcher.setNumberOfPaths(numberOfPaths);
+        Image<GRAY_FLOAT32> referenceResult =
+          matcher.computeDisparity(leftImage, rightImage);
+        for(unsigned int numberOfThreads = 2; numberOfThreads < 5;
+            ++numberOfThreads) {
+          matcher.setNumberOfThreads(numberOfThreads);
+          Image<GRAY_FLOAT32> result =
+            matcher.computeDisparity(leftImage, rightImage);
+          for(size_t ii = 0; ii < result.size(); ++ii) {
+            BRICK_TEST_ASSERT(result[ii] == referenceResult[ii]);
+          }
+        }
+      }
+    }
+
+
+    void
+    StereoMatcherBlockTest::
+    testExceptions()
+    {
+      StereoMatcherBlock matcher;
+      BRICK_TEST_ASSERT_EXCEPTION(brick::common::ValueException,
+                                  matcher.setDisparityRange(4, 0));
+      BRICK_TEST_ASSERT_EXCEPTION(brick::common::ValueException,
+                                  matcher.setNumberOfPaths(2));
+
+      Image<GRAY8> leftImage(10, 20);
+      Image<GRAY8> rightImage(10, 21);
+      leftImage = 0;
+      rightImage = 0;
+      BRICK_TEST_ASSERT_EXCEPTION(
+        brick::common::ValueException,
+        matcher.computeDisparity(leftImage, rightImage));
+    }
+
+
+    void
+    StereoMatcherBlockTest::
+    testExecutionTime()
+    {
+      size_t const rows = 480;
+      size_t const columns = 640;
+      unsigned int const numberOfDisparities = 64;
+      Image<GRAY_FLOAT64> texture = this->getTexture(rows, columns + 96, 7);
+      Image<GRAY8> leftImage;
+      Image<GRAY8> rightImage;
+      this->getShiftedPair(texture, columns, 17.5, leftImage, rightImage);
+      double const numberOfEvaluations =
+        double(rows) * double(columns) * numberOfDisparities;
+
+      StereoCost const costTypes[] = {STEREO_COST_SAD, STEREO_COST_CENSUS};
+      char const* costNames[] = {"SAD", "census"};
+      unsigned int const pathCounts[] = {0, 4, 8};
+      for(size_t ii = 0; ii < 2; ++ii) {
+        for(size_t jj = 0; jj < 3; ++jj) {
+          for(unsigned int numberOfThreads = 1; numberOfThreads <= 4;
+              numberOfThreads *= 2) {
+            StereoMatcherBlock matcher(
+              0, numberOfDisparities, 3, costTypes[ii]);
+            matcher.setNumberOfPaths(pathCounts[jj]);
+            matcher.setNumberOfThreads(numberOfThreads);
+            double t0 = brick::utilities::getCurrentTime();
+            matcher.computeDisparity(leftImage, rightImage);
+            double t1 = brick::utilities::getCurrentTime();
+            std::cout << costNames[ii] << ", " << pathCounts[jj]
+                      << " paths, " << numberOfThreads << " thread(s): "
+                      << std::fixed << std::setprecision(4) << t1 - t0
+                      << " s, " << std::setprecision(1)
+                      << numberOfEvaluations / (t1 - t0) / 1.0E6
+                      << " Mdisparity-evaluations/s." << std::endl;
+          }
+        }
+      }
+    }
+
+
+    Image<GRAY_FLOAT64>
+    StereoMatcherBlockTest::
+    getTexture(size_t rows, size_t columns, unsigned int seed)
+    {
+      // Uniform noise from a simple linear congruential generator...
+      Image<GRAY_FLOAT64> noise(rows, columns);
+      brick::common::UInt32 state = 12345u + 1000u * seed;
+      for(size_t ii = 0; ii < noise.size(); ++ii) {
+        state = state * 1664525u + 1013904223u;
+        noise[ii] = static_cast<double>(state >> 24);
+      }
+
+      // ...smoothed with a 3x3 box filter so that linear
+      // interpolation is meaningful.
+      Image<GRAY_FLOAT64> texture(rows, columns);
+      for(size_t row = 0; row < rows; ++row) {
+        for(size_t column = 0; column < columns; ++column) {
+          double sum = 0.0;
+          for(int ii = -1; ii <= 1; ++ii) {
+            for(int jj = -1; jj <= 1; ++jj) {
+              long rr = std::min(std::max(long(row) + ii, 0L), long(rows) - 1);
+              long cc = std::min(std::max(long(column) + jj, 0L),
+                                 long(columns) - 1);
+              sum += noise(rr, cc);
+            }
+          }
+          texture(row, column) = sum / 9.0;
+        }
+      }
+
+      // Stretch the contrast back out to the full range.
+      double minimum = texture[0];
+      double maximum = texture[0];
+      for(size_t ii = 0; ii < texture.size(); ++ii) {
+        minimum = std::min(minimum, texture[ii]);
+        maximum = std::max(maximum, texture[ii]);
+      }
+      for(size_t ii = 0; ii < texture.size(); ++ii) {
+        texture[ii] = 255.0 * (texture[ii] - minimum) / (maximum - minimum);
+      }
+      return texture;
+    }
+
+
+    brick::common::UInt8
+    StereoMatcherBlockTest::
+    sampleTexture(Image<GRAY_FLOAT64> const& texture,
+                  size_t row, double column)
+    {
+      size_t column0 = static_cast<size_t>(column);
+      double fraction = column - column0;
+      double value = texture(row, column0);
+      if(fraction != 0.0) {
+        value += fraction * (texture(row, column0 + 1) - value);
+      }
+      return static_cast<brick::common::UInt8>(value + 0.5);
+    }
+
+
+    void
+    StereoMatcherBlockTest::
+    getShiftedPair(Image<GRAY_FLOAT64> const& texture,
+                   size_t columns, double disparity,
+                   Image<GRAY8>& leftImage, Image<GRAY8>& rightImage)
+    {
+      leftImage.reinit(texture.rows(), columns);
+      rightImage.reinit(texture.rows(), columns);
+      for(size_t row = 0; row < texture.rows(); ++row) {
+        for(size_t column = 0; column < columns; ++column) {
+          leftImage(row, column) = this->sampleTexture(texture, row, column);
+          rightImage(row, column) =
+            this->sampleTexture(texture, row, column + disparity);
+        }
+      }
+    }
+
+  } // namespace computerVision
+
+} // namespace brick
+
+
+#if 0
+
+int main(int argc, char** argv)
+{
+  brick::computerVision::StereoMatcherBlockTest currentTest;
+  bool result = currentTest.run();
+  return (result ? 0 : 1);
+}
+
+#else
+
+namespace {
+
+  brick::computerVision::StereoMatcherBlockTest currentTest;
+
+}
+
+#endif
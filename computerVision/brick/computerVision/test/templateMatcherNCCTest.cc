@@ -0,0 +1,451 @@
+/**
+***************************************************************************
+* @file templateMatcherNCCTest.cpp
+*
+* Source file defining tests for the TemplateMatcherNCC class template.
+*
+* Copyright (C) 2026 David LaRose, dlr@cs.cmu.edu
+* See accompanying file, LICENSE.TXT, for details.
+*
+***************************************************************************
+**/
+
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+#include <brick/common/exception.hh>
+#include <brick/common/functional.hh>
+#include <brick/computerVision/templateMatcherNCC.hh>
+#include <brick/test/testFixture.hh>
+#include <brick/utilities/timeUtilities.hh>
+
+namespace brick {
+
+  namespace computerVision {
+
+    class TemplateMatcherNCCTest
+      : public brick::test::TestFixture<TemplateMatcherNCCTest> {
+
+    public:
+
+      TemplateMatcherNCCTest();
+      ~TemplateMatcherNCCTest() {}
+
+      void setUp(const std::string& /* testName */) {}
+      void tearDown(const std::string& /* testName */) {}
+
+      // Tests.
+      void testComputeScoreMap();
+      void testComputeScoreMapFFT();
+      void testComputeScoreMapMasked();
+      void testComputeScoreMapThreads();
+      void testFindBestMatch();
+      void testExceptions();
+      void testExecutionTime();
+
+    private:
+
+      // Straightforward, slow reference implementation.
+      double
+      computeReferenceScore(Image<GRAY_FLOAT64> const& image,
+                            Image<GRAY_FLOAT64> const& templateImage,
+                            Image<GRAY8> const& mask,
+                            size_t row, size_t column);
+
+      Image<GRAY_FLOAT64>
+      getRegion(Image<GRAY_FLOAT64> const& image, size_t row, size_t column,
+                size_t rows, size_t columns);
+
+      // Smooth, non-repeating test image.
+      Image<GRAY_FLOAT64>
+      getTestImage(size_t rows, size_t columns);
+
+      double m_defaultTolerance;
+
+    }; // class TemplateMatcherNCCTest
+
+
+    /* ============== Member Function Definititions ============== */
+
+    TemplateMatcherNCCTest::
+    TemplateMatcherNCCTest()
+      : brick::test::TestFixture<TemplateMatcherNCCTest>(
+          "TemplateMatcherNCCTest"),
+        m_defaultTolerance(1.0E-9)
+    {
+      BRICK_TEST_REGISTER_MEMBER(testComputeScoreMap);
+      BRICK_TEST_REGISTER_MEMBER(testComputeScoreMapFFT);
+      BRICK_TEST_REGISTER_MEMBER(testComputeScoreMapMasked);
+      BRICK_TEST_REGISTER_MEMBER(testComputeScoreMapThreads);
+      BRICK_TEST_REGISTER_MEMBER(testFindBestMatch);
+      BRICK_TEST_REGISTER_MEMBER(testExceptions);
+      // BRICK_TEST_REGISTER_MEMBER(testExecutionTime);
+    }
+
+
+    void
+    TemplateMatcherNCCTest::
+    testComputeScoreMap()
+    {
+      Image<GRAY_FLOAT64> image = this->getTestImage(40, 50);
+      Image<GRAY_FLOAT64> templateImage = this->getRegion(image, 12, 21, 9, 7);
+      Image<GRAY8> mask(templateImage.rows(), templateImage.columns());
+      mask = 1;
+
+      TemplateMatcherNCC<double> matcher(templateImage);
+      BRICK_TEST_ASSERT(matcher.getTemplateRows() == 9);
+      BRICK_TEST_ASSERT(matcher.getTemplateColumns() == 7);
+
+      numeric::Array2D<double> scores =
+        matcher.computeScoreMap(image, TEMPLATE_MATCH_DIRECT);
+      BRICK_TEST_ASSERT(scores.rows() == image.rows() - 9 + 1);
+      BRICK_TEST_ASSERT(scores.columns() == image.columns() - 7 + 1);
+      for(size_t row = 0; row < scores.rows(); ++row) {
+        for(size_t column = 0; column < scores.columns(); ++column) {
+          double referenceScore = this->computeReferenceScore(
+            image, templateImage, mask, row, column);
+          BRICK_TEST_ASSERT(
+            common::approximatelyEqual(scores(row, column), referenceScore,
+                                       m_defaultTolerance));
+        }
+      }
+      BRICK_TEST_ASSERT(
+        common::approximatelyEqual(scores(12, 21), 1.0, m_defaultTolerance));
+
+      // Scores should be invariant to brightness and contrast
+      // changes.
+      Image<GRAY_FLOAT64> scaledImage(image.rows(), image.columns());
+      for(size_t ii = 0; ii < image.size(); ++ii) {
+        scaledImage[ii] = 3.5 * image[ii] + 100.0;
+      }
+      numeric::Array2D<double> scaledScores =
+        matcher.computeScoreMap(scaledImage, TEMPLATE_MATCH_DIRECT);
+      for(size_t ii = 0; ii < scores.size(); ++ii) {
+        BRICK_TEST_ASSERT(
+          common::approximatelyEqual(scaledScores[ii], scores[ii],
+                                     m_defaultTolerance));
+      }
+
+      // Flat regions have undefined NCC, and should score zero.
+      Image<GRAY_FLOAT64> flatImage(20, 20);
+      flatImage = 7.0;
+      scores = matcher.computeScoreMap(flatImage);
+      for(size_t ii = 0; ii < scores.size(); ++ii) {
+        BRICK_TEST_ASSERT(scores[ii] == 0.0);
+      }
+    }
+
+
+    void
+    TemplateMatcherNCCTest::
+    testComputeScoreMapFFT()
+    {
+      // Image sizes that aren't powers of two exercise the padding.
+      Image<GRAY_FLOAT64> image = this->getTestImage(37, 45);
+      Image<GRAY_FLOAT64> templateImage = this->getRegion(image, 5, 9, 16, 20);
+      Image<GRAY8> mask(templateImage.rows(), templateImage.columns());
+      for(size_t row = 0; row < mask.rows(); ++row) {
+        for(size_t column = 0; column < mask.columns(); ++column) {
+          mask(row, column) = ((row + 2 * column) % 5 == 0) ? 0 : 255;
+        }
+      }
+
+      TemplateMatcherNCC<double> matcher(templateImage);
+      TemplateMatcherNCC<double> maskedMatcher(templateImage, mask);
+      for(int ii = 0; ii < 2; ++ii) {
+        TemplateMatcherNCC<double>& currentMatcher =
+          (ii == 0) ? matcher : maskedMatcher;
+        numeric::Array2D<double> directScores =
+          currentMatcher.computeScoreMap(image, TEMPLATE_MATCH_DIRECT);
+        numeric::Array2D<double> fftScores =
+          currentMatcher.computeScoreMap(image, TEMPLATE_MATCH_FFT);
+        numeric::Array2D<double> autoScores =
+          currentMatcher.computeScoreMap(image);
+        BRICK_TEST_ASSERT(fftScores.rows() == directScores.rows());
+        BRICK_TEST_ASSERT(fftScores.columns() == directScores.columns());
+        for(size_t jj = 0; jj < directScores.size(); ++jj) {
+          BRICK_TEST_ASSERT(
+            common::approximatelyEqual(fftScores[jj], directScores[jj],
+                                       1.0E-8));
+          BRICK_TEST_ASSERT(
+            common::approximatelyEqual(autoScores[jj], directScores[jj],
+                                       1.0E-8));
+        }
+        BRICK_TEST_ASSERT(
+          common::approximatelyEqual(fftScores(5, 9), 1.0, 1.0E-8));
+      }
+    }
+
+
+    void
+    TemplateMatcherNCCTest::
+    testComputeScoreMapMasked()
+    {
+      Image<GRAY_FLOAT64> image = this->getTestImage(30, 35);
+      Image<GRAY_FLOAT64> templateImage = this->getRegion(image, 7, 4, 11, 11);
+
+      // Circular mask, and garbage outside of it, which the mask
+      // should hide.
+      Image<GRAY8> mask(templateImage.rows(), templateImage.columns());
+      for(size_t row = 0; row < mask.rows(); ++row) {
+        for(size_t column = 0; column < mask.columns(); ++column) {
+          double dRow = row - 5.0;
+          double dColumn = column - 5.0;
+          mask(row, column) = (dRow * dRow + dColumn * dColumn <= 25.0);
+          if(!mask(row, column)) {
+            templateImage(row, column) = 1000.0 * ((row * 7 + column) % 3);
+          }
+        }
+      }
+
+      TemplateMatcherNCC<double> matcher(templateImage, mask);
+      numeric::Array2D<double> scores =
+        matcher.computeScoreMap(image, TEMPLATE_MATCH_DIRECT);
+      for(size_t row = 0; row < scores.rows(); ++row) {
+        for(size_t column = 0; column < scores.columns(); ++column) {
+          double referenceScore = this->computeReferenceScore(
+            image, templateImage, mask, row, column);
+          BRICK_TEST_ASSERT(
+            common::approximatelyEqual(scores(row, column), referenceScore,
+                                       m_defaultTolerance));
+        }
+      }
+      BRICK_TEST_ASSERT(
+        common::approximatelyEqual(scores(7, 4), 1.0, m_defaultTolerance));
+    }
+
+
+    void
+    TemplateMatcherNCCTest::
+    testComputeScoreMapThreads()
+    {
+      Image<GRAY_FLOAT64> image = this->getTestImage(50, 60);
+      Image<GRAY_FLOAT64> templateImage = this->getRegion(image, 20, 3, 12, 9);
+      TemplateMatcherNCC<double> matcher(templateImage);
+      for(int method = TEMPLATE_MATCH_DIRECT; method <= TEMPLATE_MATCH_FFT;
+          ++method) {
+        numeric::Array2D<double> referenceScores = matcher.computeScoreMap(
+          image, TemplateMatchMethod(method), 1);
+        for(unsigned int numberOfThreads = 0; numberOfThreads < 5;
+            ++numberOfThreads) {
+          numeric::Array2D<double> scores = matcher.computeScoreMap(
+            image, TemplateMatchMethod(method), numberOfThreads);
+          for(size_t ii = 0; ii < scores.size(); ++ii) {
+            BRICK_TEST_ASSERT(scores[ii] == referenceScores[ii]);
+          }
+        }
+      }
+    }
+
+
+    void
+    TemplateMatcherNCCTest::
+    testFindBestMatch()
+    {
+      Image<GRAY_FLOAT64> image = this->getTestImage(200, 240);
+      size_t const targetRow = 117;
+      size_t const targetColumn = 63;
+      Image<GRAY_FLOAT64> templateImage =
+        this->getRegion(image, targetRow, targetColumn, 40, 48);
+      Image<GRAY8> image8(image.rows(), image.columns());
+      Image<GRAY8> templateImage8(templateImage.rows(),
+                                  templateImage.columns());
+      for(size_t ii = 0; ii < image.size(); ++ii) {
+        image8[ii] = static_cast<common::UInt8>(image[ii] * 50.0 + 128.0);
+      }
+      for(size_t ii = 0; ii < templateImage.size(); ++ii) {
+        templateImage8[ii] =
+          static_cast<common::UInt8>(templateImage[ii] * 50.0 + 128.0);
+      }
+
+      // With four levels, the coarsest template is only 5x6 pixels,
+      // which isn't enough to reliably find the target, so we stop
+      // at three.  This is also what the automatic choice gives.
+      TemplateMatcherNCC<double> matcher(templateImage8);
+      for(unsigned int numberOfLevels = 0; numberOfLevels < 4;
+          ++numberOfLevels) {
+        double score;
+        numeric::Index2D position =
+          matcher.findBestMatch(image8, score, numberOfLevels);
+        BRICK_TEST_ASSERT(position.getRow() == int(targetRow));
+        BRICK_TEST_ASSERT(position.getColumn() == int(targetColumn));
+        BRICK_TEST_ASSERT(
+          common::approximatelyEqual(score, 1.0, m_defaultTolerance));
+      }
+
+      // Template the same size as the image.
+      TemplateMatcherNCC<double> fullMatcher(image8);
+      double score;
+      numeric::Index2D position = fullMatcher.findBestMatch(image8, score);
+      BRICK_TEST_ASSERT(position.getRow() == 0);
+      BRICK_TEST_ASSERT(position.getColumn() == 0);
+      BRICK_TEST_ASSERT(
+        common::approximatelyEqual(score, 1.0, m_defaultTolerance));
+    }
+
+
+    void
+    TemplateMatcherNCCTest::
+    testExceptions()
+    {
+      Image<GRAY_FLOAT64> image = this->getTestImage(10, 10);
+      Image<GRAY_FLOAT64> templateImage = this->getTestImage(11, 5);
+      double score;
+
+      TemplateMatcherNCC<double> emptyMatcher;
+      BRICK_TEST_ASSERT_EXCEPTION(
+        common::StateException, emptyMatcher.computeScoreMap(image));
+      BRICK_TEST_ASSERT_EXCEPTION(
+        common::StateException, emptyMatcher.findBestMatch(image, score));
+
+      TemplateMatcherNCC<double> matcher(templateImage);
+      BRICK_TEST_ASSERT_EXCEPTION(
+        common::ValueException, matcher.computeScoreMap(image));
+      BRICK_TEST_ASSERT_EXCEPTION(
+        common::ValueException, matcher.findBestMatch(image, score));
+
+      Image<GRAY8> badMask(3, 3);
+      badMask = 1;
+      BRICK_TEST_ASSERT_EXCEPTION(
+        common::ValueException, matcher.setTemplate(templateImage, badMask));
+      Image<GRAY8> emptyMask(templateImage.rows(), templateImage.columns());
+      emptyMask = 0;
+      BRICK_TEST_ASSERT_EXCEPTION(
+        common::ValueException, matcher.setTemplate(templateImage, emptyMask));
+    }
+
+
+    void
+    TemplateMatcherNCCTest::
+    testExecutionTime()
+    {
+      Image<GRAY_FLOAT64> image = this->getTestImage(480, 640);
+      Image<GRAY8> image8(image.rows(), image.columns());
+      for(size_t ii = 0; ii < image.size(); ++ii) {
+        image8[ii] = static_cast<common::UInt8>(image[ii] * 50.0 + 128.0);
+      }
+      size_t const templateSizes[] = {8, 16, 32, 64};
+      for(size_t ii = 0; ii < 4; ++ii) {
+        Image<GRAY8> templateImage8(templateSizes[ii], templateSizes[ii]);
+        for(size_t row = 0; row < templateImage8.rows(); ++row) {
+          for(size_t column = 0; column < templateImage8.columns();
+              ++column) {
+            templateImage8(row, column) = image8(row + 200, column + 300);
+          }
+        }
+        TemplateMatcherNCC<double> matcher(templateImage8);
+
+        double t0 = brick::utilities::getCurrentTime();
+        matcher.computeScoreMap(image8, TEMPLATE_MATCH_DIRECT);
+        double t1 = brick::utilities::getCurrentTime();
+        matcher.computeScoreMap(image8, TEMPLATE_MATCH_FFT);
+        double t2 = brick::utilities::getCurrentTime();
+        double score;
+        matcher.findBestMatch(image8, score);
+        double t3 = brick::utilities::getCurrentTime();
+
+        std::cout << "Template size " << templateSizes[ii] << ": "
+                  << std::fixed << std::setprecision(5)
+                  << "direct " << t1 - t0 << " s, "
+                  << "FFT " << t2 - t1 << " s, "
+                  << "coarse-to-fine " << t3 - t2 << " s." << std::endl;
+      }
+    }
+
+
+    double
+    TemplateMatcherNCCTest::
+    computeReferenceScore(Image<GRAY_FLOAT64> const& image,
+                          Image<GRAY_FLOAT64> const& templateImage,
+                          Image<GRAY8> const& mask,
+                          size_t row, size_t column)
+    {
+      double count = 0.0;
+      double imageSum = 0.0;
+      double templateSum = 0.0;
+      for(size_t ii = 0; ii < templateImage.rows(); ++ii) {
+        for(size_t jj = 0; jj < templateImage.columns(); ++jj) {
+          if(mask(ii, jj)) {
+            count += 1.0;
+            imageSum += image(row + ii, column + jj);
+            templateSum += templateImage(ii, jj);
+          }
+        }
+      }
+      double imageMean = imageSum / count;
+      double templateMean = templateSum / count;
+      double crossSum = 0.0;
+      double imageSquaredSum = 0.0;
+      double templateSquaredSum = 0.0;
+      for(size_t ii = 0; ii < templateImage.rows(); ++ii) {
+        for(size_t jj = 0; jj < templateImage.columns(); ++jj) {
+          if(mask(ii, jj)) {
+            double imageValue = image(row + ii, column + jj) - imageMean;
+            double templateValue = templateImage(ii, jj) - templateMean;
+            crossSum += imageValue * templateValue;
+            imageSquaredSum += imageValue * imageValue;
+            templateSquaredSum += templateValue * templateValue;
+          }
+        }
+      }
+      return crossSum / std::sqrt(imageSquaredSum * templateSquaredSum);
+    }
+
+
+    Image<GRAY_FLOAT64>
+    TemplateMatcherNCCTest::
+    getRegion(Image<GRAY_FLOAT64> const& image, size_t row, size_t column,
+              size_t rows, size_t columns)
+    {
+      Image<GRAY_FLOAT64> result(rows, columns);
+      for(size_t ii = 0; ii < rows; ++ii) {
+        for(size_t jj = 0; jj < columns; ++jj) {
+          result(ii, jj) = image(row + ii, column + jj);
+        }
+      }
+      return result;
+    }
+
+
+    Image<GRAY_FLOAT64>
+    TemplateMatcherNCCTest::
+    getTestImage(size_t rows, size_t columns)
+    {
+      Image<GRAY_FLOAT64> result(rows, columns);
+      for(size_t row = 0; row < rows; ++row) {
+        for(size_t column = 0; column < columns; ++column) {
+          double x = static_cast<double>(column);
+          double y = static_cast<double>(row);
+          result(row, column) = (std::sin(0.13 * x + 0.05 * y)
+                                 + 0.7 * std::cos(0.071 * y - 0.023 * x * x / 50.0)
+                                 + 0.5 * std::sin(0.31 * x * y / 40.0 + 1.0)
+                                 + 0.3 * std::cos(0.47 * y + 0.29 * x));
+        }
+      }
+      return result;
+    }
+
+  } // namespace computerVision
+
+} // namespace brick
+
+
+#if 0
+
+int main()
+{
+  brick::computerVision::TemplateMatcherNCCTest currentTest;
+  bool result = currentTest.run();
+  return (result ? 0 : 1);
+}
+
+#else
+
+namespace {
+
+  brick::computerVision::TemplateMatcherNCCTest currentTest;
+
+}
+
+#endif
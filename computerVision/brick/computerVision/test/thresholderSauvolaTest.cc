@@ -10,9 +10,11 @@
 ***************************************************************************
 **/
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 
+#include <brick/common/parallelFor.hh>
 #include <brick/computerVision/imageIO.hh>
 #include <brick/computerVision/thresholderSauvola.hh>
 #include <brick/computerVision/utilities.hh>
@@ -42,6 +44,7 @@ namespace brick {
 
       // Tests.
       void testThresholderSauvola();
+      void testComputeBinaryImageStreaming();
       void testExecutionTime();
 
     private:
@@ -62,6 +65,7 @@ namespace brick {
         m_kernelSize(64)
     {
       BRICK_TEST_REGISTER_MEMBER(testThresholderSauvola);
+      BRICK_TEST_REGISTER_MEMBER(testComputeBinaryImageStreaming);
       // BRICK_TEST_REGISTER_MEMBER(testExecutionTime);
     }
 
@@ -86,6 +90,42 @@ namespace brick {
     }
 
 
+    void
+    ThresholderSauvolaTest::
+    testComputeBinaryImageStreaming()
+    {
+      Image<GRAY8> inputImage = readPGM8(getBullseyeFileNamePGM0());
+
+      // Streaming results should match the integral image results
+      // for any window size, sensitivity, or thread count.
+      uint32_t const windowRadii[] = {3, 16, m_kernelSize};
+      double const kappas[] = {0.5, 0.2, -0.3};
+      for(uint32_t ii = 0; ii < 3; ++ii) {
+        for(uint32_t jj = 0; jj < 3; ++jj) {
+          ThresholderSauvola<GRAY8> thresholder(windowRadii[ii], kappas[jj]);
+          Image<GRAY8> referenceImage = thresholder(inputImage);
+          for(uint32_t numberOfThreads = 1; numberOfThreads < 5;
+              ++numberOfThreads) {
+            Image<GRAY8> outputImage = thresholder.computeBinaryImageStreaming(
+              inputImage, numberOfThreads);
+            BRICK_TEST_ASSERT(outputImage.rows() == inputImage.rows());
+            BRICK_TEST_ASSERT(outputImage.columns() == inputImage.columns());
+            BRICK_TEST_ASSERT(
+              std::equal(outputImage.begin(), outputImage.end(),
+                         referenceImage.begin()));
+          }
+        }
+      }
+
+      // Images that are too small should be rejected, just like
+      // setImage() does.
+      ThresholderSauvola<GRAY8> thresholder(m_kernelSize, 0.5);
+      BRICK_TEST_ASSERT_EXCEPTION(
+        brick::common::ValueException,
+        thresholder.computeBinaryImageStreaming(Image<GRAY8>(20, 200)));
+    }
+
+
     void
     ThresholderSauvolaTest::
     testExecutionTime()
@@ -124,6 +164,22 @@ namespace brick {
                 << ", " << bigImage.rows() << ") in "
                 << std::fixed << std::setprecision(5)
                 << t1 - t0 << " seconds" << std::endl;
+      std::cout << "Integral images used "
+                << (2 * (bigImage.rows() + 1) * (bigImage.columns() + 1)
+                    * sizeof(ThresholderSauvola<GRAY8>::SumType))
+                << " bytes." << std::endl;
+
+      // Now the streaming version.
+      uint32_t const numberOfThreads = brick::common::getDefaultNumberOfThreads();
+      t0 = brick::utilities::getCurrentTime();
+      outputImage = thresholder.computeBinaryImageStreaming(
+        bigImage, numberOfThreads);
+      t1 = brick::utilities::getCurrentTime();
+      std::cout << "Streaming version with " << numberOfThreads
+                << " thread(s) took " << t1 - t0 << " seconds, and used "
+                << ThresholderSauvola<GRAY8>::getStreamingWorkspaceSize(
+                  bigImage.columns(), numberOfThreads)
+                << " bytes." << std::endl;
     }
 
   } // namespace computerVision
@@ -115,6 +115,29 @@ namespace brick {
             rgbaImage[pixelIndex] == converter(inputImage2[pixelIndex]));
         }
       }
+
+      // Fast paths and threading must not change the result.
+      for(unsigned int numberOfThreads = 0; numberOfThreads < 5;
+          ++numberOfThreads) {
+        Image<GRAY8> grayImage =
+          convertColorspace<GRAY8>(inputImage2, numberOfThreads);
+        Image<HSV_FLOAT64> hsvImage =
+          convertColorspace<HSV_FLOAT64>(inputImage2, numberOfThreads);
+        Image<YIQ_FLOAT64> yiqImage =
+          convertColorspace<YIQ_FLOAT64>(inputImage2, numberOfThreads);
+        ColorspaceConverter<RGB8, GRAY8> grayConverter;
+        ColorspaceConverter<RGB8, HSV_FLOAT64> hsvConverter;
+        ColorspaceConverter<RGB8, YIQ_FLOAT64> yiqConverter;
+        for(size_t pixelIndex = 0; pixelIndex < inputImage2.size();
+            ++pixelIndex) {
+          BRICK_TEST_ASSERT(
+            grayImage[pixelIndex] == grayConverter(inputImage2[pixelIndex]));
+          BRICK_TEST_ASSERT(
+            hsvImage[pixelIndex] == hsvConverter(inputImage2[pixelIndex]));
+          BRICK_TEST_ASSERT(
+            yiqImage[pixelIndex] == yiqConverter(inputImage2[pixelIndex]));
+        }
+      }
     }
 
 
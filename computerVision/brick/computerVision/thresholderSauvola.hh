@@ -53,7 +53,9 @@ namespace brick {
      **
      ** Our implementation uses integral images to speed up the
      ** computation of local mean and variance, at the expense of
-     ** increased memory footprint.
+     ** increased memory footprint.  For very large images, member
+     ** function computeBinaryImageStreaming() gives the same result
+     ** using running column sums, which need much less memory.
      **
      ** Use this class as follows:
      **
@@ -115,6 +117,63 @@ namespace brick {
       computeBinaryImage();
 
 
+      /**
+       * Computes a thresholded image without building integral
+       * images.  This member function produces the same output as
+       * calling setImage() followed by computeBinaryImage(), but is
+       * intended for very large images (e.g., high resolution
+       * document scans), where the two full-size integral images
+       * would take up a lot of memory.  Instead, the image is split
+       * into bands of rows.  Each band keeps a running sum (and sum
+       * of squares) for each column over the current
+       * (2*windowRadius + 1)-row window, updating it incrementally as
+       * the window slides down the image, so the working memory is
+       * proportional to the width of the image, not its area.  The
+       * threshold comparison is rearranged so that no square root is
+       * needed, and bands can be processed on concurrent threads.
+       *
+       * This member function does not use or affect the image set by
+       * setImage().
+       *
+       * @param inputImage This argument is the image to be thresholded.
+       *
+       * @param numberOfThreads This argument specifies how many bands
+       * of rows should be processed concurrently.  Setting it to zero
+       * uses one thread per available processor.
+       *
+       * @return The return value is an Image<GRAY8> in which
+       * forground (text) pixels are black (i.e., have pixel value 0)
+       * and background pixels are white (i.e., have pixel value 255).
+       */
+      Image<GRAY8>
+      computeBinaryImageStreaming(Image<Format> const& inputImage,
+                                  uint32_t numberOfThreads = 1);
+
+
+      /**
+       * Returns the number of bytes of working memory (not counting
+       * the input and output images) that computeBinaryImageStreaming()
+       * allocates for an image of the specified width.  This is
+       * useful for comparing against the two
+       * (rows + 1) x (columns + 1) integral images allocated by
+       * setImage().
+       *
+       * @param columns This argument is the width of the input image.
+       *
+       * @param numberOfThreads This argument is the number of threads
+       * that will be passed to computeBinaryImageStreaming().
+       *
+       * @return The return value is the size of the workspace in bytes.
+       */
+      static size_t
+      getStreamingWorkspaceSize(uint32_t columns, uint32_t numberOfThreads) {
+        // Two arrays of column sums, plus two arrays of running
+        // sums along the row, for each thread.
+        return (size_t(numberOfThreads) * (4 * size_t(columns) + 2)
+                * sizeof(SumType));
+      }
+
+
       /**
        * Sets the image to be thresholded, and does preprocessing so
        * that subsequent calls to member function computeBinaryImage()
@@ -180,6 +239,20 @@ namespace brick {
 
     private:
 
+      // Throws if inputImage is too small for the current window size.
+      void
+      checkImageSize(Image<Format> const& inputImage,
+                     char const* functionName);
+
+
+      // Does the work of computeBinaryImageStreaming() for rows in the
+      // range [beginRow, endRow).
+      void
+      computeBinaryRows(Image<Format> const& inputImage,
+                        Image<GRAY8>& outputImage,
+                        int32_t beginRow, int32_t endRow);
+
+
       // Quick and dirty routine to make sure an image ROI is
       // completely within the image (i.e., doesn't extend past one of
       // the image borders).  Assumes the image is bigger than the
@@ -34,6 +34,8 @@ namespace brick {
 
 #include <cmath>
 #include <limits>
+#include <vector>
+#include <brick/common/parallelFor.hh>
 
 namespace brick {
 
@@ -157,6 +159,28 @@ namespace brick {
     }
 
 
+    // Computes a thresholded image without building integral images.
+    template <ImageFormat Format, class Config>
+    Image<GRAY8>
+    ThresholderSauvola<Format, Config>::
+    computeBinaryImageStreaming(Image<Format> const& inputImage,
+                                uint32_t numberOfThreads)
+    {
+      this->checkImageSize(
+        inputImage, "ThresholderSauvola::computeBinaryImageStreaming()");
+
+      Image<GRAY8> outputImage(inputImage.rows(), inputImage.columns());
+      brick::common::parallelFor(
+        0, inputImage.rows(), numberOfThreads,
+        [&](std::size_t beginRow, std::size_t endRow, std::size_t) {
+          this->computeBinaryRows(inputImage, outputImage,
+                                  static_cast<int32_t>(beginRow),
+                                  static_cast<int32_t>(endRow));
+        });
+      return outputImage;
+    }
+
+
     // Sets the image to be thresholded, and does preprocessing so
     // that subsequent calls to member function computeBinaryImage()
     // can execute quickly.
@@ -164,6 +188,23 @@ namespace brick {
     void
     ThresholderSauvola<Format, Config>::
     setImage(Image<Format> const& inputImage)
+    {
+      this->checkImageSize(inputImage, "ThresholderSauvola::setImage()");
+
+      m_inputImage = inputImage;
+      m_sumIntegrator.setArray(inputImage);
+      m_squaredSumIntegrator.setArray(
+        inputImage, [](PixelType const& xx) {return xx * xx;});
+    }
+
+
+
+    // ============== Private member functions below this line ==============
+
+    template <ImageFormat Format, class Config>
+    void
+    ThresholderSauvola<Format, Config>::
+    checkImageSize(Image<Format> const& inputImage, char const* functionName)
     {
       if(inputImage.rows() < this->getWindowSize()
          || inputImage.columns() < this->getWindowSize()) {
@@ -172,15 +213,134 @@ namespace brick {
                 << ", " << inputImage.columns() << ") is not large enough to "
                 << "accommodate window size of (" << this->getWindowSize()
                 << ", " << this->getWindowSize() << ").";
-        BRICK_THROW(brick::common::ValueException,
-                    "ThresholderSauvola::setImage()",
+        BRICK_THROW(brick::common::ValueException, functionName,
                     message.str().c_str());
       }
+    }
 
-      m_inputImage = inputImage;
-      m_sumIntegrator.setArray(inputImage);
-      m_squaredSumIntegrator.setArray(
-        inputImage, [](PixelType const& xx) {return xx * xx;});
+
+    template <ImageFormat Format, class Config>
+    void
+    ThresholderSauvola<Format, Config>::
+    computeBinaryRows(Image<Format> const& inputImage,
+                      Image<GRAY8>& outputImage,
+                      int32_t beginRow, int32_t endRow)
+    {
+      // Window geometry is exactly as in computeBinaryImage().
+      int32_t const windowSize = static_cast<int32_t>(this->getWindowSize());
+      int32_t const windowRadius = static_cast<int32_t>(this->m_windowRadius);
+      FloatType const windowArea =
+        static_cast<FloatType>(windowSize * windowSize);
+      int32_t const totalRows = static_cast<int32_t>(inputImage.rows());
+      int32_t const totalColumns = static_cast<int32_t>(inputImage.columns());
+
+      // Sauvola's rule says a pixel is white if
+      //
+      // @code
+      //   x > mu * (1 + kappa * (sigma / R - 1))
+      // @endcode
+      //
+      // where mu and sigma are the local mean and standard deviation,
+      // and R is Config::getMaxStdDev().  Rearranging gives
+      //
+      // @code
+      //   x - mu * (1 - kappa) > (mu * kappa / R) * sigma,
+      // @endcode
+      //
+      // or lhs > rhsScale * sigma, which we can test by comparing
+      // squares (taking care with signs) so that we never need to
+      // compute sigma itself.
+      FloatType const oneMinusKappa = FloatType(1) - this->m_kappa;
+      FloatType const rhsFactor = this->m_kappa / Config::getMaxStdDev();
+      uint8_t const whiteValue = Config::getWhiteValue();
+      uint8_t const blackValue = Config::getBlackValue();
+
+      // Running sums down each column over the current window, and
+      // running sums of those along the current row.
+      std::vector<SumType> columnSums(totalColumns, SumType(0));
+      std::vector<SumType> columnSquaredSums(totalColumns, SumType(0));
+      std::vector<SumType> rowSums(totalColumns + 1, SumType(0));
+      std::vector<SumType> rowSquaredSums(totalColumns + 1, SumType(0));
+
+      // This is the window row range that columnSums currently covers.
+      int32_t sumBeginRow = 0;
+      int32_t sumEndRow = 0;
+
+      for(int32_t rr = beginRow; rr < endRow; ++rr) {
+        int32_t roiBeginRow = rr - windowRadius;
+        int32_t roiEndRow = roiBeginRow + windowSize;
+        this->adjustWindowCoordinates(
+          roiBeginRow, roiEndRow, 0, totalRows, windowSize);
+
+        // Slide the column sums to cover the new window.  The window
+        // moves by at most one row between iterations, except on the
+        // first row of the band, where we start from scratch.
+        if(rr == beginRow) {
+          sumBeginRow = roiBeginRow;
+          sumEndRow = roiBeginRow;
+        }
+        while(sumBeginRow < roiBeginRow) {
+          PixelType const* inPtr = inputImage.rowBegin(sumBeginRow);
+          for(int32_t cc = 0; cc < totalColumns; ++cc) {
+            columnSums[cc] -= static_cast<SumType>(inPtr[cc]);
+            columnSquaredSums[cc] -= static_cast<SumType>(inPtr[cc] * inPtr[cc]);
+          }
+          ++sumBeginRow;
+        }
+        while(sumEndRow < roiEndRow) {
+          PixelType const* inPtr = inputImage.rowBegin(sumEndRow);
+          for(int32_t cc = 0; cc < totalColumns; ++cc) {
+            columnSums[cc] += static_cast<SumType>(inPtr[cc]);
+            columnSquaredSums[cc] += static_cast<SumType>(inPtr[cc] * inPtr[cc]);
+          }
+          ++sumEndRow;
+        }
+
+        // Running sums along the row let us get any window's worth of
+        // column sums with a single subtraction.
+        for(int32_t cc = 0; cc < totalColumns; ++cc) {
+          rowSums[cc + 1] = rowSums[cc] + columnSums[cc];
+          rowSquaredSums[cc + 1] = rowSquaredSums[cc] + columnSquaredSums[cc];
+        }
+
+        PixelType const* inPtr = inputImage.rowBegin(rr);
+        uint8_t* outPtr = outputImage.rowBegin(rr);
+        for(int32_t cc = 0; cc < totalColumns; ++cc) {
+          int32_t roiBeginColumn = cc - windowRadius;
+          int32_t roiEndColumn = roiBeginColumn + windowSize;
+          this->adjustWindowCoordinates(
+            roiBeginColumn, roiEndColumn, 0, totalColumns, windowSize);
+
+          // Same mean and (unbiased) variance computation as in
+          // computeBinaryImage().
+          SumType pixelSum = rowSums[roiEndColumn] - rowSums[roiBeginColumn];
+          SumType squaredSum =
+            rowSquaredSums[roiEndColumn] - rowSquaredSums[roiBeginColumn];
+          FloatType localMean = static_cast<FloatType>(pixelSum) / windowArea;
+          FloatType localVariance = static_cast<FloatType>(squaredSum);
+          localVariance -= (localMean * localMean * windowArea);
+          localVariance /= static_cast<FloatType>(windowArea - 1);
+
+          FloatType lhs =
+            static_cast<FloatType>(inPtr[cc]) - localMean * oneMinusKappa;
+          FloatType rhsScale = localMean * rhsFactor;
+          FloatType lhsSquared = lhs * lhs;
+          FloatType rhsSquared = rhsScale * rhsScale * localVariance;
+
+          // Roundoff can make the variance very slightly negative, in
+          // which case computeBinaryImage() takes the square root of a
+          // negative number, and the comparison fails.  We do the same.
+          bool isWhite;
+          if(localVariance < FloatType(0)) {
+            isWhite = false;
+          } else if(rhsScale >= FloatType(0)) {
+            isWhite = (lhs > FloatType(0)) && (lhsSquared > rhsSquared);
+          } else {
+            isWhite = (lhs > FloatType(0)) || (lhsSquared < rhsSquared);
+          }
+          outPtr[cc] = isWhite ? whiteValue : blackValue;
+        }
+      }
     }
 
   } // namespace computerVision
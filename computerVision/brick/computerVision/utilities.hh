@@ -118,13 +118,24 @@ namespace brick {
      * such as when converting from RGB8 to YUV420, please use a
      * different routine.
      *
+     * Conversion is done a row at a time using
+     * ColorspaceConverter::convertRow(), which has table-driven fast
+     * paths for some common format pairs (for example RGB8 to GRAY8,
+     * HSV_FLOAT64, or YIQ_FLOAT64).  Results are identical to those
+     * of applying ColorspaceConverter::operator()() to each pixel.
+     *
      * @param inputImage This argument is the image to be converted.
      *
+     * @param numberOfThreads This argument specifies how many threads
+     * should share the work, each converting a band of rows.  Setting
+     * it to zero uses one thread per available processor.
+     *
      * @return The return value is an image in the converted colorspace.
      */
     template<ImageFormat OUTPUT_FORMAT, ImageFormat INPUT_FORMAT>
     Image<OUTPUT_FORMAT>
-    convertColorspace(const Image<INPUT_FORMAT>& inputImage);
+    convertColorspace(const Image<INPUT_FORMAT>& inputImage,
+                      unsigned int numberOfThreads = 1);
 
 
     /**
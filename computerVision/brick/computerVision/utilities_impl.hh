@@ -19,6 +19,7 @@
 //
 // #include <brick/computerVision/utilities.hh>
 
+#include <brick/common/parallelFor.hh>
 #include <brick/linearAlgebra/linearAlgebra.hh>
 
 namespace brick {
@@ -348,13 +349,27 @@ namespace brick {
     // corresponding image in a second colorspace.
     template<ImageFormat OUTPUT_FORMAT, ImageFormat INPUT_FORMAT>
     Image<OUTPUT_FORMAT>
-    convertColorspace(const Image<INPUT_FORMAT>& inputImage)
+    convertColorspace(const Image<INPUT_FORMAT>& inputImage,
+                      unsigned int numberOfThreads)
     {
       Image<OUTPUT_FORMAT> outputImage(
 	inputImage.rows(), inputImage.columns());
-      ColorspaceConverter<INPUT_FORMAT, OUTPUT_FORMAT> converter;
-      std::transform(inputImage.begin(), inputImage.end(),
-                     outputImage.begin(), converter);
+      size_t const numberOfColumns = inputImage.columns();
+      if(inputImage.rows() == 0 || numberOfColumns == 0) {
+        return outputImage;
+      }
+
+      // Each band gets its own converter, since
+      // ColorspaceConverter::operator()() is not const.
+      brick::common::parallelFor(
+        size_t(0), inputImage.rows(), numberOfThreads,
+        [&](size_t bandBegin, size_t bandEnd, unsigned int) {
+          ColorspaceConverter<INPUT_FORMAT, OUTPUT_FORMAT> converter;
+          for(size_t row = bandBegin; row < bandEnd; ++row) {
+            converter.convertRow(&(inputImage(row, 0)),
+                                 &(outputImage(row, 0)), numberOfColumns);
+          }
+        });
       return outputImage;
     }
 
@@ -0,0 +1,315 @@
+/**
+***************************************************************************
+* @file brick/geometry/boundingVolumeHierarchy3D.hh
+*
+* Header file declaring the BoundingVolumeHierarchy3D class template.
+*
+* Copyright (C) 2026 David LaRose, dlr@cs.cmu.edu
+* See accompanying file, LICENSE.TXT, for details.
+*
+***************************************************************************
+**/
+
+#ifndef BRICK_GEOMETRY_BOUNDINGVOLUMEHIERARCHY3D_HH
+#define BRICK_GEOMETRY_BOUNDINGVOLUMEHIERARCHY3D_HH
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+#include <brick/common/types.hh>
+#include <brick/geometry/ray3D.hh>
+#include <brick/geometry/triangle3D.hh>
+
+namespace brick {
+
+  namespace geometry {
+
+    /**
+     ** The BoundingVolumeHierarchy3D class template accelerates
+     ** ray/triangle intersection queries against large sets of
+     ** triangles, such as scene meshes.  Triangles are grouped into a
+     ** binary tree of axis-aligned bounding boxes, built using the
+     ** surface area heuristic (SAH), and flattened into a single
+     ** contiguous array of nodes so that traversal is cache
+     ** friendly.  A query that would otherwise require testing every
+     ** triangle with checkIntersect(Ray3D const&, Triangle3D const&)
+     ** typically touches only a few dozen nodes.
+     **
+     ** Intersections are reported in terms of the ray parameter
+     ** lambda, so that the intersection point is
+     ** (ray.getOrigin() + lambda * ray.getDirectionVector()).  Only
+     ** intersections with lambda >= 0 (that is, in front of the ray
+     ** origin) are considered.
+     **
+     ** Template argument Type should be a floating point type.
+     **
+     ** Use this class as follows:
+     **
+     ** @code
+     **   std::vector< Triangle3D<double> > mesh = getMyMesh();
+     **   BoundingVolumeHierarchy3D<double> bvh(mesh.begin(), mesh.end());
+     **   std::size_t triangleIndex;
+     **   double lambda;
+     **   if(bvh.findClosestIntersect(ray, triangleIndex, lambda)) {
+     **     // mesh[triangleIndex] is the first triangle hit by ray.
+     **   }
+     ** @endcode
+     **/
+    template <class Type>
+    class BoundingVolumeHierarchy3D {
+    public:
+
+      /**
+       * The default constructor creates an empty hierarchy, which
+       * will never report any intersections.
+       */
+      BoundingVolumeHierarchy3D();
+
+
+      /**
+       * This constructor builds a hierarchy over a sequence of
+       * triangles.  It is equivalent to default construction
+       * followed by a call to setTriangles().
+       *
+       * @param beginIter This argument is an iterator pointing to the
+       * first Triangle3D<Type> in the sequence.
+       *
+       * @param endIter This argument is an iterator pointing one
+       * past the last Triangle3D<Type> in the sequence.
+       *
+       * @param maxTrianglesPerLeaf This argument sets an upper limit
+       * on how many triangles will be stored in each leaf of the
+       * tree, except where several triangles have coincident
+       * centroids, and so can't be split.
+       */
+      template <class Iter>
+      BoundingVolumeHierarchy3D(Iter beginIter, Iter endIter,
+                                std::size_t maxTrianglesPerLeaf = 4);
+
+
+      /**
+       * Destructor.
+       */
+      ~BoundingVolumeHierarchy3D() {}
+
+
+      /**
+       * This member function returns true if the ray intersects any
+       * triangle closer than maxLambda.  It stops at the first
+       * intersection found, so it is faster than
+       * findClosestIntersect(), and is useful for occlusion tests.
+       *
+       * @param ray This argument is the ray to be tested.
+       *
+       * @param maxLambda This argument limits how far along the ray
+       * to search.
+       *
+       * @return The return value is true if an intersection was found.
+       */
+      bool
+      checkIntersect(
+        Ray3D<Type> const& ray,
+        Type maxLambda = std::numeric_limits<Type>::max()) const;
+
+
+      /**
+       * This member function does the same thing as
+       * checkIntersect(Ray3D<Type> const&, Type), but for many rays
+       * at once, optionally spreading the work over several threads.
+       *
+       * @param rays This argument is the set of rays to be tested.
+       *
+       * @param hitFlags This argument will be resized to match rays,
+       * and each element will be set to 1 if the corresponding ray
+       * hits a triangle, and to 0 otherwise.
+       *
+       * @param maxLambda This argument limits how far along each ray
+       * to search.
+       *
+       * @param numberOfThreads This argument specifies how many
+       * threads to use.  Setting it to zero uses one thread per
+       * available processor.
+       *
+       * @return The return value is the number of rays that hit a
+       * triangle.
+       */
+      std::size_t
+      checkIntersects(
+        std::vector< Ray3D<Type> > const& rays,
+        std::vector<brick::common::UInt8>& hitFlags,
+        Type maxLambda = std::numeric_limits<Type>::max(),
+        unsigned int numberOfThreads = 1) const;
+
+
+      /**
+       * This member function finds the first triangle hit by a ray.
+       *
+       * @param ray This argument is the ray to be tested.
+       *
+       * @param triangleIndex If an intersection is found, this
+       * argument is set to the position of the intersected triangle
+       * in the sequence that was passed to the constructor (or to
+       * setTriangles()).
+       *
+       * @param lambda If an intersection is found, this argument is
+       * set to the ray parameter of the intersection.
+       *
+       * @param maxLambda This argument limits how far along the ray
+       * to search.
+       *
+       * @return The return value is true if an intersection was found.
+       */
+      bool
+      findClosestIntersect(
+        Ray3D<Type> const& ray, std::size_t& triangleIndex, Type& lambda,
+        Type maxLambda = std::numeric_limits<Type>::max()) const;
+
+
+      /**
+       * This member function does the same thing as
+       * findClosestIntersect(Ray3D<Type> const&, std::size_t&, Type&,
+       * Type), but for many rays at once.  Consecutive rays are
+       * grouped into small packets that traverse the tree together,
+       * which pays off when neighboring rays are coherent (for
+       * example, rays through adjacent pixels of a camera).  Packets
+       * are optionally spread across several threads.
+       *
+       * @param rays This argument is the set of rays to be tested.
+       *
+       * @param triangleIndices This argument will be resized to
+       * match rays.  Each element will be set to the index of the
+       * first triangle hit by the corresponding ray, or to
+       * getNumberOfTriangles() if the ray hits nothing.
+       *
+       * @param lambdas This argument will be resized to match rays.
+       * Each element will be set to the ray parameter of the
+       * corresponding intersection, or to maxLambda if the ray hits
+       * nothing.
+       *
+       * @param maxLambda This argument limits how far along each ray
+       * to search.
+       *
+       * @param numberOfThreads This argument specifies how many
+       * threads to use.  Setting it to zero uses one thread per
+       * available processor.
+       *
+       * @return The return value is the number of rays that hit a
+       * triangle.
+       */
+      std::size_t
+      findClosestIntersects(
+        std::vector< Ray3D<Type> > const& rays,
+        std::vector<std::size_t>& triangleIndices,
+        std::vector<Type>& lambdas,
+        Type maxLambda = std::numeric_limits<Type>::max(),
+        unsigned int numberOfThreads = 1) const;
+
+
+      /**
+       * This member function returns the number of nodes in the tree.
+       *
+       * @return The return value is the number of nodes, including
+       * leaves.
+       */
+      std::size_t
+      getNumberOfNodes() const {return m_nodes.size();}
+
+
+      /**
+       * This member function returns the number of triangles in the
+       * hierarchy.
+       *
+       * @return The return value is the number of triangles.
+       */
+      std::size_t
+      getNumberOfTriangles() const {return m_triangles.size();}
+
+
+      /**
+       * This member function discards any previously built tree, and
+       * builds a new one over the specified triangles.
+       *
+       * @param beginIter This argument is an iterator pointing to the
+       * first Triangle3D<Type> in the sequence.
+       *
+       * @param endIter This argument is an iterator pointing one
+       * past the last Triangle3D<Type> in the sequence.
+       *
+       * @param maxTrianglesPerLeaf This argument sets an upper limit
+       * on how many triangles will be stored in each leaf of the
+       * tree.
+       */
+      template <class Iter>
+      void
+      setTriangles(Iter beginIter, Iter endIter,
+                   std::size_t maxTrianglesPerLeaf = 4);
+
+    private:
+
+      // Number of rays that traverse the tree together in
+      // findClosestIntersects().
+      static const std::size_t PacketSize = 8;
+
+      // A node of the tree.  Interior nodes have count == 0, their
+      // left child immediately follows them in m_nodes, and offset
+      // is the index of their right child.  Leaf nodes reference
+      // triangles m_triangles[offset] through
+      // m_triangles[offset + count - 1].
+      struct Node {
+        Type lower[3];
+        Type upper[3];
+        brick::common::UInt32 offset;
+        brick::common::UInt32 count;
+        brick::common::UInt32 axis;
+      };
+
+      // Precomputed data for the Moller-Trumbore intersection test.
+      struct TriangleRecord {
+        Type vertex0[3];
+        Type edge0[3];
+        Type edge1[3];
+        std::size_t index;
+      };
+
+      // Precomputed data for the slab test.
+      struct RayRecord {
+        Type origin[3];
+        Type direction[3];
+        Type inverseDirection[3];
+      };
+
+      void
+      buildTree(std::vector<TriangleRecord>& triangles,
+                std::size_t maxTrianglesPerLeaf);
+
+      bool
+      checkIntersect(RayRecord const& ray, Node const& node,
+                     Type maxLambda) const;
+
+      bool
+      checkIntersect(RayRecord const& ray, TriangleRecord const& triangle,
+                     Type maxLambda, Type& lambda) const;
+
+      void
+      findClosestIntersects(RayRecord const* rays, std::size_t numberOfRays,
+                            std::size_t* triangleIndices, Type* lambdas,
+                            std::vector<brick::common::UInt32>& stack) const;
+
+      RayRecord
+      makeRayRecord(Ray3D<Type> const& ray) const;
+
+      std::vector<Node> m_nodes;
+      std::vector<TriangleRecord> m_triangles;
+      std::size_t m_maxDepth;
+
+    }; // class BoundingVolumeHierarchy3D
+
+  } // namespace geometry
+
+} // namespace brick
+
+
+// Include definitions of inline and template functions.
+#include <brick/geometry/boundingVolumeHierarchy3D_impl.hh>
+
+#endif /* #ifndef BRICK_GEOMETRY_BOUNDINGVOLUMEHIERARCHY3D_HH */
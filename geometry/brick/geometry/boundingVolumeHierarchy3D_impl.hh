@@ -0,0 +1,638 @@
+/**
+***************************************************************************
+* @file brick/geometry/boundingVolumeHierarchy3D_impl.hh
+*
+* Header file defining inline and template functions from
+* boundingVolumeHierarchy3D.hh.
+*
+* Copyright (C) 2026 David LaRose, dlr@cs.cmu.edu
+* See accompanying file, LICENSE.TXT, for details.
+*
+***************************************************************************
+**/
+
+#ifndef BRICK_GEOMETRY_BOUNDINGVOLUMEHIERARCHY3D_IMPL_HH
+#define BRICK_GEOMETRY_BOUNDINGVOLUMEHIERARCHY3D_IMPL_HH
+
+// This file is included by boundingVolumeHierarchy3D.hh, and should
+// not be directly included by user code, so no need to include
+// boundingVolumeHierarchy3D.hh here.
+//
+// #include <brick/geometry/boundingVolumeHierarchy3D.hh>
+
+#include <algorithm>
+#include <brick/common/exception.hh>
+#include <brick/common/parallelFor.hh>
+
+namespace brick {
+
+  namespace geometry {
+
+    /// @cond privateCode
+    namespace privateCode {
+
+      // Number of bins used when evaluating candidate SAH splits.
+      const std::size_t bvhNumberOfBins = 16;
+
+
+      // Surface area of an axis-aligned box, as used by the SAH.
+      template <class Type>
+      inline Type
+      getBoxArea(Type const* lower, Type const* upper)
+      {
+        Type dx = upper[0] - lower[0];
+        Type dy = upper[1] - lower[1];
+        Type dz = upper[2] - lower[2];
+        return Type(2) * (dx * dy + dy * dz + dz * dx);
+      }
+
+
+      template <class Type>
+      inline void
+      growBox(Type* lower, Type* upper,
+              Type const* otherLower, Type const* otherUpper)
+      {
+        for(int axis = 0; axis < 3; ++axis) {
+          lower[axis] = std::min(lower[axis], otherLower[axis]);
+          upper[axis] = std::max(upper[axis], otherUpper[axis]);
+        }
+      }
+
+
+      template <class Type>
+      inline void
+      resetBox(Type* lower, Type* upper)
+      {
+        for(int axis = 0; axis < 3; ++axis) {
+          lower[axis] = std::numeric_limits<Type>::max();
+          upper[axis] = -std::numeric_limits<Type>::max();
+        }
+      }
+
+    } // namespace privateCode
+    /// @endcond
+
+
+    template <class Type>
+    const std::size_t BoundingVolumeHierarchy3D<Type>::PacketSize;
+
+
+    template <class Type>
+    BoundingVolumeHierarchy3D<Type>::
+    BoundingVolumeHierarchy3D()
+      : m_nodes(),
+        m_triangles(),
+        m_maxDepth(0)
+    {
+      // Empty.
+    }
+
+
+    template <class Type>
+    template <class Iter>
+    BoundingVolumeHierarchy3D<Type>::
+    BoundingVolumeHierarchy3D(Iter beginIter, Iter endIter,
+                              std::size_t maxTrianglesPerLeaf)
+      : m_nodes(),
+        m_triangles(),
+        m_maxDepth(0)
+    {
+      this->setTriangles(beginIter, endIter, maxTrianglesPerLeaf);
+    }
+
+
+    template <class Type>
+    bool
+    BoundingVolumeHierarchy3D<Type>::
+    checkIntersect(Ray3D<Type> const& ray, Type maxLambda) const
+    {
+      if(m_nodes.empty()) {
+        return false;
+      }
+      RayRecord rayRecord = this->makeRayRecord(ray);
+      std::vector<brick::common::UInt32> stack(m_maxDepth + 2);
+      std::size_t stackSize = 0;
+      stack[stackSize++] = 0;
+      Type lambda;
+      while(stackSize != 0) {
+        Node const& node = m_nodes[stack[--stackSize]];
+        if(!this->checkIntersect(rayRecord, node, maxLambda)) {
+          continue;
+        }
+        if(node.count != 0) {
+          for(std::size_t ii = node.offset; ii < node.offset + node.count;
+              ++ii) {
+            if(this->checkIntersect(
+                 rayRecord, m_triangles[ii], maxLambda, lambda)) {
+              return true;
+            }
+          }
+        } else {
+          stack[stackSize++] = node.offset;
+          stack[stackSize++] = static_cast<brick::common::UInt32>(
+            &node - &(m_nodes[0]) + 1);
+        }
+      }
+      return false;
+    }
+
+
+    template <class Type>
+    std::size_t
+    BoundingVolumeHierarchy3D<Type>::
+    checkIntersects(std::vector< Ray3D<Type> > const& rays,
+                    std::vector<brick::common::UInt8>& hitFlags,
+                    Type maxLambda,
+                    unsigned int numberOfThreads) const
+    {
+      hitFlags.resize(rays.size());
+      std::vector<std::size_t> hitCounts(
+        brick::common::getNumberOfBands(rays.size(), numberOfThreads), 0);
+      brick::common::parallelFor(
+        0, rays.size(), numberOfThreads,
+        [&](std::size_t begin, std::size_t end, std::size_t band) {
+          for(std::size_t ii = begin; ii < end; ++ii) {
+            hitFlags[ii] = this->checkIntersect(rays[ii], maxLambda) ? 1 : 0;
+            hitCounts[band] += hitFlags[ii];
+          }
+        });
+      std::size_t numberOfHits = 0;
+      for(std::size_t ii = 0; ii < hitCounts.size(); ++ii) {
+        numberOfHits += hitCounts[ii];
+      }
+      return numberOfHits;
+    }
+
+
+    template <class Type>
+    bool
+    BoundingVolumeHierarchy3D<Type>::
+    findClosestIntersect(Ray3D<Type> const& ray, std::size_t& triangleIndex,
+                         Type& lambda, Type maxLambda) const
+    {
+      RayRecord rayRecord = this->makeRayRecord(ray);
+      std::vector<brick::common::UInt32> stack(m_maxDepth + 2);
+      std::size_t closestIndex = m_triangles.size();
+      Type closestLambda = maxLambda;
+      this->findClosestIntersects(
+        &rayRecord, 1, &closestIndex, &closestLambda, stack);
+      if(closestIndex == m_triangles.size()) {
+        return false;
+      }
+      triangleIndex = closestIndex;
+      lambda = closestLambda;
+      return true;
+    }
+
+
+    template <class Type>
+    std::size_t
+    BoundingVolumeHierarchy3D<Type>::
+    findClosestIntersects(std::vector< Ray3D<Type> > const& rays,
+                          std::vector<std::size_t>& triangleIndices,
+                          std::vector<Type>& lambdas,
+                          Type maxLambda,
+                          unsigned int numberOfThreads) const
+    {
+      triangleIndices.resize(rays.size());
+      lambdas.resize(rays.size());
+      std::fill(triangleIndices.begin(), triangleIndices.end(),
+                m_triangles.size());
+      std::fill(lambdas.begin(), lambdas.end(), maxLambda);
+
+      // Work is divided by packets, so that threads never split a
+      // packet between them.
+      std::size_t const numberOfPackets =
+        (rays.size() + PacketSize - 1) / PacketSize;
+      brick::common::parallelFor(
+        0, numberOfPackets, numberOfThreads,
+        [&](std::size_t begin, std::size_t end, std::size_t) {
+          std::vector<brick::common::UInt32> stack(m_maxDepth + 2);
+          RayRecord packet[PacketSize];
+          for(std::size_t packetIndex = begin; packetIndex < end;
+              ++packetIndex) {
+            std::size_t const firstRay = packetIndex * PacketSize;
+            std::size_t const packetRays =
+              std::min(PacketSize, rays.size() - firstRay);
+            for(std::size_t ii = 0; ii < packetRays; ++ii) {
+              packet[ii] = this->makeRayRecord(rays[firstRay + ii]);
+            }
+            this->findClosestIntersects(
+              packet, packetRays, &(triangleIndices[firstRay]),
+              &(lambdas[firstRay]), stack);
+          }
+        });
+
+      return rays.size() - std::count(
+        triangleIndices.begin(), triangleIndices.end(), m_triangles.size());
+    }
+
+
+    template <class Type>
+    template <class Iter>
+    void
+    BoundingVolumeHierarchy3D<Type>::
+    setTriangles(Iter beginIter, Iter endIter,
+                 std::size_t maxTrianglesPerLeaf)
+    {
+      if(maxTrianglesPerLeaf == 0) {
+        BRICK_THROW(brick::common::ValueException,
+                    "BoundingVolumeHierarchy3D::setTriangles()",
+                    "Argument maxTrianglesPerLeaf must be nonzero.");
+      }
+
+      std::vector<TriangleRecord> triangles;
+      std::size_t index = 0;
+      while(beginIter != endIter) {
+        Triangle3D<Type> const& triangle = *beginIter;
+        brick::numeric::Vector3D<Type> edge0 =
+          triangle.getVertex1() - triangle.getVertex0();
+        brick::numeric::Vector3D<Type> edge1 =
+          triangle.getVertex2() - triangle.getVertex0();
+
+        TriangleRecord record;
+        record.vertex0[0] = triangle.getVertex0().x();
+        record.vertex0[1] = triangle.getVertex0().y();
+        record.vertex0[2] = triangle.getVertex0().z();
+        record.edge0[0] = edge0.x();
+        record.edge0[1] = edge0.y();
+        record.edge0[2] = edge0.z();
+        record.edge1[0] = edge1.x();
+        record.edge1[1] = edge1.y();
+        record.edge1[2] = edge1.z();
+        record.index = index;
+        triangles.push_back(record);
+        ++beginIter;
+        ++index;
+      }
+      this->buildTree(triangles, maxTrianglesPerLeaf);
+    }
+
+
+    // ============== Private member functions below this line ==============
+
+    template <class Type>
+    void
+    BoundingVolumeHierarchy3D<Type>::
+    buildTree(std::vector<TriangleRecord>& triangles,
+              std::size_t maxTrianglesPerLeaf)
+    {
+      std::size_t const numberOfTriangles = triangles.size();
+      if(numberOfTriangles
+         >= std::size_t(std::numeric_limits<brick::common::UInt32>::max())) {
+        BRICK_THROW(brick::common::ValueException,
+                    "BoundingVolumeHierarchy3D::buildTree()",
+                    "Too many triangles.");
+      }
+
+      m_nodes.clear();
+      m_triangles.clear();
+      m_maxDepth = 0;
+      if(numberOfTriangles == 0) {
+        return;
+      }
+
+      // Precompute the bounding box and centroid of each triangle.
+      std::vector<Type> lowers(3 * numberOfTriangles);
+      std::vector<Type> uppers(3 * numberOfTriangles);
+      std::vector<Type> centroids(3 * numberOfTriangles);
+      for(std::size_t ii = 0; ii < numberOfTriangles; ++ii) {
+        TriangleRecord const& triangle = triangles[ii];
+        for(int axis = 0; axis < 3; ++axis) {
+          Type v0 = triangle.vertex0[axis];
+          Type v1 = v0 + triangle.edge0[axis];
+          Type v2 = v0 + triangle.edge1[axis];
+          lowers[3 * ii + axis] = std::min(v0, std::min(v1, v2));
+          uppers[3 * ii + axis] = std::max(v0, std::max(v1, v2));
+          centroids[3 * ii + axis] =
+            (lowers[3 * ii + axis] + uppers[3 * ii + axis]) / Type(2);
+        }
+      }
+
+      // Tree is built top down, depth first, using an explicit stack
+      // rather than recursion, so that pathological meshes can't
+      // overflow the call stack.  Each task covers the range
+      // [begin, end) of the order vector.
+      struct BuildTask {
+        std::size_t begin;
+        std::size_t end;
+        std::size_t depth;
+        std::size_t parent;
+      };
+      std::size_t const noParent = std::numeric_limits<std::size_t>::max();
+      std::vector<std::size_t> order(numberOfTriangles);
+      for(std::size_t ii = 0; ii < numberOfTriangles; ++ii) {
+        order[ii] = ii;
+      }
+      std::vector<BuildTask> tasks;
+      BuildTask rootTask = {0, numberOfTriangles, 0, noParent};
+      tasks.push_back(rootTask);
+
+      std::size_t const numberOfBins = privateCode::bvhNumberOfBins;
+      while(!tasks.empty()) {
+        BuildTask task = tasks.back();
+        tasks.pop_back();
+        m_maxDepth = std::max(m_maxDepth, task.depth);
+
+        // Right children are linked to their parent explicitly.
+        // Left children always immediately follow their parent.
+        std::size_t const nodeIndex = m_nodes.size();
+        if(task.parent != noParent) {
+          m_nodes[task.parent].offset =
+            static_cast<brick::common::UInt32>(nodeIndex);
+        }
+
+        Node node;
+        Type centroidLower[3];
+        Type centroidUpper[3];
+        privateCode::resetBox(node.lower, node.upper);
+        privateCode::resetBox(centroidLower, centroidUpper);
+        for(std::size_t ii = task.begin; ii < task.end; ++ii) {
+          std::size_t const jj = 3 * order[ii];
+          privateCode::growBox(node.lower, node.upper,
+                               &(lowers[jj]), &(uppers[jj]));
+          privateCode::growBox(centroidLower, centroidUpper,
+                               &(centroids[jj]), &(centroids[jj]));
+        }
+        node.offset = static_cast<brick::common::UInt32>(task.begin);
+        node.count = static_cast<brick::common::UInt32>(task.end - task.begin);
+        node.axis = 0;
+        m_nodes.push_back(node);
+
+        std::size_t const count = task.end - task.begin;
+        if(count <= 1) {
+          continue;
+        }
+
+        // Split along the axis of greatest centroid spread.
+        int axis = 0;
+        for(int candidate = 1; candidate < 3; ++candidate) {
+          if(centroidUpper[candidate] - centroidLower[candidate]
+             > centroidUpper[axis] - centroidLower[axis]) {
+            axis = candidate;
+          }
+        }
+        Type const extent = centroidUpper[axis] - centroidLower[axis];
+        if(extent <= Type(0)) {
+          // All centroids coincide, so no split is possible.
+          continue;
+        }
+
+        // Sort triangles into bins by centroid position.
+        Type const binScale = Type(numberOfBins) / extent;
+        std::size_t binCounts[privateCode::bvhNumberOfBins];
+        Type binLowers[privateCode::bvhNumberOfBins][3];
+        Type binUppers[privateCode::bvhNumberOfBins][3];
+        for(std::size_t bin = 0; bin < numberOfBins; ++bin) {
+          binCounts[bin] = 0;
+          privateCode::resetBox(binLowers[bin], binUppers[bin]);
+        }
+        for(std::size_t ii = task.begin; ii < task.end; ++ii) {
+          std::size_t const jj = 3 * order[ii];
+          std::size_t bin = static_cast<std::size_t>(
+            (centroids[jj + axis] - centroidLower[axis]) * binScale);
+          bin = std::min(bin, numberOfBins - 1);
+          ++binCounts[bin];
+          privateCode::growBox(binLowers[bin], binUppers[bin],
+                               &(lowers[jj]), &(uppers[jj]));
+        }
+
+        // Sweep from the right to get the area and count of
+        // everything to the right of each candidate split plane,
+        // then sweep from the left to evaluate the SAH cost of
+        // splitting after each bin.
+        Type rightAreas[privateCode::bvhNumberOfBins];
+        std::size_t rightCounts[privateCode::bvhNumberOfBins];
+        Type sweepLower[3];
+        Type sweepUpper[3];
+        privateCode::resetBox(sweepLower, sweepUpper);
+        std::size_t sweepCount = 0;
+        for(std::size_t bin = numberOfBins - 1; bin > 0; --bin) {
+          privateCode::growBox(sweepLower, sweepUpper,
+                               binLowers[bin], binUppers[bin]);
+          sweepCount += binCounts[bin];
+          rightAreas[bin] = privateCode::getBoxArea(sweepLower, sweepUpper);
+          rightCounts[bin] = sweepCount;
+        }
+
+        privateCode::resetBox(sweepLower, sweepUpper);
+        sweepCount = 0;
+        Type bestCost = std::numeric_limits<Type>::max();
+        std::size_t bestSplit = 0;
+        for(std::size_t bin = 0; bin < numberOfBins - 1; ++bin) {
+          privateCode::growBox(sweepLower, sweepUpper,
+                               binLowers[bin], binUppers[bin]);
+          sweepCount += binCounts[bin];
+          if(sweepCount == 0 || rightCounts[bin + 1] == 0) {
+            continue;
+          }
+          Type cost =
+            (privateCode::getBoxArea(sweepLower, sweepUpper) * Type(sweepCount)
+             + rightAreas[bin + 1] * Type(rightCounts[bin + 1]));
+          if(cost < bestCost) {
+            bestCost = cost;
+            bestSplit = bin;
+          }
+        }
+
+        // Compare with the cost of just intersecting every triangle
+        // in this node, assuming a node traversal costs about the
+        // same as a triangle test.
+        Type const nodeArea = privateCode::getBoxArea(node.lower, node.upper);
+        Type const leafCost = Type(count);
+        Type const splitCost =
+          Type(1) + ((nodeArea > Type(0)) ? bestCost / nodeArea : Type(0));
+        if(count <= maxTrianglesPerLeaf && leafCost <= splitCost) {
+          continue;
+        }
+
+        std::size_t* middle = std::partition(
+          &(order[0]) + task.begin, &(order[0]) + task.end,
+          [&](std::size_t triangleIndex) {
+            std::size_t bin = static_cast<std::size_t>(
+              (centroids[3 * triangleIndex + axis] - centroidLower[axis])
+              * binScale);
+            return std::min(bin, numberOfBins - 1) <= bestSplit;
+          });
+        std::size_t const split = middle - &(order[0]);
+
+        m_nodes[nodeIndex].count = 0;
+        m_nodes[nodeIndex].axis = static_cast<brick::common::UInt32>(axis);
+        BuildTask rightTask = {split, task.end, task.depth + 1, nodeIndex};
+        BuildTask leftTask = {task.begin, split, task.depth + 1, noParent};
+        tasks.push_back(rightTask);
+        tasks.push_back(leftTask);
+      }
+
+      // Store triangles in leaf order so that each leaf references a
+      // contiguous block.
+      m_triangles.resize(numberOfTriangles);
+      for(std::size_t ii = 0; ii < numberOfTriangles; ++ii) {
+        m_triangles[ii] = triangles[order[ii]];
+      }
+    }
+
+
+    // Slab test for intersection between a ray and a node's bounding
+    // box.  Comparisons are arranged so that NaNs (which arise when a
+    // ray lies exactly in a slab plane) are treated conservatively.
+    template <class Type>
+    inline bool
+    BoundingVolumeHierarchy3D<Type>::
+    checkIntersect(RayRecord const& ray, Node const& node,
+                   Type maxLambda) const
+    {
+      Type nearLambda = Type(0);
+      Type farLambda = maxLambda;
+      for(int axis = 0; axis < 3; ++axis) {
+        Type lambda0 =
+          (node.lower[axis] - ray.origin[axis]) * ray.inverseDirection[axis];
+        Type lambda1 =
+          (node.upper[axis] - ray.origin[axis]) * ray.inverseDirection[axis];
+        if(lambda0 > lambda1) {
+          std::swap(lambda0, lambda1);
+        }
+        nearLambda = (lambda0 > nearLambda) ? lambda0 : nearLambda;
+        farLambda = (lambda1 < farLambda) ? lambda1 : farLambda;
+      }
+      return nearLambda <= farLambda;
+    }
+
+
+    // Moller-Trumbore ray/triangle test.
+    template <class Type>
+    inline bool
+    BoundingVolumeHierarchy3D<Type>::
+    checkIntersect(RayRecord const& ray, TriangleRecord const& triangle,
+                   Type maxLambda, Type& lambda) const
+    {
+      Type const* dd = ray.direction;
+      Type const* e0 = triangle.edge0;
+      Type const* e1 = triangle.edge1;
+
+      Type pp[3] = {dd[1] * e1[2] - dd[2] * e1[1],
+                    dd[2] * e1[0] - dd[0] * e1[2],
+                    dd[0] * e1[1] - dd[1] * e1[0]};
+      Type determinant = e0[0] * pp[0] + e0[1] * pp[1] + e0[2] * pp[2];
+      if(determinant == Type(0)) {
+        // Ray is parallel to the plane of the triangle, or the
+        // triangle is degenerate.
+        return false;
+      }
+      Type inverseDeterminant = Type(1) / determinant;
+
+      Type ss[3] = {ray.origin[0] - triangle.vertex0[0],
+                    ray.origin[1] - triangle.vertex0[1],
+                    ray.origin[2] - triangle.vertex0[2]};
+      Type alpha0 =
+        (ss[0] * pp[0] + ss[1] * pp[1] + ss[2] * pp[2]) * inverseDeterminant;
+      if(alpha0 < Type(0) || alpha0 > Type(1)) {
+        return false;
+      }
+
+      Type qq[3] = {ss[1] * e0[2] - ss[2] * e0[1],
+                    ss[2] * e0[0] - ss[0] * e0[2],
+                    ss[0] * e0[1] - ss[1] * e0[0]};
+      Type alpha1 =
+        (dd[0] * qq[0] + dd[1] * qq[1] + dd[2] * qq[2]) * inverseDeterminant;
+      if(alpha1 < Type(0) || alpha0 + alpha1 > Type(1)) {
+        return false;
+      }
+
+      Type candidate =
+        (e1[0] * qq[0] + e1[1] * qq[1] + e1[2] * qq[2]) * inverseDeterminant;
+      if(candidate < Type(0) || candidate >= maxLambda) {
+        return false;
+      }
+      lambda = candidate;
+      return true;
+    }
+
+
+    // Closest-hit traversal for a packet of up to PacketSize rays.
+    // On entry, lambdas holds the search limit for each ray.
+    template <class Type>
+    void
+    BoundingVolumeHierarchy3D<Type>::
+    findClosestIntersects(RayRecord const* rays, std::size_t numberOfRays,
+                          std::size_t* triangleIndices, Type* lambdas,
+                          std::vector<brick::common::UInt32>& stack) const
+    {
+      if(m_nodes.empty()) {
+        return;
+      }
+
+      bool isActive[PacketSize];
+      std::size_t stackSize = 0;
+      stack[stackSize++] = 0;
+      while(stackSize != 0) {
+        brick::common::UInt32 const nodeIndex = stack[--stackSize];
+        Node const& node = m_nodes[nodeIndex];
+
+        // A node is visited if any ray in the packet hits its box
+        // closer than that ray's current best intersection.
+        bool isAnyActive = false;
+        for(std::size_t rr = 0; rr < numberOfRays; ++rr) {
+          isActive[rr] = this->checkIntersect(rays[rr], node, lambdas[rr]);
+          isAnyActive = isAnyActive || isActive[rr];
+        }
+        if(!isAnyActive) {
+          continue;
+        }
+
+        if(node.count != 0) {
+          for(std::size_t ii = node.offset; ii < node.offset + node.count;
+              ++ii) {
+            TriangleRecord const& triangle = m_triangles[ii];
+            for(std::size_t rr = 0; rr < numberOfRays; ++rr) {
+              if(isActive[rr]
+                 && this->checkIntersect(
+                   rays[rr], triangle, lambdas[rr], lambdas[rr])) {
+                triangleIndices[rr] = triangle.index;
+              }
+            }
+          }
+        } else {
+          // Visit the nearer child first, so that the far child is
+          // more likely to be culled.  The first ray of the packet
+          // decides the order for everyone.
+          brick::common::UInt32 nearChild = nodeIndex + 1;
+          brick::common::UInt32 farChild = node.offset;
+          if(rays[0].direction[node.axis] < Type(0)) {
+            std::swap(nearChild, farChild);
+          }
+          stack[stackSize++] = farChild;
+          stack[stackSize++] = nearChild;
+        }
+      }
+    }
+
+
+    template <class Type>
+    typename BoundingVolumeHierarchy3D<Type>::RayRecord
+    BoundingVolumeHierarchy3D<Type>::
+    makeRayRecord(Ray3D<Type> const& ray) const
+    {
+      RayRecord record;
+      brick::numeric::Vector3D<Type> const& origin = ray.getOrigin();
+      brick::numeric::Vector3D<Type> const& direction =
+        ray.getDirectionVector();
+      record.origin[0] = origin.x();
+      record.origin[1] = origin.y();
+      record.origin[2] = origin.z();
+      record.direction[0] = direction.x();
+      record.direction[1] = direction.y();
+      record.direction[2] = direction.z();
+      for(int axis = 0; axis < 3; ++axis) {
+        // Division by zero gives infinity, which the slab test
+        // handles correctly.
+        record.inverseDirection[axis] = Type(1) / record.direction[axis];
+      }
+      return record;
+    }
+
+  } // namespace geometry
+
+} // namespace brick
+
+#endif /* #ifndef BRICK_GEOMETRY_BOUNDINGVOLUMEHIERARCHY3D_IMPL_HH */
@@ -0,0 +1,345 @@
+/**
+***************************************************************************
+* @file boundingVolumeHierarchy3DTest.cc
+*
+* Source file defining tests for the BoundingVolumeHierarchy3D class.
+*
+* Copyright (C) 2026 David LaRose, dlr@cs.cmu.edu
+* See accompanying file, LICENSE.TXT, for details.
+*
+***************************************************************************
+**/
+
+#include <random>
+#include <vector>
+#include <brick/common/functional.hh>
+#include <brick/geometry/boundingVolumeHierarchy3D.hh>
+#include <brick/geometry/utilities3D.hh>
+#include <brick/test/testFixture.hh>
+
+
+namespace brick {
+
+  namespace geometry {
+
+    class BoundingVolumeHierarchy3DTest
+      : public brick::test::TestFixture<BoundingVolumeHierarchy3DTest> {
+
+    public:
+
+      BoundingVolumeHierarchy3DTest();
+      ~BoundingVolumeHierarchy3DTest() {}
+
+      void setUp(const std::string& /* testName */) {}
+      void tearDown(const std::string& /* testName */) {}
+
+      // Tests.
+      void testCheckIntersect();
+      void testCheckIntersects();
+      void testConstructor();
+      void testFindClosestIntersect();
+      void testFindClosestIntersects();
+
+    private:
+
+      // Brute force reference implementation.
+      bool
+      findClosestIntersectBruteForce(
+        Ray3D<double> const& ray,
+        std::vector< Triangle3D<double> > const& triangles,
+        std::size_t& triangleIndex, double& lambda);
+
+      std::vector< Ray3D<double> >
+      getRandomRays(std::size_t numberOfRays);
+
+      std::vector< Triangle3D<double> >
+      getRandomTriangles(std::size_t numberOfTriangles);
+
+      const double m_defaultTolerance;
+      std::mt19937 m_generator;
+
+    }; // class BoundingVolumeHierarchy3DTest
+
+
+    /* ============== Member Function Definititions ============== */
+
+    BoundingVolumeHierarchy3DTest::
+    BoundingVolumeHierarchy3DTest()
+      : brick::test::TestFixture<BoundingVolumeHierarchy3DTest>(
+          "BoundingVolumeHierarchy3DTest"),
+        m_defaultTolerance(1.0E-9),
+        m_generator(12345)
+    {
+      BRICK_TEST_REGISTER_MEMBER(testCheckIntersect);
+      BRICK_TEST_REGISTER_MEMBER(testCheckIntersects);
+      BRICK_TEST_REGISTER_MEMBER(testConstructor);
+      BRICK_TEST_REGISTER_MEMBER(testFindClosestIntersect);
+      BRICK_TEST_REGISTER_MEMBER(testFindClosestIntersects);
+    }
+
+
+    void
+    BoundingVolumeHierarchy3DTest::
+    testCheckIntersect()
+    {
+      std::vector< Triangle3D<double> > triangles =
+        this->getRandomTriangles(500);
+      std::vector< Ray3D<double> > rays = this->getRandomRays(400);
+      BoundingVolumeHierarchy3D<double> bvh(triangles.begin(), triangles.end());
+
+      std::size_t numberOfHits = 0;
+      for(std::size_t ii = 0; ii < rays.size(); ++ii) {
+        std::size_t triangleIndex;
+        double lambda;
+        bool referenceResult = this->findClosestIntersectBruteForce(
+          rays[ii], triangles, triangleIndex, lambda);
+        BRICK_TEST_ASSERT(bvh.checkIntersect(rays[ii]) == referenceResult);
+        if(referenceResult) {
+          ++numberOfHits;
+
+          // Limiting the search to just short of the closest
+          // intersection should make the ray miss.
+          BRICK_TEST_ASSERT(!bvh.checkIntersect(rays[ii], lambda * 0.999));
+          BRICK_TEST_ASSERT(bvh.checkIntersect(rays[ii], lambda * 1.001));
+        }
+      }
+
+      // Make sure the test exercised both hits and misses.
+      BRICK_TEST_ASSERT(numberOfHits > rays.size() / 10);
+      BRICK_TEST_ASSERT(numberOfHits < rays.size());
+    }
+
+
+    void
+    BoundingVolumeHierarchy3DTest::
+    testCheckIntersects()
+    {
+      std::vector< Triangle3D<double> > triangles =
+        this->getRandomTriangles(500);
+      std::vector< Ray3D<double> > rays = this->getRandomRays(400);
+      BoundingVolumeHierarchy3D<double> bvh(triangles.begin(), triangles.end());
+
+      for(unsigned int numberOfThreads = 1; numberOfThreads <= 4;
+          ++numberOfThreads) {
+        std::vector<brick::common::UInt8> hitFlags;
+        std::size_t numberOfHits = bvh.checkIntersects(
+          rays, hitFlags, std::numeric_limits<double>::max(), numberOfThreads);
+        BRICK_TEST_ASSERT(hitFlags.size() == rays.size());
+
+        std::size_t referenceNumberOfHits = 0;
+        for(std::size_t ii = 0; ii < rays.size(); ++ii) {
+          bool referenceResult = bvh.checkIntersect(rays[ii]);
+          BRICK_TEST_ASSERT((hitFlags[ii] != 0) == referenceResult);
+          referenceNumberOfHits += referenceResult ? 1 : 0;
+        }
+        BRICK_TEST_ASSERT(numberOfHits == referenceNumberOfHits);
+      }
+    }
+
+
+    void
+    BoundingVolumeHierarchy3DTest::
+    testConstructor()
+    {
+      // An empty hierarchy never reports intersections.
+      BoundingVolumeHierarchy3D<double> emptyBvh;
+      std::vector< Ray3D<double> > rays = this->getRandomRays(10);
+      std::size_t triangleIndex;
+      double lambda;
+      BRICK_TEST_ASSERT(emptyBvh.getNumberOfNodes() == 0);
+      BRICK_TEST_ASSERT(emptyBvh.getNumberOfTriangles() == 0);
+      BRICK_TEST_ASSERT(!emptyBvh.checkIntersect(rays[0]));
+      BRICK_TEST_ASSERT(
+        !emptyBvh.findClosestIntersect(rays[0], triangleIndex, lambda));
+
+      // A larger hierarchy should contain all of the triangles, and
+      // respect maxTrianglesPerLeaf.
+      std::vector< Triangle3D<double> > triangles =
+        this->getRandomTriangles(1000);
+      BoundingVolumeHierarchy3D<double> bvh(
+        triangles.begin(), triangles.end(), 2);
+      BRICK_TEST_ASSERT(bvh.getNumberOfTriangles() == triangles.size());
+      BRICK_TEST_ASSERT(bvh.getNumberOfNodes() >= triangles.size() - 1);
+      BRICK_TEST_ASSERT(bvh.getNumberOfNodes() < 2 * triangles.size());
+
+      // Many identical triangles can't be split, and must simply end
+      // up in one big leaf.
+      std::vector< Triangle3D<double> > duplicates(20, triangles[0]);
+      bvh.setTriangles(duplicates.begin(), duplicates.end(), 2);
+      BRICK_TEST_ASSERT(bvh.getNumberOfTriangles() == duplicates.size());
+      BRICK_TEST_ASSERT(bvh.getNumberOfNodes() == 1);
+
+      BRICK_TEST_ASSERT_EXCEPTION(
+        brick::common::ValueException,
+        bvh.setTriangles(triangles.begin(), triangles.end(), 0));
+    }
+
+
+    void
+    BoundingVolumeHierarchy3DTest::
+    testFindClosestIntersect()
+    {
+      std::vector< Triangle3D<double> > triangles =
+        this->getRandomTriangles(500);
+      std::vector< Ray3D<double> > rays = this->getRandomRays(400);
+
+      for(std::size_t maxTrianglesPerLeaf = 1; maxTrianglesPerLeaf <= 8;
+          maxTrianglesPerLeaf *= 2) {
+        BoundingVolumeHierarchy3D<double> bvh(
+          triangles.begin(), triangles.end(), maxTrianglesPerLeaf);
+        for(std::size_t ii = 0; ii < rays.size(); ++ii) {
+          std::size_t referenceIndex = 0;
+          double referenceLambda = 0.0;
+          bool referenceResult = this->findClosestIntersectBruteForce(
+            rays[ii], triangles, referenceIndex, referenceLambda);
+
+          std::size_t triangleIndex = 0;
+          double lambda = 0.0;
+          bool result = bvh.findClosestIntersect(
+            rays[ii], triangleIndex, lambda);
+          BRICK_TEST_ASSERT(result == referenceResult);
+          if(referenceResult) {
+            BRICK_TEST_ASSERT(triangleIndex == referenceIndex);
+            BRICK_TEST_ASSERT(
+              brick::common::approximatelyEqual(
+                lambda, referenceLambda, m_defaultTolerance));
+
+            // Search limit should be respected.
+            BRICK_TEST_ASSERT(
+              !bvh.findClosestIntersect(
+                rays[ii], triangleIndex, lambda, referenceLambda * 0.999));
+          }
+        }
+      }
+    }
+
+
+    void
+    BoundingVolumeHierarchy3DTest::
+    testFindClosestIntersects()
+    {
+      std::vector< Triangle3D<double> > triangles =
+        this->getRandomTriangles(500);
+      std::vector< Ray3D<double> > rays = this->getRandomRays(403);
+      BoundingVolumeHierarchy3D<double> bvh(triangles.begin(), triangles.end());
+
+      for(unsigned int numberOfThreads = 1; numberOfThreads <= 4;
+          ++numberOfThreads) {
+        std::vector<std::size_t> triangleIndices;
+        std::vector<double> lambdas;
+        std::size_t numberOfHits = bvh.findClosestIntersects(
+          rays, triangleIndices, lambdas, 100.0, numberOfThreads);
+        BRICK_TEST_ASSERT(triangleIndices.size() == rays.size());
+        BRICK_TEST_ASSERT(lambdas.size() == rays.size());
+
+        std::size_t referenceNumberOfHits = 0;
+        for(std::size_t ii = 0; ii < rays.size(); ++ii) {
+          std::size_t referenceIndex = 0;
+          double referenceLambda = 0.0;
+          if(bvh.findClosestIntersect(
+               rays[ii], referenceIndex, referenceLambda, 100.0)) {
+            ++referenceNumberOfHits;
+            BRICK_TEST_ASSERT(triangleIndices[ii] == referenceIndex);
+            BRICK_TEST_ASSERT(lambdas[ii] == referenceLambda);
+          } else {
+            BRICK_TEST_ASSERT(triangleIndices[ii] == triangles.size());
+            BRICK_TEST_ASSERT(lambdas[ii] == 100.0);
+          }
+        }
+        BRICK_TEST_ASSERT(numberOfHits == referenceNumberOfHits);
+      }
+    }
+
+
+    bool
+    BoundingVolumeHierarchy3DTest::
+    findClosestIntersectBruteForce(
+      Ray3D<double> const& ray,
+      std::vector< Triangle3D<double> > const& triangles,
+      std::size_t& triangleIndex, double& lambda)
+    {
+      bool result = false;
+      for(std::size_t ii = 0; ii < triangles.size(); ++ii) {
+        double candidate;
+        if(checkIntersect(ray, triangles[ii], candidate)
+           && candidate >= 0.0
+           && (!result || candidate < lambda)) {
+          result = true;
+          lambda = candidate;
+          triangleIndex = ii;
+        }
+      }
+      return result;
+    }
+
+
+    std::vector< Ray3D<double> >
+    BoundingVolumeHierarchy3DTest::
+    getRandomRays(std::size_t numberOfRays)
+    {
+      // Rays start anywhere in a box a bit larger than the one
+      // holding the triangles, and point at random targets inside
+      // the triangle box, so that some start inside the cloud of
+      // triangles, and most hit something.
+      std::uniform_real_distribution<double> originDistribution(-3.0, 3.0);
+      std::uniform_real_distribution<double> targetDistribution(-1.0, 1.0);
+      std::vector< Ray3D<double> > rays;
+      for(std::size_t ii = 0; ii < numberOfRays; ++ii) {
+        brick::numeric::Vector3D<double> origin(
+          originDistribution(m_generator), originDistribution(m_generator),
+          originDistribution(m_generator));
+        brick::numeric::Vector3D<double> target(
+          targetDistribution(m_generator), targetDistribution(m_generator),
+          targetDistribution(m_generator));
+        rays.push_back(Ray3D<double>(origin, target - origin));
+      }
+      return rays;
+    }
+
+
+    std::vector< Triangle3D<double> >
+    BoundingVolumeHierarchy3DTest::
+    getRandomTriangles(std::size_t numberOfTriangles)
+    {
+      std::uniform_real_distribution<double> centerDistribution(-1.0, 1.0);
+      std::uniform_real_distribution<double> offsetDistribution(-0.1, 0.1);
+      std::vector< Triangle3D<double> > triangles;
+      for(std::size_t ii = 0; ii < numberOfTriangles; ++ii) {
+        brick::numeric::Vector3D<double> center(
+          centerDistribution(m_generator), centerDistribution(m_generator),
+          centerDistribution(m_generator));
+        brick::numeric::Vector3D<double> vertices[3];
+        for(int jj = 0; jj < 3; ++jj) {
+          vertices[jj] = center + brick::numeric::Vector3D<double>(
+            offsetDistribution(m_generator), offsetDistribution(m_generator),
+            offsetDistribution(m_generator));
+        }
+        triangles.push_back(
+          Triangle3D<double>(vertices[0], vertices[1], vertices[2]));
+      }
+      return triangles;
+    }
+
+  } // namespace geometry
+
+} // namespace brick
+
+
+#if 0
+
+int main(int argc, char** argv)
+{
+  brick::geometry::BoundingVolumeHierarchy3DTest currentTest;
+  bool result = currentTest.run();
+  return (result ? 0 : 1);
+}
+
+#else
+
+namespace {
+
+  brick::geometry::BoundingVolumeHierarchy3DTest currentTest;
+
+}
+
+#endif
@@ -0,0 +1,308 @@
+/**
+***************************************************************************
+* @file brick/numeric/amanatidesWoo3DBatch.hh
+*
+* Header file declaring AmanatidesWoo3DBatch class.
+*
+* Copyright (C) 2026 David LaRose, dlr@cs.cmu.edu
+* See accompanying file, LICENSE.TXT, for details.
+*
+***************************************************************************
+**/
+
+#ifndef BRICK_NUMERIC_AMANATIDESWOO3DBATCH_HH
+#define BRICK_NUMERIC_AMANATIDESWOO3DBATCH_HH
+
+#include <cstddef>
+#include <vector>
+#include <brick/common/types.hh>
+#include <brick/numeric/array3D.hh>
+#include <brick/numeric/transform3D.hh>
+#include <brick/numeric/vector3D.hh>
+
+namespace brick {
+
+  namespace numeric {
+
+    /**
+     ** This class applies the Fast Voxel Traversal Algorithm of
+     ** Amanatides and Woo to many rays at once.  It uses the same
+     ** voxel and world coordinate systems as class AmanatidesWoo3D,
+     ** and visits exactly the same voxels for each ray, but avoids
+     ** constructing a separate traversal object per ray, and can
+     ** spread the rays across several threads.  This is useful for
+     ** workloads such as space carving and occupancy updates, in
+     ** which millions of rays are cast through the same grid.
+     **
+     ** Voxels are reported by their "flat" index, which is the index
+     ** of the element in the array's data() buffer, so that voxel
+     ** (slice, row, column) has flat index ((slice * rows + row) *
+     ** columns + column).
+     **
+     ** Rays whose direction is (0, 0, 0) are treated as missing the
+     ** grid, and visit no voxels.
+     **
+     ** Here's example usage:
+     **
+     ** @code
+     **   Array3D<float> occupancy(slices, rows, columns);
+     **   occupancy = 0.0;
+     **   AmanatidesWoo3DBatch<double> rayTracer(
+     **     slices, rows, columns, voxelTworld);
+     **   rayTracer.accumulate(occupancy, rayOrigins, rayDirections, 1.0f, 0);
+     ** @endcode
+     **/
+    template <class FLOAT_TYPE = double, class INT_TYPE = int>
+    class AmanatidesWoo3DBatch {
+    public:
+
+      /**
+       * This constructor specifies the shape of the voxel grid, and
+       * how world coordinates map to voxel coordinates.
+       *
+       * @param slices This argument is the number of slices in the
+       * voxel array, corresponding to the W axis.
+       *
+       * @param rows This argument is the number of rows in the voxel
+       * array, corresponding to the V axis.
+       *
+       * @param columns This argument is the number of columns in the
+       * voxel array, corresponding to the U axis.
+       *
+       * @param voxelTworld This argument specifies a coordinate
+       * transformation which takes world coordinates and converts
+       * them into voxel coordinates.
+       *
+       * @param downstreamOnly This argument has the same meaning as
+       * the corresponding argument of the AmanatidesWoo3D
+       * constructor.  If it is false, voxels "upstream" of each ray
+       * origin are included in the traversal.
+       */
+      AmanatidesWoo3DBatch(std::size_t slices, std::size_t rows,
+                           std::size_t columns,
+                           Transform3D<FLOAT_TYPE> const& voxelTworld,
+                           bool downstreamOnly = true);
+
+
+      /**
+       * Destructor.
+       */
+      ~AmanatidesWoo3DBatch() {}
+
+
+      /**
+       * This member function traces each ray through the grid, and
+       * adds increment to every voxel it passes through.  When
+       * several threads are used, each thread records the voxels it
+       * visits in private buffers, and the buffers are then applied
+       * to the array one band of slices per thread, so no two
+       * threads ever write the same voxel, and no locking is needed.
+       * The result does not depend on the number of threads, except
+       * for floating point rounding.
+       *
+       * @param data This argument is the array to be updated.  Its
+       * shape must match the shape passed to the constructor.
+       *
+       * @param rayOrigins This argument specifies the starting point
+       * of each ray, in world coordinates.
+       *
+       * @param rayDirections This argument specifies the direction of
+       * each ray, in world coordinates.  It must have the same size
+       * as rayOrigins.
+       *
+       * @param increment This argument is the amount to be added to
+       * each traversed voxel.
+       *
+       * @param numberOfThreads This argument specifies how many
+       * threads to use.  Setting it to zero uses one thread per
+       * available processor.
+       *
+       * @return The return value is the total number of voxel visits
+       * over all rays.
+       */
+      template <class Type>
+      std::size_t
+      accumulate(Array3D<Type>& data,
+                 std::vector< Vector3D<FLOAT_TYPE> > const& rayOrigins,
+                 std::vector< Vector3D<FLOAT_TYPE> > const& rayDirections,
+                 Type increment,
+                 unsigned int numberOfThreads = 1) const;
+
+
+      /**
+       * This member function traces each ray through the grid until
+       * it reaches the first voxel that is not equal to Type(), and
+       * reports that voxel.  If member function setOccupancy() has
+       * been called, blocks of empty voxels are skipped in a single
+       * step, which is much faster when the grid is mostly empty.
+       *
+       * @param data This argument is the array to be searched.  Its
+       * shape must match the shape passed to the constructor.
+       *
+       * @param rayOrigins This argument specifies the starting point
+       * of each ray, in world coordinates.
+       *
+       * @param rayDirections This argument specifies the direction of
+       * each ray, in world coordinates.  It must have the same size
+       * as rayOrigins.
+       *
+       * @param voxelIndices This argument will be resized to match
+       * rayOrigins.  Each element will be set to the flat index of
+       * the first occupied voxel along the corresponding ray, or to
+       * data.size() if the ray hits no occupied voxel.
+       *
+       * @param lambdas This argument will be resized to match
+       * rayOrigins.  Each element will be set to the ray parameter at
+       * which the corresponding ray enters the reported voxel, or to
+       * zero if there is no such voxel.
+       *
+       * @param numberOfThreads This argument specifies how many
+       * threads to use.  Setting it to zero uses one thread per
+       * available processor.
+       *
+       * @return The return value is the number of rays that hit an
+       * occupied voxel.
+       */
+      template <class Type>
+      std::size_t
+      findFirstOccupied(Array3D<Type> const& data,
+                        std::vector< Vector3D<FLOAT_TYPE> > const& rayOrigins,
+                        std::vector< Vector3D<FLOAT_TYPE> > const& rayDirections,
+                        std::vector<std::size_t>& voxelIndices,
+                        std::vector<FLOAT_TYPE>& lambdas,
+                        unsigned int numberOfThreads = 1) const;
+
+
+      /**
+       * This member function builds a coarse occupancy grid, in
+       * which each cell covers a cube of blockSize x blockSize x
+       * blockSize voxels, and records whether any of those voxels is
+       * not equal to Type().  The coarse grid is used by
+       * findFirstOccupied() to skip empty space.  It must be rebuilt
+       * whenever the array changes.
+       *
+       * @param data This argument is the array to be summarized.  Its
+       * shape must match the shape passed to the constructor.
+       *
+       * @param blockSize This argument specifies the size of each
+       * coarse cell, in voxels.  Setting it to zero discards the
+       * coarse grid, so that findFirstOccupied() visits every voxel.
+       */
+      template <class Type>
+      void
+      setOccupancy(Array3D<Type> const& data, std::size_t blockSize = 8);
+
+
+      /**
+       * This member function traces each ray through the grid, and
+       * calls a user-supplied functor for each voxel visited.  The
+       * functor is called as functor(rayIndex, voxelIndex), where
+       * rayIndex is the position of the ray in rayOrigins, and
+       * voxelIndex is the flat index of the voxel, and must return
+       * true to continue along the ray, or false to stop tracing the
+       * ray.  Voxels are visited in order along each ray.  If more
+       * than one thread is used, the functor will be called
+       * concurrently from several threads, and must be thread safe.
+       *
+       * @param rayOrigins This argument specifies the starting point
+       * of each ray, in world coordinates.
+       *
+       * @param rayDirections This argument specifies the direction of
+       * each ray, in world coordinates.  It must have the same size
+       * as rayOrigins.
+       *
+       * @param functor This argument is the functor to be called.
+       *
+       * @param numberOfThreads This argument specifies how many
+       * threads to use.  Setting it to zero uses one thread per
+       * available processor.
+       *
+       * @return The return value is the total number of calls to the
+       * functor.
+       */
+      template <class Functor>
+      std::size_t
+      traverse(std::vector< Vector3D<FLOAT_TYPE> > const& rayOrigins,
+               std::vector< Vector3D<FLOAT_TYPE> > const& rayDirections,
+               Functor functor,
+               unsigned int numberOfThreads = 1) const;
+
+    private:
+
+      // State of the traversal of a single ray through a grid of
+      // cubical cells.  Arrays are indexed in U, V, W order.
+      struct RayState {
+        INT_TYPE position[3];
+        INT_TYPE step[3];
+        INT_TYPE limit[3];
+        FLOAT_TYPE tMax[3];
+        FLOAT_TYPE tDelta[3];
+        FLOAT_TYPE tEntry;
+      };
+
+
+      // Moves the traversal into the next cell along the ray,
+      // returning false if the ray has left the grid.
+      inline bool
+      advance(RayState& state) const;
+
+
+      template <class Type>
+      void
+      checkShape(Array3D<Type> const& data, char const* functionName) const;
+
+
+      void
+      checkSizes(std::vector< Vector3D<FLOAT_TYPE> > const& rayOrigins,
+                 std::vector< Vector3D<FLOAT_TYPE> > const& rayDirections,
+                 char const* functionName) const;
+
+
+      // Sets up traversal of a ray (expressed in voxel coordinates)
+      // through a grid of cells of size cellSize covering the voxel
+      // array, starting no earlier than tLower.  Returns false if the
+      // ray misses the grid, or if its direction is zero.
+      bool
+      initialize(Vector3D<FLOAT_TYPE> const& rayOriginVoxel,
+                 Vector3D<FLOAT_TYPE> const& rayDirectionVoxel,
+                 FLOAT_TYPE tLower, FLOAT_TYPE cellSize,
+                 RayState& state) const;
+
+
+      // Calls callback(voxelIndex, slice) for each voxel along a
+      // single ray, stopping early if the callback returns false.
+      // Returns the number of voxels visited.
+      template <class Callback>
+      std::size_t
+      traverseRay(Vector3D<FLOAT_TYPE> const& rayOrigin,
+                  Vector3D<FLOAT_TYPE> const& rayDirection,
+                  Callback& callback) const;
+
+
+      void
+      transformRay(Vector3D<FLOAT_TYPE> const& rayOrigin,
+                   Vector3D<FLOAT_TYPE> const& rayDirection,
+                   Vector3D<FLOAT_TYPE>& rayOriginVoxel,
+                   Vector3D<FLOAT_TYPE>& rayDirectionVoxel) const;
+
+
+      std::size_t m_slices;
+      std::size_t m_rows;
+      std::size_t m_columns;
+      Transform3D<FLOAT_TYPE> m_voxelTworld;
+      bool m_downstreamOnly;
+
+      // Coarse occupancy grid used by findFirstOccupied().
+      std::size_t m_blockSize;
+      Array3D<brick::common::UInt8> m_occupancy;
+    };
+
+  } // namespace numeric
+
+} // namespace brick
+
+// Include file containing definitions of inline and template
+// functions.
+#include <brick/numeric/amanatidesWoo3DBatch_impl.hh>
+
+#endif /* #ifndef BRICK_NUMERIC_AMANATIDESWOO3DBATCH_HH */
@@ -0,0 +1,492 @@
+/**
+***************************************************************************
+* @file brick/numeric/amanatidesWoo3DBatch_impl.hh
+*
+* Header file defining inline and template functions declared in
+* amanatidesWoo3DBatch.hh.
+*
+* Copyright (C) 2026 David LaRose, dlr@cs.cmu.edu
+* See accompanying file, LICENSE.TXT, for details.
+*
+***************************************************************************
+**/
+
+#ifndef BRICK_NUMERIC_AMANATIDESWOO3DBATCH_IMPL_HH
+#define BRICK_NUMERIC_AMANATIDESWOO3DBATCH_IMPL_HH
+
+// This file is included by amanatidesWoo3DBatch.hh, and should not be
+// directly included by user code, so no need to include
+// amanatidesWoo3DBatch.hh here.
+//
+// #include <brick/numeric/amanatidesWoo3DBatch.hh>
+
+#include <algorithm>
+#include <limits>
+#include <sstream>
+#include <brick/common/exception.hh>
+#include <brick/common/parallelFor.hh>
+
+namespace brick {
+
+  namespace numeric {
+
+    template <class FLOAT_TYPE, class INT_TYPE>
+    AmanatidesWoo3DBatch<FLOAT_TYPE, INT_TYPE>::
+    AmanatidesWoo3DBatch(std::size_t slices, std::size_t rows,
+                         std::size_t columns,
+                         Transform3D<FLOAT_TYPE> const& voxelTworld,
+                         bool downstreamOnly)
+      : m_slices(slices),
+        m_rows(rows),
+        m_columns(columns),
+        m_voxelTworld(voxelTworld),
+        m_downstreamOnly(downstreamOnly),
+        m_blockSize(0),
+        m_occupancy()
+    {
+      // Empty.
+    }
+
+
+    template <class FLOAT_TYPE, class INT_TYPE>
+    template <class Type>
+    std::size_t
+    AmanatidesWoo3DBatch<FLOAT_TYPE, INT_TYPE>::
+    accumulate(Array3D<Type>& data,
+               std::vector< Vector3D<FLOAT_TYPE> > const& rayOrigins,
+               std::vector< Vector3D<FLOAT_TYPE> > const& rayDirections,
+               Type increment,
+               unsigned int numberOfThreads) const
+    {
+      this->checkShape(data, "AmanatidesWoo3DBatch::accumulate()");
+      this->checkSizes(rayOrigins, rayDirections,
+                       "AmanatidesWoo3DBatch::accumulate()");
+
+      Type* dataPtr = data.data();
+      std::size_t const numberOfRays = rayOrigins.size();
+      std::size_t const numberOfBands =
+        brick::common::getNumberOfBands(numberOfRays, numberOfThreads);
+
+      // Single threaded case is easy.
+      if(numberOfBands == 1) {
+        auto callback = [&](std::size_t voxelIndex, std::size_t) {
+          dataPtr[voxelIndex] += increment;
+          return true;
+        };
+        std::size_t numberOfVisits = 0;
+        for(std::size_t ii = 0; ii < numberOfRays; ++ii) {
+          numberOfVisits += this->traverseRay(
+            rayOrigins[ii], rayDirections[ii], callback);
+        }
+        return numberOfVisits;
+      }
+
+      // Multithreaded case.  Rays are processed in chunks so that the
+      // per-thread buffers stay small.  During the first phase of
+      // each chunk, thread N traces rays and sorts the visited voxel
+      // indices into buffers[N][M], where M is the band of slices
+      // that contains the voxel.  During the second phase, thread M
+      // applies buffers[0][M] through buffers[numberOfBands - 1][M]
+      // to the array.
+      std::size_t const raysPerChunk = 1024 * numberOfBands;
+      std::vector< std::vector< std::vector<std::size_t> > > buffers(
+        numberOfBands, std::vector< std::vector<std::size_t> >(numberOfBands));
+      std::vector<std::size_t> numberOfVisits(numberOfBands, 0);
+
+      for(std::size_t chunkBegin = 0; chunkBegin < numberOfRays;
+          chunkBegin += raysPerChunk) {
+        std::size_t chunkEnd = std::min(chunkBegin + raysPerChunk, numberOfRays);
+
+        brick::common::parallelFor(
+          chunkBegin, chunkEnd, numberOfBands,
+          [&](std::size_t begin, std::size_t end, std::size_t band) {
+            std::vector< std::vector<std::size_t> >& bandBuffers =
+              buffers[band];
+            auto callback = [&](std::size_t voxelIndex, std::size_t slice) {
+              bandBuffers[(slice * numberOfBands) / m_slices].push_back(
+                voxelIndex);
+              return true;
+            };
+            for(std::size_t ii = begin; ii < end; ++ii) {
+              numberOfVisits[band] += this->traverseRay(
+                rayOrigins[ii], rayDirections[ii], callback);
+            }
+          });
+
+        brick::common::parallelFor(
+          0, numberOfBands, numberOfBands,
+          [&](std::size_t begin, std::size_t end, std::size_t) {
+            for(std::size_t target = begin; target < end; ++target) {
+              for(std::size_t source = 0; source < numberOfBands; ++source) {
+                std::vector<std::size_t>& buffer = buffers[source][target];
+                for(std::size_t ii = 0; ii < buffer.size(); ++ii) {
+                  dataPtr[buffer[ii]] += increment;
+                }
+                buffer.clear();
+              }
+            }
+          });
+      }
+
+      std::size_t totalVisits = 0;
+      for(std::size_t ii = 0; ii < numberOfBands; ++ii) {
+        totalVisits += numberOfVisits[ii];
+      }
+      return totalVisits;
+    }
+
+
+    template <class FLOAT_TYPE, class INT_TYPE>
+    template <class Type>
+    std::size_t
+    AmanatidesWoo3DBatch<FLOAT_TYPE, INT_TYPE>::
+    findFirstOccupied(Array3D<Type> const& data,
+                      std::vector< Vector3D<FLOAT_TYPE> > const& rayOrigins,
+                      std::vector< Vector3D<FLOAT_TYPE> > const& rayDirections,
+                      std::vector<std::size_t>& voxelIndices,
+                      std::vector<FLOAT_TYPE>& lambdas,
+                      unsigned int numberOfThreads) const
+    {
+      this->checkShape(data, "AmanatidesWoo3DBatch::findFirstOccupied()");
+      this->checkSizes(rayOrigins, rayDirections,
+                       "AmanatidesWoo3DBatch::findFirstOccupied()");
+
+      std::size_t const numberOfRays = rayOrigins.size();
+      voxelIndices.resize(numberOfRays);
+      lambdas.resize(numberOfRays);
+      std::vector<std::size_t> numberOfHits(
+        brick::common::getNumberOfBands(numberOfRays, numberOfThreads), 0);
+
+      Type const* dataPtr = data.data();
+      FLOAT_TYPE const tLower =
+        m_downstreamOnly ? FLOAT_TYPE(0) : -std::numeric_limits<FLOAT_TYPE>::max();
+      FLOAT_TYPE const blockSize = static_cast<FLOAT_TYPE>(m_blockSize);
+
+      brick::common::parallelFor(
+        0, numberOfRays, numberOfThreads,
+        [&](std::size_t begin, std::size_t end, std::size_t band) {
+          for(std::size_t ii = begin; ii < end; ++ii) {
+            voxelIndices[ii] = data.size();
+            lambdas[ii] = FLOAT_TYPE(0);
+
+            Vector3D<FLOAT_TYPE> rayOriginVoxel;
+            Vector3D<FLOAT_TYPE> rayDirectionVoxel;
+            this->transformRay(rayOrigins[ii], rayDirections[ii],
+                               rayOriginVoxel, rayDirectionVoxel);
+
+            // Follow the ray through the voxels between tStart and
+            // tStop, stopping at the first occupied one.
+            auto searchVoxels = [&](FLOAT_TYPE tStart, FLOAT_TYPE tStop) {
+              RayState state;
+              if(!this->initialize(rayOriginVoxel, rayDirectionVoxel,
+                                   tStart, FLOAT_TYPE(1), state)) {
+                return false;
+              }
+              do {
+                if(state.tEntry >= tStop) {
+                  return false;
+                }
+                std::size_t voxelIndex =
+                  ((state.position[2] * m_rows + state.position[1])
+                   * m_columns + state.position[0]);
+                if(dataPtr[voxelIndex] != Type()) {
+                  voxelIndices[ii] = voxelIndex;
+                  lambdas[ii] = state.tEntry;
+                  ++(numberOfHits[band]);
+                  return true;
+                }
+              } while(this->advance(state));
+              return false;
+            };
+
+            if(m_blockSize == 0) {
+              searchVoxels(tLower, std::numeric_limits<FLOAT_TYPE>::max());
+              continue;
+            }
+
+            // Follow the ray through the coarse grid, and only look
+            // at individual voxels inside occupied blocks.
+            RayState blockState;
+            if(!this->initialize(rayOriginVoxel, rayDirectionVoxel,
+                                 tLower, blockSize, blockState)) {
+              continue;
+            }
+            do {
+              if(m_occupancy(blockState.position[2], blockState.position[1],
+                             blockState.position[0])) {
+                FLOAT_TYPE tBlockExit = std::min(
+                  blockState.tMax[0],
+                  std::min(blockState.tMax[1], blockState.tMax[2]));
+                if(searchVoxels(blockState.tEntry, tBlockExit)) {
+                  break;
+                }
+              }
+            } while(this->advance(blockState));
+          }
+        });
+
+      std::size_t totalHits = 0;
+      for(std::size_t ii = 0; ii < numberOfHits.size(); ++ii) {
+        totalHits += numberOfHits[ii];
+      }
+      return totalHits;
+    }
+
+
+    template <class FLOAT_TYPE, class INT_TYPE>
+    template <class Type>
+    void
+    AmanatidesWoo3DBatch<FLOAT_TYPE, INT_TYPE>::
+    setOccupancy(Array3D<Type> const& data, std::size_t blockSize)
+    {
+      this->checkShape(data, "AmanatidesWoo3DBatch::setOccupancy()");
+      m_blockSize = blockSize;
+      if(blockSize == 0) {
+        return;
+      }
+
+      m_occupancy.reinit((m_slices + blockSize - 1) / blockSize,
+                         (m_rows + blockSize - 1) / blockSize,
+                         (m_columns + blockSize - 1) / blockSize);
+      m_occupancy = brick::common::UInt8(0);
+      for(std::size_t slice = 0; slice < m_slices; ++slice) {
+        for(std::size_t row = 0; row < m_rows; ++row) {
+          Type const* rowPtr = data.data(slice, row, 0);
+          brick::common::UInt8* occupancyPtr =
+            m_occupancy.data(slice / blockSize, row / blockSize, 0);
+          for(std::size_t column = 0; column < m_columns; ++column) {
+            if(rowPtr[column] != Type()) {
+              occupancyPtr[column / blockSize] = 1;
+            }
+          }
+        }
+      }
+    }
+
+
+    template <class FLOAT_TYPE, class INT_TYPE>
+    template <class Functor>
+    std::size_t
+    AmanatidesWoo3DBatch<FLOAT_TYPE, INT_TYPE>::
+    traverse(std::vector< Vector3D<FLOAT_TYPE> > const& rayOrigins,
+             std::vector< Vector3D<FLOAT_TYPE> > const& rayDirections,
+             Functor functor,
+             unsigned int numberOfThreads) const
+    {
+      this->checkSizes(rayOrigins, rayDirections,
+                       "AmanatidesWoo3DBatch::traverse()");
+      std::vector<std::size_t> numberOfVisits(
+        brick::common::getNumberOfBands(rayOrigins.size(), numberOfThreads),
+        0);
+      brick::common::parallelFor(
+        0, rayOrigins.size(), numberOfThreads,
+        [&](std::size_t begin, std::size_t end, std::size_t band) {
+          for(std::size_t ii = begin; ii < end; ++ii) {
+            auto callback = [&](std::size_t voxelIndex, std::size_t) {
+              return static_cast<bool>(functor(ii, voxelIndex));
+            };
+            numberOfVisits[band] += this->traverseRay(
+              rayOrigins[ii], rayDirections[ii], callback);
+          }
+        });
+
+      std::size_t totalVisits = 0;
+      for(std::size_t ii = 0; ii < numberOfVisits.size(); ++ii) {
+        totalVisits += numberOfVisits[ii];
+      }
+      return totalVisits;
+    }
+
+
+    // This member function follows the same stepping rules as
+    // AmanatidesWoo3DIterator::operator++(), so that exactly the same
+    // voxels are visited.
+    template <class FLOAT_TYPE, class INT_TYPE>
+    inline bool
+    AmanatidesWoo3DBatch<FLOAT_TYPE, INT_TYPE>::
+    advance(RayState& state) const
+    {
+      int axis;
+      if(state.tMax[0] < state.tMax[1]) {
+        axis = (state.tMax[2] < state.tMax[0]) ? 2 : 0;
+      } else {
+        axis = (state.tMax[2] < state.tMax[1]) ? 2 : 1;
+      }
+      state.tEntry = state.tMax[axis];
+      state.position[axis] += state.step[axis];
+      state.tMax[axis] += state.tDelta[axis];
+      return state.position[axis] != state.limit[axis];
+    }
+
+
+    template <class FLOAT_TYPE, class INT_TYPE>
+    template <class Type>
+    void
+    AmanatidesWoo3DBatch<FLOAT_TYPE, INT_TYPE>::
+    checkShape(Array3D<Type> const& data, char const* functionName) const
+    {
+      if(data.shape0() != m_slices
+         || data.shape1() != m_rows
+         || data.shape2() != m_columns) {
+        std::ostringstream message;
+        message << "Array shape (" << data.shape0() << ", " << data.shape1()
+                << ", " << data.shape2() << ") does not match the shape ("
+                << m_slices << ", " << m_rows << ", " << m_columns
+                << ") passed to the constructor.";
+        BRICK_THROW(brick::common::ValueException, functionName,
+                    message.str().c_str());
+      }
+    }
+
+
+    template <class FLOAT_TYPE, class INT_TYPE>
+    void
+    AmanatidesWoo3DBatch<FLOAT_TYPE, INT_TYPE>::
+    checkSizes(std::vector< Vector3D<FLOAT_TYPE> > const& rayOrigins,
+               std::vector< Vector3D<FLOAT_TYPE> > const& rayDirections,
+               char const* functionName) const
+    {
+      if(rayOrigins.size() != rayDirections.size()) {
+        BRICK_THROW(brick::common::ValueException, functionName,
+                    "Arguments rayOrigins and rayDirections must have "
+                    "the same size.");
+      }
+    }
+
+
+    // The arithmetic here deliberately mirrors that of the
+    // AmanatidesWoo3D constructor, so that results are bit-for-bit
+    // identical when cellSize is 1.
+    template <class FLOAT_TYPE, class INT_TYPE>
+    bool
+    AmanatidesWoo3DBatch<FLOAT_TYPE, INT_TYPE>::
+    initialize(Vector3D<FLOAT_TYPE> const& rayOriginVoxel,
+               Vector3D<FLOAT_TYPE> const& rayDirectionVoxel,
+               FLOAT_TYPE tLower, FLOAT_TYPE cellSize,
+               RayState& state) const
+    {
+      FLOAT_TYPE const origin[3] = {
+        rayOriginVoxel.x(), rayOriginVoxel.y(), rayOriginVoxel.z()};
+      FLOAT_TYPE const direction[3] = {
+        rayDirectionVoxel.x(), rayDirectionVoxel.y(), rayDirectionVoxel.z()};
+      std::size_t const extent[3] = {m_columns, m_rows, m_slices};
+
+      // A ray with no direction never leaves its starting voxel, so
+      // advance() would never terminate.  Treat it as a miss.
+      if(direction[0] == 0.0 && direction[1] == 0.0 && direction[2] == 0.0) {
+        return false;
+      }
+
+      // Find entry and exit points of the voxel array.
+      FLOAT_TYPE tEntry = -std::numeric_limits<FLOAT_TYPE>::max();
+      FLOAT_TYPE tExit = std::numeric_limits<FLOAT_TYPE>::max();
+      for(int axis = 0; axis < 3; ++axis) {
+        if(direction[axis] != 0.0) {
+          FLOAT_TYPE t0 = (0.0 - origin[axis]) / direction[axis];
+          FLOAT_TYPE t1 = (static_cast<FLOAT_TYPE>(extent[axis]) - origin[axis])
+            / direction[axis];
+          tEntry = std::max(tEntry, std::min(t0, t1));
+          tExit = std::min(tExit, std::max(t0, t1));
+        }
+      }
+      if(tEntry < tLower) {
+        tEntry = tLower;
+      }
+      if(tExit <= tEntry) {
+        return false;
+      }
+
+      state.tEntry = tEntry;
+      for(int axis = 0; axis < 3; ++axis) {
+        FLOAT_TYPE entryPoint = origin[axis] + tEntry * direction[axis];
+        if(entryPoint < 0.0) {
+          entryPoint = 0.0;
+        }
+
+        INT_TYPE numberOfCells = static_cast<INT_TYPE>(
+          (extent[axis] + static_cast<std::size_t>(cellSize) - 1)
+          / static_cast<std::size_t>(cellSize));
+        INT_TYPE position = static_cast<INT_TYPE>(entryPoint / cellSize);
+        if(position == numberOfCells) {
+          --position;
+        }
+        if(position >= numberOfCells) {
+          return false;
+        }
+        state.position[axis] = position;
+
+        if(direction[axis] > 0.0) {
+          state.step[axis] = 1;
+          state.tDelta[axis] = cellSize / direction[axis];
+          state.tMax[axis] = tEntry + (((position + 1) * cellSize - entryPoint)
+                                       / direction[axis]);
+        } else if(direction[axis] < 0.0) {
+          state.step[axis] = -1;
+          state.tDelta[axis] = -(cellSize / direction[axis]);
+          state.tMax[axis] = tEntry + ((position * cellSize - entryPoint)
+                                       / direction[axis]);
+        } else {
+          state.step[axis] = 0;
+          state.tDelta[axis] = std::numeric_limits<FLOAT_TYPE>::max();
+          state.tMax[axis] = std::numeric_limits<FLOAT_TYPE>::max();
+        }
+        state.limit[axis] = (state.step[axis] > 0) ? numberOfCells : -1;
+      }
+      return true;
+    }
+
+
+    template <class FLOAT_TYPE, class INT_TYPE>
+    template <class Callback>
+    std::size_t
+    AmanatidesWoo3DBatch<FLOAT_TYPE, INT_TYPE>::
+    traverseRay(Vector3D<FLOAT_TYPE> const& rayOrigin,
+                Vector3D<FLOAT_TYPE> const& rayDirection,
+                Callback& callback) const
+    {
+      Vector3D<FLOAT_TYPE> rayOriginVoxel;
+      Vector3D<FLOAT_TYPE> rayDirectionVoxel;
+      this->transformRay(rayOrigin, rayDirection,
+                         rayOriginVoxel, rayDirectionVoxel);
+
+      RayState state;
+      FLOAT_TYPE const tLower =
+        m_downstreamOnly ? FLOAT_TYPE(0) : -std::numeric_limits<FLOAT_TYPE>::max();
+      if(!this->initialize(rayOriginVoxel, rayDirectionVoxel, tLower,
+                           FLOAT_TYPE(1), state)) {
+        return 0;
+      }
+
+      std::size_t numberOfVisits = 0;
+      do {
+        std::size_t slice = static_cast<std::size_t>(state.position[2]);
+        std::size_t voxelIndex =
+          ((slice * m_rows + state.position[1]) * m_columns
+           + state.position[0]);
+        ++numberOfVisits;
+        if(!callback(voxelIndex, slice)) {
+          break;
+        }
+      } while(this->advance(state));
+      return numberOfVisits;
+    }
+
+
+    template <class FLOAT_TYPE, class INT_TYPE>
+    void
+    AmanatidesWoo3DBatch<FLOAT_TYPE, INT_TYPE>::
+    transformRay(Vector3D<FLOAT_TYPE> const& rayOrigin,
+                 Vector3D<FLOAT_TYPE> const& rayDirection,
+                 Vector3D<FLOAT_TYPE>& rayOriginVoxel,
+                 Vector3D<FLOAT_TYPE>& rayDirectionVoxel) const
+    {
+      rayOriginVoxel = m_voxelTworld * rayOrigin;
+      rayDirectionVoxel =
+        (m_voxelTworld * (rayOrigin + rayDirection)) - rayOriginVoxel;
+    }
+
+  } // namespace numeric
+
+} // namespace brick
+
+#endif /* #ifndef BRICK_NUMERIC_AMANATIDESWOO3DBATCH_IMPL_HH */
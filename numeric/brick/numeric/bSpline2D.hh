@@ -13,6 +13,7 @@
 #ifndef BRICK_NUMERIC_BSPLINE2D_HH
 #define BRICK_NUMERIC_BSPLINE2D_HH
 
+#include <cstddef>
 #include <vector>
 #include <brick/numeric/array1D.hh>
 #include <brick/numeric/array2D.hh>
@@ -333,8 +334,111 @@ namespace brick {
       operator()(FloatType sValue, FloatType tValue) const;
 
 
+      /**
+       * This member function evaluates the spline at many (s, t)
+       * points at once.  It gives the same results as calling
+       * operator()(FloatType, FloatType) for each point, except for
+       * floating point rounding, but computes the basis function
+       * weights for blocks of points in tight loops that the compiler
+       * can vectorize, and can spread the work across several
+       * threads.
+       *
+       * @param sBegin This iterator specifies the beginning of a
+       * sequence of S coordinates at which to evaluate the spline.
+       * It must be a random access iterator.
+       *
+       * @param sEnd This iterator specifies the end of the sequence
+       * of S coordinates.
+       *
+       * @param tBegin This iterator specifies the beginning of the
+       * sequence of T coordinates corresponding to the S coordinate
+       * sequence described above.
+       *
+       * @param outputBegin This random access iterator specifies
+       * where to write the results.  There must be room for (sEnd -
+       * sBegin) values.
+       *
+       * @param numberOfThreads This argument specifies how many
+       * threads to use.  Setting it to zero uses one thread per
+       * available processor.
+       */
+      template <class CoordIter, class OutIter>
+      void
+      evaluate(CoordIter sBegin, CoordIter sEnd, CoordIter tBegin,
+               OutIter outputBegin, unsigned int numberOfThreads = 1) const;
+
+
+      /**
+       * This member function evaluates the spline at every point of
+       * a rectangular grid in (s, t) space, such as the pixel grid of
+       * an image.  Element (row, column) of the result is equal to
+       * (*this)(sValues[column], tValues[row]), except for floating
+       * point rounding.  Because the spline is separable, the basis
+       * function weights are computed only once for each row and
+       * each column, and each output row is computed using one 4-tap
+       * pass across the rows of the control grid, followed by one
+       * 4-tap pass along the result.  This is much faster than
+       * calling operator()() for each grid point.
+       *
+       * @param sValues This argument specifies the S coordinate of
+       * each column of the grid.
+       *
+       * @param tValues This argument specifies the T coordinate of
+       * each row of the grid.
+       *
+       * @param numberOfThreads This argument specifies how many
+       * threads to use.  Setting it to zero uses one thread per
+       * available processor.
+       *
+       * @return The return value has tValues.size() rows and
+       * sValues.size() columns.
+       */
+      Array2D<Type>
+      evaluateGrid(Array1D<FloatType> const& sValues,
+                   Array1D<FloatType> const& tValues,
+                   unsigned int numberOfThreads = 1) const;
+
+
     protected:
 
+      /**
+       * This protected member function computes the four cubic basis
+       * function values for a fractional offset within a control grid
+       * cell.
+       *
+       * @param fraction This argument is the fractional part of the
+       * (scaled) spline parameter, as computed by
+       * decomposeSamplePoint().
+       *
+       * @param weights This argument must point to a four-element
+       * array, into which the basis function values will be written.
+       */
+      inline void
+      computeBasisWeights(FloatType fraction, FloatType* weights) const;
+
+
+      /**
+       * This protected member function converts a spline parameter
+       * into the index of the control grid cell into which it falls,
+       * and the four basis function weights for that cell, checking
+       * that the parameter is within the range supported by the
+       * control grid.
+       *
+       * @param value This argument is the S or T value to be
+       * converted.
+       *
+       * @param axis This argument is 0 for S, or 1 for T.
+       *
+       * @param index This argument returns the cell index.
+       *
+       * @param weights This argument must point to a four-element
+       * array, into which the basis function values will be written.
+       */
+      void
+      decomposeCoordinate(FloatType value, size_t axis, size_t& index,
+                          FloatType* weights) const;
+
+
       /**
        * This protected member function returns the integer part of
        * sValue and tValue, while -- as a side effect -- setting
@@ -20,6 +20,7 @@
 
 #include <cmath>
 #include <algorithm>
+#include <brick/common/parallelFor.hh>
 #include <brick/numeric/functional.hh>
 #include <brick/numeric/utilities.hh>
 
@@ -571,27 +572,25 @@ namespace brick {
                                  powersOfS, powersOfT);
 
       // Interpolate by adding spline basis functions from the
-      // surrounding control points.
+      // surrounding control points.  The basis function values
+      // depend only on s (or only on t), so compute them just once.
+      FloatType sWeights[4];
+      FloatType tWeights[4];
+      this->computeBasisWeights(powersOfS[1], sWeights);
+      this->computeBasisWeights(powersOfT[1], tWeights);
+
       int index0 = iIndex - 1;
       int index1 = jIndex - 1;
       FloatType functionValue = 0.0;
       for(size_t kIndex = 0; kIndex < 4; ++kIndex) {
 
         size_t i0PlusK = index0 + kIndex;
-
-        //  FloatType B_k = dot<FloatType>((this->m_basisArray)[kIndex], powersOfS);
-        FloatType B_k = std::inner_product(
-          powersOfS, powersOfS + 4, (this->m_basisArray)[kIndex].data(),
-          static_cast<FloatType>(0));
+        FloatType B_k = sWeights[kIndex];
 
         for(size_t lIndex = 0; lIndex < 4; ++lIndex) {
 
           size_t i1PlusL = index1 + lIndex;
-
-          // FloatType B_l = dot<FloatType>((this->m_basisArray)[lIndex], powersOfT);
-          FloatType B_l = std::inner_product(
-            powersOfT, powersOfT + 4, (this->m_basisArray)[lIndex].data(),
-            static_cast<FloatType>(0));
+          FloatType B_l = tWeights[lIndex];
 
           // Indexing into control grid is (row, column), not (k, l).
           functionValue += (B_k * B_l * m_controlGrid(i1PlusL, i0PlusK));
@@ -601,6 +600,209 @@ namespace brick {
     }
 
 
+    // This member function evaluates the spline at many (s, t)
+    // points at once.
+    template <class Type, class FloatType>
+    template <class CoordIter, class OutIter>
+    void
+    BSpline2D<Type, FloatType>::
+    evaluate(CoordIter sBegin, CoordIter sEnd, CoordIter tBegin,
+             OutIter outputBegin, unsigned int numberOfThreads) const
+    {
+      // Points are processed in small blocks.  For each block, the
+      // first set of loops computes cell indices and basis weights
+      // for all points, and has no branches or indirection, so it
+      // vectorizes well.  The second gathers control points and
+      // accumulates.
+      static const size_t BlockSize = 16;
+      size_t const numberOfPoints = static_cast<size_t>(sEnd - sBegin);
+      size_t const numberOfBlocks = (numberOfPoints + BlockSize - 1) / BlockSize;
+      int const columns = static_cast<int>(m_controlGrid.columns());
+      int const rows = static_cast<int>(m_controlGrid.rows());
+
+      brick::common::parallelFor(
+        0, numberOfBlocks, numberOfThreads,
+        [&](size_t blockBegin, size_t blockEnd, size_t) {
+          FloatType iTmp[BlockSize];
+          FloatType jTmp[BlockSize];
+          int iCoord[BlockSize];
+          int jCoord[BlockSize];
+          FloatType sWeights[4][BlockSize];
+          FloatType tWeights[4][BlockSize];
+
+          for(size_t block = blockBegin; block < blockEnd; ++block) {
+            size_t const first = block * BlockSize;
+            size_t const count = std::min(BlockSize, numberOfPoints - first);
+
+            for(size_t ii = 0; ii < count; ++ii) {
+              iTmp[ii] = ((*(sBegin + (first + ii)) - m_xyCellOrigin.x())
+                          / m_xyCellSize.x());
+              jTmp[ii] = ((*(tBegin + (first + ii)) - m_xyCellOrigin.y())
+                          / m_xyCellSize.y());
+            }
+            for(size_t ii = 0; ii < count; ++ii) {
+              iCoord[ii] = static_cast<int>(roundToFloor(iTmp[ii]));
+              jCoord[ii] = static_cast<int>(roundToFloor(jTmp[ii]));
+            }
+            for(size_t ii = 0; ii < count; ++ii) {
+              if(iCoord[ii] < 1 || iCoord[ii] + 3 > columns
+                 || jCoord[ii] < 1 || jCoord[ii] + 3 > rows) {
+                BRICK_THROW(brick::common::ValueException,
+                            "BSpline2D::evaluate()",
+                            "Sample point is outside the range supported "
+                            "by the control grid.");
+              }
+            }
+            for(size_t kk = 0; kk < 4; ++kk) {
+              FloatType const* coefficients = m_basisArray[kk].data();
+              for(size_t ii = 0; ii < count; ++ii) {
+                FloatType sFraction = iTmp[ii] - FloatType(iCoord[ii]);
+                FloatType tFraction = jTmp[ii] - FloatType(jCoord[ii]);
+                FloatType sSquared = sFraction * sFraction;
+                FloatType tSquared = tFraction * tFraction;
+                sWeights[kk][ii] = (coefficients[0] + sFraction * coefficients[1]
+                                    + sSquared * coefficients[2]
+                                    + sSquared * sFraction * coefficients[3]);
+                tWeights[kk][ii] = (coefficients[0] + tFraction * coefficients[1]
+                                    + tSquared * coefficients[2]
+                                    + tSquared * tFraction * coefficients[3]);
+              }
+            }
+
+            for(size_t ii = 0; ii < count; ++ii) {
+              Type functionValue = static_cast<Type>(0.0);
+              for(size_t lIndex = 0; lIndex < 4; ++lIndex) {
+                Type const* gridRow = m_controlGrid.data(
+                  jCoord[ii] - 1 + lIndex, iCoord[ii] - 1);
+                Type rowValue = sWeights[0][ii] * gridRow[0];
+                rowValue += sWeights[1][ii] * gridRow[1];
+                rowValue += sWeights[2][ii] * gridRow[2];
+                rowValue += sWeights[3][ii] * gridRow[3];
+                functionValue += tWeights[lIndex][ii] * rowValue;
+              }
+              *(outputBegin + (first + ii)) = functionValue;
+            }
+          }
+        });
+    }
+
+
+    // This member function evaluates the spline at every point of a
+    // rectangular grid in (s, t) space.
+    template <class Type, class FloatType>
+    Array2D<Type>
+    BSpline2D<Type, FloatType>::
+    evaluateGrid(Array1D<FloatType> const& sValues,
+                 Array1D<FloatType> const& tValues,
+                 unsigned int numberOfThreads) const
+    {
+      // Precompute cell indices and weights for every column and
+      // every row of the output.
+      Array1D<size_t> iIndices(sValues.size());
+      Array2D<FloatType> sWeights(sValues.size(), 4);
+      size_t iMinimum = m_controlGrid.columns();
+      size_t iMaximum = 0;
+      for(size_t column = 0; column < sValues.size(); ++column) {
+        this->decomposeCoordinate(sValues[column], 0, iIndices[column],
+                                  sWeights.data(column, 0));
+        iMinimum = std::min(iMinimum, iIndices[column]);
+        iMaximum = std::max(iMaximum, iIndices[column]);
+      }
+      Array1D<size_t> jIndices(tValues.size());
+      Array2D<FloatType> tWeights(tValues.size(), 4);
+      for(size_t row = 0; row < tValues.size(); ++row) {
+        this->decomposeCoordinate(tValues[row], 1, jIndices[row],
+                                  tWeights.data(row, 0));
+      }
+
+      Array2D<Type> result(tValues.size(), sValues.size());
+      if(result.size() == 0) {
+        return result;
+      }
+
+      // Only control grid columns in this range affect the result.
+      size_t const firstColumn = iMinimum - 1;
+      size_t const numberOfColumns = iMaximum + 3 - firstColumn;
+
+      brick::common::parallelFor(
+        0, tValues.size(), numberOfThreads,
+        [&](size_t rowBegin, size_t rowEnd, size_t) {
+          Array1D<Type> rowBuffer(numberOfColumns);
+          for(size_t row = rowBegin; row < rowEnd; ++row) {
+            // First pass: blend four rows of the control grid, giving
+            // a 1D spline in s.  The inner loops run along contiguous
+            // rows, and vectorize well.
+            FloatType const* weights = tWeights.data(row, 0);
+            Type const* gridRow0 =
+              m_controlGrid.data(jIndices[row] - 1, firstColumn);
+            Type const* gridRow1 = gridRow0 + m_controlGrid.columns();
+            Type const* gridRow2 = gridRow1 + m_controlGrid.columns();
+            Type const* gridRow3 = gridRow2 + m_controlGrid.columns();
+            Type* bufferPtr = rowBuffer.data();
+            for(size_t column = 0; column < numberOfColumns; ++column) {
+              Type value = weights[0] * gridRow0[column];
+              value += weights[1] * gridRow1[column];
+              value += weights[2] * gridRow2[column];
+              value += weights[3] * gridRow3[column];
+              bufferPtr[column] = value;
+            }
+
+            // Second pass: evaluate the 1D spline at each column.
+            Type* outputPtr = result.data(row, 0);
+            for(size_t column = 0; column < sValues.size(); ++column) {
+              FloatType const* columnWeights = sWeights.data(column, 0);
+              Type const* taps = bufferPtr + (iIndices[column] - 1 - firstColumn);
+              Type value = columnWeights[0] * taps[0];
+              value += columnWeights[1] * taps[1];
+              value += columnWeights[2] * taps[2];
+              value += columnWeights[3] * taps[3];
+              outputPtr[column] = value;
+            }
+          }
+        });
+      return result;
+    }
+
+
+    template <class Type, class FloatType>
+    inline void
+    BSpline2D<Type, FloatType>::
+    computeBasisWeights(FloatType fraction, FloatType* weights) const
+    {
+      FloatType const fractionSquared = fraction * fraction;
+      FloatType const fractionCubed = fractionSquared * fraction;
+      for(size_t kIndex = 0; kIndex < 4; ++kIndex) {
+        FloatType const* coefficients = m_basisArray[kIndex].data();
+        weights[kIndex] = (coefficients[0] + fraction * coefficients[1]
+                           + fractionSquared * coefficients[2]
+                           + fractionCubed * coefficients[3]);
+      }
+    }
+
+
+    template <class Type, class FloatType>
+    void
+    BSpline2D<Type, FloatType>::
+    decomposeCoordinate(FloatType value, size_t axis, size_t& index,
+                        FloatType* weights) const
+    {
+      FloatType scaledValue =
+        (axis == 0) ? ((value - m_xyCellOrigin.x()) / m_xyCellSize.x())
+        : ((value - m_xyCellOrigin.y()) / m_xyCellSize.y());
+      int coordinate = static_cast<int>(roundToFloor(scaledValue));
+      int limit = static_cast<int>(
+        (axis == 0) ? m_controlGrid.columns() : m_controlGrid.rows());
+      if(coordinate < 1 || coordinate + 3 > limit) {
+        BRICK_THROW(brick::common::ValueException,
+                    "BSpline2D::decomposeCoordinate()",
+                    "Sample point is outside the range supported "
+                    "by the control grid.");
+      }
+      index = static_cast<size_t>(coordinate);
+      this->computeBasisWeights(scaledValue - FloatType(coordinate), weights);
+    }
+
+
     template <class Type, class FloatType>
     void
     BSpline2D<Type, FloatType>::
@@ -162,7 +162,7 @@ namespace brick {
        * region.
        */
       Type1
-      getIntegral(const Index2D& corner0, const Index2D& corner1);
+      getIntegral(const Index2D& corner0, const Index2D& corner1) const;
 
 
       /**
@@ -195,7 +195,8 @@ namespace brick {
        * region.
        */
       Type1
-      getIntegral(const Index2D& corner0, const Index2D& corner1, bool dummy);
+      getIntegral(const Index2D& corner0, const Index2D& corner1,
+                  bool dummy) const;
 
 
       /**
@@ -216,7 +217,7 @@ namespace brick {
        * at the specified location.
        */
       Type1
-      getRawIntegral(size_t row, size_t column);
+      getRawIntegral(size_t row, size_t column) const;
 
 
       /**
@@ -230,7 +231,7 @@ namespace brick {
        * at the specified location.
        */
       Type1
-      getRawIntegral(size_t index0);
+      getRawIntegral(size_t index0) const;
 
 
       /**
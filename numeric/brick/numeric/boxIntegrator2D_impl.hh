@@ -101,7 +101,7 @@ namespace brick {
     template <class Type0, class Type1>
     Type1
     BoxIntegrator2D<Type0, Type1>::
-    getIntegral(const Index2D& corner0, const Index2D& corner1)
+    getIntegral(const Index2D& corner0, const Index2D& corner1) const
     {
       return (m_cache(corner1.getRow(), corner1.getColumn())
               - m_cache(corner1.getRow(), corner0.getColumn())
@@ -118,7 +118,7 @@ namespace brick {
     Type1
     BoxIntegrator2D<Type0, Type1>::
     getIntegral(const Index2D& corner0, const Index2D& corner1,
-                bool /* dummy */)
+                bool /* dummy */) const
     {
       int row0 = corner0.getRow() - m_corner0.getRow();
       int row1 = corner1.getRow() - m_corner0.getRow();
@@ -136,7 +136,7 @@ namespace brick {
     template <class Type0, class Type1>
     Type1
     BoxIntegrator2D<Type0, Type1>::
-    getRawIntegral(size_t row, size_t column)
+    getRawIntegral(size_t row, size_t column) const
     {
       return m_cache(row, column);
     }
@@ -147,7 +147,7 @@ namespace brick {
     template <class Type0, class Type1>
     Type1
     BoxIntegrator2D<Type0, Type1>::
-    getRawIntegral(size_t index0)
+    getRawIntegral(size_t index0) const
     {
       return m_cache(index0);
     }
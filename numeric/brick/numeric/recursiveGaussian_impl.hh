@@ -0,0 +1,536 @@
+/**
+***************************************************************************
+* @file brick/numeric/recursiveGaussian_impl.hh
+*
+* Header file defining inline and template functions declared in
+* recursiveGaussian.hh.
+*
+* Copyright (C) 2026 David LaRose, dlr@cs.cmu.edu
+* See accompanying file, LICENSE.TXT, for details.
+*
+***************************************************************************
+*/
+
+#ifndef BRICK_NUMERIC_RECURSIVEGAUSSIAN_IMPL_HH
+#define BRICK_NUMERIC_RECURSIVEGAUSSIAN_IMPL_HH
+
+// This file is included by recursiveGaussian.hh, and should not be
+// directly included by user code, so no need to include
+// recursiveGaussian.hh here.
+//
+// #include <brick/numeric/recursiveGaussian.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <brick/common/exception.hh>
+#include <brick/common/parallelFor.hh>
+
+namespace brick {
+
+  namespace numeric {
+
+    /// @cond privateCode
+    namespace privateCode {
+
+      // Deriche's fit of each kernel, for sigma = 1, as
+      //
+      //   h(x) = (a0 * cos(w0 * x) + a1 * sin(w0 * x)) * exp(-b0 * x)
+      //          + (c0 * cos(w1 * x) + c1 * sin(w1 * x)) * exp(-b1 * x),
+      //
+      // for x >= 0.  Values are stored in the order a0, a1, b0, w0,
+      // c0, c1, b1, w1.
+      inline double const*
+      getDericheCoefficients(unsigned int derivativeOrder)
+      {
+        static double const coefficients[3][8] = {
+          {1.68, 3.735, 1.783, 0.6318, -0.6803, -0.2598, 1.723, 1.997},
+          {-0.6472, -4.531, 1.527, 0.6719, 0.6494, 0.9557, 1.516, 2.072},
+          {-1.331, 3.661, 1.24, 0.748, 0.3225, -1.738, 1.314, 2.166}
+        };
+        return coefficients[derivativeOrder];
+      }
+
+
+      // Maps an index that may fall outside of [0, length) back into
+      // the signal, mirroring or wrapping as required.
+      inline size_t
+      recursiveGaussianExtendIndex(long index, size_t length,
+                                   ConvolutionStrategy strategy)
+      {
+        long const size = static_cast<long>(length);
+        if(strategy == BRICK_CONVOLVE_WRAP_SIGNAL) {
+          return static_cast<size_t>(((index % size) + size) % size);
+        }
+        long const period = 2 * size;
+        long position = ((index % period) + period) % period;
+        if(position >= size) {
+          position = period - 1 - position;
+        }
+        return static_cast<size_t>(position);
+      }
+
+
+      inline void
+      checkRecursiveGaussianStrategy(ConvolutionStrategy strategy,
+                                     char const* functionName)
+      {
+        if(strategy != BRICK_CONVOLVE_ZERO_PAD_SIGNAL
+           && strategy != BRICK_CONVOLVE_PAD_SIGNAL
+           && strategy != BRICK_CONVOLVE_REFLECT_SIGNAL
+           && strategy != BRICK_CONVOLVE_WRAP_SIGNAL) {
+          BRICK_THROW(brick::common::NotImplementedException, functionName,
+                      "Only BRICK_CONVOLVE_ZERO_PAD_SIGNAL, "
+                      "BRICK_CONVOLVE_PAD_SIGNAL, "
+                      "BRICK_CONVOLVE_REFLECT_SIGNAL, and "
+                      "BRICK_CONVOLVE_WRAP_SIGNAL are supported.");
+        }
+      }
+
+
+      // Multiplies polynomial (in u) "poly", which has "degree + 1"
+      // coefficients, by (1 - root * u).
+      inline void
+      recursiveGaussianMultiplyFactor(std::complex<double>* poly,
+                                      size_t degree,
+                                      std::complex<double> const& root)
+      {
+        poly[degree + 1] = std::complex<double>(0.0, 0.0);
+        for(size_t ii = degree + 1; ii > 0; --ii) {
+          poly[ii] -= root * poly[ii - 1];
+        }
+      }
+
+    } // namespace privateCode
+    /// @endcond
+
+
+    // The constructor computes the recursion coefficients.
+    template <class FloatType>
+    RecursiveGaussian<FloatType>::
+    RecursiveGaussian(double sigma, unsigned int derivativeOrder)
+      : m_sigma(sigma),
+        m_derivativeOrder(derivativeOrder),
+        m_causalGain(0),
+        m_anticausalGain(0),
+        m_margin(0)
+    {
+      typedef std::complex<double> Complex;
+      if(!(sigma >= 0.5)) {
+        BRICK_THROW(brick::common::ValueException,
+                    "RecursiveGaussian::RecursiveGaussian()",
+                    "Argument sigma must be at least 0.5.");
+      }
+      if(derivativeOrder > 2) {
+        BRICK_THROW(brick::common::ValueException,
+                    "RecursiveGaussian::RecursiveGaussian()",
+                    "Argument derivativeOrder must be 0, 1, or 2.");
+      }
+
+      // Write the sampled kernel, h(n) for n >= 0, as a sum of four
+      // complex exponentials, alpha[k] * pole[k]^n.
+      double const* fit = privateCode::getDericheCoefficients(derivativeOrder);
+      Complex alpha[4];
+      Complex pole[4];
+      alpha[0] = 0.5 * Complex(fit[0], -fit[1]);
+      pole[0] = std::exp(Complex(-fit[2], fit[3]) / sigma);
+      alpha[2] = 0.5 * Complex(fit[4], -fit[5]);
+      pole[2] = std::exp(Complex(-fit[6], fit[7]) / sigma);
+      alpha[1] = std::conj(alpha[0]);
+      pole[1] = std::conj(pole[0]);
+      alpha[3] = std::conj(alpha[2]);
+      pole[3] = std::conj(pole[2]);
+
+      // The z-transform of the causal part is sum(alpha[k] / (1 -
+      // pole[k] * u)), where u is the unit delay, and the anticausal
+      // part, which covers n >= 1 only, is sign * sum(alpha[k] *
+      // pole[k] * u / (1 - pole[k] * u)), where u is the unit
+      // advance.  Put both over the common denominator.
+      double const sign = (derivativeOrder == 1) ? -1.0 : 1.0;
+      Complex denominator[5] = {Complex(1.0, 0.0)};
+      Complex causal[5] = {};
+      Complex anticausal[5] = {};
+      for(size_t kk = 0; kk < 4; ++kk) {
+        privateCode::recursiveGaussianMultiplyFactor(
+          denominator, kk, pole[kk]);
+
+        Complex term[5] = {Complex(1.0, 0.0)};
+        size_t degree = 0;
+        for(size_t jj = 0; jj < 4; ++jj) {
+          if(jj != kk) {
+            privateCode::recursiveGaussianMultiplyFactor(
+              term, degree, pole[jj]);
+            ++degree;
+          }
+        }
+        for(size_t ii = 0; ii < 4; ++ii) {
+          causal[ii] += alpha[kk] * term[ii];
+          anticausal[ii + 1] += sign * alpha[kk] * pole[kk] * term[ii];
+        }
+      }
+
+      // Moments of the sampled kernel, computed in closed form from
+      // the geometric series: h0 = h(0), gain = sum(h(n)), moment1 =
+      // sum(n * h(n)), and moment2 = sum(n^2 * h(n)), all over n >= 0.
+      double h0 = 0.0;
+      double gain = 0.0;
+      double moment1 = 0.0;
+      double moment2 = 0.0;
+      for(size_t kk = 0; kk < 4; ++kk) {
+        Complex oneMinusPole = 1.0 - pole[kk];
+        h0 += alpha[kk].real();
+        gain += (alpha[kk] / oneMinusPole).real();
+        moment1 += (alpha[kk] * pole[kk]
+                    / (oneMinusPole * oneMinusPole)).real();
+        moment2 += (alpha[kk] * pole[kk] * (1.0 + pole[kk])
+                    / (oneMinusPole * oneMinusPole * oneMinusPole)).real();
+      }
+
+      // Normalize.  For the derivatives, first adjust the center tap
+      // so that the odd kernel is exactly zero at the origin, or the
+      // even one has exactly zero DC gain.  Adding a constant to the
+      // causal transfer function means adding a multiple of the
+      // denominator to its numerator, which raises its degree to
+      // four.
+      double correction = 0.0;
+      double scale = 1.0;
+      switch(derivativeOrder) {
+      case 0:
+        scale = 1.0 / (2.0 * gain - h0);
+        break;
+      case 1:
+        correction = -h0;
+        scale = -1.0 / (2.0 * moment1);
+        break;
+      default:
+        correction = -(2.0 * gain - h0);
+        scale = 1.0 / moment2;
+        break;
+      }
+
+      double causalSum = 0.0;
+      double anticausalSum = 0.0;
+      double denominatorSum = 1.0;
+      for(size_t ii = 0; ii < 5; ++ii) {
+        double causalValue =
+          (causal[ii].real() + correction * denominator[ii].real()) * scale;
+        m_causal[ii] = static_cast<FloatType>(causalValue);
+        causalSum += causalValue;
+      }
+      for(size_t ii = 0; ii < 4; ++ii) {
+        double anticausalValue = anticausal[ii + 1].real() * scale;
+        double denominatorValue = denominator[ii + 1].real();
+        m_anticausal[ii] = static_cast<FloatType>(anticausalValue);
+        m_denominator[ii] = static_cast<FloatType>(denominatorValue);
+        anticausalSum += anticausalValue;
+        denominatorSum += denominatorValue;
+      }
+      m_causalGain = static_cast<FloatType>(causalSum / denominatorSum);
+      m_anticausalGain = static_cast<FloatType>(anticausalSum / denominatorSum);
+
+      // Start far enough out that the slowest-decaying pole has died
+      // down by a factor of 10^5 before we reach the signal.
+      double slowestDecay = std::min(fit[2], fit[6]);
+      m_margin = static_cast<size_t>(
+        std::ceil(sigma * std::log(1.0E5) / slowestDecay));
+    }
+
+
+    // This member function filters a 1D signal.
+    template <class FloatType>
+    template <class OutputType, class InputType>
+    void
+    RecursiveGaussian<FloatType>::
+    filter(Array1D<OutputType>& outputSignal,
+           Array1D<InputType> const& inputSignal,
+           ConvolutionStrategy strategy,
+           FloatType fillValue) const
+    {
+      privateCode::checkRecursiveGaussianStrategy(
+        strategy, "RecursiveGaussian::filter()");
+      size_t const length = inputSignal.size();
+      if(outputSignal.size() != length) {
+        outputSignal.reinit(length);
+      }
+      if(length == 0) {
+        return;
+      }
+      std::vector<FloatType> workspace(9 + length);
+      FloatType* resultPtr = &(workspace[9]);
+      this->filterLanes(inputSignal.data(), 1, resultPtr, length, 1,
+                        strategy, fillValue, &(workspace[0]));
+      for(size_t ii = 0; ii < length; ++ii) {
+        outputSignal[ii] = static_cast<OutputType>(resultPtr[ii]);
+      }
+    }
+
+
+    // This member function filters each column of a 2D array.
+    template <class FloatType>
+    template <class OutputType, class InputType>
+    void
+    RecursiveGaussian<FloatType>::
+    filterColumns(Array2D<OutputType>& outputArray,
+                  Array2D<InputType> const& inputArray,
+                  ConvolutionStrategy strategy,
+                  FloatType fillValue,
+                  unsigned int numberOfThreads) const
+    {
+      privateCode::checkRecursiveGaussianStrategy(
+        strategy, "RecursiveGaussian::filterColumns()");
+      size_t const rows = inputArray.rows();
+      size_t const columns = inputArray.columns();
+      if(outputArray.rows() != rows || outputArray.columns() != columns) {
+        outputArray.reinit(rows, columns);
+      }
+      if(rows == 0 || columns == 0) {
+        return;
+      }
+
+      // Each column is an independent signal, so we run the
+      // recursion down a strip of adjacent columns at once.  The
+      // strip is narrow enough that the recursion state stays in
+      // cache.
+      size_t const stripWidth = 64;
+      size_t const numberOfStrips = (columns + stripWidth - 1) / stripWidth;
+      brick::common::parallelFor(
+        0, numberOfStrips, numberOfThreads,
+        [&](size_t stripBegin, size_t stripEnd, size_t) {
+          std::vector<FloatType> workspace((9 + rows) * stripWidth);
+          FloatType* resultPtr = &(workspace[9 * stripWidth]);
+          for(size_t strip = stripBegin; strip < stripEnd; ++strip) {
+            size_t const column0 = strip * stripWidth;
+            size_t const lanes = std::min(stripWidth, columns - column0);
+            this->filterLanes(inputArray.data(0, column0), columns,
+                              resultPtr, rows, lanes, strategy, fillValue,
+                              &(workspace[0]));
+            for(size_t row = 0; row < rows; ++row) {
+              FloatType const* sourcePtr = resultPtr + row * lanes;
+              OutputType* destinationPtr = outputArray.data(row, column0);
+              for(size_t lane = 0; lane < lanes; ++lane) {
+                destinationPtr[lane] =
+                  static_cast<OutputType>(sourcePtr[lane]);
+              }
+            }
+          }
+        });
+    }
+
+
+    // This member function filters each row of a 2D array.
+    template <class FloatType>
+    template <class OutputType, class InputType>
+    void
+    RecursiveGaussian<FloatType>::
+    filterRows(Array2D<OutputType>& outputArray,
+               Array2D<InputType> const& inputArray,
+               ConvolutionStrategy strategy,
+               FloatType fillValue,
+               unsigned int numberOfThreads) const
+    {
+      privateCode::checkRecursiveGaussianStrategy(
+        strategy, "RecursiveGaussian::filterRows()");
+      size_t const rows = inputArray.rows();
+      size_t const columns = inputArray.columns();
+      if(outputArray.rows() != rows || outputArray.columns() != columns) {
+        outputArray.reinit(rows, columns);
+      }
+      if(rows == 0 || columns == 0) {
+        return;
+      }
+
+      // The recursion along a row is inherently sequential, so we
+      // transpose a block of rows into a buffer, run the recursion
+      // across all of them at once, and transpose the result back.
+      size_t const blockHeight = 16;
+      size_t const numberOfBlocks = (rows + blockHeight - 1) / blockHeight;
+      brick::common::parallelFor(
+        0, numberOfBlocks, numberOfThreads,
+        [&](size_t blockBegin, size_t blockEnd, size_t) {
+          std::vector<FloatType> workspace(
+            (9 + 2 * columns) * blockHeight);
+          FloatType* sourcePtr = &(workspace[9 * blockHeight]);
+          FloatType* resultPtr = sourcePtr + columns * blockHeight;
+          for(size_t block = blockBegin; block < blockEnd; ++block) {
+            size_t const row0 = block * blockHeight;
+            size_t const lanes = std::min(blockHeight, rows - row0);
+            for(size_t lane = 0; lane < lanes; ++lane) {
+              InputType const* inputPtr = inputArray.data(row0 + lane, 0);
+              for(size_t column = 0; column < columns; ++column) {
+                sourcePtr[column * lanes + lane] =
+                  static_cast<FloatType>(inputPtr[column]);
+              }
+            }
+            this->filterLanes(sourcePtr, lanes, resultPtr, columns, lanes,
+                              strategy, fillValue, &(workspace[0]));
+            for(size_t lane = 0; lane < lanes; ++lane) {
+              OutputType* outputPtr = outputArray.data(row0 + lane, 0);
+              for(size_t column = 0; column < columns; ++column) {
+                outputPtr[column] =
+                  static_cast<OutputType>(resultPtr[column * lanes + lane]);
+              }
+            }
+          }
+        });
+    }
+
+
+    // Runs the filter over "lanes" independent signals of "length"
+    // samples each.  Sample n of signal l is read from inputPtr[n *
+    // inputStride + l], and written to outputPtr[n * lanes + l].
+    // Argument workspacePtr must point to 9 * lanes elements of
+    // scratch space.
+    template <class FloatType>
+    template <class InputType>
+    void
+    RecursiveGaussian<FloatType>::
+    filterLanes(InputType const* inputPtr, size_t inputStride,
+                FloatType* outputPtr, size_t length, size_t lanes,
+                ConvolutionStrategy strategy, FloatType fillValue,
+                FloatType* workspacePtr) const
+    {
+      FloatType* x1 = workspacePtr;
+      FloatType* x2 = x1 + lanes;
+      FloatType* x3 = x2 + lanes;
+      FloatType* x4 = x3 + lanes;
+      FloatType* y1 = x4 + lanes;
+      FloatType* y2 = y1 + lanes;
+      FloatType* y3 = y2 + lanes;
+      FloatType* y4 = y3 + lanes;
+      FloatType* discardPtr = y4 + lanes;
+
+      FloatType const n0 = m_causal[0];
+      FloatType const n1 = m_causal[1];
+      FloatType const n2 = m_causal[2];
+      FloatType const n3 = m_causal[3];
+      FloatType const n4 = m_causal[4];
+      FloatType const m1 = m_anticausal[0];
+      FloatType const m2 = m_anticausal[1];
+      FloatType const m3 = m_anticausal[2];
+      FloatType const m4 = m_anticausal[3];
+      FloatType const d1 = m_denominator[0];
+      FloatType const d2 = m_denominator[1];
+      FloatType const d3 = m_denominator[2];
+      FloatType const d4 = m_denominator[3];
+
+      // Padded boundaries are exact if we start the recursion in the
+      // steady state for the pad value.  Reflected and wrapped
+      // boundaries need a run-up over the extended signal, starting
+      // from the steady state for its first sample.
+      bool const isExtended = (strategy == BRICK_CONVOLVE_REFLECT_SIGNAL
+                               || strategy == BRICK_CONVOLVE_WRAP_SIGNAL);
+      long const margin = isExtended ? static_cast<long>(m_margin) : 0;
+      long const size = static_cast<long>(length);
+      FloatType const padValue =
+        (strategy == BRICK_CONVOLVE_PAD_SIGNAL) ? fillValue : FloatType(0);
+
+      // Causal pass, left to right.
+      InputType const* initialPtr = inputPtr + inputStride
+        * privateCode::recursiveGaussianExtendIndex(
+          -margin - 1, length, strategy);
+      for(size_t lane = 0; lane < lanes; ++lane) {
+        FloatType value = isExtended
+          ? static_cast<FloatType>(initialPtr[lane]) : padValue;
+        x1[lane] = x2[lane] = x3[lane] = x4[lane] = value;
+        y1[lane] = y2[lane] = y3[lane] = y4[lane] = value * m_causalGain;
+      }
+      for(long position = -margin; position < size; ++position) {
+        InputType const* rowPtr = inputPtr + inputStride
+          * ((position < 0)
+             ? privateCode::recursiveGaussianExtendIndex(
+               position, length, strategy)
+             : static_cast<size_t>(position));
+        FloatType* resultPtr = (position < 0) ? discardPtr
+          : outputPtr + static_cast<size_t>(position) * lanes;
+        for(size_t lane = 0; lane < lanes; ++lane) {
+          FloatType const x0 = static_cast<FloatType>(rowPtr[lane]);
+          FloatType const y0 =
+            n0 * x0 + n1 * x1[lane] + n2 * x2[lane] + n3 * x3[lane]
+            + n4 * x4[lane]
+            - d1 * y1[lane] - d2 * y2[lane] - d3 * y3[lane] - d4 * y4[lane];
+          x4[lane] = x3[lane];
+          x3[lane] = x2[lane];
+          x2[lane] = x1[lane];
+          x1[lane] = x0;
+          y4[lane] = y3[lane];
+          y3[lane] = y2[lane];
+          y2[lane] = y1[lane];
+          y1[lane] = y0;
+          resultPtr[lane] = y0;
+        }
+      }
+
+      // Anticausal pass, right to left, adding to the causal result.
+      initialPtr = inputPtr + inputStride
+        * privateCode::recursiveGaussianExtendIndex(
+          size + margin, length, strategy);
+      for(size_t lane = 0; lane < lanes; ++lane) {
+        FloatType value = isExtended
+          ? static_cast<FloatType>(initialPtr[lane]) : padValue;
+        x1[lane] = x2[lane] = x3[lane] = x4[lane] = value;
+        y1[lane] = y2[lane] = y3[lane] = y4[lane] = value * m_anticausalGain;
+      }
+      for(long position = size + margin - 1; position >= 0; --position) {
+        InputType const* rowPtr = inputPtr + inputStride
+          * ((position >= size)
+             ? privateCode::recursiveGaussianExtendIndex(
+               position, length, strategy)
+             : static_cast<size_t>(position));
+        FloatType* resultPtr = (position >= size) ? discardPtr
+          : outputPtr + static_cast<size_t>(position) * lanes;
+        for(size_t lane = 0; lane < lanes; ++lane) {
+          FloatType const y0 =
+            m1 * x1[lane] + m2 * x2[lane] + m3 * x3[lane] + m4 * x4[lane]
+            - d1 * y1[lane] - d2 * y2[lane] - d3 * y3[lane] - d4 * y4[lane];
+          x4[lane] = x3[lane];
+          x3[lane] = x2[lane];
+          x2[lane] = x1[lane];
+          x1[lane] = static_cast<FloatType>(rowPtr[lane]);
+          y4[lane] = y3[lane];
+          y3[lane] = y2[lane];
+          y2[lane] = y1[lane];
+          y1[lane] = y0;
+          resultPtr[lane] += y0;
+        }
+      }
+    }
+
+
+    // This function smooths, or computes derivatives of, a 2D array
+    // using RecursiveGaussian.
+    template <class OutputType, class InputType>
+    void
+    filterRecursiveGaussian(
+      Array2D<OutputType>& outputArray,
+      Array2D<InputType> const& inputArray,
+      double rowSigma, double columnSigma,
+      unsigned int rowDerivativeOrder,
+      unsigned int columnDerivativeOrder,
+      ConvolutionStrategy strategy,
+      brick::common::Float64 fillValue,
+      unsigned int numberOfThreads)
+    {
+      typedef brick::common::Float64 FloatType;
+      RecursiveGaussian<FloatType> rowFilter(
+        columnSigma, columnDerivativeOrder);
+      RecursiveGaussian<FloatType> columnFilter(
+        rowSigma, rowDerivativeOrder);
+      Array2D<FloatType> intermediateArray;
+      rowFilter.filterRows(intermediateArray, inputArray, strategy,
+                           fillValue, numberOfThreads);
+
+      // Rows of padding above and below the array would have been
+      // smoothed to fillValue, or differentiated to zero, by the
+      // first pass.
+      FloatType const intermediateFillValue =
+        (columnDerivativeOrder == 0) ? fillValue : FloatType(0);
+      columnFilter.filterColumns(outputArray, intermediateArray, strategy,
+                                 intermediateFillValue, numberOfThreads);
+    }
+
+  } // namespace numeric
+
+} // namespace brick
+
+#endif /* #ifndef BRICK_NUMERIC_RECURSIVEGAUSSIAN_IMPL_HH */
@@ -282,6 +282,64 @@ namespace brick {
       operator()(FloatType sValue, FloatType tValue) const;
 
 
+      /**
+       * This member function evaluates the interpolating function at
+       * many (s, t) points at once.  Because approximate() folds each
+       * level of refinement into a single spline, the cost of this
+       * call (and of operator()()) does not depend on the number of
+       * levels.  See BSpline2D::evaluate() for details.
+       *
+       * @param sBegin This iterator specifies the beginning of a
+       * sequence of S coordinates at which to evaluate the function.
+       * It must be a random access iterator.
+       *
+       * @param sEnd This iterator specifies the end of the sequence
+       * of S coordinates.
+       *
+       * @param tBegin This iterator specifies the beginning of the
+       * sequence of T coordinates corresponding to the S coordinate
+       * sequence described above.
+       *
+       * @param outputBegin This random access iterator specifies
+       * where to write the results.  There must be room for (sEnd -
+       * sBegin) values.
+       *
+       * @param numberOfThreads This argument specifies how many
+       * threads to use.  Setting it to zero uses one thread per
+       * available processor.
+       */
+      template <class CoordIter, class OutIter>
+      void
+      evaluate(CoordIter sBegin, CoordIter sEnd, CoordIter tBegin,
+               OutIter outputBegin, unsigned int numberOfThreads = 1) const;
+
+
+      /**
+       * This member function evaluates the interpolating function at
+       * every point of a rectangular grid in (s, t) space.  Element
+       * (row, column) of the result is equal to
+       * (*this)(sValues[column], tValues[row]), except for floating
+       * point rounding.  See BSpline2D::evaluateGrid() for details.
+       *
+       * @param sValues This argument specifies the S coordinate of
+       * each column of the grid.
+       *
+       * @param tValues This argument specifies the T coordinate of
+       * each row of the grid.
+       *
+       * @param numberOfThreads This argument specifies how many
+       * threads to use.  Setting it to zero uses one thread per
+       * available processor.
+       *
+       * @return The return value has tValues.size() rows and
+       * sValues.size() columns.
+       */
+      Array2D<Type>
+      evaluateGrid(Array1D<FloatType> const& sValues,
+                   Array1D<FloatType> const& tValues,
+                   unsigned int numberOfThreads = 1) const;
+
+
     protected:
 
       BSpline2D<Type, FloatType> m_bSpline2D;
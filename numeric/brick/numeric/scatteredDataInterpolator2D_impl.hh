@@ -210,9 +210,10 @@ namespace brick {
         this->m_bSpline2D = other.m_bSpline2D;
         this->m_isMeanCentered = other.m_isMeanCentered;
         this->m_meanValue = other.m_meanValue;
-        this->m_numerOfLevels = other.m_numberOfLevels;
+        this->m_numberOfLevels = other.m_numberOfLevels;
         this->m_testFunctor = other.m_testFunctor;
       }
+      return *this;
     }
 
 
@@ -227,6 +228,41 @@ namespace brick {
     }
 
 
+    // This member function evaluates the interpolating function at
+    // many (s, t) points at once.
+    template <class Type, class FloatType, class TestType>
+    template <class CoordIter, class OutIter>
+    void
+    ScatteredDataInterpolator2D<Type, FloatType, TestType>::
+    evaluate(CoordIter sBegin, CoordIter sEnd, CoordIter tBegin,
+             OutIter outputBegin, unsigned int numberOfThreads) const
+    {
+      this->m_bSpline2D.evaluate(sBegin, sEnd, tBegin, outputBegin,
+                                 numberOfThreads);
+      OutIter outputEnd = outputBegin + (sEnd - sBegin);
+      while(outputBegin != outputEnd) {
+        *outputBegin += this->m_meanValue;
+        ++outputBegin;
+      }
+    }
+
+
+    // This member function evaluates the interpolating function at
+    // every point of a rectangular grid in (s, t) space.
+    template <class Type, class FloatType, class TestType>
+    Array2D<Type>
+    ScatteredDataInterpolator2D<Type, FloatType, TestType>::
+    evaluateGrid(Array1D<FloatType> const& sValues,
+                 Array1D<FloatType> const& tValues,
+                 unsigned int numberOfThreads) const
+    {
+      Array2D<Type> result =
+        this->m_bSpline2D.evaluateGrid(sValues, tValues, numberOfThreads);
+      result += this->m_meanValue;
+      return result;
+    }
+
+
   } // namespace numeric
 
 } // namespace brick
@@ -0,0 +1,437 @@
+/**
+***************************************************************************
+* @file brick/numeric/test/amanatidesWoo3DBatchTest.cc
+*
+* Source file defining AmanatidesWoo3DBatchTest class.
+*
+* Copyright (C) 2026 David LaRose, dlr@cs.cmu.edu
+* See accompanying file, LICENSE.TXT, for details.
+*
+***************************************************************************
+**/
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <brick/numeric/utilities.hh>
+#include <brick/numeric/amanatidesWoo3D.hh>
+#include <brick/numeric/amanatidesWoo3DBatch.hh>
+#include <brick/numeric/array3D.hh>
+#include <brick/portability/timeUtilities.hh>
+#include <brick/test/testFixture.hh>
+
+namespace brick {
+
+  namespace numeric {
+
+    class AmanatidesWoo3DBatchTest
+      : public brick::test::TestFixture<AmanatidesWoo3DBatchTest> {
+
+    public:
+
+      AmanatidesWoo3DBatchTest();
+      ~AmanatidesWoo3DBatchTest() {}
+
+      void setUp(const std::string& /* testName */) {}
+      void tearDown(const std::string& /* testName */) {}
+
+      void testAccumulate();
+      void testExecutionTime();
+      void testFindFirstOccupied();
+      void testTraverse();
+      void testZeroDirection();
+
+    private:
+
+      void
+      getRandomRays(std::size_t numberOfRays,
+                    std::vector< Vector3D<double> >& rayOrigins,
+                    std::vector< Vector3D<double> >& rayDirections);
+
+      std::size_t m_columns;
+      std::mt19937 m_generator;
+      std::size_t m_rows;
+      std::size_t m_slices;
+      Transform3D<double> m_voxelTworld;
+
+    }; // class AmanatidesWoo3DBatchTest
+
+
+    /* ============== Member Function Definititions ============== */
+
+    AmanatidesWoo3DBatchTest::
+    AmanatidesWoo3DBatchTest()
+      : brick::test::TestFixture<AmanatidesWoo3DBatchTest>(
+          "AmanatidesWoo3DBatchTest"),
+        m_columns(23),
+        m_generator(54321),
+        m_rows(17),
+        m_slices(19),
+        m_voxelTworld(2.0, 0.0, 0.0, 11.5,
+                      0.0, 1.5, 0.0, 8.5,
+                      0.0, 0.0, 2.5, 9.5,
+                      0.0, 0.0, 0.0, 1.0)
+    {
+      // Register all tests.
+      BRICK_TEST_REGISTER_MEMBER(testAccumulate);
+      // BRICK_TEST_REGISTER_MEMBER(testExecutionTime);
+      BRICK_TEST_REGISTER_MEMBER(testFindFirstOccupied);
+      BRICK_TEST_REGISTER_MEMBER(testTraverse);
+      BRICK_TEST_REGISTER_MEMBER(testZeroDirection);
+    }
+
+
+    void
+    AmanatidesWoo3DBatchTest::
+    testAccumulate()
+    {
+      std::vector< Vector3D<double> > rayOrigins;
+      std::vector< Vector3D<double> > rayDirections;
+      this->getRandomRays(3000, rayOrigins, rayDirections);
+
+      for(int downstreamOnly = 0; downstreamOnly < 2; ++downstreamOnly) {
+        // Reference result uses the single-ray traversal class.
+        Array3D<int> referenceArray(m_slices, m_rows, m_columns);
+        referenceArray = 0;
+        std::size_t referenceVisits = 0;
+        for(std::size_t ii = 0; ii < rayOrigins.size(); ++ii) {
+          AmanatidesWoo3D< Array3D<int> > rayTracer(
+            referenceArray, m_voxelTworld, rayOrigins[ii], rayDirections[ii],
+            downstreamOnly != 0);
+          AmanatidesWoo3D< Array3D<int> >::iterator endIterator =
+            rayTracer.end();
+          for(AmanatidesWoo3D< Array3D<int> >::iterator iter =
+                rayTracer.begin(); iter != endIterator; ++iter) {
+            *iter += 1;
+            ++referenceVisits;
+          }
+        }
+        BRICK_TEST_ASSERT(referenceVisits > rayOrigins.size());
+
+        AmanatidesWoo3DBatch<double> batch(
+          m_slices, m_rows, m_columns, m_voxelTworld, downstreamOnly != 0);
+        for(unsigned int numberOfThreads = 1; numberOfThreads <= 4;
+            ++numberOfThreads) {
+          Array3D<int> testArray(m_slices, m_rows, m_columns);
+          testArray = 0;
+          std::size_t numberOfVisits = batch.accumulate(
+            testArray, rayOrigins, rayDirections, 1, numberOfThreads);
+          BRICK_TEST_ASSERT(numberOfVisits == referenceVisits);
+          BRICK_TEST_ASSERT(
+            std::equal(testArray.begin(), testArray.end(),
+                       referenceArray.begin()));
+        }
+
+        // Shape mismatches should be caught.
+        Array3D<int> wrongArray(m_slices, m_rows, m_columns + 1);
+        BRICK_TEST_ASSERT_EXCEPTION(
+          brick::common::ValueException,
+          batch.accumulate(wrongArray, rayOrigins, rayDirections, 1));
+        std::vector< Vector3D<double> > shortDirections(
+          rayDirections.begin(), rayDirections.end() - 1);
+        BRICK_TEST_ASSERT_EXCEPTION(
+          brick::common::ValueException,
+          batch.accumulate(wrongArray, rayOrigins, shortDirections, 1));
+      }
+    }
+
+
+    void
+    AmanatidesWoo3DBatchTest::
+    testExecutionTime()
+    {
+      std::size_t const gridSize = 256;
+      std::size_t const numberOfRays = 200000;
+      Transform3D<double> voxelTworld(
+        double(gridSize) / 2.0, 0.0, 0.0, double(gridSize) / 2.0,
+        0.0, double(gridSize) / 2.0, 0.0, double(gridSize) / 2.0,
+        0.0, 0.0, double(gridSize) / 2.0, double(gridSize) / 2.0,
+        0.0, 0.0, 0.0, 1.0);
+
+      std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+      std::vector< Vector3D<double> > rayOrigins;
+      std::vector< Vector3D<double> > rayDirections;
+      for(std::size_t ii = 0; ii < numberOfRays; ++ii) {
+        Vector3D<double> target(distribution(m_generator),
+                                distribution(m_generator),
+                                distribution(m_generator));
+        rayOrigins.push_back(Vector3D<double>(-1.5, 0.1, -1.2));
+        rayDirections.push_back(target - rayOrigins.back());
+      }
+
+      Array3D<float> occupancy(gridSize, gridSize, gridSize);
+      occupancy = 0.0f;
+
+      double t0 = brick::portability::getCurrentTime();
+      for(std::size_t ii = 0; ii < numberOfRays; ++ii) {
+        AmanatidesWoo3D< Array3D<float> > rayTracer(
+          occupancy, voxelTworld, rayOrigins[ii], rayDirections[ii], true);
+        AmanatidesWoo3D< Array3D<float> >::iterator endIterator =
+          rayTracer.end();
+        for(AmanatidesWoo3D< Array3D<float> >::iterator iter =
+              rayTracer.begin(); iter != endIterator; ++iter) {
+          *iter += 1.0f;
+        }
+      }
+      double t1 = brick::portability::getCurrentTime();
+      std::cout << "AmanatidesWoo3D: "
+                << numberOfRays / (t1 - t0) << " rays/second." << std::endl;
+
+      AmanatidesWoo3DBatch<double> batch(
+        gridSize, gridSize, gridSize, voxelTworld);
+      for(unsigned int numberOfThreads = 1; numberOfThreads <= 4;
+          numberOfThreads *= 2) {
+        t0 = brick::portability::getCurrentTime();
+        batch.accumulate(occupancy, rayOrigins, rayDirections, 1.0f,
+                         numberOfThreads);
+        t1 = brick::portability::getCurrentTime();
+        std::cout << "AmanatidesWoo3DBatch::accumulate(), "
+                  << numberOfThreads << " thread(s): "
+                  << numberOfRays / (t1 - t0) << " rays/second." << std::endl;
+      }
+
+      // Sparse scene for testing empty space skipping.
+      Array3D<float> scene(gridSize, gridSize, gridSize);
+      scene = 0.0f;
+      for(std::size_t ii = 0; ii < 200; ++ii) {
+        std::size_t index = static_cast<std::size_t>(
+          (distribution(m_generator) + 1.0) / 2.0 * (scene.size() - 1));
+        scene[index] = 1.0f;
+      }
+      std::vector<std::size_t> voxelIndices;
+      std::vector<double> lambdas;
+      for(std::size_t blockSize = 0; blockSize <= 16; blockSize += 8) {
+        batch.setOccupancy(scene, blockSize);
+        t0 = brick::portability::getCurrentTime();
+        batch.findFirstOccupied(scene, rayOrigins, rayDirections,
+                                voxelIndices, lambdas);
+        t1 = brick::portability::getCurrentTime();
+        std::cout << "AmanatidesWoo3DBatch::findFirstOccupied(), "
+                  << "block size " << blockSize << ": "
+                  << numberOfRays / (t1 - t0) << " rays/second." << std::endl;
+      }
+    }
+
+
+    void
+    AmanatidesWoo3DBatchTest::
+    testFindFirstOccupied()
+    {
+      std::vector< Vector3D<double> > rayOrigins;
+      std::vector< Vector3D<double> > rayDirections;
+      this->getRandomRays(3000, rayOrigins, rayDirections);
+
+      // Sparse scene with a few occupied voxels.
+      Array3D<int> scene(m_slices, m_rows, m_columns);
+      scene = 0;
+      std::uniform_int_distribution<std::size_t> indexDistribution(
+        0, scene.size() - 1);
+      for(std::size_t ii = 0; ii < 60; ++ii) {
+        scene[indexDistribution(m_generator)] = 1;
+      }
+
+      // Reference result uses the single-ray traversal class.
+      std::vector<std::size_t> referenceIndices(rayOrigins.size());
+      std::size_t referenceHits = 0;
+      for(std::size_t ii = 0; ii < rayOrigins.size(); ++ii) {
+        referenceIndices[ii] = scene.size();
+        AmanatidesWoo3D< Array3D<int> > rayTracer(
+          scene, m_voxelTworld, rayOrigins[ii], rayDirections[ii], true);
+        AmanatidesWoo3D< Array3D<int> >::iterator endIterator =
+          rayTracer.end();
+        for(AmanatidesWoo3D< Array3D<int> >::iterator iter =
+              rayTracer.begin(); iter != endIterator; ++iter) {
+          if(*iter != 0) {
+            referenceIndices[ii] = &(*iter) - scene.data();
+            ++referenceHits;
+            break;
+          }
+        }
+      }
+      BRICK_TEST_ASSERT(referenceHits > rayOrigins.size() / 10);
+      BRICK_TEST_ASSERT(referenceHits < rayOrigins.size());
+
+      AmanatidesWoo3DBatch<double> batch(
+        m_slices, m_rows, m_columns, m_voxelTworld, true);
+      for(std::size_t blockSize = 0; blockSize <= 8; blockSize += 4) {
+        batch.setOccupancy(scene, blockSize);
+        for(unsigned int numberOfThreads = 1; numberOfThreads <= 4;
+            ++numberOfThreads) {
+          std::vector<std::size_t> voxelIndices;
+          std::vector<double> lambdas;
+          std::size_t numberOfHits = batch.findFirstOccupied(
+            scene, rayOrigins, rayDirections, voxelIndices, lambdas,
+            numberOfThreads);
+          BRICK_TEST_ASSERT(numberOfHits == referenceHits);
+          BRICK_TEST_ASSERT(voxelIndices == referenceIndices);
+          for(std::size_t ii = 0; ii < rayOrigins.size(); ++ii) {
+            if(voxelIndices[ii] != scene.size()) {
+              BRICK_TEST_ASSERT(lambdas[ii] >= 0.0);
+            }
+          }
+        }
+      }
+    }
+
+
+    void
+    AmanatidesWoo3DBatchTest::
+    testTraverse()
+    {
+      std::vector< Vector3D<double> > rayOrigins;
+      std::vector< Vector3D<double> > rayDirections;
+      this->getRandomRays(500, rayOrigins, rayDirections);
+      AmanatidesWoo3DBatch<double> batch(
+        m_slices, m_rows, m_columns, m_voxelTworld, true);
+
+      // Record the path of each ray, and compare with the single-ray
+      // traversal class.
+      std::vector< std::vector<std::size_t> > paths(rayOrigins.size());
+      std::size_t numberOfVisits = batch.traverse(
+        rayOrigins, rayDirections,
+        [&](std::size_t rayIndex, std::size_t voxelIndex) {
+          paths[rayIndex].push_back(voxelIndex);
+          return true;
+        }, 3);
+
+      Array3D<int> scene(m_slices, m_rows, m_columns);
+      std::size_t referenceVisits = 0;
+      for(std::size_t ii = 0; ii < rayOrigins.size(); ++ii) {
+        AmanatidesWoo3D< Array3D<int> > rayTracer(
+          scene, m_voxelTworld, rayOrigins[ii], rayDirections[ii], true);
+        AmanatidesWoo3D< Array3D<int> >::iterator endIterator =
+          rayTracer.end();
+        std::vector<std::size_t> referencePath;
+        for(AmanatidesWoo3D< Array3D<int> >::iterator iter =
+              rayTracer.begin(); iter != endIterator; ++iter) {
+          referencePath.push_back(&(*iter) - scene.data());
+        }
+        BRICK_TEST_ASSERT(paths[ii] == referencePath);
+        referenceVisits += referencePath.size();
+      }
+      BRICK_TEST_ASSERT(numberOfVisits == referenceVisits);
+
+      // Returning false should stop each ray after the first voxel.
+      numberOfVisits = batch.traverse(
+        rayOrigins, rayDirections,
+        [](std::size_t, std::size_t) {return false;});
+      std::size_t numberOfNonemptyPaths = 0;
+      for(std::size_t ii = 0; ii < paths.size(); ++ii) {
+        numberOfNonemptyPaths += paths[ii].empty() ? 0 : 1;
+      }
+      BRICK_TEST_ASSERT(numberOfVisits == numberOfNonemptyPaths);
+    }
+
+
+    void
+    AmanatidesWoo3DBatchTest::
+    testZeroDirection()
+    {
+      // A zero direction ray starting inside the grid used to loop
+      // forever.  It should visit nothing, without disturbing the
+      // other rays in the batch.
+      std::vector< Vector3D<double> > rayOrigins;
+      std::vector< Vector3D<double> > rayDirections;
+      this->getRandomRays(20, rayOrigins, rayDirections);
+      std::size_t const numberOfGoodRays = rayOrigins.size();
+      rayOrigins.push_back(Vector3D<double>(0.1, -0.2, 0.3));
+      rayDirections.push_back(Vector3D<double>(0.0, 0.0, 0.0));
+      std::vector< Vector3D<double> > goodOrigins(
+        rayOrigins.begin(), rayOrigins.begin() + numberOfGoodRays);
+      std::vector< Vector3D<double> > goodDirections(
+        rayDirections.begin(), rayDirections.begin() + numberOfGoodRays);
+
+      for(int downstreamOnly = 0; downstreamOnly < 2; ++downstreamOnly) {
+        AmanatidesWoo3DBatch<double> batch(
+          m_slices, m_rows, m_columns, m_voxelTworld, downstreamOnly != 0);
+
+        Array3D<int> referenceArray(m_slices, m_rows, m_columns);
+        referenceArray = 0;
+        std::size_t referenceVisits = batch.accumulate(
+          referenceArray, goodOrigins, goodDirections, 1);
+        Array3D<int> testArray(m_slices, m_rows, m_columns);
+        testArray = 0;
+        std::size_t numberOfVisits = batch.accumulate(
+          testArray, rayOrigins, rayDirections, 1);
+        BRICK_TEST_ASSERT(numberOfVisits == referenceVisits);
+        BRICK_TEST_ASSERT(
+          std::equal(testArray.begin(), testArray.end(),
+                     referenceArray.begin()));
+
+        std::size_t numberOfCalls = batch.traverse(
+          std::vector< Vector3D<double> >(1, rayOrigins.back()),
+          std::vector< Vector3D<double> >(1, rayDirections.back()),
+          [](std::size_t, std::size_t) {return true;});
+        BRICK_TEST_ASSERT(numberOfCalls == 0);
+
+        // Occupied everywhere, so only the zero direction ray misses.
+        Array3D<int> scene(m_slices, m_rows, m_columns);
+        scene = 1;
+        for(std::size_t blockSize = 0; blockSize < 8; blockSize += 4) {
+          batch.setOccupancy(scene, blockSize);
+          std::vector<std::size_t> voxelIndices;
+          std::vector<double> lambdas;
+          batch.findFirstOccupied(scene, rayOrigins, rayDirections,
+                                  voxelIndices, lambdas);
+          BRICK_TEST_ASSERT(voxelIndices.back() == scene.size());
+          BRICK_TEST_ASSERT(lambdas.back() == 0.0);
+        }
+      }
+    }
+
+
+    void
+    AmanatidesWoo3DBatchTest::
+    getRandomRays(std::size_t numberOfRays,
+                  std::vector< Vector3D<double> >& rayOrigins,
+                  std::vector< Vector3D<double> >& rayDirections)
+    {
+      // The voxel array covers roughly [-6, 6] x [-6, 6] x [-4, 4]
+      // in world coordinates.  Some rays start inside, and some
+      // outside.  A few are parallel to the world axes.
+      std::uniform_real_distribution<double> distribution(-10.0, 10.0);
+      rayOrigins.clear();
+      rayDirections.clear();
+      for(std::size_t ii = 0; ii < numberOfRays; ++ii) {
+        Vector3D<double> origin(distribution(m_generator),
+                                distribution(m_generator),
+                                distribution(m_generator));
+        Vector3D<double> target(distribution(m_generator) / 2.0,
+                                distribution(m_generator) / 2.0,
+                                distribution(m_generator) / 2.0);
+        Vector3D<double> direction = target - origin;
+        if(ii % 50 == 0) {
+          direction.setY(0.0);
+        }
+        if(ii % 70 == 0) {
+          direction.setZ(0.0);
+        }
+        rayOrigins.push_back(origin);
+        rayDirections.push_back(direction);
+      }
+    }
+
+  } // namespace numeric
+
+} // namespace brick
+
+
+#if 0
+
+int main(int argc, char** argv)
+{
+  brick::numeric::AmanatidesWoo3DBatchTest currentTest;
+  bool result = currentTest.run();
+  return (result ? 0 : 1);
+}
+
+#else
+
+namespace {
+
+  brick::numeric::AmanatidesWoo3DBatchTest currentTest;
+
+}
+
+#endif
@@ -11,6 +11,7 @@
 **/
 
 #include <limits>
+#include <vector>
 
 #include <brick/common/functional.hh>
 #include <brick/numeric/bSpline2D.hh>
@@ -37,6 +38,8 @@ namespace brick {
       void testApproximateScatteredData();
       void testPromote();
       void testOperatorPlusEquals();
+      void testEvaluate();
+      void testEvaluateGrid();
 
     private:
 
@@ -56,6 +59,8 @@ namespace brick {
       BRICK_TEST_REGISTER_MEMBER(testApproximateScatteredData);
       BRICK_TEST_REGISTER_MEMBER(testPromote);
       BRICK_TEST_REGISTER_MEMBER(testOperatorPlusEquals);
+      BRICK_TEST_REGISTER_MEMBER(testEvaluate);
+      BRICK_TEST_REGISTER_MEMBER(testEvaluateGrid);
     }
 
 
@@ -245,6 +250,115 @@ namespace brick {
 
     }
 
+
+    void
+    BSpline2DTest::
+    testEvaluate()
+    {
+      // Arbitrary, made up, scattered data to interpolate.
+      Array2D<double> testData(
+        "[[0.0, 0.7, 4.0],"
+        " [5.5, 0.0, 6.0],"
+        " [3.0, 3.0, 1.0],"
+        " [1.2, 3.7, 0.4],"
+        " [3.0, 4.5, 1.3],"
+        " [4.2, 4.6, 6.0],"
+        " [5.7, 2.5, 5.8],"
+        " [3.1, 0.0, 2.2]]");
+      BSpline2D<double> bSpline;
+      bSpline.setNumberOfNodes(9, 11);
+      Array2D<double> sCoordArray = subArray(testData, Slice(), Slice(0, 1));
+      Array2D<double> tCoordArray = subArray(testData, Slice(), Slice(1, 2));
+      Array2D<double> zCoordArray = subArray(testData, Slice(), Slice(2, 3));
+      bSpline.approximateScatteredData(sCoordArray.begin(), sCoordArray.end(),
+                                       tCoordArray.begin(),
+                                       zCoordArray.begin());
+
+      // Pseudo-random sample points, including a number of points
+      // that isn't a multiple of the internal block size.
+      std::vector<double> sValues;
+      std::vector<double> tValues;
+      for(size_t ii = 0; ii < 1001; ++ii) {
+        sValues.push_back(5.699 * ((ii * 37) % 1001) / 1001.0);
+        tValues.push_back(4.599 * ((ii * 101) % 1001) / 1001.0);
+      }
+
+      for(unsigned int numberOfThreads = 0; numberOfThreads < 4;
+          ++numberOfThreads) {
+        std::vector<double> results(sValues.size());
+        bSpline.evaluate(sValues.begin(), sValues.end(), tValues.begin(),
+                         results.begin(), numberOfThreads);
+        for(size_t ii = 0; ii < sValues.size(); ++ii) {
+          BRICK_TEST_ASSERT(
+            approximatelyEqual(results[ii], bSpline(sValues[ii], tValues[ii]),
+                               this->m_defaultTolerance));
+        }
+      }
+
+      // Points outside the control grid should be rejected.
+      sValues[500] = -10.0;
+      std::vector<double> results(sValues.size());
+      BRICK_TEST_ASSERT_EXCEPTION(
+        common::ValueException,
+        bSpline.evaluate(sValues.begin(), sValues.end(), tValues.begin(),
+                         results.begin()));
+    }
+
+
+    void
+    BSpline2DTest::
+    testEvaluateGrid()
+    {
+      // Arbitrary, made up, scattered data to interpolate.
+      Array2D<double> testData(
+        "[[0.0, 0.7, 4.0],"
+        " [5.5, 0.0, 6.0],"
+        " [3.0, 3.0, 1.0],"
+        " [1.2, 3.7, 0.4],"
+        " [3.0, 4.5, 1.3],"
+        " [4.2, 4.6, 6.0],"
+        " [5.7, 2.5, 5.8],"
+        " [3.1, 0.0, 2.2]]");
+      Array2D<double> sCoordArray = subArray(testData, Slice(), Slice(0, 1));
+      Array2D<double> tCoordArray = subArray(testData, Slice(), Slice(1, 2));
+      Array2D<double> zCoordArray = subArray(testData, Slice(), Slice(2, 3));
+
+      for(int isIsotropic = 0; isIsotropic < 2; ++isIsotropic) {
+        BSpline2D<double> bSpline(isIsotropic != 0);
+        bSpline.setNumberOfNodes(7, 12);
+        bSpline.approximateScatteredData(
+          sCoordArray.begin(), sCoordArray.end(), tCoordArray.begin(),
+          zCoordArray.begin());
+
+        // Grid coordinates needn't be uniformly spaced, or even
+        // sorted.
+        Array1D<double> sValues(57);
+        for(size_t ii = 0; ii < sValues.size(); ++ii) {
+          sValues[ii] = 5.7 * ((ii * 13) % sValues.size()) / sValues.size();
+        }
+        Array1D<double> tValues(46);
+        for(size_t ii = 0; ii < tValues.size(); ++ii) {
+          tValues[ii] = 0.1 * ii;
+        }
+
+        for(unsigned int numberOfThreads = 1; numberOfThreads < 4;
+            ++numberOfThreads) {
+          Array2D<double> results =
+            bSpline.evaluateGrid(sValues, tValues, numberOfThreads);
+          BRICK_TEST_ASSERT(results.rows() == tValues.size());
+          BRICK_TEST_ASSERT(results.columns() == sValues.size());
+          for(size_t row = 0; row < results.rows(); ++row) {
+            for(size_t column = 0; column < results.columns(); ++column) {
+              BRICK_TEST_ASSERT(
+                approximatelyEqual(results(row, column),
+                                   bSpline(sValues[column], tValues[row]),
+                                   this->m_defaultTolerance));
+            }
+          }
+        }
+      }
+    }
+
   } // namespace numeric
 
 } // namespace brick
@@ -0,0 +1,457 @@
+/**
+***************************************************************************
+* @file brick/numeric/test/recursiveGaussianTest.cc
+*
+* Source file defining tests for RecursiveGaussian.
+*
+* Copyright (C) 2026 David LaRose, dlr@cs.cmu.edu
+* See accompanying file, LICENSE.TXT, for details.
+*
+***************************************************************************
+**/
+
+#include <algorithm>
+#include <cmath>
+#include <brick/numeric/recursiveGaussian.hh>
+#include <brick/common/functional.hh>
+#include <brick/test/testFixture.hh>
+
+namespace brick {
+
+  namespace numeric {
+
+    class RecursiveGaussianTest
+      : public brick::test::TestFixture<RecursiveGaussianTest> {
+
+    public:
+
+      RecursiveGaussianTest();
+      ~RecursiveGaussianTest() {}
+
+      void setUp(const std::string& /* testName */) {}
+      void tearDown(const std::string& /* testName */) {}
+
+      void testFilter();
+      void testFilterBoundaries();
+      void testFilterDerivatives();
+      void testFilterRowsAndColumns();
+      void testFilterRecursiveGaussian();
+      void testExceptions();
+
+    private:
+
+      Array1D<double>
+      getTestSignal(size_t length);
+
+      double
+      getTolerance(Array1D<double> const& reference,
+                   unsigned int derivativeOrder);
+
+      Array1D<double>
+      referenceFilter(Array1D<double> const& signal, double sigma,
+                      unsigned int derivativeOrder,
+                      ConvolutionStrategy strategy, double fillValue = 0.0);
+
+    }; // class RecursiveGaussianTest
+
+
+    /* ============== Member Function Definititions ============== */
+
+    RecursiveGaussianTest::
+    RecursiveGaussianTest()
+      : brick::test::TestFixture<RecursiveGaussianTest>(
+        "RecursiveGaussianTest")
+    {
+      BRICK_TEST_REGISTER_MEMBER(testFilter);
+      BRICK_TEST_REGISTER_MEMBER(testFilterBoundaries);
+      BRICK_TEST_REGISTER_MEMBER(testFilterDerivatives);
+      BRICK_TEST_REGISTER_MEMBER(testFilterRowsAndColumns);
+      BRICK_TEST_REGISTER_MEMBER(testFilterRecursiveGaussian);
+      BRICK_TEST_REGISTER_MEMBER(testExceptions);
+    }
+
+
+    void
+    RecursiveGaussianTest::
+    testFilter()
+    {
+      // Compare with brute force filtering by a sampled Gaussian.
+      // The recursive filter is only an approximation, so the
+      // tolerance is relative to the size of the result.
+      Array1D<double> signal = getTestSignal(300);
+      double sigmas[] = {1.0, 3.0, 8.0, 20.0};
+      for(size_t ii = 0; ii < 4; ++ii) {
+        RecursiveGaussian<double> recursiveGaussian(sigmas[ii]);
+        BRICK_TEST_ASSERT(recursiveGaussian.getSigma() == sigmas[ii]);
+        BRICK_TEST_ASSERT(recursiveGaussian.getDerivativeOrder() == 0);
+        Array1D<double> result;
+        recursiveGaussian.filter(result, signal);
+        Array1D<double> reference = referenceFilter(
+          signal, sigmas[ii], 0, BRICK_CONVOLVE_REFLECT_SIGNAL);
+        BRICK_TEST_ASSERT(result.size() == signal.size());
+        double tolerance = this->getTolerance(reference, 0);
+        for(size_t jj = 0; jj < signal.size(); ++jj) {
+          BRICK_TEST_ASSERT(
+            approximatelyEqual(result[jj], reference[jj], tolerance));
+        }
+
+        // Single precision should agree closely with double, at
+        // least for modest sigma.
+        if(sigmas[ii] < 10.0) {
+          RecursiveGaussian<float> recursiveGaussianFloat(sigmas[ii]);
+          Array1D<float> resultFloat;
+          recursiveGaussianFloat.filter(resultFloat, signal);
+          for(size_t jj = 0; jj < signal.size(); ++jj) {
+            BRICK_TEST_ASSERT(
+              approximatelyEqual(double(resultFloat[jj]), result[jj], 1.0E-2));
+          }
+        }
+      }
+    }
+
+
+    void
+    RecursiveGaussianTest::
+    testFilterBoundaries()
+    {
+      Array1D<double> signal = getTestSignal(40);
+      ConvolutionStrategy strategies[] = {
+        BRICK_CONVOLVE_ZERO_PAD_SIGNAL, BRICK_CONVOLVE_PAD_SIGNAL,
+        BRICK_CONVOLVE_REFLECT_SIGNAL, BRICK_CONVOLVE_WRAP_SIGNAL};
+      for(unsigned int order = 0; order < 3; ++order) {
+        // Sigma is large compared to the signal, so that reflected
+        // and wrapped boundaries extend over several periods.
+        double sigmas[] = {2.0, 15.0};
+        for(size_t ii = 0; ii < 2; ++ii) {
+          RecursiveGaussian<double> recursiveGaussian(sigmas[ii], order);
+          for(size_t jj = 0; jj < 4; ++jj) {
+            Array1D<double> result;
+            recursiveGaussian.filter(result, signal, strategies[jj], 75.0);
+            Array1D<double> reference = referenceFilter(
+              signal, sigmas[ii], order, strategies[jj], 75.0);
+            double tolerance = this->getTolerance(reference, order);
+            for(size_t kk = 0; kk < signal.size(); ++kk) {
+              BRICK_TEST_ASSERT(
+                approximatelyEqual(result[kk], reference[kk], tolerance));
+            }
+          }
+        }
+      }
+
+      // Padding with the signal value should leave a constant
+      // signal exactly unchanged, as should reflection and wrapping.
+      Array1D<double> constantSignal(25);
+      constantSignal = 4.0;
+      RecursiveGaussian<double> smoother(10.0);
+      RecursiveGaussian<double> differentiator(10.0, 1);
+      RecursiveGaussian<double> secondDifferentiator(10.0, 2);
+      for(size_t jj = 1; jj < 4; ++jj) {
+        Array1D<double> result;
+        Array1D<double> derivative;
+        Array1D<double> secondDerivative;
+        smoother.filter(result, constantSignal, strategies[jj], 4.0);
+        differentiator.filter(derivative, constantSignal, strategies[jj], 4.0);
+        secondDifferentiator.filter(secondDerivative, constantSignal,
+                                    strategies[jj], 4.0);
+        for(size_t kk = 0; kk < constantSignal.size(); ++kk) {
+          BRICK_TEST_ASSERT(approximatelyEqual(result[kk], 4.0, 1.0E-9));
+          BRICK_TEST_ASSERT(approximatelyEqual(derivative[kk], 0.0, 1.0E-9));
+          BRICK_TEST_ASSERT(
+            approximatelyEqual(secondDerivative[kk], 0.0, 1.0E-9));
+        }
+      }
+    }
+
+
+    void
+    RecursiveGaussianTest::
+    testFilterDerivatives()
+    {
+      // Gaussian smoothing doesn't change the derivatives of a
+      // polynomial of degree two or less, so away from the ends of
+      // the signal, the derivative filters should be nearly exact.
+      Array1D<double> signal(1000);
+      for(size_t ii = 0; ii < signal.size(); ++ii) {
+        double x = double(ii) - 500.0;
+        signal[ii] = 3.0 + 0.5 * x - 0.01 * x * x;
+      }
+      double sigmas[] = {1.0, 5.0, 25.0};
+      for(size_t ii = 0; ii < 3; ++ii) {
+        RecursiveGaussian<double> differentiator(sigmas[ii], 1);
+        RecursiveGaussian<double> secondDifferentiator(sigmas[ii], 2);
+        Array1D<double> derivative;
+        Array1D<double> secondDerivative;
+        differentiator.filter(derivative, signal,
+                              BRICK_CONVOLVE_ZERO_PAD_SIGNAL);
+        secondDifferentiator.filter(secondDerivative, signal,
+                                    BRICK_CONVOLVE_ZERO_PAD_SIGNAL);
+        BRICK_TEST_ASSERT(differentiator.getDerivativeOrder() == 1);
+        BRICK_TEST_ASSERT(secondDifferentiator.getDerivativeOrder() == 2);
+        for(size_t jj = 480; jj < 520; ++jj) {
+          double x = double(jj) - 500.0;
+          BRICK_TEST_ASSERT(
+            approximatelyEqual(derivative[jj], 0.5 - 0.02 * x, 1.0E-6));
+          BRICK_TEST_ASSERT(
+            approximatelyEqual(secondDerivative[jj], -0.02, 1.0E-6));
+        }
+      }
+
+      // Compare with brute force filtering by sampled Gaussian
+      // derivatives.
+      signal = getTestSignal(300);
+      for(size_t ii = 0; ii < 3; ++ii) {
+        for(unsigned int order = 1; order < 3; ++order) {
+          RecursiveGaussian<double> recursiveGaussian(sigmas[ii], order);
+          Array1D<double> result;
+          recursiveGaussian.filter(result, signal);
+          Array1D<double> reference = referenceFilter(
+            signal, sigmas[ii], order, BRICK_CONVOLVE_REFLECT_SIGNAL);
+          double tolerance = this->getTolerance(reference, order);
+          for(size_t jj = 0; jj < signal.size(); ++jj) {
+            BRICK_TEST_ASSERT(
+              approximatelyEqual(result[jj], reference[jj], tolerance));
+          }
+        }
+      }
+    }
+
+
+    void
+    RecursiveGaussianTest::
+    testFilterRowsAndColumns()
+    {
+      // Filtering rows or columns should be the same as filtering
+      // each row or column individually, regardless of how many
+      // threads are used.  The array is big enough to exercise
+      // partial strips and blocks.
+      size_t const rows = 37;
+      size_t const columns = 141;
+      Array1D<double> signal = getTestSignal(rows * columns);
+      Array2D<double> inputArray(rows, columns);
+      std::copy(signal.begin(), signal.end(), inputArray.begin());
+
+      RecursiveGaussian<double> recursiveGaussian(4.0, 1);
+      for(unsigned int numberOfThreads = 1; numberOfThreads < 4;
+          numberOfThreads += 2) {
+        Array2D<double> rowResult;
+        Array2D<double> columnResult;
+        recursiveGaussian.filterRows(
+          rowResult, inputArray, BRICK_CONVOLVE_WRAP_SIGNAL, 0.0,
+          numberOfThreads);
+        recursiveGaussian.filterColumns(
+          columnResult, inputArray, BRICK_CONVOLVE_WRAP_SIGNAL, 0.0,
+          numberOfThreads);
+        BRICK_TEST_ASSERT(rowResult.rows() == rows);
+        BRICK_TEST_ASSERT(rowResult.columns() == columns);
+        BRICK_TEST_ASSERT(columnResult.rows() == rows);
+        BRICK_TEST_ASSERT(columnResult.columns() == columns);
+
+        for(size_t row = 0; row < rows; ++row) {
+          Array1D<double> inputRow(columns);
+          Array1D<double> outputRow;
+          std::copy(inputArray.data(row, 0), inputArray.data(row, 0) + columns,
+                    inputRow.begin());
+          recursiveGaussian.filter(outputRow, inputRow,
+                                   BRICK_CONVOLVE_WRAP_SIGNAL);
+          for(size_t column = 0; column < columns; ++column) {
+            BRICK_TEST_ASSERT(
+              approximatelyEqual(rowResult(row, column), outputRow[column],
+                                 1.0E-10));
+          }
+        }
+        for(size_t column = 0; column < columns; ++column) {
+          Array1D<double> inputColumn(rows);
+          Array1D<double> outputColumn;
+          for(size_t row = 0; row < rows; ++row) {
+            inputColumn[row] = inputArray(row, column);
+          }
+          recursiveGaussian.filter(outputColumn, inputColumn,
+                                   BRICK_CONVOLVE_WRAP_SIGNAL);
+          for(size_t row = 0; row < rows; ++row) {
+            BRICK_TEST_ASSERT(
+              approximatelyEqual(columnResult(row, column), outputColumn[row],
+                                 1.0E-10));
+          }
+        }
+      }
+    }
+
+
+    void
+    RecursiveGaussianTest::
+    testFilterRecursiveGaussian()
+    {
+      size_t const rows = 50;
+      size_t const columns = 70;
+      Array2D<unsigned char> inputArray(rows, columns);
+      for(size_t row = 0; row < rows; ++row) {
+        for(size_t column = 0; column < columns; ++column) {
+          inputArray(row, column) = static_cast<unsigned char>(
+            (row * 17 + column * column * 3) % 251);
+        }
+      }
+
+      for(unsigned int rowOrder = 0; rowOrder < 3; ++rowOrder) {
+        for(unsigned int columnOrder = 0; columnOrder < 3; ++columnOrder) {
+          Array2D<double> result;
+          filterRecursiveGaussian(
+            result, inputArray, 3.0, 6.0, rowOrder, columnOrder,
+            BRICK_CONVOLVE_PAD_SIGNAL, 20.0, 2);
+
+          RecursiveGaussian<double> rowFilter(6.0, columnOrder);
+          RecursiveGaussian<double> columnFilter(3.0, rowOrder);
+          Array2D<double> intermediate;
+          Array2D<double> reference;
+          rowFilter.filterRows(intermediate, inputArray,
+                               BRICK_CONVOLVE_PAD_SIGNAL, 20.0);
+          columnFilter.filterColumns(reference, intermediate,
+                                     BRICK_CONVOLVE_PAD_SIGNAL,
+                                     (columnOrder == 0) ? 20.0 : 0.0);
+          for(size_t ii = 0; ii < result.size(); ++ii) {
+            BRICK_TEST_ASSERT(
+              approximatelyEqual(result[ii], reference[ii], 1.0E-10));
+          }
+        }
+      }
+
+      // Padding with the array value should leave a constant array
+      // unchanged, and make all derivatives zero.
+      Array2D<float> constantArray(20, 30);
+      constantArray = 7.0f;
+      Array2D<float> smoothed;
+      Array2D<float> gradient;
+      filterRecursiveGaussian(smoothed, constantArray, 5.0, 5.0, 0, 0,
+                              BRICK_CONVOLVE_PAD_SIGNAL, 7.0);
+      filterRecursiveGaussian(gradient, constantArray, 5.0, 5.0, 1, 0,
+                              BRICK_CONVOLVE_PAD_SIGNAL, 7.0);
+      for(size_t ii = 0; ii < smoothed.size(); ++ii) {
+        BRICK_TEST_ASSERT(approximatelyEqual(smoothed[ii], 7.0f, 1.0E-5f));
+        BRICK_TEST_ASSERT(approximatelyEqual(gradient[ii], 0.0f, 1.0E-5f));
+      }
+    }
+
+
+    void
+    RecursiveGaussianTest::
+    testExceptions()
+    {
+      BRICK_TEST_ASSERT_EXCEPTION(common::ValueException,
+                                  RecursiveGaussian<double>(0.4));
+      BRICK_TEST_ASSERT_EXCEPTION(common::ValueException,
+                                  RecursiveGaussian<double>(2.0, 3));
+
+      RecursiveGaussian<double> recursiveGaussian(2.0);
+      Array1D<double> signal = getTestSignal(20);
+      Array1D<double> result;
+      BRICK_TEST_ASSERT_EXCEPTION(
+        common::NotImplementedException,
+        recursiveGaussian.filter(result, signal, BRICK_CONVOLVE_PAD_RESULT));
+      BRICK_TEST_ASSERT_EXCEPTION(
+        common::NotImplementedException,
+        recursiveGaussian.filter(result, signal,
+                                 BRICK_CONVOLVE_TRUNCATE_RESULT));
+    }
+
+
+    Array1D<double>
+    RecursiveGaussianTest::
+    getTestSignal(size_t length)
+    {
+      Array1D<double> signal(length);
+      for(size_t ii = 0; ii < length; ++ii) {
+        signal[ii] = (50.0 * std::sin(0.05 * double(ii))
+                      + 30.0 * std::cos(0.37 * double(ii * ii % 97))
+                      + ((ii % 23 < 7) ? 20.0 : 0.0));
+      }
+      return signal;
+    }
+
+
+    double
+    RecursiveGaussianTest::
+    getTolerance(Array1D<double> const& reference,
+                 unsigned int derivativeOrder)
+    {
+      // Deriche's fit is good to a small fraction of a percent for
+      // smoothing, and to better than a percent for the first
+      // derivative.  The second derivative is the least accurate.
+      double const relativeTolerances[] = {1.0E-3, 1.0E-2, 6.0E-2};
+      double maximum = 0.0;
+      for(size_t ii = 0; ii < reference.size(); ++ii) {
+        maximum = std::max(maximum, std::fabs(reference[ii]));
+      }
+      return relativeTolerances[derivativeOrder] * maximum;
+    }
+
+
+    Array1D<double>
+    RecursiveGaussianTest::
+    referenceFilter(Array1D<double> const& signal, double sigma,
+                    unsigned int derivativeOrder,
+                    ConvolutionStrategy strategy, double fillValue)
+    {
+      // Brute force convolution with the sampled kernel, after
+      // extending the signal according to strategy.  The kernel
+      // is truncated well beyond where it matters.
+      long const size = static_cast<long>(signal.size());
+      long const radius = static_cast<long>(std::ceil(10.0 * sigma));
+      double const scale = 1.0 / (std::sqrt(2.0 * 3.14159265358979) * sigma);
+      Array1D<double> result(signal.size());
+      for(long ii = 0; ii < size; ++ii) {
+        double sum = 0.0;
+        for(long jj = -radius; jj <= radius; ++jj) {
+          long index = ii - jj;
+          double value;
+          if(index >= 0 && index < size) {
+            value = signal[index];
+          } else if(strategy == BRICK_CONVOLVE_ZERO_PAD_SIGNAL) {
+            value = 0.0;
+          } else if(strategy == BRICK_CONVOLVE_PAD_SIGNAL) {
+            value = fillValue;
+          } else if(strategy == BRICK_CONVOLVE_WRAP_SIGNAL) {
+            value = signal[((index % size) + size) % size];
+          } else {
+            long position = ((index % (2 * size)) + 2 * size) % (2 * size);
+            if(position >= size) {
+              position = 2 * size - 1 - position;
+            }
+            value = signal[position];
+          }
+          double x = double(jj) / sigma;
+          double gaussian = scale * std::exp(-0.5 * x * x);
+          double weight = gaussian;
+          if(derivativeOrder == 1) {
+            weight = -x / sigma * gaussian;
+          } else if(derivativeOrder == 2) {
+            weight = (x * x - 1.0) / (sigma * sigma) * gaussian;
+          }
+          sum += weight * value;
+        }
+        result[ii] = sum;
+      }
+      return result;
+    }
+
+  } // namespace numeric
+
+} // namespace brick
+
+
+#if 0
+
+int main(int argc, char** argv)
+{
+  brick::numeric::RecursiveGaussianTest currentTest;
+  bool result = currentTest.run();
+  return (result ? 0 : 1);
+}
+
+#else
+
+namespace {
+
+  brick::numeric::RecursiveGaussianTest currentTest;
+
+}
+
+#endif
@@ -13,6 +13,7 @@
 #include <stdint.h>
 
 #include <limits>
+#include <vector>
 
 #include <brick/common/functional.hh>
 #include <brick/numeric/scatteredDataInterpolator2D.hh>
@@ -37,6 +38,7 @@ namespace brick {
 
       // Tests of member functions.
       void testApproximate();
+      void testEvaluateGrid();
 
     private:
 
@@ -54,6 +56,7 @@ namespace brick {
     {
       // Register all tests.
       BRICK_TEST_REGISTER_MEMBER(testApproximate);
+      BRICK_TEST_REGISTER_MEMBER(testEvaluateGrid);
     }
 
 
@@ -140,6 +143,71 @@ namespace brick {
 
     } // testApproximate()
 
+
+    void
+    ScatteredDataInterpolator2DTest::
+    testEvaluateGrid()
+    {
+      // Arbitrary, made up, scattered data to interpolate.
+      Array2D<double> testData(
+        "[[0.1, 0.7, 4.0],"
+        " [5.5, 0.2, 6.0],"
+        " [3.0, 3.0, 1.0],"
+        " [1.2, 3.7, 0.4],"
+        " [1.2, 3.6, 1.3],"
+        " [4.2, 4.6, 6.0],"
+        " [5.7, 2.5, 5.8],"
+        " [3.1, 0.1, 2.2]]");
+      Vector2D<double> corner0(0.0, 0.0);
+      Vector2D<double> corner1(6.0, 5.0);
+      Array2D<double> sCoordArray = subArray(testData, Slice(), Slice(0, 1));
+      Array2D<double> tCoordArray = subArray(testData, Slice(), Slice(1, 2));
+      Array2D<double> valueArray = subArray(testData, Slice(), Slice(2, 3));
+
+      ScatteredDataInterpolator2D<double> scatteredDataInterpolator(6);
+      scatteredDataInterpolator.approximate(
+        sCoordArray.begin(), sCoordArray.end(), tCoordArray.begin(),
+        valueArray.begin(), corner0, corner1);
+
+      // Sample at "pixel centers" of a 60x50 image.
+      Array1D<double> sValues(60);
+      for(size_t ii = 0; ii < sValues.size(); ++ii) {
+        sValues[ii] = 0.1 * ii + 0.05;
+      }
+      Array1D<double> tValues(50);
+      for(size_t ii = 0; ii < tValues.size(); ++ii) {
+        tValues[ii] = 0.1 * ii + 0.05;
+      }
+      Array2D<double> gridResults =
+        scatteredDataInterpolator.evaluateGrid(sValues, tValues, 2);
+
+      std::vector<double> sPoints;
+      std::vector<double> tPoints;
+      for(size_t row = 0; row < tValues.size(); ++row) {
+        for(size_t column = 0; column < sValues.size(); ++column) {
+          sPoints.push_back(sValues[column]);
+          tPoints.push_back(tValues[row]);
+        }
+      }
+      std::vector<double> pointResults(sPoints.size());
+      scatteredDataInterpolator.evaluate(
+        sPoints.begin(), sPoints.end(), tPoints.begin(),
+        pointResults.begin(), 2);
+
+      for(size_t row = 0; row < tValues.size(); ++row) {
+        for(size_t column = 0; column < sValues.size(); ++column) {
+          double referenceValue =
+            scatteredDataInterpolator(sValues[column], tValues[row]);
+          BRICK_TEST_ASSERT(
+            approximatelyEqual(gridResults(row, column), referenceValue,
+                               this->m_defaultTolerance));
+          BRICK_TEST_ASSERT(
+            approximatelyEqual(pointResults[row * sValues.size() + column],
+                               referenceValue, this->m_defaultTolerance));
+        }
+      }
+    }
+
   } // namespace numeric
 
 } // namespace brick
@@ -14,6 +14,8 @@
 #define BRICK_OPTIMIZATION_GRADIENTFUNCTION_HH
 
 #include <functional>
+#include <vector>
+#include <brick/common/parallelFor.hh>
 #include <brick/numeric/derivativeRidders.hh>
 
 namespace brick {
@@ -48,6 +50,15 @@ namespace brick {
      ** Template argument Scalar specifies the precision with which
      ** internal calculations will be conducted.
      **
+     ** If the objective function is expensive, the partial
+     ** derivatives can be computed on several threads at once (see
+     ** setNumberOfThreads()).  In this case each additional thread
+     ** works with its own copy of the functor, so Functor must be
+     ** copyable, and copies must be safe to call concurrently.  The
+     ** copies are made before any thread starts, but they may share
+     ** data with the original (Array1D members, for example, copy
+     ** shallowly), so operator()() must not write to shared data.
+     **
      ** Here's a usage example:
      **
      ** @code
@@ -76,7 +87,7 @@ namespace brick {
        * divided differences with a total step size of 2 * epsilon.
        */
       GradientFunction(const Functor& functor, Scalar epsilon=1.0e-6) :
-        m_functor(functor), m_epsilon(epsilon) {
+        m_functor(functor), m_epsilon(epsilon), m_numberOfThreads(1) {
         if(epsilon == 0.0) {
           BRICK_THROW(brick::common::ValueException,
 		      "GradientFunction::GradientFunction()",
@@ -91,6 +102,18 @@ namespace brick {
       virtual ~GradientFunction() {}
 
 
+      /**
+       * This member function returns the number of threads that
+       * will be used to compute the gradient.  See
+       * setNumberOfThreads().
+       *
+       * @return The return value is the thread count, with zero
+       * meaning one thread per available processor.
+       */
+      unsigned int
+      getNumberOfThreads() const {return m_numberOfThreads;}
+
+
       /**
        * This method numerically approximates the gradient of
        * this->operator() by divided differences.  This method should
@@ -118,9 +141,39 @@ namespace brick {
         return m_functor(theta);
       }
 
+
+      /**
+       * This member function specifies how many threads should share
+       * the function evaluations of gradient().  Different elements
+       * of the gradient are computed by different threads, each
+       * using its own copy of the functor.  The calling thread
+       * always uses the functor passed to the constructor.  Thread
+       * start-up costs tens of microseconds, so this is only
+       * worthwhile when each function evaluation is expensive.
+       *
+       * @param numberOfThreads This argument specifies the number
+       * of threads.  The default, 1, evaluates everything serially
+       * on the calling thread.  Setting it to zero uses one thread
+       * per available processor.
+       */
+      void
+      setNumberOfThreads(unsigned int numberOfThreads) {
+        m_numberOfThreads = numberOfThreads;
+      }
+
     private:
+
+      // Computes partial derivatives [bandBegin, bandEnd) of the
+      // gradient at theta using the specified functor instance.
+      void
+      computePartialDerivatives(Functor& functor,
+                                const typename Functor::argument_type& theta,
+                                size_t bandBegin, size_t bandEnd,
+                                typename Functor::argument_type& result);
+
       Functor m_functor;
       Scalar m_epsilon;
+      unsigned int m_numberOfThreads;
 
     }; // class GradientFunction
 
@@ -130,7 +183,8 @@ namespace brick {
      ** GradientFunction, from which it is derived, but uses Ridders's
      ** method to estimate derivatives.  This takes about 10x as long
      ** as the naive method implemented by GradientFunction, but is
-     ** much more accurate.  See GradientFunction for more documentation.
+     ** much more accurate.  See GradientFunction for more documentation,
+     ** including setNumberOfThreads(), which applies here too.
      **/
     template <class Functor, class Scalar = double>
     class GradientFunctionRidders
@@ -176,6 +230,16 @@ namespace brick {
       typedef brick::numeric::NDimensionalFunctorAdapter<Functor, Scalar>
         FunctorAdaptor;
 
+      // Computes partial derivatives [bandBegin, bandEnd) of the
+      // gradient at theta using the specified DerivativeRidders
+      // instance.
+      void
+      computePartialDerivatives(
+        brick::numeric::DerivativeRidders<FunctorAdaptor>& ridders,
+        const typename Functor::argument_type& theta,
+        size_t bandBegin, size_t bandEnd,
+        typename Functor::argument_type& result);
+
       Scalar m_errorTolerance;
       brick::numeric::DerivativeRidders<FunctorAdaptor> m_ridders;
 
@@ -216,27 +280,65 @@ namespace brick {
     typename Functor::argument_type
     GradientFunction<Functor, Scalar>::
     gradient(const typename Functor::argument_type& theta)
+    {
+      // Return value must be a vector, too, so use argument_type.
+      typename Functor::argument_type result(theta.size());
+
+      // Each band of partial derivatives is computed independently.
+      // With only one band, this is an ordinary serial loop on the
+      // calling thread.  Extra bands get their own copies of the
+      // functor.  These are made here, before any thread starts,
+      // because copying types with shared reference counts (such as
+      // Array1D) is not safe while another thread is using the
+      // original.
+      size_t numberOfBands = brick::common::getNumberOfBands(
+        theta.size(), m_numberOfThreads);
+      std::vector<Functor> functorCopies;
+      functorCopies.reserve(numberOfBands - 1);
+      for(size_t band = 1; band < numberOfBands; ++band) {
+        functorCopies.push_back(m_functor);
+      }
+
+      brick::common::parallelFor(
+        0, theta.size(), numberOfBands,
+        [&](size_t bandBegin, size_t bandEnd, size_t bandIndex) {
+          Functor& functor = ((bandIndex == 0)
+                              ? m_functor : functorCopies[bandIndex - 1]);
+          this->computePartialDerivatives(
+            functor, theta, bandBegin, bandEnd, result);
+        });
+      return result;
+    }
+
+
+    // Compute elements [bandBegin, bandEnd) of the divided difference
+    // gradient using the specified functor.
+    template <class Functor, class Scalar>
+    void
+    GradientFunction<Functor, Scalar>::
+    computePartialDerivatives(Functor& functor,
+                              const typename Functor::argument_type& theta,
+                              size_t bandBegin, size_t bandEnd,
+                              typename Functor::argument_type& result)
     {
       // Create some vectors to use as input to operator()().
       typename Functor::argument_type thetaMinus(theta.size());
       typename Functor::argument_type thetaPlus(theta.size());
-      // Return value must be a vector, too, so use argument_type.
-      typename Functor::argument_type result(theta.size());
       // Initialize arguments.
       for(size_t index = 0; index < theta.size(); ++index) {
         thetaMinus[index] = theta[index];
         thetaPlus[index] = theta[index];
       }
       // Now compute each partial derivative.
-      for(size_t index = 0; index < theta.size(); ++index) {
+      for(size_t index = bandBegin; index < bandEnd; ++index) {
         // Set up the difference.
         thetaMinus[index] = theta[index] - m_epsilon;
         thetaPlus[index] = theta[index] + m_epsilon;
         // Compute divided difference.
         typename Functor::result_type valueMinus =
-          m_functor.operator()(thetaMinus);
+          functor.operator()(thetaMinus);
         typename Functor::result_type valuePlus =
-          m_functor.operator()(thetaPlus);
+          functor.operator()(thetaPlus);
 
         // Dodge some roundoff error by finding out precisely what the
         // difference in arguments turned out to be.
@@ -253,7 +355,6 @@ namespace brick {
         thetaMinus[index] = theta[index];
         thetaPlus[index] = theta[index];
       }
-      return result;
     }
 
 
@@ -289,12 +390,47 @@ namespace brick {
 
       // Return value must be a vector, so use argument_type.
       typename Functor::argument_type result(theta.size());
-      typename Functor::argument_type errorEstimateVector(theta.size());
       for(unsigned int ii = 0; ii < theta.size(); ++ii) {
         result[ii] = Scalar(0.0);
-        errorEstimateVector[ii] = Scalar(0.0);
       }
 
+      // As in GradientFunction::gradient(), bands of partial
+      // derivatives are independent.  DerivativeRidders copies
+      // deeply, so each extra band gets its own tableau and functor.
+      // The copies are made before any thread starts, since band 0
+      // modifies m_ridders.
+      size_t numberOfBands = brick::common::getNumberOfBands(
+        theta.size(), this->getNumberOfThreads());
+      std::vector< brick::numeric::DerivativeRidders<FunctorAdaptor> >
+        riddersCopies;
+      riddersCopies.reserve(numberOfBands - 1);
+      for(size_t band = 1; band < numberOfBands; ++band) {
+        riddersCopies.push_back(m_ridders);
+      }
+
+      brick::common::parallelFor(
+        0, theta.size(), numberOfBands,
+        [&](size_t bandBegin, size_t bandEnd, size_t bandIndex) {
+          brick::numeric::DerivativeRidders<FunctorAdaptor>& ridders =
+            ((bandIndex == 0) ? m_ridders : riddersCopies[bandIndex - 1]);
+          this->computePartialDerivatives(
+            ridders, theta, bandBegin, bandEnd, result);
+        });
+      return result;
+    }
+
+
+    // Compute elements [bandBegin, bandEnd) of the gradient using
+    // the specified DerivativeRidders instance.
+    template <class Functor, class Scalar>
+    void
+    GradientFunctionRidders<Functor, Scalar>::
+    computePartialDerivatives(
+      brick::numeric::DerivativeRidders<FunctorAdaptor>& ridders,
+      const typename Functor::argument_type& theta,
+      size_t bandBegin, size_t bandEnd,
+      typename Functor::argument_type& result)
+    {
       // Make a local copy of theta that we can change with impunity.
       typename Functor::argument_type zeroPoint(theta.size());
       for(size_t index = 0; index < theta.size(); ++index) {
@@ -302,7 +438,7 @@ namespace brick {
       }
 
       // Compute each partial derivative.
-      for(size_t index = 0; index < theta.size(); ++index) {
+      for(size_t index = bandBegin; index < bandEnd; ++index) {
 
         // Adjust bound upward, if allowable.
         if(m_stepBounds[index] < m_maxStepBound) {
@@ -314,23 +450,22 @@ namespace brick {
 
         // Loop until good result.
         while(1) {
-          // We want m_ridders to evaluate gradient around theta, but
+          // We want ridders to evaluate gradient around theta, but
           // we can't just use theta as the zero point because that
           // would mean evaluating the adapted (1D) functor around
-          // 0.0, which would fake out m_ridders when it's trying to
+          // 0.0, which would fake out ridders when it's trying to
           // assess the scale of theta, leading to a numerically less
           // acceptable result.  For this reason, we zero out the
-          // index'th element of zeroPoint, and then tell m_ridders to
+          // index'th element of zeroPoint, and then tell ridders to
           // evaluate around theta[index].
           zeroPoint[index] = 0.0;
 
           Scalar errorValue;
-          m_ridders.getFunctor().setTargetDimension(index);
-          m_ridders.getFunctor().setZeroPoint(zeroPoint);
-          m_ridders.setStepBound(m_stepBounds[index]);
-          result[index] = m_ridders.estimateDerivative(
+          ridders.getFunctor().setTargetDimension(index);
+          ridders.getFunctor().setZeroPoint(zeroPoint);
+          ridders.setStepBound(m_stepBounds[index]);
+          result[index] = ridders.estimateDerivative(
             theta[index], errorValue);
-          errorEstimateVector[index] = errorValue;
 
           // Fix our change to zeroPoint.
           zeroPoint[index] = theta[index];
@@ -338,12 +473,15 @@ namespace brick {
           if(errorValue > m_errorTolerance) {
             m_stepBounds[index] /= 10.0;
             if(m_stepBounds[index] < m_minStepBound) {
+              // Other bands may still be running, so only report
+              // on the element this band owns.
               std::ostringstream message;
-              message << "Out-of-bounds error reported by DerivativeRidders.\n"
+              message << "Out-of-bounds error reported by DerivativeRidders "
+                      << "for element " << index << ".\n"
                       << "Theta is " << theta << "\n"
-                      << "Result (so far) is " << result << "\n"
-                      << "StepBounds are: " << m_stepBounds << "\n"
-                      << "Reported error is " << errorEstimateVector;
+                      << "Last step bound tried was "
+                      << 10.0 * m_stepBounds[index] << "\n"
+                      << "Reported error is " << errorValue;
               BRICK_THROW(brick::common::ValueException,
 			  "GradientFunctionRidders::gradient()",
 			  message.str().c_str());
@@ -354,7 +492,6 @@ namespace brick {
           break;
         }
       }
-      return result;
     }
 
   } // namespace optimization
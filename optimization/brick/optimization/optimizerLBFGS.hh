@@ -0,0 +1,1396 @@
+/**
+***************************************************************************
+* @file brick/optimization/optimizerLBFGS.hh
+*
+* Header file declaring OptimizerLBFGS class.
+*
+* (C) Copyright 2026 David LaRose, dlr@cs.cmu.edu
+* See accompanying LICENSE file for details.
+*
+***************************************************************************
+**/
+
+#ifndef BRICK_OPTIMIZATION_OPTIMIZERLBFGS_HH
+#define BRICK_OPTIMIZATION_OPTIMIZERLBFGS_HH
+
+#include <limits>
+#include <vector>
+#include <brick/common/mathFunctions.hh>
+#include <brick/common/triple.hh>
+#include <brick/numeric/array2D.hh>
+#include <brick/optimization/optimizer.hh>
+
+namespace brick {
+
+  namespace optimization {
+
+    /**
+     ** OptimizerLBFGS implements the limited-memory variant of the
+     ** Broyden, Fletcher, Goldfarb, and Shanno Quasi-Newton method,
+     ** as described in [1].  Rather than maintaining a dense estimate
+     ** of the inverse Hessian, as OptimizerBFGS does, it keeps only
+     ** the last few parameter and gradient changes, and applies the
+     ** inverse Hessian estimate implicitly using the "two-loop
+     ** recursion."  Memory and time per iteration are therefore
+     ** O(m * N), where N is the number of parameters and m is the
+     ** number of stored changes, rather than O(N^2), making this
+     ** class suitable for problems with tens of thousands of
+     ** parameters or more.
+     **
+     ** Each iteration uses a line search satisfying the strong Wolfe
+     ** conditions [2], which guarantees that the inverse Hessian
+     ** estimate remains positive definite.
+     **
+     ** Optionally, lower and upper bounds can be placed on each
+     ** parameter.  In this case, parameters that are at a bound, and
+     ** whose gradient points out of the feasible region, are held
+     ** fixed for the iteration, the search direction is computed for
+     ** the remaining parameters, and a backtracking line search is
+     ** performed along the path obtained by projecting each trial
+     ** point back into the feasible region.  This is a simplified
+     ** form of the L-BFGS-B algorithm [3], without its generalized
+     ** Cauchy point computation.
+     **
+     ** The template parameter (Functor) defines the type to use as the
+     ** objective function of the minimization, and must support the
+     ** GradientFunction interface.
+     **
+     ** [1] J. Nocedal, Updating Quasi-Newton Matrices with Limited
+     ** Storage, Mathematics of Computation, 35(151):773-782, 1980.
+     **
+     ** [2] J. Nocedal and S. J. Wright, Numerical Optimization,
+     ** Springer, 1999.  Algorithms 3.5 and 3.6.
+     **
+     ** [3] R. H. Byrd, P. Lu, J. Nocedal and C. Zhu, A Limited Memory
+     ** Algorithm for Bound Constrained Optimization, SIAM Journal on
+     ** Scientific Computing, 16(5):1190-1208, 1995.
+     **/
+    template <class Functor, class FloatType = double>
+    class OptimizerLBFGS
+      : public Optimizer<Functor>
+    {
+    public:
+      // Typedefs for convenience
+      typedef typename Functor::argument_type argument_type;
+      typedef typename Functor::result_type result_type;
+
+      /**
+       * The default constructor sets parameters to reasonable values
+       * for functions which take values and arguments in the "normal"
+       * range of 0 to 100 or so.
+       */
+      OptimizerLBFGS();
+
+      /**
+       * This constructor specifies the specific Functor instance to
+       * use.  Using this constructor exclusively avoids the danger of
+       * calling optimalValue() or optimum() before a Functor instance
+       * has been specified.
+       *
+       * @param functor A copy of this argument will be stored
+       * internally for use in optimization.
+       */
+      explicit OptimizerLBFGS(const Functor& functor);
+
+      /**
+       * Copy constructor.  This constructor simply copies the source
+       * argument.
+       *
+       * @param source The OptimizerLBFGS instance to be copied.
+       */
+      OptimizerLBFGS(const OptimizerLBFGS& source);
+
+      /**
+       * The destructor destroys the class instance and deallocates any
+       * associated storage.
+       */
+      virtual
+      ~OptimizerLBFGS();
+
+      /**
+       * This member function removes any bounds previously set using
+       * setBounds().
+       */
+      virtual void
+      clearBounds();
+
+      /**
+       * This method returns the number of function calls required to
+       * complete the previous minimization.  If the minimization
+       * parameter "restarts" is 0, there will be only one element in
+       * the returned vector.  If restarts is greater than 0, the first
+       * element of the return value will reflect the number of function
+       * calls in the initial minimization, and subsequent numbers will
+       * reflect the number of function calls in the following restarted
+       * minimizations.  If a valid minimization has not been performed
+       * since the last update to startPoint, parameters, etc., then the
+       * return value will be an empty vector.
+       *
+       * @return a vector of function call counts.
+       */
+      virtual std::vector<size_t>
+      getNumberOfFunctionCalls() {return this->m_functionCallCount;}
+
+      /**
+       * This method returns the number of gradient calls required to
+       * complete the previous minimization.  The return value is
+       * organized just like that of getNumberOfFunctionCalls().
+       *
+       * @return a vector of gradient call counts.
+       */
+      virtual std::vector<size_t>
+      getNumberOfGradientCalls() {return this->m_gradientCallCount;}
+
+      /**
+       * This method returns the number of iterations required to
+       * complete the previous minimization.  The return value is
+       * organized just like that of getNumberOfFunctionCalls().
+       *
+       * @return a vector of iteration counts.
+       */
+      virtual std::vector<size_t>
+      getNumberOfIterations() {return this->m_iterationCount;}
+
+      /**
+       * This method restricts the search to a box in parameter
+       * space.  If the start point lies outside the box, it will be
+       * moved to the nearest point inside the box before the
+       * minimization begins.
+       *
+       * @param lowerBounds This argument specifies the smallest
+       * allowable value of each parameter.  Use
+       * -std::numeric_limits<FloatType>::max() for parameters with
+       * no lower bound.
+       *
+       * @param upperBounds This argument specifies the largest
+       * allowable value of each parameter.  Use
+       * std::numeric_limits<FloatType>::max() for parameters with no
+       * upper bound.  It must have the same size as lowerBounds, and
+       * each element must be no smaller than the corresponding
+       * element of lowerBounds.
+       */
+      virtual void
+      setBounds(const argument_type& lowerBounds,
+                const argument_type& upperBounds);
+
+      /**
+       * This method sets the optimization parameter controlling the
+       * maximum number of iterations, without affecting any other
+       * optimization parameters.
+       *
+       * @param iterationLimit Each minimization will terminate after
+       * this many iterations.
+       */
+      virtual void
+      setIterationLimit(size_t iterationLimit) {
+        this->m_iterationLimit = iterationLimit;
+      }
+
+      /**
+       * This method sets the number of parameter and gradient changes
+       * retained from previous iterations, without affecting any
+       * other optimization parameters.
+       *
+       * @param memorySize This argument is the number of changes to
+       * keep.  Values between 3 and 20 are typical.
+       */
+      virtual void
+      setMemorySize(size_t memorySize);
+
+      /**
+       * This method sets the optimization parameter controlling the
+       * function value at which the optimization will be considered
+       * "close enough."
+       *
+       * @param minimumFunctionValue Iteration will terminate if the
+       * objective function value falls to or below this value.
+       */
+      virtual void
+      setMinimumFunctionValue(FloatType minimumFunctionValue) {
+        this->m_minimumFunctionValue = minimumFunctionValue;
+      }
+
+      /**
+       * This method sets the optimization parameter controlling the
+       * number of restarts, without affecting any other optimization
+       * parameters.
+       *
+       * @param numberOfRestarts Following successful termination, the
+       * minimization will be re-run this many times, discarding the
+       * stored history, to refine the result accuracy.
+       */
+      virtual void
+      setNumberOfRestarts(size_t numberOfRestarts) {
+        this->m_numberOfRestarts = numberOfRestarts;
+      }
+
+      /**
+       * This method sets minimization parameters.  Default values are
+       * reasonable for functions which take values and arguments in the
+       * "normal" range of 0 to 100 or so.
+       *
+       * @param iterationLimit Each minimization will terminate after
+       * this many iterations.
+       *
+       * @param numberOfRestarts Following successful termination, the
+       * minimization will be re-run this many times to refine the
+       * result accuracy.
+       *
+       * @param memorySize This argument specifies how many parameter
+       * and gradient changes are retained from previous iterations.
+       *
+       * @param argumentTolerance Iteration will terminate when a
+       * minimization step moves, along every axis, a distance less than
+       * this factor times the corresponding element of the argument
+       * vector.
+       *
+       * @param gradientTolerance Iteration will terminate when the
+       * magnitude of the gradient times the magnitude of the parameter
+       * vector becomes smaller than the function value by this factor.
+       *
+       * @param lineSearchAlpha This argument specifies the fraction
+       * of the decrease predicted by the directional derivative that
+       * each line search must achieve (the sufficient decrease
+       * condition).
+       *
+       * @param lineSearchBeta This argument specifies how much each
+       * line search must reduce the magnitude of the directional
+       * derivative (the curvature condition).  It must be larger than
+       * lineSearchAlpha and smaller than 1.0.
+       *
+       * @param minimumFunctionValue Iteration will terminate if the
+       * objective function value falls to or below this value.
+       */
+      virtual void
+      setParameters(size_t iterationLimit = 1000,
+                    size_t numberOfRestarts = 0,
+                    size_t memorySize = 8,
+                    FloatType argumentTolerance = 1.2E-7,
+                    FloatType gradientTolerance = 0.00001,
+                    FloatType lineSearchAlpha = 1.0E-4,
+                    FloatType lineSearchBeta = 0.9,
+                    FloatType minimumFunctionValue =
+                      -std::numeric_limits<FloatType>::max());
+
+      /**
+       * This method sets the initial conditions for the minimization.
+       * Gradient based search will start at this location in parameter
+       * space.
+       *
+       * @param startPoint Indicates a point in the parameter space of
+       * the objective function.
+       */
+      virtual void
+      setStartPoint(const typename Functor::argument_type& startPoint);
+
+      /**
+       * This method sets the amount of text printed to the standard
+       * output during the optimization.
+       *
+       * @param verbosity This argument indicates the desired output
+       * level.  Setting verbosity to zero mean that no standard output
+       * should be generated.  Higher numbers indicate increasingly more
+       * output.
+       */
+      virtual void
+      setVerbosity(int verbosity) {this->m_verbosity = verbosity;}
+
+      /**
+       * Assignment operator.
+       *
+       * @param source The OptimizerLBFGS instance to be copied.
+       *
+       * @return Reference to *this.
+       */
+      virtual OptimizerLBFGS&
+      operator=(const OptimizerLBFGS& source);
+
+    protected:
+
+      /**
+       * This protected member function computes the search direction
+       * using the two-loop recursion.  Only parameters for which
+       * isFree is nonzero participate, and the returned direction is
+       * zero for all other parameters.
+       *
+       * @param gradient This argument is the current gradient.
+       *
+       * @param isFree This argument indicates which parameters may
+       * move.
+       *
+       * @param sHistory Each row of this argument holds a stored
+       * parameter change.
+       *
+       * @param yHistory Each row of this argument holds a stored
+       * gradient change.
+       *
+       * @param rhoHistory Each element of this argument holds the
+       * reciprocal of the dot product of the corresponding rows of
+       * sHistory and yHistory.
+       *
+       * @param historyStart This argument is the row index of the
+       * oldest stored change.
+       *
+       * @param historySize This argument is the number of stored
+       * changes.
+       *
+       * @param direction This argument returns the search direction.
+       */
+      void
+      computeDirection(const argument_type& gradient,
+                       const std::vector<char>& isFree,
+                       const brick::numeric::Array2D<FloatType>& sHistory,
+                       const brick::numeric::Array2D<FloatType>& yHistory,
+                       const std::vector<FloatType>& rhoHistory,
+                       size_t historyStart, size_t historySize,
+                       std::vector<FloatType>& direction);
+
+      /**
+       * This protected member function appends a new parameter
+       * change and gradient change to the stored history, discarding
+       * the oldest stored pair if the history is full.  The new pair
+       * is rejected, leaving the history untouched, if its curvature
+       * (the dot product of sNew and yNew) isn't positive.
+       *
+       * @param sNew This argument is the new parameter change.
+       *
+       * @param yNew This argument is the new gradient change.
+       *
+       * @param sHistory Each row of this argument holds a stored
+       * parameter change.
+       *
+       * @param yHistory Each row of this argument holds a stored
+       * gradient change.
+       *
+       * @param rhoHistory Each element of this argument holds the
+       * reciprocal of the dot product of the corresponding rows of
+       * sHistory and yHistory.
+       *
+       * @param historyStart This argument is the row index of the
+       * oldest stored change.  It will be updated if the oldest
+       * change is discarded.
+       *
+       * @param historySize This argument is the number of stored
+       * changes.  It will be updated if the new pair is accepted.
+       *
+       * @return The return value is true if the new pair was added
+       * to the history, false otherwise.
+       */
+      bool
+      updateHistory(const std::vector<FloatType>& sNew,
+                    const std::vector<FloatType>& yNew,
+                    brick::numeric::Array2D<FloatType>& sHistory,
+                    brick::numeric::Array2D<FloatType>& yHistory,
+                    std::vector<FloatType>& rhoHistory,
+                    size_t& historyStart, size_t& historySize);
+
+      /**
+       * Perform one complete L-BFGS minimization, starting from the
+       * specified position.
+       *
+       * @param theta This argument specifies the point at which to
+       * start the minimization.
+       *
+       * @param startValue This argument should be set to the value of
+       * the objective function evaluated at theta.
+       *
+       * @param startGradient This argument should be set to the objective
+       * function gradient evaluated at theta.
+       *
+       * @param numberOfFunctionCalls This parameter is used to return
+       * the number of function calls required to perform the
+       * minimization.
+       *
+       * @param numberOfGradientCalls This parameter is used to return
+       * the number of gradient calls required to perform the
+       * minimization.
+       *
+       * @param numberOfIterations This parameter is used to return the
+       * number of iterations required to perform the minimization.
+       *
+       * @return A brick::triple of the vector parameter which brings the
+       * specified Functor to an optimum, and the corresponding optimal
+       * Functor value, and the corresponding gradient.
+       */
+      brick::common::Triple<typename Functor::argument_type,
+                            typename Functor::result_type,
+                            typename Functor::argument_type>
+      doLbfgs(const argument_type& theta,
+              const result_type& startValue,
+              const argument_type& startGradient,
+              size_t& numberOfFunctionCalls,
+              size_t& numberOfGradientCalls,
+              size_t& numberOfIterations);
+
+      /**
+       * This protected member function is used to asses whether the
+       * algorithm has reached convergence.  Gradient elements for
+       * parameters that are not free are ignored.
+       *
+       * @param theta This argument specifies the parameter values
+       * (arguments to the objective function) being assessed.
+       *
+       * @param value This argument specifies the function value at the
+       * point described by theta.
+       *
+       * @param gradient This argument specifies the function gradient
+       * at the point described by theta.
+       *
+       * @param isFree This argument indicates which parameters may
+       * move.
+       *
+       * @return The return value gets progressively smaller as we
+       * approach a local minimum.
+       */
+      FloatType
+      gradientConvergenceMetric(const argument_type& theta,
+                                const result_type& value,
+                                const argument_type& gradient,
+                                const std::vector<char>& isFree);
+
+      /**
+       * This protected member function performs a backtracking line
+       * search along the projection of the ray (theta + alpha *
+       * direction) onto the feasible region.  It is used only when
+       * bounds have been set.
+       *
+       * @return The return value is true if a point satisfying the
+       * sufficient decrease condition was found, in which case
+       * thetaNew, valueNew, and gradientNew are set to that point,
+       * and the corresponding function value and gradient.
+       */
+      bool
+      lineSearchProjected(const argument_type& theta,
+                          const result_type& value,
+                          const argument_type& gradient,
+                          const std::vector<FloatType>& direction,
+                          FloatType initialStep,
+                          argument_type& thetaNew,
+                          result_type& valueNew,
+                          argument_type& gradientNew,
+                          size_t& numberOfFunctionCalls,
+                          size_t& numberOfGradientCalls);
+
+      /**
+       * This protected member function performs a line search along
+       * the ray (theta + alpha * direction), returning a point that
+       * satisfies the strong Wolfe conditions, or failing that, the
+       * lowest point found that satisfies the sufficient decrease
+       * condition.
+       *
+       * @return The return value is true if an acceptable point was
+       * found, in which case thetaNew, valueNew, and gradientNew are
+       * set to that point, and the corresponding function value and
+       * gradient.
+       */
+      bool
+      lineSearchWolfe(const argument_type& theta,
+                      const result_type& value,
+                      const argument_type& gradient,
+                      const std::vector<FloatType>& direction,
+                      FloatType initialStep,
+                      argument_type& thetaNew,
+                      result_type& valueNew,
+                      argument_type& gradientNew,
+                      size_t& numberOfFunctionCalls,
+                      size_t& numberOfGradientCalls);
+
+      /**
+       * Perform the optimization.  This virtual function overrides the
+       * definition in Optimizer.
+       *
+       * @return A std::pair of the vector parameter which brings the
+       * specified Functor to an optimum, and the corresponding optimal
+       * Functor value.
+       */
+      virtual
+      std::pair<typename Functor::argument_type, typename Functor::result_type>
+      run();
+
+      // Data members.
+      FloatType m_argumentTolerance;
+      FloatType m_gradientTolerance;
+      size_t m_iterationLimit;
+      FloatType m_lineSearchAlpha;
+      FloatType m_lineSearchBeta;
+      argument_type m_lowerBounds;
+      size_t m_memorySize;
+      FloatType m_minimumFunctionValue;
+      size_t m_numberOfRestarts;
+      argument_type m_startPoint;
+      argument_type m_upperBounds;
+      int m_verbosity;
+
+      // Data members used for bookkeeping.
+      std::vector<size_t> m_functionCallCount;
+      std::vector<size_t> m_gradientCallCount;
+      std::vector<size_t> m_iterationCount;
+
+    }; // class OptimizerLBFGS
+
+  } // namespace optimization
+
+} // namespace brick
+
+
+/*******************************************************************
+ * Member function definitions follow.  This would be a .cpp file
+ * if it weren't templated.
+ *******************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <brick/optimization/optimizerCommon.hh>
+
+namespace brick {
+
+  namespace optimization {
+
+    template <class Functor, class FloatType>
+    OptimizerLBFGS<Functor, FloatType>::
+    OptimizerLBFGS()
+      : Optimizer<Functor>(),
+        m_argumentTolerance(),
+        m_gradientTolerance(),
+        m_iterationLimit(),
+        m_lineSearchAlpha(),
+        m_lineSearchBeta(),
+        m_lowerBounds(),
+        m_memorySize(),
+        m_minimumFunctionValue(),
+        m_numberOfRestarts(),
+        m_startPoint(),
+        m_upperBounds(),
+        m_verbosity(0),
+        m_functionCallCount(),
+        m_gradientCallCount(),
+        m_iterationCount()
+    {
+      this->setParameters();
+    }
+
+
+    template <class Functor, class FloatType>
+    OptimizerLBFGS<Functor, FloatType>::
+    OptimizerLBFGS(const Functor& functor)
+      : Optimizer<Functor>(functor),
+        m_argumentTolerance(),
+        m_gradientTolerance(),
+        m_iterationLimit(),
+        m_lineSearchAlpha(),
+        m_lineSearchBeta(),
+        m_lowerBounds(),
+        m_memorySize(),
+        m_minimumFunctionValue(),
+        m_numberOfRestarts(),
+        m_startPoint(),
+        m_upperBounds(),
+        m_verbosity(0),
+        m_functionCallCount(),
+        m_gradientCallCount(),
+        m_iterationCount()
+    {
+      this->setParameters();
+    }
+
+
+    template<class Functor, class FloatType>
+    OptimizerLBFGS<Functor, FloatType>::
+    OptimizerLBFGS(const OptimizerLBFGS& source)
+      : Optimizer<Functor>(source),
+        m_argumentTolerance(source.m_argumentTolerance),
+        m_gradientTolerance(source.m_gradientTolerance),
+        m_iterationLimit(source.m_iterationLimit),
+        m_lineSearchAlpha(source.m_lineSearchAlpha),
+        m_lineSearchBeta(source.m_lineSearchBeta),
+        m_lowerBounds(source.m_lowerBounds.size()),
+        m_memorySize(source.m_memorySize),
+        m_minimumFunctionValue(source.m_minimumFunctionValue),
+        m_numberOfRestarts(source.m_numberOfRestarts),
+        m_startPoint(source.m_startPoint.size()),
+        m_upperBounds(source.m_upperBounds.size()),
+        m_verbosity(source.m_verbosity),
+        m_functionCallCount(source.m_functionCallCount),
+        m_gradientCallCount(source.m_gradientCallCount),
+        m_iterationCount(source.m_iterationCount)
+    {
+      copyArgumentType(source.m_lowerBounds, this->m_lowerBounds);
+      copyArgumentType(source.m_startPoint, this->m_startPoint);
+      copyArgumentType(source.m_upperBounds, this->m_upperBounds);
+    }
+
+
+    template <class Functor, class FloatType>
+    OptimizerLBFGS<Functor, FloatType>::
+    ~OptimizerLBFGS()
+    {
+      // Empty
+    }
+
+
+    template<class Functor, class FloatType>
+    void
+    OptimizerLBFGS<Functor, FloatType>::
+    clearBounds()
+    {
+      this->m_lowerBounds = argument_type();
+      this->m_upperBounds = argument_type();
+      this->m_functionCallCount.clear();
+      this->m_gradientCallCount.clear();
+      this->m_iterationCount.clear();
+      Optimizer<Functor>::m_needsOptimization = true;
+    }
+
+
+    template<class Functor, class FloatType>
+    void
+    OptimizerLBFGS<Functor, FloatType>::
+    setBounds(const argument_type& lowerBounds,
+              const argument_type& upperBounds)
+    {
+      if(lowerBounds.size() != upperBounds.size()) {
+        BRICK_THROW(brick::common::ValueException,
+                    "OptimizerLBFGS<Functor, FloatType>::setBounds()",
+                    "Arguments lowerBounds and upperBounds must have the "
+                    "same size.");
+      }
+      for(size_t index = 0; index < lowerBounds.size(); ++index) {
+        if(!(lowerBounds[index] <= upperBounds[index])) {
+          std::ostringstream message;
+          message << "Lower bound (" << lowerBounds[index]
+                  << ") exceeds upper bound (" << upperBounds[index]
+                  << ") for parameter " << index << ".";
+          BRICK_THROW(brick::common::ValueException,
+                      "OptimizerLBFGS<Functor, FloatType>::setBounds()",
+                      message.str().c_str());
+        }
+      }
+      copyArgumentType(lowerBounds, this->m_lowerBounds);
+      copyArgumentType(upperBounds, this->m_upperBounds);
+
+      // Reset memory of previous minimization.
+      this->m_functionCallCount.clear();
+      this->m_gradientCallCount.clear();
+      this->m_iterationCount.clear();
+      Optimizer<Functor>::m_needsOptimization = true;
+    }
+
+
+    template<class Functor, class FloatType>
+    void
+    OptimizerLBFGS<Functor, FloatType>::
+    setMemorySize(size_t memorySize)
+    {
+      if(memorySize == 0) {
+        BRICK_THROW(brick::common::ValueException,
+                    "OptimizerLBFGS<Functor, FloatType>::setMemorySize()",
+                    "Argument memorySize must be nonzero.");
+      }
+      this->m_memorySize = memorySize;
+      Optimizer<Functor>::m_needsOptimization = true;
+    }
+
+
+    template<class Functor, class FloatType>
+    void
+    OptimizerLBFGS<Functor, FloatType>::
+    setParameters(size_t iterationLimit,
+                  size_t numberOfRestarts,
+                  size_t memorySize,
+                  FloatType argumentTolerance,
+                  FloatType gradientTolerance,
+                  FloatType lineSearchAlpha,
+                  FloatType lineSearchBeta,
+                  FloatType minimumFunctionValue)
+    {
+      if(!(lineSearchAlpha > 0.0 && lineSearchAlpha < lineSearchBeta
+           && lineSearchBeta < 1.0)) {
+        BRICK_THROW(brick::common::ValueException,
+                    "OptimizerLBFGS<Functor, FloatType>::setParameters()",
+                    "Line search parameters must satisfy "
+                    "0 < lineSearchAlpha < lineSearchBeta < 1.");
+      }
+
+      // Copy input arguments.
+      this->m_iterationLimit = iterationLimit;
+      this->m_numberOfRestarts = numberOfRestarts;
+      this->setMemorySize(memorySize);
+      this->m_argumentTolerance = argumentTolerance;
+      this->m_gradientTolerance = gradientTolerance;
+      this->m_lineSearchAlpha = lineSearchAlpha;
+      this->m_lineSearchBeta = lineSearchBeta;
+      this->m_minimumFunctionValue = minimumFunctionValue;
+
+      // Reset memory of previous minimization.
+      this->m_functionCallCount.clear();
+      this->m_gradientCallCount.clear();
+      this->m_iterationCount.clear();
+
+      // We've changed the parameters, so we'll have to rerun the
+      // optimization.  Indicate this by setting the inherited member
+      // m_needsOptimization.
+      Optimizer<Functor>::m_needsOptimization = true;
+    }
+
+
+    template<class Functor, class FloatType>
+    void
+    OptimizerLBFGS<Functor, FloatType>::
+    setStartPoint(const typename Functor::argument_type& startPoint)
+    {
+      copyArgumentType(startPoint, this->m_startPoint);
+
+      // Reset memory of previous minimization.
+      this->m_functionCallCount.clear();
+      this->m_gradientCallCount.clear();
+      this->m_iterationCount.clear();
+
+      // We've changed the parameters, so we'll have to rerun the
+      // optimization.  Indicate this by setting the inherited member
+      // m_needsOptimization.
+      Optimizer<Functor>::m_needsOptimization = true;
+    }
+
+
+    template<class Functor, class FloatType>
+    OptimizerLBFGS<Functor, FloatType>&
+    OptimizerLBFGS<Functor, FloatType>::
+    operator=(const OptimizerLBFGS<Functor, FloatType>& source)
+    {
+      Optimizer<Functor>::operator=(source);
+      this->m_argumentTolerance = source.m_argumentTolerance;
+      this->m_gradientTolerance = source.m_gradientTolerance;
+      this->m_iterationLimit = source.m_iterationLimit;
+      this->m_lineSearchAlpha = source.m_lineSearchAlpha;
+      this->m_lineSearchBeta = source.m_lineSearchBeta;
+      copyArgumentType(source.m_lowerBounds, this->m_lowerBounds);
+      this->m_memorySize = source.m_memorySize;
+      this->m_minimumFunctionValue = source.m_minimumFunctionValue;
+      this->m_numberOfRestarts = source.m_numberOfRestarts;
+      copyArgumentType(source.m_startPoint, this->m_startPoint);
+      copyArgumentType(source.m_upperBounds, this->m_upperBounds);
+      this->m_verbosity = source.m_verbosity;
+
+      this->m_functionCallCount = source.m_functionCallCount;
+      this->m_gradientCallCount = source.m_gradientCallCount;
+      this->m_iterationCount = source.m_iterationCount;
+
+      return *this;
+    }
+
+
+    // =============== Protected member functions below =============== //
+
+    template <class Functor, class FloatType>
+    void
+    OptimizerLBFGS<Functor, FloatType>::
+    computeDirection(const argument_type& gradient,
+                     const std::vector<char>& isFree,
+                     const brick::numeric::Array2D<FloatType>& sHistory,
+                     const brick::numeric::Array2D<FloatType>& yHistory,
+                     const std::vector<FloatType>& rhoHistory,
+                     size_t historyStart, size_t historySize,
+                     std::vector<FloatType>& direction)
+    {
+      size_t const dimensionality = gradient.size();
+      size_t const memorySize = sHistory.rows();
+      std::vector<FloatType> alphas(historySize);
+
+      // Start with the (negative) gradient of the free parameters.
+      for(size_t index = 0; index < dimensionality; ++index) {
+        direction[index] = isFree[index] ? -gradient[index] : FloatType(0);
+      }
+
+      // First loop runs from newest to oldest.
+      for(size_t count = historySize; count > 0; --count) {
+        size_t row = (historyStart + count - 1) % memorySize;
+        FloatType const* sPtr = sHistory.data(row, 0);
+        FloatType const* yPtr = yHistory.data(row, 0);
+        FloatType dotProduct = 0.0;
+        for(size_t index = 0; index < dimensionality; ++index) {
+          dotProduct += sPtr[index] * direction[index];
+        }
+        FloatType alpha = rhoHistory[row] * dotProduct;
+        alphas[count - 1] = alpha;
+        for(size_t index = 0; index < dimensionality; ++index) {
+          if(isFree[index]) {
+            direction[index] -= alpha * yPtr[index];
+          }
+        }
+      }
+
+      // Scale by the usual estimate of the inverse Hessian diagonal,
+      // based on the most recent change.
+      if(historySize != 0) {
+        size_t row = (historyStart + historySize - 1) % memorySize;
+        FloatType const* yPtr = yHistory.data(row, 0);
+        FloatType yDotY = 0.0;
+        for(size_t index = 0; index < dimensionality; ++index) {
+          yDotY += yPtr[index] * yPtr[index];
+        }
+        FloatType gamma = 1.0 / (rhoHistory[row] * yDotY);
+        for(size_t index = 0; index < dimensionality; ++index) {
+          direction[index] *= gamma;
+        }
+      }
+
+      // Second loop runs from oldest to newest.
+      for(size_t count = 0; count < historySize; ++count) {
+        size_t row = (historyStart + count) % memorySize;
+        FloatType const* sPtr = sHistory.data(row, 0);
+        FloatType const* yPtr = yHistory.data(row, 0);
+        FloatType dotProduct = 0.0;
+        for(size_t index = 0; index < dimensionality; ++index) {
+          dotProduct += yPtr[index] * direction[index];
+        }
+        FloatType beta = rhoHistory[row] * dotProduct;
+        FloatType coefficient = alphas[count] - beta;
+        for(size_t index = 0; index < dimensionality; ++index) {
+          if(isFree[index]) {
+            direction[index] += coefficient * sPtr[index];
+          }
+        }
+      }
+    }
+
+
+    template <class Functor, class FloatType>
+    bool
+    OptimizerLBFGS<Functor, FloatType>::
+    updateHistory(const std::vector<FloatType>& sNew,
+                  const std::vector<FloatType>& yNew,
+                  brick::numeric::Array2D<FloatType>& sHistory,
+                  brick::numeric::Array2D<FloatType>& yHistory,
+                  std::vector<FloatType>& rhoHistory,
+                  size_t& historyStart, size_t& historySize)
+    {
+      size_t const dimensionality = sNew.size();
+      size_t const memorySize = sHistory.rows();
+
+      // Test curvature before touching the history.  Once the
+      // history is full, the row that would receive the new pair
+      // still holds the oldest stored pair, which must stay intact
+      // if the new pair is rejected.
+      FloatType sDotY = 0.0;
+      FloatType yDotY = 0.0;
+      for(size_t index = 0; index < dimensionality; ++index) {
+        sDotY += sNew[index] * yNew[index];
+        yDotY += yNew[index] * yNew[index];
+      }
+      if(!(sDotY > std::numeric_limits<FloatType>::epsilon() * yDotY)) {
+        return false;
+      }
+
+      size_t row = (historyStart + historySize) % memorySize;
+      std::copy(sNew.begin(), sNew.end(), sHistory.data(row, 0));
+      std::copy(yNew.begin(), yNew.end(), yHistory.data(row, 0));
+      rhoHistory[row] = 1.0 / sDotY;
+      if(historySize < memorySize) {
+        ++historySize;
+      } else {
+        historyStart = (historyStart + 1) % memorySize;
+      }
+      return true;
+    }
+
+
+    template <class Functor, class FloatType>
+    brick::common::Triple<typename Functor::argument_type,
+                          typename Functor::result_type,
+                          typename Functor::argument_type>
+    OptimizerLBFGS<Functor, FloatType>::
+    doLbfgs(const argument_type& theta,
+            const result_type& startValue,
+            const argument_type& startGradient,
+            size_t& numberOfFunctionCalls,
+            size_t& numberOfGradientCalls,
+            size_t& numberOfIterations)
+    {
+      // Basic initializations.
+      size_t const dimensionality = theta.size();
+      bool const isBounded = (this->m_lowerBounds.size() != 0);
+      numberOfFunctionCalls = 0;
+      numberOfGradientCalls = 0;
+      numberOfIterations = 0;
+
+      argument_type thetaLocal(dimensionality);
+      copyArgumentType(theta, thetaLocal);
+      result_type currentValue = startValue;
+      argument_type currentGradient(dimensionality);
+      copyArgumentType(startGradient, currentGradient);
+
+      // Check that gradient dimension is correct.
+      if(currentGradient.size() != dimensionality) {
+        std::ostringstream message;
+        message << "startPoint has dimensionality " << dimensionality
+                << " but objective function returns gradient with "
+                << "dimensionality " << currentGradient.size() << ".";
+        BRICK_THROW(brick::common::ValueException,
+                    "OptimizerLBFGS<Functor, FloatType>::doLbfgs()",
+                    message.str().c_str());
+      }
+
+      // Storage for the most recent parameter changes (s) and
+      // gradient changes (y), kept as a ring buffer.
+      size_t const memorySize = this->m_memorySize;
+      brick::numeric::Array2D<FloatType> sHistory(memorySize, dimensionality);
+      brick::numeric::Array2D<FloatType> yHistory(memorySize, dimensionality);
+      std::vector<FloatType> rhoHistory(memorySize, FloatType(0));
+      size_t historyStart = 0;
+      size_t historySize = 0;
+
+      std::vector<char> isFree(dimensionality, 1);
+      std::vector<FloatType> direction(dimensionality);
+      std::vector<FloatType> sNew(dimensionality);
+      std::vector<FloatType> yNew(dimensionality);
+      argument_type thetaNew(dimensionality);
+      argument_type gradientNew(dimensionality);
+      result_type valueNew = currentValue;
+
+      while(1) {
+        // Test for adequately small objective value.
+        if(currentValue <= this->m_minimumFunctionValue) {
+          if(this->m_verbosity > 0) {
+            std::cout << "\nTerminating OptimizerLBFGS::doLbfgs() with "
+                      << "objective value (" << currentValue
+                      << ") less than or equal to threshold ("
+                      << this->m_minimumFunctionValue
+                      << ")." << std::endl;
+          }
+          return brick::common::makeTriple(
+            thetaLocal, currentValue, currentGradient);
+        }
+
+        // Parameters pinned against a bound by the gradient don't
+        // move this iteration.
+        if(isBounded) {
+          for(size_t index = 0; index < dimensionality; ++index) {
+            isFree[index] = !(
+              (thetaLocal[index] <= this->m_lowerBounds[index]
+               && currentGradient[index] > 0.0)
+              || (thetaLocal[index] >= this->m_upperBounds[index]
+                  && currentGradient[index] < 0.0));
+          }
+        }
+
+        // Test for "small gradient" convergence.
+        if(this->gradientConvergenceMetric(
+             thetaLocal, currentValue, currentGradient, isFree)
+           < this->m_gradientTolerance) {
+          if(this->m_verbosity > 0) {
+            std::cout << "\nTerminating OptimizerLBFGS::doLbfgs() with "
+                      << "small gradient." << std::endl;
+          }
+          return brick::common::makeTriple(
+            thetaLocal, currentValue, currentGradient);
+        }
+
+        // Choose the search direction.  Fall back to steepest descent
+        // if rounding has made the quasi-Newton direction uphill.
+        this->computeDirection(currentGradient, isFree, sHistory, yHistory,
+                               rhoHistory, historyStart, historySize,
+                               direction);
+        FloatType slope = 0.0;
+        for(size_t index = 0; index < dimensionality; ++index) {
+          slope += direction[index] * currentGradient[index];
+        }
+        if(!(slope < 0.0)) {
+          historySize = 0;
+          this->computeDirection(currentGradient, isFree, sHistory, yHistory,
+                                 rhoHistory, historyStart, historySize,
+                                 direction);
+        }
+
+        // With no history, the direction isn't scaled to the problem,
+        // so start with a modest step.
+        FloatType initialStep = 1.0;
+        if(historySize == 0) {
+          FloatType directionMagnitude = 0.0;
+          for(size_t index = 0; index < dimensionality; ++index) {
+            directionMagnitude += direction[index] * direction[index];
+          }
+          directionMagnitude = brick::common::squareRoot(directionMagnitude);
+          if(directionMagnitude > 1.0) {
+            initialStep = 1.0 / directionMagnitude;
+          }
+        }
+
+        bool isSuccess = false;
+        if(isBounded) {
+          isSuccess = this->lineSearchProjected(
+            thetaLocal, currentValue, currentGradient, direction, initialStep,
+            thetaNew, valueNew, gradientNew,
+            numberOfFunctionCalls, numberOfGradientCalls);
+        } else {
+          isSuccess = this->lineSearchWolfe(
+            thetaLocal, currentValue, currentGradient, direction, initialStep,
+            thetaNew, valueNew, gradientNew,
+            numberOfFunctionCalls, numberOfGradientCalls);
+        }
+
+        if(!isSuccess) {
+          // If the history was bad, clear it and try again from
+          // steepest descent.  Otherwise, we can't make progress.
+          if(historySize != 0) {
+            historySize = 0;
+            continue;
+          }
+          if(this->m_verbosity > 0) {
+            std::cout << "\nTerminating OptimizerLBFGS::doLbfgs() after "
+                      << "failed line search." << std::endl;
+          }
+          return brick::common::makeTriple(
+            thetaLocal, currentValue, currentGradient);
+        }
+
+        // Record the change in parameters and gradient.  The
+        // update is skipped if curvature isn't positive, which can
+        // happen in the bounded case, since the projected line
+        // search doesn't enforce the curvature condition.
+        for(size_t index = 0; index < dimensionality; ++index) {
+          sNew[index] = thetaNew[index] - thetaLocal[index];
+          yNew[index] = gradientNew[index] - currentGradient[index];
+        }
+        FloatType stepScale = 0.0;
+        for(size_t index = 0; index < dimensionality; ++index) {
+          FloatType pointElement = std::max(
+            brick::common::absoluteValue(FloatType(thetaNew[index])),
+            FloatType(1.0));
+          stepScale = std::max(
+            stepScale, brick::common::absoluteValue(sNew[index]) / pointElement);
+        }
+        this->updateHistory(sNew, yNew, sHistory, yHistory, rhoHistory,
+                            historyStart, historySize);
+
+        copyArgumentType(thetaNew, thetaLocal);
+        copyArgumentType(gradientNew, currentGradient);
+        currentValue = valueNew;
+
+        if(this->m_verbosity > 1) {
+          std::cout << "\rCalls: " << std::setw(10) << numberOfFunctionCalls
+                    << ", " << std::setw(10) << numberOfGradientCalls
+                    << "     Current value: "
+                    << std::setw(15) << currentValue << std::flush;
+        }
+
+        // Test for "insufficient parameter change" convergence.
+        if(stepScale < this->m_argumentTolerance) {
+          if(this->m_verbosity > 0) {
+            std::cout << "\nTerminating OptimizerLBFGS::doLbfgs() with "
+                      << "small search step." << std::endl;
+          }
+          return brick::common::makeTriple(
+            thetaLocal, currentValue, currentGradient);
+        }
+
+        // Check for convergence failure.
+        ++numberOfIterations;
+        if(numberOfIterations > this->m_iterationLimit) {
+          // We're going to bail out, but save the result anyway, just
+          // in case someone cares.
+          this->setOptimum(thetaLocal, currentValue, false);
+
+          // Now throw the exception.
+          std::ostringstream message;
+          message << "Iteration limit of " << this->m_iterationLimit
+                  << " exceeded.";
+          BRICK_THROW(brick::common::RunTimeException,
+                      "OptimizerLBFGS<Functor, FloatType>::doLbfgs()",
+                      message.str().c_str());
+        }
+      }
+    }
+
+
+    template <class Functor, class FloatType>
+    FloatType
+    OptimizerLBFGS<Functor, FloatType>::
+    gradientConvergenceMetric(const argument_type& theta,
+                              const result_type& value,
+                              const argument_type& gradient,
+                              const std::vector<char>& isFree)
+    {
+      FloatType returnValue = 0.0;
+      FloatType denominator = static_cast<FloatType>(
+        std::max(value, static_cast<result_type>(1.0)));
+      for(size_t index = 0; index < theta.size(); ++index) {
+        if(!isFree[index]) {
+          continue;
+        }
+        FloatType thetaAbsValue = brick::common::absoluteValue(theta[index]);
+        FloatType gradientAbsValue =
+          brick::common::absoluteValue(gradient[index]);
+        FloatType candidate =
+          gradientAbsValue
+          * std::max(thetaAbsValue, static_cast<FloatType>(1.0))
+          / denominator;
+
+        if(candidate > returnValue) {
+          returnValue = candidate;
+        }
+      }
+      return returnValue;
+    }
+
+
+    template <class Functor, class FloatType>
+    bool
+    OptimizerLBFGS<Functor, FloatType>::
+    lineSearchProjected(const argument_type& theta,
+                        const result_type& value,
+                        const argument_type& gradient,
+                        const std::vector<FloatType>& direction,
+                        FloatType initialStep,
+                        argument_type& thetaNew,
+                        result_type& valueNew,
+                        argument_type& gradientNew,
+                        size_t& numberOfFunctionCalls,
+                        size_t& numberOfGradientCalls)
+    {
+      size_t const maximumNumberOfTrials = 40;
+      size_t const dimensionality = theta.size();
+      FloatType step = initialStep;
+      for(size_t trial = 0; trial < maximumNumberOfTrials; ++trial) {
+        // Project the trial point into the box, and measure the
+        // decrease predicted by the gradient along the projected
+        // step.
+        FloatType predictedChange = 0.0;
+        bool isMoved = false;
+        for(size_t index = 0; index < dimensionality; ++index) {
+          FloatType element = theta[index] + step * direction[index];
+          element = std::min(
+            std::max(element, FloatType(this->m_lowerBounds[index])),
+            FloatType(this->m_upperBounds[index]));
+          thetaNew[index] = element;
+          FloatType change = element - theta[index];
+          predictedChange += gradient[index] * change;
+          isMoved = isMoved || (change != 0.0);
+        }
+        if(!isMoved) {
+          return false;
+        }
+
+        valueNew = this->m_functor(thetaNew);
+        ++numberOfFunctionCalls;
+        if(valueNew <= value + this->m_lineSearchAlpha * predictedChange) {
+          gradientNew = this->m_functor.gradient(thetaNew);
+          ++numberOfGradientCalls;
+          return true;
+        }
+        step *= 0.5;
+      }
+      return false;
+    }
+
+
+    template <class Functor, class FloatType>
+    bool
+    OptimizerLBFGS<Functor, FloatType>::
+    lineSearchWolfe(const argument_type& theta,
+                    const result_type& value,
+                    const argument_type& gradient,
+                    const std::vector<FloatType>& direction,
+                    FloatType initialStep,
+                    argument_type& thetaNew,
+                    result_type& valueNew,
+                    argument_type& gradientNew,
+                    size_t& numberOfFunctionCalls,
+                    size_t& numberOfGradientCalls)
+    {
+      size_t const maximumNumberOfTrials = 40;
+      size_t const dimensionality = theta.size();
+      FloatType const value0 = value;
+      FloatType slope0 = 0.0;
+      for(size_t index = 0; index < dimensionality; ++index) {
+        slope0 += gradient[index] * direction[index];
+      }
+      FloatType const alpha = this->m_lineSearchAlpha;
+      FloatType const beta = this->m_lineSearchBeta;
+
+      // Evaluates the function at the specified step, leaving the
+      // trial point in thetaNew and the result in valueNew.
+      auto evaluateValue = [&](FloatType step) -> FloatType {
+        for(size_t index = 0; index < dimensionality; ++index) {
+          thetaNew[index] = theta[index] + step * direction[index];
+        }
+        valueNew = this->m_functor(thetaNew);
+        ++numberOfFunctionCalls;
+        return static_cast<FloatType>(valueNew);
+      };
+
+      // Evaluates the gradient at thetaNew, and returns the
+      // directional derivative.
+      auto evaluateSlope = [&]() -> FloatType {
+        gradientNew = this->m_functor.gradient(thetaNew);
+        ++numberOfGradientCalls;
+        FloatType slope = 0.0;
+        for(size_t index = 0; index < dimensionality; ++index) {
+          slope += gradientNew[index] * direction[index];
+        }
+        return slope;
+      };
+
+      // The interval [stepLow, stepHigh] (or [stepHigh, stepLow])
+      // brackets an acceptable step once isBracketed is true.
+      // stepLow is always the best step found so far that satisfies
+      // the sufficient decrease condition.
+      FloatType stepLow = 0.0;
+      FloatType valueLow = value0;
+      FloatType slopeLow = slope0;
+      FloatType stepHigh = 0.0;
+      FloatType valueHigh = value0;
+      bool isBracketed = false;
+
+      FloatType step = initialStep;
+      for(size_t trial = 0; trial < maximumNumberOfTrials; ++trial) {
+        FloatType trialValue = evaluateValue(step);
+        if(!(trialValue <= value0 + alpha * step * slope0)
+           || trialValue >= valueLow) {
+          // Too far.  The acceptable step lies between stepLow and
+          // here.
+          stepHigh = step;
+          valueHigh = trialValue;
+          isBracketed = true;
+        } else {
+          FloatType slope = evaluateSlope();
+          if(brick::common::absoluteValue(slope) <= -beta * slope0) {
+            return true;
+          }
+          if(slope * (stepHigh - stepLow) >= 0.0 && isBracketed) {
+            stepHigh = stepLow;
+            valueHigh = valueLow;
+          }
+          if(!isBracketed && slope >= 0.0) {
+            stepHigh = stepLow;
+            valueHigh = valueLow;
+            isBracketed = true;
+          }
+          stepLow = step;
+          valueLow = trialValue;
+          slopeLow = slope;
+        }
+
+        if(!isBracketed) {
+          // Still going downhill.  Try a bigger step.
+          step *= 2.0;
+          continue;
+        }
+
+        // Minimize the quadratic through (stepLow, valueLow) with
+        // slope slopeLow, and (stepHigh, valueHigh), safeguarded to
+        // stay well inside the bracket.
+        FloatType width = stepHigh - stepLow;
+        FloatType denominator =
+          2.0 * (valueHigh - valueLow - slopeLow * width);
+        FloatType candidate = stepLow + 0.5 * width;
+        if(denominator > 0.0) {
+          candidate = stepLow - slopeLow * width * width / denominator;
+        }
+        FloatType lowerLimit = std::min(stepLow + 0.1 * width,
+                                        stepHigh - 0.1 * width);
+        FloatType upperLimit = std::max(stepLow + 0.1 * width,
+                                        stepHigh - 0.1 * width);
+        if(!(candidate >= lowerLimit && candidate <= upperLimit)) {
+          candidate = stepLow + 0.5 * width;
+        }
+        if(brick::common::absoluteValue(width)
+           <= std::numeric_limits<FloatType>::epsilon()
+           * std::max(brick::common::absoluteValue(stepLow), FloatType(1.0))) {
+          break;
+        }
+        step = candidate;
+      }
+
+      // We didn't satisfy the curvature condition, but we may still
+      // have made progress.
+      if(stepLow > 0.0) {
+        evaluateValue(stepLow);
+        evaluateSlope();
+        return true;
+      }
+      return false;
+    }
+
+
+    template <class Functor, class FloatType>
+    std::pair<typename Functor::argument_type, typename Functor::result_type>
+    OptimizerLBFGS<Functor, FloatType>::
+    run()
+    {
+      // Check that we have a valid startPoint.
+      if(this->m_startPoint.size() == 0) {
+        BRICK_THROW(brick::common::StateException,
+                    "OptimizerLBFGS<Functor, FloatType>::run()",
+                    "startPoint has not been initialized.");
+      }
+
+      // Initialize working location so that we start at the right
+      // place, moving into the feasible region if necessary.
+      argument_type theta(this->m_startPoint.size());
+      copyArgumentType(this->m_startPoint, theta);
+      if(this->m_lowerBounds.size() != 0) {
+        if(this->m_lowerBounds.size() != theta.size()) {
+          std::ostringstream message;
+          message << "Bounds have dimensionality "
+                  << this->m_lowerBounds.size()
+                  << ", but startPoint has dimensionality "
+                  << theta.size() << ".";
+          BRICK_THROW(brick::common::ValueException,
+                      "OptimizerLBFGS<Functor, FloatType>::run()",
+                      message.str().c_str());
+        }
+        for(size_t index = 0; index < theta.size(); ++index) {
+          theta[index] = std::min(
+            std::max(FloatType(theta[index]),
+                     FloatType(this->m_lowerBounds[index])),
+            FloatType(this->m_upperBounds[index]));
+        }
+      }
+
+      // Compute initial values of function and its gradient.
+      result_type startValue = this->m_functor(theta);
+      argument_type startGradient = this->m_functor.gradient(theta);
+
+      // Now run the optimization.
+      this->m_functionCallCount.clear();
+      this->m_gradientCallCount.clear();
+      this->m_iterationCount.clear();
+      size_t functionCallCount;
+      size_t gradientCallCount;
+      size_t iterationCount;
+      brick::common::Triple<argument_type, result_type, argument_type>
+        optimum_optimalValue_gradient =
+        this->doLbfgs(theta, startValue, startGradient, functionCallCount,
+                      gradientCallCount, iterationCount);
+      // When accounting function calls, don't forget to add the initial
+      // function and gradient evaluations above.
+      this->m_functionCallCount.push_back(functionCallCount + 1);
+      this->m_gradientCallCount.push_back(gradientCallCount + 1);
+      this->m_iterationCount.push_back(iterationCount);
+
+      // Restart as many times as requested.
+      for(size_t index = 0; index < this->m_numberOfRestarts; ++index) {
+        copyArgumentType(optimum_optimalValue_gradient.first, theta);
+        startValue = optimum_optimalValue_gradient.second;
+        copyArgumentType(optimum_optimalValue_gradient.third,
+                         startGradient);
+        optimum_optimalValue_gradient =
+          this->doLbfgs(theta, startValue, startGradient, functionCallCount,
+                        gradientCallCount, iterationCount);
+        this->m_functionCallCount.push_back(functionCallCount);
+        this->m_gradientCallCount.push_back(gradientCallCount);
+        this->m_iterationCount.push_back(iterationCount);
+      }
+
+      return std::make_pair(optimum_optimalValue_gradient.first,
+                            optimum_optimalValue_gradient.second);
+    }
+
+  } // namespace optimization
+
+} // namespace brick
+
+#endif /* #ifndef BRICK_OPTIMIZATION_OPTIMIZERLBFGS_HH */
@@ -15,6 +15,7 @@
 #include <vector>
 #include <brick/optimization/optimizer.hh>
 #include <brick/common/exception.hh>
+#include <brick/common/parallelFor.hh>
 
 namespace brick {
 
@@ -33,6 +34,9 @@ namespace brick {
      **
      ** [2] J.A. Nelder and R. Mead. A simplex method for function
      ** minimization. Computer Journal, 7:303--313, 1965.
+     **
+     ** For expensive objective functions, independent function
+     ** evaluations can be run concurrently.  See setNumberOfThreads().
      **/
     // template <std::unary_function Functor>
     template <class Functor, class FloatType = double>
@@ -123,6 +127,41 @@ namespace brick {
       }
 
 
+      /**
+       * This member function enables concurrent evaluation of the
+       * objective function.  If more than one thread is requested,
+       * the initial simplex vertices and the vertices of each shrink
+       * step are evaluated concurrently, and each iteration
+       * speculatively evaluates the reflection, expansion, and both
+       * contraction candidates at once, and then keeps whichever
+       * the serial algorithm would have chosen.  Given a
+       * deterministic objective function, this visits the same
+       * sequence of simplices as the serial algorithm (up to
+       * roundoff), but its wall time per iteration is roughly that
+       * of one function call, rather than two or three.  The price
+       * is that more function calls are made in total, and these
+       * count against the functionCallLimit argument of
+       * setParameters().
+       *
+       * Each additional thread uses its own copy of the objective
+       * function, so Functor must be copyable, and copies must be
+       * safe to call concurrently.  The copies are made before any
+       * thread starts, but they may share data with the original, so
+       * operator()() must not write to shared data.  Threads are started for each
+       * batch of evaluations, which costs tens of microseconds, so
+       * this is only worthwhile for expensive objective functions.
+       *
+       * @param numberOfThreads This argument specifies how many
+       * threads to use.  The default, 1, gives the original serial
+       * algorithm.  Setting it to zero uses one thread per
+       * available processor.
+       */
+      void
+      setNumberOfThreads(unsigned int numberOfThreads) {
+        this->m_numberOfThreads = numberOfThreads;
+      }
+
+
       /**
        * Sets minimization parameters.  Default values are reasonable
        * for functions which take values and arguments in the "normal"
@@ -226,6 +265,30 @@ namespace brick {
         argument_type& axisSums);
 
 
+      /**
+       * This protected member function computes a candidate point
+       * along the line from the worst point of the simplex through
+       * the centroid of the remaining points.  See evaluateMove().
+       *
+       * @param currentPoints This argument specifies the current set
+       * of points, with the worst point last.
+       *
+       * @param axisSums This argument passes in the sums of the
+       * elements of currentPoints.
+       *
+       * @param factor This argument specifies the size of the step.
+       * A factor of 1.0 returns the worst point, 0.0 returns the
+       * centroid, and -1.0 returns the reflection of the worst point
+       * through the centroid.
+       *
+       * @return The return value is the candidate point.
+       */
+      argument_type
+      computeMove(const std::vector<argument_type>& currentPoints,
+                  const argument_type& axisSums,
+                  FloatType factor);
+
+
       /**
        * This protected member function runs the actual simplex search.
        * It modifies all arguments.
@@ -273,6 +336,57 @@ namespace brick {
                    FloatType factor);
 
 
+      /**
+       * This protected member function evaluates the objective
+       * function at a range of points, using up to m_numberOfThreads
+       * threads.
+       *
+       * @param points This argument specifies the points at which to
+       * evaluate the objective function.
+       *
+       * @param values This argument is used to return the function
+       * values.  It must have the same size as points.
+       *
+       * @param begin This argument is the index of the first point
+       * to evaluate.
+       *
+       * @param end This argument is one past the index of the last
+       * point to evaluate.
+       */
+      void
+      evaluatePoints(const std::vector<argument_type>& points,
+                     std::vector<result_type>& values,
+                     size_t begin, size_t end);
+
+
+      /**
+       * This protected member function performs one iteration of the
+       * simplex search by speculatively evaluating all of the
+       * candidate points concurrently.  It modifies its arguments
+       * exactly as one iteration of the serial loop in
+       * doNelderMead() would.
+       *
+       * @param currentPoints This argument specifies the current set
+       * of points, sorted by function value, and is used to return
+       * the updated set of points.
+       *
+       * @param currentValues This argument specifies the function
+       * value at each of the points in currentPoints, and is used to
+       * return the updated values.
+       *
+       * @param axisSums This argument passes in the sums of the
+       * elements of currentPoints, and is updated on return.
+       *
+       * @param numberOfFunctionCalls This argument is incremented by
+       * the number of function calls made.
+       */
+      void
+      doSpeculativeStep(std::vector<argument_type>& currentPoints,
+                        std::vector<result_type>& currentValues,
+                        argument_type& axisSums,
+                        size_t& numberOfFunctionCalls);
+
+
       /**
        * This protected member function performs the minimization.
        *
@@ -293,6 +407,7 @@ namespace brick {
       bool m_deltaValueHack;
 
       std::vector<size_t> m_functionCallCount;
+      unsigned int m_numberOfThreads;
       argument_type m_theta0;
       size_t m_verbosity;
 
@@ -402,6 +517,7 @@ namespace brick {
     OptimizerNelderMead()
       : Optimizer<Functor>(),
         m_functionCallCount(),
+        m_numberOfThreads(1),
         m_verbosity(0)
     {
       this->setParameters(argument_type());
@@ -417,6 +533,7 @@ namespace brick {
     OptimizerNelderMead(const Functor& functor)
       : Optimizer<Functor>(functor),
         m_functionCallCount(),
+        m_numberOfThreads(1),
         m_verbosity(0)
     {
       this->setParameters(argument_type());
@@ -437,6 +554,7 @@ namespace brick {
         m_minimumSimplexValueSpan(source.m_minimumSimplexValueSpan),
         m_deltaValueHack(source.m_deltaValueHack),
         m_functionCallCount(source.m_functionCallCount),
+        m_numberOfThreads(source.m_numberOfThreads),
         m_verbosity(source.m_verbosity)
     {
       copyArgumentType(source.m_delta, this->m_delta);
@@ -533,6 +651,8 @@ namespace brick {
       this->m_minimumSimplexValueSpan = source.m_minimumSimplexValueSpan;
       this->m_deltaValueHack = source.m_deltaValueHack;
       this->m_functionCallCount = source.m_functionCallCount;
+      this->m_numberOfThreads = source.m_numberOfThreads;
+      return *this;
     }
 
     // template <std::unary_function Functor>
@@ -608,6 +728,11 @@ namespace brick {
           }
           break;
         }
+        if(this->m_numberOfThreads != 1) {
+          this->doSpeculativeStep(currentPoints, currentValues, axisSums,
+                                  numberOfFunctionCalls);
+          continue;
+        }
         result_type newValue =
           this->evaluateMove(currentPoints, currentValues, axisSums,
                              (-1.0 * this->m_alpha));
@@ -626,9 +751,10 @@ namespace brick {
           if(newValue >= oldMaxValue) {
             for(size_t i = 1; i < dimension + 1; ++i) {
               currentPoints[i] = 0.5 * (currentPoints[i] + currentPoints[0]);
-              currentValues[i] = this->m_functor(currentPoints[i]);
-              numberOfFunctionCalls += 1;
             }
+            this->evaluatePoints(currentPoints, currentValues,
+                                 1, dimension + 1);
+            numberOfFunctionCalls += dimension;
           }
           this->computeAxisSums(currentPoints, axisSums);
         }
@@ -636,8 +762,9 @@ namespace brick {
     }
 
 
-    // Evaluate, and maybe accept, a new point.  You'll want to believe
-    // the following math before reading this code.
+    // Compute a new point along the line through the worst point and
+    // the centroid of the others.  You'll want to believe the
+    // following math before reading this code.
     //
     // xMean + factor*(xMax - xMean)
     // = xMean + factor*xMax - factor*xMean
@@ -645,6 +772,56 @@ namespace brick {
     // = ((1 - factor)/n)*sum(xSubi, xSubi != xMax) + factor*xMax
     // = ((1 - factor)/n)*sum(xSubi) - ((1 - factor)/n)*xMax + factor*xMax
     // = ((1 - factor)/n)*sum(xSubi) + (factor - ((1 - factor)/n))*xMax
+    template <class Functor, class FloatType>
+    typename OptimizerNelderMead<Functor, FloatType>::argument_type
+    OptimizerNelderMead<Functor, FloatType>::
+    computeMove(const std::vector<argument_type>& currentPoints,
+                const argument_type& axisSums,
+                FloatType factor)
+    {
+      size_t dimension = currentPoints.size() - 1;
+      FloatType centroidFactor = (1.0 - factor) / dimension;
+      FloatType extrapolationFactor = factor - centroidFactor;
+      return ((centroidFactor * axisSums)
+              + (extrapolationFactor * currentPoints[dimension]));
+    }
+
+
+    // Evaluate the objective function at several points, possibly
+    // concurrently.
+    template <class Functor, class FloatType>
+    void
+    OptimizerNelderMead<Functor, FloatType>::
+    evaluatePoints(const std::vector<argument_type>& points,
+                   std::vector<result_type>& values,
+                   size_t begin, size_t end)
+    {
+      // The calling thread uses the member functor, so the serial
+      // case behaves exactly as it always has.  Other threads get
+      // their own copies, which are made before any thread starts so
+      // that copying never races with use of the original.
+      size_t numberOfBands = brick::common::getNumberOfBands(
+        (end > begin) ? (end - begin) : 0, this->m_numberOfThreads);
+      std::vector<Functor> functorCopies;
+      functorCopies.reserve(numberOfBands - 1);
+      for(size_t band = 1; band < numberOfBands; ++band) {
+        functorCopies.push_back(this->m_functor);
+      }
+
+      brick::common::parallelFor(
+        begin, end, numberOfBands,
+        [&](size_t bandBegin, size_t bandEnd, size_t bandIndex) {
+          Functor& functor = ((bandIndex == 0)
+                              ? this->m_functor
+                              : functorCopies[bandIndex - 1]);
+          for(size_t ii = bandBegin; ii < bandEnd; ++ii) {
+            values[ii] = functor(points[ii]);
+          }
+        });
+    }
+
+
+    // Evaluate, and maybe accept, a new point.  See computeMove().
     // template <std::unary_function Functor>
     template <class Functor, class FloatType>
     typename OptimizerNelderMead<Functor, FloatType>::result_type
@@ -655,11 +832,8 @@ namespace brick {
                  FloatType factor)
     {
       size_t dimension = currentPoints.size() - 1;
-      FloatType centroidFactor = (1.0 - factor) / dimension;
-      FloatType extrapolationFactor = factor - centroidFactor;
       argument_type newPoint =
-        ((centroidFactor * axisSums)
-         + (extrapolationFactor * currentPoints[dimension]));
+        this->computeMove(currentPoints, axisSums, factor);
       result_type newValue = this->m_functor(newPoint);
       if(newValue < currentValues[dimension]) {
         currentValues[dimension] = newValue;
@@ -668,6 +842,77 @@ namespace brick {
       return newValue;
     }
 
+    // One iteration of the simplex search, with all candidate points
+    // evaluated up front.  The candidates are the ones the serial
+    // loop in doNelderMead() would try.  In the serial loop, the
+    // expansion and contraction steps are taken relative to whichever
+    // point is worst after the reflection step, but this is always
+    // either the original worst point or the reflected point, so all
+    // of the candidates can be expressed relative to the original
+    // worst point:
+    //
+    //   reflection:          factor = -alpha
+    //   expansion:           factor = -alpha * gamma
+    //   outside contraction: factor = -alpha * beta (reflection accepted)
+    //   inside contraction:  factor = beta          (reflection rejected)
+    template <class Functor, class FloatType>
+    void
+    OptimizerNelderMead<Functor, FloatType>::
+    doSpeculativeStep(std::vector<argument_type>& currentPoints,
+                      std::vector<result_type>& currentValues,
+                      argument_type& axisSums,
+                      size_t& numberOfFunctionCalls)
+    {
+      size_t dimension = currentPoints.size() - 1;
+      enum {REFLECTION = 0, EXPANSION, OUTSIDE, INSIDE, NUMBER_OF_CANDIDATES};
+
+      std::vector<argument_type> candidatePoints(NUMBER_OF_CANDIDATES);
+      std::vector<result_type> candidateValues(NUMBER_OF_CANDIDATES);
+      candidatePoints[REFLECTION] = this->computeMove(
+        currentPoints, axisSums, -this->m_alpha);
+      candidatePoints[EXPANSION] = this->computeMove(
+        currentPoints, axisSums, -this->m_alpha * this->m_gamma);
+      candidatePoints[OUTSIDE] = this->computeMove(
+        currentPoints, axisSums, -this->m_alpha * this->m_beta);
+      candidatePoints[INSIDE] = this->computeMove(
+        currentPoints, axisSums, this->m_beta);
+      this->evaluatePoints(candidatePoints, candidateValues,
+                           0, NUMBER_OF_CANDIDATES);
+      numberOfFunctionCalls += NUMBER_OF_CANDIDATES;
+
+      // Now replay the serial logic using the precomputed values.
+      result_type worstValue = currentValues[dimension];
+      result_type newValue = candidateValues[REFLECTION];
+      if(newValue < currentValues[dimension]) {
+        currentValues[dimension] = newValue;
+        currentPoints[dimension] = candidatePoints[REFLECTION];
+      }
+      if(newValue <= currentValues[0]) {
+        if(candidateValues[EXPANSION] < currentValues[dimension]) {
+          currentValues[dimension] = candidateValues[EXPANSION];
+          currentPoints[dimension] = candidatePoints[EXPANSION];
+        }
+      } else if(newValue >= currentValues[dimension - 1]) {
+        result_type oldMaxValue = currentValues[dimension];
+        size_t contraction = (newValue < worstValue) ? OUTSIDE : INSIDE;
+        newValue = candidateValues[contraction];
+        if(newValue < currentValues[dimension]) {
+          currentValues[dimension] = newValue;
+          currentPoints[dimension] = candidatePoints[contraction];
+        }
+        if(newValue >= oldMaxValue) {
+          for(size_t i = 1; i < dimension + 1; ++i) {
+            currentPoints[i] = 0.5 * (currentPoints[i] + currentPoints[0]);
+          }
+          this->evaluatePoints(currentPoints, currentValues,
+                               1, dimension + 1);
+          numberOfFunctionCalls += dimension;
+        }
+      }
+      this->computeAxisSums(currentPoints, axisSums);
+    }
+
+
     // Perform the minimization (top level).
     // template <std::unary_function Functor>
     template <class Functor, class FloatType>
@@ -702,8 +947,8 @@ namespace brick {
         for(size_t j = 0; j < dimension; ++j) {
           copyArgumentType(currentPoints[0], currentPoints[j + 1]);
           (currentPoints[j + 1])[j] += this->m_delta[j];
-          currentValues[j + 1] = this->m_functor(currentPoints[j + 1]);
         }
+        this->evaluatePoints(currentPoints, currentValues, 1, dimension + 1);
         size_t numberOfFunctionCalls = (i == 0) ? 1 : 0;
         numberOfFunctionCalls += dimension;
         // Run the minimization algorithm.
@@ -0,0 +1,285 @@
+/**
+***************************************************************************
+* @file brick/optimization/test/gradientFunctionTest.cc
+*
+* Source file defining a test class for GradientFunction and
+* GradientFunctionRidders.
+*
+* Copyright (C) 2026 David LaRose, dlr@cs.cmu.edu
+* See accompanying file, LICENSE.TXT, for details.
+*
+***************************************************************************
+**/
+
+#include <cmath>
+#include <thread>
+#include <brick/optimization/gradientFunction.hh>
+
+#include <brick/common/functional.hh>
+#include <brick/numeric/array1D.hh>
+#include <brick/test/testFixture.hh>
+
+namespace brick {
+
+  namespace optimization {
+
+    // Smooth test function with a known gradient.
+    class GradientTestFunction {
+    public:
+      typedef brick::numeric::Array1D<double> argument_type;
+      typedef double result_type;
+
+      double
+      operator()(argument_type const& theta) {
+        double result = 0.0;
+        for(size_t index = 0; index < theta.size(); ++index) {
+          result += (index + 1.0) * std::sin(theta[index])
+            + theta[index] * theta[index];
+        }
+        return result;
+      }
+
+      argument_type
+      gradient(argument_type const& theta) {
+        argument_type result(theta.size());
+        for(size_t index = 0; index < theta.size(); ++index) {
+          result[index] = (index + 1.0) * std::cos(theta[index])
+            + 2.0 * theta[index];
+        }
+        return result;
+      }
+    };
+
+
+    // Test function that holds an Array1D member, so that copying
+    // it touches a shared reference count.  The copy constructor
+    // records whether it was ever called from a thread other than
+    // the one that constructed the original.
+    class StatefulGradientTestFunction {
+    public:
+      typedef brick::numeric::Array1D<double> argument_type;
+      typedef double result_type;
+
+      StatefulGradientTestFunction(size_t size)
+        : m_ownerThread(std::this_thread::get_id()),
+          m_weights(size),
+          m_wasCopiedOffThread(false)
+      {
+        for(size_t index = 0; index < m_weights.size(); ++index) {
+          m_weights[index] = index + 1.0;
+        }
+      }
+
+      StatefulGradientTestFunction(StatefulGradientTestFunction const& other)
+        : m_ownerThread(other.m_ownerThread),
+          m_weights(other.m_weights),
+          m_wasCopiedOffThread(
+            other.m_wasCopiedOffThread
+            || (std::this_thread::get_id() != other.m_ownerThread))
+      {
+        if(m_wasCopiedOffThread) {
+          s_copiedOffThread = true;
+        }
+      }
+
+      double
+      operator()(argument_type const& theta) {
+        double result = 0.0;
+        for(size_t index = 0; index < theta.size(); ++index) {
+          result += m_weights[index] * std::sin(theta[index])
+            + theta[index] * theta[index];
+        }
+        return result;
+      }
+
+      argument_type
+      gradient(argument_type const& theta) {
+        argument_type result(theta.size());
+        for(size_t index = 0; index < theta.size(); ++index) {
+          result[index] = m_weights[index] * std::cos(theta[index])
+            + 2.0 * theta[index];
+        }
+        return result;
+      }
+
+      static bool s_copiedOffThread;
+
+    private:
+      std::thread::id m_ownerThread;
+      argument_type m_weights;
+      bool m_wasCopiedOffThread;
+    };
+
+    bool StatefulGradientTestFunction::s_copiedOffThread = false;
+
+
+    class GradientFunctionTest
+      : public brick::test::TestFixture<GradientFunctionTest> {
+
+    public:
+
+      GradientFunctionTest();
+      ~GradientFunctionTest() {}
+
+      void setUp(const std::string& /* testName */) {}
+      void tearDown(const std::string& /* testName */) {}
+
+      void testGradient();
+      void testGradientRidders();
+      void testGradientStatefulFunctor();
+
+    private:
+
+      brick::numeric::Array1D<double>
+      getTheta();
+
+      double m_defaultTolerance;
+
+    }; // class GradientFunctionTest
+
+
+    /* ============== Member Function Definititions ============== */
+
+    GradientFunctionTest::
+    GradientFunctionTest()
+      : brick::test::TestFixture<GradientFunctionTest>(
+        "GradientFunctionTest"),
+        m_defaultTolerance(1.0E-6)
+    {
+      // Register all tests.
+      BRICK_TEST_REGISTER_MEMBER(testGradient);
+      BRICK_TEST_REGISTER_MEMBER(testGradientRidders);
+      BRICK_TEST_REGISTER_MEMBER(testGradientStatefulFunctor);
+    }
+
+
+    void
+    GradientFunctionTest::
+    testGradient()
+    {
+      GradientTestFunction function;
+      brick::numeric::Array1D<double> theta = this->getTheta();
+      brick::numeric::Array1D<double> reference = function.gradient(theta);
+
+      GradientFunction<GradientTestFunction> gradientFunction(function);
+      BRICK_TEST_ASSERT(gradientFunction.getNumberOfThreads() == 1);
+      brick::numeric::Array1D<double> serialResult =
+        gradientFunction.gradient(theta);
+      for(size_t index = 0; index < theta.size(); ++index) {
+        BRICK_TEST_ASSERT(
+          approximatelyEqual(serialResult[index], reference[index], 1.0E-5));
+      }
+
+      // Concurrent evaluation should give bit-identical answers.
+      for(unsigned int numberOfThreads = 0; numberOfThreads < 5;
+          ++numberOfThreads) {
+        gradientFunction.setNumberOfThreads(numberOfThreads);
+        brick::numeric::Array1D<double> result =
+          gradientFunction.gradient(theta);
+        BRICK_TEST_ASSERT(result.size() == theta.size());
+        for(size_t index = 0; index < theta.size(); ++index) {
+          BRICK_TEST_ASSERT(result[index] == serialResult[index]);
+        }
+      }
+    }
+
+
+    void
+    GradientFunctionTest::
+    testGradientRidders()
+    {
+      GradientTestFunction function;
+      brick::numeric::Array1D<double> theta = this->getTheta();
+      brick::numeric::Array1D<double> reference = function.gradient(theta);
+
+      for(unsigned int numberOfThreads = 0; numberOfThreads < 5;
+          ++numberOfThreads) {
+        GradientFunctionRidders<GradientTestFunction> gradientFunction(
+          function);
+        gradientFunction.setNumberOfThreads(numberOfThreads);
+        brick::numeric::Array1D<double> result =
+          gradientFunction.gradient(theta);
+        BRICK_TEST_ASSERT(result.size() == theta.size());
+        for(size_t index = 0; index < theta.size(); ++index) {
+          BRICK_TEST_ASSERT(
+            approximatelyEqual(result[index], reference[index],
+                               m_defaultTolerance));
+        }
+      }
+    }
+
+
+    void
+    GradientFunctionTest::
+    testGradientStatefulFunctor()
+    {
+      brick::numeric::Array1D<double> theta = this->getTheta();
+      StatefulGradientTestFunction function(theta.size());
+      brick::numeric::Array1D<double> reference = function.gradient(theta);
+      StatefulGradientTestFunction::s_copiedOffThread = false;
+
+      // Repeat several times so that any unsynchronized reference
+      // counting has a chance to corrupt the functor's Array1D
+      // member.  Functor copies must all be made on this thread.
+      for(unsigned int numberOfThreads = 0; numberOfThreads < 5;
+          ++numberOfThreads) {
+        GradientFunction<StatefulGradientTestFunction> gradientFunction(
+          function);
+        GradientFunctionRidders<StatefulGradientTestFunction>
+          riddersFunction(function);
+        gradientFunction.setNumberOfThreads(numberOfThreads);
+        riddersFunction.setNumberOfThreads(numberOfThreads);
+        for(unsigned int trial = 0; trial < 20; ++trial) {
+          brick::numeric::Array1D<double> result =
+            gradientFunction.gradient(theta);
+          brick::numeric::Array1D<double> riddersResult =
+            riddersFunction.gradient(theta);
+          BRICK_TEST_ASSERT(result.size() == theta.size());
+          BRICK_TEST_ASSERT(riddersResult.size() == theta.size());
+          for(size_t index = 0; index < theta.size(); ++index) {
+            BRICK_TEST_ASSERT(
+              approximatelyEqual(result[index], reference[index], 1.0E-5));
+            BRICK_TEST_ASSERT(
+              approximatelyEqual(riddersResult[index], reference[index],
+                                 m_defaultTolerance));
+          }
+        }
+      }
+      BRICK_TEST_ASSERT(!StatefulGradientTestFunction::s_copiedOffThread);
+    }
+
+
+    brick::numeric::Array1D<double>
+    GradientFunctionTest::
+    getTheta()
+    {
+      brick::numeric::Array1D<double> theta(7);
+      for(size_t index = 0; index < theta.size(); ++index) {
+        theta[index] = 0.3 * index - 1.0;
+      }
+      return theta;
+    }
+
+  } // namespace optimization
+
+} // namespace brick
+
+
+#if 0
+
+int main(int /* argc */, char** /* argv */)
+{
+  brick::optimization::GradientFunctionTest currentTest;
+  bool result = currentTest.run();
+  return (result ? 0 : 1);
+}
+
+#else
+
+namespace {
+
+  brick::optimization::GradientFunctionTest currentTest;
+
+}
+
+#endif
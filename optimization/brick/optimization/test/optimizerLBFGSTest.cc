@@ -0,0 +1,467 @@
+/**
+***************************************************************************
+* @file brick/optimization/test/optimizerLBFGSTest.cc
+*
+* Source file defining a test class for OptimizerLBFGS.
+*
+* Copyright (C) 2026 David LaRose, dlr@cs.cmu.edu
+* See accompanying file, LICENSE.TXT, for details.
+*
+***************************************************************************
+**/
+
+#include <chrono>
+#include <iostream>
+#include <brick/optimization/optimizerLBFGS.hh>
+#include <brick/optimization/optimizerBFGS.hh>
+
+#include <brick/common/functional.hh>
+#include <brick/numeric/array1D.hh>
+#include <brick/numeric/array2D.hh>
+#include <brick/test/testFixture.hh>
+
+namespace brick {
+
+  namespace optimization {
+
+    // Extended Rosenbrock function, with analytic gradient.  The
+    // minimum is at (1, 1, ..., 1), where the function value is zero.
+    class RosenbrockFunction {
+    public:
+      typedef brick::numeric::Array1D<double> argument_type;
+      typedef double result_type;
+
+      double
+      operator()(argument_type const& theta) {
+        double result = 0.0;
+        for(size_t index = 0; index + 1 < theta.size(); index += 2) {
+          double term0 = theta[index + 1] - theta[index] * theta[index];
+          double term1 = 1.0 - theta[index];
+          result += 100.0 * term0 * term0 + term1 * term1;
+        }
+        return result;
+      }
+
+      argument_type
+      gradient(argument_type const& theta) {
+        argument_type result(theta.size());
+        result = 0.0;
+        for(size_t index = 0; index + 1 < theta.size(); index += 2) {
+          double term0 = theta[index + 1] - theta[index] * theta[index];
+          double term1 = 1.0 - theta[index];
+          result[index] = -400.0 * term0 * theta[index] - 2.0 * term1;
+          result[index + 1] = 200.0 * term0;
+        }
+        return result;
+      }
+    };
+
+
+    // Exposes OptimizerLBFGS's protected history bookkeeping so that
+    // it can be tested directly.
+    class OptimizerLBFGSHistoryAccess
+      : public OptimizerLBFGS<RosenbrockFunction> {
+    public:
+      using OptimizerLBFGS<RosenbrockFunction>::updateHistory;
+    };
+
+
+    class OptimizerLBFGSTest
+      : public brick::test::TestFixture<OptimizerLBFGSTest> {
+
+    public:
+
+      OptimizerLBFGSTest();
+      ~OptimizerLBFGSTest() {}
+
+      void setUp(const std::string& /* testName */) {}
+      void tearDown(const std::string& /* testName */) {}
+
+      void testRosenbrock();
+      void testHighDimensional();
+      void testBounds();
+      void testBoundsFullHistory();
+      void testExceptions();
+      void testUpdateHistory();
+      void testExecutionTime();
+
+    private:
+
+      brick::numeric::Array1D<double>
+      getStartPoint(size_t dimensionality);
+
+      double m_defaultTolerance;
+
+    }; // class OptimizerLBFGSTest
+
+
+    /* ============== Member Function Definititions ============== */
+
+    OptimizerLBFGSTest::
+    OptimizerLBFGSTest()
+      : brick::test::TestFixture<OptimizerLBFGSTest>("OptimizerLBFGSTest"),
+        m_defaultTolerance(1.0E-4)
+    {
+      // Register all tests.
+      BRICK_TEST_REGISTER_MEMBER(testRosenbrock);
+      BRICK_TEST_REGISTER_MEMBER(testHighDimensional);
+      BRICK_TEST_REGISTER_MEMBER(testBounds);
+      BRICK_TEST_REGISTER_MEMBER(testBoundsFullHistory);
+      BRICK_TEST_REGISTER_MEMBER(testExceptions);
+      BRICK_TEST_REGISTER_MEMBER(testUpdateHistory);
+      // BRICK_TEST_REGISTER_MEMBER(testExecutionTime);
+    }
+
+
+    void
+    OptimizerLBFGSTest::
+    testRosenbrock()
+    {
+      brick::numeric::Array1D<double> startPoint = this->getStartPoint(2);
+
+      // Dense BFGS, for comparison.
+      OptimizerBFGS<RosenbrockFunction> optimizerBFGS;
+      optimizerBFGS.setStartPoint(startPoint);
+      brick::numeric::Array1D<double> resultBFGS = optimizerBFGS.optimum();
+
+      OptimizerLBFGS<RosenbrockFunction> optimizer;
+      optimizer.setStartPoint(startPoint);
+      brick::numeric::Array1D<double> result = optimizer.optimum();
+      BRICK_TEST_ASSERT(result.size() == 2);
+      for(size_t index = 0; index < result.size(); ++index) {
+        BRICK_TEST_ASSERT(
+          approximatelyEqual(result[index], 1.0, m_defaultTolerance));
+        BRICK_TEST_ASSERT(
+          approximatelyEqual(result[index], resultBFGS[index],
+                             m_defaultTolerance));
+      }
+      BRICK_TEST_ASSERT(optimizer.optimalValue() < 1.0E-8);
+
+      // Statistics should be available, and the limited memory
+      // version shouldn't need wildly more work than the dense
+      // version on a small problem.
+      std::vector<size_t> iterations = optimizer.getNumberOfIterations();
+      std::vector<size_t> functionCalls = optimizer.getNumberOfFunctionCalls();
+      std::vector<size_t> gradientCalls = optimizer.getNumberOfGradientCalls();
+      BRICK_TEST_ASSERT(iterations.size() == 1);
+      BRICK_TEST_ASSERT(functionCalls.size() == 1);
+      BRICK_TEST_ASSERT(gradientCalls.size() == 1);
+      BRICK_TEST_ASSERT(iterations[0] > 0);
+      BRICK_TEST_ASSERT(functionCalls[0] >= iterations[0]);
+      BRICK_TEST_ASSERT(
+        functionCalls[0] < 4 * optimizerBFGS.getNumberOfFunctionCalls()[0]);
+
+      // Restarts should add entries to the statistics.
+      optimizer.setNumberOfRestarts(2);
+      optimizer.setStartPoint(startPoint);
+      result = optimizer.optimum();
+      BRICK_TEST_ASSERT(optimizer.getNumberOfIterations().size() == 3);
+      BRICK_TEST_ASSERT(
+        approximatelyEqual(result[0], 1.0, m_defaultTolerance));
+    }
+
+
+    void
+    OptimizerLBFGSTest::
+    testHighDimensional()
+    {
+      // Far too big for dense BFGS, which would need an 800MB
+      // inverse Hessian estimate.
+      size_t const dimensionality = 10000;
+      OptimizerLBFGS<RosenbrockFunction> optimizer;
+      optimizer.setStartPoint(this->getStartPoint(dimensionality));
+      brick::numeric::Array1D<double> result = optimizer.optimum();
+      BRICK_TEST_ASSERT(result.size() == dimensionality);
+      for(size_t index = 0; index < result.size(); ++index) {
+        BRICK_TEST_ASSERT(
+          approximatelyEqual(result[index], 1.0, m_defaultTolerance));
+      }
+
+      // Memory size shouldn't affect the answer.
+      optimizer.setMemorySize(3);
+      result = optimizer.optimum();
+      for(size_t index = 0; index < result.size(); ++index) {
+        BRICK_TEST_ASSERT(
+          approximatelyEqual(result[index], 1.0, m_defaultTolerance));
+      }
+    }
+
+
+    void
+    OptimizerLBFGSTest::
+    testBounds()
+    {
+      // Constraining x <= 0.5 moves the Rosenbrock minimum to the
+      // point on the parabola y = x^2 closest to (1, 1) in x, which
+      // is (0.5, 0.25).
+      double const infinity = std::numeric_limits<double>::max();
+      brick::numeric::Array1D<double> lowerBounds(2);
+      brick::numeric::Array1D<double> upperBounds(2);
+      lowerBounds[0] = -infinity;
+      lowerBounds[1] = -infinity;
+      upperBounds[0] = 0.5;
+      upperBounds[1] = infinity;
+
+      OptimizerLBFGS<RosenbrockFunction> optimizer;
+      optimizer.setBounds(lowerBounds, upperBounds);
+      optimizer.setStartPoint(this->getStartPoint(2));
+      brick::numeric::Array1D<double> result = optimizer.optimum();
+      BRICK_TEST_ASSERT(
+        approximatelyEqual(result[0], 0.5, m_defaultTolerance));
+      BRICK_TEST_ASSERT(
+        approximatelyEqual(result[1], 0.25, m_defaultTolerance));
+
+      // Start point outside of the box should be projected in.  Here
+      // the unconstrained minimum of each pair, (1, 1), violates the
+      // bounds on some parameters but not others.
+      size_t const dimensionality = 100;
+      lowerBounds = brick::numeric::Array1D<double>(dimensionality);
+      upperBounds = brick::numeric::Array1D<double>(dimensionality);
+      brick::numeric::Array1D<double> startPoint(dimensionality);
+      for(size_t index = 0; index < dimensionality; ++index) {
+        lowerBounds[index] = -2.0;
+        upperBounds[index] = ((index % 4) == 0) ? 0.5 : 2.0;
+        startPoint[index] = 5.0;
+      }
+      optimizer.setBounds(lowerBounds, upperBounds);
+      optimizer.setStartPoint(startPoint);
+      result = optimizer.optimum();
+      for(size_t index = 0; index < dimensionality; index += 2) {
+        double expected0 = ((index % 4) == 0) ? 0.5 : 1.0;
+        BRICK_TEST_ASSERT(
+          approximatelyEqual(result[index], expected0, m_defaultTolerance));
+        BRICK_TEST_ASSERT(
+          approximatelyEqual(result[index + 1], expected0 * expected0,
+                             m_defaultTolerance));
+      }
+
+      // Removing the bounds restores the unconstrained answer.
+      optimizer.clearBounds();
+      optimizer.setStartPoint(this->getStartPoint(2));
+      result = optimizer.optimum();
+      BRICK_TEST_ASSERT(
+        approximatelyEqual(result[0], 1.0, m_defaultTolerance));
+    }
+
+
+    void
+    OptimizerLBFGSTest::
+    testBoundsFullHistory()
+    {
+      // A small history and a start point far from the solution
+      // mean that many more iterations than memorySize are needed,
+      // and clamping at the bounds means that some of those
+      // iterations produce parameter/gradient pairs that fail the
+      // curvature test after the history is full.  In pairs with
+      // index % 4 == 0, the bound on y is active, and x settles at
+      // the root of -400 * (0.2 - x^2) * x - 2 * (1 - x) = 0.
+      size_t const dimensionality = 40;
+      double const constrainedX = 0.45388973478456424;
+      brick::numeric::Array1D<double> lowerBounds(dimensionality);
+      brick::numeric::Array1D<double> upperBounds(dimensionality);
+      brick::numeric::Array1D<double> startPoint(dimensionality);
+      for(size_t index = 0; index < dimensionality; ++index) {
+        lowerBounds[index] = -2.0;
+        switch(index % 4) {
+        case 0: upperBounds[index] = 0.5; break;
+        case 1: upperBounds[index] = 0.2; break;
+        default: upperBounds[index] = 2.0; break;
+        }
+        startPoint[index] = ((index % 2) == 0) ? -1.7 : 1.9;
+      }
+
+      OptimizerLBFGS<RosenbrockFunction> optimizer;
+      optimizer.setMemorySize(3);
+      optimizer.setBounds(lowerBounds, upperBounds);
+      optimizer.setStartPoint(startPoint);
+      brick::numeric::Array1D<double> result = optimizer.optimum();
+      BRICK_TEST_ASSERT(optimizer.getNumberOfIterations()[0] > 3);
+      for(size_t index = 0; index < dimensionality; index += 2) {
+        double expected0 = ((index % 4) == 0) ? constrainedX : 1.0;
+        double expected1 = ((index % 4) == 0) ? 0.2 : 1.0;
+        BRICK_TEST_ASSERT(
+          approximatelyEqual(result[index], expected0, m_defaultTolerance));
+        BRICK_TEST_ASSERT(
+          approximatelyEqual(result[index + 1], expected1,
+                             m_defaultTolerance));
+      }
+    }
+
+
+    void
+    OptimizerLBFGSTest::
+    testExceptions()
+    {
+      OptimizerLBFGS<RosenbrockFunction> optimizer;
+      BRICK_TEST_ASSERT_EXCEPTION(brick::common::StateException,
+                                  optimizer.optimum());
+
+      brick::numeric::Array1D<double> lowerBounds(2);
+      brick::numeric::Array1D<double> upperBounds(3);
+      lowerBounds = 0.0;
+      upperBounds = 1.0;
+      BRICK_TEST_ASSERT_EXCEPTION(
+        brick::common::ValueException,
+        optimizer.setBounds(lowerBounds, upperBounds));
+
+      upperBounds = brick::numeric::Array1D<double>(2);
+      upperBounds = -1.0;
+      BRICK_TEST_ASSERT_EXCEPTION(
+        brick::common::ValueException,
+        optimizer.setBounds(lowerBounds, upperBounds));
+
+      // Bounds that don't match the start point.
+      upperBounds = 1.0;
+      optimizer.setBounds(lowerBounds, upperBounds);
+      optimizer.setStartPoint(this->getStartPoint(4));
+      BRICK_TEST_ASSERT_EXCEPTION(brick::common::ValueException,
+                                  optimizer.optimum());
+
+      BRICK_TEST_ASSERT_EXCEPTION(brick::common::ValueException,
+                                  optimizer.setMemorySize(0));
+      BRICK_TEST_ASSERT_EXCEPTION(
+        brick::common::ValueException,
+        optimizer.setParameters(100, 0, 5, 1.0E-7, 1.0E-5, 0.5, 0.1));
+
+      // Iteration limit.
+      optimizer.clearBounds();
+      optimizer.setIterationLimit(2);
+      optimizer.setStartPoint(this->getStartPoint(2));
+      BRICK_TEST_ASSERT_EXCEPTION(brick::common::RunTimeException,
+                                  optimizer.optimum());
+    }
+
+
+    void
+    OptimizerLBFGSTest::
+    testUpdateHistory()
+    {
+      OptimizerLBFGSHistoryAccess optimizer;
+      brick::numeric::Array2D<double> sHistory(2, 2);
+      brick::numeric::Array2D<double> yHistory(2, 2);
+      std::vector<double> rhoHistory(2, 0.0);
+      size_t historyStart = 0;
+      size_t historySize = 0;
+      std::vector<double> sNew(2);
+      std::vector<double> yNew(2);
+
+      // Fill the history.
+      sNew[0] = 1.0; sNew[1] = 0.0;
+      yNew[0] = 1.0; yNew[1] = 0.0;
+      BRICK_TEST_ASSERT(
+        optimizer.updateHistory(sNew, yNew, sHistory, yHistory, rhoHistory,
+                                historyStart, historySize));
+      sNew[0] = 0.0; sNew[1] = 1.0;
+      yNew[0] = 0.0; yNew[1] = 2.0;
+      BRICK_TEST_ASSERT(
+        optimizer.updateHistory(sNew, yNew, sHistory, yHistory, rhoHistory,
+                                historyStart, historySize));
+      BRICK_TEST_ASSERT(historyStart == 0);
+      BRICK_TEST_ASSERT(historySize == 2);
+
+      // A pair with negative curvature must be rejected without
+      // disturbing the oldest stored pair, which lives in the row
+      // that an accepted pair would overwrite.
+      sNew[0] = 1.0; sNew[1] = 0.0;
+      yNew[0] = -3.0; yNew[1] = 0.0;
+      BRICK_TEST_ASSERT(
+        !optimizer.updateHistory(sNew, yNew, sHistory, yHistory, rhoHistory,
+                                 historyStart, historySize));
+      BRICK_TEST_ASSERT(historyStart == 0);
+      BRICK_TEST_ASSERT(historySize == 2);
+      BRICK_TEST_ASSERT(sHistory(0, 0) == 1.0 && sHistory(0, 1) == 0.0);
+      BRICK_TEST_ASSERT(yHistory(0, 0) == 1.0 && yHistory(0, 1) == 0.0);
+      BRICK_TEST_ASSERT(sHistory(1, 0) == 0.0 && sHistory(1, 1) == 1.0);
+      BRICK_TEST_ASSERT(yHistory(1, 0) == 0.0 && yHistory(1, 1) == 2.0);
+      BRICK_TEST_ASSERT(
+        approximatelyEqual(rhoHistory[0], 1.0, m_defaultTolerance));
+      BRICK_TEST_ASSERT(
+        approximatelyEqual(rhoHistory[1], 0.5, m_defaultTolerance));
+
+      // An acceptable pair replaces the oldest one.
+      sNew[0] = 1.0; sNew[1] = 1.0;
+      yNew[0] = 2.0; yNew[1] = 2.0;
+      BRICK_TEST_ASSERT(
+        optimizer.updateHistory(sNew, yNew, sHistory, yHistory, rhoHistory,
+                                historyStart, historySize));
+      BRICK_TEST_ASSERT(historyStart == 1);
+      BRICK_TEST_ASSERT(historySize == 2);
+      BRICK_TEST_ASSERT(sHistory(0, 0) == 1.0 && sHistory(0, 1) == 1.0);
+      BRICK_TEST_ASSERT(yHistory(0, 0) == 2.0 && yHistory(0, 1) == 2.0);
+      BRICK_TEST_ASSERT(
+        approximatelyEqual(rhoHistory[0], 0.25, m_defaultTolerance));
+    }
+
+
+    void
+    OptimizerLBFGSTest::
+    testExecutionTime()
+    {
+      size_t const dimensionality = 1000;
+      brick::numeric::Array1D<double> startPoint =
+        this->getStartPoint(dimensionality);
+
+      OptimizerBFGS<RosenbrockFunction> optimizerBFGS;
+      optimizerBFGS.setStartPoint(startPoint);
+      // The optimization library doesn't link brickUtilities, so use
+      // std::chrono for timing.
+      typedef std::chrono::steady_clock Clock;
+      Clock::time_point startTime = Clock::now();
+      optimizerBFGS.optimum();
+      Clock::time_point stopTime = Clock::now();
+      std::cout << "OptimizerBFGS, N = " << dimensionality << ": "
+                << std::chrono::duration<double>(stopTime - startTime).count()
+                << " s, "
+                << optimizerBFGS.getNumberOfIterations()[0] << " iterations, "
+                << optimizerBFGS.getNumberOfFunctionCalls()[0]
+                << " function calls." << std::endl;
+
+      OptimizerLBFGS<RosenbrockFunction> optimizer;
+      optimizer.setStartPoint(startPoint);
+      startTime = Clock::now();
+      optimizer.optimum();
+      stopTime = Clock::now();
+      std::cout << "OptimizerLBFGS, N = " << dimensionality << ": "
+                << std::chrono::duration<double>(stopTime - startTime).count()
+                << " s, "
+                << optimizer.getNumberOfIterations()[0] << " iterations, "
+                << optimizer.getNumberOfFunctionCalls()[0]
+                << " function calls." << std::endl;
+    }
+
+
+    brick::numeric::Array1D<double>
+    OptimizerLBFGSTest::
+    getStartPoint(size_t dimensionality)
+    {
+      // Classic Rosenbrock start point, repeated.
+      brick::numeric::Array1D<double> startPoint(dimensionality);
+      for(size_t index = 0; index < dimensionality; ++index) {
+        startPoint[index] = ((index % 2) == 0) ? -1.2 : 1.0;
+      }
+      return startPoint;
+    }
+
+  } // namespace optimization
+
+} // namespace brick
+
+
+#if 0
+
+int main(int argc, char** argv)
+{
+  brick::optimization::OptimizerLBFGSTest currentTest;
+  bool result = currentTest.run();
+  return (result ? 0 : 1);
+}
+
+#else
+
+namespace {
+
+  brick::optimization::OptimizerLBFGSTest currentTest;
+
+}
+
+#endif
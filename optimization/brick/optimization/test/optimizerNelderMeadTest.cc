@@ -0,0 +1,192 @@
+/**
+***************************************************************************
+* @file brick/optimization/test/optimizerNelderMeadTest.cc
+*
+* Source file defining a test class for OptimizerNelderMead.
+*
+* Copyright (C) 2026 David LaRose, dlr@cs.cmu.edu
+* See accompanying file, LICENSE.TXT, for details.
+*
+***************************************************************************
+**/
+
+#include <brick/optimization/optimizerNelderMead.hh>
+
+#include <brick/common/functional.hh>
+#include <brick/numeric/array1D.hh>
+#include <brick/test/testFixture.hh>
+
+namespace brick {
+
+  namespace optimization {
+
+    // Skewed quadratic bowl with minimum value 1.0 at (1, 2, ..., N).
+    // The nonzero minimum keeps OptimizerNelderMead's relative
+    // termination criterion meaningful.  The location of the
+    // minimum is held in an Array1D member so that copying the
+    // functor for concurrent evaluation touches a shared reference
+    // count.
+    class NelderMeadTestFunction {
+    public:
+      typedef brick::numeric::Array1D<double> argument_type;
+      typedef double result_type;
+
+      NelderMeadTestFunction()
+        : m_minimum(16)
+      {
+        for(size_t index = 0; index < m_minimum.size(); ++index) {
+          m_minimum[index] = index + 1.0;
+        }
+      }
+
+      double
+      operator()(argument_type const& theta) {
+        double result = 1.0;
+        for(size_t index = 0; index < theta.size(); ++index) {
+          double term = theta[index] - m_minimum[index];
+          result += (index + 1.0) * term * term;
+          if(index != 0) {
+            double crossTerm = theta[index - 1] - m_minimum[index - 1];
+            result += 0.5 * term * crossTerm;
+          }
+        }
+        return result;
+      }
+
+    private:
+      argument_type m_minimum;
+    };
+
+
+    class OptimizerNelderMeadTest
+      : public brick::test::TestFixture<OptimizerNelderMeadTest> {
+
+    public:
+
+      OptimizerNelderMeadTest();
+      ~OptimizerNelderMeadTest() {}
+
+      void setUp(const std::string& /* testName */) {}
+      void tearDown(const std::string& /* testName */) {}
+
+      void testOptimum();
+      void testNumberOfThreads();
+
+    private:
+
+      brick::numeric::Array1D<double>
+      runOptimizer(unsigned int numberOfThreads,
+                   std::vector<size_t>& functionCalls);
+
+      double m_defaultTolerance;
+      size_t m_dimensionality;
+
+    }; // class OptimizerNelderMeadTest
+
+
+    /* ============== Member Function Definititions ============== */
+
+    OptimizerNelderMeadTest::
+    OptimizerNelderMeadTest()
+      : brick::test::TestFixture<OptimizerNelderMeadTest>(
+        "OptimizerNelderMeadTest"),
+        m_defaultTolerance(1.0E-4),
+        m_dimensionality(4)
+    {
+      // Register all tests.
+      BRICK_TEST_REGISTER_MEMBER(testOptimum);
+      BRICK_TEST_REGISTER_MEMBER(testNumberOfThreads);
+    }
+
+
+    void
+    OptimizerNelderMeadTest::
+    testOptimum()
+    {
+      std::vector<size_t> functionCalls;
+      brick::numeric::Array1D<double> result =
+        this->runOptimizer(1, functionCalls);
+      BRICK_TEST_ASSERT(result.size() == m_dimensionality);
+      for(size_t index = 0; index < result.size(); ++index) {
+        BRICK_TEST_ASSERT(
+          approximatelyEqual(result[index], index + 1.0, m_defaultTolerance));
+      }
+      BRICK_TEST_ASSERT(functionCalls.size() == 2);
+    }
+
+
+    void
+    OptimizerNelderMeadTest::
+    testNumberOfThreads()
+    {
+      std::vector<size_t> serialCalls;
+      brick::numeric::Array1D<double> serialResult =
+        this->runOptimizer(1, serialCalls);
+
+      for(unsigned int numberOfThreads = 0; numberOfThreads < 5;
+          ++numberOfThreads) {
+        if(numberOfThreads == 1) {
+          continue;
+        }
+        std::vector<size_t> functionCalls;
+        brick::numeric::Array1D<double> result =
+          this->runOptimizer(numberOfThreads, functionCalls);
+        BRICK_TEST_ASSERT(result.size() == m_dimensionality);
+        for(size_t index = 0; index < result.size(); ++index) {
+          BRICK_TEST_ASSERT(
+            approximatelyEqual(result[index], index + 1.0,
+                               m_defaultTolerance));
+          BRICK_TEST_ASSERT(
+            approximatelyEqual(result[index], serialResult[index],
+                               m_defaultTolerance));
+        }
+
+        // Speculative evaluation makes extra function calls.
+        BRICK_TEST_ASSERT(functionCalls.size() == serialCalls.size());
+        BRICK_TEST_ASSERT(functionCalls[0] > serialCalls[0]);
+      }
+    }
+
+
+    brick::numeric::Array1D<double>
+    OptimizerNelderMeadTest::
+    runOptimizer(unsigned int numberOfThreads,
+                 std::vector<size_t>& functionCalls)
+    {
+      brick::numeric::Array1D<double> startPoint(m_dimensionality);
+      brick::numeric::Array1D<double> delta(m_dimensionality);
+      startPoint = 0.0;
+      delta = 0.5;
+
+      OptimizerNelderMead<NelderMeadTestFunction> optimizer;
+      optimizer.setParameters(delta, 100000, 1, 1.0, 0.5, 2.0, 1.0E-14);
+      optimizer.setNumberOfThreads(numberOfThreads);
+      optimizer.setStartPoint(startPoint);
+      brick::numeric::Array1D<double> result = optimizer.optimum();
+      functionCalls = optimizer.getNumberOfFunctionCalls();
+      return result;
+    }
+
+  } // namespace optimization
+
+} // namespace brick
+
+
+#if 0
+
+int main(int /* argc */, char** /* argv */)
+{
+  brick::optimization::OptimizerNelderMeadTest currentTest;
+  bool result = currentTest.run();
+  return (result ? 0 : 1);
+}
+
+#else
+
+namespace {
+
+  brick::optimization::OptimizerNelderMeadTest currentTest;
+
+}
+
+#endif
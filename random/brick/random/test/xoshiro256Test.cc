@@ -0,0 +1,435 @@
+/**
+***************************************************************************
+* @file brick/random/test/xoshiro256Test.cc
+*
+* Source file defining tests for the Xoshiro256 class.
+*
+* Copyright (C) 2026 David LaRose, dlr@cs.cmu.edu
+* See accompanying file, LICENSE.TXT, for details.
+*
+***************************************************************************
+**/
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <brick/common/exception.hh>
+#include <brick/random/xoshiro256.hh>
+#include <brick/test/testFixture.hh>
+
+namespace brick {
+
+  namespace random {
+
+    class Xoshiro256Test
+      : public brick::test::TestFixture<Xoshiro256Test> {
+
+    public:
+
+      Xoshiro256Test();
+      ~Xoshiro256Test() {}
+
+      void setUp(const std::string& /* testName */) {}
+      void tearDown(const std::string& /* testName */) {}
+
+      // Tests.
+      void testReferenceOutput();
+      void testJump();
+      void testLongJump();
+      void testSplit();
+      void testUniform();
+      void testUniformIntRange();
+      void testUniformIntBias();
+      void testNormal();
+
+    private:
+
+      // Returns true if the next outputs of generator match
+      // referenceOutput.
+      bool
+      matchesReference(Xoshiro256& generator,
+                       brick::common::UInt64 const* referenceOutput,
+                       size_t numberOfOutputs);
+
+      brick::common::UInt64 m_seed;
+
+    }; // class Xoshiro256Test
+
+
+    /* ============== Reference Values ============== */
+
+    // These reference values were computed with the public domain
+    // xoshiro256++ and SplitMix64 reference implementations by
+    // Blackman and Vigna, seeding the four state words with
+    // successive SplitMix64 outputs.
+    namespace {
+
+      const brick::common::UInt64 referenceSeed0[] = {
+        0x53175d61490b23dfULL, 0x61da6f3dc380d507ULL,
+        0x5c0fdf91ec9a7bfcULL, 0x02eebf8c3bbe5e1aULL,
+        0x7eca04ebaf4a5eeaULL, 0x0543c37757f08d9aULL
+      };
+
+      const brick::common::UInt64 referenceSeed1234567[] = {
+        0x0610e053dd55ab68ULL, 0x70c979e26e27fbacULL,
+        0xfb95f99f9f6bb2deULL, 0x03890aaecd9fa80aULL,
+        0x536acabd892d9406ULL, 0x1f1a58ff404b8898ULL
+      };
+
+      // Seed 1234567, followed by one call to jump().
+      const brick::common::UInt64 referenceJump[] = {
+        0x21ae762a7c91249cULL, 0xefe59eef81fc742fULL,
+        0x5583f8b0149c48e4ULL, 0x4a6f8848f6613260ULL
+      };
+
+      // Seed 1234567, followed by two calls to jump().
+      const brick::common::UInt64 referenceJumpJump[] = {
+        0x32433f50fce88987ULL, 0x908b7f2eb23d9e49ULL,
+        0xa38f193c13869ad4ULL, 0x226876159bfbb808ULL
+      };
+
+      // Seed 1234567, followed by one call to longJump().
+      const brick::common::UInt64 referenceLongJump[] = {
+        0x80748657f4558c3bULL, 0x543a8071cfd08906ULL,
+        0xa3452258cf16f0c1ULL, 0x85892e52be8a75f1ULL
+      };
+
+    } // namespace
+
+
+    /* ============== Member Function Definititions ============== */
+
+    Xoshiro256Test::
+    Xoshiro256Test()
+      : brick::test::TestFixture<Xoshiro256Test>("Xoshiro256Test"),
+        m_seed(1234567)
+    {
+      BRICK_TEST_REGISTER_MEMBER(testReferenceOutput);
+      BRICK_TEST_REGISTER_MEMBER(testJump);
+      BRICK_TEST_REGISTER_MEMBER(testLongJump);
+      BRICK_TEST_REGISTER_MEMBER(testSplit);
+      BRICK_TEST_REGISTER_MEMBER(testUniform);
+      BRICK_TEST_REGISTER_MEMBER(testUniformIntRange);
+      BRICK_TEST_REGISTER_MEMBER(testUniformIntBias);
+      BRICK_TEST_REGISTER_MEMBER(testNormal);
+    }
+
+
+    void
+    Xoshiro256Test::
+    testReferenceOutput()
+    {
+      Xoshiro256 generator0(0);
+      BRICK_TEST_ASSERT(
+        this->matchesReference(generator0, referenceSeed0, 6));
+
+      Xoshiro256 generator1(m_seed);
+      BRICK_TEST_ASSERT(
+        this->matchesReference(generator1, referenceSeed1234567, 6));
+
+      // Reseeding should restart the sequence.
+      generator1.setCurrentSeed(0);
+      BRICK_TEST_ASSERT(
+        this->matchesReference(generator1, referenceSeed0, 6));
+      generator1.setCurrentSeed(m_seed);
+      BRICK_TEST_ASSERT(
+        this->matchesReference(generator1, referenceSeed1234567, 6));
+
+      BRICK_TEST_ASSERT(Xoshiro256::min() == 0);
+      BRICK_TEST_ASSERT(
+        Xoshiro256::max() == std::numeric_limits<brick::common::UInt64>::max());
+    }
+
+
+    void
+    Xoshiro256Test::
+    testJump()
+    {
+      Xoshiro256 generator(m_seed);
+      generator.jump();
+      BRICK_TEST_ASSERT(this->matchesReference(generator, referenceJump, 4));
+
+      generator.setCurrentSeed(m_seed);
+      generator.jump();
+      generator.jump();
+      BRICK_TEST_ASSERT(
+        this->matchesReference(generator, referenceJumpJump, 4));
+
+      // The two argument constructor is equivalent to repeated jumps.
+      Xoshiro256 generator0(m_seed, 0);
+      BRICK_TEST_ASSERT(
+        this->matchesReference(generator0, referenceSeed1234567, 6));
+      Xoshiro256 generator1(m_seed, 1);
+      BRICK_TEST_ASSERT(this->matchesReference(generator1, referenceJump, 4));
+      Xoshiro256 generator2(m_seed, 2);
+      BRICK_TEST_ASSERT(
+        this->matchesReference(generator2, referenceJumpJump, 4));
+    }
+
+
+    void
+    Xoshiro256Test::
+    testLongJump()
+    {
+      Xoshiro256 generator(m_seed);
+      generator.longJump();
+      BRICK_TEST_ASSERT(
+        this->matchesReference(generator, referenceLongJump, 4));
+
+      // Jumps don't depend on how many numbers have been drawn from
+      // the current stream, so longJump() and jump() commute.
+      Xoshiro256 generatorA(m_seed);
+      generatorA.jump();
+      generatorA.longJump();
+      Xoshiro256 generatorB(m_seed);
+      generatorB.longJump();
+      generatorB.jump();
+      for(size_t ii = 0; ii < 8; ++ii) {
+        BRICK_TEST_ASSERT(generatorA() == generatorB());
+      }
+    }
+
+
+    void
+    Xoshiro256Test::
+    testSplit()
+    {
+      Xoshiro256 generator(m_seed);
+      Xoshiro256 stream0 = generator.split();
+      Xoshiro256 stream1 = generator.split();
+      Xoshiro256 stream2 = generator.split();
+      BRICK_TEST_ASSERT(
+        this->matchesReference(stream0, referenceSeed1234567, 6));
+      BRICK_TEST_ASSERT(this->matchesReference(stream1, referenceJump, 4));
+      BRICK_TEST_ASSERT(this->matchesReference(stream2, referenceJumpJump, 4));
+
+      // Drawing from a split stream doesn't affect the parent.
+      Xoshiro256 reference(m_seed, 3);
+      for(size_t ii = 0; ii < 8; ++ii) {
+        BRICK_TEST_ASSERT(generator() == reference());
+      }
+    }
+
+
+    void
+    Xoshiro256Test::
+    testUniform()
+    {
+      // uniform() uses the top 53 bits of each output.
+      Xoshiro256 generator(m_seed);
+      for(size_t ii = 0; ii < 6; ++ii) {
+        brick::common::Float64 expected =
+          static_cast<brick::common::Float64>(referenceSeed1234567[ii] >> 11)
+          / 9007199254740992.0;
+        BRICK_TEST_ASSERT(generator.uniform() == expected);
+      }
+
+      // fillUniform() should match repeated calls to uniform().
+      Xoshiro256 generatorA(m_seed);
+      Xoshiro256 generatorB(m_seed);
+      brick::numeric::Array1D<brick::common::Float64> samples(1000);
+      generatorA.fillUniform(samples, -3.0, 5.0);
+      brick::common::Float64 sum = 0.0;
+      for(size_t ii = 0; ii < samples.size(); ++ii) {
+        BRICK_TEST_ASSERT(samples[ii] == generatorB.uniform(-3.0, 5.0));
+        BRICK_TEST_ASSERT(samples[ii] >= -3.0 && samples[ii] < 5.0);
+        sum += samples[ii];
+      }
+      BRICK_TEST_ASSERT(std::fabs(sum / samples.size() - 1.0) < 0.3);
+    }
+
+
+    void
+    Xoshiro256Test::
+    testUniformIntRange()
+    {
+      Xoshiro256 generator(m_seed);
+      brick::common::Int32 const bounds[][2] = {
+        {0, 1}, {-5, 5}, {-1000000, -999990}, {7, 1000003},
+        {std::numeric_limits<brick::common::Int32>::min(),
+         std::numeric_limits<brick::common::Int32>::max()}
+      };
+      for(size_t ii = 0; ii < 5; ++ii) {
+        brick::common::Int32 const lowerBound = bounds[ii][0];
+        brick::common::Int32 const upperBound = bounds[ii][1];
+        bool sawLower = false;
+        bool sawUpper = false;
+        for(size_t jj = 0; jj < 10000; ++jj) {
+          brick::common::Int32 const sample =
+            generator.uniformInt(lowerBound, upperBound);
+          BRICK_TEST_ASSERT(sample >= lowerBound);
+          BRICK_TEST_ASSERT(sample < upperBound);
+          sawLower = sawLower || (sample == lowerBound);
+          sawUpper = sawUpper || (sample == upperBound - 1);
+        }
+        // Small ranges should reach both ends.
+        if(static_cast<brick::common::Int64>(upperBound) - lowerBound <= 10) {
+          BRICK_TEST_ASSERT(sawLower && sawUpper);
+        }
+      }
+
+      // fillUniformInt() should match repeated calls to uniformInt().
+      Xoshiro256 generatorA(m_seed);
+      Xoshiro256 generatorB(m_seed);
+      brick::numeric::Array1D<brick::common::Int32> samples(1000);
+      generatorA.fillUniformInt(samples, -7, 12);
+      for(size_t ii = 0; ii < samples.size(); ++ii) {
+        BRICK_TEST_ASSERT(samples[ii] == generatorB.uniformInt(-7, 12));
+      }
+
+      BRICK_TEST_ASSERT_EXCEPTION(brick::common::ValueException,
+                                  generator.uniformInt(3, 3));
+      BRICK_TEST_ASSERT_EXCEPTION(brick::common::ValueException,
+                                  generator.uniformInt(3, 2));
+      brick::numeric::Array1D<brick::common::Int32> emptyArray;
+      BRICK_TEST_ASSERT_EXCEPTION(
+        brick::common::ValueException,
+        generator.fillUniformInt(emptyArray, 3, 3));
+    }
+
+
+    void
+    Xoshiro256Test::
+    testUniformIntBias()
+    {
+      Xoshiro256 generator(m_seed);
+
+      // Chi-square test of a small range.  With 6 degrees of
+      // freedom, values above 30 happen with probability ~4e-5.
+      size_t const numberOfBins = 7;
+      size_t const numberOfSamples = 70000;
+      std::vector<size_t> counts(numberOfBins, 0);
+      for(size_t ii = 0; ii < numberOfSamples; ++ii) {
+        ++counts[generator.uniformInt(0, numberOfBins)];
+      }
+      double const expectedCount = double(numberOfSamples) / numberOfBins;
+      double chiSquare = 0.0;
+      for(size_t ii = 0; ii < numberOfBins; ++ii) {
+        double const difference = counts[ii] - expectedCount;
+        chiSquare += difference * difference / expectedCount;
+      }
+      BRICK_TEST_ASSERT(chiSquare < 30.0);
+
+      // For a range of 3 * 2^30, reducing 32 random bits modulo the
+      // range would put half of the samples in the first third of
+      // the range.  An unbiased generator puts a third of them
+      // there.  The standard deviation of the fraction is ~0.0015.
+      brick::common::Int32 const lowerBound =
+        std::numeric_limits<brick::common::Int32>::min();
+      brick::common::Int32 const upperBound = 1 << 30;
+      brick::common::Int32 const firstThird = lowerBound + (1 << 30);
+      size_t const numberOfWideSamples = 100000;
+      size_t firstThirdCount = 0;
+      for(size_t ii = 0; ii < numberOfWideSamples; ++ii) {
+        if(generator.uniformInt(lowerBound, upperBound) < firstThird) {
+          ++firstThirdCount;
+        }
+      }
+      double const fraction = double(firstThirdCount) / numberOfWideSamples;
+      BRICK_TEST_ASSERT(std::fabs(fraction - 1.0 / 3.0) < 0.01);
+    }
+
+
+    void
+    Xoshiro256Test::
+    testNormal()
+    {
+      Xoshiro256 generator(m_seed);
+      size_t const numberOfSamples = 200000;
+      brick::numeric::Array1D<brick::common::Float64> samples(numberOfSamples);
+      generator.fillGaussian(samples);
+
+      // Loose moment checks.  The standard errors of the mean,
+      // variance, skewness, and kurtosis estimates are roughly
+      // 0.0022, 0.0032, 0.0055, and 0.011 respectively.
+      double sum = 0.0;
+      for(size_t ii = 0; ii < numberOfSamples; ++ii) {
+        sum += samples[ii];
+      }
+      double const mean = sum / numberOfSamples;
+      double moment2 = 0.0;
+      double moment3 = 0.0;
+      double moment4 = 0.0;
+      size_t withinOneSigma = 0;
+      size_t inTail = 0;
+      for(size_t ii = 0; ii < numberOfSamples; ++ii) {
+        double const difference = samples[ii] - mean;
+        double const squared = difference * difference;
+        moment2 += squared;
+        moment3 += squared * difference;
+        moment4 += squared * squared;
+        if(std::fabs(samples[ii]) < 1.0) {
+          ++withinOneSigma;
+        }
+        // Samples beyond the base of the ziggurat come from the
+        // slow path.
+        if(std::fabs(samples[ii]) > 3.442619855899) {
+          ++inTail;
+        }
+      }
+      moment2 /= numberOfSamples;
+      moment3 /= numberOfSamples;
+      moment4 /= numberOfSamples;
+      double const skewness = moment3 / std::pow(moment2, 1.5);
+      double const kurtosis = moment4 / (moment2 * moment2);
+      BRICK_TEST_ASSERT(std::fabs(mean) < 0.015);
+      BRICK_TEST_ASSERT(std::fabs(moment2 - 1.0) < 0.02);
+      BRICK_TEST_ASSERT(std::fabs(skewness) < 0.035);
+      BRICK_TEST_ASSERT(std::fabs(kurtosis - 3.0) < 0.07);
+
+      // P(|x| < 1) = 0.6827, and P(|x| > 3.4426) = 5.76e-4, so we
+      // expect ~115 tail samples.
+      BRICK_TEST_ASSERT(
+        std::fabs(double(withinOneSigma) / numberOfSamples - 0.6827) < 0.006);
+      BRICK_TEST_ASSERT(inTail > 60 && inTail < 170);
+
+      // gaussian() and fillGaussian() should give the same numbers.
+      Xoshiro256 generatorA(m_seed);
+      Xoshiro256 generatorB(m_seed);
+      brick::numeric::Array1D<brick::common::Float64> shortSamples(100);
+      generatorA.fillGaussian(shortSamples, 2.0, 0.5);
+      for(size_t ii = 0; ii < shortSamples.size(); ++ii) {
+        BRICK_TEST_ASSERT(
+          std::fabs(shortSamples[ii] - generatorB.gaussian(2.0, 0.5))
+          < 1.0E-12);
+      }
+    }
+
+
+    bool
+    Xoshiro256Test::
+    matchesReference(Xoshiro256& generator,
+                     brick::common::UInt64 const* referenceOutput,
+                     size_t numberOfOutputs)
+    {
+      for(size_t ii = 0; ii < numberOfOutputs; ++ii) {
+        if(generator() != referenceOutput[ii]) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+  } // namespace random
+
+} // namespace brick
+
+
+#if 0
+
+int main(int /* argc */, char** /* argv */)
+{
+  brick::random::Xoshiro256Test currentTest;
+  bool result = currentTest.run();
+  return (result ? 0 : 1);
+}
+
+#else
+
+namespace {
+
+  brick::random::Xoshiro256Test currentTest;
+
+}
+
+#endif
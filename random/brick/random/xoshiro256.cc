@@ -0,0 +1,332 @@
+/**
+***************************************************************************
+* @file brick/random/xoshiro256.cc
+*
+* Source file defining the Xoshiro256 class.
+*
+* Copyright (C) 2026 David LaRose, dlr@cs.cmu.edu
+* See accompanying file, LICENSE.TXT, for details.
+*
+***************************************************************************
+**/
+
+#include <cmath>
+#include <brick/portability/timeUtilities.hh>
+#include <brick/random/xoshiro256.hh>
+
+namespace brick {
+
+  namespace random {
+
+    /// @cond privateCode
+    namespace privateCode {
+
+      // Number of layers in the ziggurat, and the constants that
+      // go with it, from J. A. Doornik, "An Improved Ziggurat
+      // Method to Generate Normal Random Samples," 2005.
+      const unsigned int zigguratLayers = 128;
+      const brick::common::Float64 zigguratR = 3.442619855899;
+      const brick::common::Float64 zigguratV = 9.91256303526217e-3;
+
+
+      // Precomputed layer boundaries for the ziggurat method.
+      struct ZigguratTables {
+        ZigguratTables();
+
+        // Right edge of each layer, with m_x[0] being the
+        // (notional) width of the base layer, which includes the
+        // tail.
+        brick::common::Float64 m_x[zigguratLayers + 1];
+
+        // Ratio of each layer's right edge to that of the layer
+        // below.  Samples with |u| less than this fall in the
+        // rectangular part of the layer, and are accepted right away.
+        brick::common::Float64 m_ratio[zigguratLayers];
+      };
+
+
+      ZigguratTables::
+      ZigguratTables()
+      {
+        brick::common::Float64 density = std::exp(-0.5 * zigguratR * zigguratR);
+        m_x[0] = zigguratV / density;
+        m_x[1] = zigguratR;
+        m_x[zigguratLayers] = 0.0;
+        for(unsigned int ii = 2; ii < zigguratLayers; ++ii) {
+          m_x[ii] = std::sqrt(-2.0 * std::log(zigguratV / m_x[ii - 1] + density));
+          density = std::exp(-0.5 * m_x[ii] * m_x[ii]);
+        }
+        for(unsigned int ii = 0; ii < zigguratLayers; ++ii) {
+          m_ratio[ii] = m_x[ii + 1] / m_x[ii];
+        }
+      }
+
+
+      // Tables are built once, on first use.
+      inline ZigguratTables const&
+      getZigguratTables()
+      {
+        static ZigguratTables const tables;
+        return tables;
+      }
+
+
+      // SplitMix64, used to expand a 64-bit seed into 256 bits of
+      // state, as recommended by the authors of xoshiro.
+      inline brick::common::UInt64
+      splitMix64(brick::common::UInt64& state)
+      {
+        brick::common::UInt64 result = (state += 0x9e3779b97f4a7c15ULL);
+        result = (result ^ (result >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        result = (result ^ (result >> 27)) * 0x94d049bb133111ebULL;
+        return result ^ (result >> 31);
+      }
+
+
+      // Jump polynomials from the xoshiro256++ reference
+      // implementation.
+      const brick::common::UInt64 jumpPolynomial[4] = {
+        0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+        0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL
+      };
+
+      const brick::common::UInt64 longJumpPolynomial[4] = {
+        0x76e15d3efefdcbbfULL, 0xc5004e441c522fb3ULL,
+        0x77710069854ee241ULL, 0x39109bb02acbe635ULL
+      };
+
+    } // namespace privateCode
+    /// @endcond
+
+
+    // The default constructor initializes the generator with a seed
+    // derived from the system clock.
+    Xoshiro256::
+    Xoshiro256()
+    {
+      // As with PseudoRandom, time resolution isn't critical.
+      // SplitMix64 scrambles the seed, so nearby times still give
+      // unrelated states.
+      brick::common::Float64 currentTime = brick::portability::getCurrentTime();
+      this->setCurrentSeed(
+        static_cast<brick::common::UInt64>(currentTime * 1000000.0));
+    }
+
+
+    // This constructor sets the seed of the generator.
+    Xoshiro256::
+    Xoshiro256(brick::common::UInt64 seed)
+    {
+      this->setCurrentSeed(seed);
+    }
+
+
+    // This constructor sets the seed of the generator, and then
+    // advances to the requested stream.
+    Xoshiro256::
+    Xoshiro256(brick::common::UInt64 seed,
+               brick::common::UInt64 streamIndex)
+    {
+      this->setCurrentSeed(seed);
+      for(brick::common::UInt64 ii = 0; ii < streamIndex; ++ii) {
+        this->jump();
+      }
+    }
+
+
+    // This member function fills an array with Gaussian samples.
+    void
+    Xoshiro256::
+    fillGaussian(brick::numeric::Array1D<brick::common::Float64>& outputArray,
+                 brick::common::Float64 mu,
+                 brick::common::Float64 sigma)
+    {
+      brick::common::Float64* outputPtr = outputArray.data();
+      brick::common::Float64* const endPtr = outputPtr + outputArray.size();
+      while(outputPtr != endPtr) {
+        *outputPtr++ = this->normal() * sigma + mu;
+      }
+    }
+
+
+    // This member function fills an array with uniform samples.
+    void
+    Xoshiro256::
+    fillUniform(brick::numeric::Array1D<brick::common::Float64>& outputArray,
+                brick::common::Float64 lowerBound,
+                brick::common::Float64 upperBound)
+    {
+      brick::common::Float64 const range = upperBound - lowerBound;
+      brick::common::Float64* outputPtr = outputArray.data();
+      brick::common::Float64* const endPtr = outputPtr + outputArray.size();
+      while(outputPtr != endPtr) {
+        *outputPtr++ = this->uniform() * range + lowerBound;
+      }
+    }
+
+
+    // This member function fills an array with uniform integers.
+    void
+    Xoshiro256::
+    fillUniformInt(brick::numeric::Array1D<brick::common::Int32>& outputArray,
+                   brick::common::Int32 lowerBound,
+                   brick::common::Int32 upperBound)
+    {
+      // uniformInt() checks its arguments, but do it here too so
+      // that an empty array with bad bounds still throws.
+      if(upperBound <= lowerBound) {
+        BRICK_THROW(brick::common::ValueException,
+                    "Xoshiro256::fillUniformInt()",
+                    "Argument upperBound must be greater than lowerBound.");
+      }
+      brick::common::Int32* outputPtr = outputArray.data();
+      brick::common::Int32* const endPtr = outputPtr + outputArray.size();
+      while(outputPtr != endPtr) {
+        *outputPtr++ = this->uniformInt(lowerBound, upperBound);
+      }
+    }
+
+
+    // This member function advances the generator by 2^128 steps.
+    void
+    Xoshiro256::
+    jump()
+    {
+      this->applyJump(privateCode::jumpPolynomial);
+    }
+
+
+    // This member function advances the generator by 2^192 steps.
+    void
+    Xoshiro256::
+    longJump()
+    {
+      this->applyJump(privateCode::longJumpPolynomial);
+    }
+
+
+    // This member function returns a normally distributed sample.
+    brick::common::Float64
+    Xoshiro256::
+    normal()
+    {
+      privateCode::ZigguratTables const& tables =
+        privateCode::getZigguratTables();
+
+      // The top 53 bits give a uniform sample in [-1, 1), and the
+      // low 7 bits (which don't overlap) select a layer.
+      brick::common::UInt64 const bits = (*this)();
+      brick::common::Float64 const uu =
+        static_cast<brick::common::Float64>(bits >> 11)
+        * (2.0 / 9007199254740992.0) - 1.0;
+      unsigned int const layer = static_cast<unsigned int>(
+        bits & (privateCode::zigguratLayers - 1));
+      if(std::fabs(uu) < tables.m_ratio[layer]) {
+        return uu * tables.m_x[layer];
+      }
+      return this->normalSlowPath(bits);
+    }
+
+
+    // This member function sets the seed for the generator.
+    void
+    Xoshiro256::
+    setCurrentSeed(brick::common::UInt64 seed)
+    {
+      // SplitMix64 never produces four zero outputs in a row, so
+      // the state is guaranteed to be valid.
+      m_state[0] = privateCode::splitMix64(seed);
+      m_state[1] = privateCode::splitMix64(seed);
+      m_state[2] = privateCode::splitMix64(seed);
+      m_state[3] = privateCode::splitMix64(seed);
+    }
+
+
+    // This member function returns a copy of *this, and then jumps
+    // to the next stream.
+    Xoshiro256
+    Xoshiro256::
+    split()
+    {
+      Xoshiro256 result(*this);
+      this->jump();
+      return result;
+    }
+
+
+    // Applies one of the jump polynomials to the generator state.
+    void
+    Xoshiro256::
+    applyJump(brick::common::UInt64 const* jumpPolynomial)
+    {
+      brick::common::UInt64 newState[4] = {0, 0, 0, 0};
+      for(unsigned int word = 0; word < 4; ++word) {
+        for(unsigned int bit = 0; bit < 64; ++bit) {
+          if(jumpPolynomial[word] & (brick::common::UInt64(1) << bit)) {
+            newState[0] ^= m_state[0];
+            newState[1] ^= m_state[1];
+            newState[2] ^= m_state[2];
+            newState[3] ^= m_state[3];
+          }
+          (*this)();
+        }
+      }
+      m_state[0] = newState[0];
+      m_state[1] = newState[1];
+      m_state[2] = newState[2];
+      m_state[3] = newState[3];
+    }
+
+
+    // Ziggurat slow path.  Argument bits is the random word that was
+    // rejected by the fast path in normal().
+    brick::common::Float64
+    Xoshiro256::
+    normalSlowPath(brick::common::UInt64 bits)
+    {
+      privateCode::ZigguratTables const& tables =
+        privateCode::getZigguratTables();
+
+      // The first pass repeats the rectangle test from normal(),
+      // which is cheap, and keeps the loop simple.
+      while(true) {
+        brick::common::Float64 const uu =
+          static_cast<brick::common::Float64>(bits >> 11)
+          * (2.0 / 9007199254740992.0) - 1.0;
+        unsigned int const layer = static_cast<unsigned int>(
+          bits & (privateCode::zigguratLayers - 1));
+        if(std::fabs(uu) < tables.m_ratio[layer]) {
+          return uu * tables.m_x[layer];
+        }
+
+        if(layer == 0) {
+          // Sample from the tail beyond zigguratR using Marsaglia's
+          // exponential rejection method.
+          brick::common::Float64 xx;
+          brick::common::Float64 yy;
+          do {
+            xx = std::log(this->uniformNonzero()) / privateCode::zigguratR;
+            yy = std::log(this->uniformNonzero());
+          } while(-2.0 * yy < xx * xx);
+          return (uu < 0.0) ? (xx - privateCode::zigguratR)
+            : (privateCode::zigguratR - xx);
+        }
+
+        // Candidate is in the wedge between the rectangle and the
+        // density curve.  Accept with the appropriate probability.
+        brick::common::Float64 const xx = uu * tables.m_x[layer];
+        brick::common::Float64 const xx2 = xx * xx;
+        brick::common::Float64 const density0 = std::exp(
+          -0.5 * (tables.m_x[layer] * tables.m_x[layer] - xx2));
+        brick::common::Float64 const density1 = std::exp(
+          -0.5 * (tables.m_x[layer + 1] * tables.m_x[layer + 1] - xx2));
+        if(density1 + this->uniform() * (density0 - density1) < 1.0) {
+          return xx;
+        }
+        bits = (*this)();
+      }
+    }
+
+  } // namespace random
+
+} // namespace brick
@@ -0,0 +1,370 @@
+/**
+***************************************************************************
+* @file brick/random/xoshiro256.hh
+*
+* Header file declaring the Xoshiro256 class.
+*
+* Copyright (C) 2026 David LaRose, dlr@cs.cmu.edu
+* See accompanying file, LICENSE.TXT, for details.
+*
+***************************************************************************
+**/
+
+#ifndef BRICK_RANDOM_XOSHIRO256_HH
+#define BRICK_RANDOM_XOSHIRO256_HH
+
+#include <brick/common/types.hh>
+#include <brick/numeric/array1D.hh>
+
+namespace brick {
+
+  namespace random {
+
+    /**
+     ** The Xoshiro256 class is a fast pseudo-random number generator
+     ** implementing the xoshiro256++ algorithm of Blackman and Vigna
+     ** [1].  Compared to PseudoRandom, it has a much longer period
+     ** (2^256 - 1), produces a full 64 random bits per step, and
+     ** generates samples with inline code rather than a call to
+     ** LAPACK for each number.
+     **
+     ** It also supports deterministic parallel use.  Member function
+     ** jump() advances the generator by 2^128 steps, which
+     ** partitions the sequence into 2^128 non-overlapping streams.
+     ** The usual pattern is to call split() once per thread, which
+     ** hands out consecutive streams:
+     **
+     ** @code
+     **   Xoshiro256 generator(mySeed);
+     **   std::vector<Xoshiro256> streams;
+     **   for(size_t ii = 0; ii < numberOfThreads; ++ii) {
+     **     streams.push_back(generator.split());
+     **   }
+     **   // ... thread ii draws only from streams[ii] ...
+     ** @endcode
+     **
+     ** Given the same seed and thread count, each thread sees the
+     ** same numbers on every run, regardless of scheduling.
+     **
+     ** The class also meets the requirements of the standard
+     ** library's UniformRandomBitGenerator concept, so it can be
+     ** passed to std::shuffle(), std::uniform_int_distribution, etc.
+     **
+     ** [1] D. Blackman and S. Vigna, "Scrambled Linear Pseudorandom
+     ** Number Generators," ACM Transactions on Mathematical Software,
+     ** 47(4), 2021.
+     **/
+    class Xoshiro256 {
+    public:
+
+      /// This typedef is required by UniformRandomBitGenerator.
+      typedef brick::common::UInt64 result_type;
+
+
+      /**
+       * The default constructor initializes the generator with a
+       * seed derived from the system clock.
+       */
+      Xoshiro256();
+
+
+      /**
+       * This constructor sets the seed of the generator.  This is
+       * useful if you need a repeatable sequence of pseudo-random
+       * numbers.
+       *
+       * @param seed This argument is expanded into the 256-bit
+       * generator state using the SplitMix64 generator, as
+       * recommended in [1].  All 64 bits are used.
+       */
+      explicit
+      Xoshiro256(brick::common::UInt64 seed);
+
+
+      /**
+       * This constructor sets the seed of the generator, and then
+       * advances it to the start of the specified stream.  It is
+       * equivalent to calling jump() streamIndex times, and
+       * constructing Xoshiro256(seed, ii) for ii = 0, 1, 2, ...
+       * gives the same generators as repeated calls to split().
+       *
+       * @param seed This argument is the seed, as for the single
+       * argument constructor.
+       *
+       * @param streamIndex This argument specifies which stream to
+       * select.  The cost of this constructor grows linearly with
+       * streamIndex, so it is intended for small values, such as
+       * thread indices.
+       */
+      Xoshiro256(brick::common::UInt64 seed,
+                 brick::common::UInt64 streamIndex);
+
+
+      /**
+       * The destructor cleans up any allocated resources.
+       */
+      ~Xoshiro256() {}
+
+
+      /**
+       * This member function fills an array with samples drawn from
+       * a Gaussian distribution.  It produces the same numbers as
+       * calling gaussian() repeatedly, but avoids per-call overhead.
+       *
+       * @param outputArray This argument is the array to be filled.
+       * Its size is not changed.
+       *
+       * @param mu This argument specifies the mean of the
+       * distribution.
+       *
+       * @param sigma This argument specifies the standard deviation
+       * of the distribution.
+       */
+      void
+      fillGaussian(brick::numeric::Array1D<brick::common::Float64>& outputArray,
+                   brick::common::Float64 mu = 0.0,
+                   brick::common::Float64 sigma = 1.0);
+
+
+      /**
+       * This member function fills an array with samples drawn from
+       * a uniform distribution over [lowerBound, upperBound).  It
+       * produces the same numbers as calling uniform(lowerBound,
+       * upperBound) repeatedly.
+       *
+       * @param outputArray This argument is the array to be filled.
+       * Its size is not changed.
+       *
+       * @param lowerBound This argument specifies the lower bound of
+       * the uniform distribution.
+       *
+       * @param upperBound This argument specifies the upper bound of
+       * the uniform distribution.
+       */
+      void
+      fillUniform(brick::numeric::Array1D<brick::common::Float64>& outputArray,
+                  brick::common::Float64 lowerBound = 0.0,
+                  brick::common::Float64 upperBound = 1.0);
+
+
+      /**
+       * This member function fills an array with integers drawn from
+       * a uniform distribution over [lowerBound, upperBound).  It
+       * produces the same numbers as calling uniformInt(lowerBound,
+       * upperBound) repeatedly.
+       *
+       * @param outputArray This argument is the array to be filled.
+       * Its size is not changed.
+       *
+       * @param lowerBound This argument specifies the lower bound of
+       * the uniform distribution.
+       *
+       * @param upperBound This argument specifies the upper bound of
+       * the uniform distribution.  It must be greater than
+       * lowerBound.
+       */
+      void
+      fillUniformInt(brick::numeric::Array1D<brick::common::Int32>& outputArray,
+                     brick::common::Int32 lowerBound,
+                     brick::common::Int32 upperBound);
+
+
+      /**
+       * This member function returns a Float64 drawn from a Gaussian
+       * distribution with the specified mean and standard deviation.
+       *
+       * @param mu This argument specifies the mean of the desired
+       * distribution.
+       *
+       * @param sigma This argument specifies the standard deviation of
+       * the desired distribution.
+       *
+       * @return The return value is a sample drawn from a Gaussian
+       * distribution.
+       */
+      inline brick::common::Float64
+      gaussian(brick::common::Float64 mu, brick::common::Float64 sigma);
+
+
+      /**
+       * This member function advances the generator by 2^128 steps.
+       * It is equivalent to 2^128 calls to operator()(), and is used
+       * to generate non-overlapping subsequences for parallel
+       * computation.
+       */
+      void
+      jump();
+
+
+      /**
+       * This member function advances the generator by 2^192 steps.
+       * It can be used to generate 2^64 starting points, from each
+       * of which jump() will generate 2^64 non-overlapping
+       * subsequences.  This is useful when streams are handed out
+       * hierarchically, for example one per process and then one
+       * per thread.
+       */
+      void
+      longJump();
+
+
+      /**
+       * This member function returns a Float64 drawn from a Gaussian
+       * distribution with mean equal to 0.0 and standard deviation
+       * equal to 1.0.  Samples are generated using the ziggurat
+       * method [2], which usually needs only one 64-bit random
+       * number, one table lookup, and one multiply per sample.
+       *
+       * [2] G. Marsaglia and W. W. Tsang, "The Ziggurat Method for
+       * Generating Random Variables," Journal of Statistical
+       * Software, 5(8), 2000.
+       *
+       * @return The return value is a sample drawn from a normal
+       * distribution.
+       */
+      brick::common::Float64
+      normal();
+
+
+      /**
+       * This member function returns 64 pseudo-random bits, and
+       * advances the generator by one step.
+       *
+       * @return The return value is uniformly distributed over the
+       * full range of UInt64.
+       */
+      inline result_type
+      operator()();
+
+
+      /**
+       * This member function sets the seed for the generator.  See
+       * the single argument constructor for details.
+       *
+       * @param seed This argument is the new seed.
+       */
+      void
+      setCurrentSeed(brick::common::UInt64 seed);
+
+
+      /**
+       * This member function returns a copy of *this, and then
+       * advances *this by calling jump().  Each call returns a
+       * generator for the next non-overlapping stream.
+       *
+       * @return The return value is a generator for the current
+       * stream.
+       */
+      Xoshiro256
+      split();
+
+
+      /**
+       * This member function returns a Float64, x, drawn from a
+       * uniform distribution over [0.0, 1.0).  All 53 bits of the
+       * mantissa are random.
+       *
+       * @return The return value is a sample drawn from a uniform
+       * distribution.
+       */
+      inline brick::common::Float64
+      uniform();
+
+
+      /**
+       * This member function returns a Float64, x, drawn from a
+       * uniform distribution with bounds such that:
+       *
+       *   lowerBound <= x < upperBound
+       *
+       * @param lowerBound This argument specifies the lower bound of
+       * the uniform distribution.
+       *
+       * @param upperBound This argument specifies the upper bound of
+       * the uniform distribution.
+       *
+       * @return The return value is a sample drawn from a uniform
+       * distribution.
+       */
+      inline brick::common::Float64
+      uniform(brick::common::Float64 lowerBound,
+              brick::common::Float64 upperBound);
+
+
+      /**
+       * This member function returns an integer, x, drawn from a
+       * uniform distribution with bounds such that:
+       *
+       *   lowerBound <= x < upperBound
+       *
+       * Unlike PseudoRandom::uniformInt(), the result is exactly
+       * uniform, with no bias toward particular values.
+       *
+       * @param lowerBound This argument specifies the lower bound of
+       * the uniform distribution.
+       *
+       * @param upperBound This argument specifies the upper bound of
+       * the uniform distribution.  It must be greater than
+       * lowerBound, or ValueException will be thrown.
+       *
+       * @return The return value is a sample drawn from a uniform
+       * distribution.
+       */
+      inline brick::common::Int32
+      uniformInt(brick::common::Int32 lowerBound,
+                 brick::common::Int32 upperBound);
+
+
+      /**
+       * This static member function is required by
+       * UniformRandomBitGenerator.
+       *
+       * @return The return value is the smallest value returned by
+       * operator()().
+       */
+      static constexpr result_type
+      min() {return 0;}
+
+
+      /**
+       * This static member function is required by
+       * UniformRandomBitGenerator.
+       *
+       * @return The return value is the largest value returned by
+       * operator()().
+       */
+      static constexpr result_type
+      max() {return ~result_type(0);}
+
+    private:
+
+      // Applies one of the jump polynomials to the generator state.
+      void
+      applyJump(brick::common::UInt64 const* jumpPolynomial);
+
+      // Ziggurat slow path, taken when the candidate sample falls
+      // outside the rectangular part of its layer.
+      brick::common::Float64
+      normalSlowPath(brick::common::UInt64 bits);
+
+      // Returns bits scaled to a Float64 in the range (0.0, 1.0].
+      // Used when the result will be passed to log().
+      inline brick::common::Float64
+      uniformNonzero();
+
+
+      /**
+       * The 256-bit generator state.  It must never be all zero.
+       */
+      brick::common::UInt64 m_state[4];
+
+    }; // class Xoshiro256
+
+  } // namespace random
+
+} // namespace brick
+
+// Include file containing definitions of inline functions.
+#include <brick/random/xoshiro256_impl.hh>
+
+#endif /* #ifndef BRICK_RANDOM_XOSHIRO256_HH */
@@ -0,0 +1,142 @@
+/**
+***************************************************************************
+* @file brick/random/xoshiro256_impl.hh
+*
+* Header file defining inline member functions of the Xoshiro256
+* class.
+*
+* Copyright (C) 2026 David LaRose, dlr@cs.cmu.edu
+* See accompanying file, LICENSE.TXT, for details.
+*
+***************************************************************************
+**/
+
+#ifndef BRICK_RANDOM_XOSHIRO256_IMPL_HH
+#define BRICK_RANDOM_XOSHIRO256_IMPL_HH
+
+// This file is included by xoshiro256.hh, and should not be directly
+// included by user code, so no need to include xoshiro256.hh here.
+//
+// #include <brick/random/xoshiro256.hh>
+
+#include <brick/common/exception.hh>
+
+namespace brick {
+
+  namespace random {
+
+    /// @cond privateCode
+    namespace privateCode {
+
+      inline brick::common::UInt64
+      rotateLeft(brick::common::UInt64 value, int shift)
+      {
+        return (value << shift) | (value >> (64 - shift));
+      }
+
+    } // namespace privateCode
+    /// @endcond
+
+
+    // This member function returns a Float64 drawn from a Gaussian
+    // distribution with the specified mean and standard deviation.
+    inline brick::common::Float64
+    Xoshiro256::
+    gaussian(brick::common::Float64 mu, brick::common::Float64 sigma)
+    {
+      return this->normal() * sigma + mu;
+    }
+
+
+    // This member function returns 64 pseudo-random bits.
+    inline Xoshiro256::result_type
+    Xoshiro256::
+    operator()()
+    {
+      brick::common::UInt64 const result =
+        privateCode::rotateLeft(m_state[0] + m_state[3], 23) + m_state[0];
+      brick::common::UInt64 const temp = m_state[1] << 17;
+      m_state[2] ^= m_state[0];
+      m_state[3] ^= m_state[1];
+      m_state[1] ^= m_state[2];
+      m_state[0] ^= m_state[3];
+      m_state[2] ^= temp;
+      m_state[3] = privateCode::rotateLeft(m_state[3], 45);
+      return result;
+    }
+
+
+    // This member function returns a Float64 drawn from a uniform
+    // distribution over [0.0, 1.0).
+    inline brick::common::Float64
+    Xoshiro256::
+    uniform()
+    {
+      // The top 53 bits fill the mantissa exactly.
+      return static_cast<brick::common::Float64>((*this)() >> 11)
+        * (1.0 / 9007199254740992.0);
+    }
+
+
+    // This member function returns a Float64 drawn from a uniform
+    // distribution over [lowerBound, upperBound).
+    inline brick::common::Float64
+    Xoshiro256::
+    uniform(brick::common::Float64 lowerBound,
+            brick::common::Float64 upperBound)
+    {
+      return this->uniform() * (upperBound - lowerBound) + lowerBound;
+    }
+
+
+    // This member function returns an integer drawn from a uniform
+    // distribution over [lowerBound, upperBound).
+    inline brick::common::Int32
+    Xoshiro256::
+    uniformInt(brick::common::Int32 lowerBound,
+               brick::common::Int32 upperBound)
+    {
+      if(upperBound <= lowerBound) {
+        BRICK_THROW(brick::common::ValueException,
+                    "Xoshiro256::uniformInt()",
+                    "Argument upperBound must be greater than lowerBound.");
+      }
+
+      // Lemire's multiply-and-shift method.  The high 32 bits of
+      // (32 random bits * range) are uniform over [0, range), except
+      // for a small bias, which is removed by rejecting the few
+      // products whose low 32 bits fall below (2^32 % range).
+      brick::common::UInt32 const range = static_cast<brick::common::UInt32>(
+        static_cast<brick::common::Int64>(upperBound) - lowerBound);
+      brick::common::UInt64 product = ((*this)() >> 32) * range;
+      brick::common::UInt32 lowBits =
+        static_cast<brick::common::UInt32>(product);
+      if(lowBits < range) {
+        brick::common::UInt32 const threshold =
+          static_cast<brick::common::UInt32>(-range) % range;
+        while(lowBits < threshold) {
+          product = ((*this)() >> 32) * range;
+          lowBits = static_cast<brick::common::UInt32>(product);
+        }
+      }
+      return static_cast<brick::common::Int32>(
+        static_cast<brick::common::Int64>(lowerBound)
+        + static_cast<brick::common::Int64>(product >> 32));
+    }
+
+
+    // Returns a Float64 drawn from a uniform distribution over
+    // (0.0, 1.0].
+    inline brick::common::Float64
+    Xoshiro256::
+    uniformNonzero()
+    {
+      return static_cast<brick::common::Float64>(((*this)() >> 11) + 1)
+        * (1.0 / 9007199254740992.0);
+    }
+
+  } // namespace random
+
+} // namespace brick
+
+#endif /* #ifndef BRICK_RANDOM_XOSHIRO256_IMPL_HH */
@@ -0,0 +1,444 @@
+/**
+***************************************************************************
+* @file brick/sparse/compressedRowArray2D.hh
+*
+* Header file declaring a compressed sparse row matrix class, and
+* arithmetic routines that operate on it.
+*
+* Copyright (C) 2026 David LaRose, dlr@cs.cmu.edu
+* See accompanying file, LICENSE.TXT, for details.
+*
+***************************************************************************
+**/
+
+#ifndef BRICK_SPARSE_COMPRESSEDROWARRAY2D_HH
+#define BRICK_SPARSE_COMPRESSEDROWARRAY2D_HH
+
+#include <brick/common/exception.hh>
+#include <brick/numeric/array1D.hh>
+#include <brick/numeric/array2D.hh>
+#include <brick/numeric/index2D.hh>
+
+namespace brick {
+
+  namespace sparse {
+
+    /**
+     ** The CompressedRowArray2D class template represents a sparse
+     ** matrix in Compressed Sparse Row (CSR) format.  Nonzero
+     ** elements are stored row by row in two parallel arrays
+     ** (column indices and values), with a third array of size
+     ** (rows + 1) recording where each row starts.  Within each row,
+     ** column indices are strictly increasing.
+     **
+     ** Unlike the dictionary-of-keys sparse::Array2D, this format
+     ** is not designed for incremental modification, but it is
+     ** compact, cache friendly, and supports fast arithmetic.  The
+     ** usual pattern is to collect (row, column, value) triplets,
+     ** build a CompressedRowArray2D from them, and then use the
+     ** matrixMultiply() and transposeMultiply() functions declared
+     ** below.
+     **
+     ** Compressed Sparse Column (CSC) storage of a matrix is
+     ** identical to CSR storage of its transpose, so CSC is
+     ** available through getTranspose(), and transposeMultiply()
+     ** operates directly on the CSR form without an explicit
+     ** transpose when the result is a vector.
+     **
+     ** Like numeric::Array2D, this class does shallow copies.
+     **/
+    template <class Type>
+    class CompressedRowArray2D {
+    public:
+
+      /**
+       ** Typedef for value_type describes the contents of the array.
+       **/
+      typedef Type value_type;
+
+
+      /**
+       * Default constructor initializes to an empty 0x0 matrix.
+       */
+      CompressedRowArray2D();
+
+
+      /**
+       * This constructor creates a matrix of the specified shape,
+       * with no nonzero elements.
+       *
+       * @param rows This argument specifies the number of rows.
+       *
+       * @param columns This argument specifies the number of columns.
+       */
+      CompressedRowArray2D(size_t rows, size_t columns);
+
+
+      /**
+       * This constructor builds a matrix from a list of (row,
+       * column, value) triplets.  The triplets may be in any order,
+       * and if more than one triplet has the same row and column,
+       * their values are summed, as is conventional when assembling
+       * finite element or least squares systems.  Explicit zeros are
+       * kept.
+       *
+       * @param rows This argument specifies the number of rows.
+       *
+       * @param columns This argument specifies the number of columns.
+       *
+       * @param indices This argument specifies the (row, column)
+       * position of each triplet.  All positions must be inside the
+       * matrix, or ValueException will be thrown.
+       *
+       * @param values This argument specifies the value of each
+       * triplet.  It must have the same size as indices.
+       *
+       * @param numberOfThreads This argument specifies how many
+       * threads should share the work.  Setting it to zero uses one
+       * thread per available processor.  The result doesn't depend
+       * on the number of threads.
+       */
+      CompressedRowArray2D(size_t rows, size_t columns,
+                           numeric::Array1D<numeric::Index2D> const& indices,
+                           numeric::Array1D<Type> const& values,
+                           unsigned int numberOfThreads = 1);
+
+
+      /**
+       * This constructor wraps existing CSR arrays without copying
+       * them.  The arrays are checked for consistency, and
+       * ValueException is thrown if they are malformed.
+       *
+       * @param rows This argument specifies the number of rows.
+       *
+       * @param columns This argument specifies the number of columns.
+       *
+       * @param rowPointers This argument must have (rows + 1)
+       * elements.  Element i is the index in columnIndices and
+       * values of the first nonzero of row i, and the last element
+       * is the total number of nonzeros.
+       *
+       * @param columnIndices This argument specifies the column of
+       * each nonzero.  Within each row, column indices must be
+       * strictly increasing.
+       *
+       * @param values This argument specifies the value of each
+       * nonzero.
+       */
+      CompressedRowArray2D(size_t rows, size_t columns,
+                           numeric::Array1D<size_t> const& rowPointers,
+                           numeric::Array1D<size_t> const& columnIndices,
+                           numeric::Array1D<Type> const& values);
+
+
+      /**
+       * This constructor builds a sparse copy of a dense matrix,
+       * keeping only the elements that are not equal to zero.
+       *
+       * @param denseArray This argument is the matrix to be copied.
+       */
+      explicit
+      CompressedRowArray2D(numeric::Array2D<Type> const& denseArray);
+
+
+      /**
+       * The copy constructor does a shallow copy.
+       *
+       * @param source This argument is the instance to be copied.
+       */
+      CompressedRowArray2D(CompressedRowArray2D<Type> const& source);
+
+
+      /**
+       * Destructor.
+       */
+      ~CompressedRowArray2D() {}
+
+
+      /**
+       * This member function returns the number of columns.
+       *
+       * @return The return value is the number of columns.
+       */
+      size_t
+      columns() const {return m_columns;}
+
+
+      /**
+       * This member function returns a deep copy of *this.
+       *
+       * @return The return value is a matrix that shares no data
+       * with *this.
+       */
+      CompressedRowArray2D<Type>
+      copy() const;
+
+
+      /**
+       * This member function returns the CSR array of column
+       * indices.  See the constructor documentation for details.
+       *
+       * @return The return value shares data with *this.
+       */
+      numeric::Array1D<size_t> const&
+      getColumnIndices() const {return m_columnIndices;}
+
+
+      /**
+       * This member function returns a dense copy of *this.
+       *
+       * @return The return value is a rows() x columns() array, with
+       * zeros wherever *this has no stored element.
+       */
+      numeric::Array2D<Type>
+      getDenseArray() const;
+
+
+      /**
+       * This member function returns the value of the specified
+       * element.  It uses a binary search within the row, so it is
+       * not fast, but is convenient for testing.
+       *
+       * @param row This argument specifies the row of the element.
+       *
+       * @param column This argument specifies the column of the
+       * element.
+       *
+       * @return The return value is the element value, or zero if
+       * no value is stored at the specified position.
+       */
+      Type
+      getElement(size_t row, size_t column) const;
+
+
+      /**
+       * This member function returns the number of stored elements.
+       *
+       * @return The return value is the number of stored elements.
+       */
+      size_t
+      getNumberOfNonzeros() const {return m_values.size();}
+
+
+      /**
+       * This member function returns the CSR array of row start
+       * positions.  See the constructor documentation for details.
+       *
+       * @return The return value shares data with *this.
+       */
+      numeric::Array1D<size_t> const&
+      getRowPointers() const {return m_rowPointers;}
+
+
+      /**
+       * This member function returns the transpose of *this.  The
+       * result is equivalent to the CSC representation of *this.
+       *
+       * @return The return value is a columns() x rows() matrix.
+       */
+      CompressedRowArray2D<Type>
+      getTranspose() const;
+
+
+      /**
+       * This member function returns the array of stored values.
+       * Because the returned array shares data with *this, values
+       * can be modified through it.  This is convenient for updating
+       * a matrix whose sparsity pattern doesn't change, such as the
+       * Jacobian of a least squares problem.
+       *
+       * @return The return value shares data with *this.
+       */
+      numeric::Array1D<Type>
+      getValues() const {return m_values;}
+
+
+      /**
+       * This member function returns the number of rows.
+       *
+       * @return The return value is the number of rows.
+       */
+      size_t
+      rows() const {return m_rows;}
+
+
+      /**
+       * The assignment operator does a shallow copy.
+       *
+       * @param source This argument is the instance to be copied.
+       *
+       * @return The return value is a reference to *this.
+       */
+      CompressedRowArray2D<Type>&
+      operator=(CompressedRowArray2D<Type> const& source);
+
+    private:
+
+      void
+      checkConsistency() const;
+
+      size_t m_rows;
+      size_t m_columns;
+      numeric::Array1D<size_t> m_rowPointers;
+      numeric::Array1D<size_t> m_columnIndices;
+      numeric::Array1D<Type> m_values;
+
+    }; // class CompressedRowArray2D
+
+
+    /**
+     * This function computes the product of a sparse matrix and a
+     * dense vector.
+     *
+     * @param matrix0 This argument is the sparse matrix.
+     *
+     * @param vector0 This argument is the vector.  It must have
+     * matrix0.columns() elements.
+     *
+     * @param numberOfThreads This argument specifies how many threads
+     * should share the work.  Setting it to zero uses one thread per
+     * available processor.
+     *
+     * @return The return value is a vector with matrix0.rows()
+     * elements.
+     */
+    template <class Type>
+    numeric::Array1D<Type>
+    matrixMultiply(CompressedRowArray2D<Type> const& matrix0,
+                   numeric::Array1D<Type> const& vector0,
+                   unsigned int numberOfThreads = 1);
+
+
+    /**
+     * This function computes the product of a sparse matrix and a
+     * dense vector, writing into a caller-supplied vector.  Iterative
+     * solvers can use it to avoid allocating a new vector for each
+     * product.
+     *
+     * @param matrix0 This argument is the sparse matrix.
+     *
+     * @param vector0 This argument is the vector.  It must have
+     * matrix0.columns() elements.
+     *
+     * @param result This argument returns the product.  If its size
+     * doesn't match matrix0.rows(), it will be reinitialized.  It
+     * must not share data with vector0.
+     *
+     * @param numberOfThreads This argument specifies how many threads
+     * should share the work.  Setting it to zero uses one thread per
+     * available processor.
+     */
+    template <class Type>
+    void
+    matrixMultiply(CompressedRowArray2D<Type> const& matrix0,
+                   numeric::Array1D<Type> const& vector0,
+                   numeric::Array1D<Type>& result,
+                   unsigned int numberOfThreads = 1);
+
+
+    /**
+     * This function computes the product of a sparse matrix and a
+     * dense matrix.
+     *
+     * @param matrix0 This argument is the sparse matrix.
+     *
+     * @param matrix1 This argument is the dense matrix.  It must have
+     * matrix0.columns() rows.
+     *
+     * @param numberOfThreads This argument specifies how many threads
+     * should share the work.  Setting it to zero uses one thread per
+     * available processor.
+     *
+     * @return The return value is a dense matrix with matrix0.rows()
+     * rows and matrix1.columns() columns.
+     */
+    template <class Type>
+    numeric::Array2D<Type>
+    matrixMultiply(CompressedRowArray2D<Type> const& matrix0,
+                   numeric::Array2D<Type> const& matrix1,
+                   unsigned int numberOfThreads = 1);
+
+
+    /**
+     * This function computes the product of two sparse matrices,
+     * using Gustavson's row-by-row algorithm.
+     *
+     * @param matrix0 This argument is the first factor.
+     *
+     * @param matrix1 This argument is the second factor.  It must
+     * have matrix0.columns() rows.
+     *
+     * @param numberOfThreads This argument specifies how many threads
+     * should share the work.  Setting it to zero uses one thread per
+     * available processor.
+     *
+     * @return The return value is a sparse matrix with
+     * matrix0.rows() rows and matrix1.columns() columns.
+     */
+    template <class Type>
+    CompressedRowArray2D<Type>
+    matrixMultiply(CompressedRowArray2D<Type> const& matrix0,
+                   CompressedRowArray2D<Type> const& matrix1,
+                   unsigned int numberOfThreads = 1);
+
+
+    /**
+     * This function computes the product of the transpose of a
+     * sparse matrix and a dense vector, without forming the
+     * transpose.  For a Jacobian J and residual vector r, this
+     * computes the gradient term J^T * r.
+     *
+     * @param matrix0 This argument is the sparse matrix.
+     *
+     * @param vector0 This argument is the vector.  It must have
+     * matrix0.rows() elements.
+     *
+     * @param numberOfThreads This argument specifies how many threads
+     * should share the work.  Setting it to zero uses one thread per
+     * available processor.  Each thread needs a temporary vector of
+     * matrix0.columns() elements.
+     *
+     * @return The return value is a vector with matrix0.columns()
+     * elements.
+     */
+    template <class Type>
+    numeric::Array1D<Type>
+    transposeMultiply(CompressedRowArray2D<Type> const& matrix0,
+                      numeric::Array1D<Type> const& vector0,
+                      unsigned int numberOfThreads = 1);
+
+
+    /**
+     * This function computes the product of the transpose of one
+     * sparse matrix with another.  For a Jacobian J, calling
+     * transposeMultiply(J, J) computes the Gauss-Newton normal
+     * matrix J^T * J.
+     *
+     * @param matrix0 This argument is the matrix to be transposed.
+     *
+     * @param matrix1 This argument is the second factor.  It must
+     * have matrix0.rows() rows.
+     *
+     * @param numberOfThreads This argument specifies how many threads
+     * should share the work.  Setting it to zero uses one thread per
+     * available processor.
+     *
+     * @return The return value is a sparse matrix with
+     * matrix0.columns() rows and matrix1.columns() columns.
+     */
+    template <class Type>
+    CompressedRowArray2D<Type>
+    transposeMultiply(CompressedRowArray2D<Type> const& matrix0,
+                      CompressedRowArray2D<Type> const& matrix1,
+                      unsigned int numberOfThreads = 1);
+
+  } // namespace sparse
+
+} // namespace brick
+
+
+// Include file containing definitions of inline and template
+// functions.
+#include <brick/sparse/compressedRowArray2D_impl.hh>
+
+#endif /* #ifndef BRICK_SPARSE_COMPRESSEDROWARRAY2D_HH */
@@ -0,0 +1,700 @@
+/**
+***************************************************************************
+* @file brick/sparse/compressedRowArray2D_impl.hh
+*
+* Header file defining inline and template functions declared in
+* compressedRowArray2D.hh.
+*
+* Copyright (C) 2026 David LaRose, dlr@cs.cmu.edu
+* See accompanying file, LICENSE.TXT, for details.
+*
+***************************************************************************
+**/
+
+#ifndef BRICK_SPARSE_COMPRESSEDROWARRAY2D_IMPL_HH
+#define BRICK_SPARSE_COMPRESSEDROWARRAY2D_IMPL_HH
+
+// This file is included by compressedRowArray2D.hh, and should not
+// be directly included by user code, so no need to include
+// compressedRowArray2D.hh here.
+//
+// #include <brick/sparse/compressedRowArray2D.hh>
+
+#include <algorithm>
+#include <sstream>
+#include <utility>
+#include <vector>
+#include <brick/common/parallelFor.hh>
+
+namespace brick {
+
+  namespace sparse {
+
+    /// @cond privateCode
+    namespace privateCode {
+
+      // Sort the entries of one row by column index, and sum any
+      // entries that share a column.  Returns the number of distinct
+      // columns, which are left at the start of the range.
+      template <class Type>
+      size_t
+      sortAndMergeRow(size_t* columnPtr, Type* valuePtr, size_t size)
+      {
+        if(size == 0) {
+          return 0;
+        }
+
+        // Rows are usually short, so insertion sort is fast, and it
+        // is stable, so duplicates are summed in input order
+        // regardless of thread count.
+        for(size_t ii = 1; ii < size; ++ii) {
+          size_t column = columnPtr[ii];
+          Type value = valuePtr[ii];
+          size_t jj = ii;
+          while(jj > 0 && columnPtr[jj - 1] > column) {
+            columnPtr[jj] = columnPtr[jj - 1];
+            valuePtr[jj] = valuePtr[jj - 1];
+            --jj;
+          }
+          columnPtr[jj] = column;
+          valuePtr[jj] = value;
+        }
+
+        size_t outputIndex = 0;
+        for(size_t ii = 1; ii < size; ++ii) {
+          if(columnPtr[ii] == columnPtr[outputIndex]) {
+            valuePtr[outputIndex] += valuePtr[ii];
+          } else {
+            ++outputIndex;
+            columnPtr[outputIndex] = columnPtr[ii];
+            valuePtr[outputIndex] = valuePtr[ii];
+          }
+        }
+        return outputIndex + 1;
+      }
+
+    } // namespace privateCode
+    /// @endcond
+
+
+    template <class Type>
+    CompressedRowArray2D<Type>::
+    CompressedRowArray2D()
+      : m_rows(0),
+        m_columns(0),
+        m_rowPointers(1),
+        m_columnIndices(0),
+        m_values(0)
+    {
+      m_rowPointers[0] = 0;
+    }
+
+
+    template <class Type>
+    CompressedRowArray2D<Type>::
+    CompressedRowArray2D(size_t rows, size_t columns)
+      : m_rows(rows),
+        m_columns(columns),
+        m_rowPointers(rows + 1),
+        m_columnIndices(0),
+        m_values(0)
+    {
+      m_rowPointers = 0;
+    }
+
+
+    template <class Type>
+    CompressedRowArray2D<Type>::
+    CompressedRowArray2D(size_t rows, size_t columns,
+                         numeric::Array1D<numeric::Index2D> const& indices,
+                         numeric::Array1D<Type> const& values,
+                         unsigned int numberOfThreads)
+      : m_rows(rows),
+        m_columns(columns),
+        m_rowPointers(rows + 1),
+        m_columnIndices(),
+        m_values()
+    {
+      if(indices.size() != values.size()) {
+        std::ostringstream message;
+        message << "Arguments indices and values must have the same size, "
+                << "but have sizes " << indices.size() << " and "
+                << values.size() << ".";
+        BRICK_THROW(common::ValueException,
+                    "CompressedRowArray2D::CompressedRowArray2D()",
+                    message.str().c_str());
+      }
+
+      // This is a parallel counting sort by row.  First each band
+      // of triplets counts how many entries it has in each row.
+      size_t const numberOfTriplets = indices.size();
+      size_t const numberOfBands =
+        common::getNumberOfBands(numberOfTriplets, numberOfThreads);
+      std::vector< std::vector<size_t> > bandOffsets(
+        numberOfBands, std::vector<size_t>(rows, 0));
+      common::parallelFor(
+        0, numberOfTriplets, numberOfBands,
+        [&](size_t bandBegin, size_t bandEnd, size_t bandIndex) {
+          std::vector<size_t>& counts = bandOffsets[bandIndex];
+          for(size_t ii = bandBegin; ii < bandEnd; ++ii) {
+            int row = indices[ii].getRow();
+            int column = indices[ii].getColumn();
+            if(row < 0 || static_cast<size_t>(row) >= rows
+               || column < 0 || static_cast<size_t>(column) >= columns) {
+              std::ostringstream message;
+              message << "Triplet " << ii << " has index (" << row
+                      << ", " << column << "), which is outside of a "
+                      << rows << " x " << columns << " matrix.";
+              BRICK_THROW(common::ValueException,
+                          "CompressedRowArray2D::CompressedRowArray2D()",
+                          message.str().c_str());
+            }
+            ++counts[row];
+          }
+        });
+
+      // Convert counts to starting offsets.  Band order within each
+      // row preserves the input order of the triplets.
+      numeric::Array1D<size_t> rowStarts(rows + 1);
+      size_t runningTotal = 0;
+      for(size_t row = 0; row < rows; ++row) {
+        rowStarts[row] = runningTotal;
+        for(size_t band = 0; band < numberOfBands; ++band) {
+          size_t count = bandOffsets[band][row];
+          bandOffsets[band][row] = runningTotal;
+          runningTotal += count;
+        }
+      }
+      rowStarts[rows] = runningTotal;
+
+      // Scatter the triplets into row order.
+      numeric::Array1D<size_t> scatteredColumns(numberOfTriplets);
+      numeric::Array1D<Type> scatteredValues(numberOfTriplets);
+      common::parallelFor(
+        0, numberOfTriplets, numberOfBands,
+        [&](size_t bandBegin, size_t bandEnd, size_t bandIndex) {
+          std::vector<size_t>& offsets = bandOffsets[bandIndex];
+          for(size_t ii = bandBegin; ii < bandEnd; ++ii) {
+            size_t position = offsets[indices[ii].getRow()]++;
+            scatteredColumns[position] = indices[ii].getColumn();
+            scatteredValues[position] = values[ii];
+          }
+        });
+
+      // Sort each row by column and merge duplicates.
+      numeric::Array1D<size_t> rowSizes(rows);
+      common::parallelFor(
+        0, rows, numberOfThreads,
+        [&](size_t bandBegin, size_t bandEnd, size_t /* bandIndex */) {
+          for(size_t row = bandBegin; row < bandEnd; ++row) {
+            size_t start = rowStarts[row];
+            rowSizes[row] = privateCode::sortAndMergeRow(
+              scatteredColumns.data() + start, scatteredValues.data() + start,
+              rowStarts[row + 1] - start);
+          }
+        });
+
+      // If there were no duplicates, the scattered arrays are the
+      // final answer.  Otherwise, compact them.
+      m_rowPointers[0] = 0;
+      for(size_t row = 0; row < rows; ++row) {
+        m_rowPointers[row + 1] = m_rowPointers[row] + rowSizes[row];
+      }
+      if(m_rowPointers[rows] == numberOfTriplets) {
+        m_columnIndices = scatteredColumns;
+        m_values = scatteredValues;
+        return;
+      }
+      m_columnIndices.reinit(m_rowPointers[rows]);
+      m_values.reinit(m_rowPointers[rows]);
+      common::parallelFor(
+        0, rows, numberOfThreads,
+        [&](size_t bandBegin, size_t bandEnd, size_t /* bandIndex */) {
+          for(size_t row = bandBegin; row < bandEnd; ++row) {
+            std::copy(scatteredColumns.data() + rowStarts[row],
+                      scatteredColumns.data() + rowStarts[row] + rowSizes[row],
+                      m_columnIndices.data() + m_rowPointers[row]);
+            std::copy(scatteredValues.data() + rowStarts[row],
+                      scatteredValues.data() + rowStarts[row] + rowSizes[row],
+                      m_values.data() + m_rowPointers[row]);
+          }
+        });
+    }
+
+
+    template <class Type>
+    CompressedRowArray2D<Type>::
+    CompressedRowArray2D(size_t rows, size_t columns,
+                         numeric::Array1D<size_t> const& rowPointers,
+                         numeric::Array1D<size_t> const& columnIndices,
+                         numeric::Array1D<Type> const& values)
+      : m_rows(rows),
+        m_columns(columns),
+        m_rowPointers(rowPointers),
+        m_columnIndices(columnIndices),
+        m_values(values)
+    {
+      this->checkConsistency();
+    }
+
+
+    template <class Type>
+    CompressedRowArray2D<Type>::
+    CompressedRowArray2D(numeric::Array2D<Type> const& denseArray)
+      : m_rows(denseArray.rows()),
+        m_columns(denseArray.columns()),
+        m_rowPointers(denseArray.rows() + 1),
+        m_columnIndices(),
+        m_values()
+    {
+      // Count first, so that we only allocate once.
+      size_t numberOfNonzeros = 0;
+      for(size_t row = 0; row < m_rows; ++row) {
+        Type const* rowPtr = denseArray.data(row, 0);
+        for(size_t column = 0; column < m_columns; ++column) {
+          if(rowPtr[column] != Type(0)) {
+            ++numberOfNonzeros;
+          }
+        }
+      }
+      m_columnIndices.reinit(numberOfNonzeros);
+      m_values.reinit(numberOfNonzeros);
+
+      size_t position = 0;
+      for(size_t row = 0; row < m_rows; ++row) {
+        m_rowPointers[row] = position;
+        Type const* rowPtr = denseArray.data(row, 0);
+        for(size_t column = 0; column < m_columns; ++column) {
+          if(rowPtr[column] != Type(0)) {
+            m_columnIndices[position] = column;
+            m_values[position] = rowPtr[column];
+            ++position;
+          }
+        }
+      }
+      m_rowPointers[m_rows] = position;
+    }
+
+
+    template <class Type>
+    CompressedRowArray2D<Type>::
+    CompressedRowArray2D(CompressedRowArray2D<Type> const& source)
+      : m_rows(source.m_rows),
+        m_columns(source.m_columns),
+        m_rowPointers(source.m_rowPointers),
+        m_columnIndices(source.m_columnIndices),
+        m_values(source.m_values)
+    {
+      // Empty.
+    }
+
+
+    template <class Type>
+    CompressedRowArray2D<Type>
+    CompressedRowArray2D<Type>::
+    copy() const
+    {
+      return CompressedRowArray2D<Type>(
+        m_rows, m_columns, m_rowPointers.copy(), m_columnIndices.copy(),
+        m_values.copy());
+    }
+
+
+    template <class Type>
+    numeric::Array2D<Type>
+    CompressedRowArray2D<Type>::
+    getDenseArray() const
+    {
+      numeric::Array2D<Type> result(m_rows, m_columns);
+      result = Type(0);
+      for(size_t row = 0; row < m_rows; ++row) {
+        Type* rowPtr = result.data(row, 0);
+        for(size_t ii = m_rowPointers[row]; ii < m_rowPointers[row + 1];
+            ++ii) {
+          rowPtr[m_columnIndices[ii]] = m_values[ii];
+        }
+      }
+      return result;
+    }
+
+
+    template <class Type>
+    Type
+    CompressedRowArray2D<Type>::
+    getElement(size_t row, size_t column) const
+    {
+      if(row >= m_rows || column >= m_columns) {
+        std::ostringstream message;
+        message << "Index (" << row << ", " << column << ") is out of "
+                << "bounds for a " << m_rows << " x " << m_columns
+                << " matrix.";
+        BRICK_THROW(common::IndexException,
+                    "CompressedRowArray2D::getElement()",
+                    message.str().c_str());
+      }
+      size_t const* beginPtr = m_columnIndices.data() + m_rowPointers[row];
+      size_t const* endPtr = m_columnIndices.data() + m_rowPointers[row + 1];
+      size_t const* position = std::lower_bound(beginPtr, endPtr, column);
+      if(position == endPtr || *position != column) {
+        return Type(0);
+      }
+      return m_values[position - m_columnIndices.data()];
+    }
+
+
+    template <class Type>
+    CompressedRowArray2D<Type>
+    CompressedRowArray2D<Type>::
+    getTranspose() const
+    {
+      // Counting sort by column.  Visiting rows in order leaves the
+      // column indices of the transpose sorted.
+      size_t const numberOfNonzeros = m_values.size();
+      numeric::Array1D<size_t> rowPointers(m_columns + 1);
+      rowPointers = 0;
+      for(size_t ii = 0; ii < numberOfNonzeros; ++ii) {
+        ++rowPointers[m_columnIndices[ii] + 1];
+      }
+      for(size_t column = 0; column < m_columns; ++column) {
+        rowPointers[column + 1] += rowPointers[column];
+      }
+
+      numeric::Array1D<size_t> nextPosition = rowPointers.copy();
+      numeric::Array1D<size_t> columnIndices(numberOfNonzeros);
+      numeric::Array1D<Type> values(numberOfNonzeros);
+      for(size_t row = 0; row < m_rows; ++row) {
+        for(size_t ii = m_rowPointers[row]; ii < m_rowPointers[row + 1];
+            ++ii) {
+          size_t position = nextPosition[m_columnIndices[ii]]++;
+          columnIndices[position] = row;
+          values[position] = m_values[ii];
+        }
+      }
+      return CompressedRowArray2D<Type>(
+        m_columns, m_rows, rowPointers, columnIndices, values);
+    }
+
+
+    template <class Type>
+    CompressedRowArray2D<Type>&
+    CompressedRowArray2D<Type>::
+    operator=(CompressedRowArray2D<Type> const& source)
+    {
+      if(&source != this) {
+        m_rows = source.m_rows;
+        m_columns = source.m_columns;
+        m_rowPointers = source.m_rowPointers;
+        m_columnIndices = source.m_columnIndices;
+        m_values = source.m_values;
+      }
+      return *this;
+    }
+
+
+    template <class Type>
+    void
+    CompressedRowArray2D<Type>::
+    checkConsistency() const
+    {
+      std::ostringstream message;
+      if(m_rowPointers.size() != m_rows + 1) {
+        message << "Row pointer array should have " << m_rows + 1
+                << " elements, but has " << m_rowPointers.size() << ".";
+      } else if(m_columnIndices.size() != m_values.size()) {
+        message << "Column index array and value array have different "
+                << "sizes (" << m_columnIndices.size() << " and "
+                << m_values.size() << ").";
+      } else if(m_rowPointers[0] != 0
+                || m_rowPointers[m_rows] != m_values.size()) {
+        message << "Row pointer array should start at 0 and end at "
+                << m_values.size() << ".";
+      } else {
+        for(size_t row = 0; row < m_rows; ++row) {
+          if(m_rowPointers[row + 1] < m_rowPointers[row]) {
+            message << "Row pointers decrease at row " << row << ".";
+            break;
+          }
+          for(size_t ii = m_rowPointers[row]; ii < m_rowPointers[row + 1];
+              ++ii) {
+            if(m_columnIndices[ii] >= m_columns
+               || (ii != m_rowPointers[row]
+                   && m_columnIndices[ii] <= m_columnIndices[ii - 1])) {
+              message << "Column indices of row " << row << " are out of "
+                      << "range or not strictly increasing.";
+              break;
+            }
+          }
+          if(!message.str().empty()) {
+            break;
+          }
+        }
+      }
+      if(!message.str().empty()) {
+        BRICK_THROW(common::ValueException,
+                    "CompressedRowArray2D::checkConsistency()",
+                    message.str().c_str());
+      }
+    }
+
+
+    /* ============== Non-member functions ============== */
+
+    template <class Type>
+    numeric::Array1D<Type>
+    matrixMultiply(CompressedRowArray2D<Type> const& matrix0,
+                   numeric::Array1D<Type> const& vector0,
+                   unsigned int numberOfThreads)
+    {
+      numeric::Array1D<Type> result(matrix0.rows());
+      matrixMultiply(matrix0, vector0, result, numberOfThreads);
+      return result;
+    }
+
+
+    template <class Type>
+    void
+    matrixMultiply(CompressedRowArray2D<Type> const& matrix0,
+                   numeric::Array1D<Type> const& vector0,
+                   numeric::Array1D<Type>& result,
+                   unsigned int numberOfThreads)
+    {
+      if(vector0.size() != matrix0.columns()) {
+        std::ostringstream message;
+        message << "Can't multiply a " << matrix0.rows() << " x "
+                << matrix0.columns() << " matrix by a vector of size "
+                << vector0.size() << ".";
+        BRICK_THROW(common::ValueException, "matrixMultiply()",
+                    message.str().c_str());
+      }
+      if(result.size() != matrix0.rows()) {
+        result.reinit(matrix0.rows());
+      }
+      size_t const* rowPointers = matrix0.getRowPointers().data();
+      size_t const* columnIndices = matrix0.getColumnIndices().data();
+      Type const* values = matrix0.getValues().data();
+      Type const* inputPtr = vector0.data();
+      Type* outputPtr = result.data();
+      common::parallelFor(
+        0, matrix0.rows(), numberOfThreads,
+        [&](size_t bandBegin, size_t bandEnd, size_t /* bandIndex */) {
+          for(size_t row = bandBegin; row < bandEnd; ++row) {
+            Type sum = Type(0);
+            for(size_t ii = rowPointers[row]; ii < rowPointers[row + 1];
+                ++ii) {
+              sum += values[ii] * inputPtr[columnIndices[ii]];
+            }
+            outputPtr[row] = sum;
+          }
+        });
+    }
+
+
+    template <class Type>
+    numeric::Array2D<Type>
+    matrixMultiply(CompressedRowArray2D<Type> const& matrix0,
+                   numeric::Array2D<Type> const& matrix1,
+                   unsigned int numberOfThreads)
+    {
+      if(matrix1.rows() != matrix0.columns()) {
+        std::ostringstream message;
+        message << "Can't multiply a " << matrix0.rows() << " x "
+                << matrix0.columns() << " matrix by a " << matrix1.rows()
+                << " x " << matrix1.columns() << " matrix.";
+        BRICK_THROW(common::ValueException, "matrixMultiply()",
+                    message.str().c_str());
+      }
+      size_t const outputColumns = matrix1.columns();
+      numeric::Array2D<Type> result(matrix0.rows(), outputColumns);
+      size_t const* rowPointers = matrix0.getRowPointers().data();
+      size_t const* columnIndices = matrix0.getColumnIndices().data();
+      Type const* values = matrix0.getValues().data();
+      common::parallelFor(
+        0, matrix0.rows(), numberOfThreads,
+        [&](size_t bandBegin, size_t bandEnd, size_t /* bandIndex */) {
+          for(size_t row = bandBegin; row < bandEnd; ++row) {
+            // Each output row is a weighted sum of input rows.
+            Type* outputPtr = result.data(row, 0);
+            std::fill(outputPtr, outputPtr + outputColumns, Type(0));
+            for(size_t ii = rowPointers[row]; ii < rowPointers[row + 1];
+                ++ii) {
+              Type const weight = values[ii];
+              Type const* inputPtr = matrix1.data(columnIndices[ii], 0);
+              for(size_t column = 0; column < outputColumns; ++column) {
+                outputPtr[column] += weight * inputPtr[column];
+              }
+            }
+          }
+        });
+      return result;
+    }
+
+
+    template <class Type>
+    CompressedRowArray2D<Type>
+    matrixMultiply(CompressedRowArray2D<Type> const& matrix0,
+                   CompressedRowArray2D<Type> const& matrix1,
+                   unsigned int numberOfThreads)
+    {
+      if(matrix1.rows() != matrix0.columns()) {
+        std::ostringstream message;
+        message << "Can't multiply a " << matrix0.rows() << " x "
+                << matrix0.columns() << " matrix by a " << matrix1.rows()
+                << " x " << matrix1.columns() << " matrix.";
+        BRICK_THROW(common::ValueException, "matrixMultiply()",
+                    message.str().c_str());
+      }
+      size_t const outputRows = matrix0.rows();
+      size_t const outputColumns = matrix1.columns();
+      size_t const* rowPointers0 = matrix0.getRowPointers().data();
+      size_t const* columnIndices0 = matrix0.getColumnIndices().data();
+      Type const* values0 = matrix0.getValues().data();
+      size_t const* rowPointers1 = matrix1.getRowPointers().data();
+      size_t const* columnIndices1 = matrix1.getColumnIndices().data();
+      Type const* values1 = matrix1.getValues().data();
+
+      // Gustavson's algorithm needs two passes: the first counts
+      // the nonzeros of each output row, and the second fills them
+      // in.  Each band keeps a dense marker array so that finding
+      // the union of column patterns is linear in the work done.
+      numeric::Array1D<size_t> rowPointers(outputRows + 1);
+      size_t const numberOfBands =
+        common::getNumberOfBands(outputRows, numberOfThreads);
+      common::parallelFor(
+        0, outputRows, numberOfBands,
+        [&](size_t bandBegin, size_t bandEnd, size_t /* bandIndex */) {
+          std::vector<size_t> lastRowSeen(outputColumns, outputRows);
+          for(size_t row = bandBegin; row < bandEnd; ++row) {
+            size_t count = 0;
+            for(size_t ii = rowPointers0[row]; ii < rowPointers0[row + 1];
+                ++ii) {
+              size_t middle = columnIndices0[ii];
+              for(size_t jj = rowPointers1[middle];
+                  jj < rowPointers1[middle + 1]; ++jj) {
+                if(lastRowSeen[columnIndices1[jj]] != row) {
+                  lastRowSeen[columnIndices1[jj]] = row;
+                  ++count;
+                }
+              }
+            }
+            rowPointers[row + 1] = count;
+          }
+        });
+      rowPointers[0] = 0;
+      for(size_t row = 0; row < outputRows; ++row) {
+        rowPointers[row + 1] += rowPointers[row];
+      }
+
+      numeric::Array1D<size_t> columnIndices(rowPointers[outputRows]);
+      numeric::Array1D<Type> values(rowPointers[outputRows]);
+      common::parallelFor(
+        0, outputRows, numberOfBands,
+        [&](size_t bandBegin, size_t bandEnd, size_t /* bandIndex */) {
+          std::vector<Type> accumulator(outputColumns, Type(0));
+          std::vector<bool> isOccupied(outputColumns, false);
+          for(size_t row = bandBegin; row < bandEnd; ++row) {
+            size_t* rowColumns = columnIndices.data() + rowPointers[row];
+            size_t count = 0;
+            for(size_t ii = rowPointers0[row]; ii < rowPointers0[row + 1];
+                ++ii) {
+              size_t middle = columnIndices0[ii];
+              Type weight = values0[ii];
+              for(size_t jj = rowPointers1[middle];
+                  jj < rowPointers1[middle + 1]; ++jj) {
+                size_t column = columnIndices1[jj];
+                if(!isOccupied[column]) {
+                  isOccupied[column] = true;
+                  rowColumns[count++] = column;
+                }
+                accumulator[column] += weight * values1[jj];
+              }
+            }
+            std::sort(rowColumns, rowColumns + count);
+            Type* rowValues = values.data() + rowPointers[row];
+            for(size_t ii = 0; ii < count; ++ii) {
+              rowValues[ii] = accumulator[rowColumns[ii]];
+              accumulator[rowColumns[ii]] = Type(0);
+              isOccupied[rowColumns[ii]] = false;
+            }
+          }
+        });
+
+      return CompressedRowArray2D<Type>(
+        outputRows, outputColumns, rowPointers, columnIndices, values);
+    }
+
+
+    template <class Type>
+    numeric::Array1D<Type>
+    transposeMultiply(CompressedRowArray2D<Type> const& matrix0,
+                      numeric::Array1D<Type> const& vector0,
+                      unsigned int numberOfThreads)
+    {
+      if(vector0.size() != matrix0.rows()) {
+        std::ostringstream message;
+        message << "Can't multiply the transpose of a " << matrix0.rows()
+                << " x " << matrix0.columns() << " matrix by a vector of "
+                << "size " << vector0.size() << ".";
+        BRICK_THROW(common::ValueException, "transposeMultiply()",
+                    message.str().c_str());
+      }
+
+      // Each band of rows scatters into its own accumulator, and the
+      // accumulators are summed at the end.  Band 0 accumulates
+      // directly into the result.
+      size_t const columns = matrix0.columns();
+      size_t const numberOfBands =
+        common::getNumberOfBands(matrix0.rows(), numberOfThreads);
+      numeric::Array1D<Type> result(columns);
+      result = Type(0);
+      std::vector< std::vector<Type> > partialSums(numberOfBands - 1);
+      size_t const* rowPointers = matrix0.getRowPointers().data();
+      size_t const* columnIndices = matrix0.getColumnIndices().data();
+      Type const* values = matrix0.getValues().data();
+      common::parallelFor(
+        0, matrix0.rows(), numberOfBands,
+        [&](size_t bandBegin, size_t bandEnd, size_t bandIndex) {
+          Type* outputPtr = result.data();
+          if(bandIndex != 0) {
+            partialSums[bandIndex - 1].resize(columns, Type(0));
+            outputPtr = &(partialSums[bandIndex - 1][0]);
+          }
+          for(size_t row = bandBegin; row < bandEnd; ++row) {
+            Type const weight = vector0[row];
+            for(size_t ii = rowPointers[row]; ii < rowPointers[row + 1];
+                ++ii) {
+              outputPtr[columnIndices[ii]] += values[ii] * weight;
+            }
+          }
+        });
+      for(size_t band = 0; band < partialSums.size(); ++band) {
+        for(size_t column = 0; column < columns; ++column) {
+          result[column] += partialSums[band][column];
+        }
+      }
+      return result;
+    }
+
+
+    template <class Type>
+    CompressedRowArray2D<Type>
+    transposeMultiply(CompressedRowArray2D<Type> const& matrix0,
+                      CompressedRowArray2D<Type> const& matrix1,
+                      unsigned int numberOfThreads)
+    {
+      if(matrix1.rows() != matrix0.rows()) {
+        std::ostringstream message;
+        message << "Can't multiply the transpose of a " << matrix0.rows()
+                << " x " << matrix0.columns() << " matrix by a "
+                << matrix1.rows() << " x " << matrix1.columns()
+                << " matrix.";
+        BRICK_THROW(common::ValueException, "transposeMultiply()",
+                    message.str().c_str());
+      }
+      return matrixMultiply(matrix0.getTranspose(), matrix1, numberOfThreads);
+    }
+
+  } // namespace sparse
+
+} // namespace brick
+
+#endif /* #ifndef BRICK_SPARSE_COMPRESSEDROWARRAY2D_IMPL_HH */
@@ -0,0 +1,86 @@
+/**
+***************************************************************************
+* @file brick/sparse/conjugateGradient.hh
+*
+* Header file declaring an iterative solver for sparse symmetric
+* positive definite linear systems.
+*
+* Copyright (C) 2026 David LaRose, dlr@cs.cmu.edu
+* See accompanying file, LICENSE.TXT, for details.
+*
+***************************************************************************
+**/
+
+#ifndef BRICK_SPARSE_CONJUGATEGRADIENT_HH
+#define BRICK_SPARSE_CONJUGATEGRADIENT_HH
+
+#include <brick/numeric/array1D.hh>
+#include <brick/sparse/compressedRowArray2D.hh>
+
+namespace brick {
+
+  namespace sparse {
+
+    /**
+     * This function solves the linear system A * x = b, where A is
+     * a sparse symmetric positive definite matrix, using the
+     * preconditioned conjugate gradient method with a Jacobi
+     * (diagonal) preconditioner.  A typical use is solving the
+     * Gauss-Newton normal equations (J^T * J) * dx = J^T * r, with
+     * the normal matrix computed by transposeMultiply().
+     *
+     * Only matrix-vector products with A are needed, so the cost per
+     * iteration is proportional to the number of nonzeros of A, and
+     * no fill-in is created.  The number of iterations depends on
+     * the conditioning of A.
+     *
+     * @param matrixA This argument is the system matrix.  It must be
+     * square and symmetric, with strictly positive diagonal
+     * elements.  Symmetry is not checked.
+     *
+     * @param vectorB This argument is the right hand side.  It must
+     * have matrixA.rows() elements.
+     *
+     * @param vectorX This argument is the initial guess, and is used
+     * to return the solution.  If its size doesn't match
+     * matrixA.columns(), it is reinitialized to a vector of zeros.
+     *
+     * @param relativeTolerance This argument specifies when to stop.
+     * Iteration terminates when the norm of the residual, (b - A *
+     * x), is no larger than relativeTolerance times the norm of b.
+     *
+     * @param maximumIterations This argument limits the number of
+     * iterations.  If it is zero, 10 * matrixA.rows() is used.
+     * matrixA.rows() iterations would be enough in exact
+     * arithmetic, but in floating point, ill-conditioned systems
+     * often need several times that many.  If the tolerance is not
+     * reached within this many iterations, RunTimeException is
+     * thrown, and vectorX holds the last iterate.  Callers that
+     * need a tighter bound on run time should pass an explicit
+     * limit.
+     *
+     * @param numberOfThreads This argument specifies how many
+     * threads should share the matrix-vector products.  Setting it
+     * to zero uses one thread per available processor.
+     *
+     * @return The return value is the number of iterations taken.
+     */
+    template <class Type>
+    size_t
+    solveConjugateGradient(CompressedRowArray2D<Type> const& matrixA,
+                           numeric::Array1D<Type> const& vectorB,
+                           numeric::Array1D<Type>& vectorX,
+                           Type relativeTolerance = Type(1.0E-10),
+                           size_t maximumIterations = 0,
+                           unsigned int numberOfThreads = 1);
+
+  } // namespace sparse
+
+} // namespace brick
+
+
+// Include file containing definitions of inline and template
+// functions.
+#include <brick/sparse/conjugateGradient_impl.hh>
+
+#endif /* #ifndef BRICK_SPARSE_CONJUGATEGRADIENT_HH */
@@ -0,0 +1,152 @@
+/**
+***************************************************************************
+* @file brick/sparse/conjugateGradient_impl.hh
+*
+* Header file defining template functions declared in
+* conjugateGradient.hh.
+*
+* Copyright (C) 2026 David LaRose, dlr@cs.cmu.edu
+* See accompanying file, LICENSE.TXT, for details.
+*
+***************************************************************************
+**/
+
+#ifndef BRICK_SPARSE_CONJUGATEGRADIENT_IMPL_HH
+#define BRICK_SPARSE_CONJUGATEGRADIENT_IMPL_HH
+
+// This file is included by conjugateGradient.hh, and should not be
+// directly included by user code, so no need to include
+// conjugateGradient.hh here.
+//
+// #include <brick/sparse/conjugateGradient.hh>
+
+#include <cmath>
+#include <sstream>
+#include <brick/common/exception.hh>
+
+namespace brick {
+
+  namespace sparse {
+
+    template <class Type>
+    size_t
+    solveConjugateGradient(CompressedRowArray2D<Type> const& matrixA,
+                           numeric::Array1D<Type> const& vectorB,
+                           numeric::Array1D<Type>& vectorX,
+                           Type relativeTolerance,
+                           size_t maximumIterations,
+                           unsigned int numberOfThreads)
+    {
+      size_t const size = matrixA.rows();
+      if(matrixA.columns() != size || vectorB.size() != size) {
+        std::ostringstream message;
+        message << "Matrix must be square, and right hand side must match, "
+                << "but matrix is " << matrixA.rows() << " x "
+                << matrixA.columns() << " and right hand side has size "
+                << vectorB.size() << ".";
+        BRICK_THROW(common::ValueException, "solveConjugateGradient()",
+                    message.str().c_str());
+      }
+      if(vectorX.size() != size) {
+        vectorX.reinit(size);
+        vectorX = Type(0);
+      }
+      if(maximumIterations == 0) {
+        // In exact arithmetic, size iterations would be enough, but
+        // roundoff destroys the orthogonality of the search
+        // directions, and ill-conditioned systems routinely need
+        // more.
+        maximumIterations = 10 * size;
+      }
+
+      // Jacobi preconditioner.
+      numeric::Array1D<Type> inverseDiagonal(size);
+      for(size_t row = 0; row < size; ++row) {
+        Type diagonal = matrixA.getElement(row, row);
+        if(!(diagonal > Type(0))) {
+          std::ostringstream message;
+          message << "Diagonal element " << row << " is " << diagonal
+                  << ", but must be positive.";
+          BRICK_THROW(common::ValueException, "solveConjugateGradient()",
+                      message.str().c_str());
+        }
+        inverseDiagonal[row] = Type(1) / diagonal;
+      }
+
+      Type bNormSquared = Type(0);
+      for(size_t ii = 0; ii < size; ++ii) {
+        bNormSquared += vectorB[ii] * vectorB[ii];
+      }
+      if(bNormSquared == Type(0)) {
+        vectorX = Type(0);
+        return 0;
+      }
+      Type const thresholdSquared =
+        relativeTolerance * relativeTolerance * bNormSquared;
+
+      // r = b - A * x, z = M^-1 * r, p = z.
+      numeric::Array1D<Type> residual =
+        matrixMultiply(matrixA, vectorX, numberOfThreads);
+      numeric::Array1D<Type> preconditioned(size);
+      numeric::Array1D<Type> direction(size);
+      Type rDotZ = Type(0);
+      Type rNormSquared = Type(0);
+      for(size_t ii = 0; ii < size; ++ii) {
+        residual[ii] = vectorB[ii] - residual[ii];
+        preconditioned[ii] = inverseDiagonal[ii] * residual[ii];
+        direction[ii] = preconditioned[ii];
+        rDotZ += residual[ii] * preconditioned[ii];
+        rNormSquared += residual[ii] * residual[ii];
+      }
+
+      // Scratch space for the matrix-vector product, reused by every
+      // iteration.
+      numeric::Array1D<Type> aTimesDirection(size);
+
+      size_t iteration = 0;
+      while(rNormSquared > thresholdSquared) {
+        if(iteration >= maximumIterations) {
+          std::ostringstream message;
+          message << "Failed to converge in " << maximumIterations
+                  << " iterations.  Relative residual is "
+                  << std::sqrt(rNormSquared / bNormSquared) << ".";
+          BRICK_THROW(common::RunTimeException, "solveConjugateGradient()",
+                      message.str().c_str());
+        }
+
+        matrixMultiply(matrixA, direction, aTimesDirection, numberOfThreads);
+        Type pDotAp = Type(0);
+        for(size_t ii = 0; ii < size; ++ii) {
+          pDotAp += direction[ii] * aTimesDirection[ii];
+        }
+        if(!(pDotAp > Type(0))) {
+          BRICK_THROW(common::ValueException, "solveConjugateGradient()",
+                      "Matrix is not positive definite.");
+        }
+        Type const alpha = rDotZ / pDotAp;
+
+        Type newRDotZ = Type(0);
+        rNormSquared = Type(0);
+        for(size_t ii = 0; ii < size; ++ii) {
+          vectorX[ii] += alpha * direction[ii];
+          residual[ii] -= alpha * aTimesDirection[ii];
+          preconditioned[ii] = inverseDiagonal[ii] * residual[ii];
+          newRDotZ += residual[ii] * preconditioned[ii];
+          rNormSquared += residual[ii] * residual[ii];
+        }
+
+        Type const beta = newRDotZ / rDotZ;
+        rDotZ = newRDotZ;
+        for(size_t ii = 0; ii < size; ++ii) {
+          direction[ii] = preconditioned[ii] + beta * direction[ii];
+        }
+        ++iteration;
+      }
+      return iteration;
+    }
+
+  } // namespace sparse
+
+} // namespace brick
+
+#endif /* #ifndef BRICK_SPARSE_CONJUGATEGRADIENT_IMPL_HH */
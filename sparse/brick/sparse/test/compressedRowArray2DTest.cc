@@ -0,0 +1,415 @@
+/**
+***************************************************************************
+* @file brick/sparse/test/compressedRowArray2DTest.cc
+*
+* Source file defining tests for the CompressedRowArray2D class
+* template and its associated arithmetic functions.
+*
+* Copyright (C) 2026 David LaRose, dlr@cs.cmu.edu
+* See accompanying file, LICENSE.TXT, for details.
+*
+***************************************************************************
+**/
+
+#include <brick/sparse/compressedRowArray2D.hh>
+
+#include <brick/common/functional.hh>
+#include <brick/numeric/utilities.hh>
+#include <brick/test/testFixture.hh>
+
+namespace brick {
+
+  namespace sparse {
+
+    class CompressedRowArray2DTest
+      : public brick::test::TestFixture<CompressedRowArray2DTest> {
+
+    public:
+
+      CompressedRowArray2DTest();
+      ~CompressedRowArray2DTest() {}
+
+      void setUp(const std::string& /* testName */) {}
+      void tearDown(const std::string& /* testName */) {}
+
+      void testConstructorTriplets();
+      void testConstructorCompressed();
+      void testConstructorDense();
+      void testGetTranspose();
+      void testMatrixMultiplyVector();
+      void testMatrixMultiplyDense();
+      void testMatrixMultiplySparse();
+      void testTransposeMultiply();
+
+    private:
+
+      // Builds a reproducible pseudo-random dense matrix in which
+      // roughly one element in density is nonzero.
+      numeric::Array2D<double>
+      getRandomDenseArray(size_t rows, size_t columns, size_t density);
+
+      bool
+      isApproximatelyEqual(numeric::Array2D<double> const& array0,
+                           numeric::Array2D<double> const& array1);
+
+      double m_defaultTolerance;
+      unsigned int m_seed;
+
+    }; // class CompressedRowArray2DTest
+
+
+    /* ============== Member Function Definititions ============== */
+
+    CompressedRowArray2DTest::
+    CompressedRowArray2DTest()
+      : brick::test::TestFixture<CompressedRowArray2DTest>(
+        "CompressedRowArray2DTest"),
+        m_defaultTolerance(1.0E-10),
+        m_seed(1)
+    {
+      // Register all tests.
+      BRICK_TEST_REGISTER_MEMBER(testConstructorTriplets);
+      BRICK_TEST_REGISTER_MEMBER(testConstructorCompressed);
+      BRICK_TEST_REGISTER_MEMBER(testConstructorDense);
+      BRICK_TEST_REGISTER_MEMBER(testGetTranspose);
+      BRICK_TEST_REGISTER_MEMBER(testMatrixMultiplyVector);
+      BRICK_TEST_REGISTER_MEMBER(testMatrixMultiplyDense);
+      BRICK_TEST_REGISTER_MEMBER(testMatrixMultiplySparse);
+      BRICK_TEST_REGISTER_MEMBER(testTransposeMultiply);
+    }
+
+
+    void
+    CompressedRowArray2DTest::
+    testConstructorTriplets()
+    {
+      // Triplets in scrambled order, with some duplicates.
+      size_t const rows = 37;
+      size_t const columns = 23;
+      size_t const numberOfTriplets = 500;
+      numeric::Array1D<numeric::Index2D> indices(numberOfTriplets);
+      numeric::Array1D<double> values(numberOfTriplets);
+      numeric::Array2D<double> reference(rows, columns);
+      reference = 0.0;
+      for(size_t ii = 0; ii < numberOfTriplets; ++ii) {
+        int row = static_cast<int>((ii * 7919) % rows);
+        int column = static_cast<int>((ii * ii * 31 + 3) % columns);
+        indices[ii] = numeric::Index2D(row, column);
+        values[ii] = 0.5 * ii - 17.0;
+        reference(row, column) += values[ii];
+      }
+
+      for(unsigned int numberOfThreads = 0; numberOfThreads < 5;
+          ++numberOfThreads) {
+        CompressedRowArray2D<double> matrix(
+          rows, columns, indices, values, numberOfThreads);
+        BRICK_TEST_ASSERT(matrix.rows() == rows);
+        BRICK_TEST_ASSERT(matrix.columns() == columns);
+        BRICK_TEST_ASSERT(matrix.getNumberOfNonzeros() < numberOfTriplets);
+        BRICK_TEST_ASSERT(
+          this->isApproximatelyEqual(matrix.getDenseArray(), reference));
+
+        // Column indices must be sorted within each row.
+        numeric::Array1D<size_t> rowPointers = matrix.getRowPointers();
+        numeric::Array1D<size_t> columnIndices = matrix.getColumnIndices();
+        for(size_t row = 0; row < rows; ++row) {
+          for(size_t ii = rowPointers[row] + 1; ii < rowPointers[row + 1];
+              ++ii) {
+            BRICK_TEST_ASSERT(columnIndices[ii] > columnIndices[ii - 1]);
+          }
+        }
+      }
+
+      // Out of bounds triplets should be rejected.
+      indices[3] = numeric::Index2D(rows, 0);
+      BRICK_TEST_ASSERT_EXCEPTION(
+        common::ValueException,
+        CompressedRowArray2D<double>(rows, columns, indices, values, 4));
+      BRICK_TEST_ASSERT_EXCEPTION(
+        common::ValueException,
+        CompressedRowArray2D<double>(rows, columns, indices,
+                                     numeric::Array1D<double>(3)));
+    }
+
+
+    void
+    CompressedRowArray2DTest::
+    testConstructorCompressed()
+    {
+      // 2 x 3 matrix [[1, 0, 2], [0, 3, 0]].
+      numeric::Array1D<size_t> rowPointers("[0, 2, 3]");
+      numeric::Array1D<size_t> columnIndices("[0, 2, 1]");
+      numeric::Array1D<double> values("[1.0, 2.0, 3.0]");
+      CompressedRowArray2D<double> matrix(
+        2, 3, rowPointers, columnIndices, values);
+      BRICK_TEST_ASSERT(matrix.getElement(0, 0) == 1.0);
+      BRICK_TEST_ASSERT(matrix.getElement(0, 1) == 0.0);
+      BRICK_TEST_ASSERT(matrix.getElement(0, 2) == 2.0);
+      BRICK_TEST_ASSERT(matrix.getElement(1, 1) == 3.0);
+      BRICK_TEST_ASSERT_EXCEPTION(common::IndexException,
+                                  matrix.getElement(2, 0));
+
+      // Shallow copy semantics.
+      CompressedRowArray2D<double> shallowCopy(matrix);
+      CompressedRowArray2D<double> deepCopy = matrix.copy();
+      matrix.getValues()[1] = 5.0;
+      BRICK_TEST_ASSERT(shallowCopy.getElement(0, 2) == 5.0);
+      BRICK_TEST_ASSERT(deepCopy.getElement(0, 2) == 2.0);
+
+      // Malformed arrays.
+      BRICK_TEST_ASSERT_EXCEPTION(
+        common::ValueException,
+        CompressedRowArray2D<double>(3, 3, rowPointers, columnIndices,
+                                     values));
+      BRICK_TEST_ASSERT_EXCEPTION(
+        common::ValueException,
+        CompressedRowArray2D<double>(
+          2, 3, rowPointers, numeric::Array1D<size_t>("[2, 0, 1]"),
+          values));
+      BRICK_TEST_ASSERT_EXCEPTION(
+        common::ValueException,
+        CompressedRowArray2D<double>(
+          2, 2, rowPointers, columnIndices, values));
+    }
+
+
+    void
+    CompressedRowArray2DTest::
+    testConstructorDense()
+    {
+      numeric::Array2D<double> dense =
+        this->getRandomDenseArray(20, 30, 4);
+      CompressedRowArray2D<double> matrix(dense);
+      BRICK_TEST_ASSERT(matrix.rows() == dense.rows());
+      BRICK_TEST_ASSERT(matrix.columns() == dense.columns());
+      size_t numberOfNonzeros = 0;
+      for(size_t ii = 0; ii < dense.size(); ++ii) {
+        if(dense[ii] != 0.0) {
+          ++numberOfNonzeros;
+        }
+      }
+      BRICK_TEST_ASSERT(matrix.getNumberOfNonzeros() == numberOfNonzeros);
+      BRICK_TEST_ASSERT(
+        this->isApproximatelyEqual(matrix.getDenseArray(), dense));
+
+      CompressedRowArray2D<double> emptyMatrix(3, 4);
+      BRICK_TEST_ASSERT(emptyMatrix.getNumberOfNonzeros() == 0);
+      BRICK_TEST_ASSERT(emptyMatrix.getElement(2, 3) == 0.0);
+    }
+
+
+    void
+    CompressedRowArray2DTest::
+    testGetTranspose()
+    {
+      numeric::Array2D<double> dense =
+        this->getRandomDenseArray(17, 40, 3);
+      CompressedRowArray2D<double> matrix(dense);
+      CompressedRowArray2D<double> transpose = matrix.getTranspose();
+      BRICK_TEST_ASSERT(transpose.rows() == dense.columns());
+      BRICK_TEST_ASSERT(transpose.columns() == dense.rows());
+      BRICK_TEST_ASSERT(
+        this->isApproximatelyEqual(transpose.getDenseArray(),
+                                   dense.transpose()));
+    }
+
+
+    void
+    CompressedRowArray2DTest::
+    testMatrixMultiplyVector()
+    {
+      numeric::Array2D<double> dense =
+        this->getRandomDenseArray(50, 31, 5);
+      CompressedRowArray2D<double> matrix(dense);
+      numeric::Array1D<double> vector0(dense.columns());
+      for(size_t ii = 0; ii < vector0.size(); ++ii) {
+        vector0[ii] = 0.25 * ii - 3.0;
+      }
+      numeric::Array1D<double> reference =
+        numeric::matrixMultiply<double>(dense, vector0);
+
+      for(unsigned int numberOfThreads = 0; numberOfThreads < 5;
+          ++numberOfThreads) {
+        numeric::Array1D<double> result =
+          matrixMultiply(matrix, vector0, numberOfThreads);
+        BRICK_TEST_ASSERT(result.size() == reference.size());
+        for(size_t ii = 0; ii < result.size(); ++ii) {
+          BRICK_TEST_ASSERT(
+            approximatelyEqual(result[ii], reference[ii], m_defaultTolerance));
+        }
+      }
+
+      // The in-place version should resize a mis-sized result, and
+      // reuse a correctly sized one.
+      numeric::Array1D<double> result(3);
+      matrixMultiply(matrix, vector0, result);
+      BRICK_TEST_ASSERT(result.size() == reference.size());
+      double const* resultData = result.data();
+      for(unsigned int numberOfThreads = 0; numberOfThreads < 5;
+          ++numberOfThreads) {
+        result = 0.0;
+        matrixMultiply(matrix, vector0, result, numberOfThreads);
+        BRICK_TEST_ASSERT(result.data() == resultData);
+        for(size_t ii = 0; ii < result.size(); ++ii) {
+          BRICK_TEST_ASSERT(
+            approximatelyEqual(result[ii], reference[ii], m_defaultTolerance));
+        }
+      }
+      BRICK_TEST_ASSERT_EXCEPTION(
+        common::ValueException,
+        matrixMultiply(matrix, numeric::Array1D<double>(dense.rows())));
+      BRICK_TEST_ASSERT_EXCEPTION(
+        common::ValueException,
+        matrixMultiply(matrix, numeric::Array1D<double>(dense.rows()),
+                       result));
+    }
+
+
+    void
+    CompressedRowArray2DTest::
+    testMatrixMultiplyDense()
+    {
+      numeric::Array2D<double> dense0 =
+        this->getRandomDenseArray(40, 25, 4);
+      numeric::Array2D<double> dense1 =
+        this->getRandomDenseArray(25, 7, 1);
+      CompressedRowArray2D<double> matrix(dense0);
+      numeric::Array2D<double> reference =
+        numeric::matrixMultiply<double>(dense0, dense1);
+
+      for(unsigned int numberOfThreads = 0; numberOfThreads < 5;
+          ++numberOfThreads) {
+        numeric::Array2D<double> result =
+          matrixMultiply(matrix, dense1, numberOfThreads);
+        BRICK_TEST_ASSERT(this->isApproximatelyEqual(result, reference));
+      }
+      BRICK_TEST_ASSERT_EXCEPTION(
+        common::ValueException, matrixMultiply(matrix, dense0));
+    }
+
+
+    void
+    CompressedRowArray2DTest::
+    testMatrixMultiplySparse()
+    {
+      numeric::Array2D<double> dense0 =
+        this->getRandomDenseArray(33, 45, 6);
+      numeric::Array2D<double> dense1 =
+        this->getRandomDenseArray(45, 28, 5);
+      CompressedRowArray2D<double> matrix0(dense0);
+      CompressedRowArray2D<double> matrix1(dense1);
+      numeric::Array2D<double> reference =
+        numeric::matrixMultiply<double>(dense0, dense1);
+
+      for(unsigned int numberOfThreads = 0; numberOfThreads < 5;
+          ++numberOfThreads) {
+        CompressedRowArray2D<double> result =
+          matrixMultiply(matrix0, matrix1, numberOfThreads);
+        BRICK_TEST_ASSERT(result.rows() == reference.rows());
+        BRICK_TEST_ASSERT(result.columns() == reference.columns());
+        BRICK_TEST_ASSERT(
+          this->isApproximatelyEqual(result.getDenseArray(), reference));
+      }
+      BRICK_TEST_ASSERT_EXCEPTION(
+        common::ValueException, matrixMultiply(matrix0, matrix0));
+    }
+
+
+    void
+    CompressedRowArray2DTest::
+    testTransposeMultiply()
+    {
+      // Jacobian-like matrix: many more rows than columns.
+      numeric::Array2D<double> jacobian =
+        this->getRandomDenseArray(300, 24, 5);
+      CompressedRowArray2D<double> matrix(jacobian);
+      numeric::Array1D<double> residual(jacobian.rows());
+      for(size_t ii = 0; ii < residual.size(); ++ii) {
+        residual[ii] = std::sin(0.1 * ii);
+      }
+      numeric::Array1D<double> referenceGradient =
+        numeric::matrixMultiply<double>(residual, jacobian);
+      numeric::Array2D<double> referenceNormal =
+        numeric::matrixMultiply<double>(jacobian.transpose(), jacobian);
+
+      for(unsigned int numberOfThreads = 0; numberOfThreads < 5;
+          ++numberOfThreads) {
+        numeric::Array1D<double> gradient =
+          transposeMultiply(matrix, residual, numberOfThreads);
+        BRICK_TEST_ASSERT(gradient.size() == jacobian.columns());
+        for(size_t ii = 0; ii < gradient.size(); ++ii) {
+          BRICK_TEST_ASSERT(
+            approximatelyEqual(gradient[ii], referenceGradient[ii],
+                               m_defaultTolerance));
+        }
+
+        CompressedRowArray2D<double> normal =
+          transposeMultiply(matrix, matrix, numberOfThreads);
+        BRICK_TEST_ASSERT(
+          this->isApproximatelyEqual(normal.getDenseArray(),
+                                     referenceNormal));
+      }
+      BRICK_TEST_ASSERT_EXCEPTION(
+        common::ValueException,
+        transposeMultiply(matrix, numeric::Array1D<double>(24)));
+    }
+
+
+    numeric::Array2D<double>
+    CompressedRowArray2DTest::
+    getRandomDenseArray(size_t rows, size_t columns, size_t density)
+    {
+      numeric::Array2D<double> result(rows, columns);
+      for(size_t ii = 0; ii < result.size(); ++ii) {
+        m_seed = m_seed * 1103515245u + 12345u;
+        unsigned int bits = (m_seed >> 8);
+        if(bits % density == 0) {
+          result[ii] = static_cast<double>(bits % 2001) / 100.0 - 10.0;
+        } else {
+          result[ii] = 0.0;
+        }
+      }
+      return result;
+    }
+
+
+    bool
+    CompressedRowArray2DTest::
+    isApproximatelyEqual(numeric::Array2D<double> const& array0,
+                         numeric::Array2D<double> const& array1)
+    {
+      if(array0.rows() != array1.rows()
+         || array0.columns() != array1.columns()) {
+        return false;
+      }
+      for(size_t ii = 0; ii < array0.size(); ++ii) {
+        if(!approximatelyEqual(array0[ii], array1[ii], m_defaultTolerance)) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+  } // namespace sparse
+
+} // namespace brick
+
+
+#if 0
+
+int main(int /* argc */, char** /* argv */)
+{
+  brick::sparse::CompressedRowArray2DTest currentTest;
+  bool result = currentTest.run();
+  return (result ? 0 : 1);
+}
+
+#else
+
+namespace {
+
+  brick::sparse::CompressedRowArray2DTest currentTest;
+
+}
+
+#endif
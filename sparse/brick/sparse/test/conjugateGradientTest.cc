@@ -0,0 +1,273 @@
+/**
+***************************************************************************
+* @file brick/sparse/test/conjugateGradientTest.cc
+*
+* Source file defining tests for solveConjugateGradient().
+*
+* Copyright (C) 2026 David LaRose, dlr@cs.cmu.edu
+* See accompanying file, LICENSE.TXT, for details.
+*
+***************************************************************************
+**/
+#include <cmath>
+#include <vector>
+
+#include <brick/sparse/conjugateGradient.hh>
+
+#include <brick/common/functional.hh>
+#include <brick/test/testFixture.hh>
+
+namespace brick {
+
+  namespace sparse {
+
+    class ConjugateGradientTest
+      : public brick::test::TestFixture<ConjugateGradientTest> {
+
+    public:
+
+      ConjugateGradientTest();
+      ~ConjugateGradientTest() {}
+
+      void setUp(const std::string& /* testName */) {}
+      void tearDown(const std::string& /* testName */) {}
+
+      void testSolveConjugateGradient();
+      void testSolveConjugateGradientExceptions();
+      void testSolveConjugateGradientIllConditioned();
+
+    private:
+
+      // Builds the 2D Laplacian on an n x n grid, plus a small
+      // multiple of the identity.  This is sparse, symmetric, and
+      // positive definite, with a condition number that grows with
+      // n, so the solver has to do real work.
+      CompressedRowArray2D<double>
+      getLaplacian(size_t gridSize);
+
+      // Builds a 1D diffusion operator whose coefficients vary
+      // irregularly over four orders of magnitude.  The Jacobi
+      // preconditioner can't fix this, and roundoff makes the
+      // solver take more than size iterations.
+      CompressedRowArray2D<double>
+      getVariableDiffusion(size_t size);
+
+      double m_defaultTolerance;
+
+    }; // class ConjugateGradientTest
+
+
+    /* ============== Member Function Definititions ============== */
+
+    ConjugateGradientTest::
+    ConjugateGradientTest()
+      : brick::test::TestFixture<ConjugateGradientTest>(
+        "ConjugateGradientTest"),
+        m_defaultTolerance(1.0E-8)
+    {
+      // Register all tests.
+      BRICK_TEST_REGISTER_MEMBER(testSolveConjugateGradient);
+      BRICK_TEST_REGISTER_MEMBER(testSolveConjugateGradientExceptions);
+      BRICK_TEST_REGISTER_MEMBER(testSolveConjugateGradientIllConditioned);
+    }
+
+
+    void
+    ConjugateGradientTest::
+    testSolveConjugateGradient()
+    {
+      CompressedRowArray2D<double> matrixA = this->getLaplacian(30);
+      size_t const size = matrixA.rows();
+      numeric::Array1D<double> reference(size);
+      for(size_t ii = 0; ii < size; ++ii) {
+        reference[ii] = std::cos(0.05 * ii) + 0.01 * ii;
+      }
+      numeric::Array1D<double> vectorB = matrixMultiply(matrixA, reference);
+
+      for(unsigned int numberOfThreads = 0; numberOfThreads < 5;
+          ++numberOfThreads) {
+        numeric::Array1D<double> vectorX;
+        size_t iterations = solveConjugateGradient(
+          matrixA, vectorB, vectorX, 1.0E-12, 0, numberOfThreads);
+        BRICK_TEST_ASSERT(iterations > 0);
+        BRICK_TEST_ASSERT(iterations < size);
+        BRICK_TEST_ASSERT(vectorX.size() == size);
+        for(size_t ii = 0; ii < size; ++ii) {
+          BRICK_TEST_ASSERT(
+            approximatelyEqual(vectorX[ii], reference[ii],
+                               m_defaultTolerance));
+        }
+
+        // Starting from the answer should take no iterations.
+        iterations = solveConjugateGradient(
+          matrixA, vectorB, vectorX, 1.0E-6, 0, numberOfThreads);
+        BRICK_TEST_ASSERT(iterations == 0);
+      }
+
+      // Zero right hand side has a zero solution.
+      numeric::Array1D<double> zeros(size);
+      zeros = 0.0;
+      numeric::Array1D<double> vectorX(size);
+      vectorX = 1.0;
+      BRICK_TEST_ASSERT(
+        solveConjugateGradient(matrixA, zeros, vectorX) == 0);
+      for(size_t ii = 0; ii < size; ++ii) {
+        BRICK_TEST_ASSERT(vectorX[ii] == 0.0);
+      }
+    }
+
+
+    void
+    ConjugateGradientTest::
+    testSolveConjugateGradientExceptions()
+    {
+      CompressedRowArray2D<double> matrixA = this->getLaplacian(10);
+      numeric::Array1D<double> vectorB(matrixA.rows());
+      vectorB = 1.0;
+      numeric::Array1D<double> vectorX;
+
+      // Too few iterations.
+      BRICK_TEST_ASSERT_EXCEPTION(
+        common::RunTimeException,
+        solveConjugateGradient(matrixA, vectorB, vectorX, 1.0E-12, 2));
+
+      // Wrong size right hand side.
+      BRICK_TEST_ASSERT_EXCEPTION(
+        common::ValueException,
+        solveConjugateGradient(matrixA, numeric::Array1D<double>(3),
+                               vectorX));
+
+      // Not square.
+      CompressedRowArray2D<double> rectangular(3, 4);
+      BRICK_TEST_ASSERT_EXCEPTION(
+        common::ValueException,
+        solveConjugateGradient(rectangular, numeric::Array1D<double>(3),
+                               vectorX));
+
+      // Zero diagonal.
+      CompressedRowArray2D<double> empty(3, 3);
+      numeric::Array1D<double> ones(3);
+      ones = 1.0;
+      BRICK_TEST_ASSERT_EXCEPTION(
+        common::ValueException,
+        solveConjugateGradient(empty, ones, vectorX));
+    }
+
+
+    void
+    ConjugateGradientTest::
+    testSolveConjugateGradientIllConditioned()
+    {
+      size_t const size = 100;
+      CompressedRowArray2D<double> matrixA = this->getVariableDiffusion(size);
+      numeric::Array1D<double> reference(size);
+      for(size_t ii = 0; ii < size; ++ii) {
+        reference[ii] = std::cos(0.05 * ii) + 0.01 * ii;
+      }
+      numeric::Array1D<double> vectorB = matrixMultiply(matrixA, reference);
+
+      // The default iteration limit must leave room for the extra
+      // iterations caused by roundoff.
+      numeric::Array1D<double> vectorX;
+      size_t iterations = solveConjugateGradient(
+        matrixA, vectorB, vectorX, 1.0E-12);
+      BRICK_TEST_ASSERT(iterations > size);
+      for(size_t ii = 0; ii < size; ++ii) {
+        BRICK_TEST_ASSERT(
+          approximatelyEqual(vectorX[ii], reference[ii], m_defaultTolerance));
+      }
+    }
+
+
+    CompressedRowArray2D<double>
+    ConjugateGradientTest::
+    getLaplacian(size_t gridSize)
+    {
+      size_t const size = gridSize * gridSize;
+      numeric::Array1D<numeric::Index2D> indices(5 * size);
+      numeric::Array1D<double> values(5 * size);
+      size_t count = 0;
+      for(size_t row = 0; row < gridSize; ++row) {
+        for(size_t column = 0; column < gridSize; ++column) {
+          int index = static_cast<int>(row * gridSize + column);
+          indices[count] = numeric::Index2D(index, index);
+          values[count++] = 4.01;
+          if(row > 0) {
+            indices[count] = numeric::Index2D(index, index - gridSize);
+            values[count++] = -1.0;
+          }
+          if(row + 1 < gridSize) {
+            indices[count] = numeric::Index2D(index, index + gridSize);
+            values[count++] = -1.0;
+          }
+          if(column > 0) {
+            indices[count] = numeric::Index2D(index, index - 1);
+            values[count++] = -1.0;
+          }
+          if(column + 1 < gridSize) {
+            indices[count] = numeric::Index2D(index, index + 1);
+            values[count++] = -1.0;
+          }
+        }
+      }
+      numeric::Array1D<numeric::Index2D> usedIndices(count, indices.data());
+      numeric::Array1D<double> usedValues(count, values.data());
+      return CompressedRowArray2D<double>(
+        size, size, usedIndices, usedValues);
+    }
+
+
+    CompressedRowArray2D<double>
+    ConjugateGradientTest::
+    getVariableDiffusion(size_t size)
+    {
+      // Coefficient ii couples unknowns ii - 1 and ii.
+      std::vector<double> coefficients(size + 1);
+      for(size_t ii = 0; ii < coefficients.size(); ++ii) {
+        coefficients[ii] = std::pow(10.0, -0.4 * double((ii * 37) % 11));
+      }
+      numeric::Array1D<numeric::Index2D> indices(3 * size);
+      numeric::Array1D<double> values(3 * size);
+      size_t count = 0;
+      for(size_t row = 0; row < size; ++row) {
+        int index = static_cast<int>(row);
+        indices[count] = numeric::Index2D(index, index);
+        values[count++] = coefficients[row] + coefficients[row + 1];
+        if(row > 0) {
+          indices[count] = numeric::Index2D(index, index - 1);
+          values[count++] = -coefficients[row];
+        }
+        if(row + 1 < size) {
+          indices[count] = numeric::Index2D(index, index + 1);
+          values[count++] = -coefficients[row + 1];
+        }
+      }
+      numeric::Array1D<numeric::Index2D> usedIndices(count, indices.data());
+      numeric::Array1D<double> usedValues(count, values.data());
+      return CompressedRowArray2D<double>(
+        size, size, usedIndices, usedValues);
+    }
+
+  } // namespace sparse
+
+} // namespace brick
+
+
+#if 0
+
+int main(int /* argc */, char** /* argv */)
+{
+  brick::sparse::ConjugateGradientTest currentTest;
+  bool result = currentTest.run();
+  return (result ? 0 : 1);
+}
+
+#else
+
+namespace {
+
+  brick::sparse::ConjugateGradientTest currentTest;
+
+}
+
+#endif